@@ -11,6 +11,7 @@ extern "C" {
 #endif // __cplusplus
 
 #include <stdint.h>
+#include <stddef.h>
 
 /* API Version */
 #define SVT_JPEGXS_API_VER_MAJOR (0)
@@ -165,6 +166,65 @@ typedef enum {
     proxy_mode_max
 } proxy_mode_t;
 
+/* Purpose of internal allocation, passed to allocator callbacks to allow different memory placement.*/
+typedef enum SvtJxsMemPurpose {
+    SVT_JXS_MEM_GENERAL = 0,      /* Handles, contexts, queues and other small objects*/
+    SVT_JXS_MEM_COEFFICIENTS = 1, /* Wavelet coefficients and precinct buffers*/
+    SVT_JXS_MEM_SCRATCH = 2,      /* Per thread temporary buffers*/
+    SVT_JXS_MEM_BITSTREAM = 3,    /* Internal copies of bitstream*/
+    SVT_JXS_MEM_PURPOSES_NUM
+} SvtJxsMemPurpose_t;
+
+/* Allocator callbacks for all memory allocated internally by encoder/decoder.
+ * Callbacks are called only from svt_jpeg_xs_*_init() and svt_jpeg_xs_*_close(), always from the thread calling that function.
+ * Any memory returned by alloc() or aligned_alloc() is released by free().
+ * Allocator structure is copied on init, context have to be valid until close.*/
+typedef struct svt_jpeg_xs_allocator {
+    /* Return buffer of size bytes or NULL on fail.*/
+    void *(*alloc)(void *context, size_t size, SvtJxsMemPurpose_t purpose);
+    /* Return buffer of size bytes aligned to alignment (power of 2) or NULL on fail.*/
+    void *(*aligned_alloc)(void *context, size_t size, size_t alignment, SvtJxsMemPurpose_t purpose);
+    void (*free)(void *context, void *ptr);
+    void *context;
+} svt_jpeg_xs_allocator_t;
+
+/* Pipeline stages reported in svt_jpeg_xs_frame_stats_t.*/
+typedef enum SvtJxsStage {
+    SVT_JXS_STAGE_INIT = 0,  /* Encoder: frame setup, Decoder: header parsing, before slices are scheduled*/
+    SVT_JXS_STAGE_DWT = 1,   /* Encoder CPU profile: vertical DWT of all components, not used by decoder*/
+    SVT_JXS_STAGE_SLICE = 2, /* Encoder: slice rate control and pack (CPU profile: with wait on DWT), Decoder: slice decode*/
+    SVT_JXS_STAGE_FINAL = 3, /* Output ordering, for decoder also IDWT between slices and final transform*/
+    SVT_JXS_STAGES_NUM
+} SvtJxsStage_t;
+
+/* Statistics of single frame, collected only when enabled on init.
+ * All times are in microseconds. Stage time is a sum of processing time in all threads, without waiting on queues.*/
+typedef struct svt_jpeg_xs_frame_stats {
+    uint64_t frame_num;                         /* Frame number in order of send to library*/
+    uint64_t latency_us;                        /* Time from send frame to library to frame ready to get*/
+    uint64_t stage_time_us[SVT_JXS_STAGES_NUM]; /* Processing time per stage, index SvtJxsStage_t*/
+    uint64_t slice_time_min_us;                 /* Shortest slice processing time*/
+    uint64_t slice_time_max_us;                 /* Longest slice processing time*/
+    uint32_t slices_num;                        /* Number of processed slices*/
+    uint32_t rc_iterations;                     /* Encoder: rate control budget evaluations in all slices, Decoder: 0*/
+    uint32_t rc_iterations_max;                 /* Encoder: max rate control budget evaluations in single slice, Decoder: 0*/
+    uint32_t input_queue_depth;                 /* Frames waiting in input queue when frame was taken to processing*/
+    uint32_t output_queue_depth;                /* Items waiting in output queue when frame was ready, with that frame*/
+} svt_jpeg_xs_frame_stats_t;
+
+/* Maximum of frames_in_pipeline and frames_in_input_queue in encoder and decoder configuration.*/
+#define SVT_JXS_FRAMES_IN_PIPELINE_MAX    (64)
+#define SVT_JXS_FRAMES_IN_INPUT_QUEUE_MAX (256)
+
+/* Resources required by encoder or decoder for given configuration, returned by svt_jpeg_xs_*_get_resources() before init.*/
+typedef struct svt_jpeg_xs_resources {
+    size_t memory_peak;                                   /* Peak size in bytes of internal allocations between init and close*/
+    size_t memory_peak_purpose[SVT_JXS_MEM_PURPOSES_NUM]; /* Split of memory_peak, index SvtJxsMemPurpose_t*/
+    uint32_t threads_num[SVT_JXS_STAGES_NUM];             /* Threads created per stage, index SvtJxsStage_t*/
+    uint32_t frames_in_pipeline;                          /* Frames processed at once, latency of pipeline in frames*/
+    uint32_t frames_in_input_queue;                       /* Frames waiting in input queue before send is blocked*/
+} svt_jpeg_xs_resources_t;
+
 /**
 CPU FLAGS
 */
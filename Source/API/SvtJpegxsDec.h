@@ -48,12 +48,64 @@ typedef struct svt_jpeg_xs_decoder_api {
 
     void* private_ptr;
 
+    /* Optional, default NULL, Allocator used for all internal decoder memory, NULL - system allocator.
+     * Structure is copied on init.*/
+    svt_jpeg_xs_allocator_t* allocator;
+
+    /* Callback: Call when statistics of frame are ready, require stats_enable.
+     * Call from internal thread when whole frame is ready to get.
+     * Only one callback will be triggered at a time.
+     * Optional, default NULL */
+    void (*callback_frame_stats)(struct svt_jpeg_xs_decoder_api* decoder, const svt_jpeg_xs_frame_stats_t* stats, void* context);
+    void* callback_frame_stats_context;
+
+    /* Collect per frame statistics, read by callback_frame_stats or svt_jpeg_xs_decoder_get_frame_stats().
+     * 0 - disabled, 1 - enabled
+     * Optional, default 0 */
+    uint8_t stats_enable;
+
+    /* Decode only selected components, bit N set - decode component N.
+     * Samples of not selected components in output buffer are not modified.
+     * Not supported for stream with Multiple Component Transformation (Cpih).
+     * Optional, default 0 - decode all components */
+    uint8_t roi_components_mask;
+
+    /* Decode only slices from range [roi_slice_begin, roi_slice_end), slices around range are decoded only
+     * as much as required by vertical wavelet transformation. Only rows of selected slices in output buffer are valid.
+     * Not supported with packetization_mode.
+     * Optional, default 0 and 0 - decode all slices, roi_slice_end equal 0 means up to last slice */
+    uint16_t roi_slice_begin;
+    uint16_t roi_slice_end;
+
+    /* Conceal slices with invalid headers or lengths instead of fail of whole frame. Decoding resumes from next valid
+     * slice header, samples of concealed slices are filled with mid-grey, other slices are decoded as usual.
+     * Concealed slices of frame can be read by svt_jpeg_xs_decoder_get_concealed_slices().
+     * In packetization_mode lost packets have to be replaced by filler of the same size, frame size is taken from header.
+     * Optional, default 0 - any invalid slice fail whole frame */
+    uint8_t slice_concealment;
+
+    /* Ceiling of stream parameters expected after svt_jpeg_xs_decoder_reconfigure(). Internal buffers are allocated
+     * in svt_jpeg_xs_decoder_init() for the bigger of ceiling and first stream, so reconfiguration up to ceiling
+     * does not allocate memory. Bit depth does not change size of internal buffers.
+     * Optional, default 0 - buffers allocated for first stream, and grown when reconfiguration requires it */
+    uint8_t max_components_num;
+    uint16_t max_width;
+    uint16_t max_height;
+
+    /* Frames waiting in input queue before svt_jpeg_xs_decoder_send_frame() is blocked, ignored in packetization_mode.
+     * Optional, default 0 - 2 * threads + 10 frames, max SVT_JXS_FRAMES_IN_INPUT_QUEUE_MAX */
+    uint16_t frames_in_input_queue;
+    /* Pipeline depth: frames decoded at once, each frame keeps own decoder instance with coefficient buffers.
+     * 1 gives minimum latency and memory, more frames absorb jitter of input and output.
+     * Optional, default 0 - 3 frames, max SVT_JXS_FRAMES_IN_PIPELINE_MAX */
+    uint8_t frames_in_pipeline;
+
     /* This padding is used to avoid changing the size of the public configuration struct
      * when new parameters are added in the future please follow these steps:
      * 1. Insert the new parameter as a member of this structure before the padding array.
      * 2. Decrease the size of the padding array by the size of the new parameter to keep the struct size unchanged.
      */
-    uint8_t padding[64];
+    uint8_t padding[64 - 3 * sizeof(void*) - 5 * sizeof(uint8_t) - 5 * sizeof(uint16_t)];
 } svt_jpeg_xs_decoder_api_t;
 
 PREFIX_API SvtJxsErrorType_t svt_jpeg_xs_decoder_init(uint64_t version_api_major, uint64_t version_api_minor,
@@ -61,6 +113,36 @@ PREFIX_API SvtJxsErrorType_t svt_jpeg_xs_decoder_init(uint64_t version_api_major
                                                       size_t codestream_size, svt_jpeg_xs_image_config_t* out_image_config);
 PREFIX_API void svt_jpeg_xs_decoder_close(svt_jpeg_xs_decoder_api_t* dec_api);
 
+/* Get memory footprint of decoder
+  * Parameters:
+  * @ *dec_api - Decoder configuration as passed to svt_jpeg_xs_decoder_init(), allocator and callbacks are ignored.
+  * @ *bitstream_buf - pointer to bitstream with first frame header
+  * @ codestream_size - size of bitstream in bytes
+  * @ *out_footprint - output parameter, peak size in bytes of all internal allocations between init and close
+  * Computed from configuration and frame header, without creating decoder, allocating memory or starting threads.
+  * Return:
+  *  SvtJxsErrorNone on success, or the same error as svt_jpeg_xs_decoder_init() for this configuration
+  **/
+PREFIX_API SvtJxsErrorType_t svt_jpeg_xs_decoder_get_memory_footprint(uint64_t version_api_major, uint64_t version_api_minor,
+                                                                      const svt_jpeg_xs_decoder_api_t* dec_api,
+                                                                      const uint8_t* bitstream_buf, size_t codestream_size,
+                                                                      size_t* out_footprint);
+
+/* Get resources required by decoder: memory split per purpose, threads per stage and frames in pipeline
+  * Parameters:
+  * @ *dec_api - Decoder configuration as passed to svt_jpeg_xs_decoder_init(), allocator and callbacks are ignored.
+  * @ *bitstream_buf - pointer to bitstream with first frame header
+  * @ codestream_size - size of bitstream in bytes
+  * @ *out_resources - output parameter, resources of decoder with this configuration
+  * Computed from configuration and frame header, without creating decoder, allocating memory or starting threads.
+  * Return:
+  *  SvtJxsErrorNone on success, or the same error as svt_jpeg_xs_decoder_init() for this configuration
+  **/
+PREFIX_API SvtJxsErrorType_t svt_jpeg_xs_decoder_get_resources(uint64_t version_api_major, uint64_t version_api_minor,
+                                                               const svt_jpeg_xs_decoder_api_t* dec_api,
+                                                               const uint8_t* bitstream_buf, size_t codestream_size,
+                                                               svt_jpeg_xs_resources_t* out_resources);
+
 /* Get single frame size from bitstream
   * Parameters:
   * @ *bitstream_buf - pointer to bitstream
@@ -88,6 +170,55 @@ PREFIX_API SvtJxsErrorType_t svt_jpeg_xs_decoder_get_single_frame_size_with_prox
                                                                                   uint32_t* frame_size, uint32_t fast_search,
                                                                                   proxy_mode_t proxy_mode);
 
+/* Frame boundary and slice index of single frame, filled by svt_jpeg_xs_frame_scanner_feed().*/
+typedef struct svt_jpeg_xs_frame_index {
+    uint32_t frame_size;           /* Size of frame in bytes, from SOC to EOC inclusive*/
+    uint32_t slices_num;           /* Number of slices in frame*/
+    const uint32_t* slice_offsets; /* Offset of slice header (SLH) of each slice from SOC, slices_num entries.
+                                    * Owned by scanner, valid until next call of svt_jpeg_xs_frame_scanner_feed()*/
+} svt_jpeg_xs_frame_index_t;
+
+/* Incremental frame boundary scanner, for splitting codestream (CBR and VBR) into frames without buffering of whole frame.
+ * Every byte of codestream is read only once, even when frame is passed in many chunks of any size.*/
+typedef struct svt_jpeg_xs_frame_scanner {
+    void* private_ptr;
+} svt_jpeg_xs_frame_scanner_t;
+
+/* Initialize frame scanner
+  * Parameters:
+  * @ *scanner - Scanner handle to initialize, release with svt_jpeg_xs_frame_scanner_close().
+  * Return:
+  *  SvtJxsErrorNone on success,
+  *  SvtJxsErrorDecoderInvalidPointer - when scanner is null
+  *  SvtJxsErrorInsufficientResources - when allocation failed
+  **/
+PREFIX_API SvtJxsErrorType_t svt_jpeg_xs_frame_scanner_init(svt_jpeg_xs_frame_scanner_t* scanner);
+PREFIX_API void svt_jpeg_xs_frame_scanner_close(svt_jpeg_xs_frame_scanner_t* scanner);
+
+/* Discard state of partially scanned frame, next byte passed to svt_jpeg_xs_frame_scanner_feed() shall be SOC marker.
+  * Required after SvtJxsErrorDecoderInvalidBitstream, before scan of next frame.
+  **/
+PREFIX_API void svt_jpeg_xs_frame_scanner_reset(svt_jpeg_xs_frame_scanner_t* scanner);
+
+/* Scan next chunk of codestream
+  * Parameters:
+  * @ *scanner - Scanner handle.
+  * @ *chunk - pointer to next bytes of codestream, continuation of bytes passed in previous call
+  * @ chunk_size - size of chunk in bytes
+  * @ *bytes_used - output parameter, number of bytes of chunk that belong to scanned frame
+  * @ *out_index - output parameter, filled when end of frame is found
+  * Return non-fatal:
+  *  SvtJxsErrorNone - end of frame found, bytes after bytes_used belong to next frame, scanner is ready for next frame,
+  *  SvtJxsErrorDecoderBitstreamTooShort - all bytes of chunk used and frame is not complete, please call again with next chunk.
+  * Return fatal:
+  *  SvtJxsErrorDecoderInvalidPointer - when scanner, chunk, bytes_used or out_index are null,
+  *  SvtJxsErrorDecoderInvalidBitstream - when codestream is invalid, svt_jpeg_xs_frame_scanner_reset() is required
+  *  SvtJxsErrorInsufficientResources - when allocation of slice index failed
+  **/
+PREFIX_API SvtJxsErrorType_t svt_jpeg_xs_frame_scanner_feed(svt_jpeg_xs_frame_scanner_t* scanner, const uint8_t* chunk,
+                                                            size_t chunk_size, size_t* bytes_used,
+                                                            svt_jpeg_xs_frame_index_t* out_index);
+
 /*Start decode bitstream
   * Parameters:
   * @ *dec_api - Decoder handle.
@@ -103,6 +234,16 @@ PREFIX_API SvtJxsErrorType_t svt_jpeg_xs_decoder_get_single_frame_size_with_prox
 PREFIX_API SvtJxsErrorType_t svt_jpeg_xs_decoder_send_frame(svt_jpeg_xs_decoder_api_t* dec_api, svt_jpeg_xs_frame_t* dec_input,
                                                             uint8_t blocking_flag);
 
+/*Start decode bitstream with slice index found by svt_jpeg_xs_frame_scanner_feed()
+  * Parameters are the same as in svt_jpeg_xs_decoder_send_frame(), additionally:
+  * @ *index - Optional, can be null, index of frame in dec_input bitstream. Index is copied, so scanner can be used for next
+  *            frame after return. Decoder skip own search of slices when index matches frame, otherwise index is ignored.
+  **/
+PREFIX_API SvtJxsErrorType_t svt_jpeg_xs_decoder_send_frame_with_index(svt_jpeg_xs_decoder_api_t* dec_api,
+                                                                       svt_jpeg_xs_frame_t* dec_input,
+                                                                       const svt_jpeg_xs_frame_index_t* index,
+                                                                       uint8_t blocking_flag);
+
 /*Start decode bitstream
   * Parameters:
   * @ *dec_api - Decoder handle.
@@ -147,6 +288,58 @@ PREFIX_API SvtJxsErrorType_t svt_jpeg_xs_decoder_get_frame(svt_jpeg_xs_decoder_a
   **/
 PREFIX_API SvtJxsErrorType_t svt_jpeg_xs_decoder_send_eoc(svt_jpeg_xs_decoder_api_t* dec_api);
 
+/* Optional API function to get statistics of last frame ready to get, require stats_enable.
+  * Parameters:
+  * @ *dec_api - Decoder handle.
+  * @ *out_stats - Statistics of last finished frame.
+  * Return non-fatal:
+  *  SvtJxsErrorNone - on success,
+  *  SvtJxsErrorNoErrorEmptyQueue - when no frame is finished yet,
+  * Return fatal:
+  *  SvtJxsErrorDecoderInvalidPointer - when decoder handle in null or is not initialized
+  *  SvtJxsErrorBadParameter - when statistics are not enabled
+  **/
+PREFIX_API SvtJxsErrorType_t svt_jpeg_xs_decoder_get_frame_stats(svt_jpeg_xs_decoder_api_t* dec_api,
+                                                                 svt_jpeg_xs_frame_stats_t* out_stats);
+
+/* Optional API function to get slices concealed in last frame returned by svt_jpeg_xs_decoder_get_frame(),
+  * require slice_concealment.
+  * Parameters:
+  * @ *dec_api - Decoder handle.
+  * @ *out_bitmap - Bit (slice % 8) of byte (slice / 8) is set when slice was concealed, can be NULL.
+  * @ bitmap_size - Size of out_bitmap in bytes, at least (number of slices + 7) / 8 when out_bitmap is not NULL.
+  * @ *out_concealed_num - Number of concealed slices, 0 when all slices were decoded.
+  * Return non-fatal:
+  *  SvtJxsErrorNone - on success,
+  * Return fatal:
+  *  SvtJxsErrorDecoderInvalidPointer - when decoder handle in null or is not initialized
+  *  SvtJxsErrorBadParameter - when slice concealment is not enabled or bitmap is too small
+  **/
+PREFIX_API SvtJxsErrorType_t svt_jpeg_xs_decoder_get_concealed_slices(svt_jpeg_xs_decoder_api_t* dec_api, uint8_t* out_bitmap,
+                                                                     uint32_t bitmap_size, uint32_t* out_concealed_num);
+
+/* Optional API function to change decoder to new picture header without close and init, threads and queues are kept
+  * and internal buffers are allocated again only when bigger are required.
+  * Call after svt_jpeg_xs_decoder_get_frame() returns SvtJxsErrorDecoderConfigChange and all frames sent to decoder
+  * are received back. Frames sent after frame with new header fail with SvtJxsErrorDecoderConfigChange and have to
+  * be sent again after reconfiguration. Parameters of region of interest are taken again from dec_api.
+  * Must not be called concurrently with other decoder API functions.
+  * Parameters:
+  * @ *dec_api - Decoder handle.
+  * @ *bitstream_buf - Bitstream with new picture header.
+  * @ codestream_size - Size of bitstream_buf.
+  * @ *out_image_config - Image configuration of new stream.
+  * Return non-fatal:
+  *  SvtJxsErrorNone - on success,
+  * Return fatal:
+  *  SvtJxsErrorDecoderInvalidPointer - when decoder handle in null or is not initialized
+  *  SvtJxsErrorBadParameter - when frames are still in decoder, decoder is not changed
+  * or any other from SvtJxsErrorType_t enum, then decoder can be only closed
+  **/
+PREFIX_API SvtJxsErrorType_t svt_jpeg_xs_decoder_reconfigure(svt_jpeg_xs_decoder_api_t* dec_api, const uint8_t* bitstream_buf,
+                                                             size_t codestream_size,
+                                                             svt_jpeg_xs_image_config_t* out_image_config);
+
 #ifdef __cplusplus
 }
 #endif // __cplusplus
@@ -15,11 +15,42 @@ extern "C" {
 #include <stdio.h>
 #include <stdlib.h>
 
+/* Size of band and GTLI dimensions of histogram in svt_jpeg_xs_rate_stats_t.*/
+#define SVT_JXS_BANDS_PER_COMPONENT_MAX (10)
+#define SVT_JXS_GTLI_VALUES_NUM         (16)
+
+/* Rate statistics of single slice.*/
+typedef struct svt_jpeg_xs_slice_rate_stats {
+    uint32_t bytes;         /* Size of slice in codestream with slice header, in last slice also with end of codestream marker*/
+    uint32_t padding_bytes; /* Padding written to slice to fill budget of slice*/
+    uint64_t distortion;    /* Distortion proxy of slice, see svt_jpeg_xs_rate_stats_t*/
+} svt_jpeg_xs_slice_rate_stats_t;
+
+/* Rate and quality statistics of single frame, collected only when stats_enable.
+ * GTLI (Greatest Trimmed Line Index) is the number of bit planes truncated in band of precinct,
+ * selected by rate control from quantization and refinement of precinct.
+ * Distortion proxy is a sum over coefficient groups of (2^T - 1)^2 * group size, where T = min(GCLI, GTLI)
+ * is the number of truncated bit planes of group. Not weighted by band gains, useful only to compare slices and frames
+ * of that same configuration.*/
+typedef struct svt_jpeg_xs_rate_stats {
+    uint64_t frame_num;     /* Frame number in order of send to library*/
+    uint32_t bytes;         /* Size of frame codestream*/
+    uint32_t padding_bytes; /* Padding in all slices*/
+    uint64_t distortion;    /* Distortion proxy of frame, sum of all slices*/
+    /* Number of precincts coded with GTLI, index [component][band in component][GTLI]*/
+    uint32_t gtli_histogram[MAX_COMPONENTS_NUM][SVT_JXS_BANDS_PER_COMPONENT_MAX][SVT_JXS_GTLI_VALUES_NUM];
+    uint32_t slices_num; /* Number of slices in frame*/
+    /* Set by caller of svt_jpeg_xs_encoder_get_rate_stats(): size of slices array,
+     * min(slices_alloc, slices_num) elements are copied, 0 - per slice statistics are not copied.*/
+    uint32_t slices_alloc;
+    svt_jpeg_xs_slice_rate_stats_t* slices; /* Statistics per slice, index slice number*/
+} svt_jpeg_xs_rate_stats_t;
+
 typedef struct svt_jpeg_xs_encoder_api {
     // Input Info
     uint32_t source_width;        /* Mandatory, The width of input source in units of picture luma pixels.*/
     uint32_t source_height;       /* Mandatory, The height of input source in units of picture luma pixels. */
-    uint8_t input_bit_depth;      /* Mandatory, Specifies the bit depth of input video. * 8 = 8 bit. * 10 = 10 bit. */
+    uint8_t input_bit_depth;      /* Mandatory, Specifies the bit depth of input video, 8 to 16. * 8 = 8 bit. * 10 = 10 bit. */
     ColourFormat_t colour_format; /* Mandatory, Specifies the chroma sub-sampling format of input video. */
     uint32_t bpp_numerator;       /* Mandatory, Specifies the bits per pixel. BPP value is fraction: */
     uint32_t bpp_denominator;     /* Optional, default 1, BPP = bpp_numerator / bpp_denominator; */
@@ -84,12 +115,56 @@ typedef struct svt_jpeg_xs_encoder_api {
 
     void* private_ptr; /*Private encoder pointer, do not touch!!! */
 
+    /* Optional, default NULL, Allocator used for all internal encoder memory, NULL - system allocator.
+     * Structure is copied on init.*/
+    svt_jpeg_xs_allocator_t* allocator;
+
+    /* Callback: Call when statistics of frame are ready, require stats_enable.
+     * Call from internal thread when whole frame is ready to get.
+     * Only one callback will be triggered at a time.
+     * Optional, default NULL */
+    void (*callback_frame_stats)(struct svt_jpeg_xs_encoder_api* encoder, const svt_jpeg_xs_frame_stats_t* stats, void* context);
+    void* callback_frame_stats_context;
+
+    /* Collect per frame statistics, read by callback_frame_stats or svt_jpeg_xs_encoder_get_frame_stats().
+     * 0 - disabled, 1 - enabled
+     * Optional, default 0 */
+    uint8_t stats_enable;
+
+    /* Pipeline depth: frames processed at once, each frame keeps own coefficient buffers in CPU profile.
+     * 1 gives minimum latency and memory, more frames absorb jitter of input and output.
+     * Optional, default 0 - 10 frames, max SVT_JXS_FRAMES_IN_PIPELINE_MAX */
+    uint8_t frames_in_pipeline;
+    /* Frames waiting in input queue before svt_jpeg_xs_encoder_send_picture() is blocked.
+     * Optional, default 0 - 10 frames, max SVT_JXS_FRAMES_IN_INPUT_QUEUE_MAX */
+    uint16_t frames_in_input_queue;
+
+    /* Input samples are IEEE half-float (FP16) linear values, 0.0 - black and 1.0 - white, values out of range are clipped.
+     * Requires input_bit_depth 16. Samples are mapped through quadratic non-linearity (NLT marker),
+     * decoder returns 16 bit integer linear samples.
+     * Optional, default 0 - integer samples */
+    uint8_t input_float16;
+
+    /* Order of slices on pack threads, used by low latency CPU profile when slices are not split to parts:
+     * 0 - interleaved, every slice is a separate task taken by first free thread
+     * 1 - chunked, every thread gets one range of contiguous slices, input lines shared by neighbour slices
+     *     and thread contexts stay in cache, less memory traffic per frame but first slices of frame are returned later
+     * Optional, default 0 */
+    uint8_t slice_scheduling;
+
+    /* Callback: Call when rate statistics of frame are ready, require stats_enable.
+     * Called from internal thread just after callback_frame_stats, slices array is valid only inside callback.
+     * Optional, default NULL */
+    void (*callback_rate_stats)(struct svt_jpeg_xs_encoder_api* encoder, const svt_jpeg_xs_rate_stats_t* stats, void* context);
+    void* callback_rate_stats_context;
+
     /* This padding is used to avoid changing the size of the public configuration struct
      * when new parameters are added in the future please follow these steps:
      * 1. Insert the new parameter as a member of this structure before the padding array.
      * 2. Decrease the size of the padding array by the size of the new parameter to keep the struct size unchanged.
+     * Last 2 bytes are taken by alignment of callback_rate_stats.
      */
-    uint8_t padding[64];
+    uint8_t padding[64 - 5 * sizeof(void*) - 4 * sizeof(uint8_t) - sizeof(uint16_t) - 2];
 } svt_jpeg_xs_encoder_api_t;
 
 /* STEP 0 (Optional): Set default encoder parameters.
@@ -121,6 +196,28 @@ PREFIX_API SvtJxsErrorType_t svt_jpeg_xs_encoder_init(uint64_t version_api_major
 /* STEP 4: */
 PREFIX_API void svt_jpeg_xs_encoder_close(svt_jpeg_xs_encoder_api_t* enc_api);
 
+/* STEP x: Get memory footprint of encoder. No need to init encoder.
+ * Computed from configuration, without creating encoder, allocating memory or starting threads.
+ * Parameter:
+ * @ version_api_major - Use version of API Major number (SVT_JPEGXS_API_VER_MAJOR)
+   @ version_api_minor - Use version of API Minor number (SVT_JPEGXS_API_VER_MINOR)
+ * @ *enc_api          - Encoder handle with configuration, allocator and callbacks are ignored
+ * @ *out_footprint    - Peak size in bytes of all internal allocations between init and close*/
+PREFIX_API SvtJxsErrorType_t svt_jpeg_xs_encoder_get_memory_footprint(uint64_t version_api_major, uint64_t version_api_minor,
+                                                                      const svt_jpeg_xs_encoder_api_t* enc_api,
+                                                                      size_t* out_footprint);
+
+/* STEP x: Get resources required by encoder: memory split per purpose, threads per stage and frames in pipeline.
+ * No need to init encoder. Computed from configuration, without creating encoder, allocating memory or starting threads.
+ * Parameter:
+ * @ version_api_major - Use version of API Major number (SVT_JPEGXS_API_VER_MAJOR)
+   @ version_api_minor - Use version of API Minor number (SVT_JPEGXS_API_VER_MINOR)
+ * @ *enc_api          - Encoder handle with configuration, allocator and callbacks are ignored
+ * @ *out_resources    - Resources of encoder with this configuration*/
+PREFIX_API SvtJxsErrorType_t svt_jpeg_xs_encoder_get_resources(uint64_t version_api_major, uint64_t version_api_minor,
+                                                               const svt_jpeg_xs_encoder_api_t* enc_api,
+                                                               svt_jpeg_xs_resources_t* out_resources);
+
 /* STEP 2: Send the picture.
  *
  * Parameter:
@@ -130,6 +227,17 @@ PREFIX_API void svt_jpeg_xs_encoder_close(svt_jpeg_xs_encoder_api_t* enc_api);
 PREFIX_API SvtJxsErrorType_t svt_jpeg_xs_encoder_send_picture(svt_jpeg_xs_encoder_api_t* enc_api, svt_jpeg_xs_frame_t* enc_input,
                                                               uint8_t blocking_flag);
 
+/* STEP x: Change rate of frames sent after this call, without init. Can be called from any thread.
+ * Rate of frames already sent is not changed.
+ * Parameter:
+ * @ *enc_api            Encoder handler.
+ * @ bpp_numerator       New bits per pixel numerator, bitstream buffer of next frames have to fit new bytes per frame.
+ * @ bpp_denominator     New bits per pixel denominator.
+ * @ rate_control_mode   New rate control mode, only change between budget per precinct modes (0, 1)
+ *                       or between budget per slice modes (2, 3) is supported.*/
+PREFIX_API SvtJxsErrorType_t svt_jpeg_xs_encoder_set_rate(svt_jpeg_xs_encoder_api_t* enc_api, uint32_t bpp_numerator,
+                                                          uint32_t bpp_denominator, uint32_t rate_control_mode);
+
 /* STEP 3: Receive packet.
  * Parameter:
  * @ *enc_api            Encoder handler.
@@ -141,6 +249,56 @@ PREFIX_API SvtJxsErrorType_t svt_jpeg_xs_encoder_send_picture(svt_jpeg_xs_encode
 PREFIX_API SvtJxsErrorType_t svt_jpeg_xs_encoder_get_packet(svt_jpeg_xs_encoder_api_t* enc_api, svt_jpeg_xs_frame_t* enc_output,
                                                             uint8_t blocking_flag);
 
+/* STEP x: Get statistics of last frame ready to get, require stats_enable.
+ * Parameter:
+ * @ *enc_api            Encoder handler.
+ * @ *out_stats          Statistics of last finished frame.
+ * Return SvtJxsErrorNoErrorEmptyQueue when no frame is finished yet.*/
+PREFIX_API SvtJxsErrorType_t svt_jpeg_xs_encoder_get_frame_stats(svt_jpeg_xs_encoder_api_t* enc_api,
+                                                                 svt_jpeg_xs_frame_stats_t* out_stats);
+
+/* STEP x: Get rate statistics of last frame ready to get, require stats_enable.
+ * Parameter:
+ * @ *enc_api            Encoder handler.
+ * @ *out_stats          Rate statistics of last finished frame, slices and slices_alloc are set by caller.
+ * Return SvtJxsErrorNoErrorEmptyQueue when no frame is finished yet.*/
+PREFIX_API SvtJxsErrorType_t svt_jpeg_xs_encoder_get_rate_stats(svt_jpeg_xs_encoder_api_t* enc_api,
+                                                                svt_jpeg_xs_rate_stats_t* out_stats);
+
+/* Batch of encoders sharing one set of slice threads, for many small streams encoded at once.
+ * Slices of all encoders in batch are calculated on threads of batch in order of send,
+ * every encoder keeps own configuration, input queue and output queue.*/
+typedef struct svt_jpeg_xs_encoder_batch {
+    uint32_t threads_num; /* Optional, default 0 (1 thread), Number of slice threads shared by encoders of batch.*/
+    void* private_ptr;
+} svt_jpeg_xs_encoder_batch_t;
+
+/* STEP x: Create threads of batch.
+ * Parameter:
+ * @ version_api_major - Use version of API Major number (SVT_JPEGXS_API_VER_MAJOR)
+   @ version_api_minor - Use version of API Minor number (SVT_JPEGXS_API_VER_MINOR)
+ * @ *batch            - Batch handle with threads_num set, release with svt_jpeg_xs_encoder_batch_close()*/
+PREFIX_API SvtJxsErrorType_t svt_jpeg_xs_encoder_batch_init(uint64_t version_api_major, uint64_t version_api_minor,
+                                                            svt_jpeg_xs_encoder_batch_t* batch);
+
+/* STEP x: Close batch, all encoders of batch have to be closed before.
+ * Return SvtJxsErrorBadParameter and keep batch unchanged when any encoder of batch is not closed.*/
+PREFIX_API SvtJxsErrorType_t svt_jpeg_xs_encoder_batch_close(svt_jpeg_xs_encoder_batch_t* batch);
+
+/* STEP 1 (Batch): Initialize encoder Handle like svt_jpeg_xs_encoder_init(), slices are calculated on threads of batch.
+ * Only low latency CPU profile (cpu_profile 0) is supported, threads_num of encoder is not used for slice threads.
+ * Pictures are sent and packets received per encoder by svt_jpeg_xs_encoder_send_picture() and
+ * svt_jpeg_xs_encoder_get_packet(), slices of every sent picture join shared queue of batch.
+ * Encoder is closed by svt_jpeg_xs_encoder_close().
+ * Parameter:
+ * @ version_api_major - Use version of API Major number (SVT_JPEGXS_API_VER_MAJOR)
+   @ version_api_minor - Use version of API Minor number (SVT_JPEGXS_API_VER_MINOR)
+ * @ *batch            - Initialized batch
+ * @ *enc_api          - Encoder handle with configuration*/
+PREFIX_API SvtJxsErrorType_t svt_jpeg_xs_encoder_batch_init_encoder(uint64_t version_api_major, uint64_t version_api_minor,
+                                                                    svt_jpeg_xs_encoder_batch_t* batch,
+                                                                    svt_jpeg_xs_encoder_api_t* enc_api);
+
 #ifdef __cplusplus
 }
 #endif // __cplusplus
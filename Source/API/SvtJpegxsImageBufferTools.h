@@ -5,13 +5,14 @@
 
 #ifndef _SVT_JPEG_XS_API_IMAGE_BUFFER_TOOLS_H_
 #define _SVT_JPEG_XS_API_IMAGE_BUFFER_TOOLS_H_
+#include <stddef.h>
 #include "SvtJpegxs.h"
 
 #ifdef __cplusplus
 extern "C" {
 #endif
 
-/*Allocate simple image YUV buffer
+/*Allocate simple image YUV buffer, every component is aligned to 64 bytes
  * Parameters:
  * @ image_config - Image config how much memory allocate.
  * Return:
@@ -55,6 +56,55 @@ typedef struct svt_jpeg_xs_frame_pool svt_jpeg_xs_frame_pool_t;
 PREFIX_API svt_jpeg_xs_frame_pool_t* svt_jpeg_xs_frame_pool_alloc(const svt_jpeg_xs_image_config_t* image_config,
                                                                   uint32_t bitstream_size, uint32_t count);
 
+/*Hugepage backing of frame pool memory*/
+typedef enum SvtJxsHugepages {
+    SVT_JXS_HUGEPAGES_NONE = 0,        /*Regular pages*/
+    SVT_JXS_HUGEPAGES_TRANSPARENT = 1, /*Anonymous mapping with madvise(MADV_HUGEPAGE), Linux only*/
+    SVT_JXS_HUGEPAGES_EXPLICIT = 2,    /*MAP_HUGETLB mapping, fallback to transparent when no hugepages are reserved, Linux only*/
+} SvtJxsHugepages_t;
+
+/*Memory placement of frame pool buffers.
+ *All buffers of the pool are carved out of one contiguous region, every component plane and bitstream buffer
+ *starts on an alignment boundary.*/
+typedef struct svt_jpeg_xs_frame_pool_config {
+    uint32_t alignment;          /*Power of two, 0 - default 64 bytes, 4096 to align buffers to pages*/
+    SvtJxsHugepages_t hugepages; /*Ignored when not supported by system*/
+    uint8_t use_numa_node;       /*1 - place pool memory on numa_node, 0 - first touch by calling thread. Linux only*/
+    uint32_t numa_node;          /*Preferred NUMA node of pool memory*/
+    /*Optional caller-owned memory region used as pool storage, NULL - pool allocates memory itself.
+     *Region have to be at least svt_jpeg_xs_frame_pool_get_memory_size() bytes, and valid until pool is freed.
+     *hugepages and NUMA node are ignored for caller-owned memory.*/
+    void* memory;
+    size_t memory_size;
+} svt_jpeg_xs_frame_pool_config_t;
+
+/*Allocate pool of image YUV and bitstream buffers with memory placement configuration
+ * Parameters:
+ * @ image_config - Image config how much memory allocate. If NULL, then image buffer will not be allocated for frames.
+ * @ bitstream_size - Bitstream buffers size. If 0, then bitstream buffer will not be allocated for frames.
+ * @ count - number of buffers to allocate
+ * @ pool_config - Memory placement, NULL - defaults, equal to svt_jpeg_xs_frame_pool_alloc()
+ * Return:
+ *  Pointer to allocated structure with buffers, or NULL - when allocation fail
+ **/
+PREFIX_API svt_jpeg_xs_frame_pool_t* svt_jpeg_xs_frame_pool_alloc_ex(const svt_jpeg_xs_image_config_t* image_config,
+                                                                     uint32_t bitstream_size, uint32_t count,
+                                                                     const svt_jpeg_xs_frame_pool_config_t* pool_config);
+
+/*Get size of memory region required by svt_jpeg_xs_frame_pool_alloc_ex() for caller-owned pool storage
+ * Parameters:
+ * @ image_config - Image config, can be NULL
+ * @ bitstream_size - Bitstream buffers size
+ * @ count - number of buffers
+ * @ alignment - Buffers alignment, 0 - default
+ * @ out_memory_size - Required size of memory region in bytes
+ * Return:
+ *  SvtJxsErrorNone - on success, SvtJxsErrorBadParameter - Invalid parameters
+ **/
+PREFIX_API SvtJxsErrorType_t svt_jpeg_xs_frame_pool_get_memory_size(const svt_jpeg_xs_image_config_t* image_config,
+                                                                    uint32_t bitstream_size, uint32_t count, uint32_t alignment,
+                                                                    size_t* out_memory_size);
+
 /*Free pool of image YUV and bitstream buffers
  * Parameters:
  * @ image_buffer_pool - Pointer on allocated pool of frames, have to be that same pointer as allocated by svt_jpeg_xs_frame_pool_alloc()
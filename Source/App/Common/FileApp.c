@@ -0,0 +1,269 @@
+/*
+* Copyright(c) 2024 Intel Corporation
+* SPDX - License - Identifier: BSD - 2 - Clause - Patent
+*/
+
+#ifndef _WIN32
+#ifndef _GNU_SOURCE
+#define _GNU_SOURCE /*O_DIRECT*/
+#endif
+#endif
+
+#include "FileApp.h"
+#include <stdlib.h>
+#include <string.h>
+
+#ifdef _WIN32
+#include <windows.h>
+#include <malloc.h>
+#else
+#include <errno.h>
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
+
+/*Fallback when file can not be mapped*/
+static SvtJxsErrorType_t app_file_read_all(AppFileMap_t* map, const char* filename) {
+    FILE* f = NULL;
+#ifdef _WIN32
+    fopen_s(&f, filename, "rb");
+#else
+    f = fopen(filename, "rb");
+#endif
+    if (!f) {
+        return SvtJxsErrorUndefined;
+    }
+    size_t alloc_size = 1 << 20;
+    map->data = (uint8_t*)malloc(alloc_size);
+    map->size = 0;
+    while (map->data) {
+        map->size += fread(map->data + map->size, 1, alloc_size - map->size, f);
+        if (map->size < alloc_size) {
+            break;
+        }
+        alloc_size *= 2;
+        uint8_t* data = (uint8_t*)realloc(map->data, alloc_size);
+        if (!data) {
+            free(map->data);
+        }
+        map->data = data;
+    }
+    int read_error = ferror(f);
+    fclose(f);
+    if (!map->data || read_error) {
+        free(map->data);
+        map->data = NULL;
+        map->size = 0;
+        return SvtJxsErrorInsufficientResources;
+    }
+    map->mapped = 0;
+    return SvtJxsErrorNone;
+}
+
+SvtJxsErrorType_t app_file_map_open(AppFileMap_t* map, const char* filename) {
+    memset(map, 0, sizeof(*map));
+#ifdef _WIN32
+    HANDLE file = CreateFileA(filename, GENERIC_READ, FILE_SHARE_READ, NULL, OPEN_EXISTING, FILE_FLAG_SEQUENTIAL_SCAN, NULL);
+    if (file == INVALID_HANDLE_VALUE) {
+        return SvtJxsErrorUndefined;
+    }
+    LARGE_INTEGER size;
+    if (GetFileSizeEx(file, &size) && size.QuadPart > 0 && (uint64_t)size.QuadPart <= (uint64_t)SIZE_MAX) {
+        HANDLE mapping = CreateFileMappingA(file, NULL, PAGE_READONLY, 0, 0, NULL);
+        if (mapping) {
+            void* data = MapViewOfFile(mapping, FILE_MAP_READ, 0, 0, 0);
+            if (data) {
+                map->data = (uint8_t*)data;
+                map->size = (size_t)size.QuadPart;
+                map->mapped = 1;
+                map->file_handle = file;
+                map->mapping_handle = mapping;
+                return SvtJxsErrorNone;
+            }
+            CloseHandle(mapping);
+        }
+    }
+    CloseHandle(file);
+#else
+    int fd = open(filename, O_RDONLY);
+    if (fd < 0) {
+        return SvtJxsErrorUndefined;
+    }
+    struct stat st;
+    if (fstat(fd, &st) == 0 && S_ISREG(st.st_mode) && st.st_size > 0 && (uint64_t)st.st_size <= (uint64_t)SIZE_MAX) {
+        void* data = mmap(NULL, (size_t)st.st_size, PROT_READ, MAP_PRIVATE, fd, 0);
+        if (data != MAP_FAILED) {
+            /*Codestream is read once from begin to end, let kernel read ahead and drop pages behind*/
+            posix_madvise(data, (size_t)st.st_size, POSIX_MADV_SEQUENTIAL);
+            map->data = (uint8_t*)data;
+            map->size = (size_t)st.st_size;
+            map->mapped = 1;
+            /*Mapping is valid after file is closed*/
+            close(fd);
+            return SvtJxsErrorNone;
+        }
+    }
+    close(fd);
+#endif
+    return app_file_read_all(map, filename);
+}
+
+void app_file_map_close(AppFileMap_t* map) {
+    if (!map->data) {
+        return;
+    }
+    if (map->mapped) {
+#ifdef _WIN32
+        UnmapViewOfFile(map->data);
+        CloseHandle((HANDLE)map->mapping_handle);
+        CloseHandle((HANDLE)map->file_handle);
+#else
+        munmap(map->data, map->size);
+#endif
+    }
+    else {
+        free(map->data);
+    }
+    memset(map, 0, sizeof(*map));
+}
+
+#ifndef _WIN32
+/*Write whole block, for O_DIRECT size have to be aligned unless direct mode was disabled before*/
+static SvtJxsErrorType_t app_file_writer_write_block(AppFileWriter_t* writer, const uint8_t* data, size_t size) {
+    while (size) {
+        ssize_t ret = write(writer->fd, data, size);
+        if (ret < 0) {
+            if (errno == EINTR) {
+                continue;
+            }
+#ifdef O_DIRECT
+            /*File system accepted O_DIRECT on open but not on write, continue with cached writes*/
+            if (errno == EINVAL && writer->direct) {
+                int flags = fcntl(writer->fd, F_GETFL);
+                if (flags != -1 && fcntl(writer->fd, F_SETFL, flags & ~O_DIRECT) == 0) {
+                    writer->direct = 0;
+                    continue;
+                }
+            }
+#endif
+            return SvtJxsErrorUndefined;
+        }
+        data += ret;
+        size -= (size_t)ret;
+    }
+    return SvtJxsErrorNone;
+}
+#endif
+
+static SvtJxsErrorType_t app_file_writer_flush(AppFileWriter_t* writer) {
+    if (!writer->buffer_used) {
+        return SvtJxsErrorNone;
+    }
+    SvtJxsErrorType_t ret;
+#ifdef _WIN32
+    ret = fwrite(writer->buffer, 1, writer->buffer_used, writer->file) == writer->buffer_used ? SvtJxsErrorNone
+                                                                                             : SvtJxsErrorUndefined;
+#else
+#ifdef O_DIRECT
+    if (writer->direct && (writer->buffer_used % APP_FILE_WRITER_ALIGNMENT)) {
+        /*Last not aligned block is written through page cache*/
+        int flags = fcntl(writer->fd, F_GETFL);
+        if (flags == -1 || fcntl(writer->fd, F_SETFL, flags & ~O_DIRECT)) {
+            return SvtJxsErrorUndefined;
+        }
+        writer->direct = 0;
+    }
+#endif
+    ret = app_file_writer_write_block(writer, writer->buffer, writer->buffer_used);
+#endif
+    writer->buffer_used = 0;
+    return ret;
+}
+
+SvtJxsErrorType_t app_file_writer_open(AppFileWriter_t* writer, const char* filename, uint8_t direct) {
+    memset(writer, 0, sizeof(*writer));
+    writer->buffer_size = APP_FILE_WRITER_BUFFER_SIZE;
+#ifdef _WIN32
+    /*Writes are already done in large blocks, page cache is not bypassed*/
+    (void)direct;
+    fopen_s(&writer->file, filename, "wb");
+    if (!writer->file) {
+        return SvtJxsErrorUndefined;
+    }
+    setvbuf(writer->file, NULL, _IONBF, 0);
+    writer->buffer = (uint8_t*)_aligned_malloc(writer->buffer_size, APP_FILE_WRITER_ALIGNMENT);
+    if (!writer->buffer) {
+        fclose(writer->file);
+        writer->file = NULL;
+        return SvtJxsErrorInsufficientResources;
+    }
+#else
+    writer->fd = -1;
+#ifdef O_DIRECT
+    if (direct) {
+        writer->fd = open(filename, O_WRONLY | O_CREAT | O_TRUNC | O_DIRECT, 0644);
+        writer->direct = writer->fd >= 0;
+    }
+#endif
+    if (writer->fd < 0) {
+        writer->fd = open(filename, O_WRONLY | O_CREAT | O_TRUNC, 0644);
+    }
+    if (writer->fd < 0) {
+        return SvtJxsErrorUndefined;
+    }
+#if defined(__APPLE__) && defined(F_NOCACHE)
+    if (direct) {
+        fcntl(writer->fd, F_NOCACHE, 1);
+    }
+#endif
+    void* buffer = NULL;
+    if (posix_memalign(&buffer, APP_FILE_WRITER_ALIGNMENT, writer->buffer_size)) {
+        close(writer->fd);
+        writer->fd = -1;
+        return SvtJxsErrorInsufficientResources;
+    }
+    writer->buffer = (uint8_t*)buffer;
+#endif
+    return SvtJxsErrorNone;
+}
+
+SvtJxsErrorType_t app_file_writer_write(AppFileWriter_t* writer, const void* data, size_t size) {
+    const uint8_t* src = (const uint8_t*)data;
+    while (size) {
+        size_t copy_size = writer->buffer_size - writer->buffer_used;
+        copy_size = copy_size < size ? copy_size : size;
+        memcpy(writer->buffer + writer->buffer_used, src, copy_size);
+        writer->buffer_used += copy_size;
+        src += copy_size;
+        size -= copy_size;
+        if (writer->buffer_used == writer->buffer_size) {
+            SvtJxsErrorType_t ret = app_file_writer_flush(writer);
+            if (ret) {
+                return ret;
+            }
+        }
+    }
+    return SvtJxsErrorNone;
+}
+
+SvtJxsErrorType_t app_file_writer_close(AppFileWriter_t* writer) {
+    if (!writer->buffer) {
+        return SvtJxsErrorNone;
+    }
+    SvtJxsErrorType_t ret = app_file_writer_flush(writer);
+#ifdef _WIN32
+    if (fclose(writer->file)) {
+        ret = SvtJxsErrorUndefined;
+    }
+    _aligned_free(writer->buffer);
+#else
+    if (close(writer->fd)) {
+        ret = SvtJxsErrorUndefined;
+    }
+    free(writer->buffer);
+#endif
+    memset(writer, 0, sizeof(*writer));
+    return ret;
+}
@@ -0,0 +1,48 @@
+/*
+* Copyright(c) 2024 Intel Corporation
+* SPDX - License - Identifier: BSD - 2 - Clause - Patent
+*/
+
+#ifndef __APP_FILE_H__
+#define __APP_FILE_H__
+#include <stdio.h>
+#include "SvtJpegxs.h"
+
+/*Input file mapped to memory, pages are read on first access so processing can start before whole file is read.
+ *When mapping is not possible (e.g. pipe or empty file) file is read to allocated buffer.*/
+typedef struct AppFileMap {
+    uint8_t* data;
+    size_t size;
+    uint8_t mapped; /*0 when data is allocated buffer*/
+#ifdef _WIN32
+    void* file_handle;
+    void* mapping_handle;
+#endif
+} AppFileMap_t;
+
+SvtJxsErrorType_t app_file_map_open(AppFileMap_t* map, const char* filename);
+void app_file_map_close(AppFileMap_t* map);
+
+#define APP_FILE_WRITER_ALIGNMENT   (4096)
+#define APP_FILE_WRITER_BUFFER_SIZE (8 * 1024 * 1024)
+
+/*Output file written in large aligned blocks, optionally with O_DIRECT to bypass page cache.
+ *Only last block at close can have size not aligned to APP_FILE_WRITER_ALIGNMENT.*/
+typedef struct AppFileWriter {
+    uint8_t* buffer;
+    size_t buffer_size;
+    size_t buffer_used;
+    uint8_t direct;
+#ifdef _WIN32
+    FILE* file;
+#else
+    int fd;
+#endif
+} AppFileWriter_t;
+
+/*direct - try to bypass page cache, fall back to cached writes when file system does not support it*/
+SvtJxsErrorType_t app_file_writer_open(AppFileWriter_t* writer, const char* filename, uint8_t direct);
+SvtJxsErrorType_t app_file_writer_write(AppFileWriter_t* writer, const void* data, size_t size);
+SvtJxsErrorType_t app_file_writer_close(AppFileWriter_t* writer);
+
+#endif /*__APP_FILE_H__*/
@@ -21,7 +21,7 @@
 uint32_t global_stride_add = 100;
 #endif
 
-int32_t write_frame(svt_jpeg_xs_image_config_t* image_config, svt_jpeg_xs_image_buffer_t* image_buffer, FILE* f_out) {
+int32_t write_frame(svt_jpeg_xs_image_config_t* image_config, svt_jpeg_xs_image_buffer_t* image_buffer, AppFileWriter_t* f_out) {
 #if TEST_STRIDE
     uint32_t pixel_size = image_config->bit_depth <= 8 ? sizeof(uint8_t) : sizeof(uint16_t);
 #endif
@@ -33,19 +33,16 @@ int32_t write_frame(svt_jpeg_xs_image_config_t* image_config, svt_jpeg_xs_image_
         uint32_t width = width_stride - global_stride_add;
         uint32_t line_size_stride = width_stride * pixel_size;
         uint32_t line_size = width * pixel_size;
-        uint32_t write_size = 0;
         for (uint32_t h = 0; h < image_config->components[c].height; ++h) {
-            write_size += (uint32_t)fwrite(((uint8_t*)image_buffer->data_yuv[c]) + yuv_offset, 1, line_size, f_out);
+            if (app_file_writer_write(f_out, ((uint8_t*)image_buffer->data_yuv[c]) + yuv_offset, line_size)) {
+                fprintf(stderr, "error while writing to file!\n");
+                return 1;
+            }
             yuv_offset += line_size_stride;
         }
-        if (image_config->components[c].height * line_size != write_size) {
-            fprintf(stderr, "error while writing to file!\n");
-            return 1;
-        }
 #else
         uint32_t byte_size = image_config->components[c].byte_size;
-        size_t ret = fwrite(image_buffer->data_yuv[c], 1, byte_size, f_out);
-        if (ret != byte_size) {
+        if (app_file_writer_write(f_out, image_buffer->data_yuv[c], byte_size)) {
             fprintf(stderr, "error while writing to file!\n");
             return -1;
         }
@@ -54,24 +51,190 @@ int32_t write_frame(svt_jpeg_xs_image_config_t* image_config, svt_jpeg_xs_image_
     return 0;
 }
 
-SvtJxsErrorType_t read_data_from_file(FILE* f, uint8_t* buf, size_t size) {
-    if (f == NULL) {
-        return SvtJxsErrorUndefined;
-    }
-    size_t read_size = fread(buf, 1, size, f);
-    if (read_size != size) {
-        fprintf(stderr, "Error while reading file, read=%zu bytes, expected=%zu bytes\n", read_size, size);
-        return SvtJxsErrorUndefined;
-    }
-    return SvtJxsErrorNone;
-}
-
 #define DEC_OK                 (0)
 #define DEC_IGNORE_SOME_FRAMES (1)
 #define DEC_INVALID_BITSTREAM  (2)
 #define DEC_CAN_NOT_DECODE     (3)
 #define DEC_INVALID_PARAMETER  (4)
 
+/*Frames scanned ahead of send thread, scan is paused when index thread is so many frames ahead*/
+#define DEC_APP_SCAN_AHEAD_FRAMES 16
+
+typedef struct DecAppFrameEntry {
+    size_t offset; /*From bitstream_buf_ref*/
+    uint32_t frame_size;
+    uint32_t slices_num;
+    size_t slice_offsets_pos; /*First slice of frame in slice_offsets*/
+} DecAppFrameEntry_t;
+
+/*Frames found by index thread in parallel with decoding, send thread feed frames straight from input mapping.
+ *Index is kept for whole input, so frames are not scanned again when input is decoded in loop.*/
+typedef struct DecAppFrameIndex {
+    void* lock;        /*Binary semaphore, protect all fields below*/
+    void* frame_found; /*Posted for every frame found and when scan is finished*/
+    void* scan_ahead;  /*Posted for every frame sent first time and on quit*/
+    DecAppFrameEntry_t* frames;
+    size_t frames_num;
+    size_t frames_alloc;
+    uint32_t* slice_offsets;
+    size_t slice_offsets_num;
+    size_t slice_offsets_alloc;
+    uint8_t finished;
+    uint8_t quit;
+} DecAppFrameIndex_t;
+
+static void frame_index_free(DecAppFrameIndex_t* frame_index) {
+    if (!frame_index) {
+        return;
+    }
+    if (frame_index->lock) {
+        semaphore_destroy(frame_index->lock);
+    }
+    if (frame_index->frame_found) {
+        semaphore_destroy(frame_index->frame_found);
+    }
+    if (frame_index->scan_ahead) {
+        semaphore_destroy(frame_index->scan_ahead);
+    }
+    free(frame_index->frames);
+    free(frame_index->slice_offsets);
+    free(frame_index);
+}
+
+static DecAppFrameIndex_t* frame_index_alloc(void) {
+    DecAppFrameIndex_t* frame_index = (DecAppFrameIndex_t*)calloc(1, sizeof(DecAppFrameIndex_t));
+    if (!frame_index) {
+        return NULL;
+    }
+    frame_index->lock = semaphore_create(1, 1);
+    frame_index->frame_found = semaphore_create(0, INT32_MAX);
+    frame_index->scan_ahead = semaphore_create(DEC_APP_SCAN_AHEAD_FRAMES, INT32_MAX);
+    if (!frame_index->lock || !frame_index->frame_found || !frame_index->scan_ahead) {
+        frame_index_free(frame_index);
+        return NULL;
+    }
+    return frame_index;
+}
+
+static SvtJxsErrorType_t frame_index_add(DecAppFrameIndex_t* frame_index, size_t offset, const svt_jpeg_xs_frame_index_t* index) {
+    SvtJxsErrorType_t ret = SvtJxsErrorNone;
+    semaphore_block(frame_index->lock, -1);
+    if (frame_index->frames_num == frame_index->frames_alloc) {
+        size_t alloc = frame_index->frames_alloc ? 2 * frame_index->frames_alloc : 256;
+        DecAppFrameEntry_t* frames = (DecAppFrameEntry_t*)realloc(frame_index->frames, alloc * sizeof(DecAppFrameEntry_t));
+        if (frames) {
+            frame_index->frames = frames;
+            frame_index->frames_alloc = alloc;
+        }
+    }
+    if (frame_index->slice_offsets_num + index->slices_num > frame_index->slice_offsets_alloc) {
+        size_t alloc = 2 * (frame_index->slice_offsets_num + index->slices_num);
+        uint32_t* slice_offsets = (uint32_t*)realloc(frame_index->slice_offsets, alloc * sizeof(uint32_t));
+        if (slice_offsets) {
+            frame_index->slice_offsets = slice_offsets;
+            frame_index->slice_offsets_alloc = alloc;
+        }
+    }
+    if (frame_index->frames_num < frame_index->frames_alloc &&
+        frame_index->slice_offsets_num + index->slices_num <= frame_index->slice_offsets_alloc) {
+        DecAppFrameEntry_t* entry = &frame_index->frames[frame_index->frames_num++];
+        entry->offset = offset;
+        entry->frame_size = index->frame_size;
+        entry->slices_num = index->slices_num;
+        entry->slice_offsets_pos = frame_index->slice_offsets_num;
+        memcpy(frame_index->slice_offsets + frame_index->slice_offsets_num,
+               index->slice_offsets,
+               index->slices_num * sizeof(uint32_t));
+        frame_index->slice_offsets_num += index->slices_num;
+    }
+    else {
+        ret = SvtJxsErrorInsufficientResources;
+    }
+    semaphore_post(frame_index->lock);
+    semaphore_post(frame_index->frame_found);
+    return ret;
+}
+
+/*Copy frame of index, wait until frame is scanned. Return 1 when found, 0 when input has no such frame, -1 on error*/
+static int32_t frame_index_get(DecAppFrameIndex_t* frame_index, size_t frame_idx, DecAppFrameEntry_t* entry,
+                               uint32_t** slice_offsets, size_t* slice_offsets_alloc) {
+    for (;;) {
+        int32_t found = 0;
+        semaphore_block(frame_index->lock, -1);
+        uint8_t finished = frame_index->finished;
+        if (frame_idx < frame_index->frames_num) {
+            *entry = frame_index->frames[frame_idx];
+            found = 1;
+            if (entry->slices_num > *slice_offsets_alloc) {
+                uint32_t* buffer = (uint32_t*)realloc(*slice_offsets, entry->slices_num * sizeof(uint32_t));
+                if (buffer) {
+                    *slice_offsets = buffer;
+                    *slice_offsets_alloc = entry->slices_num;
+                }
+                else {
+                    found = -1;
+                }
+            }
+            if (found > 0) {
+                memcpy(*slice_offsets,
+                       frame_index->slice_offsets + entry->slice_offsets_pos,
+                       entry->slices_num * sizeof(uint32_t));
+            }
+        }
+        semaphore_post(frame_index->lock);
+        if (found || finished) {
+            return found;
+        }
+        semaphore_block(frame_index->frame_found, -1);
+    }
+}
+
+static void* thread_index(void* arg) {
+    DecoderConfig_t* config_dec = (DecoderConfig_t*)arg;
+    DecAppFrameIndex_t* frame_index = config_dec->frame_index;
+    size_t offset = config_dec->bitstream_offset;
+
+    svt_jpeg_xs_frame_scanner_t scanner;
+    if (svt_jpeg_xs_frame_scanner_init(&scanner) != SvtJxsErrorNone) {
+        fprintf(stderr, "Failed to allocate frame scanner!!! \n");
+    }
+    else {
+        /*Scanner find frame size and slices in one pass, decoder reuse slices from index*/
+        while (offset < config_dec->bitstream_buf_size) {
+            semaphore_block(frame_index->scan_ahead, -1);
+            semaphore_block(frame_index->lock, -1);
+            uint8_t quit = frame_index->quit;
+            semaphore_post(frame_index->lock);
+            if (quit) {
+                break;
+            }
+            svt_jpeg_xs_frame_index_t index;
+            size_t frame_size = 0;
+            SvtJxsErrorType_t ret = svt_jpeg_xs_frame_scanner_feed(
+                &scanner, config_dec->bitstream_buf_ref + offset, config_dec->bitstream_buf_size - offset, &frame_size, &index);
+            if (ret == SvtJxsErrorDecoderBitstreamTooShort) {
+                fprintf(stderr, "Last frame in file is invalid!!! \n");
+                break;
+            }
+            if (ret != SvtJxsErrorNone || frame_index_add(frame_index, offset, &index) != SvtJxsErrorNone) {
+                break;
+            }
+            offset += frame_size;
+            if (config_dec->frames_count && frame_index->frames_num >= config_dec->frames_count) {
+                /*No more frames will be decoded*/
+                break;
+            }
+        }
+        svt_jpeg_xs_frame_scanner_close(&scanner);
+    }
+
+    semaphore_block(frame_index->lock, -1);
+    frame_index->finished = 1;
+    semaphore_post(frame_index->lock);
+    semaphore_post(frame_index->frame_found);
+    return NULL;
+}
+
 static void* thread_send(void* arg) {
     DecoderConfig_t* config_dec = (DecoderConfig_t*)arg;
 
@@ -80,45 +243,51 @@ static void* thread_send(void* arg) {
         fps_interval_ms = 1000.0 / config_dec->limit_fps;
     }
 
-    uint8_t* bitstream_ptr = config_dec->bitstream_buf_ref + config_dec->bitstream_offset;
-    uint64_t bitstream_size = config_dec->bitstream_buf_size - config_dec->bitstream_offset;
+    DecAppFrameIndex_t* frame_index = config_dec->frame_index;
 
     uint64_t thread_start_time[2];
     get_current_time(&thread_start_time[0], &thread_start_time[1]);
 
-    uint8_t file_end = 0;
     uint64_t send_frames = 0;
+    size_t frame_idx = 0;
+    uint8_t loop = 0;
+    uint32_t* slice_offsets = NULL;
+    size_t slice_offsets_alloc = 0;
 
     do {
-        uint32_t frame_size = 0;
-        SvtJxsErrorType_t ret = svt_jpeg_xs_decoder_get_single_frame_size_with_proxy(
-            bitstream_ptr, bitstream_size, NULL, &frame_size, 1, config_dec->decoder.proxy_mode);
-        if (ret != SvtJxsErrorNone) {
+        DecAppFrameEntry_t entry;
+        int32_t found = frame_index_get(frame_index, frame_idx, &entry, &slice_offsets, &slice_offsets_alloc);
+        if (found < 0) {
+            fprintf(stderr, "Failed to allocate frame index!!! \n");
             break;
         }
-        if (frame_size > bitstream_size) {
-            fprintf(stderr, "Last frame in file is invalid!!! \n");
-            break;
+        if (!found) {
+            if (frame_idx == 0 || config_dec->frames_count == 0) {
+                break;
+            }
+            /*Decode input in loop until frames_count is reached*/
+            frame_idx = 0;
+            loop = 1;
+            continue;
+        }
+        frame_idx++;
+        if (!loop) {
+            semaphore_post(frame_index->scan_ahead);
         }
 
+        svt_jpeg_xs_frame_index_t index;
+        index.frame_size = entry.frame_size;
+        index.slices_num = entry.slices_num;
+        index.slice_offsets = slice_offsets;
+
         svt_jpeg_xs_bitstream_buffer_t bitstream;
-        bitstream.buffer = bitstream_ptr;
-        bitstream.used_size = frame_size;
-        bitstream.allocation_size = frame_size;
-
-        if (frame_size == bitstream_size) {
-            file_end = 1;
-            bitstream_ptr = config_dec->bitstream_buf_ref + config_dec->bitstream_offset;
-            bitstream_size = config_dec->bitstream_buf_size - config_dec->bitstream_offset;
-        }
-        else {
-            bitstream_ptr += frame_size;
-            bitstream_size -= frame_size;
-        }
+        bitstream.buffer = config_dec->bitstream_buf_ref + entry.offset;
+        bitstream.used_size = entry.frame_size;
+        bitstream.allocation_size = entry.frame_size;
 
         svt_jpeg_xs_frame_t dec_input;
         dec_input.user_prv_ctx_ptr = NULL;
-        ret = svt_jpeg_xs_frame_pool_get(config_dec->frame_pool, &dec_input, /*blocking*/ 1);
+        SvtJxsErrorType_t ret = svt_jpeg_xs_frame_pool_get(config_dec->frame_pool, &dec_input, /*blocking*/ 1);
         if (ret != SvtJxsErrorNone) {
             break;
         }
@@ -150,13 +319,14 @@ static void* thread_send(void* arg) {
             dec_input.user_prv_ctx_ptr = user_data;
         }
 
-        ret = svt_jpeg_xs_decoder_send_frame(&config_dec->decoder, &dec_input, /*blocking*/ 1);
+        ret = svt_jpeg_xs_decoder_send_frame_with_index(&config_dec->decoder, &dec_input, &index, /*blocking*/ 1);
         if (ret != SvtJxsErrorNone) {
             break;
         }
         send_frames++;
-    } while ((config_dec->frames_count == 0 && !file_end) || send_frames < config_dec->frames_count);
+    } while (config_dec->frames_count == 0 || send_frames < config_dec->frames_count);
 
+    free(slice_offsets);
     svt_jpeg_xs_decoder_send_eoc(&config_dec->decoder);
 
     return NULL;
@@ -257,6 +427,7 @@ int32_t main(int32_t argc, char* argv[]) {
     // GLOBAL VARIABLES
     SvtJxsErrorType_t return_error = SvtJxsErrorNone; // Error Handling
     void* thread_send_handle = NULL;
+    void* thread_index_handle = NULL;
 
     // Initialize config
     DecoderConfig_t config_dec;
@@ -287,16 +458,14 @@ int32_t main(int32_t argc, char* argv[]) {
         goto fail;
     }
 
-    FOPEN(config_dec.in_file, config_dec.in_filename, "rb");
-    if (!config_dec.in_file) {
+    if (app_file_map_open(&config_dec.in_map, config_dec.in_filename) != SvtJxsErrorNone) {
         fprintf(stderr, "Invalid input file \n");
         return_error = DEC_INVALID_PARAMETER;
         goto fail;
     }
 
     if (config_dec.out_filename[0]) {
-        FOPEN(config_dec.out_file, config_dec.out_filename, "wb");
-        if (!config_dec.out_file) {
+        if (app_file_writer_open(&config_dec.out_writer, config_dec.out_filename, config_dec.out_direct) != SvtJxsErrorNone) {
             fprintf(stderr, "Invalid output file \n");
             return_error = DEC_INVALID_PARAMETER;
             goto fail;
@@ -308,27 +477,15 @@ int32_t main(int32_t argc, char* argv[]) {
         goto fail;
     }
 
-    config_dec.bitstream_buf_size = get_file_size(config_dec.in_file);
+    /*Frames are sent to decoder straight from mapping, without copy of whole input*/
+    config_dec.bitstream_buf_ref = config_dec.in_map.data;
+    config_dec.bitstream_buf_size = config_dec.in_map.size;
     if (config_dec.bitstream_buf_size <= 0) {
         fprintf(stderr, "Unable to open file %s\n", config_dec.in_filename);
         return_error = DEC_INVALID_BITSTREAM;
         goto fail;
     }
 
-    config_dec.bitstream_buf_ref = (uint8_t*)malloc(config_dec.bitstream_buf_size);
-    if (!config_dec.bitstream_buf_ref) {
-        fprintf(stderr, "Unable allocate memory for read file\n");
-        return_error = DEC_CAN_NOT_DECODE;
-        goto fail;
-    }
-
-    SvtJxsErrorType_t ret = read_data_from_file(config_dec.in_file, config_dec.bitstream_buf_ref, config_dec.bitstream_buf_size);
-    if (ret) {
-        fprintf(stderr, "Unable to read file %s\n", config_dec.in_filename);
-        return_error = DEC_INVALID_BITSTREAM;
-        goto fail;
-    }
-
     if (config_dec.autodetect_bitstream_header) {
         int find = 0;
         for (size_t i = 0; i < config_dec.bitstream_buf_size - 4; ++i) {
@@ -349,12 +506,13 @@ int32_t main(int32_t argc, char* argv[]) {
 
     /*First frame consistency test.*/
     uint32_t frame_size = 0;
-    ret = svt_jpeg_xs_decoder_get_single_frame_size_with_proxy(config_dec.bitstream_buf_ref + config_dec.bitstream_offset,
-                                                               config_dec.bitstream_buf_size - config_dec.bitstream_offset,
-                                                               &config_dec.image_config,
-                                                               &frame_size,
-                                                               1,
-                                                               config_dec.decoder.proxy_mode);
+    SvtJxsErrorType_t ret = svt_jpeg_xs_decoder_get_single_frame_size_with_proxy(
+        config_dec.bitstream_buf_ref + config_dec.bitstream_offset,
+        config_dec.bitstream_buf_size - config_dec.bitstream_offset,
+        &config_dec.image_config,
+        &frame_size,
+        1,
+        config_dec.decoder.proxy_mode);
     if (ret != SvtJxsErrorNone) {
         fprintf(stderr, "Unable to get first frame size, input codestream (%s)\n", config_dec.in_filename);
         return_error = DEC_INVALID_BITSTREAM;
@@ -428,6 +586,15 @@ int32_t main(int32_t argc, char* argv[]) {
         thread_send_handle = app_create_thread(thread_send_packet, &config_dec);
     }
     else {
+        config_dec.frame_index = frame_index_alloc();
+        if (config_dec.frame_index == NULL) {
+            fprintf(stderr, "Failed to allocate frame index!!! \n");
+            goto fail;
+        }
+        thread_index_handle = app_create_thread(thread_index, &config_dec);
+        if (thread_index_handle == NULL) {
+            goto fail;
+        }
         thread_send_handle = app_create_thread(thread_send, &config_dec);
     }
     if (thread_send_handle == NULL) {
@@ -463,8 +630,14 @@ int32_t main(int32_t argc, char* argv[]) {
 
         frames_received++;
         if (ret == SvtJxsErrorNone) {
-            if (config_dec.out_file != NULL) {
-                write_frame(&config_dec.image_config, &dec_output.image, config_dec.out_file);
+            if (config_dec.out_writer.buffer != NULL) {
+                write_frame(&config_dec.image_config, &dec_output.image, &config_dec.out_writer);
+            }
+            uint32_t concealed_num = 0;
+            if (config_dec.decoder.slice_concealment &&
+                svt_jpeg_xs_decoder_get_concealed_slices(&config_dec.decoder, NULL, 0, &concealed_num) == SvtJxsErrorNone &&
+                concealed_num) {
+                fprintf(stderr, "\nFrame %lu: %u slices concealed\n", (unsigned long)frames_received, concealed_num);
             }
             if (config_dec.decoder.verbose >= VERBOSE_INFO_MULTITHREADING) {
                 fprintf(stderr, "Release frame received_frame %lu\n", (unsigned long)frames_received);
@@ -521,21 +694,21 @@ fail:
     if (thread_send_handle) {
         app_destroy_thread(thread_send_handle);
     }
+    if (thread_index_handle) {
+        semaphore_block(config_dec.frame_index->lock, -1);
+        config_dec.frame_index->quit = 1;
+        semaphore_post(config_dec.frame_index->lock);
+        semaphore_post(config_dec.frame_index->scan_ahead);
+        app_destroy_thread(thread_index_handle);
+    }
+    frame_index_free(config_dec.frame_index);
     svt_jpeg_xs_frame_pool_free(config_dec.frame_pool);
     svt_jpeg_xs_decoder_close(&config_dec.decoder);
 
-    if (config_dec.in_file) {
-        fclose(config_dec.in_file);
-        config_dec.in_file = NULL;
-    }
-
-    if (config_dec.out_file) {
-        fclose(config_dec.out_file);
-        config_dec.out_file = NULL;
-    }
+    app_file_map_close(&config_dec.in_map);
 
-    if (config_dec.bitstream_buf_ref) {
-        free(config_dec.bitstream_buf_ref);
+    if (app_file_writer_close(&config_dec.out_writer) != SvtJxsErrorNone) {
+        fprintf(stderr, "error while writing to file!\n");
     }
 
     return return_error;
@@ -30,6 +30,8 @@
 #define LIMIT_FPS_TOKEN              "--limit-fps"
 #define PACKETIZATION_MODE           "--packetization-mode"
 #define PROXY_MODE                   "--proxy-mode"
+#define SLICE_CONCEALMENT            "--slice-concealment"
+#define OUTPUT_DIRECT_TOKEN          "--output-direct"
 #define MAX_NUM_TOKENS               200
 
 static void strncpy_local(char* dest, const char* src, size_t count) {
@@ -56,6 +58,10 @@ static void set_cfg_output_file(const char* value, DecoderConfig_t* cfg) {
     strncpy_local(cfg->out_filename, value, sizeof(cfg->out_filename));
 };
 
+static void set_output_direct(const char* value, DecoderConfig_t* cfg) {
+    cfg->out_direct = (uint8_t)strtoul(value, NULL, 0);
+};
+
 static void set_find_header(const char* value, DecoderConfig_t* cfg) {
     cfg->autodetect_bitstream_header = 1;
     UNUSED(value);
@@ -144,6 +150,10 @@ static void set_proxy_mode(const char* value, DecoderConfig_t* cfg) {
     }
 }
 
+static void set_slice_concealment(const char* value, DecoderConfig_t* cfg) {
+    cfg->decoder.slice_concealment = (uint8_t)strtoul(value, NULL, 0);
+}
+
 /**********************************
  * Config Entry Struct
  **********************************/
@@ -174,7 +184,9 @@ ConfigEntry config_entry[] = {
     {INPUT_OPTIONS, LIMIT_FPS_TOKEN,             "Limit number of frames per second (disabled: 0, enabled [1-240])", 0, 1, set_limit_fps},
     {INPUT_OPTIONS, PACKETIZATION_MODE,          "Specify how bitstream is passed to decoder(multiple packets per frame:1, single packet per frame:0, default:0)", 0, 1, set_packetization_mode},
     {OUTPUT_OPTIONS, OUTPUT_FILE_TOKEN,         "Output Filename", 0, 1, set_cfg_output_file},
+    {OUTPUT_OPTIONS, OUTPUT_DIRECT_TOKEN,       "Write output bypassing page cache (O_DIRECT) in large aligned blocks (disabled: 0, enabled: 1, default: 0)", 0, 1, set_output_direct},
     {OUTPUT_OPTIONS, PROXY_MODE,                "Resolution scaling mode(disabled: 0, scale 1/2: 1, scale 1/4: 2, default: 0)", 0, 1, set_proxy_mode},
+    {OUTPUT_OPTIONS, SLICE_CONCEALMENT,         "Fill invalid slices with mid-grey instead of drop of frame(disabled: 0, enabled: 1, default: 0)", 0, 1, set_slice_concealment},
     {THREAD_PERF_OPTIONS, ASM_TYPE_TOKEN,       "Limit assembly instruction set [0 - 11] or [c, mmx, sse, sse2, sse3, "
                                                 "ssse3, sse4_1, sse4_2,"
                                                 " avx, avx2, avx512, max], by default highest level supported by CPU", 0, 1,
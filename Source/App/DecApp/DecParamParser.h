@@ -16,6 +16,7 @@
 #include <string.h>
 #include "SvtJpegxsDec.h"
 #include "SvtJpegxsImageBufferTools.h"
+#include "FileApp.h"
 
 #define UNUSED(x) (void)(x)
 
@@ -23,13 +24,15 @@ typedef struct DecoderConfig {
     char in_filename[1024];
     char out_filename[1024];
 
-    FILE* in_file;
-    FILE* out_file;
+    AppFileMap_t in_map;
+    AppFileWriter_t out_writer;
+    uint8_t out_direct; /*Write output bypassing page cache*/
 
     int autodetect_bitstream_header;
-    uint8_t* bitstream_buf_ref;
+    uint8_t* bitstream_buf_ref; /*Input file mapped to memory*/
     size_t bitstream_buf_size;
     size_t bitstream_offset;
+    struct DecAppFrameIndex* frame_index;
 
     uint32_t frames_count;
     uint32_t force_decode;
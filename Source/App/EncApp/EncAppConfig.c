@@ -49,14 +49,17 @@ static void strncpy_local(char *dest, const char *src, size_t count) {
 #define SLICE_HEIGHT_TOKEN      "--slice-height"
 #define ENCODER_COLOUR_FORMAT   "--colour-format"
 #define INPUT_DEPTH_TOKEN       "--input-depth"
+#define INPUT_FLOAT16_TOKEN     "--input-float16"
 
 #define OUTPUT_BITSTREAM_TOKEN "-b"
+#define OUTPUT_DIRECT_TOKEN    "--output-direct"
 #define NO_PROGRESS_TOKEN      "--no-progress" // tbd if it should be removed
 #define STATS_REPORT_TOKEN     "--stat-report"
 
 #define ASM_TYPE_TOKEN     "--asm"
 #define PROFILE_TYPE_TOKEN "--profile"
 #define THREAD_MGMNT       "--lp"
+#define SLICE_SCHEDULING   "--slice-scheduling"
 #define FRAMES_COUNT_TOKEN "-n"
 // double dash
 #define PRESET_TOKEN "--preset"
@@ -84,6 +87,10 @@ static void set_cfg_stream_file(const char *value, EncoderConfig_t *cfg) {
     strncpy_local(cfg->out_filename, value, sizeof(cfg->out_filename));
 }
 
+static void set_output_direct(const char *value, EncoderConfig_t *cfg) {
+    cfg->out_direct = (uint8_t)strtoul(value, NULL, 0);
+}
+
 static void set_cfg_source_width(const char *value, EncoderConfig_t *cfg) {
     cfg->encoder.source_width = strtoul(value, NULL, 0);
 }
@@ -113,6 +120,10 @@ static void set_input_bit_depth(const char *value, EncoderConfig_t *cfg) {
     cfg->encoder.input_bit_depth = (uint8_t)strtoul(value, NULL, 0);
 }
 
+static void set_input_float16(const char *value, EncoderConfig_t *cfg) {
+    cfg->encoder.input_float16 = (uint8_t)strtoul(value, NULL, 0);
+}
+
 static void coding_signs_handling(const char *value, EncoderConfig_t *cfg) {
     cfg->encoder.coding_signs_handling = strtoul(value, NULL, 0);
 }
@@ -267,6 +278,10 @@ static void set_verbose(const char *value, EncoderConfig_t *cfg) {
     cfg->encoder.verbose = strtoul(value, NULL, 0);
 };
 
+static void set_slice_scheduling(const char *value, EncoderConfig_t *cfg) {
+    cfg->encoder.slice_scheduling = (uint8_t)strtoul(value, NULL, 0);
+};
+
 static void set_packetization_mode(const char *value, EncoderConfig_t *cfg) {
     cfg->encoder.slice_packetization_mode = (uint8_t)strtoul(value, NULL, 0);
 };
@@ -301,10 +316,12 @@ ConfigEntry config_entry[] = {
     {INPUT_OPTIONS, HEIGHT_TOKEN,           "Frame height", 1, 1, set_cfg_source_height},
     {INPUT_OPTIONS, ENCODER_COLOUR_FORMAT,  "Set encoder colour format (yuv420, yuv422) (Experimental: yuv400, yuv444, rgb(planar), rgbp(packed))", 1, 1, set_encoder_colour_format},
     {INPUT_OPTIONS, INPUT_DEPTH_TOKEN,      "Input depth", 1, 1, set_input_bit_depth},
+    {INPUT_OPTIONS, INPUT_FLOAT16_TOKEN,    "Input samples are half-float linear 0.0 to 1.0, require input depth 16 (enabled:1, disable:0, default:0)", 0, 1, set_input_float16},
     {INPUT_OPTIONS, COMPRESS_BPP_LONG_TOKEN,"Bits Per Pixel, can be passed as integer or float (example: 0.5, 3, 3.75, 5 etc.)", 1, 1, set_encoder_bpp},
     {INPUT_OPTIONS, FRAMES_COUNT_TOKEN,     "Number of frames to encode", 0, 1, set_cfg_frames_count},
     {INPUT_OPTIONS, LIMIT_FPS_TOKEN,        "Limit number of frames per second (disabled: 0, enabled [1-240])", 0, 1, set_limit_fps},
     {OUTPUT_OPTIONS, OUTPUT_BITSTREAM_TOKEN,"Output filename", 0, 1, set_cfg_stream_file},
+    {OUTPUT_OPTIONS, OUTPUT_DIRECT_TOKEN,   "Write output bypassing page cache (O_DIRECT) in large aligned blocks (disabled: 0, enabled: 1, default: 0)", 0, 1, set_output_direct},
     {OUTPUT_OPTIONS, NO_PROGRESS_TOKEN,     "Do not print out progress (no print:1, print:0, default:0)", 0, 1, set_no_progress},
     {OUTPUT_OPTIONS, PACKETIZATION_MODE,    "Specify how encoded stream is returned (multiple packets per frame:1, single packet per frame:0, default:0)", 0, 1, set_packetization_mode},
     {CODING_OPTIONS, DECOMP_V_LONG_TOKEN,   "Vertical decomposition (0, 1, 2, default: 2)", 0, 1, set_encoder_decomp_v},
@@ -321,6 +338,7 @@ ConfigEntry config_entry[] = {
                                             set_asm_type},
     {THREAD_PERF_OPTIONS, PROFILE_TYPE_TOKEN,"Profile of CPU use. 0:latency Low Latency mode, 1:cpu Low CPU use mode [latency:0, cpu:1, default: 0]", 0, 1, set_profile_type},
     {THREAD_PERF_OPTIONS, THREAD_MGMNT,     "Thread Scaling parameter, the higher the value the more threads are created and thus lower latency and/or higher FPS can be achieved (default: 0, which means lowest possible number of threads is created)", 0, 1, set_num_thread},
+    {THREAD_PERF_OPTIONS, SLICE_SCHEDULING, "Order of slices on threads in Low Latency mode, chunked reduces memory traffic (interleaved:0, chunked:1, default: 0)", 0, 1, set_slice_scheduling},
     // Termination
     {NULL_OPTIONS, NULL, NULL, 0, 0, NULL}
 };
@@ -9,6 +9,7 @@
 #include <stdio.h>
 #include "SvtJpegxsEnc.h"
 #include "SvtJpegxsImageBufferTools.h"
+#include "FileApp.h"
 
 #define MAX_NUM_TOKENS 210
 
@@ -19,8 +20,10 @@ typedef struct EncoderConfig {
     char in_filename[1024];
     char out_filename[1024];
 
-    FILE *in_file;
-    FILE *out_file;
+    AppFileMap_t in_map;        // Input frames are passed to encoder directly from mapped file
+    uint32_t frames_in_file;    // Complete frames in input file, repeated from begin when more frames are encoded
+    AppFileWriter_t out_writer; // Used only by writer thread
+    uint8_t out_direct;         // Bypass page cache on output
 
     uint8_t progress; // 0 = no progress output, 1 = normal, verbose progress
     uint32_t frames_count;
@@ -33,10 +33,23 @@
 uint32_t global_stride_add = 100;
 #endif
 
-static int32_t read_yuv_frame(FILE *in_file, svt_jpeg_xs_image_config_t *image_config, svt_jpeg_xs_image_buffer_t *yuv_buffer) {
-    if (feof(in_file)) {
-        return 1;
+static uint32_t get_single_frame_size(svt_jpeg_xs_image_config_t *image_config) {
+    uint32_t size = 0;
+    for (uint8_t c = 0; c < image_config->components_num; ++c) {
+        size += image_config->components[c].byte_size;
+#if TEST_STRIDE
+        uint32_t pixel_size = image_config->bit_depth <= 8 ? sizeof(uint8_t) : sizeof(uint16_t);
+        size -= global_stride_add * image_config->components[c].height * pixel_size;
+#endif
     }
+    return size;
+}
+
+/*Input planes point directly to mapped file, frames are not copied.
+ *When more frames than in file are encoded, file is repeated from begin.*/
+static void get_yuv_frame(EncoderConfig_t *config, uint64_t frame_num, svt_jpeg_xs_image_buffer_t *yuv_buffer) {
+    svt_jpeg_xs_image_config_t *image_config = &config->image_config;
+    uint8_t *src = config->in_map.data + (size_t)(frame_num % config->frames_in_file) * get_single_frame_size(image_config);
 
 #if TEST_STRIDE
     uint32_t pixel_size = image_config->bit_depth <= 8 ? sizeof(uint8_t) : sizeof(uint16_t);
@@ -48,34 +61,112 @@ static int32_t read_yuv_frame(FILE *in_file, svt_jpeg_xs_image_config_t *image_c
         uint32_t width = width_stride - global_stride_add;
         uint32_t line_size_stride = width_stride * pixel_size;
         uint32_t line_size = width * pixel_size;
-        uint32_t read_size = 0;
         for (uint32_t h = 0; h < image_config->components[c].height; ++h) {
-            read_size += (uint32_t)fread(((uint8_t *)yuv_buffer->data_yuv[c]) + yuv_offset, 1, line_size, in_file);
+            memcpy(((uint8_t *)yuv_buffer->data_yuv[c]) + yuv_offset, src, line_size);
             yuv_offset += line_size_stride;
-        }
-        if (image_config->components[c].height * line_size != read_size) {
-            return 1;
+            src += line_size;
         }
 #else
-        uint32_t read_size = (uint32_t)fread(yuv_buffer->data_yuv[c], 1, yuv_buffer->alloc_size[c], in_file);
-        if (image_config->components[c].byte_size != read_size) {
-            return 1;
-        }
+        yuv_buffer->data_yuv[c] = src;
+        yuv_buffer->stride[c] = image_config->components[c].width;
+        yuv_buffer->alloc_size[c] = image_config->components[c].byte_size;
+        src += image_config->components[c].byte_size;
 #endif
     }
-    return 0;
+#if !TEST_STRIDE
+    yuv_buffer->release_ctx_ptr = NULL;
+    yuv_buffer->ready_to_release = 0;
+#endif
 }
 
-static uint32_t get_single_frame_size(svt_jpeg_xs_image_config_t *image_config) {
-    uint32_t size = 0;
-    for (uint8_t c = 0; c < image_config->components_num; ++c) {
-        size += image_config->components[c].byte_size;
+/*Packets queued for write, frames are released to pool only after write*/
+#define ENC_APP_WRITER_QUEUE_SIZE (64)
+
+typedef struct EncAppWriteItem {
+    svt_jpeg_xs_frame_t frame;
+    uint8_t write; /*0 for packets with encode error, released without write*/
+} EncAppWriteItem_t;
+
+/*Bitstream is written on separate thread so get_packet() loop is not stalled by storage.
+ *Queue is bounded, when storage is slower than encoder main thread waits for free slot.*/
+typedef struct EncAppWriter {
+    EncoderConfig_t *config;
+    EncAppWriteItem_t queue[ENC_APP_WRITER_QUEUE_SIZE];
+    uint32_t head; /*Used only by writer thread*/
+    uint32_t tail; /*Used only by main thread*/
+    void *free_slots;
+    void *filled_slots; /*Posted for every packet and once on finish*/
+    void *thread;
+    SvtJxsErrorType_t error;
+} EncAppWriter_t;
+
+static void *thread_write(void *arg) {
+    EncAppWriter_t *writer = (EncAppWriter_t *)arg;
+    EncoderConfig_t *config_enc = writer->config;
+    for (;;) {
+        semaphore_block(writer->filled_slots, -1);
+        if (writer->head == writer->tail) {
+            break;
+        }
+        EncAppWriteItem_t *item = &writer->queue[writer->head % ENC_APP_WRITER_QUEUE_SIZE];
+        writer->head++;
+        if (item->write && writer->error == SvtJxsErrorNone) {
+            writer->error = app_file_writer_write(
+                &config_enc->out_writer, item->frame.bitstream.buffer, item->frame.bitstream.used_size);
+        }
+        svt_jpeg_xs_frame_pool_release(config_enc->frame_pool, &item->frame);
+        semaphore_post(writer->free_slots);
     }
-    return size;
+    return NULL;
 }
 
-static int32_t reset_yuv_file(FILE *in_file) {
-    return fseek(in_file, 0, SEEK_SET);
+static void writer_free(EncAppWriter_t *writer) {
+    if (!writer) {
+        return;
+    }
+    if (writer->free_slots) {
+        semaphore_destroy(writer->free_slots);
+    }
+    if (writer->filled_slots) {
+        semaphore_destroy(writer->filled_slots);
+    }
+    free(writer);
+}
+
+static EncAppWriter_t *writer_start(EncoderConfig_t *config) {
+    EncAppWriter_t *writer = (EncAppWriter_t *)calloc(1, sizeof(EncAppWriter_t));
+    if (!writer) {
+        return NULL;
+    }
+    writer->config = config;
+    writer->free_slots = semaphore_create(ENC_APP_WRITER_QUEUE_SIZE, ENC_APP_WRITER_QUEUE_SIZE);
+    writer->filled_slots = semaphore_create(0, ENC_APP_WRITER_QUEUE_SIZE + 1);
+    if (writer->free_slots && writer->filled_slots) {
+        writer->thread = app_create_thread(thread_write, writer);
+    }
+    if (!writer->thread) {
+        writer_free(writer);
+        return NULL;
+    }
+    return writer;
+}
+
+static void writer_push(EncAppWriter_t *writer, svt_jpeg_xs_frame_t *frame, uint8_t write) {
+    semaphore_block(writer->free_slots, -1);
+    EncAppWriteItem_t *item = &writer->queue[writer->tail % ENC_APP_WRITER_QUEUE_SIZE];
+    item->frame = *frame;
+    item->write = write;
+    writer->tail++;
+    semaphore_post(writer->filled_slots);
+}
+
+/*Wait until all queued packets are written, return first write error*/
+static SvtJxsErrorType_t writer_finish(EncAppWriter_t *writer) {
+    semaphore_post(writer->filled_slots);
+    app_destroy_thread(writer->thread);
+    SvtJxsErrorType_t ret = writer->error;
+    writer_free(writer);
+    return ret;
 }
 
 static void show_encoding_progress(EncoderConfig_t *config, uint64_t encoded_frame_count) {
@@ -115,20 +206,7 @@ static void *thread_send(void *arg) {
             break;
         }
 
-        if (read_yuv_frame(config_enc->in_file, &config_enc->image_config, &enc_input.image)) {
-            //End of file reached or read less than expected, Repeat read file from begin
-
-            int32_t read_ret = reset_yuv_file(config_enc->in_file);
-            if (read_ret != 0) {
-                fprintf(stderr, "Input invalid read file from begin! Error!!! \n");
-                break;
-            }
-            read_ret = read_yuv_frame(config_enc->in_file, &config_enc->image_config, &enc_input.image);
-            if (read_ret) {
-                //file does not hold enough data for frame
-                break;
-            }
-        }
+        get_yuv_frame(config_enc, send_frames, &enc_input.image);
 
         //Optional block of code to measure latency
         {
@@ -180,6 +258,7 @@ int32_t main(int32_t argc, char *argv[]) {
     // GLOBAL VARIABLES
     SvtJxsErrorType_t return_error = SvtJxsErrorNone; // Error Handling
     void *thread_send_handle = NULL;
+    EncAppWriter_t *writer = NULL;
 
     EncoderConfig_t config_enc;
     memset(&config_enc, 0, sizeof(EncoderConfig_t));
@@ -215,16 +294,15 @@ int32_t main(int32_t argc, char *argv[]) {
         goto fail;
     }
 
-    FOPEN(config_enc.in_file, config_enc.in_filename, "rb");
-    if (!config_enc.in_file) {
+    if (app_file_map_open(&config_enc.in_map, config_enc.in_filename) != SvtJxsErrorNone) {
         fprintf(stderr, "Invalid input file: '%s'\n", config_enc.in_filename);
         return_error = SvtJxsErrorBadParameter;
         goto fail;
     }
 
+    //Without output file bitstream is discarded, only encoder throughput is measured
     if (config_enc.out_filename[0]) {
-        FOPEN(config_enc.out_file, config_enc.out_filename, "wb");
-        if (!config_enc.out_file) {
+        if (app_file_writer_open(&config_enc.out_writer, config_enc.out_filename, config_enc.out_direct) != SvtJxsErrorNone) {
             fprintf(stderr, "Invalid output file: '%s'\n", config_enc.out_filename);
             return_error = SvtJxsErrorBadParameter;
             goto fail;
@@ -248,15 +326,20 @@ int32_t main(int32_t argc, char *argv[]) {
     }
 
 #if TEST_STRIDE
-    uint32_t pixel_size = image_config.bit_depth <= 8 ? sizeof(uint8_t) : sizeof(uint16_t);
-    for (uint8_t c = 0; c < image_config.components_num; ++c) {
-        image_config.components[c].width += global_stride_add;
-        image_config.components[c].byte_size += global_stride_add * image_config.components[c].height * pixel_size;
+    uint32_t pixel_size = config_enc.image_config.bit_depth <= 8 ? sizeof(uint8_t) : sizeof(uint16_t);
+    for (uint8_t c = 0; c < config_enc.image_config.components_num; ++c) {
+        config_enc.image_config.components[c].width += global_stride_add;
+        config_enc.image_config.components[c].byte_size += global_stride_add * config_enc.image_config.components[c].height *
+            pixel_size;
     }
+    //Input is copied to YUV buffers with stride
+    svt_jpeg_xs_image_config_t *pool_image_config = &config_enc.image_config;
+#else
+    //Input planes are taken from mapped file, pool allocates only bitstream buffers
+    svt_jpeg_xs_image_config_t *pool_image_config = NULL;
 #endif
 
-    config_enc.frame_pool = svt_jpeg_xs_frame_pool_alloc(
-        &config_enc.image_config, bitstream_size, 5); //Allocate 5 output YUV buffers
+    config_enc.frame_pool = svt_jpeg_xs_frame_pool_alloc(pool_image_config, bitstream_size, 5); //Allocate 5 buffers
     if (!config_enc.frame_pool) {
         fprintf(stderr, "Invalid YUV and bitstream buffer pool allocation!\n");
         return_error = SvtJxsErrorInsufficientResources;
@@ -270,11 +353,25 @@ int32_t main(int32_t argc, char *argv[]) {
         goto fail;
     }
 
+    config_enc.frames_in_file = (uint32_t)(config_enc.in_map.size / get_single_frame_size(&config_enc.image_config));
+    if (config_enc.frames_in_file == 0) {
+        fprintf(stderr, "Input file does not hold enough data for frame: '%s'\n", config_enc.in_filename);
+        return_error = SvtJxsErrorBadParameter;
+        goto fail;
+    }
+
     //Calculate number of frames in file if user does not specify any
     if (config_enc.frames_count == 0) {
-        int64_t file_size = get_file_size(config_enc.in_file);
-        uint32_t single_frame_size = get_single_frame_size(&config_enc.image_config);
-        config_enc.frames_count = (uint32_t)(file_size / single_frame_size);
+        config_enc.frames_count = config_enc.frames_in_file;
+    }
+
+    if (config_enc.out_writer.buffer) {
+        writer = writer_start(&config_enc);
+        if (writer == NULL) {
+            fprintf(stderr, "Failed to start output writer thread!\n");
+            return_error = SvtJxsErrorInsufficientResources;
+            goto fail;
+        }
     }
 
     get_current_time(&performance_context.processing_start_time[0], &performance_context.processing_start_time[1]);
@@ -335,22 +432,32 @@ int32_t main(int32_t argc, char *argv[]) {
             return_error = ret;
             goto fail;
         }
-        if (ret == SvtJxsErrorNone) {
-            if (config_enc.out_file) {
-                fwrite(enc_output.bitstream.buffer, 1, enc_output.bitstream.used_size, config_enc.out_file);
-            }
-        }
-        else {
+        if (ret != SvtJxsErrorNone) {
             fprintf(stderr, "---------Error encode frame %lu ---------\n", (unsigned long)frames_received);
             return_error = ENC_IGNORE_SOME_FRAMES;
         }
 
-        svt_jpeg_xs_frame_pool_release(config_enc.frame_pool, &enc_output);
+        if (writer) {
+            //Released to pool by writer thread
+            writer_push(writer, &enc_output, ret == SvtJxsErrorNone);
+        }
+        else {
+            svt_jpeg_xs_frame_pool_release(config_enc.frame_pool, &enc_output);
+        }
         // Dump progress
         show_encoding_progress(&config_enc, frames_received);
 
     } while (frames_received < config_enc.frames_count);
 
+    if (writer) {
+        SvtJxsErrorType_t write_ret = writer_finish(writer);
+        writer = NULL;
+        if (write_ret != SvtJxsErrorNone) {
+            fprintf(stderr, "Error write output file: '%s'\n", config_enc.out_filename);
+            return_error = write_ret;
+        }
+    }
+
     uint64_t encode_end_time[2]; // [sec, micro_sec] first frame sent
     get_current_time(&encode_end_time[0], &encode_end_time[1]);
     performance_context.total_process_time = compute_elapsed_time_in_ms(performance_context.processing_start_time[0],
@@ -388,18 +495,17 @@ fail:
     if (thread_send_handle) {
         app_destroy_thread(thread_send_handle);
     }
+    if (writer) {
+        writer_finish(writer);
+    }
     svt_jpeg_xs_frame_pool_free(config_enc.frame_pool);
     svt_jpeg_xs_encoder_close(&config_enc.encoder);
 
     // Close any files that are open
-    if (config_enc.in_file) {
-        fclose(config_enc.in_file);
-        config_enc.in_file = NULL;
-    }
-
-    if (config_enc.out_file) {
-        fclose(config_enc.out_file);
-        config_enc.out_file = NULL;
+    app_file_map_close(&config_enc.in_map);
+    if (app_file_writer_close(&config_enc.out_writer) != SvtJxsErrorNone && return_error == SvtJxsErrorNone) {
+        fprintf(stderr, "Error write output file: '%s'\n", config_enc.out_filename);
+        return_error = SvtJxsErrorUndefined;
     }
 
     return return_error;
@@ -5,9 +5,28 @@
 
 #include <inttypes.h>
 #include <stdio.h>
+#include <string.h>
+#ifndef _WIN32
+#include <sys/mman.h>
+#include <unistd.h>
+#endif
+#ifdef __linux__
+#include <sys/syscall.h>
+#endif
 #include "SvtJpegxsImageBufferTools.h"
 #include "Threads/SystemResourceManager.h"
 
+#define POOL_HUGEPAGE_SIZE (2 * 1024 * 1024)
+#define POOL_NUMA_MAX_NODES 1024
+#define POOL_MPOL_PREFERRED 1 /*MPOL_PREFERRED from linux/mempolicy.h*/
+#define POOL_ALIGN_UP(size, align) (((size) + ((align)-1)) & ~((size_t)(align)-1))
+
+typedef enum PoolMemoryType {
+    POOL_MEMORY_HEAP = 0,   /*Aligned heap allocation*/
+    POOL_MEMORY_MAPPED = 1, /*Anonymous mapping, used for hugepages and NUMA placement*/
+    POOL_MEMORY_CALLER = 2, /*Caller-owned region, not released by pool*/
+} PoolMemoryType_t;
+
 struct svt_jpeg_xs_frame_pool {
     uint8_t use_image_buffer;
     svt_jpeg_xs_image_config_t image_config;
@@ -17,8 +36,76 @@ struct svt_jpeg_xs_frame_pool {
     Fifo_t* pool_image_buffer_fifo_ptr;
     SystemResource_t* pool_bitstream_resource_ptr;
     Fifo_t* pool_bitstream_fifo_ptr;
+
+    /*Contiguous storage for buffers of all frames in pool:
+     *frame 0: [plane 0][plane 1][plane 2][bitstream] frame 1: [plane 0]...
+     *Each buffer is aligned to alignment.*/
+    PoolMemoryType_t memory_type;
+    void* memory_raw;
+    size_t memory_raw_size;
+    uint8_t* memory;
+    uint32_t alignment;
+    uint32_t image_stride[MAX_COMPONENTS_NUM];
+    uint32_t image_alloc_size[MAX_COMPONENTS_NUM];
+    size_t image_frame_size;
+    size_t frame_size;
+    uint32_t image_buffer_next;
+    uint32_t bitstream_next;
 };
 
+static SvtJxsErrorType_t image_buffer_get_layout(const svt_jpeg_xs_image_config_t* image_config,
+                                                 uint32_t stride[MAX_COMPONENTS_NUM],
+                                                 uint32_t alloc_size[MAX_COMPONENTS_NUM]) {
+    uint32_t pixel_size = image_config->bit_depth <= 8 ? sizeof(uint8_t) : sizeof(uint16_t);
+    for (int32_t c = 0; c < MAX_COMPONENTS_NUM; c++) {
+        stride[c] = 0;
+        alloc_size[c] = 0;
+    }
+    if (image_config->format == COLOUR_FORMAT_PACKED_YUV444_OR_RGB) {
+        const uint64_t stride64 = (uint64_t)image_config->components[0].width * 3;
+        if (stride64 > UINT32_MAX) {
+            fprintf(stderr, "Image buffer alloc overflow: stride %" PRIu64 " exceeds uint32 max\n", stride64);
+            return SvtJxsErrorBadParameter;
+        }
+        const uint64_t alloc64 = stride64 * image_config->components[0].height * pixel_size;
+        if (alloc64 > UINT32_MAX) {
+            fprintf(stderr, "Image buffer alloc overflow: alloc_size %" PRIu64 " exceeds uint32 max\n", alloc64);
+            return SvtJxsErrorBadParameter;
+        }
+        stride[0] = (uint32_t)stride64;
+        alloc_size[0] = (uint32_t)alloc64;
+        assert(alloc_size[0] == image_config->components[0].byte_size);
+    }
+    else {
+        for (uint32_t c = 0; c < image_config->components_num; c++) {
+            const uint64_t alloc64 = (uint64_t)image_config->components[c].width * image_config->components[c].height *
+                pixel_size;
+            if (alloc64 > UINT32_MAX) {
+                fprintf(
+                    stderr, "Image buffer alloc overflow: component %u alloc_size %" PRIu64 " exceeds uint32 max\n", c, alloc64);
+                return SvtJxsErrorBadParameter;
+            }
+            stride[c] = image_config->components[c].width;
+            alloc_size[c] = (uint32_t)alloc64;
+            assert(alloc_size[c] >= image_config->components[c].byte_size);
+        }
+    }
+    return SvtJxsErrorNone;
+}
+
+static uint32_t image_buffer_get_planes_num(const svt_jpeg_xs_image_config_t* image_config) {
+    if (image_config->format == COLOUR_FORMAT_PACKED_YUV444_OR_RGB) {
+        return 1;
+    }
+    return image_config->components_num;
+}
+
+static void* image_buffer_data_alloc(size_t size) {
+    void* ptr;
+    SVT_NO_THROW_MALLOC_ALIGNED(ptr, size);
+    return ptr;
+}
+
 PREFIX_API svt_jpeg_xs_image_buffer_t* svt_jpeg_xs_image_buffer_alloc(svt_jpeg_xs_image_config_t* image_config) {
     if (!image_config) {
         fprintf(stderr, "Invalid image config: NULL pointer\n");
@@ -42,49 +129,18 @@ PREFIX_API svt_jpeg_xs_image_buffer_t* svt_jpeg_xs_image_buffer_alloc(svt_jpeg_x
         image_buffer->data_yuv[c] = NULL;
     }
 
-    uint32_t pixel_size = image_config->bit_depth <= 8 ? sizeof(uint8_t) : sizeof(uint16_t);
-    if (image_config->format == COLOUR_FORMAT_PACKED_YUV444_OR_RGB) {
-        const uint64_t stride64 = (uint64_t)image_config->components[0].width * 3;
-        if (stride64 > UINT32_MAX) {
-            fprintf(stderr, "Image buffer alloc overflow: stride %" PRIu64 " exceeds uint32 max\n", stride64);
-            svt_jpeg_xs_image_buffer_free(image_buffer);
-            return NULL;
-        }
-        const uint64_t alloc64 = stride64 * image_config->components[0].height * pixel_size;
-        if (alloc64 > UINT32_MAX) {
-            fprintf(stderr, "Image buffer alloc overflow: alloc_size %" PRIu64 " exceeds uint32 max\n", alloc64);
-            svt_jpeg_xs_image_buffer_free(image_buffer);
-            return NULL;
-        }
-        image_buffer->stride[0] = (uint32_t)stride64;
-        image_buffer->alloc_size[0] = (uint32_t)alloc64;
-        assert(image_buffer->alloc_size[0] == image_config->components[0].byte_size);
-        SVT_NO_THROW_MALLOC(image_buffer->data_yuv[0], image_buffer->alloc_size[0]);
-        if (!image_buffer->data_yuv[0]) {
+    if (image_buffer_get_layout(image_config, image_buffer->stride, image_buffer->alloc_size) != SvtJxsErrorNone) {
+        svt_jpeg_xs_image_buffer_free(image_buffer);
+        return NULL;
+    }
+    const uint32_t planes_num = image_buffer_get_planes_num(image_config);
+    for (uint32_t c = 0; c < planes_num; c++) {
+        image_buffer->data_yuv[c] = image_buffer_data_alloc(image_buffer->alloc_size[c]);
+        if (!image_buffer->data_yuv[c]) {
             svt_jpeg_xs_image_buffer_free(image_buffer);
             return NULL;
         }
     }
-    else {
-        for (uint32_t c = 0; c < image_config->components_num; c++) {
-            const uint64_t alloc64 = (uint64_t)image_config->components[c].width * image_config->components[c].height *
-                pixel_size;
-            if (alloc64 > UINT32_MAX) {
-                fprintf(
-                    stderr, "Image buffer alloc overflow: component %u alloc_size %" PRIu64 " exceeds uint32 max\n", c, alloc64);
-                svt_jpeg_xs_image_buffer_free(image_buffer);
-                return NULL;
-            }
-            image_buffer->stride[c] = image_config->components[c].width;
-            image_buffer->alloc_size[c] = (uint32_t)alloc64;
-            assert(image_buffer->alloc_size[c] >= image_config->components[c].byte_size);
-            SVT_NO_THROW_MALLOC(image_buffer->data_yuv[c], image_buffer->alloc_size[c]);
-            if (!image_buffer->data_yuv[c]) {
-                svt_jpeg_xs_image_buffer_free(image_buffer);
-                return NULL;
-            }
-        }
-    }
 
     image_buffer->release_ctx_ptr = NULL;
     return image_buffer;
@@ -94,7 +150,7 @@ PREFIX_API void svt_jpeg_xs_image_buffer_free(svt_jpeg_xs_image_buffer_t* image_
     if (image_buffer) {
         for (int32_t c = 0; c < MAX_COMPONENTS_NUM; c++) {
             if (image_buffer->data_yuv[c]) {
-                SVT_FREE(image_buffer->data_yuv[c]);
+                SVT_FREE_ALIGNED(image_buffer->data_yuv[c]);
             }
             image_buffer->data_yuv[c] = NULL;
         }
@@ -134,64 +190,271 @@ PREFIX_API void svt_jpeg_xs_bitstream_free(svt_jpeg_xs_bitstream_buffer_t* bitst
 static SvtJxsErrorType_t out_image_buffer_create_ctor(void_ptr* object_dbl_ptr, void_ptr object_init_data_ptr) {
     svt_jpeg_xs_frame_pool_t* frame_pool = (svt_jpeg_xs_frame_pool_t*)object_init_data_ptr;
     assert(frame_pool->use_image_buffer);
-    svt_jpeg_xs_image_buffer_t* image_buffer = svt_jpeg_xs_image_buffer_alloc(&frame_pool->image_config);
+    svt_jpeg_xs_image_buffer_t* image_buffer;
+    SVT_NO_THROW_CALLOC(image_buffer, 1, sizeof(svt_jpeg_xs_image_buffer_t));
     if (!image_buffer) {
         return SvtJxsErrorInsufficientResources;
     }
 
+    /*Objects are created in order, so each takes next frame slot of pool storage*/
+    uint8_t* frame_memory = frame_pool->memory + frame_pool->image_buffer_next * frame_pool->frame_size;
+    frame_pool->image_buffer_next++;
+    const uint32_t planes_num = image_buffer_get_planes_num(&frame_pool->image_config);
+    for (uint32_t c = 0; c < planes_num; c++) {
+        image_buffer->data_yuv[c] = frame_memory;
+        image_buffer->stride[c] = frame_pool->image_stride[c];
+        image_buffer->alloc_size[c] = frame_pool->image_alloc_size[c];
+        frame_memory += POOL_ALIGN_UP(frame_pool->image_alloc_size[c], frame_pool->alignment);
+    }
+    image_buffer->release_ctx_ptr = NULL;
+
     *object_dbl_ptr = image_buffer;
     return SvtJxsErrorNone;
 }
 
 static void out_image_buffer_destroy_ctor(void_ptr p) {
+    /*Planes belong to pool storage*/
     svt_jpeg_xs_image_buffer_t* image_buffer = (svt_jpeg_xs_image_buffer_t*)p;
-    svt_jpeg_xs_image_buffer_free(image_buffer);
+    SVT_FREE(image_buffer);
 }
 
 static SvtJxsErrorType_t out_bitstream_buffer_create_ctor(void_ptr* object_dbl_ptr, void_ptr object_init_data_ptr) {
-    svt_jpeg_xs_frame_pool_t* bitstream_buffer_pool = (svt_jpeg_xs_frame_pool_t*)object_init_data_ptr;
-    assert(bitstream_buffer_pool->use_bitstream);
-    svt_jpeg_xs_bitstream_buffer_t* bitstream_buffer = svt_jpeg_xs_bitstream_alloc(bitstream_buffer_pool->bitstream_size);
+    svt_jpeg_xs_frame_pool_t* frame_pool = (svt_jpeg_xs_frame_pool_t*)object_init_data_ptr;
+    assert(frame_pool->use_bitstream);
+    svt_jpeg_xs_bitstream_buffer_t* bitstream_buffer;
+    SVT_NO_THROW_CALLOC(bitstream_buffer, 1, sizeof(svt_jpeg_xs_bitstream_buffer_t));
     if (!bitstream_buffer) {
         return SvtJxsErrorInsufficientResources;
     }
 
+    bitstream_buffer->buffer = frame_pool->memory + frame_pool->bitstream_next * frame_pool->frame_size +
+        frame_pool->image_frame_size;
+    frame_pool->bitstream_next++;
+    bitstream_buffer->allocation_size = frame_pool->bitstream_size;
+    bitstream_buffer->used_size = 0;
+    bitstream_buffer->release_ctx_ptr = NULL;
+
     *object_dbl_ptr = bitstream_buffer;
     return SvtJxsErrorNone;
 }
 
 static void out_bitstream_buffer_destroy_ctor(void_ptr p) {
+    /*Buffer belongs to pool storage*/
     svt_jpeg_xs_bitstream_buffer_t* bitstream_buffer = (svt_jpeg_xs_bitstream_buffer_t*)p;
-    svt_jpeg_xs_bitstream_free(bitstream_buffer);
+    SVT_FREE(bitstream_buffer);
+}
+
+static uint32_t frame_pool_get_alignment(uint32_t alignment) {
+    if (alignment == 0) {
+        return ALVALUE;
+    }
+    if (alignment & (alignment - 1)) {
+        return 0; /*Not power of two*/
+    }
+    /*posix_memalign() requires at least pointer size*/
+    return alignment < sizeof(void*) ? (uint32_t)sizeof(void*) : alignment;
+}
+
+/*Calculate layout of single frame in pool storage*/
+static SvtJxsErrorType_t frame_pool_compute_layout(svt_jpeg_xs_frame_pool_t* frame_pool,
+                                                   const svt_jpeg_xs_image_config_t* image_config, uint32_t bitstream_size,
+                                                   uint32_t count, uint32_t alignment, size_t* out_memory_size) {
+    frame_pool->alignment = frame_pool_get_alignment(alignment);
+    if (frame_pool->alignment == 0) {
+        fprintf(stderr, "Invalid frame pool alignment (%u), expected power of two\n", alignment);
+        return SvtJxsErrorBadParameter;
+    }
+
+    frame_pool->image_frame_size = 0;
+    if (image_config) {
+        if (image_config->components_num > MAX_COMPONENTS_NUM) {
+            fprintf(stderr,
+                    "Invalid image config: components_num (%u) exceeds maximum (%u)\n",
+                    image_config->components_num,
+                    MAX_COMPONENTS_NUM);
+            return SvtJxsErrorBadParameter;
+        }
+        SvtJxsErrorType_t ret = image_buffer_get_layout(image_config, frame_pool->image_stride, frame_pool->image_alloc_size);
+        if (ret != SvtJxsErrorNone) {
+            return ret;
+        }
+        const uint32_t planes_num = image_buffer_get_planes_num(image_config);
+        for (uint32_t c = 0; c < planes_num; c++) {
+            frame_pool->image_frame_size += POOL_ALIGN_UP(frame_pool->image_alloc_size[c], frame_pool->alignment);
+        }
+    }
+    frame_pool->frame_size = frame_pool->image_frame_size + POOL_ALIGN_UP(bitstream_size, frame_pool->alignment);
+    if (frame_pool->frame_size != 0 && count > SIZE_MAX / frame_pool->frame_size) {
+        fprintf(stderr, "Frame pool size overflow\n");
+        return SvtJxsErrorBadParameter;
+    }
+    /*Extra alignment to align begin of storage in caller-owned region*/
+    *out_memory_size = frame_pool->frame_size * count + frame_pool->alignment;
+    return SvtJxsErrorNone;
+}
+
+#ifdef __linux__
+static void frame_pool_memory_set_numa_node(void* ptr, size_t size, uint32_t numa_node) {
+#ifdef SYS_mbind
+    unsigned long nodemask[POOL_NUMA_MAX_NODES / (8 * sizeof(unsigned long))] = {0};
+    if (numa_node >= POOL_NUMA_MAX_NODES) {
+        fprintf(stderr, "Warning: NUMA node %u out of range, memory placement ignored\n", numa_node);
+        return;
+    }
+    nodemask[numa_node / (8 * sizeof(unsigned long))] |= 1UL << (numa_node % (8 * sizeof(unsigned long)));
+    /*Best effort, kernel without NUMA support return error and keep default policy*/
+    if (syscall(SYS_mbind, ptr, size, POOL_MPOL_PREFERRED, nodemask, (unsigned long)POOL_NUMA_MAX_NODES, 0) != 0) {
+        fprintf(stderr, "Warning: Can not bind frame pool memory to NUMA node %u\n", numa_node);
+    }
+#else
+    (void)ptr;
+    (void)size;
+    (void)numa_node;
+#endif
+}
+
+static void* frame_pool_memory_map(size_t* size, SvtJxsHugepages_t hugepages) {
+    void* ptr = MAP_FAILED;
+    if (hugepages != SVT_JXS_HUGEPAGES_NONE) {
+        *size = POOL_ALIGN_UP(*size, POOL_HUGEPAGE_SIZE);
+    }
+#ifdef MAP_HUGETLB
+    if (hugepages == SVT_JXS_HUGEPAGES_EXPLICIT) {
+        ptr = mmap(NULL, *size, PROT_READ | PROT_WRITE, MAP_PRIVATE | MAP_ANONYMOUS | MAP_HUGETLB, -1, 0);
+    }
+#endif
+    if (ptr == MAP_FAILED) {
+        ptr = mmap(NULL, *size, PROT_READ | PROT_WRITE, MAP_PRIVATE | MAP_ANONYMOUS, -1, 0);
+        if (ptr == MAP_FAILED) {
+            return NULL;
+        }
+#ifdef MADV_HUGEPAGE
+        if (hugepages != SVT_JXS_HUGEPAGES_NONE) {
+            madvise(ptr, *size, MADV_HUGEPAGE);
+        }
+#endif
+    }
+    return ptr;
+}
+#endif
+
+static SvtJxsErrorType_t frame_pool_memory_alloc(svt_jpeg_xs_frame_pool_t* frame_pool, size_t memory_size,
+                                                 const svt_jpeg_xs_frame_pool_config_t* pool_config) {
+    frame_pool->memory_raw = NULL;
+    frame_pool->memory_raw_size = 0;
+    frame_pool->memory = NULL;
+
+    if (pool_config && pool_config->memory) {
+        if (pool_config->memory_size < memory_size) {
+            fprintf(stderr,
+                    "Frame pool memory region too small: %zu bytes, required %zu bytes\n",
+                    pool_config->memory_size,
+                    memory_size);
+            return SvtJxsErrorBadParameter;
+        }
+        frame_pool->memory_type = POOL_MEMORY_CALLER;
+        frame_pool->memory = (uint8_t*)POOL_ALIGN_UP((uintptr_t)pool_config->memory, frame_pool->alignment);
+        return SvtJxsErrorNone;
+    }
+
+#ifdef __linux__
+    if (pool_config && (pool_config->hugepages != SVT_JXS_HUGEPAGES_NONE || pool_config->use_numa_node)) {
+        size_t map_size = memory_size;
+        void* ptr = frame_pool_memory_map(&map_size, pool_config->hugepages);
+        if (ptr) {
+            if (pool_config->use_numa_node) {
+                frame_pool_memory_set_numa_node(ptr, map_size, pool_config->numa_node);
+            }
+            SVT_ADD_MEM_ENTRY(ptr, POINTER_TYPE_A_PTR, map_size);
+            frame_pool->memory_type = POOL_MEMORY_MAPPED;
+            frame_pool->memory_raw = ptr;
+            frame_pool->memory_raw_size = map_size;
+            frame_pool->memory = (uint8_t*)POOL_ALIGN_UP((uintptr_t)ptr, frame_pool->alignment);
+            /*Fault pages in now, with requested policy, instead of first frame*/
+            memset(ptr, 0, map_size);
+            return SvtJxsErrorNone;
+        }
+        /*Fallback to heap*/
+    }
+#endif
+
+    void* ptr = NULL;
+#ifdef _WIN32
+    ptr = _aligned_malloc(memory_size, frame_pool->alignment);
+#else
+    if (posix_memalign(&ptr, frame_pool->alignment, memory_size) != 0) {
+        ptr = NULL;
+    }
+#endif
+    SVT_NO_THROW_ADD_MEM(ptr, memory_size, POINTER_TYPE_A_PTR);
+    if (!ptr) {
+        return SvtJxsErrorInsufficientResources;
+    }
+    frame_pool->memory_type = POOL_MEMORY_HEAP;
+    frame_pool->memory_raw = ptr;
+    frame_pool->memory_raw_size = memory_size;
+    frame_pool->memory = (uint8_t*)ptr;
+    return SvtJxsErrorNone;
+}
+
+static void frame_pool_memory_free(svt_jpeg_xs_frame_pool_t* frame_pool) {
+    if (frame_pool->memory_raw == NULL) {
+        return;
+    }
+    if (frame_pool->memory_type == POOL_MEMORY_HEAP) {
+        SVT_FREE_ALIGNED(frame_pool->memory_raw);
+    }
+#ifdef __linux__
+    else if (frame_pool->memory_type == POOL_MEMORY_MAPPED) {
+        SVT_REMOVE_MEM_ENTRY(frame_pool->memory_raw, POINTER_TYPE_A_PTR);
+        munmap(frame_pool->memory_raw, frame_pool->memory_raw_size);
+    }
+#endif
+    frame_pool->memory_raw = NULL;
+    frame_pool->memory = NULL;
+}
+
+PREFIX_API SvtJxsErrorType_t svt_jpeg_xs_frame_pool_get_memory_size(const svt_jpeg_xs_image_config_t* image_config,
+                                                                    uint32_t bitstream_size, uint32_t count, uint32_t alignment,
+                                                                    size_t* out_memory_size) {
+    if (out_memory_size == NULL || count == 0 || (image_config == NULL && bitstream_size == 0)) {
+        return SvtJxsErrorBadParameter;
+    }
+    svt_jpeg_xs_frame_pool_t frame_pool;
+    memset(&frame_pool, 0, sizeof(frame_pool));
+    return frame_pool_compute_layout(&frame_pool, image_config, bitstream_size, count, alignment, out_memory_size);
 }
 
 PREFIX_API svt_jpeg_xs_frame_pool_t* svt_jpeg_xs_frame_pool_alloc(const svt_jpeg_xs_image_config_t* image_config,
                                                                   uint32_t bitstream_size, uint32_t count) {
+    return svt_jpeg_xs_frame_pool_alloc_ex(image_config, bitstream_size, count, NULL);
+}
+
+PREFIX_API svt_jpeg_xs_frame_pool_t* svt_jpeg_xs_frame_pool_alloc_ex(const svt_jpeg_xs_image_config_t* image_config,
+                                                                     uint32_t bitstream_size, uint32_t count,
+                                                                     const svt_jpeg_xs_frame_pool_config_t* pool_config) {
     svt_jpeg_xs_frame_pool_t* frame_pool = NULL;
 
     if (count == 0 || (image_config == NULL && bitstream_size == 0)) {
         return NULL;
     }
 
-    SVT_NO_THROW_MALLOC(frame_pool, sizeof(svt_jpeg_xs_frame_pool_t));
+    SVT_NO_THROW_CALLOC(frame_pool, 1, sizeof(svt_jpeg_xs_frame_pool_t));
     if (frame_pool) {
         svt_jxs_increase_component_count();
-        frame_pool->pool_image_buffer_resource_ptr = NULL;
-        frame_pool->pool_image_buffer_fifo_ptr = NULL;
-        frame_pool->pool_bitstream_resource_ptr = NULL;
-        frame_pool->pool_image_buffer_fifo_ptr = NULL;
 
-        if (image_config == NULL) {
-            frame_pool->use_image_buffer = 0;
-        }
-        else if (image_config->components_num > MAX_COMPONENTS_NUM) {
-            fprintf(stderr,
-                    "Invalid image config: components_num (%u) exceeds maximum (%u)\n",
-                    image_config->components_num,
-                    MAX_COMPONENTS_NUM);
+        size_t memory_size = 0;
+        if (frame_pool_compute_layout(
+                frame_pool, image_config, bitstream_size, count, pool_config ? pool_config->alignment : 0, &memory_size) !=
+                SvtJxsErrorNone ||
+            frame_pool_memory_alloc(frame_pool, memory_size, pool_config) != SvtJxsErrorNone) {
             svt_jpeg_xs_frame_pool_free(frame_pool);
             return NULL;
         }
+
+        if (image_config == NULL) {
+            frame_pool->use_image_buffer = 0;
+        }
         else {
             frame_pool->use_image_buffer = 1;
             frame_pool->image_config = *image_config; /*Copy structure with configuration.*/
@@ -251,6 +514,7 @@ PREFIX_API void svt_jpeg_xs_frame_pool_free(svt_jpeg_xs_frame_pool_t* frame_pool
         if (frame_pool->pool_bitstream_resource_ptr) {
             SVT_DELETE(frame_pool->pool_bitstream_resource_ptr);
         }
+        frame_pool_memory_free(frame_pool);
         SVT_FREE(frame_pool);
         svt_jxs_decrease_component_count();
     }
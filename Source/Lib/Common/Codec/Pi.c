@@ -577,16 +577,9 @@ SvtJxsErrorType_t pi_update_proxy_mode(pi_t* pi, proxy_mode_t proxy_mode, uint32
 
     if (proxy_mode == proxy_mode_half) {
         proxy_subsampling = 1;
-        if (pi->decom_v == 1) {
-            pi->packets_num = 1;
-        }
-        else {
-            pi->packets_num = 4;
-        }
     }
     if (proxy_mode == proxy_mode_quarter) {
         proxy_subsampling = 2;
-        pi->packets_num = 1;
     }
 
     if (proxy_subsampling > pi->decom_v || proxy_subsampling > pi->decom_h) {
@@ -622,5 +615,25 @@ SvtJxsErrorType_t pi_update_proxy_mode(pi_t* pi, proxy_mode_t proxy_mode, uint32
         pi->components[c].bands_num = 2 * pi->components[c].decom_v + pi->components[c].decom_h + 1;
     }
 
+    /*Packets are ordered from lowest frequency, keep packets up to last one with band used by proxy.
+     *Packets after that are skipped by precinct size without unpacking.*/
+    uint32_t packets_num = 0;
+    for (uint32_t packet_idx = 0; packet_idx < pi->packets_num; packet_idx++) {
+        for (uint32_t band_idx = pi->packets[packet_idx].band_start; band_idx < pi->packets[packet_idx].band_stop; band_idx++) {
+            const uint32_t c = pi->global_band_info[band_idx].comp_id;
+            if (pi->global_band_info[band_idx].band_id < pi->components[c].bands_num) {
+                packets_num = packet_idx + 1;
+                break;
+            }
+        }
+    }
+    pi->packets_num = packets_num;
+
     return SvtJxsErrorNone;
 }
+
+uint8_t pi_is_band_discarded(const pi_t* pi, uint32_t band_idx) {
+    const uint32_t b = pi->global_band_info[band_idx].band_id;
+    const uint32_t c = pi->global_band_info[band_idx].comp_id;
+    return (b != BAND_NOT_EXIST) && (b >= pi->components[c].bands_num);
+}
@@ -213,6 +213,8 @@ SvtJxsErrorType_t pi_compute(pi_t* pi, uint8_t init_for_encoder, uint32_t comps_
                              uint32_t slice_height);
 
 SvtJxsErrorType_t pi_update_proxy_mode(pi_t* pi, proxy_mode_t proxy_mode, uint32_t verbose);
+/*Band exists in codestream but is not used in decoding with proxy mode*/
+uint8_t pi_is_band_discarded(const pi_t* pi, uint32_t band_idx);
 
 void pi_show_bands(const pi_t* const pi, int gain_priorities);
 
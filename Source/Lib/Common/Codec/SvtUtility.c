@@ -23,6 +23,24 @@ void assert_err(uint32_t condition, char* err_msg) {
     assert(condition);
 }
 
+uint64_t svt_jxs_get_time_us(void) {
+#ifdef _WIN32
+    LARGE_INTEGER counter, frequency;
+    QueryPerformanceCounter(&counter);
+    QueryPerformanceFrequency(&frequency);
+    return (uint64_t)(counter.QuadPart / frequency.QuadPart) * 1000000 +
+        (uint64_t)(counter.QuadPart % frequency.QuadPart) * 1000000 / frequency.QuadPart;
+#elif defined(CLOCK_MONOTONIC) && !defined(OLD_MACOS)
+    struct timespec curr_time;
+    clock_gettime(CLOCK_MONOTONIC, &curr_time);
+    return (uint64_t)curr_time.tv_sec * 1000000 + (uint64_t)curr_time.tv_nsec / 1000;
+#else
+    struct timeval curr_time;
+    gettimeofday(&curr_time, NULL);
+    return (uint64_t)curr_time.tv_sec * 1000000 + (uint64_t)curr_time.tv_usec;
+#endif
+}
+
 /*****************************************
  * Long Log 2
  *  This is a quick adaptation of a Number
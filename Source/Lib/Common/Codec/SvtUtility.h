@@ -52,6 +52,9 @@ static INLINE double compute_elapsed_time_in_ms(const uint64_t start_seconds, co
     return (double)s_diff * 1000.0 + (double)m_diff;
 }
 
+/*Monotonic time in microseconds, for statistics.*/
+uint64_t svt_jxs_get_time_us(void);
+
 #ifdef __cplusplus
 }
 #endif
@@ -0,0 +1,105 @@
+/*
+* Copyright(c) 2024 Intel Corporation
+* SPDX - License - Identifier: BSD - 2 - Clause - Patent
+*/
+
+#include <string.h>
+#include "SvtArena.h"
+#include "SvtMalloc.h"
+#define LOG_TAG "SvtArena"
+#include "SvtLog.h"
+
+struct SvtArenaBlock {
+    SvtArenaBlock_t* next;
+    size_t size; /*Size of data*/
+    size_t used;
+};
+
+#define ARENA_ALIGN_UP(size)    (((size) + (ALVALUE - 1)) & ~((size_t)ALVALUE - 1))
+#define ARENA_BLOCK_HEADER_SIZE ARENA_ALIGN_UP(sizeof(SvtArenaBlock_t))
+
+void svt_jxs_arena_ctor(SvtArena_t* arena, size_t block_size, SvtJxsMemPurpose_t purpose) {
+    memset(arena, 0, sizeof(*arena));
+    arena->block_size = block_size ? block_size : ARENA_BLOCK_SIZE_DEFAULT;
+    arena->purpose = purpose;
+}
+
+void svt_jxs_arena_dctor(SvtArena_t* arena) {
+    SvtArenaBlock_t* block = arena->blocks;
+    while (block) {
+        SvtArenaBlock_t* next = block->next;
+        SVT_FREE_ALIGNED(block);
+        block = next;
+    }
+    memset(arena, 0, sizeof(*arena));
+}
+
+void svt_jxs_arena_reset(SvtArena_t* arena, size_t block_size) {
+    size_t data_size = 0;
+    for (SvtArenaBlock_t* block = arena->blocks; block; block = block->next) {
+        data_size += block->size;
+    }
+    if (data_size < block_size) {
+        SvtJxsMemPurpose_t purpose = arena->purpose;
+        svt_jxs_arena_dctor(arena);
+        svt_jxs_arena_ctor(arena, block_size, purpose);
+        return;
+    }
+    for (SvtArenaBlock_t* block = arena->blocks; block; block = block->next) {
+        memset((uint8_t*)block + ARENA_BLOCK_HEADER_SIZE, 0, block->used);
+        block->used = 0;
+    }
+    arena->stats.bytes_used = 0;
+    arena->stats.allocations_num = 0;
+}
+
+static SvtArenaBlock_t* arena_block_alloc(SvtArena_t* arena, size_t size) {
+    size_t data_size = ARENA_ALIGN_UP(size > arena->block_size ? size : arena->block_size);
+    SvtArenaBlock_t* block;
+    SVT_NO_THROW_MALLOC_ALIGNED_PURPOSE(block, ARENA_BLOCK_HEADER_SIZE + data_size, arena->purpose);
+    if (!block) {
+        return NULL;
+    }
+    /*Buffers from arena are zeroed, clear whole block once*/
+    memset(block, 0, ARENA_BLOCK_HEADER_SIZE + data_size);
+    block->size = data_size;
+    block->used = 0;
+    block->next = arena->blocks;
+    arena->blocks = block;
+    arena->stats.blocks_num++;
+    arena->stats.bytes_reserved += ARENA_BLOCK_HEADER_SIZE + data_size;
+    return block;
+}
+
+void* svt_jxs_arena_alloc(SvtArena_t* arena, size_t size) {
+    size_t aligned_size = ARENA_ALIGN_UP(size);
+    /*Blocks kept by svt_jxs_arena_reset() can have free place also behind first block*/
+    SvtArenaBlock_t* block = arena->blocks;
+    while (block && block->size - block->used < aligned_size) {
+        block = block->next;
+    }
+    if (!block) {
+        block = arena_block_alloc(arena, aligned_size);
+        if (!block) {
+            return NULL;
+        }
+    }
+    void* ptr = (uint8_t*)block + ARENA_BLOCK_HEADER_SIZE + block->used;
+    block->used += aligned_size;
+    arena->stats.bytes_used += aligned_size;
+    arena->stats.allocations_num++;
+    return ptr;
+}
+
+size_t svt_jxs_arena_block_memory(size_t block_size) {
+    return ARENA_BLOCK_HEADER_SIZE + ARENA_ALIGN_UP(block_size ? block_size : ARENA_BLOCK_SIZE_DEFAULT);
+}
+
+void svt_jxs_arena_print_usage(const SvtArena_t* arena, const char* name) {
+    SVT_DEBUG("%s arena: %zu allocations, %zu bytes used, %zu bytes in %zu blocks\n",
+              name,
+              arena->stats.allocations_num,
+              arena->stats.bytes_used,
+              arena->stats.bytes_reserved,
+              arena->stats.blocks_num);
+}
@@ -0,0 +1,68 @@
+/*
+* Copyright(c) 2024 Intel Corporation
+* SPDX - License - Identifier: BSD - 2 - Clause - Patent
+*/
+
+#ifndef _SVT_ARENA_H_
+#define _SVT_ARENA_H_
+#include <stddef.h>
+#include "Definitions.h"
+
+/*Arena allocator for buffers with lifetime of codec instance or thread context.
+ *Memory is carved from large aligned blocks and released all at once by svt_jxs_arena_dctor(),
+ *so single allocation do not touch system allocator nor memory tracking.
+
+  SvtArena_t arena;
+  svt_jxs_arena_ctor(&arena, expected_size, SVT_JXS_MEM_SCRATCH);
+  a = svt_jxs_arena_alloc(&arena, size_a);
+  b = svt_jxs_arena_alloc(&arena, size_b);
+  //...
+  svt_jxs_arena_dctor(&arena); //Free a and b
+*/
+
+#define ARENA_BLOCK_SIZE_DEFAULT (256 * 1024)
+
+typedef struct SvtArenaBlock SvtArenaBlock_t;
+
+typedef struct SvtArenaStats {
+    size_t blocks_num;      /*Number of blocks allocated from system*/
+    size_t bytes_reserved;  /*Sum of blocks sizes*/
+    size_t bytes_used;      /*Sum of carved buffers sizes, with alignment padding*/
+    size_t allocations_num; /*Number of carved buffers*/
+} SvtArenaStats_t;
+
+typedef struct SvtArena {
+    SvtArenaBlock_t* blocks;    /*Last allocated block first*/
+    size_t block_size;          /*Minimum size of next block*/
+    SvtJxsMemPurpose_t purpose; /*Passed to allocator for every block*/
+    SvtArenaStats_t stats;
+} SvtArena_t;
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/*Init empty arena. First block is allocated on first svt_jxs_arena_alloc(),
+ *block_size can be set to expected summary size to get single block, 0 - default size.*/
+void svt_jxs_arena_ctor(SvtArena_t* arena, size_t block_size, SvtJxsMemPurpose_t purpose);
+/*Release all blocks, all buffers from arena become invalid.*/
+void svt_jxs_arena_dctor(SvtArena_t* arena);
+/*Release all buffers and keep blocks for next allocations, all buffers from arena become invalid.
+ *When blocks are smaller than block_size, they are freed and next block is allocated with block_size.*/
+void svt_jxs_arena_reset(SvtArena_t* arena, size_t block_size);
+/*Get zeroed buffer aligned to ALVALUE, or NULL when allocation fail.*/
+void* svt_jxs_arena_alloc(SvtArena_t* arena, size_t size);
+void svt_jxs_arena_print_usage(const SvtArena_t* arena, const char* name);
+/*Bytes requested from allocator by arena created with block_size, when all buffers fit in first block.*/
+size_t svt_jxs_arena_block_memory(size_t block_size);
+
+#ifdef __cplusplus
+}
+#endif
+
+#define SVT_ARENA_CALLOC_ARRAY(arena, pa, count)                  \
+    do {                                                          \
+        pa = svt_jxs_arena_alloc(arena, sizeof(*(pa)) * (count)); \
+    } while (0)
+
+#endif /*_SVT_ARENA_H_*/
@@ -10,6 +10,7 @@
 */
 #include <stdint.h>
 #include <limits.h>
+#include <string.h>
 
 #include "SvtMalloc.h"
 #include "SvtThreads.h"
@@ -20,6 +21,108 @@ void svt_jxs_print_alloc_fail_impl(const char* file, int line) {
     SVT_FATAL("allocate memory failed, at %s:%d\n", file, line);
 }
 
+#ifdef _MSC_VER
+#define SVT_THREAD_LOCAL __declspec(thread)
+#else
+#define SVT_THREAD_LOCAL __thread
+#endif
+
+/*Allocator is set by encoder/decoder init and close, only for calling thread,
+ *so instances with different allocators can be created in parallel.*/
+static SVT_THREAD_LOCAL const svt_jpeg_xs_allocator_t* g_allocator;
+
+const svt_jpeg_xs_allocator_t* svt_jxs_set_allocator(const svt_jpeg_xs_allocator_t* allocator) {
+    const svt_jpeg_xs_allocator_t* prev = g_allocator;
+    g_allocator = allocator;
+    return prev;
+}
+
+const svt_jpeg_xs_allocator_t* svt_jxs_get_allocator(void) {
+    return g_allocator;
+}
+
+SvtJxsErrorType_t svt_jxs_allocator_validate(const svt_jpeg_xs_allocator_t* allocator) {
+    if (allocator && (!allocator->alloc || !allocator->aligned_alloc || !allocator->free)) {
+        return SvtJxsErrorBadParameter;
+    }
+    return SvtJxsErrorNone;
+}
+
+static void* system_malloc_aligned(size_t size, size_t alignment) {
+#ifdef _WIN32
+    return _aligned_malloc(size, alignment);
+#else
+    void* ptr;
+    if (posix_memalign(&ptr, alignment, size) != 0) {
+        return NULL;
+    }
+    return ptr;
+#endif
+}
+
+static void system_free_aligned(void* ptr) {
+#ifdef _WIN32
+    _aligned_free(ptr);
+#else
+    free(ptr);
+#endif
+}
+
+void* svt_jxs_malloc(size_t size, SvtJxsMemPurpose_t purpose) {
+    const svt_jpeg_xs_allocator_t* allocator = g_allocator;
+    if (allocator) {
+        return allocator->alloc(allocator->context, size, purpose);
+    }
+    return malloc(size);
+}
+
+void* svt_jxs_calloc(size_t count, size_t size, SvtJxsMemPurpose_t purpose) {
+    const svt_jpeg_xs_allocator_t* allocator = g_allocator;
+    if (allocator) {
+        if (size && count > SIZE_MAX / size) {
+            return NULL;
+        }
+        void* ptr = allocator->alloc(allocator->context, count * size, purpose);
+        if (ptr) {
+            memset(ptr, 0, count * size);
+        }
+        return ptr;
+    }
+    return calloc(count, size);
+}
+
+void* svt_jxs_malloc_aligned(size_t size, SvtJxsMemPurpose_t purpose) {
+    const svt_jpeg_xs_allocator_t* allocator = g_allocator;
+    if (allocator) {
+        return allocator->aligned_alloc(allocator->context, size, ALVALUE, purpose);
+    }
+    return system_malloc_aligned(size, ALVALUE);
+}
+
+void svt_jxs_free(void* ptr) {
+    const svt_jpeg_xs_allocator_t* allocator = g_allocator;
+    if (!ptr) {
+        return;
+    }
+    if (allocator) {
+        allocator->free(allocator->context, ptr);
+        return;
+    }
+    free(ptr);
+}
+
+void svt_jxs_free_aligned(void* ptr) {
+    const svt_jpeg_xs_allocator_t* allocator = g_allocator;
+    if (!ptr) {
+        return;
+    }
+    if (allocator) {
+        allocator->free(allocator->context, ptr);
+        return;
+    }
+    system_free_aligned(ptr);
+}
+
 #ifdef DEBUG_MEMORY_USAGE
 
 static Handle_t g_malloc_mutex;
@@ -30,7 +133,10 @@ static void malloc_mutex_cleanup(void) {
     }
 }
 static void create_malloc_mutex(void) {
+    /*Mutex live until exit, never use allocator of current codec instance*/
+    const svt_jpeg_xs_allocator_t* allocator = svt_jxs_set_allocator(NULL);
     g_malloc_mutex = svt_jxs_create_mutex();
+    svt_jxs_set_allocator(allocator);
     atexit(malloc_mutex_cleanup);
 }
 
@@ -22,6 +22,43 @@
 #define svt_print_alloc_fail(a, b) svt_jxs_print_alloc_fail_impl(a, b)
 void svt_jxs_print_alloc_fail_impl(const char* file, int line);
 
+/*All internal allocations go through allocator set for calling thread,
+ *NULL allocator means system allocator. Return previous allocator.*/
+const svt_jpeg_xs_allocator_t* svt_jxs_set_allocator(const svt_jpeg_xs_allocator_t* allocator);
+const svt_jpeg_xs_allocator_t* svt_jxs_get_allocator(void);
+/*Check that all callbacks are set, NULL allocator is valid.*/
+SvtJxsErrorType_t svt_jxs_allocator_validate(const svt_jpeg_xs_allocator_t* allocator);
+void* svt_jxs_malloc(size_t size, SvtJxsMemPurpose_t purpose);
+void* svt_jxs_calloc(size_t count, size_t size, SvtJxsMemPurpose_t purpose);
+void* svt_jxs_malloc_aligned(size_t size, SvtJxsMemPurpose_t purpose);
+void svt_jxs_free(void* ptr);
+void svt_jxs_free_aligned(void* ptr);
+
+/*Bytes that constructor will request from allocator, split per purpose, computed without any allocation.
+ *Every *_memory() function follows allocations of its constructor and have to be updated together with it.*/
+typedef struct SvtMemSize {
+    size_t purpose[SVT_JXS_MEM_PURPOSES_NUM];
+} SvtMemSize_t;
+
+static INLINE void svt_jxs_mem_size_add(SvtMemSize_t* mem, size_t size, SvtJxsMemPurpose_t purpose) {
+    mem->purpose[purpose] += size;
+}
+
+/*Add count objects of size obj_mem*/
+static INLINE void svt_jxs_mem_size_add_objects(SvtMemSize_t* mem, const SvtMemSize_t* obj_mem, size_t count) {
+    for (int i = 0; i < SVT_JXS_MEM_PURPOSES_NUM; i++) {
+        mem->purpose[i] += obj_mem->purpose[i] * count;
+    }
+}
+
+static INLINE size_t svt_jxs_mem_size_total(const SvtMemSize_t* mem) {
+    size_t total = 0;
+    for (int i = 0; i < SVT_JXS_MEM_PURPOSES_NUM; i++) {
+        total += mem->purpose[i];
+    }
+    return total;
+}
+
 #ifdef DEBUG_MEMORY_USAGE
 void svt_jxs_print_memory_usage();
 void svt_jxs_increase_component_count();
@@ -73,22 +110,26 @@ void svt_jxs_remove_mem_entry(void* ptr, PointerType_t type);
         SVT_CHECK_MEM(p);                    \
     } while (0)
 
-#define SVT_NO_THROW_MALLOC(pointer, size)                          \
+#define SVT_NO_THROW_MALLOC_PURPOSE(pointer, size, purpose)         \
     do {                                                            \
-        void* malloced_p = malloc(size);                            \
+        void* malloced_p = svt_jxs_malloc(size, purpose);           \
         SVT_NO_THROW_ADD_MEM(malloced_p, size, POINTER_TYPE_N_PTR); \
         pointer = malloced_p;                                       \
     } while (0)
 
-#define SVT_MALLOC(pointer, size)           \
-    do {                                    \
-        SVT_NO_THROW_MALLOC(pointer, size); \
-        SVT_CHECK_MEM(pointer);             \
+#define SVT_NO_THROW_MALLOC(pointer, size) SVT_NO_THROW_MALLOC_PURPOSE(pointer, size, SVT_JXS_MEM_GENERAL)
+
+#define SVT_MALLOC_PURPOSE(pointer, size, purpose)           \
+    do {                                                     \
+        SVT_NO_THROW_MALLOC_PURPOSE(pointer, size, purpose); \
+        SVT_CHECK_MEM(pointer);                              \
     } while (0)
 
+#define SVT_MALLOC(pointer, size) SVT_MALLOC_PURPOSE(pointer, size, SVT_JXS_MEM_GENERAL)
+
 #define SVT_NO_THROW_CALLOC(pointer, count, size)                       \
     do {                                                                \
-        pointer = calloc(count, size);                                  \
+        pointer = svt_jxs_calloc(count, size, SVT_JXS_MEM_GENERAL);     \
         SVT_NO_THROW_ADD_MEM(pointer, count* size, POINTER_TYPE_C_PTR); \
     } while (0)
 
@@ -101,7 +142,7 @@ void svt_jxs_remove_mem_entry(void* ptr, PointerType_t type);
 #define SVT_FREE(pointer)                                  \
     do {                                                   \
         SVT_REMOVE_MEM_ENTRY(pointer, POINTER_TYPE_N_PTR); \
-        free(pointer);                                     \
+        svt_jxs_free(pointer);                             \
         pointer = NULL;                                    \
     } while (0)
 
@@ -110,17 +151,6 @@ void svt_jxs_remove_mem_entry(void* ptr, PointerType_t type);
         SVT_MALLOC(pa, sizeof(*(pa)) * (count)); \
     } while (0)
 
-#define SVT_REALLOC_ARRAY(pa, count)                      \
-    do {                                                  \
-        size_t size = sizeof(*(pa)) * (count);            \
-        void* p = realloc(pa, size);                      \
-        if (p) {                                          \
-            SVT_REMOVE_MEM_ENTRY(pa, POINTER_TYPE_N_PTR); \
-        }                                                 \
-        SVT_ADD_MEM(p, size, POINTER_TYPE_N_PTR);         \
-        pa = p;                                           \
-    } while (0)
-
 #define SVT_CALLOC_ARRAY(pa, count)           \
     do {                                      \
         SVT_CALLOC(pa, count, sizeof(*(pa))); \
@@ -165,34 +195,28 @@ void svt_jxs_remove_mem_entry(void* ptr, PointerType_t type);
         SVT_FREE_ARRAY(p2d);        \
     } while (0)
 
-#ifdef _WIN32
-#define SVT_MALLOC_ALIGNED(pointer, size)               \
-    do {                                                \
-        pointer = _aligned_malloc(size, ALVALUE);       \
-        SVT_ADD_MEM(pointer, size, POINTER_TYPE_A_PTR); \
+#define SVT_NO_THROW_MALLOC_ALIGNED_PURPOSE(pointer, size, purpose) \
+    do {                                                            \
+        pointer = svt_jxs_malloc_aligned(size, purpose);            \
+        SVT_NO_THROW_ADD_MEM(pointer, size, POINTER_TYPE_A_PTR);    \
     } while (0)
 
-#define SVT_FREE_ALIGNED(pointer)                          \
+#define SVT_NO_THROW_MALLOC_ALIGNED(pointer, size) SVT_NO_THROW_MALLOC_ALIGNED_PURPOSE(pointer, size, SVT_JXS_MEM_GENERAL)
+
+#define SVT_MALLOC_ALIGNED_PURPOSE(pointer, size, purpose) \
     do {                                                   \
-        SVT_REMOVE_MEM_ENTRY(pointer, POINTER_TYPE_A_PTR); \
-        _aligned_free(pointer);                            \
-        pointer = NULL;                                    \
-    } while (0)
-#else
-#define SVT_MALLOC_ALIGNED(pointer, size)                           \
-    do {                                                            \
-        if (posix_memalign((void**)&(pointer), ALVALUE, size) != 0) \
-            return SvtJxsErrorInsufficientResources;                \
-        SVT_ADD_MEM(pointer, size, POINTER_TYPE_A_PTR);             \
+        pointer = svt_jxs_malloc_aligned(size, purpose);   \
+        SVT_ADD_MEM(pointer, size, POINTER_TYPE_A_PTR);    \
     } while (0)
 
+#define SVT_MALLOC_ALIGNED(pointer, size) SVT_MALLOC_ALIGNED_PURPOSE(pointer, size, SVT_JXS_MEM_GENERAL)
+
 #define SVT_FREE_ALIGNED(pointer)                          \
     do {                                                   \
         SVT_REMOVE_MEM_ENTRY(pointer, POINTER_TYPE_A_PTR); \
-        free(pointer);                                     \
+        svt_jxs_free_aligned(pointer);                     \
         pointer = NULL;                                    \
     } while (0)
-#endif
 
 #define SVT_MALLOC_ALIGNED_ARRAY(pa, count) SVT_MALLOC_ALIGNED(pa, sizeof(*(pa)) * (count))
 
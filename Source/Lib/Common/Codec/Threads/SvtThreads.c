@@ -30,6 +30,7 @@
  ****************************************/
 #include <stdlib.h>
 #include "SvtThreads.h"
+#include "SvtMalloc.h"
 #include "SvtLog.h"
 /****************************************
   * Win32 Includes
@@ -101,7 +102,7 @@ Handle_t svt_jxs_create_thread(void *(*thread_function)(void *), void *thread_co
         pthread_attr_destroy(&attr);
         return NULL;
     }
-    pthread_t *th = malloc(sizeof(*th));
+    pthread_t *th = svt_jxs_malloc(sizeof(*th), SVT_JXS_MEM_GENERAL);
     if (th == NULL) {
         SVT_ERROR("Failed to allocate thread handle\n");
         return NULL;
@@ -109,7 +110,7 @@ Handle_t svt_jxs_create_thread(void *(*thread_function)(void *), void *thread_co
 
     if (pthread_create(th, &attr, thread_function, thread_context)) {
         SVT_ERROR("Failed to create thread: %s\n", strerror(errno));
-        free(th);
+        svt_jxs_free(th);
         return NULL;
     }
 
@@ -149,12 +150,20 @@ SvtJxsErrorType_t svt_jxs_destroy_thread(Handle_t thread_handle) {
     error_return = CloseHandle(thread_handle) ? SvtJxsErrorNone : SvtJxsErrorDestroyThreadFailed;
 #else
     error_return = pthread_join(*((pthread_t *)thread_handle), NULL) ? SvtJxsErrorDestroyThreadFailed : SvtJxsErrorNone;
-    free(thread_handle);
+    svt_jxs_free(thread_handle);
 #endif // _WIN32
 
     return error_return;
 }
 
+size_t svt_jxs_thread_memory(void) {
+#ifdef _WIN32
+    return 0;
+#else
+    return sizeof(pthread_t);
+#endif
+}
+
 /***************************************
  * svt_jxs_create_semaphore
  ***************************************/
@@ -172,7 +181,7 @@ Handle_t svt_jxs_create_semaphore(uint32_t initial_count, uint32_t max_count) {
 #else
     UNUSED(max_count);
 
-    semaphore_handle = (sem_t *)malloc(sizeof(sem_t));
+    semaphore_handle = (sem_t *)svt_jxs_malloc(sizeof(sem_t), SVT_JXS_MEM_GENERAL);
     if (semaphore_handle != NULL)
         sem_init((sem_t *)semaphore_handle, // semaphore handle
                  0,                         // shared semaphore (not local)
@@ -240,11 +249,20 @@ SvtJxsErrorType_t svt_jxs_destroy_semaphore(Handle_t semaphore_handle) {
     return_error = SvtJxsErrorNone;
 #else
     return_error = sem_destroy((sem_t *)semaphore_handle) ? SvtJxsErrorDestroySemaphoreFailed : SvtJxsErrorNone;
-    free(semaphore_handle);
+    svt_jxs_free(semaphore_handle);
 #endif
 
     return return_error;
 }
+
+size_t svt_jxs_semaphore_memory(void) {
+#if defined(_WIN32) || defined(__APPLE__)
+    return 0;
+#else
+    return sizeof(sem_t);
+#endif
+}
+
 /***************************************
  * svt_jxs_create_mutex
  ***************************************/
@@ -258,7 +276,7 @@ Handle_t svt_jxs_create_mutex(void) {
 
 #else
 
-    mutex_handle = (Handle_t)malloc(sizeof(pthread_mutex_t));
+    mutex_handle = (Handle_t)svt_jxs_malloc(sizeof(pthread_mutex_t), SVT_JXS_MEM_GENERAL);
 
     if (mutex_handle != NULL) {
         pthread_mutex_init((pthread_mutex_t *)mutex_handle,
@@ -309,12 +327,20 @@ SvtJxsErrorType_t svt_jxs_destroy_mutex(Handle_t mutex_handle) {
     return_error = CloseHandle((HANDLE)mutex_handle) ? SvtJxsErrorNone : SvtJxsErrorDestroyMutexFailed;
 #else
     return_error = pthread_mutex_destroy((pthread_mutex_t *)mutex_handle) ? SvtJxsErrorDestroyMutexFailed : SvtJxsErrorNone;
-    free(mutex_handle);
+    svt_jxs_free(mutex_handle);
 #endif
 
     return return_error;
 }
 
+size_t svt_jxs_mutex_memory(void) {
+#ifdef _WIN32
+    return 0;
+#else
+    return sizeof(pthread_mutex_t);
+#endif
+}
+
 /*
     create condition variable
 
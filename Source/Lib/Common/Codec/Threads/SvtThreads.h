@@ -50,6 +50,12 @@ extern Handle_t svt_jxs_create_mutex(void);
 extern SvtJxsErrorType_t svt_jxs_release_mutex(Handle_t mutex_handle);
 extern SvtJxsErrorType_t svt_jxs_block_on_mutex(Handle_t mutex_handle);
 extern SvtJxsErrorType_t svt_jxs_destroy_mutex(Handle_t mutex_handle);
+
+/*Bytes requested from allocator by svt_jxs_create_thread(), svt_jxs_create_semaphore() and svt_jxs_create_mutex(),
+ *always SVT_JXS_MEM_GENERAL, 0 when platform object is not allocated by library.*/
+extern size_t svt_jxs_thread_memory(void);
+extern size_t svt_jxs_semaphore_memory(void);
+extern size_t svt_jxs_mutex_memory(void);
 #ifdef _WIN32
 
 #define SVT_CREATE_THREAD(pointer, thread_function, thread_context)   \
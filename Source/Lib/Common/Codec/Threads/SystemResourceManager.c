@@ -68,6 +68,7 @@ static SvtJxsErrorType_t svt_fifo_push_back(Fifo_t *fifoPtr, ObjectWrapper_t *wr
     }
 
     fifoPtr->last_ptr->next_ptr = (ObjectWrapper_t *)NULL;
+    fifoPtr->objects_num++;
 
     return return_error;
 }
@@ -86,6 +87,7 @@ static SvtJxsErrorType_t svt_fifo_pop_front(Fifo_t *fifoPtr, ObjectWrapper_t **w
 
     // Update head of BufferPool
     fifoPtr->first_ptr = fifoPtr->first_ptr->next_ptr;
+    fifoPtr->objects_num--;
 
     return return_error;
 }
@@ -399,6 +401,26 @@ SvtJxsErrorType_t svt_jxs_system_resource_ctor(SystemResource_t *resource_ptr, u
     return return_error;
 }
 
+static void svt_muxing_queue_memory(SvtMemSize_t *mem, uint32_t object_total_count, uint32_t process_total_count) {
+    const size_t fifo_size = sizeof(Fifo_t) + svt_jxs_semaphore_memory() + svt_jxs_mutex_memory();
+    size_t size = sizeof(MuxingQueue_t) + svt_jxs_mutex_memory();
+    size += 2 * sizeof(CircularBuffer_t) + (object_total_count + process_total_count) * sizeof(void_ptr);
+    size += process_total_count * (sizeof(Fifo_t *) + fifo_size);
+    svt_jxs_mem_size_add(mem, size, SVT_JXS_MEM_GENERAL);
+}
+
+void svt_jxs_system_resource_memory(SvtMemSize_t *mem, uint32_t object_total_count, uint32_t producer_process_total_count,
+                                    uint32_t consumer_process_total_count, const SvtMemSize_t *object_mem) {
+    svt_jxs_mem_size_add(mem,
+                         sizeof(SystemResource_t) + object_total_count * (sizeof(ObjectWrapper_t *) + sizeof(ObjectWrapper_t)),
+                         SVT_JXS_MEM_GENERAL);
+    svt_jxs_mem_size_add_objects(mem, object_mem, object_total_count);
+    svt_muxing_queue_memory(mem, object_total_count, producer_process_total_count);
+    if (consumer_process_total_count) {
+        svt_muxing_queue_memory(mem, object_total_count, consumer_process_total_count);
+    }
+}
+
 Fifo_t *svt_jxs_system_resource_get_producer_fifo(const SystemResource_t *resource_ptr, uint32_t index) {
     return svt_muxing_queue_get_fifo(resource_ptr->empty_queue, index);
 }
@@ -407,6 +429,24 @@ Fifo_t *svt_jxs_system_resource_get_consumer_fifo(const SystemResource_t *resour
     return svt_muxing_queue_get_fifo(resource_ptr->full_queue, index);
 }
 
+uint32_t svt_jxs_system_resource_get_full_objects_num(const SystemResource_t *resource_ptr) {
+    MuxingQueue_t *queue_ptr = resource_ptr->full_queue;
+    uint32_t objects_num;
+
+    // Objects wait in muxing queue until any consumer ask, then in fifo of that consumer
+    svt_jxs_block_on_mutex(queue_ptr->lockout_mutex);
+    objects_num = queue_ptr->object_queue->current_count;
+    for (uint32_t i = 0; i < queue_ptr->process_total_count; i++) {
+        Fifo_t *fifo_ptr = queue_ptr->process_fifo_ptr_array[i];
+        svt_jxs_block_on_mutex(fifo_ptr->lockout_mutex);
+        objects_num += fifo_ptr->objects_num;
+        svt_jxs_release_mutex(fifo_ptr->lockout_mutex);
+    }
+    svt_jxs_release_mutex(queue_ptr->lockout_mutex);
+
+    return objects_num;
+}
+
 SvtJxsErrorType_t svt_jxs_shutdown_process(const SystemResource_t *resource_ptr) {
     //not fully constructed
     if (!resource_ptr || !resource_ptr->full_queue || !resource_ptr->empty_queue)
@@ -79,6 +79,10 @@ typedef struct Fifo {
     // last_ptr - pointer to the tail of the Fifo
     ObjectWrapper_t *last_ptr;
 
+    // objects_num - number of ObjectWrapper_ts currently in the Fifo_t,
+    //   protected by lockout_mutex.
+    uint32_t objects_num;
+
     // quit_signal - a flag that main thread sets to break out from kernels
     uint8_t quit_signal;
 
@@ -164,6 +168,15 @@ extern SvtJxsErrorType_t svt_jxs_system_resource_ctor(SystemResource_t *resource
                                                       uint32_t consumer_process_total_count, Creator_t object_ctor,
                                                       void_ptr object_init_data_ptr, DctorCall object_destroyer);
 
+/*********************************************************************
+     * svt_jxs_system_resource_memory
+     *   Add memory allocated by SVT_NEW() with svt_jxs_system_resource_ctor,
+     *   including SystemResource_t itself. object_mem is memory allocated
+     *   by object_ctor for one object.
+     *********************************************************************/
+extern void svt_jxs_system_resource_memory(SvtMemSize_t *mem, uint32_t object_total_count, uint32_t producer_process_total_count,
+                                           uint32_t consumer_process_total_count, const SvtMemSize_t *object_mem);
+
 /*********************************************************************
      * svt_jxs_system_resource_get_producer_fifo
      *   get producer fifo
@@ -188,6 +201,15 @@ Fifo_t *svt_jxs_system_resource_get_producer_fifo(const SystemResource_t *resour
      */
 Fifo_t *svt_jxs_system_resource_get_consumer_fifo(const SystemResource_t *resource_ptr, uint32_t index);
 
+/*********************************************************************
+     * svt_jxs_system_resource_get_full_objects_num
+     *   get number of full objects posted and not yet taken by consumers
+     *
+     *   resource_ptr
+     *     pointer to SystemResource
+     */
+uint32_t svt_jxs_system_resource_get_full_objects_num(const SystemResource_t *resource_ptr);
+
 /*********************************************************************
      * SystemResource_tGetEmptyObject
      *   Dequeues an empty ObjectWrapper_t from the SystemResource.  The
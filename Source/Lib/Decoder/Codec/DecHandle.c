@@ -12,12 +12,14 @@
 #include "common_dsp_rtcd.h"
 #include "decoder_dsp_rtcd.h"
 #include "ParseHeader.h"
+#include "FrameScanner.h"
 #include "DecThreadInit.h"
 #include "DecThreadSlice.h"
 #include "DecThreadFinal.h"
 #include "DecThreads.h"
 #include "Threads/SvtThreads.h"
 #include "SvtLog.h"
+#include "SvtUtility.h"
 #include "EncDec.h"
 #include "SvtJpegxsImageBufferTools.h"
 
@@ -36,10 +38,49 @@ PREFIX_API SvtJxsErrorType_t svt_jpeg_xs_decoder_get_single_frame_size_with_prox
     return static_get_single_frame_size(bitstream_buf, bitstream_buf_size, out_image_config, frame_size, fast_search, proxy_mode);
 }
 
+PREFIX_API SvtJxsErrorType_t svt_jpeg_xs_frame_scanner_init(svt_jpeg_xs_frame_scanner_t* scanner) {
+    if (scanner == NULL) {
+        return SvtJxsErrorDecoderInvalidPointer;
+    }
+    scanner->private_ptr = NULL;
+    frame_scanner_t* scanner_prv;
+    SVT_CALLOC(scanner_prv, 1, sizeof(frame_scanner_t));
+    frame_scanner_reset(scanner_prv);
+    scanner->private_ptr = scanner_prv;
+    return SvtJxsErrorNone;
+}
+
+PREFIX_API void svt_jpeg_xs_frame_scanner_close(svt_jpeg_xs_frame_scanner_t* scanner) {
+    if (scanner && scanner->private_ptr) {
+        frame_scanner_t* scanner_prv = (frame_scanner_t*)scanner->private_ptr;
+        SVT_FREE(scanner_prv->slice_offsets);
+        SVT_FREE(scanner->private_ptr);
+    }
+}
+
+PREFIX_API void svt_jpeg_xs_frame_scanner_reset(svt_jpeg_xs_frame_scanner_t* scanner) {
+    if (scanner && scanner->private_ptr) {
+        frame_scanner_reset((frame_scanner_t*)scanner->private_ptr);
+    }
+}
+
+PREFIX_API SvtJxsErrorType_t svt_jpeg_xs_frame_scanner_feed(svt_jpeg_xs_frame_scanner_t* scanner, const uint8_t* chunk,
+                                                            size_t chunk_size, size_t* bytes_used,
+                                                            svt_jpeg_xs_frame_index_t* out_index) {
+    if (scanner == NULL || scanner->private_ptr == NULL || chunk == NULL || bytes_used == NULL || out_index == NULL) {
+        return SvtJxsErrorDecoderInvalidPointer;
+    }
+    return frame_scanner_feed((frame_scanner_t*)scanner->private_ptr, chunk, chunk_size, bytes_used, out_index);
+}
+
 PREFIX_API void svt_jpeg_xs_decoder_close(svt_jpeg_xs_decoder_api_t* dec_api) {
     if (dec_api) {
         svt_jpeg_xs_decoder_api_prv_t* dec_api_prv = (svt_jpeg_xs_decoder_api_prv_t*)dec_api->private_ptr;
         if (dec_api_prv) {
+            /*Handle is released by own allocator, keep copy on stack*/
+            svt_jpeg_xs_allocator_t allocator = dec_api_prv->allocator;
+            const svt_jpeg_xs_allocator_t* allocator_prev = svt_jxs_set_allocator(allocator.alloc ? &allocator : NULL);
+
             svt_jxs_shutdown_process(dec_api_prv->input_buffer_resource_ptr);
             svt_jxs_shutdown_process(dec_api_prv->universal_buffer_resource_ptr);
             svt_jxs_shutdown_process(dec_api_prv->final_buffer_resource_ptr);
@@ -58,12 +99,15 @@ PREFIX_API void svt_jpeg_xs_decoder_close(svt_jpeg_xs_decoder_api_t* dec_api) {
             SVT_DELETE(dec_api_prv->internal_pool_decoder_instance_resource_ptr);
 
             SVT_FREE(dec_api_prv->sync_output_ringbuffer);
+            SVT_FREE(dec_api_prv->concealed_bitmaps);
             svt_jxs_free_cond_var(&dec_api_prv->sync_output_ringbuffer_left);
+            SVT_DESTROY_MUTEX(dec_api_prv->stats_mutex);
 
             for (uint32_t c = 0; c < MAX_COMPONENTS_NUM; c++) {
                 SVT_FREE(dec_api_prv->dec_common.buffer_tmp_cpih[c]);
             }
             SVT_FREE(dec_api->private_ptr);
+            svt_jxs_set_allocator(allocator_prev);
         }
         dec_api->private_ptr = NULL;
         svt_jxs_decrease_component_count();
@@ -103,39 +147,140 @@ SvtJxsErrorType_t decoder_allocate_handle(svt_jpeg_xs_decoder_api_t* dec_api) {
     return SvtJxsErrorNone;
 }
 
-PREFIX_API SvtJxsErrorType_t svt_jpeg_xs_decoder_init(uint64_t version_api_major, uint64_t version_api_minor,
-                                                      svt_jpeg_xs_decoder_api_t* dec_api, const uint8_t* bitstream_buf,
-                                                      size_t codestream_size, svt_jpeg_xs_image_config_t* out_image_config) {
-    if ((version_api_major > SVT_JPEGXS_API_VER_MAJOR) ||
-        (version_api_major == SVT_JPEGXS_API_VER_MAJOR && version_api_minor > SVT_JPEGXS_API_VER_MINOR)) {
-        return SvtJxsErrorInvalidApiVersion;
+/*Picture information of ceiling of stream parameters from dec_api, without subsampling and with maximum vertical
+ * decomposition, out_ceiling_used is set when ceiling require bigger buffers than stream*/
+static SvtJxsErrorType_t decoder_get_ceiling_pi(const svt_jpeg_xs_decoder_api_t* dec_api,
+                                                const svt_jpeg_xs_decoder_common_t* dec_common, pi_t* out_pi,
+                                                uint8_t* out_ceiling_used) {
+    const picture_header_const_t* hdr = &dec_common->picture_header_const;
+    uint32_t width = MAX((uint32_t)hdr->hdr_width, dec_api->max_width);
+    uint32_t height = MAX((uint32_t)hdr->hdr_height, dec_api->max_height);
+    uint32_t comps_num = MAX(hdr->hdr_comps_num, dec_api->max_components_num);
+    *out_ceiling_used = 0;
+    if (width == (uint32_t)hdr->hdr_width && height == (uint32_t)hdr->hdr_height && comps_num == hdr->hdr_comps_num) {
+        return SvtJxsErrorNone;
     }
-
-    if (dec_api == NULL || bitstream_buf == NULL || codestream_size == 0) {
-        return SvtJxsErrorDecoderInvalidPointer;
+    if (comps_num > MAX_COMPONENTS_NUM) {
+        if (dec_api->verbose >= VERBOSE_ERRORS) {
+            fprintf(stderr, "Ceiling of components number above %i is not supported\n", MAX_COMPONENTS_NUM);
+        }
+        return SvtJxsErrorBadParameter;
     }
 
-    SvtJxsErrorType_t ret = decoder_allocate_handle(dec_api);
+    uint32_t sx[MAX_COMPONENTS_NUM] = {1, 1, 1, 1};
+    uint32_t sy[MAX_COMPONENTS_NUM] = {1, 1, 1, 1};
+    uint32_t decom_v = MIN(2, hdr->hdr_decom_h);
+    SvtJxsErrorType_t ret = pi_compute(out_pi,
+                                       0 /*Init decoder*/,
+                                       comps_num,
+                                       hdr->hdr_coeff_group_size,
+                                       hdr->hdr_significance_group_size,
+                                       width,
+                                       height,
+                                       hdr->hdr_decom_h,
+                                       decom_v,
+                                       0,
+                                       sx,
+                                       sy,
+                                       hdr->hdr_precinct_width,
+                                       hdr->hdr_Hsl * (1 << decom_v));
     if (ret) {
-        svt_jpeg_xs_decoder_close(dec_api);
-        return ret;
+        if (dec_api->verbose >= VERBOSE_ERRORS) {
+            fprintf(stderr, "Invalid ceiling of stream parameters\n");
+        }
+        return SvtJxsErrorBadParameter;
     }
+    *out_ceiling_used = 1;
+    return SvtJxsErrorNone;
+}
 
-    svt_jxs_increase_component_count();
-    svt_jpeg_xs_decoder_api_prv_t* dec_api_prv = (svt_jpeg_xs_decoder_api_prv_t*)dec_api->private_ptr;
-    dec_api_prv->callback_decoder_ctx = dec_api;
-    dec_api_prv->callback_send_data_available = dec_api->callback_send_data_available;
-    dec_api_prv->callback_send_data_available_context = dec_api->callback_send_data_available_context;
-    dec_api_prv->callback_get_data_available = dec_api->callback_get_data_available;
-    dec_api_prv->callback_get_data_available_context = dec_api->callback_get_data_available_context;
-    dec_api_prv->verbose = dec_api->verbose;
+/*Carve buffers of decoder instances and thread contexts for current stream, allocate only when bigger are required*/
+static SvtJxsErrorType_t decoder_reset_contexts(svt_jpeg_xs_decoder_api_prv_t* dec_api_prv) {
+    SystemResource_t* pool = dec_api_prv->internal_pool_decoder_instance_resource_ptr;
+    for (uint32_t i = 0; i < pool->object_total_count; i++) {
+        SvtJxsErrorType_t ret = svt_jpeg_xs_dec_instance_reset(
+            (svt_jpeg_xs_decoder_instance_t*)pool->wrapper_ptr_pool[i]->object_ptr, &dec_api_prv->dec_common);
+        if (ret) {
+            return ret;
+        }
+    }
+    for (uint32_t i = 0; i < dec_api_prv->universal_threads_num; i++) {
+        UniversalThreadContext* context_ptr = (UniversalThreadContext*)dec_api_prv->universal_stage_context_ptr_array[i]->priv;
+        SvtJxsErrorType_t ret = svt_jpeg_xs_dec_thread_context_reset(context_ptr->dec_thread_context,
+                                                                     &dec_api_prv->dec_common.pi);
+        if (ret) {
+            return ret;
+        }
+    }
+    return SvtJxsErrorNone;
+}
 
-    dec_api_prv->packetization_mode = dec_api->packetization_mode;
-    if (dec_api_prv->packetization_mode != 0 && dec_api_prv->packetization_mode != 1) {
+/*Set pointers of items of sync_output_ringbuffer to bitmaps of concealed slices*/
+static void decoder_set_concealed_bitmaps(svt_jpeg_xs_decoder_api_prv_t* dec_api_prv) {
+    for (uint32_t i = 0; i < dec_api_prv->sync_output_ringbuffer_size; i++) {
+        dec_api_prv->sync_output_ringbuffer[i].concealed_slices = dec_api_prv->concealed_bitmaps +
+            i * dec_api_prv->concealed_bitmap_size;
+    }
+    dec_api_prv->concealed_last = dec_api_prv->concealed_bitmaps +
+        dec_api_prv->sync_output_ringbuffer_size * dec_api_prv->concealed_bitmap_size;
+}
+
+/*Grow buffers allocated by number of slices: indexes of input tasks and bitmaps of concealed slices*/
+static SvtJxsErrorType_t decoder_reserve_slices(svt_jpeg_xs_decoder_api_prv_t* dec_api_prv, uint32_t slices_num) {
+    if (slices_num <= dec_api_prv->slices_num_reserved) {
+        return SvtJxsErrorNone;
+    }
+    dec_api_prv->slices_num_reserved = slices_num;
+
+    SystemResource_t* input_resource = dec_api_prv->input_buffer_resource_ptr;
+    if (input_resource) {
+        for (uint32_t i = 0; i < input_resource->object_total_count; i++) {
+            TaskInputBitstream* input_buffer = (TaskInputBitstream*)input_resource->wrapper_ptr_pool[i]->object_ptr;
+            SVT_FREE(input_buffer->slice_offsets);
+            SVT_MALLOC(input_buffer->slice_offsets, (slices_num + 1) * sizeof(uint32_t));
+        }
+    }
+
+    if (dec_api_prv->slice_concealment) {
+        dec_api_prv->concealed_bitmap_size = DIV_ROUND_UP(slices_num, 8);
+        SystemResource_t* output_resource = dec_api_prv->output_buffer_resource_ptr;
+        for (uint32_t i = 0; i < output_resource->object_total_count; i++) {
+            TaskOutFrame* output_buffer = (TaskOutFrame*)output_resource->wrapper_ptr_pool[i]->object_ptr;
+            SVT_FREE(output_buffer->concealed_slices);
+            SVT_CALLOC(output_buffer->concealed_slices, dec_api_prv->concealed_bitmap_size, sizeof(uint8_t));
+        }
+        SVT_FREE(dec_api_prv->concealed_bitmaps);
+        SVT_CALLOC(dec_api_prv->concealed_bitmaps,
+                   (dec_api_prv->sync_output_ringbuffer_size + 1) * dec_api_prv->concealed_bitmap_size,
+                   sizeof(uint8_t));
+        decoder_set_concealed_bitmaps(dec_api_prv);
+    }
+    return SvtJxsErrorNone;
+}
+
+/*Threads and queue sizes of decoder pipeline*/
+typedef struct DecPipelineSizes {
+    uint32_t universal_threads_num;
+    uint32_t input_bitstream_queue_count; /*0 in packetization mode*/
+    uint32_t output_bitstream_queue_count;
+    uint32_t pool_decoders_instances_count;
+    uint32_t sync_output_ringbuffer_size;
+    uint32_t slices_num_reserved;
+    uint32_t concealed_bitmap_size;
+} DecPipelineSizes_t;
+
+/**********************************
+ * Validate configuration, parse stream header and compute picture information, threads and queue sizes.
+ * Nothing is allocated, shared by decoder_init() and svt_jpeg_xs_decoder_get_resources().
+ **********************************/
+static SvtJxsErrorType_t decoder_configure(const svt_jpeg_xs_decoder_api_t* dec_api, const uint8_t* bitstream_buf,
+                                           size_t codestream_size, svt_jpeg_xs_decoder_common_t* dec_common,
+                                           svt_jpeg_xs_image_config_t* out_image_config, pi_t* out_pi_ceiling,
+                                           uint8_t* out_ceiling_used, DecPipelineSizes_t* sizes) {
+    if (dec_api->packetization_mode != 0 && dec_api->packetization_mode != 1) {
         if (dec_api->verbose >= VERBOSE_ERRORS) {
             fprintf(stderr, "Unrecognized packetization mode\n");
         }
-        svt_jpeg_xs_decoder_close(dec_api);
         return SvtJxsErrorBadParameter;
     }
 
@@ -143,10 +288,179 @@ PREFIX_API SvtJxsErrorType_t svt_jpeg_xs_decoder_init(uint64_t version_api_major
         if (dec_api->verbose >= VERBOSE_ERRORS) {
             fprintf(stderr, "Unrecognized proxy mode\n");
         }
-        svt_jpeg_xs_decoder_close(dec_api);
         return SvtJxsErrorBadParameter;
     }
-    dec_api_prv->proxy_mode = dec_api->proxy_mode;
+
+    if (dec_api->stats_enable > 1) {
+        if (dec_api->verbose >= VERBOSE_ERRORS) {
+            fprintf(stderr, "Unrecognized statistics mode\n");
+        }
+        return SvtJxsErrorBadParameter;
+    }
+
+    if (dec_api->frames_in_pipeline > SVT_JXS_FRAMES_IN_PIPELINE_MAX ||
+        dec_api->frames_in_input_queue > SVT_JXS_FRAMES_IN_INPUT_QUEUE_MAX) {
+        if (dec_api->verbose >= VERBOSE_ERRORS) {
+            fprintf(stderr,
+                    "Pipeline depth out of range, max frames in pipeline %d and in input queue %d\n",
+                    SVT_JXS_FRAMES_IN_PIPELINE_MAX,
+                    SVT_JXS_FRAMES_IN_INPUT_QUEUE_MAX);
+        }
+        return SvtJxsErrorBadParameter;
+    }
+
+    //Create common decoder
+    picture_header_dynamic_t header_dynamic;
+    SvtJxsErrorType_t ret = svt_jpeg_xs_decoder_probe(
+        bitstream_buf, codestream_size, &dec_common->picture_header_const, &header_dynamic, dec_api->verbose);
+    if (ret) {
+        return ret;
+    }
+    if (dec_api->packetization_mode == 1 && header_dynamic.hdr_Lcod == 0) {
+        if (dec_api->verbose >= VERBOSE_ERRORS) {
+            fprintf(stderr, "Packetization mode(multiple packets per frame) not supported with variable bitrate coding\n");
+        }
+        return SvtJxsErrorBadParameter;
+    }
+
+    dec_common->max_frame_bitstream_size = 0;
+    if (dec_api->packetization_mode) {
+        dec_common->max_frame_bitstream_size = header_dynamic.hdr_Lcod;
+    }
+
+    ret = svt_jpeg_xs_dec_configure_common(dec_common, out_image_config, dec_api->proxy_mode, dec_api->verbose);
+    if (ret) {
+        return ret;
+    }
+
+    if (dec_api->packetization_mode && (dec_api->roi_slice_begin || dec_api->roi_slice_end)) {
+        if (dec_api->verbose >= VERBOSE_ERRORS) {
+            fprintf(stderr, "Slice range of interest not supported with packetization mode\n");
+        }
+        return SvtJxsErrorBadParameter;
+    }
+    ret = svt_jpeg_xs_dec_init_roi(
+        dec_common, dec_api->roi_slice_begin, dec_api->roi_slice_end, dec_api->roi_components_mask, dec_api->verbose);
+    if (ret) {
+        return ret;
+    }
+
+    if (dec_api->slice_concealment > 1) {
+        if (dec_api->verbose >= VERBOSE_ERRORS) {
+            fprintf(stderr, "Unrecognized slice concealment mode\n");
+        }
+        return SvtJxsErrorBadParameter;
+    }
+
+    /*Thread contexts and decoder instances are allocated for ceiling and then carved for stream*/
+    ret = decoder_get_ceiling_pi(dec_api, dec_common, out_pi_ceiling, out_ceiling_used);
+    if (ret) {
+        return ret;
+    }
+    sizes->slices_num_reserved = dec_common->pi.slice_num;
+    if (*out_ceiling_used) {
+        sizes->slices_num_reserved = MAX(sizes->slices_num_reserved, out_pi_ceiling->slice_num);
+    }
+    sizes->concealed_bitmap_size = DIV_ROUND_UP(sizes->slices_num_reserved, 8);
+
+    if (dec_api->threads_num <= 2) {
+        sizes->universal_threads_num = 1;
+    }
+    else {
+        sizes->universal_threads_num = dec_api->threads_num - 2;
+    }
+
+    /*Number of threads: adding 10 contexts to faster schedule tasks when 10 outputs are waiting on write or on synchronize output*/
+    sizes->output_bitstream_queue_count = 2 * sizes->universal_threads_num + 10;
+    sizes->input_bitstream_queue_count = 2 * sizes->universal_threads_num + 10;
+    if (dec_api->frames_in_input_queue) {
+        sizes->input_bitstream_queue_count = dec_api->frames_in_input_queue;
+    }
+    if (dec_api->packetization_mode) {
+        sizes->input_bitstream_queue_count = 0;
+    }
+    //Allocate decoder instances, by default one instance to prepare init, one to calculate and one to finish
+    sizes->pool_decoders_instances_count = dec_api->frames_in_pipeline ? dec_api->frames_in_pipeline : 3;
+    //Should be more that pool_decoders_instances_count to not reduce performance
+    sizes->sync_output_ringbuffer_size = sizes->universal_threads_num + MAX(20, sizes->pool_decoders_instances_count + 1);
+    return SvtJxsErrorNone;
+}
+
+/**********************************
+ * Memory allocated by decoder_init(), follows order of allocations in it.
+ * Contexts allocated for ceiling are carved for stream, they grow when stream need more than ceiling.
+ **********************************/
+static void decoder_memory(SvtMemSize_t* mem, const svt_jpeg_xs_decoder_api_t* dec_api,
+                           const svt_jpeg_xs_decoder_common_t* dec_common, const pi_t* pi_ceiling,
+                           const DecPipelineSizes_t* sizes) {
+    SvtMemSize_t obj_mem;
+    size_t size = sizeof(svt_jpeg_xs_decoder_api_prv_t);
+    if (dec_api->stats_enable) {
+        size += svt_jxs_mutex_memory();
+    }
+    svt_jxs_mem_size_add(mem, size, SVT_JXS_MEM_GENERAL);
+    svt_jpeg_xs_dec_common_memory(mem, dec_common);
+
+    if (!dec_api->packetization_mode) {
+        memset(&obj_mem, 0, sizeof(obj_mem));
+        input_bitstream_memory(&obj_mem, sizes->slices_num_reserved);
+        svt_jxs_system_resource_memory(mem, sizes->input_bitstream_queue_count, 1, 1, &obj_mem);
+    }
+
+    memset(&obj_mem, 0, sizeof(obj_mem));
+    svt_jxs_mem_size_add(&obj_mem, sizeof(TaskCalculateFrame), SVT_JXS_MEM_GENERAL);
+    svt_jxs_system_resource_memory(mem, sizes->universal_threads_num, 1, sizes->universal_threads_num, &obj_mem);
+
+    memset(&obj_mem, 0, sizeof(obj_mem));
+    svt_jxs_mem_size_add(&obj_mem, sizeof(TaskFinalSync), SVT_JXS_MEM_GENERAL);
+    svt_jxs_system_resource_memory(mem, sizes->output_bitstream_queue_count, sizes->universal_threads_num, 1, &obj_mem);
+
+    memset(&obj_mem, 0, sizeof(obj_mem));
+    svt_jxs_mem_size_add(&obj_mem, sizeof(ThreadContext_t*) + sizeof(ThreadContext_t), SVT_JXS_MEM_GENERAL);
+    universal_thread_context_memory(&obj_mem, &dec_common->pi, pi_ceiling);
+    svt_jxs_mem_size_add_objects(mem, &obj_mem, sizes->universal_threads_num);
+
+    size = sizes->sync_output_ringbuffer_size * sizeof(OutItem);
+    if (dec_api->slice_concealment) {
+        size += (sizes->sync_output_ringbuffer_size + 1) * sizes->concealed_bitmap_size * sizeof(uint8_t);
+    }
+    svt_jxs_mem_size_add(mem, size, SVT_JXS_MEM_GENERAL);
+
+    memset(&obj_mem, 0, sizeof(obj_mem));
+    output_frame_memory(&obj_mem, dec_api->slice_concealment, sizes->concealed_bitmap_size);
+    svt_jxs_system_resource_memory(mem, sizes->output_bitstream_queue_count, 1, 1, &obj_mem);
+
+    memset(&obj_mem, 0, sizeof(obj_mem));
+    svt_jpeg_xs_dec_instance_memory(&obj_mem, dec_common, pi_ceiling);
+    svt_jxs_system_resource_memory(mem, sizes->pool_decoders_instances_count, 1, 0, &obj_mem);
+
+    /*Threads*/
+    uint32_t threads_num = (dec_api->packetization_mode ? 0 : 1) + sizes->universal_threads_num + 1;
+    svt_jxs_mem_size_add(
+        mem, sizes->universal_threads_num * sizeof(Handle_t) + threads_num * svt_jxs_thread_memory(), SVT_JXS_MEM_GENERAL);
+}
+
+static SvtJxsErrorType_t decoder_init(svt_jpeg_xs_decoder_api_t* dec_api, const uint8_t* bitstream_buf, size_t codestream_size,
+                                      svt_jpeg_xs_image_config_t* out_image_config) {
+    SvtJxsErrorType_t ret = decoder_allocate_handle(dec_api);
+    if (ret) {
+        svt_jpeg_xs_decoder_close(dec_api);
+        return ret;
+    }
+
+    svt_jxs_increase_component_count();
+    svt_jpeg_xs_decoder_api_prv_t* dec_api_prv = (svt_jpeg_xs_decoder_api_prv_t*)dec_api->private_ptr;
+    if (dec_api->allocator) {
+        dec_api_prv->allocator = *dec_api->allocator;
+    }
+    dec_api_prv->callback_decoder_ctx = dec_api;
+    dec_api_prv->callback_send_data_available = dec_api->callback_send_data_available;
+    dec_api_prv->callback_send_data_available_context = dec_api->callback_send_data_available_context;
+    dec_api_prv->callback_get_data_available = dec_api->callback_get_data_available;
+    dec_api_prv->callback_get_data_available_context = dec_api->callback_get_data_available_context;
+    dec_api_prv->callback_frame_stats = dec_api->callback_frame_stats;
+    dec_api_prv->callback_frame_stats_context = dec_api->callback_frame_stats_context;
+    dec_api_prv->verbose = dec_api->verbose;
 
     const CPU_FLAGS cpu_flags = get_cpu_flags();
     dec_api->use_cpu_flags &= cpu_flags;
@@ -158,6 +472,22 @@ PREFIX_API SvtJxsErrorType_t svt_jpeg_xs_decoder_init(uint64_t version_api_major
     setup_common_rtcd_internal(dec_api->use_cpu_flags);
     setup_decoder_rtcd_internal(dec_api->use_cpu_flags);
 
+    pi_t pi_ceiling;
+    uint8_t ceiling_used = 0;
+    DecPipelineSizes_t sizes;
+    ret = decoder_configure(
+        dec_api, bitstream_buf, codestream_size, &dec_api_prv->dec_common, out_image_config, &pi_ceiling, &ceiling_used, &sizes);
+    if (ret) {
+        svt_jpeg_xs_decoder_close(dec_api);
+        return ret;
+    }
+    dec_api_prv->packetization_mode = dec_api->packetization_mode;
+    dec_api_prv->proxy_mode = dec_api->proxy_mode;
+    dec_api_prv->stats_enable = dec_api->stats_enable;
+    dec_api_prv->slice_concealment = dec_api->slice_concealment;
+    dec_api_prv->slices_num_reserved = sizes.slices_num_reserved;
+    dec_api_prv->concealed_bitmap_size = sizes.concealed_bitmap_size;
+
     //Init queue
     if (dec_api_prv->verbose >= VERBOSE_SYSTEM_INFO) {
         fprintf(stderr, "[Threads            : %i]\n", dec_api->threads_num);
@@ -186,28 +516,11 @@ PREFIX_API SvtJxsErrorType_t svt_jpeg_xs_decoder_init(uint64_t version_api_major
 
     memset(&dec_api_prv->slice_scheduler_ctx, 0, sizeof(svt_jpeg_xs_slice_scheduler_ctx_t));
 
-    //Create common decoder
-    picture_header_dynamic_t header_dynamic;
-    ret = svt_jpeg_xs_decoder_probe(
-        bitstream_buf, codestream_size, &dec_api_prv->dec_common.picture_header_const, &header_dynamic, dec_api_prv->verbose);
-    if (ret) {
-        svt_jpeg_xs_decoder_close(dec_api);
-        return ret;
-    }
-    if (dec_api_prv->packetization_mode == 1 && header_dynamic.hdr_Lcod == 0) {
-        if (dec_api->verbose >= VERBOSE_ERRORS) {
-            fprintf(stderr, "Packetization mode(multiple packets per frame) not supported with variable bitrate coding\n");
-        }
-        svt_jpeg_xs_decoder_close(dec_api);
-        return SvtJxsErrorBadParameter;
-    }
-
-    dec_api_prv->dec_common.max_frame_bitstream_size = 0;
-    if (dec_api_prv->packetization_mode) {
-        dec_api_prv->dec_common.max_frame_bitstream_size = header_dynamic.hdr_Lcod;
+    if (dec_api_prv->stats_enable) {
+        SVT_CREATE_MUTEX(dec_api_prv->stats_mutex);
     }
 
-    ret = svt_jpeg_xs_dec_init_common(&dec_api_prv->dec_common, out_image_config, dec_api_prv->proxy_mode, dec_api_prv->verbose);
+    ret = svt_jpeg_xs_dec_alloc_common(&dec_api_prv->dec_common);
     if (ret) {
         svt_jpeg_xs_decoder_close(dec_api);
         return ret;
@@ -235,39 +548,29 @@ PREFIX_API SvtJxsErrorType_t svt_jpeg_xs_decoder_init(uint64_t version_api_major
                 color_format_name);
     }
 
-    if (dec_api->threads_num <= 2) {
-        dec_api_prv->universal_threads_num = 1;
-    }
-    else {
-        dec_api_prv->universal_threads_num = dec_api->threads_num - 2;
-    }
-
-    /*Number of threads: adding 10 contexts to faster schedule tasks when 10 outputs are waiting on write or on synchronize output*/
-    uint32_t output_bitsteram_queue_count = 2 * dec_api_prv->universal_threads_num + 10;
-    uint32_t input_bitstream_queue_count = 2 * dec_api_prv->universal_threads_num + 10;
-    uint32_t pool_decoders_instances_count =
-        3; //Allocate decoder instances, One instance to prepare init, one to calculate and one to finish
-    dec_api_prv->sync_output_ringbuffer_size = dec_api_prv->universal_threads_num +
-        20; //Should be more that pool_decoders_instances_count to not reduce performance
+    dec_api_prv->universal_threads_num = sizes.universal_threads_num;
+    dec_api_prv->sync_output_ringbuffer_size = sizes.sync_output_ringbuffer_size;
+    dec_api_prv->input_bitstream_queue_count = sizes.input_bitstream_queue_count;
+    dec_api_prv->pool_decoders_instances_count = sizes.pool_decoders_instances_count;
 
     if (dec_api_prv->verbose >= VERBOSE_SYSTEM_INFO_ALL) {
         fprintf(stderr, "-------------------------------------------\n");
         fprintf(stderr, "[%s] universal_threads_num: %i\n", __FUNCTION__, (int)dec_api_prv->universal_threads_num);
-        fprintf(stderr, "[%s] TaskInputBitstreamQueueCount: %i\n", __FUNCTION__, (int)input_bitstream_queue_count);
-        fprintf(stderr, "[%s] OutoutBitstreamQueueCount: %i\n", __FUNCTION__, (int)output_bitsteram_queue_count);
+        fprintf(stderr, "[%s] TaskInputBitstreamQueueCount: %i\n", __FUNCTION__, (int)sizes.input_bitstream_queue_count);
+        fprintf(stderr, "[%s] OutoutBitstreamQueueCount: %i\n", __FUNCTION__, (int)sizes.output_bitstream_queue_count);
         fprintf(stderr, "[%s] sync_output_ringbuffer_size: %i\n", __FUNCTION__, (int)dec_api_prv->sync_output_ringbuffer_size);
-        fprintf(stderr, "[%s] PoolDecContextsNum: %i\n", __FUNCTION__, (int)pool_decoders_instances_count);
+        fprintf(stderr, "[%s] PoolDecContextsNum: %i\n", __FUNCTION__, (int)sizes.pool_decoders_instances_count);
     }
 
     if (!dec_api_prv->packetization_mode) {
         //Allocate Input Queue:
         SVT_NEW(dec_api_prv->input_buffer_resource_ptr,
                 svt_jxs_system_resource_ctor,
-                input_bitstream_queue_count,
+                sizes.input_bitstream_queue_count,
                 1,
                 1,
                 input_bitstream_creator,
-                NULL,
+                dec_api_prv,
                 input_bitstream_destroyer);
         dec_api_prv->input_producer_fifo_ptr = svt_jxs_system_resource_get_producer_fifo(dec_api_prv->input_buffer_resource_ptr,
                                                                                          0);
@@ -288,7 +591,7 @@ PREFIX_API SvtJxsErrorType_t svt_jpeg_xs_decoder_init(uint64_t version_api_major
 
     SVT_NEW(dec_api_prv->final_buffer_resource_ptr,
             svt_jxs_system_resource_ctor,
-            output_bitsteram_queue_count,
+            sizes.output_bitstream_queue_count,
             dec_api_prv->universal_threads_num,
             1,
             final_sync_creator,
@@ -296,6 +599,11 @@ PREFIX_API SvtJxsErrorType_t svt_jpeg_xs_decoder_init(uint64_t version_api_major
             final_sync_destroyer);
     dec_api_prv->final_consumer_fifo_ptr = svt_jxs_system_resource_get_consumer_fifo(dec_api_prv->final_buffer_resource_ptr, 0);
 
+    pi_t pi_stream = dec_api_prv->dec_common.pi;
+    if (ceiling_used) {
+        dec_api_prv->dec_common.pi = pi_ceiling;
+    }
+
     //Call after alloc Universal output queue
     SVT_ALLOC_PTR_ARRAY(dec_api_prv->universal_stage_context_ptr_array, dec_api_prv->universal_threads_num);
     for (uint32_t process_index = 0; process_index < dec_api_prv->universal_threads_num; ++process_index) {
@@ -305,7 +613,13 @@ PREFIX_API SvtJxsErrorType_t svt_jpeg_xs_decoder_init(uint64_t version_api_major
                 process_index);
     }
 
-    SVT_MALLOC(dec_api_prv->sync_output_ringbuffer, dec_api_prv->sync_output_ringbuffer_size * sizeof(OutItem));
+    SVT_CALLOC(dec_api_prv->sync_output_ringbuffer, dec_api_prv->sync_output_ringbuffer_size, sizeof(OutItem));
+    if (dec_api_prv->slice_concealment) {
+        SVT_CALLOC(dec_api_prv->concealed_bitmaps,
+                   (dec_api_prv->sync_output_ringbuffer_size + 1) * dec_api_prv->concealed_bitmap_size,
+                   sizeof(uint8_t));
+        decoder_set_concealed_bitmaps(dec_api_prv);
+    }
     ret = svt_jxs_create_cond_var(&dec_api_prv->sync_output_ringbuffer_left);
     if (ret) {
         svt_jpeg_xs_decoder_close(dec_api);
@@ -315,18 +629,18 @@ PREFIX_API SvtJxsErrorType_t svt_jpeg_xs_decoder_init(uint64_t version_api_major
 
     SVT_NEW(dec_api_prv->output_buffer_resource_ptr,
             svt_jxs_system_resource_ctor,
-            output_bitsteram_queue_count,
+            sizes.output_bitstream_queue_count,
             1,
             1,
             output_frame_creator,
-            NULL,
+            dec_api_prv,
             output_frame_destroyer);
     dec_api_prv->output_producer_fifo_ptr = svt_jxs_system_resource_get_producer_fifo(dec_api_prv->output_buffer_resource_ptr, 0);
     dec_api_prv->output_consumer_fifo_ptr = svt_jxs_system_resource_get_consumer_fifo(dec_api_prv->output_buffer_resource_ptr, 0);
 
     SVT_NEW(dec_api_prv->internal_pool_decoder_instance_resource_ptr,
             svt_jxs_system_resource_ctor,
-            pool_decoders_instances_count,
+            sizes.pool_decoders_instances_count,
             1,
             0,
             pool_decoder_instance_create_ctor,
@@ -335,6 +649,15 @@ PREFIX_API SvtJxsErrorType_t svt_jpeg_xs_decoder_init(uint64_t version_api_major
     dec_api_prv->internal_pool_decoder_instance_fifo_ptr = svt_jxs_system_resource_get_producer_fifo(
         dec_api_prv->internal_pool_decoder_instance_resource_ptr, 0);
 
+    if (ceiling_used) {
+        dec_api_prv->dec_common.pi = pi_stream;
+        ret = decoder_reset_contexts(dec_api_prv);
+        if (ret) {
+            svt_jpeg_xs_decoder_close(dec_api);
+            return ret;
+        }
+    }
+
     if (!dec_api_prv->packetization_mode) {
         /*Start threads*/
         SVT_CREATE_THREAD(dec_api_prv->input_stage_thread_handle, thread_init_stage_kernel, dec_api_prv);
@@ -360,8 +683,26 @@ PREFIX_API SvtJxsErrorType_t svt_jpeg_xs_decoder_init(uint64_t version_api_major
     return SvtJxsErrorNone;
 }
 
-PREFIX_API SvtJxsErrorType_t svt_jpeg_xs_decoder_send_frame(svt_jpeg_xs_decoder_api_t* dec_api, svt_jpeg_xs_frame_t* dec_input,
-                                                            uint8_t blocking_flag) {
+/*Copy index to input task when it match frame, last offset is position of EOC*/
+static uint8_t decoder_copy_frame_index(pi_t* pi, const svt_jpeg_xs_frame_t* dec_input, const svt_jpeg_xs_frame_index_t* index,
+                                        uint32_t* slice_offsets) {
+    if (index == NULL || index->slice_offsets == NULL || index->slices_num != pi->slice_num || index->frame_size < 2 ||
+        index->frame_size > dec_input->bitstream.used_size) {
+        return 0;
+    }
+    uint32_t prev_offset = 0;
+    for (uint32_t slice = 0; slice < pi->slice_num; slice++) {
+        if (index->slice_offsets[slice] <= prev_offset) {
+            return 0;
+        }
+        prev_offset = slice_offsets[slice] = index->slice_offsets[slice];
+    }
+    slice_offsets[pi->slice_num] = index->frame_size - 2;
+    return prev_offset < slice_offsets[pi->slice_num];
+}
+
+static SvtJxsErrorType_t decoder_send_frame(svt_jpeg_xs_decoder_api_t* dec_api, svt_jpeg_xs_frame_t* dec_input,
+                                            const svt_jpeg_xs_frame_index_t* index, uint8_t blocking_flag) {
     if (dec_api == NULL || dec_api->private_ptr == NULL || dec_input == NULL) {
         return SvtJxsErrorDecoderInvalidPointer;
     }
@@ -417,12 +758,27 @@ PREFIX_API SvtJxsErrorType_t svt_jpeg_xs_decoder_send_frame(svt_jpeg_xs_decoder_
         TaskInputBitstream* buffer_input = (TaskInputBitstream*)input_wrapper_ptr->object_ptr;
         buffer_input->dec_input = *dec_input; /*Copy output buffer structure.*/
         buffer_input->flags = 0;
+        buffer_input->time_send_us = dec_api_prv->stats_enable ? svt_jxs_get_time_us() : 0;
+        buffer_input->slice_offsets_set = decoder_copy_frame_index(pi, dec_input, index, buffer_input->slice_offsets);
+        SVT_ATOMIC_ADD32(&dec_api_prv->frames_sent, 1);
         svt_jxs_post_full_object(input_wrapper_ptr);
         return SvtJxsErrorNone;
     }
     return SvtJxsErrorNoErrorEmptyQueue; //Queue is full, please try again later
 }
 
+PREFIX_API SvtJxsErrorType_t svt_jpeg_xs_decoder_send_frame(svt_jpeg_xs_decoder_api_t* dec_api, svt_jpeg_xs_frame_t* dec_input,
+                                                            uint8_t blocking_flag) {
+    return decoder_send_frame(dec_api, dec_input, NULL, blocking_flag);
+}
+
+PREFIX_API SvtJxsErrorType_t svt_jpeg_xs_decoder_send_frame_with_index(svt_jpeg_xs_decoder_api_t* dec_api,
+                                                                       svt_jpeg_xs_frame_t* dec_input,
+                                                                       const svt_jpeg_xs_frame_index_t* index,
+                                                                       uint8_t blocking_flag) {
+    return decoder_send_frame(dec_api, dec_input, index, blocking_flag);
+}
+
 PREFIX_API SvtJxsErrorType_t svt_jpeg_xs_decoder_send_packet(svt_jpeg_xs_decoder_api_t* dec_api, svt_jpeg_xs_frame_t* dec_input,
                                                              uint32_t* bytes_used) {
     if (dec_api == NULL || dec_api->private_ptr == NULL || dec_input == NULL || bytes_used == NULL) {
@@ -452,9 +808,14 @@ PREFIX_API SvtJxsErrorType_t svt_jpeg_xs_decoder_get_frame(svt_jpeg_xs_decoder_a
 
         *dec_output = input_buffer_ptr->dec_input; //Copy structure
         SvtJxsErrorType_t frame_error = input_buffer_ptr->frame_error;
+        if (dec_api_prv->slice_concealment && frame_error == SvtJxsErrorNone) {
+            memcpy(dec_api_prv->concealed_last, input_buffer_ptr->concealed_slices, dec_api_prv->concealed_bitmap_size);
+            dec_api_prv->concealed_last_num = input_buffer_ptr->concealed_num;
+        }
 
         //Release buffer back:
         svt_jxs_release_object(wrapper_ptr);
+        SVT_ATOMIC_ADD32(&dec_api_prv->frames_received, 1);
         return frame_error;
     }
     else {
@@ -488,6 +849,7 @@ PREFIX_API SvtJxsErrorType_t svt_jpeg_xs_decoder_send_eoc(svt_jpeg_xs_decoder_ap
         dec_api_prv->slice_scheduler_ctx.sync_output_frame_idx = (dec_api_prv->slice_scheduler_ctx.sync_output_frame_idx + 1) %
             dec_api_prv->sync_output_ringbuffer_size;
         dec_api_prv->slice_scheduler_ctx.frame_num++;
+        SVT_ATOMIC_ADD32(&dec_api_prv->frames_sent, 1);
 
         ObjectWrapper_t* universal_wrapper_ptr = NULL;
         ret = svt_jxs_get_empty_object(dec_api_prv->universal_producer_fifo_ptr, &universal_wrapper_ptr);
@@ -504,6 +866,8 @@ PREFIX_API SvtJxsErrorType_t svt_jpeg_xs_decoder_send_eoc(svt_jpeg_xs_decoder_ap
         /*Use wrapper output only to propagate error to Thread Final*/
         buffer_output->frame_error = SvtJxsDecoderEndOfCodestream;
         buffer_output->slice_id = 0;
+        buffer_output->slice_missing = 0;
+        dec_ctx->sync_slice_first = 0;
         // Atomic: final thread reads this concurrently while processing earlier slices
         SVT_ATOMIC_STORE32(&dec_ctx->sync_num_slices_to_receive, 1);
 
@@ -524,9 +888,238 @@ PREFIX_API SvtJxsErrorType_t svt_jpeg_xs_decoder_send_eoc(svt_jpeg_xs_decoder_ap
             TaskInputBitstream* buffer_input = (TaskInputBitstream*)input_wrapper_ptr->object_ptr;
             memset(&buffer_input->dec_input, 0, sizeof(buffer_input->dec_input));
             buffer_input->flags = SvtJxsDecoderEndOfCodestream;
+            buffer_input->time_send_us = 0;
+            SVT_ATOMIC_ADD32(&dec_api_prv->frames_sent, 1);
             svt_jxs_post_full_object(input_wrapper_ptr);
             return SvtJxsErrorNone;
         }
     }
     return SvtJxsErrorUndefined;
 }
+
+PREFIX_API SvtJxsErrorType_t svt_jpeg_xs_decoder_init(uint64_t version_api_major, uint64_t version_api_minor,
+                                                      svt_jpeg_xs_decoder_api_t* dec_api, const uint8_t* bitstream_buf,
+                                                      size_t codestream_size, svt_jpeg_xs_image_config_t* out_image_config) {
+    if ((version_api_major > SVT_JPEGXS_API_VER_MAJOR) ||
+        (version_api_major == SVT_JPEGXS_API_VER_MAJOR && version_api_minor > SVT_JPEGXS_API_VER_MINOR)) {
+        return SvtJxsErrorInvalidApiVersion;
+    }
+
+    if (dec_api == NULL || bitstream_buf == NULL || codestream_size == 0) {
+        return SvtJxsErrorDecoderInvalidPointer;
+    }
+
+    if (svt_jxs_allocator_validate(dec_api->allocator)) {
+        if (dec_api->verbose >= VERBOSE_ERRORS) {
+            fprintf(stderr, "All allocator callbacks have to be set\n");
+        }
+        return SvtJxsErrorBadParameter;
+    }
+
+    const svt_jpeg_xs_allocator_t* allocator_prev = svt_jxs_set_allocator(dec_api->allocator);
+    SvtJxsErrorType_t ret = decoder_init(dec_api, bitstream_buf, codestream_size, out_image_config);
+    svt_jxs_set_allocator(allocator_prev);
+    return ret;
+}
+
+PREFIX_API SvtJxsErrorType_t svt_jpeg_xs_decoder_get_resources(uint64_t version_api_major, uint64_t version_api_minor,
+                                                               const svt_jpeg_xs_decoder_api_t* dec_api,
+                                                               const uint8_t* bitstream_buf, size_t codestream_size,
+                                                               svt_jpeg_xs_resources_t* out_resources) {
+    if (dec_api == NULL || out_resources == NULL) {
+        return SvtJxsErrorDecoderInvalidPointer;
+    }
+
+    if ((version_api_major > SVT_JPEGXS_API_VER_MAJOR) ||
+        (version_api_major == SVT_JPEGXS_API_VER_MAJOR && version_api_minor > SVT_JPEGXS_API_VER_MINOR)) {
+        return SvtJxsErrorInvalidApiVersion;
+    }
+    if (bitstream_buf == NULL || codestream_size == 0) {
+        return SvtJxsErrorDecoderInvalidPointer;
+    }
+
+    /*Configuration and stream header are validated as on init, memory is computed from sizes of all objects created by init*/
+    svt_jpeg_xs_decoder_api_t dec_api_tmp = *dec_api;
+    dec_api_tmp.verbose = VERBOSE_NONE;
+    svt_jpeg_xs_decoder_common_t dec_common;
+    svt_jpeg_xs_image_config_t image_config;
+    pi_t pi_ceiling;
+    uint8_t ceiling_used = 0;
+    DecPipelineSizes_t sizes;
+    memset(&dec_common, 0, sizeof(dec_common));
+    SvtJxsErrorType_t ret = decoder_configure(
+        &dec_api_tmp, bitstream_buf, codestream_size, &dec_common, &image_config, &pi_ceiling, &ceiling_used, &sizes);
+    if (ret) {
+        return ret;
+    }
+
+    SvtMemSize_t mem;
+    memset(&mem, 0, sizeof(mem));
+    decoder_memory(&mem, &dec_api_tmp, &dec_common, ceiling_used ? &pi_ceiling : NULL, &sizes);
+
+    memset(out_resources, 0, sizeof(*out_resources));
+    out_resources->threads_num[SVT_JXS_STAGE_INIT] = dec_api->packetization_mode ? 0 : 1;
+    out_resources->threads_num[SVT_JXS_STAGE_SLICE] = sizes.universal_threads_num;
+    out_resources->threads_num[SVT_JXS_STAGE_FINAL] = 1;
+    out_resources->frames_in_pipeline = sizes.pool_decoders_instances_count;
+    out_resources->frames_in_input_queue = sizes.input_bitstream_queue_count;
+    out_resources->memory_peak = svt_jxs_mem_size_total(&mem);
+    memcpy(out_resources->memory_peak_purpose, mem.purpose, sizeof(out_resources->memory_peak_purpose));
+    return SvtJxsErrorNone;
+}
+
+PREFIX_API SvtJxsErrorType_t svt_jpeg_xs_decoder_get_memory_footprint(uint64_t version_api_major, uint64_t version_api_minor,
+                                                                      const svt_jpeg_xs_decoder_api_t* dec_api,
+                                                                      const uint8_t* bitstream_buf, size_t codestream_size,
+                                                                      size_t* out_footprint) {
+    if (dec_api == NULL || out_footprint == NULL) {
+        return SvtJxsErrorDecoderInvalidPointer;
+    }
+
+    svt_jpeg_xs_resources_t resources;
+    SvtJxsErrorType_t ret = svt_jpeg_xs_decoder_get_resources(
+        version_api_major, version_api_minor, dec_api, bitstream_buf, codestream_size, &resources);
+    if (ret) {
+        return ret;
+    }
+    *out_footprint = resources.memory_peak;
+    return SvtJxsErrorNone;
+}
+
+void decoder_stats_publish(svt_jpeg_xs_decoder_api_prv_t* dec_api_prv, const svt_jpeg_xs_frame_stats_t* stats) {
+    svt_jxs_block_on_mutex(dec_api_prv->stats_mutex);
+    dec_api_prv->stats_last = *stats;
+    dec_api_prv->stats_last_valid = 1;
+    svt_jxs_release_mutex(dec_api_prv->stats_mutex);
+
+    if (dec_api_prv->callback_frame_stats) {
+        dec_api_prv->callback_frame_stats(dec_api_prv->callback_decoder_ctx, stats, dec_api_prv->callback_frame_stats_context);
+    }
+}
+
+PREFIX_API SvtJxsErrorType_t svt_jpeg_xs_decoder_get_frame_stats(svt_jpeg_xs_decoder_api_t* dec_api,
+                                                                 svt_jpeg_xs_frame_stats_t* out_stats) {
+    if (dec_api == NULL || dec_api->private_ptr == NULL || out_stats == NULL) {
+        return SvtJxsErrorDecoderInvalidPointer;
+    }
+
+    svt_jpeg_xs_decoder_api_prv_t* dec_api_prv = (svt_jpeg_xs_decoder_api_prv_t*)dec_api->private_ptr;
+    if (!dec_api_prv->stats_enable) {
+        return SvtJxsErrorBadParameter;
+    }
+
+    SvtJxsErrorType_t ret = SvtJxsErrorNoErrorEmptyQueue;
+    svt_jxs_block_on_mutex(dec_api_prv->stats_mutex);
+    if (dec_api_prv->stats_last_valid) {
+        *out_stats = dec_api_prv->stats_last;
+        ret = SvtJxsErrorNone;
+    }
+    svt_jxs_release_mutex(dec_api_prv->stats_mutex);
+    return ret;
+}
+
+PREFIX_API SvtJxsErrorType_t svt_jpeg_xs_decoder_get_concealed_slices(svt_jpeg_xs_decoder_api_t* dec_api, uint8_t* out_bitmap,
+                                                                     uint32_t bitmap_size, uint32_t* out_concealed_num) {
+    if (dec_api == NULL || dec_api->private_ptr == NULL || out_concealed_num == NULL) {
+        return SvtJxsErrorDecoderInvalidPointer;
+    }
+
+    svt_jpeg_xs_decoder_api_prv_t* dec_api_prv = (svt_jpeg_xs_decoder_api_prv_t*)dec_api->private_ptr;
+    if (!dec_api_prv->slice_concealment) {
+        return SvtJxsErrorBadParameter;
+    }
+    if (out_bitmap) {
+        uint32_t bitmap_size_required = DIV_ROUND_UP(dec_api_prv->dec_common.pi.slice_num, 8);
+        if (bitmap_size < bitmap_size_required) {
+            return SvtJxsErrorBadParameter;
+        }
+        memset(out_bitmap, 0, bitmap_size);
+        memcpy(out_bitmap, dec_api_prv->concealed_last, bitmap_size_required);
+    }
+    *out_concealed_num = dec_api_prv->concealed_last_num;
+    return SvtJxsErrorNone;
+}
+
+static SvtJxsErrorType_t decoder_reconfigure(svt_jpeg_xs_decoder_api_t* dec_api, const uint8_t* bitstream_buf,
+                                             size_t codestream_size, svt_jpeg_xs_image_config_t* out_image_config) {
+    svt_jpeg_xs_decoder_api_prv_t* dec_api_prv = (svt_jpeg_xs_decoder_api_prv_t*)dec_api->private_ptr;
+    svt_jpeg_xs_decoder_common_t* dec_common = &dec_api_prv->dec_common;
+
+    picture_header_const_t picture_header_const;
+    picture_header_dynamic_t header_dynamic;
+    SvtJxsErrorType_t ret = svt_jpeg_xs_decoder_probe(
+        bitstream_buf, codestream_size, &picture_header_const, &header_dynamic, dec_api_prv->verbose);
+    if (ret) {
+        return ret;
+    }
+    if (dec_api_prv->packetization_mode == 1 && header_dynamic.hdr_Lcod == 0) {
+        if (dec_api_prv->verbose >= VERBOSE_ERRORS) {
+            fprintf(stderr, "Packetization mode(multiple packets per frame) not supported with variable bitrate coding\n");
+        }
+        return SvtJxsErrorBadParameter;
+    }
+
+    dec_common->picture_header_const = picture_header_const;
+    dec_common->max_frame_bitstream_size = 0;
+    if (dec_api_prv->packetization_mode) {
+        dec_common->max_frame_bitstream_size = header_dynamic.hdr_Lcod;
+    }
+    ret = svt_jpeg_xs_dec_init_common(dec_common, out_image_config, dec_api_prv->proxy_mode, dec_api_prv->verbose);
+    if (ret) {
+        return ret;
+    }
+    if (dec_api_prv->packetization_mode && (dec_api->roi_slice_begin || dec_api->roi_slice_end)) {
+        if (dec_api_prv->verbose >= VERBOSE_ERRORS) {
+            fprintf(stderr, "Slice range of interest not supported with packetization mode\n");
+        }
+        return SvtJxsErrorBadParameter;
+    }
+    ret = svt_jpeg_xs_dec_init_roi(
+        dec_common, dec_api->roi_slice_begin, dec_api->roi_slice_end, dec_api->roi_components_mask, dec_api_prv->verbose);
+    if (ret) {
+        return ret;
+    }
+
+    ret = decoder_reserve_slices(dec_api_prv, dec_common->pi.slice_num);
+    if (ret) {
+        return ret;
+    }
+    ret = decoder_reset_contexts(dec_api_prv);
+    if (ret) {
+        return ret;
+    }
+
+    if (dec_api_prv->verbose >= VERBOSE_SYSTEM_INFO) {
+        fprintf(stderr,
+                "SVT [config]: Reconfigured Stream Resolution [width x height]\t: %d x %d\n",
+                picture_header_const.hdr_width,
+                picture_header_const.hdr_height);
+    }
+    return SvtJxsErrorNone;
+}
+
+PREFIX_API SvtJxsErrorType_t svt_jpeg_xs_decoder_reconfigure(svt_jpeg_xs_decoder_api_t* dec_api, const uint8_t* bitstream_buf,
+                                                             size_t codestream_size,
+                                                             svt_jpeg_xs_image_config_t* out_image_config) {
+    if (dec_api == NULL || dec_api->private_ptr == NULL || bitstream_buf == NULL || codestream_size == 0 ||
+        out_image_config == NULL) {
+        return SvtJxsErrorDecoderInvalidPointer;
+    }
+
+    svt_jpeg_xs_decoder_api_prv_t* dec_api_prv = (svt_jpeg_xs_decoder_api_prv_t*)dec_api->private_ptr;
+    /*Received is loaded first, it never exceeds sent, so equal values mean nothing was in flight*/
+    uint32_t frames_received = SVT_ATOMIC_LOAD32(&dec_api_prv->frames_received);
+    uint32_t frames_sent = SVT_ATOMIC_LOAD32(&dec_api_prv->frames_sent);
+    if (frames_sent != frames_received || dec_api_prv->slice_scheduler_ctx.wrapper_ptr_decoder_ctx) {
+        if (dec_api_prv->verbose >= VERBOSE_ERRORS) {
+            fprintf(stderr, "Reconfiguration require to receive all frames sent to decoder\n");
+        }
+        return SvtJxsErrorBadParameter;
+    }
+
+    svt_jpeg_xs_allocator_t allocator = dec_api_prv->allocator;
+    const svt_jpeg_xs_allocator_t* allocator_prev = svt_jxs_set_allocator(allocator.alloc ? &allocator : NULL);
+    SvtJxsErrorType_t ret = decoder_reconfigure(dec_api, bitstream_buf, codestream_size, out_image_config);
+    svt_jxs_set_allocator(allocator_prev);
+    return ret;
+}
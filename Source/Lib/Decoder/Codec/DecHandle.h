@@ -24,7 +24,10 @@ typedef struct {
     uint32_t sync_output_frame_idx;
     uint32_t frame_error_slice;
     SvtJxsErrorType_t frame_error; //Positive read size of frame in bitstream, otherwise error code.
-    uint32_t slice_next_to_recalc; //TODO: Recalculate any received Pair of slices, not from top to bottom.
+    svt_jpeg_xs_frame_stats_t stats; //Set only when stats_enable
+    uint64_t stats_time_send_us;
+    uint8_t* concealed_slices; //Bitmap of concealed slices, set only when slice_concealment
+    uint32_t concealed_num;
 } OutItem;
 
 typedef struct svt_jpeg_xs_slice_scheduler_ctx {
@@ -52,10 +55,30 @@ typedef struct svt_jpeg_xs_decoder_api_prv {
      * No synchronization required.*/
     void (*callback_get_data_available)(svt_jpeg_xs_decoder_api_t* decoder, void* context);
     void* callback_get_data_available_context;
+    /* Callback: Call when statistics of frame are ready, from final thread.*/
+    void (*callback_frame_stats)(svt_jpeg_xs_decoder_api_t* decoder, const svt_jpeg_xs_frame_stats_t* stats, void* context);
+    void* callback_frame_stats_context;
+    uint8_t stats_enable;                 /*Collect per frame statistics in threads*/
+    Handle_t stats_mutex;                 /*Protect stats_last*/
+    svt_jpeg_xs_frame_stats_t stats_last; /*Statistics of last frame ready to get*/
+    uint8_t stats_last_valid;
+
+    uint8_t slice_concealment;        /*Conceal invalid slices instead of fail of frame*/
+    uint32_t concealed_bitmap_size;   /*Bytes of bitmap of concealed slices of one frame, for slices_num_reserved*/
+    uint8_t* concealed_bitmaps;       /*Bitmaps of items of sync_output_ringbuffer*/
+    uint8_t* concealed_last;          /*Bitmap of last frame returned by get_frame*/
+    uint32_t concealed_last_num;
+
+    uint32_t slices_num_reserved; /*Slices of buffers allocated by number of slices, grown on reconfiguration*/
+    /*Frames and EOC sent to decoder and received by svt_jpeg_xs_decoder_get_frame(), to check on reconfiguration
+     *that decoder is empty. Updated by SVT_ATOMIC_ADD32, send and get can be called from different threads.*/
+    uint32_t frames_sent;
+    uint32_t frames_received;
 
     uint32_t verbose;
     uint8_t packetization_mode;
     proxy_mode_t proxy_mode;
+    svt_jpeg_xs_allocator_t allocator; /*Copy of user allocator, alloc == NULL - system allocator*/
 
     svt_jpeg_xs_decoder_common_t dec_common; /*Common decoder*/
 
@@ -98,6 +121,8 @@ typedef struct svt_jpeg_xs_decoder_api_prv {
      * type of context: UniversalThreadContext
      */
     uint32_t universal_threads_num;                      //Number of threads
+    uint32_t input_bitstream_queue_count;                //Frames waiting in input queue, 0 in packetization mode
+    uint32_t pool_decoders_instances_count;              //Frames decoded at once
     Handle_t* universal_stage_thread_handle_array;       //Threads
     ThreadContext_t** universal_stage_context_ptr_array; //Contexts for threads UniversalThreadContext
 
@@ -143,6 +168,9 @@ typedef struct svt_jpeg_xs_decoder_api_prv {
 extern "C" {
 #endif
 
+/*Store statistics of finished frame and call user callback, call only from final thread.*/
+void decoder_stats_publish(svt_jpeg_xs_decoder_api_prv_t* dec_api_prv, const svt_jpeg_xs_frame_stats_t* stats);
+
 #ifdef __cplusplus
 }
 #endif
@@ -7,6 +7,7 @@
 #include "DecThreadFinal.h"
 #include "Threads/SvtThreads.h"
 #include "DecHandle.h"
+#include "SvtUtility.h"
 
 SvtJxsErrorType_t final_sync_creator(void_ptr* object_dbl_ptr, void_ptr object_init_data_ptr) {
     UNUSED(object_init_data_ptr);
@@ -37,7 +38,6 @@ void* thread_final_stage_kernel(void* input_ptr) {
     void (*callback_get)(svt_jpeg_xs_decoder_api_t*, void*) = dec_api_prv->callback_get_data_available;
 
     uint64_t buffer_begin_id = 0;
-    memset(sync_output_ringbuffer, 0, sync_output_ringbuffer_size * sizeof(OutItem));
 
     for (;;) {
         ObjectWrapper_t* input_wrapper_ptr;
@@ -47,6 +47,7 @@ void* thread_final_stage_kernel(void* input_ptr) {
         }
         SVT_GET_FULL_OBJECT(dec_api_prv->final_consumer_fifo_ptr, &input_wrapper_ptr);
         TaskFinalSync* input_buffer_ptr = (TaskFinalSync*)input_wrapper_ptr->object_ptr;
+        uint64_t stats_time_begin_us = dec_api_prv->stats_enable ? svt_jxs_get_time_us() : 0;
         ObjectWrapper_t* wrapper_ptr_decoder_ctx = input_buffer_ptr->wrapper_ptr_decoder_ctx;
         svt_jpeg_xs_decoder_instance_t* dec_ctx = wrapper_ptr_decoder_ctx->object_ptr;
         picture_header_const_t* picture_header_const = &dec_api_prv->dec_common.picture_header_const;
@@ -54,13 +55,8 @@ void* thread_final_stage_kernel(void* input_ptr) {
         OutItem* item = &sync_output_ringbuffer[dec_ctx->sync_output_frame_idx];
 
         //If Slice thread exited with error, release thread that is waiting for it to be done
-        if (!dec_ctx->sync_slices_idwt) {
-            svt_jxs_set_cond_var(&dec_ctx->map_slices_decode_done[input_buffer_ptr->slice_id], SYNC_OK);
-        }
-        else {
-            if (input_buffer_ptr->frame_error) {
-                svt_jxs_set_cond_var(&dec_ctx->map_slices_decode_done[input_buffer_ptr->slice_id], SYNC_ERROR);
-            }
+        if (dec_ctx->sync_slices_idwt && input_buffer_ptr->frame_error) {
+            svt_jxs_set_cond_var(&dec_ctx->map_slices_decode_done[input_buffer_ptr->slice_id], SYNC_ERROR);
         }
 
         if (item->in_use == 0) {
@@ -73,7 +69,14 @@ void* thread_final_stage_kernel(void* input_ptr) {
             item->dec_input = dec_ctx->dec_input;
             item->frame_error_slice = 0;
             item->frame_error = input_buffer_ptr->frame_error;
-            item->slice_next_to_recalc = 0;
+            if (item->concealed_slices) {
+                memset(item->concealed_slices, 0, dec_api_prv->concealed_bitmap_size);
+                item->concealed_num = 0;
+            }
+            if (dec_api_prv->stats_enable) {
+                item->stats = dec_ctx->stats;
+                item->stats_time_send_us = dec_ctx->stats_time_send_us;
+            }
         }
         else {
             assert(item->ready_to_send == 0);
@@ -90,24 +93,19 @@ void* thread_final_stage_kernel(void* input_ptr) {
             }
         }
 
-        if (!dec_ctx->sync_slices_idwt) {
-            /*IDWT between slices. Only when universal thread not calculate fully IDWT*/
-            if (item->frame_error == 0) {
-                // Atomic: init thread may reduce sync_num_slices_to_receive on error concurrently
-                while ((item->slice_next_to_recalc < SVT_ATOMIC_LOAD32(&dec_ctx->sync_num_slices_to_receive)) &&
-                       dec_ctx->map_slices_decode_done[item->slice_next_to_recalc].val) {
-                    SvtJxsErrorType_t error = svt_jpeg_xs_decode_final_slice_overlap(
-                        dec_ctx, &item->dec_input.image, item->slice_next_to_recalc);
-                    if (error) {
-                        if (item->slice_next_to_recalc > input_buffer_ptr->slice_id) {
-                            item->frame_error_slice = item->slice_next_to_recalc;
-                            item->frame_error = error;
-                        }
-                        break;
-                    }
-                    item->slice_next_to_recalc++;
-                }
+        if (input_buffer_ptr->slice_concealed) {
+            item->concealed_slices[input_buffer_ptr->slice_id / 8] |= 1 << (input_buffer_ptr->slice_id % 8);
+            item->concealed_num++;
+        }
+
+        if (dec_api_prv->stats_enable) {
+            svt_jpeg_xs_frame_stats_t* stats = &item->stats;
+            if (stats->slices_num == 0 || input_buffer_ptr->slice_time_us < stats->slice_time_min_us) {
+                stats->slice_time_min_us = input_buffer_ptr->slice_time_us;
             }
+            stats->slice_time_max_us = MAX(stats->slice_time_max_us, input_buffer_ptr->slice_time_us);
+            stats->stage_time_us[SVT_JXS_STAGE_SLICE] += input_buffer_ptr->slice_time_us;
+            stats->slices_num++;
         }
 
         // Atomic: init thread may reduce sync_num_slices_to_receive on error concurrently
@@ -118,6 +116,20 @@ void* thread_final_stage_kernel(void* input_ptr) {
             if ((item->frame_error == 0) && picture_header_const->hdr_Cpih) {
                 item->frame_error = svt_jpeg_xs_decode_final(dec_ctx, &item->dec_input.image);
             }
+            if ((item->frame_error == 0) && item->concealed_num) {
+                /*After IDWT of whole frame, overlap of neighbour slices write also rows of concealed slice*/
+                for (uint32_t slice = 0; slice < dec_api_prv->dec_common.pi.slice_num; slice++) {
+                    if (item->concealed_slices[slice / 8] & (1 << (slice % 8))) {
+                        svt_jpeg_xs_decode_slice_conceal(dec_ctx, &item->dec_input.image, slice);
+                    }
+                }
+                if (dec_api_prv->verbose >= VERBOSE_WARNINGS) {
+                    fprintf(stderr,
+                            "Warning: Frame %i decoded with %u concealed slices\n",
+                            (int)item->frame_num,
+                            item->concealed_num);
+                }
+            }
             /*if (item->frame_error < 0) {
                 Release output buffer when error
                 item->image_buffer = NULL;
@@ -130,6 +142,10 @@ void* thread_final_stage_kernel(void* input_ptr) {
             }
         }
 
+        if (stats_time_begin_us) {
+            item->stats.stage_time_us[SVT_JXS_STAGE_FINAL] += svt_jxs_get_time_us() - stats_time_begin_us;
+        }
+
         //Release actual input task
         svt_jxs_release_object(input_wrapper_ptr);
 
@@ -151,12 +167,22 @@ void* thread_final_stage_kernel(void* input_ptr) {
             buffer_output->dec_input.bitstream.ready_to_release = 1;
             buffer_output->dec_input.image.ready_to_release = 1;
             buffer_output->frame_error = item->frame_error;
+            if (item->concealed_slices) {
+                memcpy(buffer_output->concealed_slices, item->concealed_slices, dec_api_prv->concealed_bitmap_size);
+                buffer_output->concealed_num = item->concealed_num;
+            }
 
             if (dec_api_prv->verbose >= VERBOSE_INFO_MULTITHREADING) {
                 fprintf(stderr, "[%s] Send frame  %i Final thread\n", __FUNCTION__, (int)item->frame_num);
             }
 
             svt_jxs_post_full_object(final_wrapper_ptr);
+            if (dec_api_prv->stats_enable && item->frame_error != SvtJxsDecoderEndOfCodestream) {
+                item->stats.latency_us = svt_jxs_get_time_us() - item->stats_time_send_us;
+                item->stats.output_queue_depth = svt_jxs_system_resource_get_full_objects_num(
+                    dec_api_prv->output_buffer_resource_ptr);
+                decoder_stats_publish(dec_api_prv, &item->stats);
+            }
             /*Callback frame is ready to get.*/
             if (callback_get) {
                 callback_get(callback_decoder_ctx, callback_get_context);
@@ -14,6 +14,8 @@ typedef struct {
     ObjectWrapper_t* wrapper_ptr_decoder_ctx;
     uint32_t slice_id;
     int32_t frame_error;
+    uint8_t slice_concealed; /*Slice missing or invalid, rows are filled by final thread*/
+    uint64_t slice_time_us; /*Set only when stats_enable*/
 } TaskFinalSync;
 
 void* thread_final_stage_kernel(void* input_ptr);
@@ -11,18 +11,24 @@
 #include "SvtJpegxsImageBufferTools.h"
 
 SvtJxsErrorType_t input_bitstream_creator(void_ptr* object_dbl_ptr, void_ptr object_init_data_ptr) {
-    UNUSED(object_init_data_ptr);
+    svt_jpeg_xs_decoder_api_prv_t* dec_api_prv = (svt_jpeg_xs_decoder_api_prv_t*)object_init_data_ptr;
     TaskInputBitstream* input_buffer;
 
     *object_dbl_ptr = NULL;
     SVT_CALLOC(input_buffer, 1, sizeof(TaskInputBitstream));
     *object_dbl_ptr = (void_ptr)input_buffer;
+    SVT_MALLOC(input_buffer->slice_offsets, (dec_api_prv->slices_num_reserved + 1) * sizeof(uint32_t));
 
     return SvtJxsErrorNone;
 }
 
+void input_bitstream_memory(SvtMemSize_t* mem, uint32_t slices_num_reserved) {
+    svt_jxs_mem_size_add(mem, sizeof(TaskInputBitstream) + (slices_num_reserved + 1) * sizeof(uint32_t), SVT_JXS_MEM_GENERAL);
+}
+
 void input_bitstream_destroyer(void_ptr p) {
     TaskInputBitstream* obj = (TaskInputBitstream*)p;
+    SVT_FREE(obj->slice_offsets);
     SVT_FREE(obj);
 }
 
@@ -130,6 +136,48 @@ static int32_t get_slice_size(pi_t* pi, const uint8_t* bitstream_buf, size_t bit
     return SvtJxsErrorDecoderInvalidBitstream;
 }
 
+/*Find slice header with index from range [slice_min, slice_num) to resume decoding after invalid or lost data.
+ * Accept only header followed by valid precincts, so data of precincts similar to header is skipped.*/
+static SvtJxsErrorType_t find_next_slice_header(pi_t* pi, const uint8_t* bitstream_buf, size_t bitstream_buf_size,
+                                                uint32_t slice_min, uint32_t* out_offset, uint32_t* out_slice) {
+    for (size_t offset = 0; offset + 6 <= bitstream_buf_size; offset++) {
+        const uint8_t* buf = bitstream_buf + offset;
+        if (buf[0] != 0xFF || get_16_bits(buf) != CODESTREAM_SLH || get_16_bits(buf + 2) != 4) {
+            continue;
+        }
+        uint32_t slice = get_16_bits(buf + 4);
+        uint32_t slice_size = 0;
+        if (slice < slice_min || slice >= pi->slice_num ||
+            get_slice_size(pi, buf, bitstream_buf_size - offset, slice, &slice_size) == SvtJxsErrorDecoderInvalidBitstream) {
+            continue;
+        }
+        *out_offset = (uint32_t)offset;
+        *out_slice = slice;
+        return SvtJxsErrorNone;
+    }
+    return SvtJxsErrorDecoderBitstreamTooShort;
+}
+
+static SvtJxsErrorType_t send_slice_missing_task(svt_jpeg_xs_decoder_api_prv_t* dec_api_prv,
+                                                 ObjectWrapper_t* wrapper_ptr_decoder_ctx, svt_jpeg_xs_image_buffer_t* image_buffer,
+                                                 uint32_t slice) {
+    ObjectWrapper_t* universal_wrapper_ptr = NULL;
+    SvtJxsErrorType_t err = svt_jxs_get_empty_object(dec_api_prv->universal_producer_fifo_ptr, &universal_wrapper_ptr);
+    if (err != SvtJxsErrorNone || universal_wrapper_ptr == NULL) {
+        return err ? err : SvtJxsErrorUndefined;
+    }
+    TaskCalculateFrame* buffer_output = (TaskCalculateFrame*)universal_wrapper_ptr->object_ptr;
+    buffer_output->wrapper_ptr_decoder_ctx = wrapper_ptr_decoder_ctx;
+    buffer_output->image_buffer = *image_buffer;
+    buffer_output->bitstream_buf = NULL;
+    buffer_output->bitstream_buf_size = 0;
+    buffer_output->slice_id = slice;
+    buffer_output->frame_error = SvtJxsErrorNone;
+    buffer_output->slice_missing = 1;
+    svt_jxs_post_full_object(universal_wrapper_ptr);
+    return SvtJxsErrorNone;
+}
+
 static void send_slices_tasks(svt_jpeg_xs_decoder_api_prv_t* dec_api_prv, TaskInputBitstream* input_buffer_ptr,
                               ObjectWrapper_t* wrapper_ptr_decoder_ctx, svt_jpeg_xs_image_buffer_t* image_buffer,
                               uint32_t header_size) {
@@ -137,15 +185,56 @@ static void send_slices_tasks(svt_jpeg_xs_decoder_api_prv_t* dec_api_prv, TaskIn
     svt_jpeg_xs_decoder_instance_t* dec_ctx = wrapper_ptr_decoder_ctx->object_ptr;
     pi_t* pi = &dec_ctx->dec_common->pi;
 
-    SVT_ATOMIC_STORE32(&dec_ctx->sync_num_slices_to_receive, pi->slice_num);
+    /*Region of interest: slices out of range are only located in bitstream, not decoded*/
+    uint32_t slice_first;
+    uint32_t slice_end;
+    svt_jpeg_xs_dec_get_roi_slices(dec_ctx->dec_common, &slice_first, &slice_end);
+    const uint8_t slices_roi = (slice_first != 0) || (slice_end != pi->slice_num);
+
+    dec_ctx->sync_slice_first = slice_first;
+    SVT_ATOMIC_STORE32(&dec_ctx->sync_num_slices_to_receive, slice_end - slice_first);
     dec_ctx->sync_slices_idwt = (pi->decom_v != 0) && (dec_api_prv->universal_threads_num > 1) && (pi->precincts_per_slice > 2) &&
-        (dec_ctx->dec_common->picture_header_const.hdr_Cpih == 0);
+        (dec_ctx->dec_common->picture_header_const.hdr_Cpih == 0) && !slices_roi && !dec_api_prv->slice_concealment;
 
     for (uint32_t slice_idx = 0; slice_idx < pi->slice_num; slice_idx++) {
         svt_jxs_set_cond_var(&dec_ctx->map_slices_decode_done[slice_idx], SYNC_INIT);
     }
+    svt_jpeg_xs_decode_slice_overlap_deps_init(dec_ctx, slice_first, slice_end);
+
+    for (uint32_t slice = 0; slice < slice_end; slice++) {
+        const uint8_t* slice_buf = input_buffer_ptr->dec_input.bitstream.buffer + offset;
+        size_t slice_buf_size = input_buffer_ptr->dec_input.bitstream.used_size - offset;
+        uint32_t frame_bitstream_size = header_size;
+
+        uint32_t out_slice_size;
+        int32_t ret = SvtJxsErrorNone;
+        if (input_buffer_ptr->slice_offsets_set && input_buffer_ptr->slice_offsets[0] == header_size) {
+            /*Slices already found by frame scanner*/
+            out_slice_size = input_buffer_ptr->slice_offsets[slice + 1] - input_buffer_ptr->slice_offsets[slice];
+        }
+        else {
+            ret = get_slice_size(&dec_ctx->dec_common->pi, slice_buf, slice_buf_size, slice, &out_slice_size);
+        }
+        if (ret && dec_api_prv->slice_concealment) {
+            /*Skip to next valid slice header, all slices before are concealed*/
+            uint32_t next_offset = 0;
+            uint32_t next_slice = pi->slice_num;
+            if (find_next_slice_header(pi, slice_buf, slice_buf_size, slice + 1, &next_offset, &next_slice) == SvtJxsErrorNone) {
+                offset += next_offset;
+            }
+            for (uint32_t slice_missing = MAX(slice, slice_first); slice_missing < MIN(next_slice, slice_end); slice_missing++) {
+                if (send_slice_missing_task(dec_api_prv, wrapper_ptr_decoder_ctx, image_buffer, slice_missing)) {
+                    return;
+                }
+            }
+            slice = next_slice - 1;
+            continue;
+        }
+        if (!ret && slice < slice_first) {
+            offset += out_slice_size;
+            continue;
+        }
 
-    for (uint32_t slice = 0; slice < pi->slice_num; slice++) {
         /*Get Wrapper output*/
         ObjectWrapper_t* universal_wrapper_ptr = NULL;
         SvtJxsErrorType_t err = svt_jxs_get_empty_object(dec_api_prv->universal_producer_fifo_ptr, &universal_wrapper_ptr);
@@ -155,14 +244,11 @@ static void send_slices_tasks(svt_jpeg_xs_decoder_api_prv_t* dec_api_prv, TaskIn
         TaskCalculateFrame* buffer_output = (TaskCalculateFrame*)universal_wrapper_ptr->object_ptr;
         buffer_output->wrapper_ptr_decoder_ctx = wrapper_ptr_decoder_ctx;
         buffer_output->image_buffer = *image_buffer;
-        buffer_output->bitstream_buf = input_buffer_ptr->dec_input.bitstream.buffer + offset;
-        buffer_output->bitstream_buf_size = input_buffer_ptr->dec_input.bitstream.used_size - offset;
+        buffer_output->bitstream_buf = slice_buf;
+        buffer_output->bitstream_buf_size = slice_buf_size;
         buffer_output->slice_id = slice;
-        uint32_t frame_bitstream_size = header_size;
+        buffer_output->slice_missing = 0;
 
-        uint32_t out_slice_size;
-        int32_t ret = get_slice_size(
-            &dec_ctx->dec_common->pi, buffer_output->bitstream_buf, buffer_output->bitstream_buf_size, slice, &out_slice_size);
         if (!ret) {
             offset += out_slice_size;
             if (slice + 1 == pi->slice_num) {
@@ -175,7 +261,11 @@ static void send_slices_tasks(svt_jpeg_xs_decoder_api_prv_t* dec_api_prv, TaskIn
                 else {
                     ret = SvtJxsErrorDecoderBitstreamTooShort;
                 }
-                if (!ret) {
+                if (ret && dec_api_prv->slice_concealment) {
+                    /*All slices are found, only end of frame is invalid*/
+                    ret = SvtJxsErrorNone;
+                }
+                else if (!ret) {
                     frame_bitstream_size = offset + 2;
 
                     if (dec_ctx->picture_header_dynamic.hdr_Lcod != 0 &&
@@ -195,7 +285,7 @@ static void send_slices_tasks(svt_jpeg_xs_decoder_api_prv_t* dec_api_prv, TaskIn
         buffer_output->frame_error = ret;
         if (ret) {
             // Atomic: final thread reads this concurrently while processing earlier slices
-            SVT_ATOMIC_STORE32(&dec_ctx->sync_num_slices_to_receive, slice + 1);
+            SVT_ATOMIC_STORE32(&dec_ctx->sync_num_slices_to_receive, slice < slice_first ? 1 : slice + 1 - slice_first);
         }
         svt_jxs_post_full_object(universal_wrapper_ptr);
         if (ret) {
@@ -287,6 +377,13 @@ void* thread_init_stage_kernel(void* input_ptr) {
         dec_ctx->dec_input = input_buffer_ptr->dec_input;
         dec_ctx->dec_input.bitstream.ready_to_release = 0;
         dec_ctx->dec_input.image.ready_to_release = 0;
+        if (dec_api_prv->stats_enable) {
+            memset(&dec_ctx->stats, 0, sizeof(dec_ctx->stats));
+            dec_ctx->stats.frame_num = dec_ctx->frame_num;
+            dec_ctx->stats.input_queue_depth = svt_jxs_system_resource_get_full_objects_num(
+                dec_api_prv->input_buffer_resource_ptr);
+            dec_ctx->stats_time_send_us = input_buffer_ptr->time_send_us;
+        }
 
         svt_jxs_wait_cond_var(sync_output_ringbuffer_left, 0); //Wait until will be free place in ring buffer
         svt_jxs_add_cond_var(sync_output_ringbuffer_left, -1); //Decrement number of elements to use.
@@ -297,11 +394,15 @@ void* thread_init_stage_kernel(void* input_ptr) {
             ret = SvtJxsDecoderEndOfCodestream;
         }
         else {
+            uint64_t stats_time_begin_us = dec_api_prv->stats_enable ? svt_jxs_get_time_us() : 0;
             ret = svt_jpeg_xs_decode_header(dec_ctx,
                                             input_buffer_ptr->dec_input.bitstream.buffer,
                                             input_buffer_ptr->dec_input.bitstream.used_size,
                                             &header_size,
                                             dec_api_prv->verbose);
+            if (stats_time_begin_us) {
+                dec_ctx->stats.stage_time_us[SVT_JXS_STAGE_INIT] = svt_jxs_get_time_us() - stats_time_begin_us;
+            }
         }
         if (ret) {
             /*Error path when invalid parse header, send error to slice Thread to forward error information to final Thread.*/
@@ -327,6 +428,8 @@ void* thread_init_stage_kernel(void* input_ptr) {
             /*Use wrapper output only to propagate error to Thread Final*/
             buffer_output->frame_error = ret;
             buffer_output->slice_id = 0;
+            buffer_output->slice_missing = 0;
+            dec_ctx->sync_slice_first = 0;
             SVT_ATOMIC_STORE32(&dec_ctx->sync_num_slices_to_receive, 1);
             svt_jxs_post_full_object(universal_wrapper_ptr);
         }
@@ -367,11 +470,18 @@ SvtJxsErrorType_t internal_svt_jpeg_xs_decoder_send_packet(svt_jpeg_xs_decoder_a
 
         memset(&dec_ctx->dec_input.bitstream, 0, sizeof(svt_jpeg_xs_bitstream_buffer_t));
         dec_ctx->dec_input.user_prv_ctx_ptr = dec_input->user_prv_ctx_ptr;
+        if (dec_api_prv->stats_enable) {
+            /*No input queue in packetization mode, frame is send with first packet*/
+            memset(&dec_ctx->stats, 0, sizeof(dec_ctx->stats));
+            dec_ctx->stats.frame_num = dec_ctx->frame_num;
+            dec_ctx->stats_time_send_us = svt_jxs_get_time_us();
+        }
 
         //Protect to overflow integer (frame_num) will not break output sync buffer.
         slice_scheduler_ctx->sync_output_frame_idx = (slice_scheduler_ctx->sync_output_frame_idx + 1) %
             dec_api_prv->sync_output_ringbuffer_size;
         slice_scheduler_ctx->frame_num++;
+        SVT_ATOMIC_ADD32(&dec_api_prv->frames_sent, 1);
         slice_scheduler_ctx->slices_sent = 0;
         slice_scheduler_ctx->header_size = 0;
         slice_scheduler_ctx->bytes_filled = 0;
@@ -385,9 +495,12 @@ SvtJxsErrorType_t internal_svt_jpeg_xs_decoder_send_packet(svt_jpeg_xs_decoder_a
             svt_jxs_set_cond_var(&dec_ctx->map_slices_decode_done[slice_idx], SYNC_INIT);
         }
 
+        dec_ctx->sync_slice_first = 0;
         SVT_ATOMIC_STORE32(&dec_ctx->sync_num_slices_to_receive, dec_ctx->dec_common->pi.slice_num);
         dec_ctx->sync_slices_idwt = (dec_ctx->dec_common->pi.decom_v != 0) && (dec_api_prv->universal_threads_num > 1) &&
-            (dec_ctx->dec_common->pi.precincts_per_slice > 2) && (dec_ctx->dec_common->picture_header_const.hdr_Cpih == 0);
+            (dec_ctx->dec_common->pi.precincts_per_slice > 2) && (dec_ctx->dec_common->picture_header_const.hdr_Cpih == 0) &&
+            !dec_api_prv->slice_concealment;
+        svt_jpeg_xs_decode_slice_overlap_deps_init(dec_ctx, 0, dec_ctx->dec_common->pi.slice_num);
     }
 
     svt_jpeg_xs_decoder_instance_t* dec_ctx = wrapper_ptr_decoder_ctx->object_ptr;
@@ -407,12 +520,16 @@ SvtJxsErrorType_t internal_svt_jpeg_xs_decoder_send_packet(svt_jpeg_xs_decoder_a
 
     //Process bitstream Header
     if (slice_scheduler_ctx->header_size == 0) {
+        uint64_t stats_time_begin_us = dec_api_prv->stats_enable ? svt_jxs_get_time_us() : 0;
         ret = svt_jpeg_xs_decode_header(dec_ctx,
                                         dec_ctx->frame_bitstream_ptr,
                                         slice_scheduler_ctx->bytes_filled,
                                         &slice_scheduler_ctx->header_size,
                                         dec_api_prv->verbose);
         slice_scheduler_ctx->bytes_processed += slice_scheduler_ctx->header_size;
+        if (stats_time_begin_us) {
+            dec_ctx->stats.stage_time_us[SVT_JXS_STAGE_INIT] += svt_jxs_get_time_us() - stats_time_begin_us;
+        }
     }
 
     //Process and schedule bitstream into slice-threads
@@ -425,6 +542,38 @@ SvtJxsErrorType_t internal_svt_jpeg_xs_decoder_send_packet(svt_jpeg_xs_decoder_a
                                  slice_scheduler_ctx->slices_sent,
                                  &slice_size);
         }
+        const uint8_t frame_filled = slice_scheduler_ctx->bytes_filled == dec_ctx->dec_common->max_frame_bitstream_size;
+        if (ret && dec_api_prv->slice_concealment && slice_scheduler_ctx->header_size &&
+            (ret == SvtJxsErrorDecoderInvalidBitstream || frame_filled)) {
+            /*Skip to next valid slice header, or to end of frame when whole frame is received*/
+            pi_t* pi = &dec_ctx->dec_common->pi;
+            uint32_t next_offset = 0;
+            uint32_t next_slice = pi->slice_num;
+            ret = find_next_slice_header(pi,
+                                         dec_ctx->frame_bitstream_ptr + slice_scheduler_ctx->bytes_processed,
+                                         slice_scheduler_ctx->bytes_filled - slice_scheduler_ctx->bytes_processed,
+                                         slice_scheduler_ctx->slices_sent + 1,
+                                         &next_offset,
+                                         &next_slice);
+            if (ret && !frame_filled) {
+                //Next slice header not received yet
+                return SvtJxsErrorDecoderBitstreamTooShort;
+            }
+            ret = SvtJxsErrorNone;
+            slice_scheduler_ctx->bytes_processed += next_offset;
+            for (; slice_scheduler_ctx->slices_sent < next_slice; slice_scheduler_ctx->slices_sent++) {
+                ret = send_slice_missing_task(
+                    dec_api_prv, wrapper_ptr_decoder_ctx, &dec_ctx->dec_input.image, slice_scheduler_ctx->slices_sent);
+                if (ret) {
+                    return ret;
+                }
+            }
+            if (slice_scheduler_ctx->slices_sent == pi->slice_num) {
+                slice_scheduler_ctx->wrapper_ptr_decoder_ctx = NULL;
+                break;
+            }
+            continue;
+        }
         if (ret == SvtJxsErrorDecoderBitstreamTooShort) {
             //Not enough data to process slice,
             return SvtJxsErrorDecoderBitstreamTooShort;
@@ -443,6 +592,7 @@ SvtJxsErrorType_t internal_svt_jpeg_xs_decoder_send_packet(svt_jpeg_xs_decoder_a
         buffer_output->bitstream_buf_size = slice_size;
         buffer_output->slice_id = slice_scheduler_ctx->slices_sent;
         buffer_output->frame_error = ret;
+        buffer_output->slice_missing = 0;
 
         if (ret) {
             // Atomic: final thread reads this concurrently while processing earlier slices
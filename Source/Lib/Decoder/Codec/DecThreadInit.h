@@ -13,6 +13,9 @@
 typedef struct {
     svt_jpeg_xs_frame_t dec_input;
     SvtJxsErrorType_t flags;
+    uint64_t time_send_us; /*Set only when stats_enable*/
+    uint32_t* slice_offsets;   /*Offsets of slices and EOC from svt_jpeg_xs_decoder_send_frame_with_index(), slice_num + 1 entries*/
+    uint8_t slice_offsets_set; /*0 when index is not passed or not match frame*/
 } TaskInputBitstream;
 
 void* thread_init_stage_kernel(void* input_ptr);
@@ -20,6 +23,7 @@ void* thread_init_stage_kernel(void* input_ptr);
 /*Allocate queues and contexts for multithreading*/
 SvtJxsErrorType_t input_bitstream_creator(void_ptr* object_dbl_ptr, void_ptr object_init_data_ptr);
 void input_bitstream_destroyer(void_ptr p);
+void input_bitstream_memory(SvtMemSize_t* mem, uint32_t slices_num_reserved);
 
 SvtJxsErrorType_t internal_svt_jpeg_xs_decoder_send_packet(svt_jpeg_xs_decoder_api_prv_t* dec_api_prv,
                                                            svt_jpeg_xs_frame_t* dec_input, uint32_t* bytes_used);
@@ -6,6 +6,7 @@
 #include "DecThreads.h"
 #include "DecThreadSlice.h"
 #include "DecThreadFinal.h"
+#include "SvtUtility.h"
 
 /*Create input buffer item.*/
 SvtJxsErrorType_t universal_frame_task_creator(void_ptr* object_dbl_ptr, void_ptr object_init_data_ptr) {
@@ -55,6 +56,11 @@ SvtJxsErrorType_t universal_thread_context_ctor(ThreadContext_t* thread_context_
     return SvtJxsErrorNone;
 }
 
+void universal_thread_context_memory(SvtMemSize_t* mem, const pi_t* pi, const pi_t* pi_ceiling) {
+    svt_jxs_mem_size_add(mem, sizeof(UniversalThreadContext), SVT_JXS_MEM_GENERAL);
+    svt_jpeg_xs_dec_thread_context_memory(mem, pi, pi_ceiling);
+}
+
 void* thread_universal_stage_kernel(void* input_ptr) {
     ThreadContext_t* thread_ctx = (ThreadContext_t*)input_ptr;
     UniversalThreadContext* universal_ctx = (UniversalThreadContext*)thread_ctx->priv;
@@ -81,8 +87,15 @@ void* thread_universal_stage_kernel(void* input_ptr) {
         }
 
         SvtJxsErrorType_t ret_decode = SvtJxsErrorNone;
+        uint64_t stats_time_begin_us = dec_api_prv->stats_enable ? svt_jxs_get_time_us() : 0;
+        uint8_t slice_concealed = 0;
         /*Check that other slice or header did not have error while decoding.*/
-        if (input_buffer_ptr->frame_error == 0) {
+        if (input_buffer_ptr->frame_error == 0 && input_buffer_ptr->slice_missing) {
+            /*Slice not found in bitstream, zero coefficients are used in IDWT of neighbour slices*/
+            svt_jpeg_xs_decode_slice_clear(dec_ctx, input_buffer_ptr->slice_id);
+            slice_concealed = 1;
+        }
+        else if (input_buffer_ptr->frame_error == 0) {
             uint32_t out_slice_size;
             ret_decode = svt_jpeg_xs_decode_slice(dec_ctx,
                                                   dec_thread_context,
@@ -92,10 +105,23 @@ void* thread_universal_stage_kernel(void* input_ptr) {
                                                   &out_slice_size,
                                                   &input_buffer_ptr->image_buffer,
                                                   dec_api_prv->verbose);
-            if (ret_decode < 0) {
+            if (ret_decode < 0 && dec_api_prv->slice_concealment) {
+                svt_jpeg_xs_decode_slice_clear(dec_ctx, input_buffer_ptr->slice_id);
+                slice_concealed = 1;
+            }
+            else if (ret_decode < 0) {
                 input_buffer_ptr->frame_error = ret_decode;
             }
         }
+        if (input_buffer_ptr->frame_error == 0) {
+            /*IDWT between slices, calculated by thread that finish last slice required by overlap*/
+            SvtJxsErrorType_t ret_overlap = svt_jpeg_xs_decode_slice_overlap_ready(
+                dec_ctx, dec_thread_context, &input_buffer_ptr->image_buffer, input_buffer_ptr->slice_id);
+            if (ret_overlap) {
+                input_buffer_ptr->frame_error = ret_overlap;
+            }
+        }
+        uint64_t slice_time_us = stats_time_begin_us ? svt_jxs_get_time_us() - stats_time_begin_us : 0;
 
         if (dec_api_prv->verbose >= VERBOSE_WARNINGS) {
             if (ret_decode >= 0 && ret_decode != (int)input_buffer_ptr->bitstream_buf_size) {
@@ -131,6 +157,8 @@ void* thread_universal_stage_kernel(void* input_ptr) {
         buffer_output->wrapper_ptr_decoder_ctx = input_buffer_ptr->wrapper_ptr_decoder_ctx;
         buffer_output->slice_id = input_buffer_ptr->slice_id;
         buffer_output->frame_error = input_buffer_ptr->frame_error;
+        buffer_output->slice_concealed = slice_concealed;
+        buffer_output->slice_time_us = slice_time_us;
 
         if (dec_api_prv->verbose >= VERBOSE_INFO_MULTITHREADING) {
             fprintf(stderr,
@@ -18,6 +18,7 @@ typedef struct {
     svt_jpeg_xs_image_buffer_t image_buffer;
     uint32_t slice_id;
     SvtJxsErrorType_t frame_error;
+    uint8_t slice_missing; /*Slice not found in bitstream, conceal without decode*/
 } TaskCalculateFrame;
 
 typedef struct UniversalThreadContext {
@@ -36,5 +37,7 @@ SvtJxsErrorType_t universal_frame_task_creator(void_ptr* object_dbl_ptr, void_pt
 void universal_frame_task_creator_destroy(void_ptr p);
 SvtJxsErrorType_t universal_thread_context_ctor(ThreadContext_t* thread_context_ptr, svt_jpeg_xs_decoder_api_prv_t* dec_api_prv,
                                                 int idx);
+/*Memory of context created by universal_thread_context_ctor(), pi_ceiling is set when context is allocated for ceiling*/
+void universal_thread_context_memory(SvtMemSize_t* mem, const pi_t* pi, const pi_t* pi_ceiling);
 
 #endif /*_DECODER_THREAD_SLICE_H_*/
@@ -7,18 +7,29 @@
 #include "DecHandle.h"
 
 SvtJxsErrorType_t output_frame_creator(void_ptr* object_dbl_ptr, void_ptr object_init_data_ptr) {
-    UNUSED(object_init_data_ptr);
+    svt_jpeg_xs_decoder_api_prv_t* dec_api_prv = (svt_jpeg_xs_decoder_api_prv_t*)object_init_data_ptr;
     TaskOutFrame* input_buffer;
 
     *object_dbl_ptr = NULL;
     SVT_CALLOC(input_buffer, 1, sizeof(TaskOutFrame));
     *object_dbl_ptr = (void_ptr)input_buffer;
+    if (dec_api_prv->slice_concealment) {
+        SVT_CALLOC(input_buffer->concealed_slices, dec_api_prv->concealed_bitmap_size, sizeof(uint8_t));
+    }
 
     return SvtJxsErrorNone;
 }
 
+void output_frame_memory(SvtMemSize_t* mem, uint8_t slice_concealment, uint32_t concealed_bitmap_size) {
+    svt_jxs_mem_size_add(mem, sizeof(TaskOutFrame), SVT_JXS_MEM_GENERAL);
+    if (slice_concealment) {
+        svt_jxs_mem_size_add(mem, concealed_bitmap_size * sizeof(uint8_t), SVT_JXS_MEM_GENERAL);
+    }
+}
+
 void output_frame_destroyer(void_ptr p) {
     TaskOutFrame* obj = (TaskOutFrame*)p;
+    SVT_FREE(obj->concealed_slices);
     SVT_FREE(obj);
 }
 
@@ -14,6 +14,8 @@ typedef struct {
     uint64_t frame_num;
     SvtJxsErrorType_t frame_error;
     void* user_prv_ctx;
+    uint8_t* concealed_slices; /*Bitmap of concealed slices, set only when slice_concealment*/
+    uint32_t concealed_num;
 } TaskOutFrame;
 
 typedef struct ThreadContext {
@@ -24,6 +26,7 @@ typedef struct ThreadContext {
 /*Allocate queues and contexts for multithreading*/
 SvtJxsErrorType_t output_frame_creator(void_ptr* object_dbl_ptr, void_ptr object_init_data_ptr);
 void output_frame_destroyer(void_ptr p);
+void output_frame_memory(SvtMemSize_t* mem, uint8_t slice_concealment, uint32_t concealed_bitmap_size);
 SvtJxsErrorType_t pool_decoder_instance_create_ctor(void_ptr* object_dbl_ptr, void_ptr object_init_data_ptr);
 void pool_decoder_instance_destroy_ctor(void_ptr p);
 
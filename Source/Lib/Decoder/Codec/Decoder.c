@@ -78,9 +78,9 @@ ColourFormat_t svt_jpeg_xs_get_format_from_params(uint32_t comps_num, uint32_t s
     return format;
 }
 
-SvtJxsErrorType_t svt_jpeg_xs_dec_init_common(svt_jpeg_xs_decoder_common_t* dec_common,
-                                              svt_jpeg_xs_image_config_t* out_image_config, proxy_mode_t proxy_mode,
-                                              uint32_t verbose) {
+SvtJxsErrorType_t svt_jpeg_xs_dec_configure_common(svt_jpeg_xs_decoder_common_t* dec_common,
+                                                   svt_jpeg_xs_image_config_t* out_image_config, proxy_mode_t proxy_mode,
+                                                   uint32_t verbose) {
     SvtJxsErrorType_t ret = pi_compute(
         &dec_common->pi, //TODO: Update if required
         0 /*Init decoder*/,
@@ -112,14 +112,25 @@ SvtJxsErrorType_t svt_jpeg_xs_dec_init_common(svt_jpeg_xs_decoder_common_t* dec_
         return ret;
     }
 
-    if (dec_common->picture_header_const.hdr_Cpih) {
-        for (uint32_t c = 0; c < dec_common->pi.comps_num; c++) {
-            SVT_MALLOC(dec_common->buffer_tmp_cpih[c], dec_common->pi.width * dec_common->pi.height * sizeof(int32_t));
+    /*Decode whole picture until region of interest is set*/
+    dec_common->roi_slice_begin = 0;
+    dec_common->roi_slice_end = dec_common->pi.slice_num;
+    memset(dec_common->components_skip, 0, sizeof(dec_common->components_skip));
+    memset(dec_common->bands_skip, 0, sizeof(dec_common->bands_skip));
+    dec_common->bands_skip_enable = 0;
+
+    /*Bands discarded by proxy mode in packets that are unpacked*/
+    pi_t* pi = &dec_common->pi;
+    for (uint32_t packet_idx = 0; packet_idx < pi->packets_num; packet_idx++) {
+        for (uint32_t band_idx = pi->packets[packet_idx].band_start; band_idx < pi->packets[packet_idx].band_stop; band_idx++) {
+            if (pi_is_band_discarded(pi, band_idx)) {
+                dec_common->bands_skip[band_idx] = 1;
+                dec_common->bands_skip_enable = 1;
+            }
         }
     }
 
     if (out_image_config) {
-        pi_t* pi = &dec_common->pi;
         out_image_config->width = pi->width;
         out_image_config->height = pi->height;
         out_image_config->components_num = pi->comps_num;
@@ -142,55 +153,178 @@ SvtJxsErrorType_t svt_jpeg_xs_dec_init_common(svt_jpeg_xs_decoder_common_t* dec_
     return SvtJxsErrorNone;
 }
 
-svt_jpeg_xs_decoder_instance_t* svt_jpeg_xs_dec_instance_alloc(svt_jpeg_xs_decoder_common_t* dec_common) {
-    svt_jpeg_xs_decoder_instance_t* ctx;
+/*Size of temporary buffer of every component for inverse Multiple Component Transformation*/
+static size_t dec_common_cpih_buffer_size(const svt_jpeg_xs_decoder_common_t* dec_common) {
+    return dec_common->pi.width * dec_common->pi.height * sizeof(int32_t);
+}
 
-    SVT_NO_THROW_CALLOC(ctx, 1, sizeof(svt_jpeg_xs_decoder_instance_t));
-    if (!ctx) {
-        return NULL;
+SvtJxsErrorType_t svt_jpeg_xs_dec_alloc_common(svt_jpeg_xs_decoder_common_t* dec_common) {
+    if (dec_common->picture_header_const.hdr_Cpih) {
+        /*Buffers are kept on reconfiguration and allocated again only when bigger are required*/
+        size_t buffer_tmp_cpih_size = dec_common_cpih_buffer_size(dec_common);
+        if (buffer_tmp_cpih_size > dec_common->buffer_tmp_cpih_size) {
+            for (uint32_t c = 0; c < MAX_COMPONENTS_NUM; c++) {
+                SVT_FREE(dec_common->buffer_tmp_cpih[c]);
+            }
+            dec_common->buffer_tmp_cpih_size = buffer_tmp_cpih_size;
+        }
+        for (uint32_t c = 0; c < dec_common->pi.comps_num; c++) {
+            if (dec_common->buffer_tmp_cpih[c] == NULL) {
+                SVT_MALLOC_PURPOSE(dec_common->buffer_tmp_cpih[c], dec_common->buffer_tmp_cpih_size, SVT_JXS_MEM_SCRATCH);
+            }
+        }
     }
+    return SvtJxsErrorNone;
+}
 
-    ctx->dec_common = dec_common;
+SvtJxsErrorType_t svt_jpeg_xs_dec_init_common(svt_jpeg_xs_decoder_common_t* dec_common,
+                                              svt_jpeg_xs_image_config_t* out_image_config, proxy_mode_t proxy_mode,
+                                              uint32_t verbose) {
+    SvtJxsErrorType_t ret = svt_jpeg_xs_dec_configure_common(dec_common, out_image_config, proxy_mode, verbose);
+    if (ret) {
+        return ret;
+    }
+    return svt_jpeg_xs_dec_alloc_common(dec_common);
+}
+
+void svt_jpeg_xs_dec_common_memory(SvtMemSize_t* mem, const svt_jpeg_xs_decoder_common_t* dec_common) {
+    if (dec_common->picture_header_const.hdr_Cpih) {
+        svt_jxs_mem_size_add(mem, dec_common->pi.comps_num * dec_common_cpih_buffer_size(dec_common), SVT_JXS_MEM_SCRATCH);
+    }
+}
+
+SvtJxsErrorType_t svt_jpeg_xs_dec_init_roi(svt_jpeg_xs_decoder_common_t* dec_common, uint32_t slice_begin, uint32_t slice_end,
+                                           uint8_t components_mask, uint32_t verbose) {
     pi_t* pi = &dec_common->pi;
-    int ret = 0;
+    if (slice_end == 0) {
+        slice_end = pi->slice_num;
+    }
+    if (slice_begin >= slice_end || slice_end > pi->slice_num) {
+        if (verbose >= VERBOSE_ERRORS) {
+            fprintf(stderr,
+                    "Invalid slice range of interest [%u, %u), slices in picture: %u\n",
+                    slice_begin,
+                    slice_end,
+                    pi->slice_num);
+        }
+        return SvtJxsErrorBadParameter;
+    }
+    if (components_mask && (components_mask >> pi->comps_num)) {
+        if (verbose >= VERBOSE_ERRORS) {
+            fprintf(
+                stderr, "Invalid components mask of interest 0x%x, components in picture: %u\n", components_mask, pi->comps_num);
+        }
+        return SvtJxsErrorBadParameter;
+    }
+    if (components_mask && dec_common->picture_header_const.hdr_Cpih) {
+        if (verbose >= VERBOSE_ERRORS) {
+            fprintf(stderr, "Components mask of interest not supported with Multiple Component Transformation\n");
+        }
+        return SvtJxsErrorBadParameter;
+    }
 
-    ctx->precincts_line_coeff_size = 0;
-    for (uint32_t c = 0; c < pi->comps_num; c++) {
-        ctx->precincts_line_coeff_comp_offset[c] = ctx->precincts_line_coeff_size;
-        for (uint32_t b = 0; b < pi->components[c].bands_num; b++) {
-            ctx->precincts_line_coeff_size += pi->components[c].bands[b].width * pi->components[c].bands[b].height_lines_num;
+    dec_common->roi_slice_begin = slice_begin;
+    dec_common->roi_slice_end = slice_end;
+    if (components_mask) {
+        for (uint32_t c = 0; c < pi->comps_num; c++) {
+            dec_common->components_skip[c] = !(components_mask & (1 << c));
+        }
+        for (uint32_t band_idx = 0; band_idx < pi->bands_num_all; band_idx++) {
+            if (pi->global_band_info[band_idx].band_id != BAND_NOT_EXIST &&
+                dec_common->components_skip[pi->global_band_info[band_idx].comp_id]) {
+                dec_common->bands_skip[band_idx] = 1;
+                dec_common->bands_skip_enable = 1;
+            }
         }
     }
+    return SvtJxsErrorNone;
+}
 
-    uint32_t frame_coeff_size = ctx->precincts_line_coeff_size * pi->precincts_line_num;
+/*Range of slices to decode, include neighbour slices of region of interest required by vertical IDWT:
+ * two precincts above first slice and two precincts below last slice.*/
+void svt_jpeg_xs_dec_get_roi_slices(const svt_jpeg_xs_decoder_common_t* dec_common, uint32_t* first_slice,
+                                    uint32_t* end_slice) {
+    const pi_t* pi = &dec_common->pi;
+    *first_slice = dec_common->roi_slice_begin;
+    *end_slice = dec_common->roi_slice_end;
+    if (pi->decom_v != 0) {
+        uint32_t first_precinct = *first_slice * pi->precincts_per_slice;
+        *first_slice = (first_precinct > 2 ? first_precinct - 2 : 0) / pi->precincts_per_slice;
+        *end_slice = MIN(pi->slice_num, (*end_slice * pi->precincts_per_slice + 1) / pi->precincts_per_slice + 1);
+    }
+}
 
-    // Zero-initialize: IDWT may read padding/boundary elements before they are written
-    SVT_NO_THROW_CALLOC(ctx->coeff_buff_ptr_16bit, 1, frame_coeff_size * sizeof(int16_t));
-    if (!ctx->coeff_buff_ptr_16bit) {
-        ret |= 1;
+/*Coefficients of one line of precincts of all components, with offset of every component*/
+static uint32_t dec_precincts_line_coeff_size(const pi_t* pi, uint32_t* out_comp_offset) {
+    uint32_t size = 0;
+    for (uint32_t c = 0; c < pi->comps_num; c++) {
+        if (out_comp_offset) {
+            out_comp_offset[c] = size;
+        }
+        for (uint32_t b = 0; b < pi->components[c].bands_num; b++) {
+            size += pi->components[c].bands[b].width * pi->components[c].bands[b].height_lines_num;
+        }
     }
+    return size;
+}
 
-    // Zero-initialize: IDWT temp buffers may be partially read at slice boundaries before full write
+static void dec_instance_tmp_sizes(const pi_t* pi, size_t* out_idwt_tmp_size, size_t* out_component_tmp_size) {
     if (pi->decom_v == 0) {
-        SVT_NO_THROW_CALLOC(ctx->precinct_idwt_tmp_buffer, 1, 1 * pi->width * sizeof(int32_t));
-        SVT_NO_THROW_CALLOC(ctx->precinct_component_tmp_buffer, 1, 1 * pi->width * sizeof(int32_t));
+        *out_idwt_tmp_size = 1 * pi->width;
+        *out_component_tmp_size = 1 * pi->width;
     }
     else if (pi->decom_v == 1) {
-        SVT_NO_THROW_CALLOC(ctx->precinct_idwt_tmp_buffer, 1, 3 * pi->width * sizeof(int32_t));
-        SVT_NO_THROW_CALLOC(ctx->precinct_component_tmp_buffer, 1, 4 * pi->width * sizeof(int32_t));
+        *out_idwt_tmp_size = 3 * pi->width;
+        *out_component_tmp_size = 4 * pi->width;
     }
     else { // pi->.decom_v == 2
         uint32_t V1_len = (pi->width / 2) + (pi->width & 1);
-        SVT_NO_THROW_CALLOC(ctx->precinct_idwt_tmp_buffer, 1, (7 * V1_len + 4 * pi->width) * sizeof(int32_t)); // ~7.5 * pi->width
-        SVT_NO_THROW_CALLOC(ctx->precinct_component_tmp_buffer, 1, 8 * pi->width * sizeof(int32_t));
+        *out_idwt_tmp_size = 7 * V1_len + 4 * pi->width; // ~7.5 * pi->width
+        *out_component_tmp_size = 8 * pi->width;
+    }
+}
+
+/*Arena size to get all buffers of instance in one block, with alignment padding of 6 buffers*/
+static size_t dec_instance_arena_size(const pi_t* pi, uint32_t max_frame_bitstream_size) {
+    size_t idwt_tmp_size;
+    size_t component_tmp_size;
+    dec_instance_tmp_sizes(pi, &idwt_tmp_size, &component_tmp_size);
+    size_t frame_coeff_size = (size_t)dec_precincts_line_coeff_size(pi, NULL) * pi->precincts_line_num;
+    return frame_coeff_size * sizeof(int16_t) + (idwt_tmp_size + component_tmp_size) * sizeof(int32_t) +
+        pi->slice_num * (sizeof(CondVar) + sizeof(uint32_t)) + max_frame_bitstream_size + 6 * ALVALUE;
+}
+
+/*Carve all buffers of instance from arena for current configuration of dec_common*/
+static int dec_instance_carve(svt_jpeg_xs_decoder_instance_t* ctx) {
+    svt_jpeg_xs_decoder_common_t* dec_common = ctx->dec_common;
+    pi_t* pi = &dec_common->pi;
+    int ret = 0;
+
+    ctx->precincts_line_coeff_size = dec_precincts_line_coeff_size(pi, ctx->precincts_line_coeff_comp_offset);
+    uint32_t frame_coeff_size = ctx->precincts_line_coeff_size * pi->precincts_line_num;
+
+    size_t idwt_tmp_size;
+    size_t component_tmp_size;
+    dec_instance_tmp_sizes(pi, &idwt_tmp_size, &component_tmp_size);
+
+    /*All buffers of instance share one arena block, kept when it is big enough for new configuration*/
+    svt_jxs_arena_reset(&ctx->arena, dec_instance_arena_size(pi, dec_common->max_frame_bitstream_size));
+
+    // Zero-initialize: IDWT may read padding/boundary elements before they are written
+    SVT_ARENA_CALLOC_ARRAY(&ctx->arena, ctx->coeff_buff_ptr_16bit, frame_coeff_size);
+    if (!ctx->coeff_buff_ptr_16bit) {
+        ret |= 1;
     }
 
+    // Zero-initialize: IDWT temp buffers may be partially read at slice boundaries before full write
+    SVT_ARENA_CALLOC_ARRAY(&ctx->arena, ctx->precinct_idwt_tmp_buffer, idwt_tmp_size);
+    SVT_ARENA_CALLOC_ARRAY(&ctx->arena, ctx->precinct_component_tmp_buffer, component_tmp_size);
     if (!ctx->precinct_idwt_tmp_buffer || !ctx->precinct_component_tmp_buffer) {
         ret |= 1;
     }
 
     if (!ret) {
-        SVT_NO_THROW_MALLOC(ctx->map_slices_decode_done, pi->slice_num * sizeof(CondVar));
+        SVT_ARENA_CALLOC_ARRAY(&ctx->arena, ctx->map_slices_decode_done, pi->slice_num);
         if (!ctx->map_slices_decode_done) {
             ret |= 1;
         }
@@ -200,67 +334,157 @@ svt_jpeg_xs_decoder_instance_t* svt_jpeg_xs_dec_instance_alloc(svt_jpeg_xs_decod
                 if (ret) {
                     /*When any error, destroy all previous created Condition Variables*/
                     for (uint32_t i = 0; i < slice_idx; i++) {
-                        svt_jxs_free_cond_var(&ctx->map_slices_decode_done[slice_idx]);
+                        svt_jxs_free_cond_var(&ctx->map_slices_decode_done[i]);
                     }
-                    SVT_FREE(ctx->map_slices_decode_done);
+                    ctx->map_slices_decode_done = NULL;
                     break;
                 }
             }
+            if (ctx->map_slices_decode_done) {
+                ctx->map_slices_num = pi->slice_num;
+            }
+        }
+        SVT_ARENA_CALLOC_ARRAY(&ctx->arena, ctx->sync_overlap_deps, pi->slice_num);
+        if (!ctx->sync_overlap_deps) {
+            ret |= 1;
         }
     }
 
+    ctx->frame_bitstream_ptr = NULL;
     if (dec_common->max_frame_bitstream_size) {
-        SVT_NO_THROW_MALLOC(ctx->frame_bitstream_ptr, dec_common->max_frame_bitstream_size * sizeof(uint8_t));
+        SVT_ARENA_CALLOC_ARRAY(&ctx->arena, ctx->frame_bitstream_ptr, dec_common->max_frame_bitstream_size);
         if (!ctx->frame_bitstream_ptr) {
             ret |= 1;
         }
     }
+    return ret;
+}
 
-    if (ret) {
+static void dec_instance_free_cond_vars(svt_jpeg_xs_decoder_instance_t* ctx) {
+    if (ctx->map_slices_decode_done) {
+        for (uint32_t slice_idx = 0; slice_idx < ctx->map_slices_num; slice_idx++) {
+            svt_jxs_free_cond_var(&ctx->map_slices_decode_done[slice_idx]);
+        }
+        ctx->map_slices_decode_done = NULL;
+        ctx->map_slices_num = 0;
+    }
+}
+
+svt_jpeg_xs_decoder_instance_t* svt_jpeg_xs_dec_instance_alloc(svt_jpeg_xs_decoder_common_t* dec_common) {
+    svt_jpeg_xs_decoder_instance_t* ctx;
+
+    SVT_NO_THROW_CALLOC(ctx, 1, sizeof(svt_jpeg_xs_decoder_instance_t));
+    if (!ctx) {
+        return NULL;
+    }
+
+    ctx->dec_common = dec_common;
+    svt_jxs_arena_ctor(&ctx->arena, 0, SVT_JXS_MEM_COEFFICIENTS);
+    if (dec_instance_carve(ctx)) {
         svt_jpeg_xs_dec_instance_free(ctx);
         return NULL;
     }
 
+    svt_jxs_arena_print_usage(&ctx->arena, "Decoder instance");
     return ctx;
 }
 
+SvtJxsErrorType_t svt_jpeg_xs_dec_instance_reset(svt_jpeg_xs_decoder_instance_t* ctx, svt_jpeg_xs_decoder_common_t* dec_common) {
+    dec_instance_free_cond_vars(ctx);
+    ctx->dec_common = dec_common;
+    if (dec_instance_carve(ctx)) {
+        return SvtJxsErrorInsufficientResources;
+    }
+    svt_jxs_arena_print_usage(&ctx->arena, "Decoder instance");
+    return SvtJxsErrorNone;
+}
+
 void svt_jpeg_xs_dec_instance_free(svt_jpeg_xs_decoder_instance_t* ctx) {
     if (!ctx) {
         return;
     }
-    SVT_FREE(ctx->coeff_buff_ptr_16bit);
-    SVT_FREE(ctx->precinct_idwt_tmp_buffer);
-    SVT_FREE(ctx->precinct_component_tmp_buffer);
 
-    if (ctx->map_slices_decode_done) {
-        for (uint32_t slice_idx = 0; slice_idx < ctx->dec_common->pi.slice_num; slice_idx++) {
-            svt_jxs_free_cond_var(&ctx->map_slices_decode_done[slice_idx]);
-        }
-    }
-    SVT_FREE(ctx->map_slices_decode_done);
-    SVT_FREE(ctx->frame_bitstream_ptr);
+    dec_instance_free_cond_vars(ctx);
+    svt_jxs_arena_dctor(&ctx->arena);
     SVT_FREE(ctx);
 }
 
-svt_jpeg_xs_decoder_thread_context* svt_jpeg_xs_dec_thread_context_alloc(pi_t* pi) {
-    svt_jpeg_xs_decoder_thread_context* ctx;
+void svt_jpeg_xs_dec_instance_memory(SvtMemSize_t* mem, const svt_jpeg_xs_decoder_common_t* dec_common, const pi_t* pi_ceiling) {
+    size_t arena_size = dec_instance_arena_size(&dec_common->pi, dec_common->max_frame_bitstream_size);
+    if (pi_ceiling) {
+        arena_size = MAX(arena_size, dec_instance_arena_size(pi_ceiling, dec_common->max_frame_bitstream_size));
+    }
+    svt_jxs_mem_size_add(mem, sizeof(svt_jpeg_xs_decoder_instance_t), SVT_JXS_MEM_GENERAL);
+    svt_jxs_mem_size_add(mem, svt_jxs_arena_block_memory(arena_size), SVT_JXS_MEM_COEFFICIENTS);
+}
 
-    SVT_NO_THROW_CALLOC(ctx, 1, sizeof(svt_jpeg_xs_decoder_thread_context));
-    if (!ctx) {
-        return NULL;
+/*Sizes of IDWT buffers of thread context for component, for whole picture width when picture has no vertical decomposition*/
+static void dec_thread_context_tmp_sizes(const pi_t* pi, uint32_t c, size_t* out_idwt_tmp_size, size_t* out_component_tmp_size) {
+    uint32_t width = pi->components[c].width;
+    if (pi->decom_v == 0) {
+        *out_idwt_tmp_size = pi->width;
+        *out_component_tmp_size = pi->width;
+    }
+    else if (pi->components[c].decom_v == 0) {
+        *out_idwt_tmp_size = width;
+        *out_component_tmp_size = width;
+    }
+    else if (pi->components[c].decom_v == 1) {
+        *out_idwt_tmp_size = 3 * width;
+        *out_component_tmp_size = 4 * width;
+    }
+    else { // pi->components[c].decom_v == 2
+        uint32_t V1_len = (width / 2) + (width & 1);
+        *out_idwt_tmp_size = 7 * V1_len + 3 * width; // ~6.5 * component->width
+        *out_component_tmp_size = 8 * width;
+    }
+}
+
+/*Arena size to get all buffers of thread context in one block, with alignment padding of every buffer*/
+static size_t dec_thread_context_arena_size(const pi_t* pi) {
+    size_t size = 0;
+    /*Without vertical decomposition one pair of buffers is shared by all components*/
+    uint32_t tmp_buffers_num = pi->decom_v == 0 ? 1 : pi->comps_num;
+    for (uint32_t c = 0; c < tmp_buffers_num; c++) {
+        size_t idwt_tmp_size;
+        size_t component_tmp_size;
+        dec_thread_context_tmp_sizes(pi, c, &idwt_tmp_size, &component_tmp_size);
+        size += (idwt_tmp_size + component_tmp_size) * sizeof(int32_t) + 2 * ALVALUE;
+    }
+
+    if (pi->precincts_col_num < MAX_PRECINCT_IN_LINE) {
+        const precinct_info_t* precinct_normal = &pi->p_info[PRECINCT_NORMAL];
+        size_t precinct_size = sizeof(precinct_t) + ALVALUE;
+        for (uint32_t c = 0; c < pi->comps_num; c++) {
+            for (uint32_t b = 0; b < pi->components[c].bands_num; b++) {
+                uint32_t height_lines_num = pi->components[c].bands[b].height_lines_num;
+                precinct_size += (size_t)precinct_normal->b_info[c][b].gcli_width * height_lines_num +
+                    (size_t)precinct_normal->b_info[c][b].significance_width * height_lines_num + 2 * ALVALUE;
+            }
+        }
+        size += (pi->precincts_col_num + 1) * precinct_size;
     }
+    return size;
+}
 
+/*Carve all buffers of thread context from arena for configuration of pi*/
+static int dec_thread_context_carve(svt_jpeg_xs_decoder_thread_context* ctx, pi_t* pi) {
     int ret = 0;
+    memset(ctx->precincts_top, 0, sizeof(ctx->precincts_top));
+    memset(ctx->precinct_components_tmp_buffer, 0, sizeof(ctx->precinct_components_tmp_buffer));
+    memset(ctx->precinct_idwt_tmp_buffer, 0, sizeof(ctx->precinct_idwt_tmp_buffer));
+
+    /*All buffers of thread context share one arena block, kept when it is big enough for new configuration*/
+    svt_jxs_arena_reset(&ctx->arena, dec_thread_context_arena_size(pi));
 
     //IDWT per precinct support
     // Zero-initialize: IDWT temp buffers may be partially read at slice boundaries before full write
+    size_t idwt_tmp_size;
+    size_t component_tmp_size;
     if (pi->decom_v == 0) {
-        for (uint32_t c = 0; c < pi->comps_num; c++) {
-            ctx->precinct_components_tmp_buffer[c] = NULL;
-            ctx->precinct_idwt_tmp_buffer[c] = NULL;
-        }
-        SVT_NO_THROW_CALLOC(ctx->precinct_components_tmp_buffer[0], 1, pi->width * sizeof(int32_t));
-        SVT_NO_THROW_CALLOC(ctx->precinct_idwt_tmp_buffer[0], 1, pi->width * sizeof(int32_t));
+        dec_thread_context_tmp_sizes(pi, 0, &idwt_tmp_size, &component_tmp_size);
+        SVT_ARENA_CALLOC_ARRAY(&ctx->arena, ctx->precinct_components_tmp_buffer[0], component_tmp_size);
+        SVT_ARENA_CALLOC_ARRAY(&ctx->arena, ctx->precinct_idwt_tmp_buffer[0], idwt_tmp_size);
 
         if (!ctx->precinct_components_tmp_buffer[0] || !ctx->precinct_idwt_tmp_buffer[0]) {
             ret |= 1;
@@ -268,21 +492,9 @@ svt_jpeg_xs_decoder_thread_context* svt_jpeg_xs_dec_thread_context_alloc(pi_t* p
     }
     else {
         for (uint32_t c = 0; c < pi->comps_num; c++) {
-            if (pi->components[c].decom_v == 0) {
-                SVT_NO_THROW_CALLOC(ctx->precinct_idwt_tmp_buffer[c], 1, pi->components[c].width * sizeof(int32_t));
-                SVT_NO_THROW_CALLOC(ctx->precinct_components_tmp_buffer[c], 1, pi->components[c].width * sizeof(int32_t));
-            }
-            else if (pi->components[c].decom_v == 1) {
-                SVT_NO_THROW_CALLOC(ctx->precinct_idwt_tmp_buffer[c], 1, 3 * pi->components[c].width * sizeof(int32_t));
-                SVT_NO_THROW_CALLOC(ctx->precinct_components_tmp_buffer[c], 1, 4 * pi->components[c].width * sizeof(int32_t));
-            }
-            else { // pi->components[c].decom_v == 2
-                uint32_t V1_len = (pi->components[c].width / 2) + (pi->components[c].width & 1);
-                SVT_NO_THROW_CALLOC(ctx->precinct_idwt_tmp_buffer[c],
-                                    1,
-                                    (7 * V1_len + 3 * pi->components[c].width) * sizeof(int32_t)); // ~6.5 * component->width
-                SVT_NO_THROW_CALLOC(ctx->precinct_components_tmp_buffer[c], 1, 8 * pi->components[c].width * sizeof(int32_t));
-            }
+            dec_thread_context_tmp_sizes(pi, c, &idwt_tmp_size, &component_tmp_size);
+            SVT_ARENA_CALLOC_ARRAY(&ctx->arena, ctx->precinct_idwt_tmp_buffer[c], idwt_tmp_size);
+            SVT_ARENA_CALLOC_ARRAY(&ctx->arena, ctx->precinct_components_tmp_buffer[c], component_tmp_size);
             if (!ctx->precinct_components_tmp_buffer[c] || !ctx->precinct_idwt_tmp_buffer[c]) {
                 ret |= 1;
                 break;
@@ -299,7 +511,7 @@ svt_jpeg_xs_decoder_thread_context* svt_jpeg_xs_dec_thread_context_alloc(pi_t* p
         precinct_info_t* precinct_normal = &pi->p_info[PRECINCT_NORMAL];
         for (uint32_t s = 0; s < pi->precincts_col_num + 1; s++) {
             precinct_t* p;
-            SVT_NO_THROW_CALLOC(p, 1, sizeof(precinct_t));
+            SVT_ARENA_CALLOC_ARRAY(&ctx->arena, p, 1);
             if (!p) {
                 ret |= 1;
                 break;
@@ -310,13 +522,13 @@ svt_jpeg_xs_decoder_thread_context* svt_jpeg_xs_dec_thread_context_alloc(pi_t* p
                     uint32_t height_lines_num = pi->components[c].bands[b].height_lines_num;
                     assert(height_lines_num == precinct_normal->b_info[c][b].height);
                     uint32_t gcli_data_size = precinct_normal->b_info[c][b].gcli_width * height_lines_num;
-                    SVT_NO_THROW_MALLOC(p->bands[c][b].gcli_data, sizeof(int8_t) * (gcli_data_size));
+                    SVT_ARENA_CALLOC_ARRAY(&ctx->arena, p->bands[c][b].gcli_data, gcli_data_size);
                     if (!p->bands[c][b].gcli_data) {
                         ret |= 1;
                         break;
                     }
                     uint32_t sig_data_size = precinct_normal->b_info[c][b].significance_width * height_lines_num;
-                    SVT_NO_THROW_MALLOC(p->bands[c][b].significance_data, sizeof(uint8_t) * (sig_data_size));
+                    SVT_ARENA_CALLOC_ARRAY(&ctx->arena, p->bands[c][b].significance_data, sig_data_size);
                     if (!p->bands[c][b].significance_data) {
                         ret |= 1;
                         break;
@@ -326,51 +538,52 @@ svt_jpeg_xs_decoder_thread_context* svt_jpeg_xs_dec_thread_context_alloc(pi_t* p
         }
     }
 
-    if (ret) {
+    return ret;
+}
+
+svt_jpeg_xs_decoder_thread_context* svt_jpeg_xs_dec_thread_context_alloc(pi_t* pi) {
+    svt_jpeg_xs_decoder_thread_context* ctx;
+
+    SVT_NO_THROW_CALLOC(ctx, 1, sizeof(svt_jpeg_xs_decoder_thread_context));
+    if (!ctx) {
+        return NULL;
+    }
+
+    svt_jxs_arena_ctor(&ctx->arena, 0, SVT_JXS_MEM_SCRATCH);
+    if (dec_thread_context_carve(ctx, pi)) {
         svt_jpeg_xs_dec_thread_context_free(ctx, pi);
         return NULL;
     }
 
+    svt_jxs_arena_print_usage(&ctx->arena, "Decoder thread context");
     return ctx;
 }
 
+SvtJxsErrorType_t svt_jpeg_xs_dec_thread_context_reset(svt_jpeg_xs_decoder_thread_context* ctx, pi_t* pi) {
+    if (dec_thread_context_carve(ctx, pi)) {
+        return SvtJxsErrorInsufficientResources;
+    }
+    svt_jxs_arena_print_usage(&ctx->arena, "Decoder thread context");
+    return SvtJxsErrorNone;
+}
+
 void svt_jpeg_xs_dec_thread_context_free(svt_jpeg_xs_decoder_thread_context* ctx, pi_t* pi) {
+    (void)pi;
     if (!ctx) {
         return;
     }
 
-    //IDWT per precinct support
-    if (pi->decom_v == 0) {
-        for (uint32_t c = 0; c < pi->comps_num; c++) {
-            SVT_FREE(ctx->precinct_components_tmp_buffer[c]);
-        }
-        SVT_FREE(ctx->precinct_idwt_tmp_buffer[0]);
-    }
-    else {
-        for (uint32_t c = 0; c < pi->comps_num; c++) {
-            SVT_FREE(ctx->precinct_components_tmp_buffer[c]);
-            SVT_FREE(ctx->precinct_idwt_tmp_buffer[c]);
-        }
-    }
-    //END IDWT per precinct support
+    svt_jxs_arena_dctor(&ctx->arena);
+    SVT_FREE(ctx);
+}
 
-    for (uint32_t s = 0; s < MIN(pi->precincts_col_num + 1, MAX_PRECINCT_IN_LINE); s++) {
-        for (uint32_t c = 0; c < pi->comps_num; c++) {
-            for (uint32_t b = 0; b < pi->components[c].bands_num; b++) {
-                if (ctx->precincts_top[s]) {
-                    if (ctx->precincts_top[s]->bands[c][b].gcli_data) {
-                        SVT_FREE(ctx->precincts_top[s]->bands[c][b].gcli_data);
-                    }
-                    if (ctx->precincts_top[s]->bands[c][b].significance_data) {
-                        SVT_FREE(ctx->precincts_top[s]->bands[c][b].significance_data);
-                    }
-                }
-            }
-        }
-        SVT_FREE(ctx->precincts_top[s]);
+void svt_jpeg_xs_dec_thread_context_memory(SvtMemSize_t* mem, const pi_t* pi, const pi_t* pi_ceiling) {
+    size_t arena_size = dec_thread_context_arena_size(pi);
+    if (pi_ceiling) {
+        arena_size = MAX(arena_size, dec_thread_context_arena_size(pi_ceiling));
     }
-
-    SVT_FREE(ctx);
+    svt_jxs_mem_size_add(mem, sizeof(svt_jpeg_xs_decoder_thread_context), SVT_JXS_MEM_GENERAL);
+    svt_jxs_mem_size_add(mem, svt_jxs_arena_block_memory(arena_size), SVT_JXS_MEM_SCRATCH);
 }
 
 //Parse header and return size header, or return ERROR
@@ -514,6 +727,7 @@ SvtJxsErrorType_t svt_jpeg_xs_decode_slice(svt_jpeg_xs_decoder_instance_t* ctx,
     bitstream_reader_t bitstream;
     bitstream_reader_init(&bitstream, bitstream_buf, bitstream_buf_size);
 
+    const svt_jpeg_xs_decoder_common_t* dec_common = ctx->dec_common;
     pi_t* pi = &ctx->dec_common->pi;
     picture_header_dynamic_t* picture_header_dynamic = &ctx->picture_header_dynamic;
 
@@ -568,12 +782,18 @@ SvtJxsErrorType_t svt_jpeg_xs_decode_slice(svt_jpeg_xs_decoder_instance_t* ctx,
                 }
             }
 
-            ret = unpack_precinct(&bitstream, precinct, precincts_top, pi, picture_header_dynamic, verbose);
+            ret = unpack_precinct(&bitstream,
+                                  precinct,
+                                  precincts_top,
+                                  pi,
+                                  picture_header_dynamic,
+                                  dec_common->bands_skip_enable ? dec_common->bands_skip : NULL,
+                                  verbose);
             if (ret) {
                 return ret;
             }
 
-            inv_precinct_calculate_data(precinct, pi, picture_header_dynamic->hdr_Qpih);
+            inv_precinct_calculate_data(precinct, pi, picture_header_dynamic->hdr_Qpih, dec_common->components_skip);
 
             //Swap pointers in precincts_top
             thread_ctx->precincts_top[pi->precincts_col_num] = thread_ctx->precincts_top[column];
@@ -591,6 +811,9 @@ SvtJxsErrorType_t svt_jpeg_xs_decode_slice(svt_jpeg_xs_decoder_instance_t* ctx,
         /*****V0 Hx IDWT per precinct implementation**********/
         if (pi->decom_v == 0) {
             for (uint32_t c = 0; c < pi->comps_num; c++) {
+                if (dec_common->components_skip[c]) {
+                    continue;
+                }
                 transform_precinct(pi,
                                    ctx,
                                    c,
@@ -613,6 +836,9 @@ SvtJxsErrorType_t svt_jpeg_xs_decode_slice(svt_jpeg_xs_decoder_instance_t* ctx,
             if ((line == 1) && slice) {
                 uint32_t precint_idx_to_init = precinct_line_idx + 1;
                 for (uint32_t c = 0; c < pi->comps_num; c++) {
+                    if (dec_common->components_skip[c]) {
+                        continue;
+                    }
                     transform_precinct_initialize(pi,
                                                   ctx,
                                                   c,
@@ -624,6 +850,9 @@ SvtJxsErrorType_t svt_jpeg_xs_decode_slice(svt_jpeg_xs_decoder_instance_t* ctx,
             }
             else { // (line > 1)
                 for (uint32_t c = 0; c < pi->comps_num; c++) {
+                    if (dec_common->components_skip[c]) {
+                        continue;
+                    }
                     transform_precinct(pi,
                                        ctx,
                                        c,
@@ -648,6 +877,9 @@ SvtJxsErrorType_t svt_jpeg_xs_decode_slice(svt_jpeg_xs_decoder_instance_t* ctx,
         for (uint32_t line = 0; line < 2; line++) {
             uint32_t precinct_line_idx = (slice + 1) * pi->precincts_per_slice + line;
             for (uint32_t c = 0; c < pi->comps_num; c++) {
+                if (dec_common->components_skip[c]) {
+                    continue;
+                }
                 transform_precinct(pi,
                                    ctx,
                                    c,
@@ -663,8 +895,10 @@ SvtJxsErrorType_t svt_jpeg_xs_decode_slice(svt_jpeg_xs_decoder_instance_t* ctx,
     return SvtJxsErrorNone;
 }
 
-SvtJxsErrorType_t svt_jpeg_xs_decode_final_slice_overlap(svt_jpeg_xs_decoder_instance_t* ctx, svt_jpeg_xs_image_buffer_t* out,
-                                                         uint32_t slice_idx) {
+SvtJxsErrorType_t svt_jpeg_xs_decode_final_slice_overlap(svt_jpeg_xs_decoder_instance_t* ctx,
+                                                         svt_jpeg_xs_decoder_thread_context* thread_ctx,
+                                                         svt_jpeg_xs_image_buffer_t* out, uint32_t slice_idx) {
+    const svt_jpeg_xs_decoder_common_t* dec_common = ctx->dec_common;
     pi_t* pi = &ctx->dec_common->pi;
 
     //First slice does not require recalculation
@@ -674,29 +908,35 @@ SvtJxsErrorType_t svt_jpeg_xs_decode_final_slice_overlap(svt_jpeg_xs_decoder_ins
     }
 
     uint32_t precincts_per_slice_last = pi->precincts_line_num - (pi->slice_num - 1) * pi->precincts_per_slice;
-    // Number of "precincts" lines in one slice
+    /*Calculate only precincts of this slice, so overlaps of different slices can be calculated in parallel*/
+    uint32_t precincts_to_calculate = 2;
+    if (slice_idx == (pi->slice_num - 1)) {
+        precincts_to_calculate = MIN(precincts_to_calculate, precincts_per_slice_last);
+    }
+    else {
+        precincts_to_calculate = MIN(precincts_to_calculate, pi->precincts_per_slice);
+    }
     //for each component
     for (uint32_t c = 0; c < pi->comps_num; c++) {
+        if (dec_common->components_skip[c]) {
+            continue;
+        }
         uint32_t precinct_line_idx = slice_idx * pi->precincts_per_slice;
         transform_precinct_initialize(pi,
                                       ctx,
                                       c,
                                       precinct_line_idx,
-                                      ctx->precinct_component_tmp_buffer,
-                                      ctx->precinct_idwt_tmp_buffer,
+                                      thread_ctx->precinct_components_tmp_buffer[c],
+                                      thread_ctx->precinct_idwt_tmp_buffer[c],
                                       ctx->picture_header_dynamic.hdr_Fq);
 
-        uint32_t precincts_to_calculate = 2;
-        if (slice_idx == (pi->slice_num - 1)) {
-            precincts_to_calculate = MIN(precincts_to_calculate, precincts_per_slice_last);
-        }
         for (uint32_t precinct = 0; precinct < precincts_to_calculate; precinct++) {
             transform_precinct(pi,
                                ctx,
                                c,
                                (precinct_line_idx + precinct),
-                               ctx->precinct_component_tmp_buffer,
-                               ctx->precinct_idwt_tmp_buffer,
+                               thread_ctx->precinct_components_tmp_buffer[c],
+                               thread_ctx->precinct_idwt_tmp_buffer[c],
                                out,
                                ctx->picture_header_dynamic.hdr_Fq);
         }
@@ -705,6 +945,52 @@ SvtJxsErrorType_t svt_jpeg_xs_decode_final_slice_overlap(svt_jpeg_xs_decoder_ins
     return SvtJxsErrorNone;
 }
 
+/*Initialization of overlap read 2 precincts above first precinct of slice, that is 2 slices above when slice has 1 precinct*/
+static uint32_t slice_overlap_deps_above(const pi_t* pi) {
+    return pi->precincts_per_slice == 1 ? 2 : 1;
+}
+
+void svt_jpeg_xs_decode_slice_overlap_deps_init(svt_jpeg_xs_decoder_instance_t* ctx, uint32_t slice_first, uint32_t slice_end) {
+    const pi_t* pi = &ctx->dec_common->pi;
+    const uint32_t deps_above = slice_overlap_deps_above(pi);
+    /*Slices out of range are not decoded, so they are not waited for*/
+    memset(ctx->sync_overlap_deps, 0, pi->slice_num * sizeof(uint32_t));
+    for (uint32_t slice = slice_first; slice < slice_end; slice++) {
+        ctx->sync_overlap_deps[slice] = slice - MAX(slice_first, (slice > deps_above ? slice - deps_above : 0)) + 1;
+    }
+}
+
+SvtJxsErrorType_t svt_jpeg_xs_decode_slice_overlap_ready(svt_jpeg_xs_decoder_instance_t* ctx,
+                                                        svt_jpeg_xs_decoder_thread_context* thread_ctx,
+                                                        svt_jpeg_xs_image_buffer_t* out, uint32_t slice) {
+    const svt_jpeg_xs_decoder_common_t* dec_common = ctx->dec_common;
+    const pi_t* pi = &dec_common->pi;
+
+    /*Overlap is calculated in slice when sync_slices_idwt, or in final thread for whole frame when Cpih*/
+    if (ctx->sync_slices_idwt || pi->decom_v == 0 || dec_common->picture_header_const.hdr_Cpih) {
+        return SvtJxsErrorNone;
+    }
+    const uint32_t slice_last = MIN(slice + slice_overlap_deps_above(pi), pi->slice_num - 1);
+    for (uint32_t slice_overlap = slice; slice_overlap <= slice_last; slice_overlap++) {
+        if (SVT_ATOMIC_LOAD32(&ctx->sync_overlap_deps[slice_overlap]) == 0) {
+            /*Slice is not decoded*/
+            continue;
+        }
+        if (SVT_ATOMIC_SUB32(&ctx->sync_overlap_deps[slice_overlap], 1) != 0) {
+            continue;
+        }
+        /*Slices around region of interest only provide coefficients, overlap of slice after region finishes last rows of
+         * region*/
+        if (slice_overlap >= dec_common->roi_slice_begin && slice_overlap <= dec_common->roi_slice_end) {
+            SvtJxsErrorType_t ret = svt_jpeg_xs_decode_final_slice_overlap(ctx, thread_ctx, out, slice_overlap);
+            if (ret) {
+                return ret;
+            }
+        }
+    }
+    return SvtJxsErrorNone;
+}
+
 SvtJxsErrorType_t svt_jpeg_xs_decode_final(svt_jpeg_xs_decoder_instance_t* ctx, svt_jpeg_xs_image_buffer_t* out) {
     pi_t* pi = &ctx->dec_common->pi;
     picture_header_dynamic_t* picture_header_dynamic = &ctx->picture_header_dynamic;
@@ -798,3 +1084,41 @@ SvtJxsErrorType_t svt_jpeg_xs_decode_final(svt_jpeg_xs_decoder_instance_t* ctx,
     }
     return SvtJxsErrorNone;
 }
+
+void svt_jpeg_xs_decode_slice_clear(svt_jpeg_xs_decoder_instance_t* ctx, uint32_t slice_idx) {
+    pi_t* pi = &ctx->dec_common->pi;
+    uint32_t precinct_line_begin = slice_idx * pi->precincts_per_slice;
+    uint32_t precinct_line_end = MIN(precinct_line_begin + pi->precincts_per_slice, pi->precincts_line_num);
+    memset(ctx->coeff_buff_ptr_16bit + (size_t)precinct_line_begin * ctx->precincts_line_coeff_size,
+           0,
+           (size_t)(precinct_line_end - precinct_line_begin) * ctx->precincts_line_coeff_size * sizeof(int16_t));
+}
+
+void svt_jpeg_xs_decode_slice_conceal(svt_jpeg_xs_decoder_instance_t* ctx, svt_jpeg_xs_image_buffer_t* out, uint32_t slice_idx) {
+    const svt_jpeg_xs_decoder_common_t* dec_common = ctx->dec_common;
+    const pi_t* pi = &dec_common->pi;
+    uint8_t bit_depth = dec_common->picture_header_const.hdr_bit_depth[0];
+    uint16_t grey = (uint16_t)(1 << (bit_depth - 1));
+
+    for (uint32_t c = 0; c < pi->comps_num; c++) {
+        if (dec_common->components_skip[c]) {
+            continue;
+        }
+        uint32_t width = pi->components[c].width;
+        uint32_t slice_height = pi->precincts_per_slice * pi->components[c].precinct_height;
+        uint32_t line_begin = MIN(slice_idx * slice_height, pi->components[c].height);
+        uint32_t line_end = MIN(line_begin + slice_height, pi->components[c].height);
+        for (uint32_t line = line_begin; line < line_end; line++) {
+            if (bit_depth <= 8) {
+                uint8_t* out_buf_8 = ((uint8_t*)out->data_yuv[c]) + line * out->stride[c];
+                memset(out_buf_8, grey, width);
+            }
+            else {
+                uint16_t* out_buf_16 = ((uint16_t*)out->data_yuv[c]) + line * out->stride[c];
+                for (uint32_t i = 0; i < width; i++) {
+                    out_buf_16[i] = grey;
+                }
+            }
+        }
+    }
+}
@@ -9,6 +9,8 @@
 #include "SvtJpegxsDec.h"
 #include "Definitions.h"
 #include "Threads/SvtThreads.h"
+#include "Threads/SvtArena.h"
+#include "Threads/SvtMalloc.h"
 
 #define MAX_PRECINCT_IN_LINE (130)
 
@@ -20,15 +22,24 @@ typedef struct svt_jpeg_xs_decoder_common {
     // Temporary buffer when picture_header_dynamic->hdr_Cpih is enabled
     // TODO: Can be removed/optimized in future
     int32_t* buffer_tmp_cpih[MAX_COMPONENTS_NUM];
+    size_t buffer_tmp_cpih_size;
 
     // max_frame_bitstream_size is used only when packetization_mode is enabled
     uint32_t max_frame_bitstream_size;
+
+    /* Region of interest, set by svt_jpeg_xs_dec_init_roi()*/
+    uint32_t roi_slice_begin;
+    uint32_t roi_slice_end;
+    uint8_t components_skip[MAX_COMPONENTS_NUM]; /*Component is not decoded*/
+    uint8_t bands_skip[MAX_BANDS_NUM];           /*Global band is not unpacked, indexing refers to pi.global_band_info[]*/
+    uint8_t bands_skip_enable;
 } svt_jpeg_xs_decoder_common_t;
 
 typedef struct svt_jpeg_xs_decoder_thread_context {
     precinct_t* precincts_top[MAX_PRECINCT_IN_LINE];
     int32_t* precinct_components_tmp_buffer[MAX_COMPONENTS_NUM];
     int32_t* precinct_idwt_tmp_buffer[MAX_COMPONENTS_NUM];
+    SvtArena_t arena; /*Owns all buffers of thread context*/
 } svt_jpeg_xs_decoder_thread_context;
 
 /*TODO Decoder instance Per frame, rename to decoder per frame.*/
@@ -89,18 +100,27 @@ precinct X |  comp-n, band6        |
 
     uint32_t sync_output_frame_idx;
     uint32_t sync_num_slices_to_receive;
+    uint32_t sync_slice_first; /*First slice scheduled to decode, other than 0 when decode region of interest*/
     uint64_t frame_num;
     svt_jpeg_xs_frame_t dec_input;
 
+    svt_jpeg_xs_frame_stats_t stats; /*Only INIT stage and input queue, set before first slice is scheduled*/
+    uint64_t stats_time_send_us;
+
     uint8_t sync_slices_idwt;        /*Calculation slice before IDWT wait to finish decode next slice.*/
     CondVar* map_slices_decode_done; /*When sync_slices_idwt use as array of Condition Variable, else use as array of "val"*/
+    uint32_t map_slices_num;         /*Number of created Condition Variables*/
+    uint32_t* sync_overlap_deps;     /*When not sync_slices_idwt, per slice number of slices to decode before overlap with
+                                      * previous slice can be calculated, last universal thread that finish them calculate it*/
 
-    //TODO: Used only by Final Thread. Can be moved to Final Thread context, or to Slice thread context in future solution.
+    //TODO: Used only by Final Thread with Multiple Component Transformation. Can be moved to Final Thread context.
     int32_t* precinct_idwt_tmp_buffer;
     int32_t* precinct_component_tmp_buffer;
 
     // Buffer allocated only when packetization_mode is enabled
     uint8_t* frame_bitstream_ptr;
+
+    SvtArena_t arena; /*Owns all buffers of instance*/
 } svt_jpeg_xs_decoder_instance_t;
 
 #ifdef __cplusplus
@@ -113,14 +133,32 @@ SvtJxsErrorType_t svt_jpeg_xs_decoder_probe(const uint8_t* bitstream_buf, size_t
 ColourFormat_t svt_jpeg_xs_get_format_from_params(uint32_t comps_num, uint32_t sx[MAX_COMPONENTS_NUM],
                                                   uint32_t sy[MAX_COMPONENTS_NUM]);
 
+/*Compute picture information and region of interest from picture header, without any allocation*/
+SvtJxsErrorType_t svt_jpeg_xs_dec_configure_common(svt_jpeg_xs_decoder_common_t* dec_common,
+                                                   svt_jpeg_xs_image_config_t* out_image_config, proxy_mode_t proxy_mode,
+                                                   uint32_t verbose);
+/*Allocate buffers shared by all decoder instances for configuration of dec_common*/
+SvtJxsErrorType_t svt_jpeg_xs_dec_alloc_common(svt_jpeg_xs_decoder_common_t* dec_common);
+/*Configure and allocate buffers shared by all decoder instances*/
 SvtJxsErrorType_t svt_jpeg_xs_dec_init_common(svt_jpeg_xs_decoder_common_t* dec_common,
                                               svt_jpeg_xs_image_config_t* out_image_config, proxy_mode_t proxy_mode,
                                               uint32_t verbose);
+void svt_jpeg_xs_dec_common_memory(SvtMemSize_t* mem, const svt_jpeg_xs_decoder_common_t* dec_common);
+
+SvtJxsErrorType_t svt_jpeg_xs_dec_init_roi(svt_jpeg_xs_decoder_common_t* dec_common, uint32_t slice_begin, uint32_t slice_end,
+                                           uint8_t components_mask, uint32_t verbose);
+void svt_jpeg_xs_dec_get_roi_slices(const svt_jpeg_xs_decoder_common_t* dec_common, uint32_t* first_slice, uint32_t* end_slice);
 
 svt_jpeg_xs_decoder_instance_t* svt_jpeg_xs_dec_instance_alloc(svt_jpeg_xs_decoder_common_t* dec_common);
 void svt_jpeg_xs_dec_instance_free(svt_jpeg_xs_decoder_instance_t* ctx);
 svt_jpeg_xs_decoder_thread_context* svt_jpeg_xs_dec_thread_context_alloc(pi_t* pi);
+/*Reconfiguration: carve buffers again for new configuration, memory is allocated only when more is required*/
+SvtJxsErrorType_t svt_jpeg_xs_dec_instance_reset(svt_jpeg_xs_decoder_instance_t* ctx, svt_jpeg_xs_decoder_common_t* dec_common);
+SvtJxsErrorType_t svt_jpeg_xs_dec_thread_context_reset(svt_jpeg_xs_decoder_thread_context* ctx, pi_t* pi);
 void svt_jpeg_xs_dec_thread_context_free(svt_jpeg_xs_decoder_thread_context* ctx, pi_t* pi);
+/*Memory of instance and thread context, pi_ceiling is set when they are allocated for ceiling and carved for stream*/
+void svt_jpeg_xs_dec_instance_memory(SvtMemSize_t* mem, const svt_jpeg_xs_decoder_common_t* dec_common, const pi_t* pi_ceiling);
+void svt_jpeg_xs_dec_thread_context_memory(SvtMemSize_t* mem, const pi_t* pi, const pi_t* pi_ceiling);
 
 SvtJxsErrorType_t svt_jpeg_xs_decode_header(svt_jpeg_xs_decoder_instance_t* ctx, const uint8_t* bitstream_buf,
                                             size_t bitstream_buf_size, uint32_t* out_header_size, uint32_t verbose);
@@ -130,8 +168,20 @@ SvtJxsErrorType_t svt_jpeg_xs_decode_slice(svt_jpeg_xs_decoder_instance_t* ctx,
 
 SvtJxsErrorType_t svt_jpeg_xs_decode_final(svt_jpeg_xs_decoder_instance_t* ctx, svt_jpeg_xs_image_buffer_t* out);
 
-SvtJxsErrorType_t svt_jpeg_xs_decode_final_slice_overlap(svt_jpeg_xs_decoder_instance_t* ctx, svt_jpeg_xs_image_buffer_t* out,
-                                                         uint32_t slice_idx);
+SvtJxsErrorType_t svt_jpeg_xs_decode_final_slice_overlap(svt_jpeg_xs_decoder_instance_t* ctx,
+                                                         svt_jpeg_xs_decoder_thread_context* thread_ctx,
+                                                         svt_jpeg_xs_image_buffer_t* out, uint32_t slice_idx);
+/*Set dependencies of overlaps for slices scheduled to decode in range [slice_first, slice_end)*/
+void svt_jpeg_xs_decode_slice_overlap_deps_init(svt_jpeg_xs_decoder_instance_t* ctx, uint32_t slice_first, uint32_t slice_end);
+/*Call when slice is decoded or concealed, calculate overlaps that do not wait for other slices*/
+SvtJxsErrorType_t svt_jpeg_xs_decode_slice_overlap_ready(svt_jpeg_xs_decoder_instance_t* ctx,
+                                                        svt_jpeg_xs_decoder_thread_context* thread_ctx,
+                                                        svt_jpeg_xs_image_buffer_t* out, uint32_t slice);
+
+/*Slice concealment: clear coefficients of invalid slice before overlap with neighbour slices,
+ * and fill rows of slice in output with mid-grey after whole frame is transformed*/
+void svt_jpeg_xs_decode_slice_clear(svt_jpeg_xs_decoder_instance_t* ctx, uint32_t slice_idx);
+void svt_jpeg_xs_decode_slice_conceal(svt_jpeg_xs_decoder_instance_t* ctx, svt_jpeg_xs_image_buffer_t* out, uint32_t slice_idx);
 
 #ifdef __cplusplus
 }
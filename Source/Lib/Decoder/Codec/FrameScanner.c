@@ -0,0 +1,282 @@
+/*
+* Copyright(c) 2024 Intel Corporation
+* SPDX - License - Identifier: BSD - 2 - Clause - Patent
+*/
+
+#include "FrameScanner.h"
+
+#include <string.h>
+
+#include "Codestream.h"
+#include "SvtUtility.h"
+#include "Threads/SvtMalloc.h"
+
+/* Maximum number of components allowed by the JPEG XS spec (ISO/IEC 21122) */
+#define JPEGXS_SPEC_MAX_COMPONENTS_NUM (8)
+/* Part of picture header used by scanner: marker, Lpih .. Nlx/Nly */
+#define FRAME_SCANNER_PIH_BYTES (27)
+
+static uint16_t get_16_bits(const uint8_t* buf) {
+    uint16_t ret_val = (uint16_t)buf[0] << 8;
+    return ret_val | buf[1];
+}
+
+void frame_scanner_reset(frame_scanner_t* scanner) {
+    /*Keep slice index allocation for next frames*/
+    uint32_t* slice_offsets = scanner->slice_offsets;
+    uint32_t slice_offsets_size = scanner->slice_offsets_size;
+    memset(scanner, 0, sizeof(*scanner));
+    scanner->slice_offsets = slice_offsets;
+    scanner->slice_offsets_size = slice_offsets_size;
+
+    scanner->step = FRAME_SCANNER_MARKER;
+    scanner->header_needed = 2;
+    scanner->comps_num = -1;
+    scanner->decomp_h = -1;
+    scanner->decomp_v = -1;
+    scanner->bands_num_exists = -1;
+}
+
+static SvtJxsErrorType_t scanner_begin_precincts(frame_scanner_t* scanner) {
+    int32_t comps_num = scanner->comps_num;
+    int32_t Sd = scanner->Sd;
+    if (comps_num < 1 || scanner->decomp_h < 0 || scanner->decomp_v < 0 || Sd >= comps_num || scanner->slices_expected == 0) {
+        return SvtJxsErrorDecoderInvalidBitstream;
+    }
+    int32_t bands_num_exists = Sd;
+    for (int32_t c = 0; c < comps_num - Sd; c++) {
+        uint32_t Sx = scanner->Sx[c];
+        uint32_t Sy = scanner->Sy[c];
+        if (Sx < 1 || Sy < 1 || Sx > 2 || Sy > Sx) {
+            return SvtJxsErrorDecoderInvalidBitstream;
+        }
+        int32_t Nx = scanner->decomp_h;
+        int32_t Ny = scanner->decomp_v - (Sy - 1);
+        if (Ny < 0 || Ny > Nx) {
+            return SvtJxsErrorDecoderInvalidBitstream;
+        }
+        bands_num_exists += 2 * Ny + Nx + 1;
+    }
+    scanner->bands_num_exists = bands_num_exists;
+    /*Lprc + Q[p] + R[p] and Bit-plane count coding mode with alignment*/
+    scanner->precinct_header_bytes = 5 + DIV_ROUND_UP(bands_num_exists * 2, 8);
+    return SvtJxsErrorNone;
+}
+
+/*Read marker and choose how many bytes of marker segment are needed*/
+static SvtJxsErrorType_t scanner_parse_marker(frame_scanner_t* scanner, uint8_t* frame_done) {
+    uint16_t marker = get_16_bits(scanner->header);
+    if (scanner->frame_offset == 2) {
+        if (marker != CODESTREAM_SOC) {
+            return SvtJxsErrorDecoderInvalidBitstream;
+        }
+        scanner->header_filled = 0;
+        return SvtJxsErrorNone;
+    }
+    if (marker == CODESTREAM_SOC) {
+        return SvtJxsErrorDecoderInvalidBitstream;
+    }
+    if (marker == CODESTREAM_EOC) {
+        if (scanner->bands_num_exists < 0 || scanner->slices_num != scanner->slices_expected) {
+            return SvtJxsErrorDecoderInvalidBitstream;
+        }
+        *frame_done = 1;
+        return SvtJxsErrorNone;
+    }
+    if ((marker >> 12) == 0) {
+        /*Precinct, first 2 bytes of Lprc*/
+        if (scanner->bands_num_exists < 0) {
+            return SvtJxsErrorDecoderInvalidBitstream;
+        }
+        scanner->step = FRAME_SCANNER_SEGMENT_DATA;
+        scanner->header_needed = 3;
+        return SvtJxsErrorNone;
+    }
+    scanner->step = FRAME_SCANNER_SEGMENT;
+    scanner->header_needed = 4;
+    return SvtJxsErrorNone;
+}
+
+static SvtJxsErrorType_t scanner_parse_segment(frame_scanner_t* scanner) {
+    uint16_t marker = get_16_bits(scanner->header);
+    uint32_t segment_size = 2 + get_16_bits(scanner->header + 2);
+    uint32_t header_needed = 0;
+
+    if (marker != CODESTREAM_SLH && scanner->bands_num_exists >= 0) {
+        /*Only slices are allowed after first slice header*/
+        return SvtJxsErrorDecoderInvalidBitstream;
+    }
+    switch (marker) {
+    case CODESTREAM_PIH:
+        header_needed = FRAME_SCANNER_PIH_BYTES;
+        break;
+    case CODESTREAM_CDT:
+        header_needed = segment_size;
+        if (header_needed > FRAME_SCANNER_HEADER_MAX_BYTES) {
+            return SvtJxsErrorDecoderInvalidBitstream;
+        }
+        break;
+    case CODESTREAM_CWD:
+        header_needed = 5;
+        break;
+    case CODESTREAM_SLH:
+        header_needed = 6;
+        break;
+    case CODESTREAM_CAP:
+    case CODESTREAM_WGT:
+    case CODESTREAM_NLT:
+    case CODESTREAM_CTS:
+    case CODESTREAM_CRG:
+    case CODESTREAM_COM:
+        header_needed = 4;
+        break;
+    default:
+        return SvtJxsErrorDecoderInvalidBitstream;
+    }
+    if (segment_size < header_needed) {
+        return SvtJxsErrorDecoderInvalidBitstream;
+    }
+    if (header_needed == 4) {
+        scanner->skip_bytes = segment_size - 4;
+        scanner->step = FRAME_SCANNER_MARKER;
+        scanner->header_needed = 2;
+        scanner->header_filled = 0;
+    }
+    else {
+        scanner->step = FRAME_SCANNER_SEGMENT_DATA;
+        scanner->header_needed = header_needed;
+    }
+    return SvtJxsErrorNone;
+}
+
+static SvtJxsErrorType_t scanner_parse_segment_data(frame_scanner_t* scanner) {
+    const uint8_t* header = scanner->header;
+    uint16_t marker = get_16_bits(header);
+    uint32_t segment_size = 0;
+
+    if ((marker >> 12) == 0) {
+        uint32_t precinct_size = (uint32_t)marker << 8 | header[2];
+        if (precinct_size > PRECINCT_MAX_BYTES_SIZE) {
+            return SvtJxsErrorDecoderInvalidBitstream;
+        }
+        segment_size = precinct_size + scanner->precinct_header_bytes;
+    }
+    else {
+        segment_size = 2 + get_16_bits(header + 2);
+        switch (marker) {
+        case CODESTREAM_PIH: {
+            uint32_t height = get_16_bits(header + 14);
+            uint32_t slice_height = get_16_bits(header + 18);
+            scanner->comps_num = header[20];
+            scanner->decomp_h = header[26] >> 4;
+            scanner->decomp_v = header[26] & 0xF;
+            if (height == 0 || slice_height == 0) {
+                return SvtJxsErrorDecoderInvalidBitstream;
+            }
+            scanner->slices_expected = DIV_ROUND_UP(height, slice_height << scanner->decomp_v);
+            if (scanner->slices_expected > scanner->slice_offsets_size) {
+                SVT_FREE(scanner->slice_offsets);
+                scanner->slice_offsets_size = 0;
+                SVT_MALLOC(scanner->slice_offsets, scanner->slices_expected * sizeof(uint32_t));
+                scanner->slice_offsets_size = scanner->slices_expected;
+            }
+            break;
+        }
+        case CODESTREAM_CDT: {
+            int32_t comps_num = scanner->comps_num;
+            if (comps_num < 1 || comps_num > JPEGXS_SPEC_MAX_COMPONENTS_NUM || (uint32_t)(2 * comps_num + 4) > segment_size) {
+                return SvtJxsErrorDecoderInvalidBitstream;
+            }
+            for (int32_t c = 0; c < comps_num; c++) {
+                scanner->Sx[c] = header[4 + 2 * c + 1] >> 4;
+                scanner->Sy[c] = header[4 + 2 * c + 1] & 0xF;
+            }
+            break;
+        }
+        case CODESTREAM_CWD:
+            scanner->Sd = header[4];
+            break;
+        case CODESTREAM_SLH: {
+            uint32_t slice_index = get_16_bits(header + 4);
+            if (scanner->bands_num_exists < 0) {
+                SvtJxsErrorType_t ret = scanner_begin_precincts(scanner);
+                if (ret) {
+                    return ret;
+                }
+            }
+            if (slice_index != scanner->slices_num || scanner->slices_num >= scanner->slices_expected) {
+                return SvtJxsErrorDecoderInvalidBitstream;
+            }
+            scanner->slice_offsets[scanner->slices_num++] = scanner->frame_offset - scanner->header_needed;
+            break;
+        }
+        default:
+            return SvtJxsErrorDecoderInvalidBitstream;
+        }
+    }
+
+    scanner->skip_bytes = segment_size - scanner->header_needed;
+    scanner->step = FRAME_SCANNER_MARKER;
+    scanner->header_needed = 2;
+    scanner->header_filled = 0;
+    return SvtJxsErrorNone;
+}
+
+SvtJxsErrorType_t frame_scanner_feed(frame_scanner_t* scanner, const uint8_t* chunk, size_t chunk_size, size_t* bytes_used,
+                                     svt_jpeg_xs_frame_index_t* out_index) {
+    size_t pos = 0;
+    *bytes_used = 0;
+    if (scanner->invalid) {
+        return SvtJxsErrorDecoderInvalidBitstream;
+    }
+
+    while (pos < chunk_size) {
+        if (scanner->skip_bytes) {
+            /*Payload of marker segment or precinct is not read*/
+            uint32_t skip = (uint32_t)MIN((size_t)scanner->skip_bytes, chunk_size - pos);
+            scanner->skip_bytes -= skip;
+            scanner->frame_offset += skip;
+            pos += skip;
+            continue;
+        }
+
+        uint32_t copy = (uint32_t)MIN((size_t)(scanner->header_needed - scanner->header_filled), chunk_size - pos);
+        memcpy(scanner->header + scanner->header_filled, chunk + pos, copy);
+        scanner->header_filled += copy;
+        scanner->frame_offset += copy;
+        pos += copy;
+        if (scanner->header_filled < scanner->header_needed) {
+            break;
+        }
+
+        uint8_t frame_done = 0;
+        SvtJxsErrorType_t ret = SvtJxsErrorNone;
+        switch (scanner->step) {
+        case FRAME_SCANNER_MARKER:
+            ret = scanner_parse_marker(scanner, &frame_done);
+            break;
+        case FRAME_SCANNER_SEGMENT:
+            ret = scanner_parse_segment(scanner);
+            break;
+        case FRAME_SCANNER_SEGMENT_DATA:
+            ret = scanner_parse_segment_data(scanner);
+            break;
+        }
+        if (ret) {
+            scanner->invalid = 1;
+            *bytes_used = pos;
+            return ret;
+        }
+        if (frame_done) {
+            *bytes_used = pos;
+            out_index->frame_size = scanner->frame_offset;
+            out_index->slices_num = scanner->slices_num;
+            out_index->slice_offsets = scanner->slice_offsets;
+            frame_scanner_reset(scanner);
+            return SvtJxsErrorNone;
+        }
+    }
+
+    *bytes_used = pos;
+    return SvtJxsErrorDecoderBitstreamTooShort;
+}
@@ -0,0 +1,55 @@
+/*
+* Copyright(c) 2024 Intel Corporation
+* SPDX - License - Identifier: BSD - 2 - Clause - Patent
+*/
+
+#ifndef _DECODER_FRAME_SCANNER_H_
+#define _DECODER_FRAME_SCANNER_H_
+
+#include "Definitions.h"
+#include "SvtJpegxsDec.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+#define FRAME_SCANNER_HEADER_MAX_BYTES (32)
+
+typedef enum frame_scanner_step {
+    FRAME_SCANNER_MARKER = 0,  /*Read 2 bytes of next marker*/
+    FRAME_SCANNER_SEGMENT,     /*Read marker and 2 bytes of marker segment size*/
+    FRAME_SCANNER_SEGMENT_DATA /*Read part of marker segment used by scanner: PIH, CDT, CWD, SLH or precinct header*/
+} frame_scanner_step_t;
+
+typedef struct frame_scanner {
+    frame_scanner_step_t step;
+    uint8_t header[FRAME_SCANNER_HEADER_MAX_BYTES]; /*Bytes of marker segment, can be collected from many chunks*/
+    uint32_t header_filled;
+    uint32_t header_needed;
+    uint32_t skip_bytes;   /*Bytes of current marker segment or precinct to skip without read*/
+    uint32_t frame_offset; /*Bytes of current frame already scanned*/
+    uint8_t invalid;       /*Set on invalid codestream, cleared only by reset*/
+
+    int32_t comps_num;
+    int32_t Sd;
+    int32_t decomp_h;
+    int32_t decomp_v;
+    uint32_t Sx[8];
+    uint32_t Sy[8];
+    int32_t bands_num_exists; /*Known after first slice header, -1 before*/
+    uint32_t precinct_header_bytes;
+
+    uint32_t slices_expected; /*Calculated from picture header*/
+    uint32_t slices_num;
+    uint32_t* slice_offsets;
+    uint32_t slice_offsets_size;
+} frame_scanner_t;
+
+void frame_scanner_reset(frame_scanner_t* scanner);
+SvtJxsErrorType_t frame_scanner_feed(frame_scanner_t* scanner, const uint8_t* chunk, size_t chunk_size, size_t* bytes_used,
+                                     svt_jpeg_xs_frame_index_t* out_index);
+
+#ifdef __cplusplus
+}
+#endif
+#endif /*_DECODER_FRAME_SCANNER_H_*/
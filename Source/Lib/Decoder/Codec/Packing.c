@@ -510,8 +510,36 @@ SvtJxsErrorType_t unpack_pred_zero_gclis_significance(bitstream_reader_t* bitstr
     return SvtJxsErrorNone;
 }
 
+/*Size of data sub-packet of band line calculated from GCLIs, used to skip data without unpack*/
+static uint32_t get_band_data_bits(const uint8_t* gclis, uint32_t gcli_w, int8_t gtli, uint8_t sign_flag) {
+    uint32_t bits = 0;
+    for (uint32_t group = 0; group < gcli_w; group++) {
+        int32_t bitplanes_size = gclis[group] - gtli;
+        if (bitplanes_size > 0) {
+            bits += 4 * (bitplanes_size + (sign_flag == 0));
+        }
+    }
+    return bits;
+}
+
+/*Return 1 when all bands of packet included in precinct are marked to skip*/
+static int8_t is_packet_skipped(const precinct_t* prec, const pi_t* pi, uint32_t packet_idx, const uint8_t* bands_skip) {
+    if (bands_skip == NULL) {
+        return 0;
+    }
+    for (uint32_t band_idx = pi->packets[packet_idx].band_start; band_idx < pi->packets[packet_idx].band_stop; band_idx++) {
+        const uint32_t b = pi->global_band_info[band_idx].band_id;
+        const uint32_t c = pi->global_band_info[band_idx].comp_id;
+        if (pi->packets[packet_idx].line_idx < prec->p_info->b_info[c][b].height && !bands_skip[band_idx]) {
+            return 0;
+        }
+    }
+    return 1;
+}
+
 SvtJxsErrorType_t unpack_precinct(bitstream_reader_t* bitstream, precinct_t* prec, precinct_t* prec_top, const pi_t* pi,
-                                  const picture_header_dynamic_t* picture_header_dynamic, uint32_t verbose) {
+                                  const picture_header_dynamic_t* picture_header_dynamic, const uint8_t* bands_skip,
+                                  uint32_t verbose) {
     uint32_t len_before_subpkt_bytes = 0;
     CodingModeFlag coding_modes[MAX_BANDS_NUM];
     uint32_t subpkt_len_bytes;
@@ -591,6 +619,38 @@ SvtJxsErrorType_t unpack_precinct(bitstream_reader_t* bitstream, precinct_t* pre
             return SvtJxsErrorDecoderInvalidBitstream;
         }
 
+        if (is_packet_skipped(prec, pi, packet_idx, bands_skip)) {
+            /*Skip whole packet, only size of significance sub-packet is not signaled in packet header*/
+            if (!pkt_header.raw_mode_flag) {
+                uint32_t significance_bits = 0;
+                for (uint32_t band_idx = pi->packets[packet_idx].band_start; band_idx < pi->packets[packet_idx].band_stop;
+                     band_idx++) {
+                    const uint32_t b = pi->global_band_info[band_idx].band_id;
+                    const uint32_t c = pi->global_band_info[band_idx].comp_id;
+                    if (pi->packets[packet_idx].line_idx < prec->p_info->b_info[c][b].height &&
+                        (coding_modes[band_idx] & CODING_MODE_FLAG_SIGNIFICANCE)) {
+                        significance_bits += prec->p_info->b_info[c][b].significance_width;
+                    }
+                }
+                significance_bits = BITS_TO_BYTE_WITH_ALIGN(significance_bits) * 8;
+                precinct_bits_left -= significance_bits;
+                if (precinct_bits_left < 0 || !bitstream_reader_is_enough_bytes(bitstream, significance_bits / 8)) {
+                    return SvtJxsErrorDecoderInvalidBitstream;
+                }
+                bitstream_reader_add_padding(bitstream, significance_bits / 8);
+            }
+            uint32_t skip_bytes = pkt_header.gcli_len + pkt_header.data_len;
+            if (picture_header_dynamic->hdr_Fs) {
+                skip_bytes += pkt_header.sign_len;
+            }
+            precinct_bits_left -= skip_bytes * 8;
+            if (precinct_bits_left < 0 || !bitstream_reader_is_enough_bytes(bitstream, skip_bytes)) {
+                return SvtJxsErrorDecoderInvalidBitstream;
+            }
+            bitstream_reader_add_padding(bitstream, skip_bytes);
+            continue;
+        }
+
         if (pkt_header.raw_mode_flag) {
             len_before_subpkt_bytes = (int)bitstream_reader_get_used_bytes(bitstream);
             /*************GCLI sub-packet BEGIN****************************/
@@ -751,7 +811,18 @@ SvtJxsErrorType_t unpack_precinct(bitstream_reader_t* bitstream, precinct_t* pre
             const uint32_t gcli_w = prec->p_info->b_info[c][b].gcli_width;
             const uint32_t ypos = pi->packets[packet_idx].line_idx;
             assert(ypos < MAX_BAND_LINES);
-            if (ypos < prec->p_info->b_info[c][b].height) {
+            if (ypos < prec->p_info->b_info[c][b].height && bands_skip && bands_skip[band_idx] &&
+                !picture_header_dynamic->hdr_Fs) {
+                /*Data of band is not used, sign sub-packet require unpacked data so skip only when signs are in data*/
+                const uint32_t skip_bits = get_band_data_bits(
+                    prec->bands[c][b].gcli_data + ypos * gcli_w, gcli_w, prec->bands[c][b].gtli, 0);
+                precinct_bits_left -= skip_bits;
+                if (precinct_bits_left < 0) {
+                    return SvtJxsErrorDecoderInvalidBitstream;
+                }
+                bitstream_reader_skip_bits(bitstream, skip_bits);
+            }
+            else if (ypos < prec->p_info->b_info[c][b].height) {
                 const int8_t gtli = prec->bands[c][b].gtli;
                 SvtJxsErrorType_t ret = unpack_data(bitstream,
                                                     prec->bands[c][b].coeff_data + ypos * pi->components[c].bands[b].width,
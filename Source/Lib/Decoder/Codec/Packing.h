@@ -14,7 +14,8 @@ extern "C" {
 #endif
 
 SvtJxsErrorType_t unpack_precinct(bitstream_reader_t* bitstream, precinct_t* prec, precinct_t* prec_top, const pi_t* pi,
-                                  const picture_header_dynamic_t* picture_header_dynamic, uint32_t verbose);
+                                  const picture_header_dynamic_t* picture_header_dynamic, const uint8_t* bands_skip,
+                                  uint32_t verbose);
 SvtJxsErrorType_t unpack_data_c(bitstream_reader_t* bitstream, uint16_t* buf, uint32_t w, uint8_t* gclis, uint32_t group_size,
                                 uint8_t gtli, uint8_t sign_flag, uint8_t* leftover_signs_num, int32_t* precinct_bits_left);
 int32_t unpack_sign(bitstream_reader_t* bitstream, uint16_t* buf, uint32_t w, uint32_t group_size, uint8_t leftover_signs_num,
@@ -13,8 +13,11 @@ void inv_sign_c(uint16_t* in_out, uint32_t width) {
     }
 }
 
-void inv_precinct_calculate_data(precinct_t* precinct, const pi_t* const pi, int dq_type) {
+void inv_precinct_calculate_data(precinct_t* precinct, const pi_t* const pi, int dq_type, const uint8_t* components_skip) {
     for (uint32_t c = 0; c < pi->comps_num; c++) {
+        if (components_skip[c]) {
+            continue;
+        }
         for (uint32_t b = 0; b < pi->components[c].bands_num; b++) {
             precinct_band_t* b_data = &precinct->bands[c][b];
             precinct_band_info_t* b_info = &precinct->p_info->b_info[c][b];
@@ -14,7 +14,7 @@ extern "C" {
 #endif
 
 void inv_sign_c(uint16_t* in_out, uint32_t width);
-void inv_precinct_calculate_data(precinct_t* precinct, const pi_t* const pi, int dq_type);
+void inv_precinct_calculate_data(precinct_t* precinct, const pi_t* const pi, int dq_type, const uint8_t* components_skip);
 
 #ifdef __cplusplus
 }
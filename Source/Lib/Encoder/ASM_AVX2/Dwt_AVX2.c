@@ -69,6 +69,79 @@ void dwt_horizontal_line_avx2(int32_t* out_lf, int32_t* out_hf, const int32_t* i
     }
 }
 
+/*Calculate (a + b) >> 1 without overflow of 16bit lanes on inverted inputs: ((a ^ 0x7FFF) and (b ^ 0x7FFF)).
+ *Inversion map signed value to unsigned and avg_epu16() round up, so floor of average is inverted result.*/
+static INLINE __m256i avg_floor_inv_epi16(__m256i a_inv, __m256i b_inv, __m256i inv) {
+    return _mm256_xor_si256(_mm256_avg_epu16(a_inv, b_inv), inv);
+}
+
+void dwt_horizontal_line_16bit_avx2(int16_t* out_lf, int16_t* out_hf, const int16_t* in, uint32_t len) {
+    if (len == 2) {
+        out_hf[0] = in[1] - in[0];
+        out_lf[0] = in[0] + (out_hf[0] >> 1) + (out_hf[0] & 1);
+        return;
+    }
+
+    out_hf[0] = in[1] - ((in[0] >> 1) + (in[2] >> 1) + (in[0] & in[2] & 1));
+    out_lf[0] = in[0] + (out_hf[0] >> 1) + (out_hf[0] & 1);
+
+    const uint32_t count = ((len - 1) / 2);
+    const uint32_t count_all = (count - 1) / 16;
+    const __m256i one = _mm256_set1_epi16(1);
+    const __m256i inv = _mm256_set1_epi16(0x7FFF);
+    const __m256i shuffle_even_odd = _mm256_setr_epi8(
+        0, 1, 4, 5, 8, 9, 12, 13, 2, 3, 6, 7, 10, 11, 14, 15, 0, 1, 4, 5, 8, 9, 12, 13, 2, 3, 6, 7, 10, 11, 14, 15);
+    __m256i hf_inv_prev = _mm256_set1_epi16(out_hf[0] ^ 0x7FFF);
+
+    for (uint32_t id = 1; id < count_all * 16; id += 16) {
+        __m256i in_A = _mm256_loadu_si256((__m256i*)(&in[id * 2]));      //0  1  2 ..15
+        __m256i in_B = _mm256_loadu_si256((__m256i*)(&in[id * 2 + 16])); //16 17 18 ..31
+        const __m256i in_next = _mm256_castsi128_si256(_mm_cvtsi32_si128(in[id * 2 + 32] ^ 0x7FFF));
+        /*Deinterleave even and odd samples*/
+        in_A = _mm256_permute4x64_epi64(_mm256_shuffle_epi8(in_A, shuffle_even_odd), 0xd8); //0  2 ..14  1  3 ..15
+        in_B = _mm256_permute4x64_epi64(_mm256_shuffle_epi8(in_B, shuffle_even_odd), 0xd8); //16 18 ..30 17 19 ..31
+        const __m256i in_0 = _mm256_permute2x128_si256(in_A, in_B, 0x20);                   //0  2  4 .. 30
+        const __m256i in_1 = _mm256_permute2x128_si256(in_A, in_B, 0x31);                   //1  3  5 .. 31
+
+        const __m256i in_0_inv = _mm256_xor_si256(in_0, inv);
+        const __m256i in_2_inv = _mm256_alignr_epi8(
+            _mm256_permute2x128_si256(in_0_inv, in_next, 0x21), in_0_inv, 2); //2  4  6 .. 32
+
+        const __m256i hf_out = _mm256_sub_epi16(in_1, avg_floor_inv_epi16(in_0_inv, in_2_inv, inv));
+        _mm256_storeu_si256((__m256i*)(out_hf + id), hf_out); //out_hf[id]
+
+        const __m256i hf_inv = _mm256_xor_si256(hf_out, inv);
+        const __m256i hf_m1_inv = _mm256_alignr_epi8(hf_inv, _mm256_permute2x128_si256(hf_inv_prev, hf_inv, 0x21), 14);
+        hf_inv_prev = hf_inv;
+
+        /*(hf_m1 + hf + 2) >> 2 == (((hf_m1 + hf) >> 1) + 1) >> 1*/
+        __m256i lf = avg_floor_inv_epi16(hf_m1_inv, hf_inv, inv);
+        lf = _mm256_srai_epi16(_mm256_add_epi16(lf, one), 1);
+        lf = _mm256_add_epi16(in_0, lf);
+        _mm256_storeu_si256((__m256i*)(out_lf + id), lf);
+    }
+
+    for (uint32_t id = count_all * 16 + 1; id < count; id++) {
+        const int16_t e0 = in[id * 2];
+        const int16_t e1 = in[id * 2 + 2];
+        out_hf[id] = in[id * 2 + 1] - ((e0 >> 1) + (e1 >> 1) + (e0 & e1 & 1));
+        const int16_t h0 = out_hf[id - 1];
+        const int16_t h1 = out_hf[id];
+        out_lf[id] = e0 + (h0 >> 2) + (h1 >> 2) + (((h0 & 3) + (h1 & 3) + 2) >> 2);
+    }
+
+    if (!(len & 1)) {
+        const int16_t h0 = out_hf[len / 2 - 2];
+        const int16_t h1 = in[len - 1] - in[len - 2];
+        out_hf[len / 2 - 1] = h1;
+        out_lf[len / 2 - 1] = in[len - 2] + (h0 >> 2) + (h1 >> 2) + (((h0 & 3) + (h1 & 3) + 2) >> 2);
+    }
+    else { //if (len & 1){
+        const int16_t h0 = out_hf[len / 2 - 1];
+        out_lf[len / 2] = in[len - 1] + (h0 >> 1) + (h0 & 1);
+    }
+}
+
 /*Optimization Vertical lines loops to AVX*/
 void transform_vertical_loop_hf_line_0_avx2(uint32_t width, int32_t* out_hf, const int32_t* line_0, const int32_t* line_1) {
     uint32_t i = 0;
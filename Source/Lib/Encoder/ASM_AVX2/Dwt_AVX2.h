@@ -13,6 +13,7 @@ extern "C" {
 #endif
 
 void dwt_horizontal_line_avx2(int32_t* out_lf, int32_t* out_hf, const int32_t* in, uint32_t len);
+void dwt_horizontal_line_16bit_avx2(int16_t* out_lf, int16_t* out_hf, const int16_t* in, uint32_t len);
 
 /*Optimization Vertical lines loops to AVX*/
 void transform_vertical_loop_hf_line_0_avx2(uint32_t width, int32_t* out_hf, const int32_t* line_0, const int32_t* line_1);
@@ -114,7 +114,7 @@ void linear_input_scaling_line_16bit_avx2(const uint16_t* src, int32_t* dst, uin
     const __m256i offset_avx2 = _mm256_set1_epi32(offset);
     const __m128i input_mask_epi16 = _mm_set1_epi16(input_mask);
     for (uint32_t i = 0; i < simd_batch; i++) {
-        __m256i reg = _mm256_cvtepi16_epi32(_mm_and_si128(_mm_loadu_si128((__m128i*)src), input_mask_epi16));
+        __m256i reg = _mm256_cvtepu16_epi32(_mm_and_si128(_mm_loadu_si128((__m128i*)src), input_mask_epi16));
         __m256i result = _mm256_sub_epi32(_mm256_slli_epi32(reg, shift), offset_avx2);
         _mm256_storeu_si256((__m256i*)dst, result);
         src += 8;
@@ -124,3 +124,83 @@ void linear_input_scaling_line_16bit_avx2(const uint16_t* src, int32_t* dst, uin
         dst[i] = ((src[i] & input_mask) << shift) - offset;
     }
 }
+
+void image_shift_from_16bit_avx2(uint16_t* out_coeff_16bit, const int16_t* in_coeff_16bit, uint32_t width, int32_t shift,
+                                 int32_t offset) {
+    const __m256i offset_avx2 = _mm256_set1_epi16((int16_t)offset);
+    const __m256i sign_mask_epi16 = _mm256_set1_epi16((int16_t)BITSTREAM_MASK_SIGN);
+    const __m256i zero = _mm256_setzero_si256();
+    const __m128i shift_sse = _mm_cvtsi32_si128(shift);
+
+    const uint32_t simd_batch = width / 16;
+    const uint32_t remaining = width % 16;
+
+    for (uint32_t i = 0; i < simd_batch; i++) {
+        __m256i data = _mm256_loadu_si256((__m256i*)(in_coeff_16bit));
+        __m256i sign = _mm256_and_si256(data, sign_mask_epi16);
+
+        data = _mm256_abs_epi16(data);
+        data = _mm256_add_epi16(data, offset_avx2);
+        data = _mm256_srl_epi16(data, shift_sse);
+        sign = _mm256_and_si256(sign, _mm256_cmpgt_epi16(data, zero));
+        data = _mm256_or_si256(data, sign);
+        _mm256_storeu_si256((__m256i*)out_coeff_16bit, data);
+
+        in_coeff_16bit += 16;
+        out_coeff_16bit += 16;
+    }
+
+    for (uint32_t i = 0; i < remaining; i++) {
+        int32_t val = in_coeff_16bit[i];
+        if (val >= 0) {
+            val = (val + offset) >> shift;
+        }
+        else {
+            val = ((-val + offset) >> shift);
+            if (val) {
+                val |= BITSTREAM_MASK_SIGN;
+            }
+        }
+        out_coeff_16bit[i] = val;
+    }
+}
+
+void linear_input_scaling_line_8bit_to_16bit_avx2(const uint8_t* src, int16_t* dst, uint32_t w, uint8_t shift, int16_t offset) {
+    const __m256i offset_avx2 = _mm256_set1_epi16(offset);
+    const __m128i shift_sse = _mm_cvtsi32_si128(shift);
+    const uint32_t simd_batch = w / 16;
+    const uint32_t remaining = w % 16;
+
+    for (uint32_t j = 0; j < simd_batch; j++) {
+        __m256i data = _mm256_cvtepu8_epi16(_mm_loadu_si128((const __m128i*)src));
+        data = _mm256_sub_epi16(_mm256_sll_epi16(data, shift_sse), offset_avx2);
+        _mm256_storeu_si256((__m256i*)dst, data);
+
+        src += 16;
+        dst += 16;
+    }
+    for (uint32_t j = 0; j < remaining; j++) {
+        dst[j] = (int16_t)((src[j] << shift) - offset);
+    }
+}
+
+void linear_input_scaling_line_16bit_to_16bit_avx2(const uint16_t* src, int16_t* dst, uint32_t w, uint8_t shift, int16_t offset,
+                                                   uint8_t bit_depth) {
+    const uint16_t input_mask = (1 << bit_depth) - 1;
+    const __m256i offset_avx2 = _mm256_set1_epi16(offset);
+    const __m256i input_mask_epi16 = _mm256_set1_epi16(input_mask);
+    const __m128i shift_sse = _mm_cvtsi32_si128(shift);
+    const uint32_t simd_batch = w / 16;
+    const uint32_t remaining = w % 16;
+
+    for (uint32_t i = 0; i < simd_batch; i++) {
+        __m256i data = _mm256_and_si256(_mm256_loadu_si256((__m256i*)src), input_mask_epi16);
+        data = _mm256_sub_epi16(_mm256_sll_epi16(data, shift_sse), offset_avx2);
+        _mm256_storeu_si256((__m256i*)dst, data);
+        src += 16;
+        dst += 16;
+    }
+    for (uint32_t i = 0; i < remaining; i++) {
+        dst[i] = (int16_t)(((src[i] & input_mask) << shift) - offset);
+    }
+}
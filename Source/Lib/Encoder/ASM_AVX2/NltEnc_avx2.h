@@ -16,6 +16,11 @@ void image_shift_avx2(uint16_t* out_coeff_16bit, int32_t* in_coeff_32bit, uint32
 void linear_input_scaling_line_8bit_avx2(const uint8_t* src, int32_t* dst, uint32_t w, uint8_t shift, int32_t offset);
 void linear_input_scaling_line_16bit_avx2(const uint16_t* src, int32_t* dst, uint32_t w, uint8_t shift, int32_t offset,
                                           uint8_t bit_depth);
+void image_shift_from_16bit_avx2(uint16_t* out_coeff_16bit, const int16_t* in_coeff_16bit, uint32_t width, int32_t shift,
+                                 int32_t offset);
+void linear_input_scaling_line_8bit_to_16bit_avx2(const uint8_t* src, int16_t* dst, uint32_t w, uint8_t shift, int16_t offset);
+void linear_input_scaling_line_16bit_to_16bit_avx2(const uint16_t* src, int16_t* dst, uint32_t w, uint8_t shift, int16_t offset,
+                                                   uint8_t bit_depth);
 
 #ifdef __cplusplus
 }
@@ -229,7 +229,7 @@ void linear_input_scaling_line_16bit_avx512(const uint16_t* src, int32_t* dst, u
     __m512i reg_offset = _mm512_set1_epi32(offset);
     __m256i input_mask_epi16 = _mm256_set1_epi16(input_mask);
     for (int i = 0; i < simd_batch; i++) {
-        __m512i reg = _mm512_cvtepi16_epi32(_mm256_and_si256(_mm256_loadu_si256((__m256i*)src), input_mask_epi16));
+        __m512i reg = _mm512_cvtepu16_epi32(_mm256_and_si256(_mm256_loadu_si256((__m256i*)src), input_mask_epi16));
         __m512i result = _mm512_sub_epi32(_mm512_slli_epi32(reg, shift), reg_offset);
         _mm512_storeu_si512(dst, result);
         src += 16;
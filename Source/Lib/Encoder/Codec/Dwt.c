@@ -39,6 +39,64 @@ void dwt_horizontal_line_c(int32_t* out_lf, int32_t* out_hf, const int32_t* in,
     }
 }
 
+/* Cacluate Horizontal DWT for one line on 16bit values, result is the same as dwt_horizontal_line_c() when it fit in int16_t.
+ * Sums are split to not overflow 16bit lanes: (a + b) >> 1 == (a >> 1) + (b >> 1) + (a & b & 1)
+ */
+void dwt_horizontal_line_16bit_c(int16_t* out_lf, int16_t* out_hf, const int16_t* in, uint32_t len) {
+    assert((len >= 2) && "[dwt_horizontal_line_16bit_c()] ERROR: Length is too small!");
+
+    if (len == 2) {
+        out_hf[0] = in[1] - in[0];
+        out_lf[0] = in[0] + (out_hf[0] >> 1) + (out_hf[0] & 1);
+        return;
+    }
+
+    out_hf[0] = in[1] - ((in[0] >> 1) + (in[2] >> 1) + (in[0] & in[2] & 1));
+    out_lf[0] = in[0] + (out_hf[0] >> 1) + (out_hf[0] & 1);
+
+    const uint32_t count = ((len - 1) / 2);
+    for (uint32_t id = 1; id < count; id++) {
+        const int16_t e0 = in[id * 2];
+        const int16_t e1 = in[id * 2 + 2];
+        out_hf[id] = in[id * 2 + 1] - ((e0 >> 1) + (e1 >> 1) + (e0 & e1 & 1));
+        const int16_t h0 = out_hf[id - 1];
+        const int16_t h1 = out_hf[id];
+        out_lf[id] = e0 + (h0 >> 2) + (h1 >> 2) + (((h0 & 3) + (h1 & 3) + 2) >> 2);
+    }
+
+    if (!(len & 1)) {
+        const int16_t h0 = out_hf[len / 2 - 2];
+        const int16_t h1 = in[len - 1] - in[len - 2];
+        out_hf[len / 2 - 1] = h1;
+        out_lf[len / 2 - 1] = in[len - 2] + (h0 >> 2) + (h1 >> 2) + (((h0 & 3) + (h1 & 3) + 2) >> 2);
+    }
+    else { //if (len & 1){
+        const int16_t h0 = out_hf[len / 2 - 1];
+        out_lf[len / 2] = in[len - 1] + (h0 >> 1) + (h0 & 1);
+    }
+}
+
+/* DWT on 16bit lanes give the same coefficients as 32bit DWT when:
+ * - input is linear scaled, so the lowest (Bw - DWT_16BIT_INPUT_BITS) bits are zero and can be skipped,
+ * - no bits are lost by shifts of lifting: every level need 3 bits more below input bit depth,
+ * - values fit in int16_t: range increase less than 4 times for all levels.
+ * Only components without vertical decomposition (decom_v == 0) can use it. Vertical lifting is the same
+ * 5/3 step, so it need the same 3 bits for each vertical level too: (input_bit_depth + 3 * (decom_h + decom_v)).
+ * For 8bit input only V1 H1 fit in that limit and default V1/V2 with H5 need 26 or 29 bits, so vertical
+ * transforms stay on 32bit lanes to keep the output bit exact.
+ * Kernels are C and AVX2 only, AVX512 use AVX2 version.
+ */
+uint8_t dwt_16bit_supported(uint8_t input_bit_depth, uint8_t decom_h, const picture_header_dynamic_t* hdr) {
+    if (input_bit_depth == 0 || hdr->hdr_Tnlt != 0 || hdr->hdr_Bw < DWT_16BIT_INPUT_BITS) {
+        return 0;
+    }
+    /*Output shift have to round at least one bit*/
+    if (hdr->hdr_Fq <= hdr->hdr_Bw - DWT_16BIT_INPUT_BITS) {
+        return 0;
+    }
+    return (input_bit_depth + 3 * decom_h) <= DWT_16BIT_INPUT_BITS;
+}
+
 transform_V0_ptr_t transform_V0_get_function_ptr(uint8_t decom_h) {
     transform_V0_ptr_t ptrs[] = {NULL, transform_V0_H1, transform_V0_H2, transform_V0_H3, transform_V0_H4, transform_V0_H5};
     if (decom_h < sizeof(ptrs) / sizeof(ptrs[0])) {
@@ -130,6 +188,37 @@ void transform_V0_H2(const pi_component_t* const component, const pi_enc_compone
     }
 }
 
+/*DWT Calculate Precinct 1 lines for Vertical 0 Horizontal X on 16bit lanes, see dwt_16bit_supported().
+ * Parameters the same as transform_V0_H1(), input conversion is required (input_bit_depth != 0).
+ */
+void transform_V0_Hx_16bit(const pi_component_t* const component, const pi_enc_component_t* const component_enc,
+                           const int32_t* buff_in, uint8_t input_bit_depth, picture_header_dynamic_t* picture_hdr,
+                           uint16_t* buffer_out_16bit, uint8_t param_out_Fq, uint32_t width, int32_t* buffer_tmp) {
+    assert(input_bit_depth != 0);
+    assert(component_enc->bands[0].coeff_buff_tmp_pos_offset_16bit == 0);
+    //buffer_tmp 1 line size 3*width/2 of int32_t, fit 3 * width of int16_t
+    int16_t* line = (int16_t*)buffer_tmp;
+    int16_t* out16_bit = line + width;
+
+    /*Coefficients are scaled by (1 << (Bw - DWT_16BIT_INPUT_BITS)) less than in 32bit DWT*/
+    int32_t shift_out = param_out_Fq - (picture_hdr->hdr_Bw - DWT_16BIT_INPUT_BITS);
+    int32_t offset_out = 1 << (shift_out - 1);
+
+    nlt_input_scaling_line_to_16bit(buff_in, line, width, picture_hdr, input_bit_depth);
+    uint32_t len = width;
+    for (uint32_t band = component->decom_h; band > 0; band--) {
+        dwt_horizontal_line_16bit(line, out16_bit, line, len);
+        image_shift_from_16bit(buffer_out_16bit + component_enc->bands[band].coeff_buff_tmp_pos_offset_16bit,
+                               out16_bit,
+                               component->bands[band].width,
+                               shift_out,
+                               offset_out);
+        len -= component->bands[band].width;
+    }
+    assert(len == component->bands[0].width);
+    image_shift_from_16bit(buffer_out_16bit, line, len, shift_out, offset_out);
+}
+
 void transform_V0_H3(const pi_component_t* const component, const pi_enc_component_t* const component_enc, const int32_t* buff_in,
                      uint8_t input_bit_depth, picture_header_dynamic_t* picture_hdr, uint16_t* buffer_out_16bit,
                      uint8_t param_out_Fq, uint32_t width, int32_t* buffer_tmp) {
@@ -15,6 +15,8 @@ extern "C" {
 #endif
 
 void dwt_horizontal_line_c(int32_t* out_lf, int32_t* out_hf, const int32_t* in, uint32_t len);
+void dwt_horizontal_line_16bit_c(int16_t* out_lf, int16_t* out_hf, const int16_t* in, uint32_t len);
+uint8_t dwt_16bit_supported(uint8_t input_bit_depth, uint8_t decom_h, const picture_header_dynamic_t* hdr);
 
 /*DWT transform_V0_H[1,2,3,4,5]() calculate precinct with 1 line.
 * When (input_bit_depth == 0) do not convert input.
@@ -46,6 +48,10 @@ void transform_V0_H5(const pi_component_t* const component, const pi_enc_compone
                      uint8_t input_bit_depth, picture_header_dynamic_t* picture_hdr, uint16_t* buffer_out_16bit,
                      uint8_t param_out_Fq, uint32_t width, int32_t* buffer_tmp);
 
+void transform_V0_Hx_16bit(const pi_component_t* const component, const pi_enc_component_t* const component_enc,
+                           const int32_t* buff_in, uint8_t input_bit_depth, picture_header_dynamic_t* picture_hdr,
+                           uint16_t* buffer_out_16bit, uint8_t param_out_Fq, uint32_t width, int32_t* buffer_tmp);
+
 void transform_V1_Hx_precinct_recalc_HF_prev_c(uint32_t width, int32_t* out_tmp_line_HF_next, const int32_t* line_0,
                                                const int32_t* line_1, const int32_t* line_2);
 
@@ -36,27 +36,10 @@ static void dwt_stage_context_dctor(void_ptr p) {
     }
 }
 
-/************************************************
- * dwt Context Constructor
- ************************************************/
-SvtJxsErrorType_t dwt_stage_context_ctor(ThreadContext_t* thread_context_ptr, svt_jpeg_xs_encoder_api_prv_t* enc_api_prv,
-                                         int idx) {
-    svt_jpeg_xs_encoder_common_t* enc_common = &enc_api_prv->enc_common;
-    DwtStageContext_t* context_ptr;
-    SVT_CALLOC_ARRAY(context_ptr, 1);
-    thread_context_ptr->priv = context_ptr;
-    thread_context_ptr->dctor = dwt_stage_context_dctor;
-
-    context_ptr->dwt_stage_input_fifo_ptr = svt_jxs_system_resource_get_consumer_fifo(enc_api_prv->dwt_input_resource_ptr, idx);
-
-    context_ptr->process_idx = idx;
-
-    context_ptr->enc_common = enc_common;
-    pi_t* pi = &enc_common->pi;
-
-    size_t buffers_tmp_size = 0;
+/*Size in samples of temporary buffer of DWT context, 0 when not used*/
+static size_t dwt_stage_buffers_tmp_size(const pi_t* pi) {
     /*if (enc_common->cpu_profile == CPU_PROFILE_LOW_CPU && pi->decom_v == 0) {
-        buffers_tmp_size = (size_t)picture_info_ptr->input_luma_width * 3 / 2;
+        return (size_t)picture_info_ptr->input_luma_width * 3 / 2;
     }*/
     if (pi->decom_v == 1) {
         /*Allocate buffer for V1:
@@ -66,7 +49,7 @@ SvtJxsErrorType_t dwt_stage_context_ctor(ThreadContext_t* thread_context_ptr, sv
          *2.5 temp for Vertical and Horizontal temp
          *Summary: 7.5 line == 15/2*width
          */
-        buffers_tmp_size = (size_t)pi->width * 15 / 2;
+        return (size_t)pi->width * 15 / 2;
     }
     else if (pi->decom_v == 2) {
         /*Allocate 2 buffers for biggest component size.
@@ -76,11 +59,39 @@ SvtJxsErrorType_t dwt_stage_context_ctor(ThreadContext_t* thread_context_ptr, sv
          buffers_tmp = Size: 5 * plane_width + (5 * plane_width + 1) + 3 * plane_width / 2 + plane_width + 1 + width + 1;
           buffers_tmp = Size: 27 * plane_width /2 +  3;*/
         //TODO: For some configurations V and H second buffer can be smaller
-        buffers_tmp_size = (size_t)pi->width * 27 / 2 + 3;
+        return (size_t)pi->width * 27 / 2 + 3;
     }
 
+    return 0;
+}
+
+void dwt_stage_context_memory(SvtMemSize_t* mem, const svt_jpeg_xs_encoder_common_t* enc_common) {
+    svt_jxs_mem_size_add(mem, sizeof(DwtStageContext_t), SVT_JXS_MEM_GENERAL);
+    svt_jxs_mem_size_add(mem, sizeof(int32_t) * dwt_stage_buffers_tmp_size(&enc_common->pi), SVT_JXS_MEM_SCRATCH);
+}
+
+/************************************************
+ * dwt Context Constructor
+ ************************************************/
+SvtJxsErrorType_t dwt_stage_context_ctor(ThreadContext_t* thread_context_ptr, svt_jpeg_xs_encoder_api_prv_t* enc_api_prv,
+                                         int idx) {
+    svt_jpeg_xs_encoder_common_t* enc_common = &enc_api_prv->enc_common;
+    DwtStageContext_t* context_ptr;
+    SVT_CALLOC_ARRAY(context_ptr, 1);
+    thread_context_ptr->priv = context_ptr;
+    thread_context_ptr->dctor = dwt_stage_context_dctor;
+
+    context_ptr->dwt_stage_input_fifo_ptr = svt_jxs_system_resource_get_consumer_fifo(enc_api_prv->dwt_input_resource_ptr, idx);
+
+    context_ptr->process_idx = idx;
+
+    context_ptr->enc_common = enc_common;
+    pi_t* pi = &enc_common->pi;
+
+    size_t buffers_tmp_size = dwt_stage_buffers_tmp_size(pi);
     if (buffers_tmp_size > 0) {
-        SVT_MALLOC_ALIGNED_ARRAY(context_ptr->buffers_tmp, buffers_tmp_size);
+        SVT_MALLOC_ALIGNED_PURPOSE(
+            context_ptr->buffers_tmp, sizeof(*context_ptr->buffers_tmp) * buffers_tmp_size, SVT_JXS_MEM_SCRATCH);
     }
     else {
         context_ptr->buffers_tmp = NULL;
@@ -89,6 +100,21 @@ SvtJxsErrorType_t dwt_stage_context_ctor(ThreadContext_t* thread_context_ptr, sv
     return SvtJxsErrorNone;
 }
 
+/*Release slice to pack stage and return next slice in frame.
+ *Statistics are stored before last slice of component is released, after that PCS can be finished by final stage.*/
+static volatile PackInput_t* dwt_release_slice(volatile PackInput_t* slice, uint32_t component_id, PictureControlSet* pcs_ptr,
+                                               uint64_t stats_time_begin_us) {
+    volatile PackInput_t* slice_next = slice->sync_dwt_list_next;
+    Handle_t sync_dwt_semaphore = slice->sync_dwt_semaphore;
+    if (stats_time_begin_us && slice_next == NULL) {
+        pcs_ptr->stats_dwt_time_us[component_id] = svt_jxs_get_time_us() - stats_time_begin_us;
+    }
+    //After set flag list item can be not longer actual for last component. First get next item
+    slice->sync_dwt_component_done_flag[component_id] = 1;
+    svt_jxs_post_semaphore(sync_dwt_semaphore);
+    return slice_next;
+}
+
 /************************************************
  * dwt transformation Kernel
  *************************************************/
@@ -109,6 +135,7 @@ void* dwt_stage_kernel(void* input_ptr) {
 
         PictureControlSet* pcs_ptr = (PictureControlSet*)in_pcs_wrapper_ptr->object_ptr;
         svt_jpeg_xs_encoder_common_t* enc_common = pcs_ptr->enc_common;
+        uint64_t stats_time_begin_us = enc_common->stats_enable ? svt_jxs_get_time_us() : 0;
         const pi_t* const pi = &enc_common->pi;
 
         uint16_t* buffer_out_16bit = pcs_ptr->coeff_buff_ptr_16bit[component_id];
@@ -224,22 +251,12 @@ void* dwt_stage_kernel(void* input_ptr) {
 
                 //Send sync after finish Slice
                 if (line_idx && (((line_idx + 2) % slice_height) == 0)) {
-                    volatile PackInput_t* list_slice_next_old = list_slice_next;
-                    list_slice_next = list_slice_next->sync_dwt_list_next;
-                    Handle_t sync_dwt_semaphore = list_slice_next_old->sync_dwt_semaphore;
-                    //After set flag list item can be not longer actual for last component. First get next item
-                    list_slice_next_old->sync_dwt_component_done_flag[component_id] = 1;
-                    svt_jxs_post_semaphore(sync_dwt_semaphore);
+                    list_slice_next = dwt_release_slice(list_slice_next, component_id, pcs_ptr, stats_time_begin_us);
                 }
             }
             //Send sync after finish last Slice
             if (list_slice_next) {
-                volatile PackInput_t* list_slice_next_old = list_slice_next;
-                list_slice_next = list_slice_next->sync_dwt_list_next;
-                Handle_t sync_dwt_semaphore = list_slice_next_old->sync_dwt_semaphore;
-                //After set flag list item can be not longer actual for last component. First get next item
-                list_slice_next_old->sync_dwt_component_done_flag[component_id] = 1;
-                svt_jxs_post_semaphore(sync_dwt_semaphore);
+                list_slice_next = dwt_release_slice(list_slice_next, component_id, pcs_ptr, stats_time_begin_us);
             }
             assert(list_slice_next == NULL);
             continue;
@@ -343,22 +360,12 @@ void* dwt_stage_kernel(void* input_ptr) {
 
             //Send sync after finish Slice
             if (line_idx && (((line_idx + 4) % slice_height) == 0)) {
-                volatile PackInput_t* list_slice_next_old = list_slice_next;
-                list_slice_next = list_slice_next->sync_dwt_list_next;
-                Handle_t sync_dwt_semaphore = list_slice_next_old->sync_dwt_semaphore;
-                //After set flag list item can be not longer actual for last component. First get next item
-                list_slice_next_old->sync_dwt_component_done_flag[component_id] = 1;
-                svt_jxs_post_semaphore(sync_dwt_semaphore);
+                list_slice_next = dwt_release_slice(list_slice_next, component_id, pcs_ptr, stats_time_begin_us);
             }
         }
         //Send sync after finish last Slice
         if (list_slice_next) {
-            volatile PackInput_t* list_slice_next_old = list_slice_next;
-            list_slice_next = list_slice_next->sync_dwt_list_next;
-            Handle_t sync_dwt_semaphore = list_slice_next_old->sync_dwt_semaphore;
-            //After set flag list item can be not longer actual for last component. First get next item
-            list_slice_next_old->sync_dwt_component_done_flag[component_id] = 1;
-            svt_jxs_post_semaphore(sync_dwt_semaphore);
+            list_slice_next = dwt_release_slice(list_slice_next, component_id, pcs_ptr, stats_time_begin_us);
         }
         assert(list_slice_next == NULL);
     }
@@ -18,6 +18,8 @@ extern "C" {
  ***************************************/
 SvtJxsErrorType_t dwt_stage_context_ctor(ThreadContext_t *thread_context_ptr, svt_jpeg_xs_encoder_api_prv_t *enc_api_prv,
                                          int idx);
+/*Memory allocated by dwt_stage_context_ctor()*/
+void dwt_stage_context_memory(SvtMemSize_t *mem, const svt_jpeg_xs_encoder_common_t *enc_common);
 
 extern void *dwt_stage_kernel(void *input_ptr);
 
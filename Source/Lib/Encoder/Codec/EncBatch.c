@@ -0,0 +1,185 @@
+/*
+* Copyright(c) 2024 Intel Corporation
+* SPDX - License - Identifier: BSD - 2 - Clause - Patent
+*/
+
+#include "EncBatch.h"
+#include "EncHandle.h"
+#include "PackIn.h"
+#include "PackStageProcess.h"
+#include "PictureControlSet.h"
+#include "Threads/SvtObject.h"
+
+static const svt_jpeg_xs_encoder_common_t* enc_batch_task_encoder(const ObjectWrapper_t* wrapper_ptr) {
+    const PackInput_t* pack_input = (const PackInput_t*)wrapper_ptr->object_ptr;
+    return ((const PictureControlSet*)pack_input->pcs_wrapper_ptr->object_ptr)->enc_common;
+}
+
+/*Get next task of any encoder [BLOCKING], NULL when batch is closed*/
+static ObjectWrapper_t* enc_batch_pop(EncBatch_t* batch, uint32_t thread_idx) {
+    for (;;) {
+        svt_jxs_block_on_semaphore(batch->queue_semaphore);
+        svt_jxs_block_on_mutex(batch->queue_mutex);
+        if (batch->quit) {
+            svt_jxs_release_mutex(batch->queue_mutex);
+            return NULL;
+        }
+        ObjectWrapper_t* wrapper_ptr = batch->queue_head;
+        if (wrapper_ptr) {
+            batch->queue_head = wrapper_ptr->next_ptr;
+            if (batch->queue_head == NULL) {
+                batch->queue_tail = NULL;
+            }
+            wrapper_ptr->next_ptr = NULL;
+            batch->thread_encoder[thread_idx] = enc_batch_task_encoder(wrapper_ptr);
+        }
+        svt_jxs_release_mutex(batch->queue_mutex);
+        if (wrapper_ptr) {
+            return wrapper_ptr;
+        }
+        /*Task was dropped by detach of encoder*/
+    }
+}
+
+/*Return task not calculated to pools of encoder, slot of slice split to parts is released by last part*/
+static void enc_batch_release_task(ObjectWrapper_t* wrapper_ptr) {
+    PackInput_t* pack_input = (PackInput_t*)wrapper_ptr->object_ptr;
+    if (pack_input->slice_slot_wrapper_ptr) {
+        PackSliceSlot_t* slot = (PackSliceSlot_t*)pack_input->slice_slot_wrapper_ptr->object_ptr;
+        if (SVT_ATOMIC_SUB32(&slot->parts_left, 1) == 0) {
+            svt_jxs_release_object(pack_input->slice_slot_wrapper_ptr);
+        }
+    }
+    svt_jxs_release_object(wrapper_ptr);
+}
+
+static void* enc_batch_kernel(void* input_ptr) {
+    EncBatchThread_t* thread = (EncBatchThread_t*)input_ptr;
+    EncBatch_t* batch = thread->batch;
+    ObjectWrapper_t* input_wrapper_ptr;
+
+    while ((input_wrapper_ptr = enc_batch_pop(batch, thread->idx)) != NULL) {
+        /*Pack context of encoder for this thread, encoder is not released until task is done*/
+        const svt_jpeg_xs_encoder_common_t* enc_common = batch->thread_encoder[thread->idx];
+        if (SVT_ATOMIC_LOAD32(&enc_common->batch_closing)) {
+            /*Encoder is closed, its final stage does not take pack outputs any more*/
+            enc_batch_release_task(input_wrapper_ptr);
+        }
+        else {
+            pack_stage_process_input(enc_common->batch_pack_contexts[thread->idx], input_wrapper_ptr);
+        }
+
+        svt_jxs_block_on_mutex(batch->queue_mutex);
+        batch->thread_encoder[thread->idx] = NULL;
+        batch->tasks_done_num = (batch->tasks_done_num + 1) & INT32_MAX;
+        svt_jxs_set_cond_var(&batch->tasks_done, (int32_t)batch->tasks_done_num);
+        svt_jxs_release_mutex(batch->queue_mutex);
+    }
+    return NULL;
+}
+
+static void enc_batch_dctor(void_ptr p) {
+    EncBatch_t* batch = (EncBatch_t*)p;
+    if (batch->thread_handle_array) {
+        svt_jxs_block_on_mutex(batch->queue_mutex);
+        batch->quit = 1;
+        svt_jxs_release_mutex(batch->queue_mutex);
+        for (uint32_t i = 0; i < batch->threads_num; i++) {
+            svt_jxs_post_semaphore(batch->queue_semaphore);
+        }
+        SVT_DESTROY_THREAD_ARRAY(batch->thread_handle_array, batch->threads_num);
+    }
+    SVT_FREE(batch->threads);
+    SVT_FREE(batch->thread_encoder);
+    svt_jxs_free_cond_var(&batch->tasks_done);
+    SVT_DESTROY_SEMAPHORE(batch->queue_semaphore);
+    SVT_DESTROY_MUTEX(batch->queue_mutex);
+}
+
+SvtJxsErrorType_t enc_batch_ctor(EncBatch_t* batch, uint32_t threads_num) {
+    batch->dctor = enc_batch_dctor;
+    batch->threads_num = MAX(1, threads_num);
+
+    SVT_CREATE_MUTEX(batch->queue_mutex);
+    SVT_CREATE_SEMAPHORE(batch->queue_semaphore, 0, INT32_MAX);
+    SvtJxsErrorType_t ret = svt_jxs_create_cond_var(&batch->tasks_done);
+    if (ret) {
+        return ret;
+    }
+    SVT_CALLOC_ARRAY(batch->thread_encoder, batch->threads_num);
+    SVT_CALLOC_ARRAY(batch->threads, batch->threads_num);
+    for (uint32_t i = 0; i < batch->threads_num; i++) {
+        batch->threads[i].batch = batch;
+        batch->threads[i].idx = i;
+    }
+
+    SVT_ALLOC_PTR_ARRAY(batch->thread_handle_array, batch->threads_num);
+    for (uint32_t i = 0; i < batch->threads_num; i++) {
+        SVT_CREATE_THREAD(batch->thread_handle_array[i], enc_batch_kernel, &batch->threads[i]);
+    }
+    return SvtJxsErrorNone;
+}
+
+void enc_batch_attach(EncBatch_t* batch) {
+    svt_jxs_block_on_mutex(batch->queue_mutex);
+    batch->encoders_num++;
+    svt_jxs_release_mutex(batch->queue_mutex);
+}
+
+void enc_batch_detach(EncBatch_t* batch, const svt_jpeg_xs_encoder_common_t* enc_common) {
+    ObjectWrapper_t* dropped_head = NULL;
+    svt_jxs_block_on_mutex(batch->queue_mutex);
+    ObjectWrapper_t** link = &batch->queue_head;
+    batch->queue_tail = NULL;
+    while (*link) {
+        if (enc_batch_task_encoder(*link) == enc_common) {
+            ObjectWrapper_t* dropped = *link;
+            *link = dropped->next_ptr;
+            dropped->next_ptr = dropped_head;
+            dropped_head = dropped;
+        }
+        else {
+            batch->queue_tail = *link;
+            link = &(*link)->next_ptr;
+        }
+    }
+    batch->encoders_num--;
+
+    for (;;) {
+        uint8_t in_progress = 0;
+        for (uint32_t i = 0; i < batch->threads_num; i++) {
+            if (batch->thread_encoder[i] == enc_common) {
+                in_progress = 1;
+            }
+        }
+        if (!in_progress) {
+            break;
+        }
+        int32_t tasks_done_num = (int32_t)batch->tasks_done_num;
+        svt_jxs_release_mutex(batch->queue_mutex);
+        svt_jxs_wait_cond_var(&batch->tasks_done, tasks_done_num);
+        svt_jxs_block_on_mutex(batch->queue_mutex);
+    }
+    svt_jxs_release_mutex(batch->queue_mutex);
+
+    while (dropped_head) {
+        ObjectWrapper_t* next = dropped_head->next_ptr;
+        dropped_head->next_ptr = NULL;
+        enc_batch_release_task(dropped_head);
+        dropped_head = next;
+    }
+}
+
+void enc_batch_post(EncBatch_t* batch, ObjectWrapper_t* pack_input_wrapper_ptr) {
+    pack_input_wrapper_ptr->next_ptr = NULL;
+    svt_jxs_block_on_mutex(batch->queue_mutex);
+    if (batch->queue_tail) {
+        batch->queue_tail->next_ptr = pack_input_wrapper_ptr;
+    }
+    else {
+        batch->queue_head = pack_input_wrapper_ptr;
+    }
+    batch->queue_tail = pack_input_wrapper_ptr;
+    svt_jxs_release_mutex(batch->queue_mutex);
+    svt_jxs_post_semaphore(batch->queue_semaphore);
+}
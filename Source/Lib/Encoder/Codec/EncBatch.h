@@ -0,0 +1,54 @@
+/*
+* Copyright(c) 2024 Intel Corporation
+* SPDX - License - Identifier: BSD - 2 - Clause - Patent
+*/
+
+#ifndef _ENCODER_BATCH_H_
+#define _ENCODER_BATCH_H_
+
+#include "Definitions.h"
+#include "Encoder.h"
+#include "Threads/SystemResourceManager.h"
+#include "Threads/SvtThreads.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+typedef struct EncBatchThread {
+    struct EncBatch* batch;
+    uint32_t idx;
+} EncBatchThread_t;
+
+/*Slice threads shared by many encoders, pack tasks of all attached encoders are calculated in order of post.*/
+typedef struct EncBatch {
+    DctorCall dctor;
+    uint32_t threads_num;
+    Handle_t* thread_handle_array;
+    EncBatchThread_t* threads;
+
+    Handle_t queue_mutex;
+    Handle_t queue_semaphore;    /*Posted for every task in queue and for every thread on close*/
+    ObjectWrapper_t* queue_head; /*Pack inputs of all encoders, linked by next_ptr*/
+    ObjectWrapper_t* queue_tail;
+    uint8_t quit;
+
+    /*Protected by queue_mutex*/
+    const svt_jpeg_xs_encoder_common_t** thread_encoder; /*Encoder of task in progress on thread, NULL when thread wait*/
+    uint32_t encoders_num;
+    uint32_t tasks_done_num;
+    CondVar tasks_done; /*Set to tasks_done_num after every task, to wait for tasks of encoder in progress*/
+} EncBatch_t;
+
+SvtJxsErrorType_t enc_batch_ctor(EncBatch_t* batch, uint32_t threads_num);
+
+void enc_batch_attach(EncBatch_t* batch);
+/*Drop tasks of encoder not started yet and return them to pools of encoder,
+ *wait for tasks of encoder in progress, before encoder is released*/
+void enc_batch_detach(EncBatch_t* batch, const svt_jpeg_xs_encoder_common_t* enc_common);
+void enc_batch_post(EncBatch_t* batch, ObjectWrapper_t* pack_input_wrapper_ptr);
+
+#ifdef __cplusplus
+}
+#endif
+#endif /*_ENCODER_BATCH_H_*/
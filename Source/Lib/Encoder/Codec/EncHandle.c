@@ -8,15 +8,20 @@
 #include <stdio.h>
 #include <inttypes.h>
 
+#include "Dwt.h"
+#include "EncBatch.h"
 #include "DwtInput.h"
 #include "DwtStageProcess.h"
 #include "FinalStageProcess.h"
 #include "InitStageProcess.h"
+#include "PackIn.h"
 #include "PackOut.h"
+#include "PictureControlSet.h"
 #include "PackStageProcess.h"
 #include "WeightTable.h"
 #include "encoder_dsp_rtcd.h"
 #include "SvtLog.h"
+#include "SvtUtility.h"
 #include "Codestream.h"
 #include "EncDec.h"
 
@@ -29,6 +34,11 @@ static void svt_enc_handle_dctor(void_ptr p) {
 
     // Init Stage
     SVT_DESTROY_THREAD(enc_api_prv->init_stage_thread_handle);
+    /*No more tasks are posted to batch, drop queued tasks of encoder and wait for tasks in progress
+     *before pools used by them are released*/
+    if (enc_common->batch) {
+        enc_batch_detach(enc_common->batch, enc_common);
+    }
 
     if (enc_common->cpu_profile == CPU_PROFILE_CPU) {
         // dwt Stage
@@ -44,18 +54,19 @@ static void svt_enc_handle_dctor(void_ptr p) {
     SVT_DELETE(enc_api_prv->output_queue_resource_ptr);
     SVT_DELETE(enc_api_prv->pack_input_resource_ptr);
     SVT_DELETE(enc_api_prv->pack_output_resource_ptr);
+    SVT_DELETE(enc_api_prv->pack_slice_slot_resource_ptr);
     SVT_DELETE(enc_api_prv->init_stage_context_ptr);
     SVT_DELETE(enc_api_prv->final_stage_context_ptr);
     if (enc_common->cpu_profile == CPU_PROFILE_CPU) {
         SVT_DELETE(enc_api_prv->dwt_input_resource_ptr);
         SVT_DELETE_PTR_ARRAY(enc_api_prv->dwt_stage_context_ptr_array, enc_api_prv->dwt_stage_threads_num);
     }
-    if (enc_api_prv->enc_common.slice_sizes) {
-        SVT_FREE(enc_api_prv->enc_common.slice_sizes);
-    }
     SVT_DELETE_PTR_ARRAY(enc_api_prv->pack_stage_context_ptr_array, enc_api_prv->pack_stage_threads_num);
     SVT_FREE(enc_api_prv->sync_output_ringbuffer);
     svt_jxs_free_cond_var(&enc_api_prv->sync_output_ringbuffer_left);
+    SVT_DESTROY_MUTEX(enc_api_prv->stats_mutex);
+    SVT_FREE(enc_api_prv->rate_stats_last_slices);
+    SVT_DESTROY_MUTEX(enc_api_prv->rate_mutex);
 }
 
 /**********************************
@@ -133,9 +144,15 @@ static SvtJxsErrorType_t encoder_init_configuration(svt_jpeg_xs_encoder_common_t
 
     /*Validation of encoder parameters:*/
     enc_common->bit_depth = config_struct->input_bit_depth;
-    if (enc_common->bit_depth < 8 || enc_common->bit_depth > 14) {
+    if (enc_common->bit_depth < 8 || enc_common->bit_depth > 16) {
+        if (config_struct->verbose >= VERBOSE_ERRORS) {
+            fprintf(stderr, "Incorrect bit_depth, expected: 8 to 16,  provided: %d\n", enc_common->bit_depth);
+        }
+        return SvtJxsErrorBadParameter;
+    }
+    if (config_struct->input_float16 > 1 || (config_struct->input_float16 && enc_common->bit_depth != 16)) {
         if (config_struct->verbose >= VERBOSE_ERRORS) {
-            fprintf(stderr, "Incorrect bit_depth, expected: 8 to 14,  provided: %d\n", enc_common->bit_depth);
+            fprintf(stderr, "Half-float input requires bit_depth 16, provided: %d\n", enc_common->bit_depth);
         }
         return SvtJxsErrorBadParameter;
     }
@@ -216,8 +233,15 @@ static SvtJxsErrorType_t encoder_init_configuration(svt_jpeg_xs_encoder_common_t
 
     // Rate Control
     enc_common->rate_control_mode = config_struct->rate_control_mode;
+    /*Input of any bit depth is scaled to Bw bits, so range of coefficients in 16 bit storage of decoder
+     *does not depend on input bit depth, Bw have to be not smaller than input bit depth.*/
     enc_common->picture_header_dynamic.hdr_Bw = WAVELET_IN_DEPTH_BW_DEFAULT;
     enc_common->picture_header_dynamic.hdr_Fq = WAVELET_FRACTION_BITS_FQ_DEFAULT;
+    assert(enc_common->bit_depth <= enc_common->picture_header_dynamic.hdr_Bw);
+    /*Half-float linear samples are coded as square root, decoder apply quadratic non-linearity without DC offset*/
+    enc_common->picture_header_dynamic.hdr_Tnlt = config_struct->input_float16 ? 1 : 0;
+    enc_common->picture_header_dynamic.hdr_Tnlt_sigma = 0;
+    enc_common->picture_header_dynamic.hdr_Tnlt_alpha = 0;
     enc_common->coding_significance = config_struct->coding_significance;
     enc_common->cpu_profile = config_struct->cpu_profile;
     if (enc_common->cpu_profile != CPU_PROFILE_LOW_LATENCY && enc_common->cpu_profile != CPU_PROFILE_CPU) {
@@ -448,6 +472,8 @@ static SvtJxsErrorType_t encoder_init_configuration(svt_jpeg_xs_encoder_common_t
     if (return_error) {
         return return_error;
     }
+    enc_common->dwt_16bit_lanes = dwt_16bit_supported(
+        enc_common->bit_depth, (uint8_t)pi->decom_h, &enc_common->picture_header_dynamic);
 
     SVT_DEBUG("%s, prec_num_in_slice %u, prec_num_in_frame %u\n", __func__, pi->precincts_per_slice, pi->precincts_line_num);
     return SvtJxsErrorNone;
@@ -551,9 +577,9 @@ PREFIX_API SvtJxsErrorType_t svt_jpeg_xs_encoder_get_image_config(uint64_t versi
     out_image_config->height = enc_api->source_height;
     out_image_config->bit_depth = enc_api->input_bit_depth;
     out_image_config->format = enc_api->colour_format;
-    if (out_image_config->bit_depth < 8 || out_image_config->bit_depth > 14) {
+    if (out_image_config->bit_depth < 8 || out_image_config->bit_depth > 16) {
         if (enc_api->verbose >= VERBOSE_ERRORS) {
-            fprintf(stderr, "Incorrect bit_depth, expected: 8 to 14,  provided: %d\n", out_image_config->bit_depth);
+            fprintf(stderr, "Incorrect bit_depth, expected: 8 to 16,  provided: %d\n", out_image_config->bit_depth);
         }
         return SvtJxsErrorBadParameter;
     }
@@ -617,124 +643,129 @@ PREFIX_API SvtJxsErrorType_t svt_jpeg_xs_encoder_get_image_config(uint64_t versi
     return SvtJxsErrorNone;
 }
 
+/*Threads and queue sizes of encoder pipeline*/
+typedef struct EncPipelineSizes {
+    uint32_t dwt_stage_threads_num;
+    uint32_t pack_stage_threads_num;
+    uint32_t dwt_input_fifo_count;
+    uint32_t pack_input_fifo_count;
+    uint32_t pack_slice_slot_count;
+    uint32_t pack_output_fifo_count;
+    uint32_t input_buffer_fifo_count;
+    uint32_t picture_control_set_pool_count;
+    uint32_t sync_output_ringbuffer_size;
+    uint32_t output_buffer_fifo_count;
+} EncPipelineSizes_t;
+
 /**********************************
- * Initialize Encoder Library
+ * Validate configuration and compute encoder parameters, threads and queue sizes.
+ * Nothing is allocated, shared by encoder_init() and svt_jpeg_xs_encoder_get_resources().
  **********************************/
-PREFIX_API SvtJxsErrorType_t svt_jpeg_xs_encoder_init(uint64_t version_api_major, uint64_t version_api_minor,
-                                                      svt_jpeg_xs_encoder_api_t* enc_api) {
-    SvtJxsErrorType_t return_error = SvtJxsErrorNone;
-    if ((version_api_major > SVT_JPEGXS_API_VER_MAJOR) ||
-        (version_api_major == SVT_JPEGXS_API_VER_MAJOR && version_api_minor > SVT_JPEGXS_API_VER_MINOR)) {
-        return SvtJxsErrorInvalidApiVersion;
-    }
-    if (enc_api == NULL) {
+static SvtJxsErrorType_t encoder_configure(svt_jpeg_xs_encoder_common_t* enc_common, svt_jpeg_xs_encoder_api_t* enc_api,
+                                           const EncBatch_t* batch, EncPipelineSizes_t* sizes) {
+    if (enc_api->slice_packetization_mode > 1) {
+        if (enc_api->verbose >= VERBOSE_ERRORS) {
+            SVT_LOG("Unrecognized slice packetization mode\n");
+        }
         return SvtJxsErrorBadParameter;
     }
-    enc_api->private_ptr = NULL;
-    svt_jxs_log_init();
-    // Init Component OS objects (threads, semaphores, etc.)
-    // also links the various Component control functions
-    return_error = encoder_allocate_handle(enc_api);
-    if (return_error != SvtJxsErrorNone) {
-        svt_jpeg_xs_encoder_close(enc_api);
-        return return_error;
-    }
-    svt_jpeg_xs_encoder_api_prv_t* enc_api_prv = (svt_jpeg_xs_encoder_api_prv_t*)enc_api->private_ptr;
-    if (enc_api_prv == NULL) {
-        return SvtJxsErrorUndefined;
-    }
-    svt_jpeg_xs_encoder_common_t* enc_common = &enc_api_prv->enc_common;
-    svt_jxs_increase_component_count();
+    enc_common->slice_packetization_mode = enc_api->slice_packetization_mode;
 
-    enc_api_prv->callback_encoder_ctx = enc_api;
-    enc_api_prv->callback_send_data_available = enc_api->callback_send_data_available;
-    enc_api_prv->callback_send_data_available_context = enc_api->callback_send_data_available_context;
-    enc_api_prv->callback_get_data_available = enc_api->callback_get_data_available;
-    enc_api_prv->callback_get_data_available_context = enc_api->callback_get_data_available_context;
+    if (enc_api->stats_enable > 1) {
+        if (enc_api->verbose >= VERBOSE_ERRORS) {
+            SVT_LOG("Unrecognized statistics mode\n");
+        }
+        return SvtJxsErrorBadParameter;
+    }
+    enc_common->stats_enable = enc_api->stats_enable;
 
-    if (enc_api->slice_packetization_mode > 1) {
+    if (enc_api->slice_scheduling > 1) {
         if (enc_api->verbose >= VERBOSE_ERRORS) {
-            SVT_LOG("Unrecognized slice packetization mode\n");
+            SVT_LOG("Unrecognized slice scheduling mode\n");
         }
-        svt_jpeg_xs_encoder_close(enc_api);
         return SvtJxsErrorBadParameter;
     }
-    enc_common->slice_packetization_mode = enc_api->slice_packetization_mode;
 
-    const CPU_FLAGS cpu_flags = get_cpu_flags();
-    enc_api->use_cpu_flags &= cpu_flags;
-    if (enc_api->verbose >= VERBOSE_SYSTEM_INFO) {
-        SVT_LOG("[asm level on system : up to %s]\n", get_asm_level_name_str(cpu_flags));
-        SVT_LOG("[asm level selected : up to %s]\n", get_asm_level_name_str(enc_api->use_cpu_flags));
+    if (enc_api->frames_in_pipeline > SVT_JXS_FRAMES_IN_PIPELINE_MAX ||
+        enc_api->frames_in_input_queue > SVT_JXS_FRAMES_IN_INPUT_QUEUE_MAX) {
+        if (enc_api->verbose >= VERBOSE_ERRORS) {
+            SVT_LOG("Pipeline depth out of range, max frames in pipeline %d and in input queue %d\n",
+                    SVT_JXS_FRAMES_IN_PIPELINE_MAX,
+                    SVT_JXS_FRAMES_IN_INPUT_QUEUE_MAX);
+        }
+        return SvtJxsErrorBadParameter;
     }
-    setup_common_rtcd_internal(enc_api->use_cpu_flags);
-    setup_encoder_rtcd_internal(enc_api->use_cpu_flags);
 
-    return_error = encoder_init_configuration(&enc_api_prv->enc_common, enc_api);
+    SvtJxsErrorType_t return_error = encoder_init_configuration(enc_common, enc_api);
     if (return_error != SvtJxsErrorNone) {
-        svt_jpeg_xs_encoder_close(enc_api);
         return return_error;
     }
+    if (batch && enc_common->cpu_profile != CPU_PROFILE_LOW_LATENCY) {
+        if (enc_api->verbose >= VERBOSE_ERRORS) {
+            SVT_LOG("Batch of encoders support only low latency CPU profile\n");
+        }
+        return SvtJxsErrorBadParameter;
+    }
 
     if (enc_common->cpu_profile == CPU_PROFILE_CPU) {
         if (enc_api->threads_num > 12) {
-            enc_api_prv->dwt_stage_threads_num = 3;
+            sizes->dwt_stage_threads_num = 3;
         }
         else if (enc_api->threads_num > 8) {
-            enc_api_prv->dwt_stage_threads_num = 2;
+            sizes->dwt_stage_threads_num = 2;
         }
         else {
-            enc_api_prv->dwt_stage_threads_num = 1;
+            sizes->dwt_stage_threads_num = 1;
         }
 
-        int32_t threads_left = (int32_t)enc_api->threads_num - 2 - (int32_t)enc_api_prv->dwt_stage_threads_num;
-        enc_api_prv->pack_stage_threads_num = MAX(1, threads_left);
+        int32_t threads_left = (int32_t)enc_api->threads_num - 2 - (int32_t)sizes->dwt_stage_threads_num;
+        sizes->pack_stage_threads_num = MAX(1, threads_left);
     }
     else if (enc_common->cpu_profile == CPU_PROFILE_LOW_LATENCY) {
-        enc_api_prv->dwt_stage_threads_num = 0;
-        enc_api_prv->pack_stage_threads_num = MAX(1, (int32_t)enc_api->threads_num - 2);
+        sizes->dwt_stage_threads_num = 0;
+        sizes->pack_stage_threads_num = MAX(1, (int32_t)enc_api->threads_num - 2);
+        if (batch) {
+            /*Pack context for every thread of batch, pack threads are not created*/
+            sizes->pack_stage_threads_num = batch->threads_num;
+        }
     }
     else {
-        assert(0);
+        return SvtJxsErrorBadParameter;
     }
 
-    uint32_t pack_input_fifo_count = 2 * enc_api_prv->pack_stage_threads_num;
+    /*Precincts without vertical decomposition do not depend on each other before RC,
+     *so when there are less slices than pack threads every slice is split to parts prepared in parallel.*/
+    enc_common->slice_parts_num = 1;
+    if (enc_common->cpu_profile == CPU_PROFILE_LOW_LATENCY && enc_common->pi.decom_v == 0 &&
+        sizes->pack_stage_threads_num > enc_common->pi.slice_num) {
+        enc_common->slice_parts_num = MIN(DIV_ROUND_UP(sizes->pack_stage_threads_num, enc_common->pi.slice_num),
+                                          enc_common->pi.precincts_per_slice);
+    }
+    /*Chunked scheduling: one range of contiguous slices per pack thread.
+     *CPU profile keeps task per slice, DWT stage sync with every slice separately.*/
+    enc_common->slices_per_pack_task = 1;
+    if (enc_api->slice_scheduling == 1 && enc_common->cpu_profile == CPU_PROFILE_LOW_LATENCY &&
+        enc_common->slice_parts_num == 1) {
+        enc_common->slices_per_pack_task = DIV_ROUND_UP(enc_common->pi.slice_num, sizes->pack_stage_threads_num);
+    }
+    /*Slot with precincts for every slice of 2 frames*/
+    sizes->pack_slice_slot_count = 2 * enc_common->pi.slice_num;
+
+    sizes->pack_input_fifo_count = 2 * sizes->pack_stage_threads_num;
     if (enc_common->cpu_profile == CPU_PROFILE_CPU) {
         /*Set minimum 2 frames to schedule.
          *If size of queue is smaller than number of slices then deadlock.*/
-        pack_input_fifo_count = MAX(pack_input_fifo_count, 2 * enc_common->pi.slice_num);
-        pack_input_fifo_count = MAX(pack_input_fifo_count,
-                                    (enc_api_prv->dwt_stage_threads_num / enc_common->pi.comps_num) * enc_common->pi.slice_num);
-    }
-
-    const uint32_t init_stage_process_threads_num = 1;
-    uint32_t dwt_input_fifo_count = enc_api_prv->dwt_stage_threads_num * 3; /* Using only for CPU_PROFILE_CPU! */
-    uint32_t input_buffer_fifo_count = 10;
-    uint32_t picture_control_set_pool_count = input_buffer_fifo_count; //TODO: 3 will be enough for latency mode???
-    enc_api_prv->sync_output_ringbuffer_size = picture_control_set_pool_count + 10;
-    uint32_t output_buffer_fifo_count = enc_api_prv->sync_output_ringbuffer_size + 8;
-    uint32_t pack_output_fifo_count = pack_input_fifo_count;
-
-    enc_api_prv->sync_output_ringbuffer = NULL;
-    SVT_CALLOC_ARRAY(enc_api_prv->sync_output_ringbuffer, enc_api_prv->sync_output_ringbuffer_size);
-    return_error = svt_jxs_create_cond_var(&enc_api_prv->sync_output_ringbuffer_left);
-    if (return_error) {
-        svt_jpeg_xs_encoder_close(enc_api);
-        return return_error;
+        sizes->pack_input_fifo_count = MAX(sizes->pack_input_fifo_count, 2 * enc_common->pi.slice_num);
+        sizes->pack_input_fifo_count = MAX(sizes->pack_input_fifo_count,
+                                           (sizes->dwt_stage_threads_num / enc_common->pi.comps_num) * enc_common->pi.slice_num);
     }
-    svt_jxs_set_cond_var(&enc_api_prv->sync_output_ringbuffer_left, enc_api_prv->sync_output_ringbuffer_size);
 
-    if (enc_api->verbose >= VERBOSE_SYSTEM_INFO) {
-        SVT_LOG(
-            "Number of logical cores available: %u\nNumber of PPCS %u\n", enc_api->threads_num, picture_control_set_pool_count);
-        if (enc_common->cpu_profile == CPU_PROFILE_CPU) {
-            SVT_LOG("dwt input count %d\n", dwt_input_fifo_count);
-        }
-        SVT_LOG("slice pack input count %d\n", pack_input_fifo_count);
-        SVT_LOG("slice pack output count %d\n", pack_output_fifo_count);
-
-        print_lib_params(enc_api);
-    }
+    sizes->dwt_input_fifo_count = sizes->dwt_stage_threads_num * 3; /* Using only for CPU_PROFILE_CPU! */
+    sizes->input_buffer_fifo_count = enc_api->frames_in_input_queue ? enc_api->frames_in_input_queue : 10;
+    sizes->picture_control_set_pool_count = enc_api->frames_in_pipeline ? enc_api->frames_in_pipeline : 10;
+    sizes->sync_output_ringbuffer_size = sizes->picture_control_set_pool_count + 10;
+    sizes->output_buffer_fifo_count = sizes->sync_output_ringbuffer_size + 8;
+    sizes->pack_output_fifo_count = sizes->pack_input_fifo_count;
 
     /*Prepare header for all frames*/
     enc_common->frame_header_length_bytes = write_pic_level_header_nbytes(
@@ -743,7 +774,6 @@ PREFIX_API SvtJxsErrorType_t svt_jpeg_xs_encoder_init(uint64_t version_api_major
     if (enc_common->frame_header_length_bytes > sizeof(enc_common->frame_header_buffer)) {
         assert(0);
         //Should not happens
-        svt_jpeg_xs_encoder_close(enc_api);
         return SvtJxsErrorInsufficientResources;
     }
 
@@ -753,67 +783,188 @@ PREFIX_API SvtJxsErrorType_t svt_jpeg_xs_encoder_init(uint64_t version_api_major
         if (enc_api->verbose >= VERBOSE_ERRORS) {
             fprintf(stderr, "Impossible compression. Please use bigger bpp param!\n");
         }
-        svt_jpeg_xs_encoder_close(enc_api);
         return SvtJxsErrorBadParameter;
     }
 
-    SVT_MALLOC(enc_common->slice_sizes, enc_common->pi.slice_num * sizeof(uint32_t));
-    /*Calculate size of each slice*/
-    {
-        uint32_t picture_headlen_bytes = enc_common->frame_header_length_bytes;
-        uint32_t heders_and_tags_bytes = picture_headlen_bytes + CODESTREAM_SIZE_BYTES +
-            SLICE_HEADER_SIZE_BYTES * enc_common->pi.slice_num;
-        assert(enc_common->picture_header_dynamic.hdr_Lcod >= heders_and_tags_bytes);
-        uint32_t size_all_precincts_bytes = enc_common->picture_header_dynamic.hdr_Lcod - heders_and_tags_bytes;
-
-        uint32_t precincst_last_slice = enc_common->pi.precincts_per_slice -
-            (enc_common->pi.slice_num * enc_common->pi.precincts_per_slice - enc_common->pi.precincts_line_num);
-        /* Last slice can have less precinct so need to balance size between slices.
-     * First slices get more one byte per slice*/
-        uint32_t min_size_per_precinct_bytes = size_all_precincts_bytes / enc_common->pi.precincts_line_num;
-        uint32_t min_size_per_slice_bytes = min_size_per_precinct_bytes * enc_common->pi.precincts_per_slice;
-        uint32_t last_size_per_slice_bytes = min_size_per_precinct_bytes * precincst_last_slice;
-        assert(size_all_precincts_bytes >= last_size_per_slice_bytes + min_size_per_slice_bytes * (enc_common->pi.slice_num - 1));
-        uint32_t size_left_bytes = size_all_precincts_bytes - last_size_per_slice_bytes -
-            min_size_per_slice_bytes * (enc_common->pi.slice_num - 1);
-
-        /*Add to slices proportionally to precincts in slice*/
-        if (enc_common->pi.slice_num > 1) {
-            assert(((uint64_t)size_left_bytes * (enc_common->pi.slice_num - 1) * enc_common->pi.precincts_per_slice) <
-                   UINT32_MAX);
-            min_size_per_slice_bytes += (size_left_bytes * (enc_common->pi.slice_num - 1) * enc_common->pi.precincts_per_slice /
-                                         enc_common->pi.precincts_line_num) /
-                (enc_common->pi.slice_num - 1);
+    /*Lcod of each frame is written to copy of header by pre rc stage*/
+    assert(((uint32_t)enc_common->frame_header_buffer[FRAME_HEADER_LCOD_OFFSET_BYTES] << 24 |
+            (uint32_t)enc_common->frame_header_buffer[FRAME_HEADER_LCOD_OFFSET_BYTES + 1] << 16 |
+            (uint32_t)enc_common->frame_header_buffer[FRAME_HEADER_LCOD_OFFSET_BYTES + 2] << 8 |
+            enc_common->frame_header_buffer[FRAME_HEADER_LCOD_OFFSET_BYTES + 3]) == enc_common->picture_header_dynamic.hdr_Lcod);
+    return SvtJxsErrorNone;
+}
+
+/**********************************
+ * Memory allocated by encoder_init(), follows order of allocations in it.
+ **********************************/
+static void encoder_memory(SvtMemSize_t* mem, const svt_jpeg_xs_encoder_common_t* enc_common, const EncPipelineSizes_t* sizes,
+                           uint8_t batch) {
+    SvtMemSize_t obj_mem;
+    size_t size = sizeof(svt_jpeg_xs_encoder_api_prv_t) + sizes->sync_output_ringbuffer_size * sizeof(ObjectWrapper_t*) +
+        svt_jxs_mutex_memory();
+    if (enc_common->stats_enable) {
+        size += svt_jxs_mutex_memory() + enc_common->pi.slice_num * sizeof(svt_jpeg_xs_slice_rate_stats_t);
+    }
+    svt_jxs_mem_size_add(mem, size, SVT_JXS_MEM_GENERAL);
+
+    memset(&obj_mem, 0, sizeof(obj_mem));
+    picture_control_set_memory(&obj_mem, enc_common);
+    svt_jxs_system_resource_memory(mem, sizes->picture_control_set_pool_count, 1, 0, &obj_mem);
+
+    memset(&obj_mem, 0, sizeof(obj_mem));
+    svt_jxs_mem_size_add(&obj_mem, sizeof(EncoderInputItem), SVT_JXS_MEM_GENERAL);
+    svt_jxs_system_resource_memory(mem, sizes->input_buffer_fifo_count, 1, 1, &obj_mem);
+
+    memset(&obj_mem, 0, sizeof(obj_mem));
+    svt_jxs_mem_size_add(&obj_mem, sizeof(EncoderOutputItem), SVT_JXS_MEM_GENERAL);
+    svt_jxs_system_resource_memory(mem, sizes->output_buffer_fifo_count, 1, 1, &obj_mem);
+
+    if (enc_common->cpu_profile == CPU_PROFILE_CPU) {
+        memset(&obj_mem, 0, sizeof(obj_mem));
+        svt_jxs_mem_size_add(&obj_mem, sizeof(DwtInput), SVT_JXS_MEM_GENERAL);
+        svt_jxs_system_resource_memory(mem, sizes->dwt_input_fifo_count, 1, sizes->dwt_stage_threads_num, &obj_mem);
+    }
+
+    memset(&obj_mem, 0, sizeof(obj_mem));
+    pack_input_memory(&obj_mem, enc_common);
+    svt_jxs_system_resource_memory(mem, sizes->pack_input_fifo_count, 1, batch ? 0 : sizes->pack_stage_threads_num, &obj_mem);
+
+    if (enc_common->slice_parts_num > 1) {
+        memset(&obj_mem, 0, sizeof(obj_mem));
+        pack_slice_slot_memory(&obj_mem, enc_common);
+        svt_jxs_system_resource_memory(mem, sizes->pack_slice_slot_count, 1, 0, &obj_mem);
+    }
+
+    memset(&obj_mem, 0, sizeof(obj_mem));
+    svt_jxs_mem_size_add(&obj_mem, sizeof(PackOutput), SVT_JXS_MEM_GENERAL);
+    svt_jxs_system_resource_memory(mem, sizes->pack_output_fifo_count, sizes->pack_stage_threads_num, 1, &obj_mem);
+
+    /*Contexts*/
+    svt_jxs_mem_size_add(mem, 2 * sizeof(ThreadContext_t), SVT_JXS_MEM_GENERAL);
+    init_stage_context_memory(mem);
+    final_stage_context_memory(mem);
+    if (enc_common->cpu_profile == CPU_PROFILE_CPU) {
+        memset(&obj_mem, 0, sizeof(obj_mem));
+        svt_jxs_mem_size_add(&obj_mem, sizeof(ThreadContext_t*) + sizeof(ThreadContext_t), SVT_JXS_MEM_GENERAL);
+        dwt_stage_context_memory(&obj_mem, enc_common);
+        svt_jxs_mem_size_add_objects(mem, &obj_mem, sizes->dwt_stage_threads_num);
+    }
+    memset(&obj_mem, 0, sizeof(obj_mem));
+    svt_jxs_mem_size_add(&obj_mem, sizeof(ThreadContext_t*) + sizeof(ThreadContext_t), SVT_JXS_MEM_GENERAL);
+    pack_stage_context_memory(&obj_mem, enc_common);
+    svt_jxs_mem_size_add_objects(mem, &obj_mem, sizes->pack_stage_threads_num);
+
+    /*Threads, pack threads of batch are owned by batch*/
+    uint32_t threads_num = 2;
+    if (enc_common->cpu_profile == CPU_PROFILE_CPU) {
+        svt_jxs_mem_size_add(mem, sizes->dwt_stage_threads_num * sizeof(Handle_t), SVT_JXS_MEM_GENERAL);
+        threads_num += sizes->dwt_stage_threads_num;
+    }
+    if (!batch) {
+        svt_jxs_mem_size_add(mem, sizes->pack_stage_threads_num * sizeof(Handle_t), SVT_JXS_MEM_GENERAL);
+        threads_num += sizes->pack_stage_threads_num;
+    }
+    svt_jxs_mem_size_add(mem, threads_num * svt_jxs_thread_memory(), SVT_JXS_MEM_GENERAL);
+}
+
+/**********************************
+ * Initialize Encoder Library
+ **********************************/
+static SvtJxsErrorType_t encoder_init(svt_jpeg_xs_encoder_api_t* enc_api, EncBatch_t* batch) {
+    SvtJxsErrorType_t return_error = SvtJxsErrorNone;
+    // Init Component OS objects (threads, semaphores, etc.)
+    // also links the various Component control functions
+    return_error = encoder_allocate_handle(enc_api);
+    if (return_error != SvtJxsErrorNone) {
+        svt_jpeg_xs_encoder_close(enc_api);
+        return return_error;
+    }
+    svt_jpeg_xs_encoder_api_prv_t* enc_api_prv = (svt_jpeg_xs_encoder_api_prv_t*)enc_api->private_ptr;
+    if (enc_api_prv == NULL) {
+        return SvtJxsErrorUndefined;
+    }
+    if (enc_api->allocator) {
+        enc_api_prv->allocator = *enc_api->allocator;
+    }
+    svt_jpeg_xs_encoder_common_t* enc_common = &enc_api_prv->enc_common;
+    svt_jxs_increase_component_count();
+
+    enc_api_prv->callback_encoder_ctx = enc_api;
+    enc_api_prv->callback_send_data_available = enc_api->callback_send_data_available;
+    enc_api_prv->callback_send_data_available_context = enc_api->callback_send_data_available_context;
+    enc_api_prv->callback_get_data_available = enc_api->callback_get_data_available;
+    enc_api_prv->callback_get_data_available_context = enc_api->callback_get_data_available_context;
+    enc_api_prv->callback_frame_stats = enc_api->callback_frame_stats;
+    enc_api_prv->callback_frame_stats_context = enc_api->callback_frame_stats_context;
+    enc_api_prv->callback_rate_stats = enc_api->callback_rate_stats;
+    enc_api_prv->callback_rate_stats_context = enc_api->callback_rate_stats_context;
+
+    const CPU_FLAGS cpu_flags = get_cpu_flags();
+    enc_api->use_cpu_flags &= cpu_flags;
+    if (enc_api->verbose >= VERBOSE_SYSTEM_INFO) {
+        SVT_LOG("[asm level on system : up to %s]\n", get_asm_level_name_str(cpu_flags));
+        SVT_LOG("[asm level selected : up to %s]\n", get_asm_level_name_str(enc_api->use_cpu_flags));
+    }
+    setup_common_rtcd_internal(enc_api->use_cpu_flags);
+    setup_encoder_rtcd_internal(enc_api->use_cpu_flags);
+
+    EncPipelineSizes_t sizes = {0};
+    return_error = encoder_configure(enc_common, enc_api, batch, &sizes);
+    if (return_error != SvtJxsErrorNone) {
+        svt_jpeg_xs_encoder_close(enc_api);
+        return return_error;
+    }
+
+    const uint32_t init_stage_process_threads_num = 1;
+    enc_api_prv->dwt_stage_threads_num = sizes.dwt_stage_threads_num;
+    enc_api_prv->pack_stage_threads_num = sizes.pack_stage_threads_num;
+    enc_api_prv->input_buffer_fifo_count = sizes.input_buffer_fifo_count;
+    enc_api_prv->picture_control_set_pool_count = sizes.picture_control_set_pool_count;
+    enc_api_prv->sync_output_ringbuffer_size = sizes.sync_output_ringbuffer_size;
+
+    enc_api_prv->sync_output_ringbuffer = NULL;
+    SVT_CALLOC_ARRAY(enc_api_prv->sync_output_ringbuffer, enc_api_prv->sync_output_ringbuffer_size);
+    return_error = svt_jxs_create_cond_var(&enc_api_prv->sync_output_ringbuffer_left);
+    if (return_error) {
+        svt_jpeg_xs_encoder_close(enc_api);
+        return return_error;
+    }
+    svt_jxs_set_cond_var(&enc_api_prv->sync_output_ringbuffer_left, enc_api_prv->sync_output_ringbuffer_size);
+
+    if (enc_api->verbose >= VERBOSE_SYSTEM_INFO) {
+        SVT_LOG("Number of logical cores available: %u\nNumber of PPCS %u\n",
+                enc_api->threads_num,
+                sizes.picture_control_set_pool_count);
+        if (enc_common->cpu_profile == CPU_PROFILE_CPU) {
+            SVT_LOG("dwt input count %d\n", sizes.dwt_input_fifo_count);
         }
-        assert(((uint64_t)size_left_bytes * precincst_last_slice) < UINT32_MAX);
-        last_size_per_slice_bytes += size_left_bytes * precincst_last_slice / enc_common->pi.precincts_line_num;
-        size_left_bytes = size_all_precincts_bytes - last_size_per_slice_bytes -
-            min_size_per_slice_bytes * (enc_common->pi.slice_num - 1);
-        assert(size_left_bytes <= enc_common->pi.slice_num);
-
-        uint32_t bytes_left = enc_common->picture_header_dynamic.hdr_Lcod - picture_headlen_bytes;
-        for (uint32_t i = 0; i < enc_common->pi.slice_num; i++) {
-            if (i != enc_common->pi.slice_num - 1) {
-                uint32_t size_per_slice_bytes = min_size_per_slice_bytes;
-                if (i < size_left_bytes) {
-                    size_per_slice_bytes++;
-                }
-                size_per_slice_bytes += SLICE_HEADER_SIZE_BYTES;
-                enc_common->slice_sizes[i] = size_per_slice_bytes;
-                bytes_left -= size_per_slice_bytes;
-            }
-            else {
-                enc_common->slice_sizes[i] = bytes_left;
-            }
+        SVT_LOG("slice pack input count %d\n", sizes.pack_input_fifo_count);
+        SVT_LOG("slice pack output count %d\n", sizes.pack_output_fifo_count);
+        if (enc_common->slices_per_pack_task > 1) {
+            SVT_LOG("slices per pack task %u\n", enc_common->slices_per_pack_task);
+        }
+        if (enc_common->slice_parts_num > 1) {
+            SVT_LOG("slice parts %u, slice slot count %u\n", enc_common->slice_parts_num, sizes.pack_slice_slot_count);
         }
+
+        print_lib_params(enc_api);
     }
 
+    enc_api_prv->rate_Lcod = enc_common->picture_header_dynamic.hdr_Lcod;
+    enc_api_prv->rate_control_mode = enc_common->rate_control_mode;
+    SVT_CREATE_MUTEX(enc_api_prv->rate_mutex);
+
     uint32_t process_index;
     enc_api_prv->frame_number = 0;
 
+    if (enc_common->stats_enable) {
+        SVT_CREATE_MUTEX(enc_api_prv->stats_mutex);
+        SVT_CALLOC_ARRAY(enc_api_prv->rate_stats_last_slices, enc_common->pi.slice_num);
+    }
+
     SVT_NEW(enc_api_prv->picture_control_set_pool_ptr,
             svt_jxs_system_resource_ctor,
-            picture_control_set_pool_count,
+            sizes.picture_control_set_pool_count,
             1,
             0,
             picture_control_set_creator,
@@ -827,7 +978,7 @@ PREFIX_API SvtJxsErrorType_t svt_jpeg_xs_encoder_init(uint64_t version_api_major
     // EncoderInputImageItem Input
     SVT_NEW(enc_api_prv->input_image_resource_ptr,
             svt_jxs_system_resource_ctor,
-            input_buffer_fifo_count,
+            sizes.input_buffer_fifo_count,
             1,
             1,
             input_item_creator,
@@ -841,7 +992,7 @@ PREFIX_API SvtJxsErrorType_t svt_jpeg_xs_encoder_init(uint64_t version_api_major
 
     SVT_NEW(enc_api_prv->output_queue_resource_ptr,
             svt_jxs_system_resource_ctor,
-            output_buffer_fifo_count,
+            sizes.output_buffer_fifo_count,
             1,
             1,
             output_item_creator,
@@ -859,7 +1010,7 @@ PREFIX_API SvtJxsErrorType_t svt_jpeg_xs_encoder_init(uint64_t version_api_major
 
         SVT_NEW(enc_api_prv->dwt_input_resource_ptr,
                 svt_jxs_system_resource_ctor,
-                dwt_input_fifo_count,
+                sizes.dwt_input_fifo_count,
                 init_stage_process_threads_num,
                 enc_api_prv->dwt_stage_threads_num,
                 dwt_input_creator,
@@ -867,22 +1018,34 @@ PREFIX_API SvtJxsErrorType_t svt_jpeg_xs_encoder_init(uint64_t version_api_major
                 NULL);
     }
 
-    //INIT -> PACK
+    //INIT -> PACK, tasks are sent to batch without consumer fifo
     SVT_NEW(enc_api_prv->pack_input_resource_ptr,
             svt_jxs_system_resource_ctor,
-            pack_input_fifo_count,
+            sizes.pack_input_fifo_count,
             init_stage_process_threads_num,
-            enc_api_prv->pack_stage_threads_num,
+            batch ? 0 : enc_api_prv->pack_stage_threads_num,
             pack_input_creator,
             enc_common,
             NULL);
 
+    if (enc_common->slice_parts_num > 1) {
+        //Precincts of slice shared by parts of slice
+        SVT_NEW(enc_api_prv->pack_slice_slot_resource_ptr,
+                svt_jxs_system_resource_ctor,
+                sizes.pack_slice_slot_count,
+                init_stage_process_threads_num,
+                0,
+                pack_slice_slot_creator,
+                enc_common,
+                NULL);
+    }
+
     // slice pack output
     // PACK -> FINISH THREAD
     PackOutputInitData pack_output_init_data;
     SVT_NEW(enc_api_prv->pack_output_resource_ptr,
             svt_jxs_system_resource_ctor,
-            pack_output_fifo_count,
+            sizes.pack_output_fifo_count,
             enc_api_prv->pack_stage_threads_num,
             1,
             pack_output_creator,
@@ -904,10 +1067,15 @@ PREFIX_API SvtJxsErrorType_t svt_jpeg_xs_encoder_init(uint64_t version_api_major
     }
 
     // Pack Stage Context
+    if (batch) {
+        enc_batch_attach(batch);
+        enc_common->batch = batch;
+    }
     SVT_ALLOC_PTR_ARRAY(enc_api_prv->pack_stage_context_ptr_array, enc_api_prv->pack_stage_threads_num);
     for (process_index = 0; process_index < enc_api_prv->pack_stage_threads_num; ++process_index) {
         SVT_NEW(enc_api_prv->pack_stage_context_ptr_array[process_index], pack_stage_context_ctor, enc_api_prv, process_index);
     }
+    enc_common->batch_pack_contexts = enc_api_prv->pack_stage_context_ptr_array;
 
     // Final Stage Context
     SVT_NEW(enc_api_prv->final_stage_context_ptr, final_stage_context_ctor, enc_api_prv);
@@ -923,11 +1091,13 @@ PREFIX_API SvtJxsErrorType_t svt_jpeg_xs_encoder_init(uint64_t version_api_major
                                 enc_api_prv->dwt_stage_context_ptr_array);
     }
 
-    // Pack Stage Kernel
-    SVT_CREATE_THREAD_ARRAY(enc_api_prv->pack_stage_thread_handle_array,
-                            enc_api_prv->pack_stage_threads_num,
-                            pack_stage_kernel,
-                            enc_api_prv->pack_stage_context_ptr_array);
+    if (batch == NULL) {
+        // Pack Stage Kernel
+        SVT_CREATE_THREAD_ARRAY(enc_api_prv->pack_stage_thread_handle_array,
+                                enc_api_prv->pack_stage_threads_num,
+                                pack_stage_kernel,
+                                enc_api_prv->pack_stage_context_ptr_array);
+    }
     // Final Stage Kernel
     SVT_CREATE_THREAD(enc_api_prv->final_stage_thread_handle, final_stage_kernel, enc_api_prv->final_stage_context_ptr);
 
@@ -935,9 +1105,45 @@ PREFIX_API SvtJxsErrorType_t svt_jpeg_xs_encoder_init(uint64_t version_api_major
     return return_error;
 }
 
+static SvtJxsErrorType_t encoder_init_api(uint64_t version_api_major, uint64_t version_api_minor,
+                                          svt_jpeg_xs_encoder_api_t* enc_api, EncBatch_t* batch) {
+    if ((version_api_major > SVT_JPEGXS_API_VER_MAJOR) ||
+        (version_api_major == SVT_JPEGXS_API_VER_MAJOR && version_api_minor > SVT_JPEGXS_API_VER_MINOR)) {
+        return SvtJxsErrorInvalidApiVersion;
+    }
+    if (enc_api == NULL) {
+        return SvtJxsErrorBadParameter;
+    }
+    enc_api->private_ptr = NULL;
+    svt_jxs_log_init();
+
+    if (svt_jxs_allocator_validate(enc_api->allocator)) {
+        if (enc_api->verbose >= VERBOSE_ERRORS) {
+            SVT_LOG("All allocator callbacks have to be set\n");
+        }
+        return SvtJxsErrorBadParameter;
+    }
+
+    const svt_jpeg_xs_allocator_t* allocator_prev = svt_jxs_set_allocator(enc_api->allocator);
+    SvtJxsErrorType_t return_error = encoder_init(enc_api, batch);
+    svt_jxs_set_allocator(allocator_prev);
+    return return_error;
+}
+
+PREFIX_API SvtJxsErrorType_t svt_jpeg_xs_encoder_init(uint64_t version_api_major, uint64_t version_api_minor,
+                                                      svt_jpeg_xs_encoder_api_t* enc_api) {
+    return encoder_init_api(version_api_major, version_api_minor, enc_api, NULL);
+}
+
 PREFIX_API void svt_jpeg_xs_encoder_close(svt_jpeg_xs_encoder_api_t* enc_api) {
     if (enc_api && enc_api->private_ptr) {
         svt_jpeg_xs_encoder_api_prv_t* enc_api_prv = (svt_jpeg_xs_encoder_api_prv_t*)enc_api->private_ptr;
+        /*Handle is released by own allocator, keep copy on stack*/
+        svt_jpeg_xs_allocator_t allocator = enc_api_prv->allocator;
+        const svt_jpeg_xs_allocator_t* allocator_prev = svt_jxs_set_allocator(allocator.alloc ? &allocator : NULL);
+
+        /*Threads of batch keep running, set before shutdown wakes them from waiting for pack output*/
+        SVT_ATOMIC_STORE32(&enc_api_prv->enc_common.batch_closing, 1);
         svt_jxs_shutdown_process(enc_api_prv->input_image_resource_ptr);
         svt_jxs_shutdown_process(enc_api_prv->dwt_input_resource_ptr);
         svt_jxs_shutdown_process(enc_api_prv->pack_input_resource_ptr);
@@ -945,8 +1151,116 @@ PREFIX_API void svt_jpeg_xs_encoder_close(svt_jpeg_xs_encoder_api_t* enc_api) {
         svt_jxs_shutdown_process(enc_api_prv->output_queue_resource_ptr);
         SVT_DELETE(enc_api_prv);
         enc_api->private_ptr = NULL;
+        svt_jxs_set_allocator(allocator_prev);
+        svt_jxs_decrease_component_count();
+    }
+}
+
+static SvtJxsErrorType_t encoder_batch_allocate(svt_jpeg_xs_encoder_batch_t* batch) {
+    EncBatch_t* batch_prv;
+    SVT_NEW(batch_prv, enc_batch_ctor, batch->threads_num);
+    batch->private_ptr = batch_prv;
+    return SvtJxsErrorNone;
+}
+
+PREFIX_API SvtJxsErrorType_t svt_jpeg_xs_encoder_batch_init(uint64_t version_api_major, uint64_t version_api_minor,
+                                                            svt_jpeg_xs_encoder_batch_t* batch) {
+    if ((version_api_major > SVT_JPEGXS_API_VER_MAJOR) ||
+        (version_api_major == SVT_JPEGXS_API_VER_MAJOR && version_api_minor > SVT_JPEGXS_API_VER_MINOR)) {
+        return SvtJxsErrorInvalidApiVersion;
+    }
+    if (batch == NULL) {
+        return SvtJxsErrorBadParameter;
+    }
+    batch->private_ptr = NULL;
+    svt_jxs_increase_component_count();
+    SvtJxsErrorType_t return_error = encoder_batch_allocate(batch);
+    if (return_error != SvtJxsErrorNone) {
         svt_jxs_decrease_component_count();
     }
+    return return_error;
+}
+
+PREFIX_API SvtJxsErrorType_t svt_jpeg_xs_encoder_batch_close(svt_jpeg_xs_encoder_batch_t* batch) {
+    if (batch && batch->private_ptr) {
+        EncBatch_t* batch_prv = (EncBatch_t*)batch->private_ptr;
+        svt_jxs_block_on_mutex(batch_prv->queue_mutex);
+        uint32_t encoders_num = batch_prv->encoders_num;
+        svt_jxs_release_mutex(batch_prv->queue_mutex);
+        if (encoders_num) {
+            /*Threads are still used by encoders, keep batch*/
+            return SvtJxsErrorBadParameter;
+        }
+        SVT_DELETE(batch_prv);
+        batch->private_ptr = NULL;
+        svt_jxs_decrease_component_count();
+    }
+    return SvtJxsErrorNone;
+}
+
+PREFIX_API SvtJxsErrorType_t svt_jpeg_xs_encoder_batch_init_encoder(uint64_t version_api_major, uint64_t version_api_minor,
+                                                                    svt_jpeg_xs_encoder_batch_t* batch,
+                                                                    svt_jpeg_xs_encoder_api_t* enc_api) {
+    if (batch == NULL || batch->private_ptr == NULL) {
+        return SvtJxsErrorBadParameter;
+    }
+    return encoder_init_api(version_api_major, version_api_minor, enc_api, (EncBatch_t*)batch->private_ptr);
+}
+
+PREFIX_API SvtJxsErrorType_t svt_jpeg_xs_encoder_get_resources(uint64_t version_api_major, uint64_t version_api_minor,
+                                                               const svt_jpeg_xs_encoder_api_t* enc_api,
+                                                               svt_jpeg_xs_resources_t* out_resources) {
+    if ((version_api_major > SVT_JPEGXS_API_VER_MAJOR) ||
+        (version_api_major == SVT_JPEGXS_API_VER_MAJOR && version_api_minor > SVT_JPEGXS_API_VER_MINOR)) {
+        return SvtJxsErrorInvalidApiVersion;
+    }
+    if (enc_api == NULL || out_resources == NULL) {
+        return SvtJxsErrorBadParameter;
+    }
+
+    /*Configuration is validated as on init, memory is computed from sizes of all objects created by init*/
+    svt_jpeg_xs_encoder_api_t enc_api_tmp = *enc_api;
+    enc_api_tmp.verbose = VERBOSE_NONE;
+    svt_jpeg_xs_encoder_common_t enc_common;
+    EncPipelineSizes_t sizes = {0};
+    memset(&enc_common, 0, sizeof(enc_common));
+    SvtJxsErrorType_t return_error = encoder_configure(&enc_common, &enc_api_tmp, NULL, &sizes);
+    if (return_error) {
+        return return_error;
+    }
+
+    SvtMemSize_t mem;
+    memset(&mem, 0, sizeof(mem));
+    encoder_memory(&mem, &enc_common, &sizes, 0);
+
+    memset(out_resources, 0, sizeof(*out_resources));
+    out_resources->threads_num[SVT_JXS_STAGE_INIT] = 1;
+    if (enc_common.cpu_profile == CPU_PROFILE_CPU) {
+        out_resources->threads_num[SVT_JXS_STAGE_DWT] = sizes.dwt_stage_threads_num;
+    }
+    out_resources->threads_num[SVT_JXS_STAGE_SLICE] = sizes.pack_stage_threads_num;
+    out_resources->threads_num[SVT_JXS_STAGE_FINAL] = 1;
+    out_resources->frames_in_pipeline = sizes.picture_control_set_pool_count;
+    out_resources->frames_in_input_queue = sizes.input_buffer_fifo_count;
+    out_resources->memory_peak = svt_jxs_mem_size_total(&mem);
+    memcpy(out_resources->memory_peak_purpose, mem.purpose, sizeof(out_resources->memory_peak_purpose));
+    return SvtJxsErrorNone;
+}
+
+PREFIX_API SvtJxsErrorType_t svt_jpeg_xs_encoder_get_memory_footprint(uint64_t version_api_major, uint64_t version_api_minor,
+                                                                      const svt_jpeg_xs_encoder_api_t* enc_api,
+                                                                      size_t* out_footprint) {
+    if (enc_api == NULL || out_footprint == NULL) {
+        return SvtJxsErrorBadParameter;
+    }
+
+    svt_jpeg_xs_resources_t resources;
+    SvtJxsErrorType_t return_error = svt_jpeg_xs_encoder_get_resources(version_api_major, version_api_minor, enc_api, &resources);
+    if (return_error) {
+        return return_error;
+    }
+    *out_footprint = resources.memory_peak;
+    return SvtJxsErrorNone;
 }
 
 /**********************************
@@ -960,7 +1274,12 @@ PREFIX_API SvtJxsErrorType_t svt_jpeg_xs_encoder_send_picture(svt_jpeg_xs_encode
 
     svt_jpeg_xs_encoder_api_prv_t* enc_api_prv = (svt_jpeg_xs_encoder_api_prv_t*)enc_api->private_ptr;
 
-    if (enc_input->bitstream.allocation_size < enc_api_prv->enc_common.picture_header_dynamic.hdr_Lcod) {
+    svt_jxs_block_on_mutex(enc_api_prv->rate_mutex);
+    uint32_t Lcod = enc_api_prv->rate_Lcod;
+    RateControlType rate_control_mode = enc_api_prv->rate_control_mode;
+    svt_jxs_release_mutex(enc_api_prv->rate_mutex);
+
+    if (enc_input->bitstream.allocation_size < Lcod) {
         return SvtJxsErrorBadParameter;
     }
     if (enc_input->bitstream.buffer == NULL) {
@@ -1006,6 +1325,9 @@ PREFIX_API SvtJxsErrorType_t svt_jpeg_xs_encoder_send_picture(svt_jpeg_xs_encode
         EncoderInputItem* input_item = (EncoderInputItem*)wrapper_ptr->object_ptr;
         input_item->enc_input = *enc_input; //Copy input structure
         input_item->frame_number = enc_api_prv->frame_number;
+        input_item->time_send_us = enc_api_prv->enc_common.stats_enable ? svt_jxs_get_time_us() : 0;
+        input_item->Lcod = Lcod;
+        input_item->rate_control_mode = rate_control_mode;
         enc_api_prv->frame_number++;
         svt_jxs_post_full_object(wrapper_ptr);
         SVT_DEBUG("%s\n", __func__);
@@ -1057,3 +1379,111 @@ PREFIX_API SvtJxsErrorType_t svt_jpeg_xs_encoder_get_packet(svt_jpeg_xs_encoder_
     // SVT_DEBUG("%s\n", __func__);
     return return_error;
 }
+
+void encoder_stats_publish(svt_jpeg_xs_encoder_api_prv_t* enc_api_prv, const svt_jpeg_xs_frame_stats_t* stats,
+                           const svt_jpeg_xs_rate_stats_t* rate_stats) {
+    svt_jxs_block_on_mutex(enc_api_prv->stats_mutex);
+    enc_api_prv->stats_last = *stats;
+    enc_api_prv->rate_stats_last = *rate_stats;
+    enc_api_prv->rate_stats_last.slices = enc_api_prv->rate_stats_last_slices;
+    memcpy(enc_api_prv->rate_stats_last_slices, rate_stats->slices, rate_stats->slices_num * sizeof(*rate_stats->slices));
+    enc_api_prv->stats_last_valid = 1;
+    svt_jxs_release_mutex(enc_api_prv->stats_mutex);
+
+    if (enc_api_prv->callback_frame_stats) {
+        enc_api_prv->callback_frame_stats(enc_api_prv->callback_encoder_ctx, stats, enc_api_prv->callback_frame_stats_context);
+    }
+    if (enc_api_prv->callback_rate_stats) {
+        enc_api_prv->callback_rate_stats(enc_api_prv->callback_encoder_ctx, rate_stats, enc_api_prv->callback_rate_stats_context);
+    }
+}
+
+PREFIX_API SvtJxsErrorType_t svt_jpeg_xs_encoder_get_frame_stats(svt_jpeg_xs_encoder_api_t* enc_api,
+                                                                 svt_jpeg_xs_frame_stats_t* out_stats) {
+    if (enc_api == NULL || enc_api->private_ptr == NULL || out_stats == NULL) {
+        return SvtJxsErrorBadParameter;
+    }
+    svt_jpeg_xs_encoder_api_prv_t* enc_api_prv = (svt_jpeg_xs_encoder_api_prv_t*)enc_api->private_ptr;
+    if (!enc_api_prv->enc_common.stats_enable) {
+        return SvtJxsErrorBadParameter;
+    }
+
+    SvtJxsErrorType_t return_error = SvtJxsErrorNoErrorEmptyQueue;
+    svt_jxs_block_on_mutex(enc_api_prv->stats_mutex);
+    if (enc_api_prv->stats_last_valid) {
+        *out_stats = enc_api_prv->stats_last;
+        return_error = SvtJxsErrorNone;
+    }
+    svt_jxs_release_mutex(enc_api_prv->stats_mutex);
+    return return_error;
+}
+
+PREFIX_API SvtJxsErrorType_t svt_jpeg_xs_encoder_get_rate_stats(svt_jpeg_xs_encoder_api_t* enc_api,
+                                                                svt_jpeg_xs_rate_stats_t* out_stats) {
+    if (enc_api == NULL || enc_api->private_ptr == NULL || out_stats == NULL ||
+        (out_stats->slices_alloc && out_stats->slices == NULL)) {
+        return SvtJxsErrorBadParameter;
+    }
+    svt_jpeg_xs_encoder_api_prv_t* enc_api_prv = (svt_jpeg_xs_encoder_api_prv_t*)enc_api->private_ptr;
+    if (!enc_api_prv->enc_common.stats_enable) {
+        return SvtJxsErrorBadParameter;
+    }
+
+    SvtJxsErrorType_t return_error = SvtJxsErrorNoErrorEmptyQueue;
+    svt_jpeg_xs_slice_rate_stats_t* slices = out_stats->slices;
+    uint32_t slices_alloc = out_stats->slices_alloc;
+    svt_jxs_block_on_mutex(enc_api_prv->stats_mutex);
+    if (enc_api_prv->stats_last_valid) {
+        const svt_jpeg_xs_rate_stats_t* last = &enc_api_prv->rate_stats_last;
+        *out_stats = *last;
+        out_stats->slices = slices;
+        out_stats->slices_alloc = slices_alloc;
+        if (slices_alloc) {
+            memcpy(slices, last->slices, MIN(slices_alloc, last->slices_num) * sizeof(*slices));
+        }
+        return_error = SvtJxsErrorNone;
+    }
+    svt_jxs_release_mutex(enc_api_prv->stats_mutex);
+    return return_error;
+}
+
+static uint8_t rate_control_mode_per_slice(uint32_t rate_control_mode) {
+    return rate_control_mode == RC_CBR_PER_SLICE_COMMON_QUANT || rate_control_mode == RC_CBR_PER_SLICE_COMMON_QUANT_MAX_RATE;
+}
+
+PREFIX_API SvtJxsErrorType_t svt_jpeg_xs_encoder_set_rate(svt_jpeg_xs_encoder_api_t* enc_api, uint32_t bpp_numerator,
+                                                          uint32_t bpp_denominator, uint32_t rate_control_mode) {
+    if (enc_api == NULL || enc_api->private_ptr == NULL || bpp_numerator == 0 || bpp_denominator == 0) {
+        return SvtJxsErrorBadParameter;
+    }
+    svt_jpeg_xs_encoder_api_prv_t* enc_api_prv = (svt_jpeg_xs_encoder_api_prv_t*)enc_api->private_ptr;
+    svt_jpeg_xs_encoder_common_t* enc_common = &enc_api_prv->enc_common;
+
+    /*Pack stage buffers are allocated for precinct or slice budget, mode can be changed only in the same group*/
+    if (rate_control_mode >= RC_MODE_SIZE ||
+        rate_control_mode_per_slice(rate_control_mode) != rate_control_mode_per_slice(enc_common->rate_control_mode)) {
+        if (enc_api->verbose >= VERBOSE_ERRORS) {
+            fprintf(stderr,
+                    "Error: rc mode %u can not be changed from %u without init!\n",
+                    rate_control_mode,
+                    enc_common->rate_control_mode);
+        }
+        return SvtJxsErrorBadParameter;
+    }
+
+    uint64_t bytes_per_frame = ((uint64_t)enc_common->pi.width * enc_common->pi.height * bpp_numerator / bpp_denominator + 7) / 8;
+    uint64_t headers_len_per_frame = enc_common->frame_header_length_bytes + CODESTREAM_SIZE_BYTES +
+        SLICE_HEADER_SIZE_BYTES * enc_common->pi.slice_num;
+    if (bytes_per_frame >= (((uint64_t)1) << 32) || bytes_per_frame <= headers_len_per_frame) {
+        if (enc_api->verbose >= VERBOSE_ERRORS) {
+            fprintf(stderr, "Impossible compression. Please use different bpp param!\n");
+        }
+        return SvtJxsErrorBadParameter;
+    }
+
+    svt_jxs_block_on_mutex(enc_api_prv->rate_mutex);
+    enc_api_prv->rate_Lcod = (uint32_t)bytes_per_frame;
+    enc_api_prv->rate_control_mode = (RateControlType)rate_control_mode;
+    svt_jxs_release_mutex(enc_api_prv->rate_mutex);
+    return SvtJxsErrorNone;
+}
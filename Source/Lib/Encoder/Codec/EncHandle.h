@@ -41,6 +41,23 @@ typedef struct svt_jpeg_xs_encoder_api_prv {
     void (*callback_get_data_available)(svt_jpeg_xs_encoder_api_t *encoder, void *context);
     void *callback_get_data_available_context;
 
+    /* Callback: Call when statistics of frame are ready, from final stage thread.*/
+    void (*callback_frame_stats)(svt_jpeg_xs_encoder_api_t *encoder, const svt_jpeg_xs_frame_stats_t *stats, void *context);
+    void *callback_frame_stats_context;
+    Handle_t stats_mutex;                 /*Protect stats_last*/
+    svt_jpeg_xs_frame_stats_t stats_last; /*Statistics of last frame ready to get*/
+    uint8_t stats_last_valid;
+    void (*callback_rate_stats)(svt_jpeg_xs_encoder_api_t *encoder, const svt_jpeg_xs_rate_stats_t *stats, void *context);
+    void *callback_rate_stats_context;
+    svt_jpeg_xs_rate_stats_t rate_stats_last;              /*Rate statistics of last frame, protected by stats_mutex*/
+    svt_jpeg_xs_slice_rate_stats_t *rate_stats_last_slices; /*Slices of rate_stats_last, pi.slice_num elements*/
+
+    Handle_t rate_mutex;               /*Protect rate applied to next sent frame*/
+    uint32_t rate_Lcod;                /*Bytes per frame, set by svt_jpeg_xs_encoder_set_rate()*/
+    RateControlType rate_control_mode; /*Set by svt_jpeg_xs_encoder_set_rate()*/
+
+    svt_jpeg_xs_allocator_t allocator; /*Copy of user allocator, alloc == NULL - system allocator*/
+
     // picture control set pool
     SystemResource_t *picture_control_set_pool_ptr;
 
@@ -48,6 +65,8 @@ typedef struct svt_jpeg_xs_encoder_api_prv {
 
     uint32_t dwt_stage_threads_num;
     uint32_t pack_stage_threads_num;
+    uint32_t input_buffer_fifo_count;        /*Frames waiting in input queue*/
+    uint32_t picture_control_set_pool_count; /*Frames processed at once*/
 
     ObjectWrapper_t **sync_output_ringbuffer; //Array of pointers to reorder output
     uint32_t sync_output_ringbuffer_size;
@@ -73,6 +92,7 @@ typedef struct svt_jpeg_xs_encoder_api_prv {
     SystemResource_t *dwt_input_resource_ptr;
     SystemResource_t *pack_input_resource_ptr;
     SystemResource_t *pack_output_resource_ptr;
+    SystemResource_t *pack_slice_slot_resource_ptr; /*Only when enc_common.slice_parts_num > 1*/
 
     SystemResource_t *output_queue_resource_ptr;
     Fifo_t *output_queue_producer_fifo_ptr;
@@ -81,4 +101,8 @@ typedef struct svt_jpeg_xs_encoder_api_prv {
     uint64_t frame_number;
 } svt_jpeg_xs_encoder_api_prv_t;
 
+/*Store statistics of finished frame and call user callbacks, call only from final stage.*/
+void encoder_stats_publish(svt_jpeg_xs_encoder_api_prv_t *enc_api_prv, const svt_jpeg_xs_frame_stats_t *stats,
+                           const svt_jpeg_xs_rate_stats_t *rate_stats);
+
 #endif /*_ENCODER_HANDLE_H_*/
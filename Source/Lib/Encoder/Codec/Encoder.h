@@ -67,6 +67,7 @@ typedef struct svt_jpeg_xs_encoder_common {
 
     pi_t pi; /* Picture Information */
     picture_header_dynamic_t picture_header_dynamic;
+    uint8_t dwt_16bit_lanes; /* Components without vertical decomposition calculate DWT on 16bit lanes*/
     pi_enc_t pi_enc; /* Picture Information for encoder, allocate buffers pointers etc.*/
 
     RateControlType rate_control_mode;
@@ -93,11 +94,15 @@ typedef struct svt_jpeg_xs_encoder_common {
     */
     uint8_t frame_header_buffer[256];
 
-    /*
-    * Array that keep size of each coded slice
-    */
-    uint32_t *slice_sizes;
     uint8_t slice_packetization_mode;
+    uint8_t stats_enable; /*Collect per frame statistics in stages*/
+    /*Pack tasks per slice, more than 1 when precincts of slice without vertical decomposition are calculated in parallel*/
+    uint32_t slice_parts_num;
+    /*Contiguous slices per pack task, more than 1 with chunked slice scheduling*/
+    uint32_t slices_per_pack_task;
+    struct EncBatch* batch;                     /*Slices are calculated on threads of batch, NULL when on own pack threads*/
+    struct ThreadContext** batch_pack_contexts; /*Pack context of encoder for every thread of batch*/
+    uint32_t batch_closing; /*Set by close before shutdown, threads of batch skip tasks and do not wait for pack outputs*/
 } svt_jpeg_xs_encoder_common_t;
 
 #ifdef __cplusplus
@@ -59,6 +59,10 @@ SvtJxsErrorType_t final_stage_context_ctor(ThreadContext_t *thread_contxt_ptr, s
     return SvtJxsErrorNone;
 }
 
+void final_stage_context_memory(SvtMemSize_t *mem) {
+    svt_jxs_mem_size_add(mem, sizeof(FinalStageContext), SVT_JXS_MEM_GENERAL);
+}
+
 /* Final Stage Kernel */
 /*********************************************************************************
  *
@@ -108,6 +112,7 @@ void *final_stage_kernel(void *input_ptr) {
         SVT_GET_FULL_OBJECT(context_ptr->input_buffer_fifo_ptr, &input_wrapper_ptr);
 
         pack_result = (PackOutput *)input_wrapper_ptr->object_ptr;
+        uint64_t stats_time_begin_us = enc_api_prv->enc_common.stats_enable ? svt_jxs_get_time_us() : 0;
 
         if (pack_result->pcs_wrapper_ptr == NULL) {
             fprintf(stderr, "FATAL ERROR [%s:%i] Final thread pcs_wrapper_ptr is NULL\n", __func__, __LINE__);
@@ -118,6 +123,34 @@ void *final_stage_kernel(void *input_ptr) {
         pcs_ptr = (PictureControlSet *)pack_result->pcs_wrapper_ptr->object_ptr;
         pcs_ptr->slice_cnt++;
         pcs_ptr->frame_error |= pack_result->slice_error;
+        if (pcs_ptr->enc_common->stats_enable) {
+            svt_jpeg_xs_frame_stats_t *stats = &pcs_ptr->stats;
+            if (stats->slices_num == 0 || pack_result->slice_time_us < stats->slice_time_min_us) {
+                stats->slice_time_min_us = pack_result->slice_time_us;
+            }
+            stats->slice_time_max_us = MAX(stats->slice_time_max_us, pack_result->slice_time_us);
+            stats->stage_time_us[SVT_JXS_STAGE_SLICE] += pack_result->slice_time_us;
+            stats->rc_iterations += pack_result->rc_iterations;
+            stats->rc_iterations_max = MAX(stats->rc_iterations_max, pack_result->rc_iterations);
+            stats->slices_num++;
+
+            svt_jpeg_xs_rate_stats_t *rate_stats = &pcs_ptr->rate_stats;
+            svt_jpeg_xs_slice_rate_stats_t *slice_stats = &rate_stats->slices[pack_result->slice_idx];
+            slice_stats->bytes = pcs_ptr->slice_sizes[pack_result->slice_idx];
+            slice_stats->padding_bytes = pack_result->padding_bytes;
+            slice_stats->distortion = pack_result->distortion;
+            rate_stats->padding_bytes += pack_result->padding_bytes;
+            rate_stats->distortion += pack_result->distortion;
+            const pi_t *pi = &pcs_ptr->enc_common->pi;
+            for (uint32_t c = 0; c < pi->comps_num; c++) {
+                for (uint32_t b = 0; b < pi->components[c].bands_num; b++) {
+                    for (uint32_t gtli = 0; gtli <= TRUNCATION_MAX; gtli++) {
+                        rate_stats->gtli_histogram[c][b][gtli] += pack_result->gtli_histogram[c][b][gtli];
+                    }
+                }
+            }
+            stats->stage_time_us[SVT_JXS_STAGE_FINAL] += svt_jxs_get_time_us() - stats_time_begin_us;
+        }
 
 #ifdef FLAG_DEADLOCK_DETECT
         printf("Receive Frame=%llu slice_idx=%d\n", pcs_ptr->frame_number, pack_result->slice_idx);
@@ -184,7 +217,7 @@ void *final_stage_kernel(void *input_ptr) {
                     EncoderOutputItem *output_item = (EncoderOutputItem *)output_item_wrapper_ptr->object_ptr;
                     output_item->enc_input = pcs_ring->enc_input; //Copy structure
                     output_item->enc_input.bitstream.buffer += pcs_ring->bitstream_release_offset;
-                    output_item->enc_input.bitstream.used_size = pcs_ring->enc_common->slice_sizes[pcs_ring->slice_released_idx];
+                    output_item->enc_input.bitstream.used_size = pcs_ring->slice_sizes[pcs_ring->slice_released_idx];
                     pcs_ring->bitstream_release_offset += output_item->enc_input.bitstream.used_size;
                     output_item->enc_input.bitstream.last_packet_in_frame = 0;
                     output_item->enc_input.bitstream.ready_to_release = 0;
@@ -213,6 +246,7 @@ void *final_stage_kernel(void *input_ptr) {
             }
 
             if (pcs_ring->slice_cnt == pcs_ring->enc_common->pi.slice_num) {
+                uint64_t stats_time_output_us = pcs_ring->enc_common->stats_enable ? svt_jxs_get_time_us() : 0;
                 if (!pcs_ring->enc_common->slice_packetization_mode) {
 #ifdef FLAG_DEADLOCK_DETECT
                     printf("08[%s:%i] Return full frame: %llu\n", __func__, __LINE__, pcs_ring->frame_number);
@@ -238,6 +272,19 @@ void *final_stage_kernel(void *input_ptr) {
                     }
                 }
 
+                if (pcs_ring->enc_common->stats_enable) {
+                    svt_jpeg_xs_frame_stats_t *stats = &pcs_ring->stats;
+                    for (uint32_t c = 0; c < MAX_COMPONENTS_NUM; c++) {
+                        stats->stage_time_us[SVT_JXS_STAGE_DWT] += pcs_ring->stats_dwt_time_us[c];
+                    }
+                    uint64_t time_us = svt_jxs_get_time_us();
+                    stats->stage_time_us[SVT_JXS_STAGE_FINAL] += time_us - stats_time_output_us;
+                    stats->latency_us = time_us - pcs_ring->stats_time_send_us;
+                    stats->output_queue_depth = svt_jxs_system_resource_get_full_objects_num(
+                        enc_api_prv->output_queue_resource_ptr);
+                    encoder_stats_publish(enc_api_prv, stats, &pcs_ring->rate_stats);
+                }
+
                 //Release the pcs wrapper
                 svt_jxs_release_object(pcs_ring_wrapper_ptr);
                 /* Release the input picture
@@ -24,6 +24,8 @@ SvtJxsErrorType_t output_item_creator(void_ptr *object_dbl_ptr, void_ptr object_
 void output_item_destroyer(void_ptr p);
 
 SvtJxsErrorType_t final_stage_context_ctor(ThreadContext_t *thread_context_ptr, svt_jpeg_xs_encoder_api_prv_t *enc_api_prv);
+/*Memory allocated by final_stage_context_ctor()*/
+void final_stage_context_memory(SvtMemSize_t *mem);
 
 extern void *final_stage_kernel(void *input_ptr);
 #ifdef __cplusplus
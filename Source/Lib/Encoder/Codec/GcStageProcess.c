@@ -111,7 +111,9 @@ void precinct_component_calculate_dwt_V0(struct PictureControlSet* pcs_ptr, prec
 
     uint16_t* buffer_out_16bit = (uint16_t*)precinct->coeff_buff_ptr_16bit[comp_id];
 
-    transform_V0_ptr_t transform_V0_Hn = transform_V0_get_function_ptr(pi->components[comp_id].decom_h);
+    transform_V0_ptr_t transform_V0_Hn = enc_common->dwt_16bit_lanes
+        ? transform_V0_Hx_16bit
+        : transform_V0_get_function_ptr(pi->components[comp_id].decom_h);
     assert(transform_V0_Hn != NULL);
     //transform_V0_H1, transform_V0_H2, transform_V0_H3, transform_V0_H4, transform_V0_H5
     transform_V0_Hn(component,
@@ -856,6 +858,28 @@ SvtJxsErrorType_t buffers_components_allocate(struct precinct_calc_dwt_buff_per_
     return SvtJxsErrorNone;
 }
 
+void buffers_components_memory(SvtMemSize_t* mem, const pi_t* pi) {
+    uint8_t decom_V1_exist = 0;
+    uint8_t decom_V2_exist = 0;
+    for (uint32_t i = 0; i < pi->comps_num; ++i) {
+        if (pi->components[i].decom_v == 1) {
+            decom_V1_exist = 1;
+        }
+        else if (pi->components[i].decom_v == 2) {
+            decom_V2_exist = 1;
+        }
+    }
+
+    size_t size = 0;
+    if (decom_V1_exist) {
+        size += pi->comps_num * (2 * pi->width * sizeof(int32_t));
+    }
+    if (decom_V2_exist) {
+        size += pi->comps_num * ((pi->width + (pi->width + 1) + 3 * pi->width / 2) * sizeof(int32_t));
+    }
+    svt_jxs_mem_size_add(mem, size, SVT_JXS_MEM_GENERAL);
+}
+
 void buffers_components_free(struct precinct_calc_dwt_buff_per_component* buffers_dwt_per_component) {
     for (uint32_t c = 0; c < MAX_COMPONENTS_NUM; ++c) {
         SVT_FREE(buffers_dwt_per_component->V1[c].in_tmp_line_HF_prev);
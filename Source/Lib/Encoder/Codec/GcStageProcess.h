@@ -71,6 +71,8 @@ struct precinct_calc_dwt_buff_tmp {
 };
 
 SvtJxsErrorType_t buffers_components_allocate(struct precinct_calc_dwt_buff_per_component* buffers_dwt_per_component, pi_t* pi);
+/*Memory allocated by buffers_components_allocate()*/
+void buffers_components_memory(SvtMemSize_t* mem, const pi_t* pi);
 void buffers_components_free(struct precinct_calc_dwt_buff_per_component* buffers_dwt_per_component);
 
 void precinct_component_calculate_dwt_V1_precalculate_slice(
@@ -21,6 +21,7 @@
 typedef struct InitStageContext {
     Fifo_t *dwt_stage_input_fifo_ptr;
     Fifo_t *pack_input_buffer_fifo_ptr;
+    Fifo_t *pack_slice_slot_fifo_ptr; /*NULL when slice is not split to parts*/
     Fifo_t *picture_control_set_fifo_ptr;
     svt_jpeg_xs_encoder_api_prv_t *enc_api_prv;
 } InitStageContext;
@@ -76,12 +77,20 @@ SvtJxsErrorType_t init_stage_context_ctor(ThreadContext_t *thread_contxt_ptr, sv
         context_ptr->pack_input_buffer_fifo_ptr = svt_jxs_system_resource_get_producer_fifo(enc_api_prv->pack_input_resource_ptr,
                                                                                             0);
     }
+    if (enc_common->slice_parts_num > 1) {
+        context_ptr->pack_slice_slot_fifo_ptr = svt_jxs_system_resource_get_producer_fifo(
+            enc_api_prv->pack_slice_slot_resource_ptr, 0);
+    }
 
     context_ptr->enc_api_prv = enc_api_prv;
 
     return error;
 }
 
+void init_stage_context_memory(SvtMemSize_t *mem) {
+    svt_jxs_mem_size_add(mem, sizeof(InitStageContext), SVT_JXS_MEM_GENERAL);
+}
+
 #ifndef NDEBUG
 static int32_t validate_yuv_range(pi_t *pi, svt_jpeg_xs_image_buffer_t *image_buffer, uint8_t input_bit_depth, uint64_t frame,
                                   ColourFormat_t format) {
@@ -186,6 +195,17 @@ void *init_stage_kernel(void *input_ptr) {
         pcs_ptr->slice_cnt = 0;
         pcs_ptr->frame_error = 0;
 
+        uint64_t stats_time_begin_us = 0;
+        if (pcs_ptr->enc_common->stats_enable) {
+            memset(&pcs_ptr->stats, 0, sizeof(pcs_ptr->stats));
+            memset(pcs_ptr->stats_dwt_time_us, 0, sizeof(pcs_ptr->stats_dwt_time_us));
+            pcs_ptr->stats.frame_num = input_item->frame_number;
+            pcs_ptr->stats.input_queue_depth = svt_jxs_system_resource_get_full_objects_num(
+                enc_api_prv->input_image_resource_ptr);
+            pcs_ptr->stats_time_send_us = input_item->time_send_us;
+            stats_time_begin_us = svt_jxs_get_time_us();
+        }
+
         if (pcs_ptr->enc_common->slice_packetization_mode) {
             memset(pcs_ptr->slice_ready_to_release_arr, 0, pi->slice_num);
             pcs_ptr->slice_released_idx = 0;
@@ -194,6 +214,19 @@ void *init_stage_kernel(void *input_ptr) {
         // assign wavelet transformation buf
         pcs_ptr->enc_input = input_item->enc_input;
         pcs_ptr->frame_number = input_item->frame_number;
+        pcs_ptr->rate_control_mode = input_item->rate_control_mode;
+        if (pcs_ptr->Lcod != input_item->Lcod) {
+            pcs_ptr->Lcod = input_item->Lcod;
+            pre_rc_calculate_slice_sizes(pcs_ptr->enc_common, pcs_ptr->Lcod, pcs_ptr->slice_sizes);
+        }
+        if (stats_time_begin_us) {
+            memset(&pcs_ptr->rate_stats, 0, sizeof(pcs_ptr->rate_stats));
+            pcs_ptr->rate_stats.frame_num = input_item->frame_number;
+            pcs_ptr->rate_stats.bytes = pcs_ptr->Lcod;
+            pcs_ptr->rate_stats.slices_num = pi->slice_num;
+            pcs_ptr->rate_stats.slices_alloc = pi->slice_num;
+            pcs_ptr->rate_stats.slices = pcs_ptr->rate_stats_slices;
+        }
 
         //Locking bitstream buffer
         pcs_ptr->enc_input.bitstream.ready_to_release = 0;
@@ -209,6 +242,11 @@ void *init_stage_kernel(void *input_ptr) {
         }
 #endif
 
+        if (stats_time_begin_us) {
+            /*Only setup of frame, after slices are scheduled PCS can be read by final stage*/
+            pcs_ptr->stats.stage_time_us[SVT_JXS_STAGE_INIT] = svt_jxs_get_time_us() - stats_time_begin_us;
+        }
+
         svt_jxs_wait_cond_var(sync_output_ringbuffer_left, 0); //Wait until will be free place in ring buffer
         svt_jxs_add_cond_var(sync_output_ringbuffer_left, -1); //Decrement number of elements to use.
 
@@ -216,7 +254,7 @@ void *init_stage_kernel(void *input_ptr) {
         if (pcs_ptr->enc_common->cpu_profile == CPU_PROFILE_CPU) {
             //CPU
             PackInput_t *list_slices = pre_rc_send_frame_to_pack_slices(
-                pcs_ptr, context_ptr->pack_input_buffer_fifo_ptr, input_item->frame_number, pcs_wrapper_ptr);
+                pcs_ptr, context_ptr->pack_input_buffer_fifo_ptr, NULL, input_item->frame_number, pcs_wrapper_ptr);
 #ifndef NDEBUG
             if (pi->decom_v != 0) {
                 volatile PackInput_t *list_slice_next_tmp = list_slices;
@@ -251,8 +289,11 @@ void *init_stage_kernel(void *input_ptr) {
         else {
             assert(pcs_ptr->enc_common->cpu_profile == CPU_PROFILE_LOW_LATENCY);
             //LOW LATENCY
-            pre_rc_send_frame_to_pack_slices(
-                pcs_ptr, context_ptr->pack_input_buffer_fifo_ptr, input_item->frame_number, pcs_wrapper_ptr);
+            pre_rc_send_frame_to_pack_slices(pcs_ptr,
+                                             context_ptr->pack_input_buffer_fifo_ptr,
+                                             context_ptr->pack_slice_slot_fifo_ptr,
+                                             input_item->frame_number,
+                                             pcs_wrapper_ptr);
         }
 
         svt_jxs_release_object(input_wrapper_ptr);
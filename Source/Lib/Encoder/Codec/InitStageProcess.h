@@ -7,12 +7,16 @@
 #define _INIT_STAGE_H_
 
 #include "Definitions.h"
+#include "Encoder.h"
 #ifdef __cplusplus
 extern "C" {
 #endif
 
 typedef struct {
     uint64_t frame_number;
+    uint64_t time_send_us; /*Set only when stats_enable*/
+    uint32_t Lcod;         /*Rate of frame at time of send*/
+    RateControlType rate_control_mode;
     svt_jpeg_xs_frame_t enc_input;
 } EncoderInputItem;
 
@@ -23,6 +27,8 @@ SvtJxsErrorType_t input_item_creator(void_ptr *object_dbl_ptr, void_ptr object_i
 void input_item_destroyer(void_ptr p);
 
 SvtJxsErrorType_t init_stage_context_ctor(ThreadContext_t *thread_contxt_ptr, svt_jpeg_xs_encoder_api_prv_t *enc_api_prv);
+/*Memory allocated by init_stage_context_ctor()*/
+void init_stage_context_memory(SvtMemSize_t *mem);
 
 extern void *init_stage_kernel(void *input_ptr);
 #ifdef __cplusplus
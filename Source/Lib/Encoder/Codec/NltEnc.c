@@ -8,6 +8,7 @@
 #include "encoder_dsp_rtcd.h"
 #include "EncDec.h"
 #include <assert.h>
+#include <math.h>
 
 void image_shift_c(uint16_t* out_coeff_16bit, int32_t* in_coeff_32bit, uint32_t width, int32_t shift, int32_t offset) {
     //Part of insert_coefficients
@@ -30,6 +31,25 @@ void image_shift_c(uint16_t* out_coeff_16bit, int32_t* in_coeff_32bit, uint32_t
     }
 }
 
+/*Same as image_shift_c() for DWT calculated on 16bit lanes*/
+void image_shift_from_16bit_c(uint16_t* out_coeff_16bit, const int16_t* in_coeff_16bit, uint32_t width, int32_t shift,
+                              int32_t offset) {
+    for (uint32_t i = 0; i < width; i++) {
+        int32_t val = in_coeff_16bit[i];
+        if (val >= 0) {
+            val = (val + offset) >> shift;
+        }
+        else {
+            val = ((-val + offset) >> shift);
+            if (val) {
+                //Avoid keep -0 value
+                val |= BITSTREAM_MASK_SIGN;
+            }
+        }
+        out_coeff_16bit[i] = val;
+    }
+}
+
 void linear_input_scaling_line_8bit_c(const uint8_t* src, int32_t* dst, uint32_t w, uint8_t shift, int32_t offset) {
     for (uint32_t j = 0; j < w; j++) {
         dst[j] = (int32_t)((uint32_t)src[j] << shift) - (int32_t)offset;
@@ -44,6 +64,20 @@ void linear_input_scaling_line_16bit_c(const uint16_t* src, int32_t* dst, uint32
     }
 }
 
+void linear_input_scaling_line_8bit_to_16bit_c(const uint8_t* src, int16_t* dst, uint32_t w, uint8_t shift, int16_t offset) {
+    for (uint32_t j = 0; j < w; j++) {
+        dst[j] = (int16_t)((src[j] << shift) - offset);
+    }
+}
+
+void linear_input_scaling_line_16bit_to_16bit_c(const uint16_t* src, int16_t* dst, uint32_t w, uint8_t shift, int16_t offset,
+                                                uint8_t bit_depth) {
+    uint16_t input_mask = (1 << bit_depth) - 1;
+    for (uint32_t j = 0; j < w; j++) {
+        dst[j] = (int16_t)(((src[j] & input_mask) << shift) - offset);
+    }
+}
+
 void linear_input_scaling_line(const void* src, int32_t* dst, uint32_t width, uint8_t input_bit_depth, uint8_t shift,
                                int32_t offset) {
     if (input_bit_depth <= 8) {
@@ -55,6 +89,40 @@ void linear_input_scaling_line(const void* src, int32_t* dst, uint32_t width, ui
     }
 }
 
+/*Half-float linear input, value 0.0 to 1.0 is mapped to (2^bit_depth - 1) before quadratic non-linearity.
+ *Negative values and NaN are clipped to 0, values above 1.0 and infinity are clipped to 1.0.
+ *Inverse of decoder: y = (v^2 + 2^(dzeta-1)) >> dzeta where dzeta = 2*Bw - bit_depth, DC offset is 0.*/
+void quadratic_input_scaling_line_fp16_c(const uint16_t* src, int32_t* dst, uint32_t w, uint8_t bw, uint8_t bit_depth) {
+    const double max_val = (double)((1 << bw) - 1);
+    const int32_t offset = 1 << (bw - 1);
+    const int32_t dzeta = 2 * bw - bit_depth;
+    /*Half-float value is mantissa * 2^(exponent - 25), subnormals have exponent 1 without implicit bit.
+     *Products of mantissa and scale are exact in double, so result is rounded only once by sqrt().*/
+    double exponent_scale[16];
+    for (int32_t e = 0; e < 16; e++) {
+        exponent_scale[e] = ldexp((double)((1 << bit_depth) - 1), dzeta - 25 + (e ? e : 1));
+    }
+    for (uint32_t j = 0; j < w; j++) {
+        const uint16_t h = src[j];
+        uint32_t exponent = (h >> 10) & 0x1F;
+        uint32_t mantissa = h & 0x3FF;
+        double v = 0;
+        if (!(h & 0x8000) && !(exponent == 0x1F && mantissa)) {
+            if (exponent >= 15) {
+                /*Clip to 1.0*/
+                exponent = 15;
+                mantissa = 0;
+            }
+            if (exponent) {
+                mantissa |= 0x400;
+            }
+            v = sqrt(mantissa * exponent_scale[exponent]) + 0.5;
+            v = v > max_val ? max_val : v;
+        }
+        dst[j] = (int32_t)v - offset;
+    }
+}
+
 void nlt_input_scaling_line(const void* src, int32_t* dst, uint32_t width, picture_header_dynamic_t* hdr,
                             uint8_t input_bit_depth) {
     const uint8_t shift = hdr->hdr_Bw - input_bit_depth;
@@ -64,9 +132,29 @@ void nlt_input_scaling_line(const void* src, int32_t* dst, uint32_t width, pictu
         linear_input_scaling_line(src, dst, width, input_bit_depth, shift, offset);
         break;
     case 1:
+        /*Quadratic non-linearity is used only for half-float input*/
+        assert(input_bit_depth == 16 && hdr->hdr_Tnlt_sigma == 0 && hdr->hdr_Tnlt_alpha == 0);
+        quadratic_input_scaling_line_fp16_c((const uint16_t*)src, dst, width, hdr->hdr_Bw, input_bit_depth);
+        break;
     case 2:
     default:
         assert(0);
         break;
     }
 }
+
+/*Scale input to DWT_16BIT_INPUT_BITS instead of Bw, the lowest (Bw - DWT_16BIT_INPUT_BITS) bits are skipped
+ * because in linear mode they are always zero.*/
+void nlt_input_scaling_line_to_16bit(const void* src, int16_t* dst, uint32_t width, picture_header_dynamic_t* hdr,
+                                     uint8_t input_bit_depth) {
+    assert(hdr->hdr_Tnlt == 0 && input_bit_depth <= DWT_16BIT_INPUT_BITS);
+    UNUSED(hdr);
+    const uint8_t shift = DWT_16BIT_INPUT_BITS - input_bit_depth;
+    const int16_t offset = 1 << (DWT_16BIT_INPUT_BITS - 1);
+    if (input_bit_depth <= 8) {
+        linear_input_scaling_line_8bit_to_16bit((uint8_t*)src, dst, width, shift, offset);
+    }
+    else {
+        linear_input_scaling_line_16bit_to_16bit((uint16_t*)src, dst, width, shift, offset, input_bit_depth);
+    }
+}
@@ -18,6 +18,17 @@ void nlt_input_scaling_line(const void* src, int32_t* dst, uint32_t width, pictu
 void linear_input_scaling_line_8bit_c(const uint8_t* src, int32_t* dst, uint32_t w, uint8_t shift, int32_t offset);
 void linear_input_scaling_line_16bit_c(const uint16_t* src, int32_t* dst, uint32_t w, uint8_t shift, int32_t offset,
                                        uint8_t bit_depth);
+void quadratic_input_scaling_line_fp16_c(const uint16_t* src, int32_t* dst, uint32_t w, uint8_t bw, uint8_t bit_depth);
+
+/*DWT on 16bit lanes, see dwt_16bit_supported()*/
+#define DWT_16BIT_INPUT_BITS (14)
+void image_shift_from_16bit_c(uint16_t* out_coeff_16bit, const int16_t* in_coeff_16bit, uint32_t width, int32_t shift,
+                              int32_t offset);
+void nlt_input_scaling_line_to_16bit(const void* src, int16_t* dst, uint32_t width, picture_header_dynamic_t* hdr,
+                                     uint8_t input_bit_depth);
+void linear_input_scaling_line_8bit_to_16bit_c(const uint8_t* src, int16_t* dst, uint32_t w, uint8_t shift, int16_t offset);
+void linear_input_scaling_line_16bit_to_16bit_c(const uint16_t* src, int16_t* dst, uint32_t w, uint8_t shift, int16_t offset,
+                                                uint8_t bit_depth);
 
 #ifdef __cplusplus
 }
@@ -18,7 +18,7 @@ void write_capabilities_marker(bitstream_writer_t* bitstream, svt_jpeg_xs_encode
     uint8_t support_420 = enc_common->colour_format == COLOUR_FORMAT_PLANAR_YUV420;
     capability[0] = 0;           //Unused
     capability[1] = 0;           //Support for Star-Tetrix transform and CTS marker required
-    capability[2] = 0;           //Support for quadratic non-linear transform required
+    capability[2] = enc_common->picture_header_dynamic.hdr_Tnlt == 1; //Support for quadratic non-linear transform required
     capability[3] = 0;           //Support for extended non-linear transform required
     capability[4] = support_420; //0: sy[i] = 1 for all components i 1: component i with sy[i]>1 present
     capability[5] = 0;           //Support for component-dependent wavelet decomposition required
@@ -88,6 +88,14 @@ void write_component_table(bitstream_writer_t* bitstream, pi_t* pi, uint8_t bit_
     }
 }
 
+void write_nonlinearity_marker(bitstream_writer_t* bitstream, picture_header_dynamic_t* hdr) {
+    assert(hdr->hdr_Tnlt == 1);
+    write_16_bits(bitstream, CODESTREAM_NLT);
+    write_16_bits(bitstream, 5);
+    write_8_bits(bitstream, hdr->hdr_Tnlt);
+    write_16_bits(bitstream, (uint16_t)((hdr->hdr_Tnlt_sigma << 15) | (hdr->hdr_Tnlt_alpha & 0x7FFF))); //sigma, alpha
+}
+
 void write_slice_header(bitstream_writer_t* bitstream, int slice_idx) {
     write_16_bits(bitstream, CODESTREAM_SLH);
     write_16_bits(bitstream, 4);
@@ -136,5 +144,8 @@ void write_header(bitstream_writer_t* bitstream, svt_jpeg_xs_encoder_common_t* e
     write_picture_header(bitstream, &enc_common->pi, enc_common);
     write_component_table(bitstream, &enc_common->pi, enc_common->bit_depth);
     write_weight_table(bitstream, &enc_common->pi);
+    if (enc_common->picture_header_dynamic.hdr_Tnlt) {
+        write_nonlinearity_marker(bitstream, &enc_common->picture_header_dynamic);
+    }
     align_bitstream_writer_to_next_byte(bitstream);
 }
@@ -20,6 +20,7 @@ void write_capabilities_marker(bitstream_writer_t* bitstream, svt_jpeg_xs_encode
 void write_picture_header(bitstream_writer_t* bitstream, pi_t* pi, svt_jpeg_xs_encoder_common_t* enc_common);
 void write_weight_table(bitstream_writer_t* bitstream, pi_t* pi);
 void write_component_table(bitstream_writer_t* bitstream, pi_t* pi, uint8_t bit_depth);
+void write_nonlinearity_marker(bitstream_writer_t* bitstream, picture_header_dynamic_t* hdr);
 void write_slice_header(bitstream_writer_t* bitstream, int slice_idx);
 uint32_t write_packet_header(bitstream_writer_t* bitstream, uint32_t long_hdr, uint8_t raw_coding, uint64_t data_size_bytes,
                              uint64_t bitplane_count_size_bytes, uint64_t sign_size_bytes);
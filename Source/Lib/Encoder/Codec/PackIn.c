@@ -6,7 +6,9 @@
 #include <stdlib.h>
 #include "PackIn.h"
 #include "Encoder.h"
+#include "EncHandle.h"
 #include "Threads/SvtThreads.h"
+#include "PackStageProcess.h"
 
 void pack_input_dctor(void_ptr p) {
     PackInput_t* object_ptr = (PackInput_t*)p;
@@ -41,3 +43,40 @@ SvtJxsErrorType_t pack_input_creator(void_ptr* object_dbl_ptr, void_ptr object_i
 
     return SvtJxsErrorNone;
 }
+
+void pack_input_memory(SvtMemSize_t* mem, const svt_jpeg_xs_encoder_common_t* enc_common) {
+    size_t size = sizeof(PackInput_t);
+    if (enc_common->cpu_profile == CPU_PROFILE_CPU) {
+        size += svt_jxs_semaphore_memory();
+    }
+    svt_jxs_mem_size_add(mem, size, SVT_JXS_MEM_GENERAL);
+}
+
+static void pack_slice_slot_dctor(void_ptr p) {
+    PackSliceSlot_t* object_ptr = (PackSliceSlot_t*)p;
+    SVT_FREE(object_ptr->parts_time_us);
+    svt_jxs_arena_dctor(&object_ptr->precincts_arena);
+}
+
+static SvtJxsErrorType_t pack_slice_slot_ctor(PackSliceSlot_t* object_ptr, void_ptr object_init_data_ptr) {
+    svt_jpeg_xs_encoder_common_t* enc_common = object_init_data_ptr;
+    object_ptr->dctor = pack_slice_slot_dctor;
+    SVT_CALLOC_ARRAY(object_ptr->parts_time_us, enc_common->slice_parts_num);
+    return pack_precincts_alloc(
+        &object_ptr->precincts_arena, enc_common, enc_common->pi.precincts_per_slice, &object_ptr->precincts);
+}
+
+SvtJxsErrorType_t pack_slice_slot_creator(void_ptr* object_dbl_ptr, void_ptr object_init_data_ptr) {
+    PackSliceSlot_t* obj;
+
+    *object_dbl_ptr = NULL;
+    SVT_NEW(obj, pack_slice_slot_ctor, object_init_data_ptr);
+    *object_dbl_ptr = obj;
+
+    return SvtJxsErrorNone;
+}
+
+void pack_slice_slot_memory(SvtMemSize_t* mem, const svt_jpeg_xs_encoder_common_t* enc_common) {
+    svt_jxs_mem_size_add(mem, sizeof(PackSliceSlot_t) + enc_common->slice_parts_num * sizeof(uint64_t), SVT_JXS_MEM_GENERAL);
+    pack_precincts_memory(mem, enc_common, enc_common->pi.precincts_per_slice);
+}
@@ -10,6 +10,9 @@
 #include "Threads/SvtObject.h"
 #include "Threads/SystemResourceManager.h"
 #include "Pi.h"
+#include "PrecinctEnc.h"
+#include "Threads/SvtArena.h"
+#include "Encoder.h"
 
 #ifdef __cplusplus
 extern "C" {
@@ -22,6 +25,7 @@ typedef struct PackInput {
     DctorCall dctor;
     ObjectWrapper_t* pcs_wrapper_ptr;
     uint32_t slice_idx;
+    uint32_t slices_num; /*Contiguous slices from slice_idx calculated one by one in this task*/
     uint32_t slice_budget_bytes;
     uint32_t out_bytes_begin;
     uint32_t out_bytes_end;
@@ -32,12 +36,31 @@ typedef struct PackInput {
     volatile struct PackInput* sync_dwt_list_next; //One direction list to get next pack task in frame
     Handle_t sync_dwt_semaphore;
     volatile uint32_t sync_dwt_component_done_flag[MAX_COMPONENTS_NUM];
+
+    /*Slice split to many pack tasks, NULL when one task calculate whole slice.*/
+    ObjectWrapper_t* slice_slot_wrapper_ptr;
+    uint32_t slice_part_idx;
 } PackInput_t;
 
+/**************************************
+ * Precincts of slice shared by pack tasks of slice parts
+ **************************************/
+typedef struct PackSliceSlot {
+    DctorCall dctor;
+    precinct_enc_t* precincts;
+    SvtArena_t precincts_arena;   /*Owns precincts and buffers of precincts*/
+    uint64_t* parts_time_us;      /*Time of every part, set only when stats_enable*/
+    volatile uint32_t parts_left; /*Last finished part calculate RC and pack of slice*/
+} PackSliceSlot_t;
+
 /**************************************
  * Extern Function Declarations
  **************************************/
 extern SvtJxsErrorType_t pack_input_creator(void_ptr* object_dbl_ptr, void_ptr object_init_data_ptr);
+extern SvtJxsErrorType_t pack_slice_slot_creator(void_ptr* object_dbl_ptr, void_ptr object_init_data_ptr);
+/*Memory allocated by pack_input_creator() and pack_slice_slot_creator()*/
+extern void pack_input_memory(SvtMemSize_t* mem, const svt_jpeg_xs_encoder_common_t* enc_common);
+extern void pack_slice_slot_memory(SvtMemSize_t* mem, const svt_jpeg_xs_encoder_common_t* enc_common);
 
 #ifdef __cplusplus
 }
@@ -7,6 +7,7 @@
 #define PackOut_h
 
 #include "Definitions.h"
+#include "EncDec.h"
 #include "Threads/SvtObject.h"
 #include "Threads/SystemResourceManager.h"
 #ifdef __cplusplus
@@ -20,6 +21,12 @@ typedef struct PackOutput {
     ObjectWrapper_t *pcs_wrapper_ptr;
     uint32_t slice_idx;
     SvtJxsErrorType_t slice_error;
+    uint64_t slice_time_us; /*Set only when stats_enable*/
+    uint32_t rc_iterations; /*Set only when stats_enable*/
+    /*Rate statistics of slice, set only when stats_enable*/
+    uint32_t padding_bytes;
+    uint64_t distortion;
+    uint16_t gtli_histogram[MAX_COMPONENTS_NUM][MAX_BANDS_PER_COMPONENT_NUM][TRUNCATION_MAX + 1];
 } PackOutput;
 
 typedef struct PackOutputInitData {
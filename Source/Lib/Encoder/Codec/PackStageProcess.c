@@ -27,6 +27,7 @@
 #include "GcStageProcess.h"
 #include "PackIn.h"
 #include "Threads/SvtThreads.h"
+#include "Threads/SvtArena.h"
 
 #define PRINT_BUDGET 0
 
@@ -35,15 +36,25 @@
 #define TUNING_RC_CBR_PER_PRECINCT_MOVE_PADDING_FIRST_PREC_BIGGER_WITH_SIGN_LAZY_PERCENT (20)
 #define TUNING_RC_CBR_PER_SLICE_MAX_PRECINCT_BUDGET_RATE                                 (4)
 
+#if SVT_JXS_BANDS_PER_COMPONENT_MAX != MAX_BANDS_PER_COMPONENT_NUM || SVT_JXS_GTLI_VALUES_NUM != TRUNCATION_MAX + 1
+#error "Size of GTLI histogram in svt_jpeg_xs_rate_stats_t does not match encoder"
+#endif
+
 typedef struct PackStageContext {
     svt_jpeg_xs_encoder_common_t* enc_common;
     Fifo_t* input_buffer_fifo_ptr;
     Fifo_t* output_buffer_fifo_ptr;
     uint32_t num_alloc_precincts_per_thread;
     precinct_enc_t* temp_precincts_in_slice;
+    SvtArena_t precincts_arena; /*Owns temp_precincts_in_slice and buffers of precincts*/
 
     struct precinct_calc_dwt_buff_tmp buffers_dwt_tmp;                     //Only for profile Latency
     struct precinct_calc_dwt_buff_per_component buffers_dwt_per_component; //Only for profile Latency
+
+    /*Rate statistics of actual slice, only when stats_enable*/
+    uint32_t stats_padding_bytes;
+    uint64_t stats_distortion;
+    uint16_t stats_gtli_histogram[MAX_COMPONENTS_NUM][MAX_BANDS_PER_COMPONENT_NUM][TRUNCATION_MAX + 1];
 } PackStageContext;
 
 static void pack_stage_context_dctor(void_ptr p) {
@@ -53,27 +64,6 @@ static void pack_stage_context_dctor(void_ptr p) {
         svt_jpeg_xs_encoder_common_t* enc_common = obj->enc_common;
         pi_t* pi = &enc_common->pi;
 
-        if (obj->temp_precincts_in_slice) {
-            for (uint32_t i = 0; i < obj->num_alloc_precincts_per_thread; ++i) {
-                precinct_enc_t* precincts = &obj->temp_precincts_in_slice[i];
-                for (uint32_t c = 0; c < pi->comps_num; ++c) {
-                    if (pi->components[c].decom_v == 0 || enc_common->cpu_profile == CPU_PROFILE_LOW_LATENCY) {
-                        SVT_FREE_ALIGNED_ARRAY(precincts->coeff_buff_ptr_16bit[c]);
-                    }
-                    SVT_FREE_ALIGNED_ARRAY(precincts->gc_buff_ptr[c]);
-                    if (enc_common->coding_significance) {
-                        SVT_FREE_ALIGNED_ARRAY(precincts->gc_significance_buff_ptr[c]);
-                    }
-                    if (enc_common->coding_vertical_prediction_mode) {
-                        SVT_FREE_ALIGNED_ARRAY(precincts->vped_bit_pack_buff_ptr[c]);
-                        if (enc_common->coding_significance) {
-                            SVT_FREE_ALIGNED_ARRAY(precincts->vped_significance_ptr[c]);
-                        }
-                    }
-                }
-            }
-        }
-
         if (obj->buffers_dwt_tmp.buffer_tmp) {
             SVT_FREE(obj->buffers_dwt_tmp.buffer_tmp);
         }
@@ -111,80 +101,202 @@ static void pack_stage_context_dctor(void_ptr p) {
             buffers_components_free(&obj->buffers_dwt_per_component);
         }
 
-        SVT_FREE(obj->temp_precincts_in_slice);
+        svt_jxs_arena_dctor(&obj->precincts_arena);
         SVT_FREE_ARRAY(obj);
     }
 }
 
-/************************************************
- * Pack Context Constructor
- ************************************************/
-SvtJxsErrorType_t pack_stage_context_ctor(ThreadContext_t* thread_contxt_ptr, svt_jpeg_xs_encoder_api_prv_t* enc_api_prv,
-                                          int idx) {
-    SvtJxsErrorType_t error;
-    PackStageContext* context_ptr;
-    svt_jpeg_xs_encoder_common_t* enc_common = &enc_api_prv->enc_common;
+/*Estimate arena size to get all precincts in one block*/
+static size_t pack_precincts_arena_size(const svt_jpeg_xs_encoder_common_t* enc_common, uint32_t precincts_num) {
+    const pi_t* pi = &enc_common->pi;
+    const pi_enc_t* pi_enc = &enc_common->pi_enc;
+
+    size_t precinct_buffers_size = ALVALUE * MAX_COMPONENTS_NUM * 5;
+    for (uint32_t c = 0; c < pi->comps_num; ++c) {
+        precinct_buffers_size += (size_t)pi_enc->coeff_buff_tmp_size_precinct[c] * sizeof(uint16_t) +
+            pi_enc->gc_buff_tmp_size_precinct[c] + pi_enc->gc_buff_tmp_significance_size_precinct[c] +
+            pi_enc->vped_bit_pack_size_precinct[c] + pi_enc->vped_significance_size_precinct[c];
+    }
+    return (sizeof(precinct_enc_t) + precinct_buffers_size) * precincts_num;
+}
+
+void pack_precincts_memory(SvtMemSize_t* mem, const svt_jpeg_xs_encoder_common_t* enc_common, uint32_t precincts_num) {
+    svt_jxs_mem_size_add(
+        mem, svt_jxs_arena_block_memory(pack_precincts_arena_size(enc_common, precincts_num)), SVT_JXS_MEM_COEFFICIENTS);
+}
+
+SvtJxsErrorType_t pack_precincts_alloc(SvtArena_t* arena, svt_jpeg_xs_encoder_common_t* enc_common, uint32_t precincts_num,
+                                       precinct_enc_t** precincts_out) {
     pi_t* pi = &enc_common->pi;
     pi_enc_t* pi_enc = &enc_common->pi_enc;
 
-    SVT_CALLOC_ARRAY(context_ptr, 1);
-    thread_contxt_ptr->priv = context_ptr;
-    thread_contxt_ptr->dctor = pack_stage_context_dctor;
-    context_ptr->enc_common = enc_common;
-    context_ptr->temp_precincts_in_slice = NULL;
+    svt_jxs_arena_ctor(arena, pack_precincts_arena_size(enc_common, precincts_num), SVT_JXS_MEM_COEFFICIENTS);
 
-    context_ptr->input_buffer_fifo_ptr = svt_jxs_system_resource_get_consumer_fifo(enc_api_prv->pack_input_resource_ptr, idx);
+    SVT_ARENA_CALLOC_ARRAY(arena, *precincts_out, precincts_num);
+    SVT_CHECK_MEM(*precincts_out);
 
-    context_ptr->output_buffer_fifo_ptr = svt_jxs_system_resource_get_producer_fifo(enc_api_prv->pack_output_resource_ptr, idx);
+    for (uint32_t i = 0; i < precincts_num; ++i) {
+        precinct_enc_t* precincts = &(*precincts_out)[i];
 
-    if (enc_common->rate_control_mode == RC_CBR_PER_PRECINCT ||
-        enc_common->rate_control_mode == RC_CBR_PER_PRECINCT_MOVE_PADDING) {
-        if (enc_common->coding_vertical_prediction_mode != METHOD_PRED_DISABLE) {
-            //Keep actual precinct and Top precinct for VPRED
-            context_ptr->num_alloc_precincts_per_thread = 2;
-        }
-        else {
-            context_ptr->num_alloc_precincts_per_thread = 1;
+        for (uint32_t c = 0; c < pi->comps_num; ++c) {
+            if (pi->components[c].decom_v == 0 || enc_common->cpu_profile == CPU_PROFILE_LOW_LATENCY) {
+                SVT_ARENA_CALLOC_ARRAY(arena, precincts->coeff_buff_ptr_16bit[c], pi_enc->coeff_buff_tmp_size_precinct[c]);
+                SVT_CHECK_MEM(precincts->coeff_buff_ptr_16bit[c]);
+            }
+            // Zero-initialize: gc_buff_ptr is read by sigflags_max before being fully written
+            SVT_ARENA_CALLOC_ARRAY(arena, precincts->gc_buff_ptr[c], pi_enc->gc_buff_tmp_size_precinct[c]);
+            SVT_CHECK_MEM(precincts->gc_buff_ptr[c]);
+            if (enc_common->coding_significance) {
+                SVT_ARENA_CALLOC_ARRAY(
+                    arena, precincts->gc_significance_buff_ptr[c], pi_enc->gc_buff_tmp_significance_size_precinct[c]);
+                SVT_CHECK_MEM(precincts->gc_significance_buff_ptr[c]);
+            }
+            if (enc_common->coding_vertical_prediction_mode) {
+                SVT_ARENA_CALLOC_ARRAY(arena, precincts->vped_bit_pack_buff_ptr[c], pi_enc->vped_bit_pack_size_precinct[c]);
+                SVT_CHECK_MEM(precincts->vped_bit_pack_buff_ptr[c]);
+                if (enc_common->coding_significance) {
+                    SVT_ARENA_CALLOC_ARRAY(
+                        arena, precincts->vped_significance_ptr[c], pi_enc->vped_significance_size_precinct[c]);
+                    SVT_CHECK_MEM(precincts->vped_significance_ptr[c]);
+                }
+            }
         }
     }
-    else {
-        context_ptr->num_alloc_precincts_per_thread = pi->precincts_per_slice;
-    }
-
-    context_ptr->buffers_dwt_tmp.buffer_tmp = NULL;
-    context_ptr->buffers_dwt_tmp.buffer_unpacked_color_formats = NULL;
+    return SvtJxsErrorNone;
+}
 
-    uint8_t decom_V0_exist = 0;
-    uint8_t decom_V1_exist = 0;
-    uint8_t decom_V2_exist = 0;
+/*Sizes of DWT temporary buffers of pack context*/
+typedef struct PackStageTmpSizes {
+    uint8_t decom_V0_exist;
+    uint8_t decom_V1_exist;
+    uint8_t decom_V2_exist;
+    uint32_t pixels_temp_size;
+    uint32_t unpacked_color_format_temp_size;
+} PackStageTmpSizes;
+
+static void pack_stage_tmp_sizes(const svt_jpeg_xs_encoder_common_t* enc_common, PackStageTmpSizes* sizes) {
+    const pi_t* pi = &enc_common->pi;
+    memset(sizes, 0, sizeof(*sizes));
     for (uint32_t i = 0; i < pi->comps_num; ++i) {
         if (pi->components[i].decom_v == 0) {
-            decom_V0_exist = 1;
+            sizes->decom_V0_exist = 1;
         }
         else if (pi->components[i].decom_v == 1) {
-            decom_V1_exist = 1;
+            sizes->decom_V1_exist = 1;
         }
         else if (pi->components[i].decom_v == 2) {
-            decom_V2_exist = 1;
+            sizes->decom_V2_exist = 1;
         }
     }
 
-    uint32_t pixels_temp_size = 0;
-    uint32_t unpacked_color_format_temp_size = 0;
-    if (decom_V0_exist) {
+    if (sizes->decom_V0_exist) {
         /*Buffer tmp DWT :
          * V0 required size: (width_max * 3 / 2) * sizeof(int32_t)*/
-        pixels_temp_size = MAX(pixels_temp_size, (pi->width * 3 / 2));
-        unpacked_color_format_temp_size = MAX(unpacked_color_format_temp_size, 3 * pi->width);
+        sizes->pixels_temp_size = MAX(sizes->pixels_temp_size, (pi->width * 3 / 2));
+        sizes->unpacked_color_format_temp_size = MAX(sizes->unpacked_color_format_temp_size, 3 * pi->width);
     }
     if (enc_common->cpu_profile == CPU_PROFILE_LOW_LATENCY) {
-        if (decom_V1_exist) {
+        if (sizes->decom_V1_exist) {
             /*Allocate buffer for V1:
              *2.5 temp for Vertical and Horizontal temp
              */
-            pixels_temp_size = MAX(pixels_temp_size, (pi->width * 5 / 2));
-            unpacked_color_format_temp_size = MAX(unpacked_color_format_temp_size, 9 * pi->width);
+            sizes->pixels_temp_size = MAX(sizes->pixels_temp_size, (pi->width * 5 / 2));
+            sizes->unpacked_color_format_temp_size = MAX(sizes->unpacked_color_format_temp_size, 9 * pi->width);
+        }
+        if (sizes->decom_V2_exist) {
+            /*Allocate buffer for V2 get maximum from:
+             (pi->width * 5 + 1) SIZE temp for transform_V2_Hx_precinct()
+             (7*width/2 + 2)  SIZE temp for transform_V2_Hx_precinct_recalc() + and 3*width to allocate additional 4 lines for precalc.
+             */
+            sizes->pixels_temp_size = MAX(sizes->pixels_temp_size, (pi->width * 5 + 1));
+            sizes->pixels_temp_size = MAX(sizes->pixels_temp_size, (7 * pi->width / 2 + 2) + 4 * pi->width);
+            sizes->unpacked_color_format_temp_size = MAX(sizes->unpacked_color_format_temp_size, 27 * pi->width);
+        }
+    }
+}
+
+/*Number of precincts allocated in pack context, 0 when precincts are in slot shared by parts of slice*/
+static uint32_t pack_stage_precincts_num(const svt_jpeg_xs_encoder_common_t* enc_common) {
+    if (enc_common->slice_parts_num > 1) {
+        return 0;
+    }
+    if (enc_common->rate_control_mode == RC_CBR_PER_PRECINCT ||
+        enc_common->rate_control_mode == RC_CBR_PER_PRECINCT_MOVE_PADDING) {
+        //Keep actual precinct and Top precinct for VPRED
+        return enc_common->coding_vertical_prediction_mode != METHOD_PRED_DISABLE ? 2 : 1;
+    }
+    return enc_common->pi.precincts_per_slice;
+}
+
+/*Buffer for unpacked packed colour format, 0 when input is planar*/
+static size_t pack_stage_unpacked_buffer_size(const svt_jpeg_xs_encoder_common_t* enc_common, const PackStageTmpSizes* sizes) {
+    ColourFormat_t colour_format = enc_common->colour_format;
+    if (colour_format > COLOUR_FORMAT_PACKED_MIN && colour_format < COLOUR_FORMAT_PACKED_MAX &&
+        sizes->unpacked_color_format_temp_size > 0 && colour_format == COLOUR_FORMAT_PACKED_YUV444_OR_RGB) {
+        //rgb24 is 1byte per pixel in component
+        uint32_t pixel_size = enc_common->bit_depth <= 8 ? sizeof(uint8_t) : sizeof(uint16_t);
+        return (size_t)sizes->unpacked_color_format_temp_size * pixel_size;
+    }
+    return 0;
+}
+
+void pack_stage_context_memory(SvtMemSize_t* mem, const svt_jpeg_xs_encoder_common_t* enc_common) {
+    const pi_t* pi = &enc_common->pi;
+    PackStageTmpSizes sizes;
+    pack_stage_tmp_sizes(enc_common, &sizes);
+
+    size_t size = sizeof(PackStageContext);
+    if (enc_common->cpu_profile == CPU_PROFILE_LOW_LATENCY) {
+        if (sizes.decom_V1_exist) {
+            size += 3 * pi->width * sizeof(int32_t);
+        }
+        if (sizes.decom_V2_exist) {
+            size += 4 * pi->width * sizeof(int32_t) + (pi->width + 1) * sizeof(int32_t);
+        }
+        buffers_components_memory(mem, pi);
+    }
+    size += sizes.pixels_temp_size * sizeof(int32_t);
+    size += pack_stage_unpacked_buffer_size(enc_common, &sizes);
+    svt_jxs_mem_size_add(mem, size, SVT_JXS_MEM_GENERAL);
+
+    uint32_t precincts_num = pack_stage_precincts_num(enc_common);
+    if (precincts_num) {
+        pack_precincts_memory(mem, enc_common, precincts_num);
+    }
+}
+
+/************************************************
+ * Pack Context Constructor
+ ************************************************/
+SvtJxsErrorType_t pack_stage_context_ctor(ThreadContext_t* thread_contxt_ptr, svt_jpeg_xs_encoder_api_prv_t* enc_api_prv,
+                                          int idx) {
+    SvtJxsErrorType_t error;
+    PackStageContext* context_ptr;
+    svt_jpeg_xs_encoder_common_t* enc_common = &enc_api_prv->enc_common;
+    pi_t* pi = &enc_common->pi;
 
+    SVT_CALLOC_ARRAY(context_ptr, 1);
+    thread_contxt_ptr->priv = context_ptr;
+    thread_contxt_ptr->dctor = pack_stage_context_dctor;
+    context_ptr->enc_common = enc_common;
+    context_ptr->temp_precincts_in_slice = NULL;
+
+    if (enc_common->batch == NULL) {
+        context_ptr->input_buffer_fifo_ptr = svt_jxs_system_resource_get_consumer_fifo(enc_api_prv->pack_input_resource_ptr,
+                                                                                       idx);
+    }
+
+    context_ptr->output_buffer_fifo_ptr = svt_jxs_system_resource_get_producer_fifo(enc_api_prv->pack_output_resource_ptr, idx);
+
+    context_ptr->num_alloc_precincts_per_thread = pack_stage_precincts_num(enc_common);
+
+    context_ptr->buffers_dwt_tmp.buffer_tmp = NULL;
+    context_ptr->buffers_dwt_tmp.buffer_unpacked_color_formats = NULL;
+
+    PackStageTmpSizes sizes;
+    pack_stage_tmp_sizes(enc_common, &sizes);
+    if (enc_common->cpu_profile == CPU_PROFILE_LOW_LATENCY) {
+        if (sizes.decom_V1_exist) {
             /*Allocate buffer for V1:
             *3 lines on convert input,
             *1 - previous HF
@@ -196,15 +308,7 @@ SvtJxsErrorType_t pack_stage_context_ctor(ThreadContext_t* thread_contxt_ptr, sv
             SVT_CALLOC(context_ptr->buffers_dwt_tmp.V1.line_2, 1, pi->width * sizeof(int32_t));
             SVT_CALLOC(context_ptr->buffers_dwt_tmp.V1.out_tmp_line_HF_next, 1, pi->width * sizeof(int32_t));
         }
-        if (decom_V2_exist) {
-            /*Allocate buffer for V2 get maximum from:
-             (pi->width * 5 + 1) SIZE temp for transform_V2_Hx_precinct()
-             (7*width/2 + 2)  SIZE temp for transform_V2_Hx_precinct_recalc() + and 3*width to allocate additional 4 lines for precalc.
-             */
-            pixels_temp_size = MAX(pixels_temp_size, (pi->width * 5 + 1));
-            pixels_temp_size = MAX(pixels_temp_size, (7 * pi->width / 2 + 2) + 4 * pi->width);
-            unpacked_color_format_temp_size = MAX(unpacked_color_format_temp_size, 27 * pi->width);
-
+        if (sizes.decom_V2_exist) {
             SVT_CALLOC(context_ptr->buffers_dwt_tmp.V2.line_3, 1, pi->width * sizeof(int32_t));
             SVT_CALLOC(context_ptr->buffers_dwt_tmp.V2.line_4, 1, pi->width * sizeof(int32_t));
             SVT_CALLOC(context_ptr->buffers_dwt_tmp.V2.line_5, 1, pi->width * sizeof(int32_t));
@@ -220,47 +324,32 @@ SvtJxsErrorType_t pack_stage_context_ctor(ThreadContext_t* thread_contxt_ptr, sv
         }
     }
 
-    if (pixels_temp_size > 0) {
-        SVT_CALLOC(context_ptr->buffers_dwt_tmp.buffer_tmp, 1, pixels_temp_size * sizeof(int32_t));
+    if (sizes.pixels_temp_size > 0) {
+        SVT_CALLOC(context_ptr->buffers_dwt_tmp.buffer_tmp, 1, sizes.pixels_temp_size * sizeof(int32_t));
     }
 
     ColourFormat_t colour_format = enc_common->colour_format;
     if (colour_format > COLOUR_FORMAT_PACKED_MIN && colour_format < COLOUR_FORMAT_PACKED_MAX &&
-        unpacked_color_format_temp_size > 0) {
-        uint32_t pixel_size = enc_common->bit_depth <= 8 ? sizeof(uint8_t) : sizeof(uint16_t);
+        sizes.unpacked_color_format_temp_size > 0) {
         if (colour_format == COLOUR_FORMAT_PACKED_YUV444_OR_RGB) {
-            //rgb24 is 1byte per pixel in component
-            SVT_CALLOC(
-                context_ptr->buffers_dwt_tmp.buffer_unpacked_color_formats, 1, unpacked_color_format_temp_size * pixel_size);
+            SVT_CALLOC(context_ptr->buffers_dwt_tmp.buffer_unpacked_color_formats,
+                       1,
+                       pack_stage_unpacked_buffer_size(enc_common, &sizes));
         }
         else {
             assert(0);
         }
     }
 
-    SVT_CALLOC(context_ptr->temp_precincts_in_slice, context_ptr->num_alloc_precincts_per_thread, sizeof(precinct_enc_t));
-
-    for (uint32_t i = 0; i < context_ptr->num_alloc_precincts_per_thread; ++i) {
-        precinct_enc_t* precincts = &context_ptr->temp_precincts_in_slice[i];
-
-        for (uint32_t c = 0; c < pi->comps_num; ++c) {
-            if (pi->components[c].decom_v == 0 || enc_common->cpu_profile == CPU_PROFILE_LOW_LATENCY) {
-                SVT_MALLOC_ALIGNED_ARRAY(precincts->coeff_buff_ptr_16bit[c], (size_t)pi_enc->coeff_buff_tmp_size_precinct[c]);
-            }
-            // Zero-initialize: gc_buff_ptr is read by sigflags_max before being fully written
-            SVT_CALLOC_ALIGNED_ARRAY(precincts->gc_buff_ptr[c], (size_t)pi_enc->gc_buff_tmp_size_precinct[c]);
-            if (enc_common->coding_significance) {
-                SVT_MALLOC_ALIGNED_ARRAY(precincts->gc_significance_buff_ptr[c],
-                                         (size_t)pi_enc->gc_buff_tmp_significance_size_precinct[c]);
-            }
-            if (enc_common->coding_vertical_prediction_mode) {
-                SVT_MALLOC_ALIGNED_ARRAY(precincts->vped_bit_pack_buff_ptr[c], (size_t)pi_enc->vped_bit_pack_size_precinct[c]);
-                if (enc_common->coding_significance) {
-                    SVT_MALLOC_ALIGNED_ARRAY(precincts->vped_significance_ptr[c],
-                                             (size_t)pi_enc->vped_significance_size_precinct[c]);
-                }
-            }
+    if (context_ptr->num_alloc_precincts_per_thread) {
+        error = pack_precincts_alloc(&context_ptr->precincts_arena,
+                                     enc_common,
+                                     context_ptr->num_alloc_precincts_per_thread,
+                                     &context_ptr->temp_precincts_in_slice);
+        if (error) {
+            return error;
         }
+        svt_jxs_arena_print_usage(&context_ptr->precincts_arena, "Pack stage precincts");
     }
 
     return SvtJxsErrorNone;
@@ -271,26 +360,55 @@ static void slice_init_bitstream(bitstream_writer_t* bitstream, PictureControlSe
     bitstream_writer_init(bitstream, buf, pack_input->out_bytes_end - pack_input->out_bytes_begin);
 }
 
-static SvtJxsErrorType_t process_precinct(PictureControlSet* pcs_ptr, svt_jpeg_xs_encoder_common_t* enc_common, pi_t* pi,
-                                          uint32_t slice_idx, uint32_t prec_idx, uint32_t prec_idx_in_slice,
-                                          PackInput_t* pack_input, precinct_enc_t* precinct_top, precinct_enc_t* precinct,
-                                          uint32_t budget_bytes, bitstream_writer_t* bitstream,
-                                          struct precinct_calc_dwt_buff_tmp* buffers_dwt_tmp,
-                                          struct precinct_calc_dwt_buff_per_component* buffers_dwt_per_component,
-                                          uint32_t prec_num, uint32_t* budget_bytes_padding_left) {
-    SvtJxsErrorType_t error = 0;
+/*Init, DWT and precalculation of RC for precinct, does not depend on other precincts.*/
+static void prepare_precinct(PictureControlSet* pcs_ptr, svt_jpeg_xs_encoder_common_t* enc_common, pi_t* pi, uint32_t prec_idx,
+                             uint32_t prec_idx_in_slice, PackInput_t* pack_input, precinct_enc_t* precinct_top,
+                             precinct_enc_t* precinct, struct precinct_calc_dwt_buff_tmp* buffers_dwt_tmp,
+                             struct precinct_calc_dwt_buff_per_component* buffers_dwt_per_component) {
     precinc_info_enum type = PRECINCT_NORMAL;
     if (prec_idx + 1 >= enc_common->pi.precincts_line_num) {
         type = PRECINCT_LAST_NORMAL;
     }
     precinct_enc_init(pcs_ptr, pi, prec_idx, type, precinct_top, precinct);
     precinct_calculate_data(pcs_ptr, precinct, pack_input, buffers_dwt_tmp, buffers_dwt_per_component, prec_idx_in_slice);
+    rate_control_init_precinct(
+        pcs_ptr, precinct, enc_common->coding_vertical_prediction_mode, enc_common->coding_signs_handling);
+}
 
-    rate_control_init_precinct(pcs_ptr, precinct, enc_common->coding_signs_handling);
+/*Prepare precincts [prec_begin, prec_end) of slice, precincts are indexed in slice.*/
+static void prepare_slice_precincts(PictureControlSet* pcs_ptr, svt_jpeg_xs_encoder_common_t* enc_common, pi_t* pi,
+                                    PackInput_t* pack_input, precinct_enc_t* precincts, uint32_t prec_first_idx,
+                                    uint32_t prec_begin, uint32_t prec_end, struct precinct_calc_dwt_buff_tmp* buffers_dwt_tmp,
+                                    struct precinct_calc_dwt_buff_per_component* buffers_dwt_per_component) {
+    for (uint32_t i = prec_begin; i < prec_end; i++) {
+        precinct_enc_t* precinct_top = NULL;
+        if (enc_common->coding_vertical_prediction_mode != METHOD_PRED_DISABLE && i > 0) {
+            precinct_top = &precincts[i - 1];
+        }
+        prepare_precinct(pcs_ptr,
+                         enc_common,
+                         pi,
+                         prec_first_idx + i,
+                         i,
+                         pack_input,
+                         precinct_top,
+                         &precincts[i],
+                         buffers_dwt_tmp,
+                         buffers_dwt_per_component);
+    }
+}
+
+/*RC, quantization and pack of prepared precinct.*/
+static SvtJxsErrorType_t process_precinct(PictureControlSet* pcs_ptr, svt_jpeg_xs_encoder_common_t* enc_common, pi_t* pi,
+                                          uint32_t slice_idx, uint32_t prec_idx, uint32_t prec_idx_in_slice,
+                                          precinct_enc_t* precinct, uint32_t budget_bytes, bitstream_writer_t* bitstream,
+                                          uint32_t prec_num, uint32_t* budget_bytes_padding_left) {
+    UNUSED(prec_idx); // Value only used in debug messages
+    SvtJxsErrorType_t error = 0;
     error = rate_control_precinct(
         pcs_ptr, precinct, budget_bytes, enc_common->coding_vertical_prediction_mode, enc_common->coding_signs_handling);
 
-    if (enc_common->rate_control_mode == RC_CBR_PER_PRECINCT_MOVE_PADDING) {
+    if (pcs_ptr->rate_control_mode == RC_CBR_PER_PRECINCT_MOVE_PADDING) {
         /* Possibility of using unfilled data in precinct in next precinct by modifying the budget
          * Average, 3% of the precinct area is empty, and the next precinct can benefit from less quantization
          * by using up the area of the previous precinct (padding_bits).
@@ -323,7 +441,7 @@ static SvtJxsErrorType_t process_precinct(PictureControlSet* pcs_ptr, svt_jpeg_x
 
     error = pack_precinct(bitstream, pi, precinct, enc_common->coding_signs_handling);
 
-    if (enc_common->rate_control_mode == RC_CBR_PER_PRECINCT_MOVE_PADDING) {
+    if (pcs_ptr->rate_control_mode == RC_CBR_PER_PRECINCT_MOVE_PADDING) {
         if (enc_common->coding_signs_handling == SIGN_HANDLING_STRATEGY_FAST) {
             if (prec_idx_in_slice + 1 < prec_num) {
                 assert(precinct->pack_signs_handling_cut_precing);
@@ -337,35 +455,18 @@ static SvtJxsErrorType_t process_precinct(PictureControlSet* pcs_ptr, svt_jpeg_x
     return error;
 }
 
+/*RC, quantization and pack of slice with all precincts prepared.*/
 static SvtJxsErrorType_t process_slice(PictureControlSet* pcs_ptr, svt_jpeg_xs_encoder_common_t* enc_common, pi_t* pi,
                                        PackInput_t* pack_input, precinct_enc_t* precincts, uint32_t prec_num,
-                                       uint32_t prec_first_idx, struct precinct_calc_dwt_buff_tmp* buffers_dwt_tmp,
-                                       struct precinct_calc_dwt_buff_per_component* buffers_dwt_per_component,
-                                       bitstream_writer_t* bitstream) {
-    assert(enc_common->rate_control_mode == RC_CBR_PER_SLICE_COMMON_QUANT ||
-           enc_common->rate_control_mode == RC_CBR_PER_SLICE_COMMON_QUANT_MAX_RATE);
+                                       uint32_t prec_first_idx, bitstream_writer_t* bitstream) {
+    assert(pcs_ptr->rate_control_mode == RC_CBR_PER_SLICE_COMMON_QUANT ||
+           pcs_ptr->rate_control_mode == RC_CBR_PER_SLICE_COMMON_QUANT_MAX_RATE);
 
     /*RC Budget per slice. Separate loops for DWT, RC, QUANTIZATION and PACK.*/
+    UNUSED(prec_first_idx); // Value only used in debug messages
     SvtJxsErrorType_t error = 0;
-    precinct_enc_t* precinct_top = NULL;
     precinct_enc_t* precinct = NULL;
 
-    /*LOOP: Init and DWT*/
-    for (uint32_t i = 0; i < prec_num; i++) {
-        precinct = &precincts[i];
-        if (enc_common->coding_vertical_prediction_mode != METHOD_PRED_DISABLE && i > 0) {
-            precinct_top = &precincts[i - 1];
-        }
-        uint32_t prec_idx_global = prec_first_idx + i;
-        precinc_info_enum type = PRECINCT_NORMAL;
-        if (prec_idx_global + 1 >= enc_common->pi.precincts_line_num) {
-            type = PRECINCT_LAST_NORMAL;
-        }
-        precinct_enc_init(pcs_ptr, pi, prec_idx_global, type, precinct_top, precinct);
-        precinct_calculate_data(pcs_ptr, precinct, pack_input, buffers_dwt_tmp, buffers_dwt_per_component, i);
-        rate_control_init_precinct(pcs_ptr, precinct, enc_common->coding_signs_handling);
-    }
-
     /*LOOP: RC*/
     /*Precalculate common Quantization and Refinement for all precincts*/
     uint32_t slice_budget_bytes = pack_input->slice_budget_bytes;
@@ -386,7 +487,7 @@ static SvtJxsErrorType_t process_slice(PictureControlSet* pcs_ptr, svt_jpeg_xs_e
         }
         assert(total_bytes == slice_budget_bytes);
 #endif
-        if (enc_common->rate_control_mode == RC_CBR_PER_SLICE_COMMON_QUANT_MAX_RATE) {
+        if (pcs_ptr->rate_control_mode == RC_CBR_PER_SLICE_COMMON_QUANT_MAX_RATE) {
             /*Update max rate*/
             uint32_t max_precinct_size = 0;
             for (uint32_t i = 0; i < prec_num; i++) {
@@ -564,186 +665,329 @@ static SvtJxsErrorType_t process_slice(PictureControlSet* pcs_ptr, svt_jpeg_xs_e
     return error;
 }
 
-void* pack_stage_kernel(void* input_ptr) {
-    ThreadContext_t* enc_contxt_ptr = (ThreadContext_t*)input_ptr;
-    PackStageContext* context_ptr = (PackStageContext*)enc_contxt_ptr->priv;
+/*Add packed precinct to rate statistics of slice: padding, GTLI of bands and distortion proxy of truncated bit planes.*/
+static void pack_stats_add_precinct(PackStageContext* context_ptr, const pi_t* pi, const precinct_enc_t* precinct) {
+    context_ptr->stats_padding_bytes += precinct->pack_padding_bytes;
+    uint64_t distortion = 0;
+    for (uint32_t c = 0; c < pi->comps_num; ++c) {
+        for (uint32_t b = 0; b < pi->components[c].bands_num; ++b) {
+            uint32_t height_lines = precinct->p_info->b_info[c][b].height;
+            uint8_t gtli = precinct->bands[c][b].gtli;
+            if (height_lines == 0 || gtli > TRUNCATION_MAX) {
+                continue;
+            }
+            context_ptr->stats_gtli_histogram[c][b][gtli]++;
+            for (uint32_t line = 0; line < height_lines; ++line) {
+                const uint16_t* gc_lookup_table = precinct->bands[c][b].lines_common[line].rc_cache_line.gc_lookup_table;
+                for (uint32_t gcli = 1; gcli <= TRUNCATION_MAX; ++gcli) {
+#if LUT_GC_SERIAL_SUMMATION
+                    /*Table is summarized, number of groups with GCLI lower or equal to index*/
+                    uint64_t groups = gc_lookup_table[gcli] - gc_lookup_table[gcli - 1];
+#else
+                    uint64_t groups = gc_lookup_table[gcli];
+#endif
+                    uint64_t error = ((uint64_t)1 << MIN(gcli, gtli)) - 1;
+                    distortion += groups * error * error;
+                }
+            }
+        }
+    }
+    context_ptr->stats_distortion += distortion * pi->coeff_group_size;
+}
 
-    PictureControlSet* pcs_ptr;
-    ObjectWrapper_t *input_wrapper_ptr, *output_wrapper_ptr;
-
-    for (;;) {
-        // Get the Next svt Input Buffer [BLOCKING]
-        SVT_GET_FULL_OBJECT(context_ptr->input_buffer_fifo_ptr, &input_wrapper_ptr);
-        PackInput_t* pack_input = (PackInput_t*)input_wrapper_ptr->object_ptr;
-        ObjectWrapper_t* pcs_wrapper_ptr = pack_input->pcs_wrapper_ptr;
-        pcs_ptr = (PictureControlSet*)pcs_wrapper_ptr->object_ptr;
+/*Calculate and pack one slice of task, or prepare part of slice when slice is split to parts*/
+static void pack_stage_process_slice(PackStageContext* context_ptr, PackInput_t* pack_input) {
+    ObjectWrapper_t* output_wrapper_ptr;
+    ObjectWrapper_t* pcs_wrapper_ptr = pack_input->pcs_wrapper_ptr;
+    PictureControlSet* pcs_ptr = (PictureControlSet*)pcs_wrapper_ptr->object_ptr;
 
 #ifdef FLAG_DEADLOCK_DETECT
-        printf("07[%s:%i] frame: %03li slice: %03d\n", __func__, __LINE__, (size_t)pcs_ptr->frame_number, pack_input->slice_idx);
+    printf("07[%s:%i] frame: %03li slice: %03d\n", __func__, __LINE__, (size_t)pcs_ptr->frame_number, pack_input->slice_idx);
 #endif
 
-        pi_t* pi = &pcs_ptr->enc_common->pi;
-        svt_jpeg_xs_encoder_common_t* enc_common = pcs_ptr->enc_common;
-        SvtJxsErrorType_t error = 0;
-
-        /*Write Slice header*/
-        bitstream_writer_t bitstream;
-        slice_init_bitstream(&bitstream, pcs_ptr, pack_input);
-
-        /*RC and Quantization*/
-        uint32_t prec_first_idx = pi->precincts_per_slice * pack_input->slice_idx;
-        uint32_t prec_num = pi->precincts_per_slice;
-        int32_t last_slice = (pack_input->slice_idx == enc_common->pi.slice_num - 1);
-        if (last_slice) {
-            prec_num = pi->precincts_line_num - prec_first_idx;
-        }
-        uint32_t min_budget_per_prec_bytes = pack_input->slice_budget_bytes / prec_num;
-        uint32_t left_budget_bytes = pack_input->slice_budget_bytes - min_budget_per_prec_bytes * prec_num;
-        /* Budget if not divide by precincts number then distribution size for upper precinct
-         * Example Budget for 4 precincts:
-         * 45/4 = 11 Left 1 Budgets: 12 11 11 11
-         * 46/4 = 11 Left 2 Budgets: 12 12 11 11
-         * 47/4 = 11 Left 3 Budgets: 12 12 12 11
-         * 48/4 = 12 Left 0 Budgets: 12 12 12 12
-         */
+    pi_t* pi = &pcs_ptr->enc_common->pi;
+    svt_jpeg_xs_encoder_common_t* enc_common = pcs_ptr->enc_common;
+    SvtJxsErrorType_t error = 0;
+    uint64_t stats_time_begin_us = 0;
+    uint64_t stats_time_parts_us = 0;
+    if (enc_common->stats_enable) {
+        stats_time_begin_us = svt_jxs_get_time_us();
+        for (uint32_t i = 0; i < context_ptr->num_alloc_precincts_per_thread; i++) {
+            context_ptr->temp_precincts_in_slice[i].rc_iterations = 0;
+        }
+    }
 
-        precinct_enc_t* precincts = context_ptr->temp_precincts_in_slice;
+    uint32_t prec_first_idx = pi->precincts_per_slice * pack_input->slice_idx;
+    uint32_t prec_num = pi->precincts_per_slice;
+    int32_t last_slice = (pack_input->slice_idx == enc_common->pi.slice_num - 1);
+    if (last_slice) {
+        prec_num = pi->precincts_line_num - prec_first_idx;
+    }
 
-        /*Calculate Slice*/
-        if (enc_common->rate_control_mode == RC_CBR_PER_PRECINCT ||
-            enc_common->rate_control_mode == RC_CBR_PER_PRECINCT_MOVE_PADDING) {
-            /*RC Budget per precinct. One loop for DWT, RC, and PACK.*/
-            precinct_enc_t* precinct_top = NULL;
-            precinct_enc_t* precinct = NULL;
-            uint8_t precinct_index = 0;
-            if (enc_common->coding_vertical_prediction_mode == METHOD_PRED_DISABLE) {
-                precinct = &precincts[precinct_index];
+    precinct_enc_t* precincts = context_ptr->temp_precincts_in_slice;
+    uint32_t precincts_stats_num = context_ptr->num_alloc_precincts_per_thread;
+    PackSliceSlot_t* slot = NULL;
+    if (pack_input->slice_slot_wrapper_ptr) {
+        /*Slice split to parts: every part prepare own range of precincts in parallel,
+         *last finished part calculate RC and pack of whole slice in order.*/
+        slot = (PackSliceSlot_t*)pack_input->slice_slot_wrapper_ptr->object_ptr;
+        precincts = slot->precincts;
+        precincts_stats_num = prec_num;
+        uint32_t parts_num = enc_common->slice_parts_num;
+        uint32_t part_idx = pack_input->slice_part_idx;
+        uint32_t prec_begin = prec_num * part_idx / parts_num;
+        uint32_t prec_end = prec_num * (part_idx + 1) / parts_num;
+        prepare_slice_precincts(pcs_ptr,
+                                enc_common,
+                                pi,
+                                pack_input,
+                                precincts,
+                                prec_first_idx,
+                                prec_begin,
+                                prec_end,
+                                &context_ptr->buffers_dwt_tmp,
+                                &context_ptr->buffers_dwt_per_component);
+        if (enc_common->stats_enable) {
+            for (uint32_t i = prec_begin; i < prec_end; i++) {
+                precincts[i].rc_iterations = 0;
             }
+            slot->parts_time_us[part_idx] = svt_jxs_get_time_us() - stats_time_begin_us;
+        }
+        if (SVT_ATOMIC_SUB32(&slot->parts_left, 1) != 0) {
+            return;
+        }
+        if (enc_common->stats_enable) {
+            for (uint32_t i = 0; i < parts_num; i++) {
+                stats_time_parts_us += slot->parts_time_us[i];
+            }
+            stats_time_begin_us = svt_jxs_get_time_us();
+        }
+    }
 
-            uint32_t first_budget_per_prec_bytes = min_budget_per_prec_bytes;
+    if (enc_common->stats_enable) {
+        context_ptr->stats_padding_bytes = 0;
+        context_ptr->stats_distortion = 0;
+        memset(context_ptr->stats_gtli_histogram, 0, sizeof(context_ptr->stats_gtli_histogram));
+    }
 
-            if (enc_common->rate_control_mode == RC_CBR_PER_PRECINCT_MOVE_PADDING) {
-                if (enc_common->coding_signs_handling == SIGN_HANDLING_STRATEGY_FAST) {
-                    first_budget_per_prec_bytes = first_budget_per_prec_bytes *
-                        (100 + TUNING_RC_CBR_PER_PRECINCT_MOVE_PADDING_FIRST_PREC_BIGGER_WITH_SIGN_LAZY_PERCENT) / 100;
-                }
-                else {
-                    first_budget_per_prec_bytes = first_budget_per_prec_bytes *
-                        (100 + TUNING_RC_CBR_PER_PRECINCT_MOVE_PADDING_FIRST_PREC_BIGGER_NO_SIGN_LAZY_PERCENT) / 100;
-                }
-                first_budget_per_prec_bytes = MIN(pack_input->slice_budget_bytes, first_budget_per_prec_bytes);
-                if (prec_num > 1) {
-                    uint32_t left_after_first = pack_input->slice_budget_bytes - first_budget_per_prec_bytes;
-                    min_budget_per_prec_bytes = left_after_first / (prec_num - 1);
-                    left_budget_bytes = pack_input->slice_budget_bytes - min_budget_per_prec_bytes * (prec_num - 1) -
-                        first_budget_per_prec_bytes;
-                }
-                else {
-                    left_budget_bytes = 0;
-                }
+    /*Write Slice header*/
+    bitstream_writer_t bitstream;
+    slice_init_bitstream(&bitstream, pcs_ptr, pack_input);
+
+    /*RC and Quantization*/
+    uint32_t min_budget_per_prec_bytes = pack_input->slice_budget_bytes / prec_num;
+    uint32_t left_budget_bytes = pack_input->slice_budget_bytes - min_budget_per_prec_bytes * prec_num;
+    /* Budget if not divide by precincts number then distribution size for upper precinct
+     * Example Budget for 4 precincts:
+     * 45/4 = 11 Left 1 Budgets: 12 11 11 11
+     * 46/4 = 11 Left 2 Budgets: 12 12 11 11
+     * 47/4 = 11 Left 3 Budgets: 12 12 12 11
+     * 48/4 = 12 Left 0 Budgets: 12 12 12 12
+     */
+
+    /*Calculate Slice*/
+    if (pcs_ptr->rate_control_mode == RC_CBR_PER_PRECINCT ||
+        pcs_ptr->rate_control_mode == RC_CBR_PER_PRECINCT_MOVE_PADDING) {
+        /*RC Budget per precinct. One loop for DWT, RC, and PACK.*/
+        precinct_enc_t* precinct_top = NULL;
+        precinct_enc_t* precinct = NULL;
+        uint8_t precinct_index = 0;
+        if (!slot && enc_common->coding_vertical_prediction_mode == METHOD_PRED_DISABLE) {
+            precinct = &precincts[precinct_index];
+        }
+
+        uint32_t first_budget_per_prec_bytes = min_budget_per_prec_bytes;
+
+        if (pcs_ptr->rate_control_mode == RC_CBR_PER_PRECINCT_MOVE_PADDING) {
+            if (enc_common->coding_signs_handling == SIGN_HANDLING_STRATEGY_FAST) {
+                first_budget_per_prec_bytes = first_budget_per_prec_bytes *
+                    (100 + TUNING_RC_CBR_PER_PRECINCT_MOVE_PADDING_FIRST_PREC_BIGGER_WITH_SIGN_LAZY_PERCENT) / 100;
             }
-            assert(pack_input->slice_budget_bytes ==
-                   first_budget_per_prec_bytes + (prec_num - 1) * min_budget_per_prec_bytes + left_budget_bytes);
+            else {
+                first_budget_per_prec_bytes = first_budget_per_prec_bytes *
+                    (100 + TUNING_RC_CBR_PER_PRECINCT_MOVE_PADDING_FIRST_PREC_BIGGER_NO_SIGN_LAZY_PERCENT) / 100;
+            }
+            first_budget_per_prec_bytes = MIN(pack_input->slice_budget_bytes, first_budget_per_prec_bytes);
+            if (prec_num > 1) {
+                uint32_t left_after_first = pack_input->slice_budget_bytes - first_budget_per_prec_bytes;
+                min_budget_per_prec_bytes = left_after_first / (prec_num - 1);
+                left_budget_bytes = pack_input->slice_budget_bytes - min_budget_per_prec_bytes * (prec_num - 1) -
+                    first_budget_per_prec_bytes;
+            }
+            else {
+                left_budget_bytes = 0;
+            }
+        }
+        assert(pack_input->slice_budget_bytes ==
+               first_budget_per_prec_bytes + (prec_num - 1) * min_budget_per_prec_bytes + left_budget_bytes);
 
-            uint32_t budget_padding_left_bytes = 0; /*Move padding budget between precincts.*/
-            for (uint32_t i = 0; i < prec_num; i++) {
-                uint32_t budget_bytes = (i == 0) ? first_budget_per_prec_bytes : min_budget_per_prec_bytes;
-                if (i < left_budget_bytes) {
-                    budget_bytes++;
-                }
-                budget_bytes += budget_padding_left_bytes;
+        uint32_t budget_padding_left_bytes = 0; /*Move padding budget between precincts.*/
+        for (uint32_t i = 0; i < prec_num; i++) {
+            uint32_t budget_bytes = (i == 0) ? first_budget_per_prec_bytes : min_budget_per_prec_bytes;
+            if (i < left_budget_bytes) {
+                budget_bytes++;
+            }
+            budget_bytes += budget_padding_left_bytes;
 #if PRINT_BUDGET
-                printf("Slice: %u Prec %u size bytes: %u\n", pack_input->slice_idx, i, budget_bytes);
+            printf("Slice: %u Prec %u size bytes: %u\n", pack_input->slice_idx, i, budget_bytes);
 #endif
+            if (slot) {
+                precinct = &precincts[i];
+            }
+            else {
                 if (enc_common->coding_vertical_prediction_mode != METHOD_PRED_DISABLE) {
                     precinct_top = precinct;               //Set top for next precinct
                     precinct = &precincts[precinct_index]; //Get one of the two items to take turns
                     precinct_index = (precinct_index + 1) % context_ptr->num_alloc_precincts_per_thread;
                 }
-                error = process_precinct(pcs_ptr,
-                                         enc_common,
-                                         pi,
-                                         pack_input->slice_idx,
-                                         prec_first_idx + i,
-                                         i,
-                                         pack_input,
-                                         precinct_top,
-                                         precinct,
-                                         budget_bytes,
-                                         &bitstream,
-                                         &context_ptr->buffers_dwt_tmp,
-                                         &context_ptr->buffers_dwt_per_component,
-                                         prec_num,
-                                         &budget_padding_left_bytes);
-                if (error) {
+                prepare_precinct(pcs_ptr,
+                                 enc_common,
+                                 pi,
+                                 prec_first_idx + i,
+                                 i,
+                                 pack_input,
+                                 precinct_top,
+                                 precinct,
+                                 &context_ptr->buffers_dwt_tmp,
+                                 &context_ptr->buffers_dwt_per_component);
+            }
+            error = process_precinct(pcs_ptr,
+                                     enc_common,
+                                     pi,
+                                     pack_input->slice_idx,
+                                     prec_first_idx + i,
+                                     i,
+                                     precinct,
+                                     budget_bytes,
+                                     &bitstream,
+                                     prec_num,
+                                     &budget_padding_left_bytes);
+            if (error) {
 #ifndef NDEBUG
-                    fprintf(stderr, "err happen when pack prec\n");
+                fprintf(stderr, "err happen when pack prec\n");
 #endif
-                    break;
-                }
+                break;
+            }
+            if (enc_common->stats_enable) {
+                pack_stats_add_precinct(context_ptr, pi, precinct);
             }
         }
-        else {
-            error = process_slice(pcs_ptr,
-                                  enc_common,
-                                  pi,
-                                  pack_input,
-                                  precincts,
-                                  prec_num,
-                                  prec_first_idx,
-                                  &context_ptr->buffers_dwt_tmp,
-                                  &context_ptr->buffers_dwt_per_component,
-                                  &bitstream);
+    }
+    else {
+        if (!slot) {
+            prepare_slice_precincts(pcs_ptr,
+                                    enc_common,
+                                    pi,
+                                    pack_input,
+                                    precincts,
+                                    prec_first_idx,
+                                    0,
+                                    prec_num,
+                                    &context_ptr->buffers_dwt_tmp,
+                                    &context_ptr->buffers_dwt_per_component);
+        }
+        error = process_slice(pcs_ptr, enc_common, pi, pack_input, precincts, prec_num, prec_first_idx, &bitstream);
 #ifndef NDEBUG
-            if (error) {
-                fprintf(stderr, "Error calculate RC or pack for slice: %i\n", pack_input->slice_idx);
-            }
+        if (error) {
+            fprintf(stderr, "Error calculate RC or pack for slice: %i\n", pack_input->slice_idx);
+        }
 #endif
+        if (error == SvtJxsErrorNone && enc_common->stats_enable) {
+            for (uint32_t i = 0; i < prec_num; i++) {
+                pack_stats_add_precinct(context_ptr, pi, &precincts[i]);
+            }
         }
+    }
 
 #ifndef NDEBUG
-        if (error == SvtJxsErrorNone) {
-            uint32_t used_bytes = bitstream_writer_get_used_bytes(&bitstream);
-            uint32_t used_bytes_expected = pack_input->out_bytes_end - pack_input->out_bytes_begin;
-            if (used_bytes_expected != used_bytes) {
-                fprintf(stderr,
-                        "Error pack slice: %i, Expected write to bitstream: %u Get: %u\n",
-                        pack_input->slice_idx,
-                        used_bytes_expected,
-                        used_bytes);
-                assert(0);
-            }
+    if (error == SvtJxsErrorNone) {
+        uint32_t used_bytes = bitstream_writer_get_used_bytes(&bitstream);
+        uint32_t used_bytes_expected = pack_input->out_bytes_end - pack_input->out_bytes_begin;
+        if (used_bytes_expected != used_bytes) {
+            fprintf(stderr,
+                    "Error pack slice: %i, Expected write to bitstream: %u Get: %u\n",
+                    pack_input->slice_idx,
+                    used_bytes_expected,
+                    used_bytes);
+            assert(0);
         }
+    }
 #endif
-        assert((error != SvtJxsErrorNone) ||
-               (bitstream_writer_get_used_bytes(&bitstream) == pack_input->out_bytes_end - pack_input->out_bytes_begin));
+    assert((error != SvtJxsErrorNone) ||
+           (bitstream_writer_get_used_bytes(&bitstream) == pack_input->out_bytes_end - pack_input->out_bytes_begin));
 
-        //Write End of Bitstream
-        if (error == SvtJxsErrorNone && pack_input->write_tail) {
-            assert(pack_input->tail_bytes_begin == pack_input->out_bytes_end);
-            void* buf = pcs_ptr->enc_input.bitstream.buffer + pack_input->tail_bytes_begin;
-            bitstream_writer_t bitstream;
-            bitstream_writer_init(&bitstream, buf, CODESTREAM_SIZE_BYTES);
-            write_tail(&bitstream);
-        }
+    //Write End of Bitstream
+    if (error == SvtJxsErrorNone && pack_input->write_tail) {
+        assert(pack_input->tail_bytes_begin == pack_input->out_bytes_end);
+        void* buf = pcs_ptr->enc_input.bitstream.buffer + pack_input->tail_bytes_begin;
+        bitstream_writer_t bitstream;
+        bitstream_writer_init(&bitstream, buf, CODESTREAM_SIZE_BYTES);
+        write_tail(&bitstream);
+    }
 
-        SvtJxsErrorType_t err = svt_jxs_get_empty_object(context_ptr->output_buffer_fifo_ptr, &output_wrapper_ptr);
-        if (err != SvtJxsErrorNone || output_wrapper_ptr == NULL) {
-            continue;
+    uint32_t rc_iterations = 0;
+    if (enc_common->stats_enable) {
+        for (uint32_t i = 0; i < precincts_stats_num; i++) {
+            rc_iterations += precincts[i].rc_iterations;
         }
+    }
+    if (slot) {
+        svt_jxs_release_object(pack_input->slice_slot_wrapper_ptr);
+    }
+
+    /*Thread of batch does not quit on shutdown of encoder and would wait again for pack output never released*/
+    if (enc_common->batch && SVT_ATOMIC_LOAD32(&enc_common->batch_closing)) {
+        return;
+    }
+    SvtJxsErrorType_t err = svt_jxs_get_empty_object(context_ptr->output_buffer_fifo_ptr, &output_wrapper_ptr);
+    if (err != SvtJxsErrorNone || output_wrapper_ptr == NULL) {
+        return;
+    }
 #ifdef FLAG_DEADLOCK_DETECT
-        printf("07[%s:%i] frame: %03li slice: %03d\n", __func__, __LINE__, (size_t)pcs_ptr->frame_number, pack_input->slice_idx);
+    printf("07[%s:%i] frame: %03li slice: %03d\n", __func__, __LINE__, (size_t)pcs_ptr->frame_number, pack_input->slice_idx);
 #endif
-        PackOutput* pack_out = (PackOutput*)output_wrapper_ptr->object_ptr;
-        pack_out->pcs_wrapper_ptr = pcs_wrapper_ptr;
-        pack_out->slice_idx = pack_input->slice_idx;
-        pack_out->slice_error = error;
+    PackOutput* pack_out = (PackOutput*)output_wrapper_ptr->object_ptr;
+    pack_out->pcs_wrapper_ptr = pcs_wrapper_ptr;
+    pack_out->slice_idx = pack_input->slice_idx;
+    pack_out->slice_error = error;
+    if (enc_common->stats_enable) {
+        pack_out->slice_time_us = svt_jxs_get_time_us() - stats_time_begin_us + stats_time_parts_us;
+        pack_out->rc_iterations = rc_iterations;
+        pack_out->padding_bytes = context_ptr->stats_padding_bytes;
+        pack_out->distortion = context_ptr->stats_distortion;
+        memcpy(pack_out->gtli_histogram, context_ptr->stats_gtli_histogram, sizeof(pack_out->gtli_histogram));
+    }
 #ifdef FLAG_DEADLOCK_DETECT
-        printf("07[%s:%i] frame: %03li slice: %03d\n", __func__, __LINE__, (size_t)pcs_ptr->frame_number, pack_out->slice_idx);
+    printf("07[%s:%i] frame: %03li slice: %03d\n", __func__, __LINE__, (size_t)pcs_ptr->frame_number, pack_out->slice_idx);
 #endif
-        svt_jxs_post_full_object(output_wrapper_ptr);
+    svt_jxs_post_full_object(output_wrapper_ptr);
+}
+
+void pack_stage_process_input(ThreadContext_t* thread_context_ptr, ObjectWrapper_t* input_wrapper_ptr) {
+    PackStageContext* context_ptr = (PackStageContext*)thread_context_ptr->priv;
+    PackInput_t* pack_input = (PackInput_t*)input_wrapper_ptr->object_ptr;
+    const PictureControlSet* pcs_ptr = (const PictureControlSet*)pack_input->pcs_wrapper_ptr->object_ptr;
+
+    /*Contiguous slices on one thread keep input lines shared by neighbour slices in cache*/
+    const uint32_t slice_last_idx = pack_input->slice_idx + pack_input->slices_num - 1;
+    pack_stage_process_slice(context_ptr, pack_input);
+    while (pack_input->slice_idx < slice_last_idx) {
+        pre_rc_setup_pack_slice(pcs_ptr, pack_input, pack_input->slice_idx + 1, pack_input->out_bytes_end);
+        pack_stage_process_slice(context_ptr, pack_input);
+    }
+
+    svt_jxs_release_object(input_wrapper_ptr);
+}
 
-        svt_jxs_release_object(input_wrapper_ptr);
+void* pack_stage_kernel(void* input_ptr) {
+    ThreadContext_t* enc_contxt_ptr = (ThreadContext_t*)input_ptr;
+    PackStageContext* context_ptr = (PackStageContext*)enc_contxt_ptr->priv;
+    ObjectWrapper_t* input_wrapper_ptr;
+
+    for (;;) {
+        // Get the Next svt Input Buffer [BLOCKING]
+        SVT_GET_FULL_OBJECT(context_ptr->input_buffer_fifo_ptr, &input_wrapper_ptr);
+        pack_stage_process_input(enc_contxt_ptr, input_wrapper_ptr);
     }
     return NULL;
 }
@@ -7,6 +7,9 @@
 #define _PACK_STAGE_H_
 
 #include "Definitions.h"
+#include "Encoder.h"
+#include "PrecinctEnc.h"
+#include "Threads/SvtArena.h"
 #ifdef __cplusplus
 extern "C" {
 #endif
@@ -15,6 +18,17 @@ extern "C" {
  ***************************************/
 SvtJxsErrorType_t pack_stage_context_ctor(ThreadContext_t *thread_context_ptr, svt_jpeg_xs_encoder_api_prv_t *enc_api_prv,
                                           int idx);
+/*Memory allocated by pack_stage_context_ctor()*/
+void pack_stage_context_memory(SvtMemSize_t *mem, const svt_jpeg_xs_encoder_common_t *enc_common);
+
+/*Allocate precincts with buffers for pack of precincts_num precincts of slice in arena*/
+SvtJxsErrorType_t pack_precincts_alloc(SvtArena_t *arena, svt_jpeg_xs_encoder_common_t *enc_common, uint32_t precincts_num,
+                                       precinct_enc_t **precincts_out);
+/*Memory allocated by pack_precincts_alloc()*/
+void pack_precincts_memory(SvtMemSize_t *mem, const svt_jpeg_xs_encoder_common_t *enc_common, uint32_t precincts_num);
+
+/*Calculate one task from pack input queue, on pack thread or on thread of batch*/
+void pack_stage_process_input(ThreadContext_t *thread_context_ptr, ObjectWrapper_t *input_wrapper_ptr);
 
 extern void *pack_stage_kernel(void *input_ptr);
 #ifdef __cplusplus
@@ -21,6 +21,8 @@ void picture_control_set_dctor(void_ptr p) {
     if (enc_common->slice_packetization_mode) {
         SVT_FREE(obj->slice_ready_to_release_arr);
     }
+    SVT_FREE(obj->slice_sizes);
+    SVT_FREE(obj->rate_stats_slices);
 }
 
 SvtJxsErrorType_t picture_control_set_ctor(PictureControlSet* obj, void_ptr object_init_data_ptr) {
@@ -36,8 +38,10 @@ SvtJxsErrorType_t picture_control_set_ctor(PictureControlSet* obj, void_ptr obje
         obj->coeff_buff_ptr_16bit[c] = NULL;
         if (enc_common->cpu_profile == CPU_PROFILE_CPU) {
             if (pi->components[c].decom_v == 1 || pi->components[c].decom_v == 2) {
-                SVT_MALLOC_ALIGNED_ARRAY(obj->coeff_buff_ptr_16bit[c],
-                                         (size_t)pi_enc->coeff_buff_tmp_size_precinct[c] * pi->precincts_line_num);
+                SVT_MALLOC_ALIGNED_PURPOSE(obj->coeff_buff_ptr_16bit[c],
+                                           sizeof(*obj->coeff_buff_ptr_16bit[c]) * pi_enc->coeff_buff_tmp_size_precinct[c] *
+                                               pi->precincts_line_num,
+                                           SVT_JXS_MEM_COEFFICIENTS);
             }
         }
     }
@@ -45,10 +49,40 @@ SvtJxsErrorType_t picture_control_set_ctor(PictureControlSet* obj, void_ptr obje
     if (enc_common->slice_packetization_mode) {
         SVT_MALLOC(obj->slice_ready_to_release_arr, pi->slice_num);
     }
+    /*Lcod 0 is invalid, slice sizes are calculated for first frame*/
+    obj->Lcod = 0;
+    SVT_MALLOC(obj->slice_sizes, pi->slice_num * sizeof(uint32_t));
+    obj->rate_stats_slices = NULL;
+    if (enc_common->stats_enable) {
+        SVT_CALLOC_ARRAY(obj->rate_stats_slices, pi->slice_num);
+    }
 
     return return_error;
 }
 
+void picture_control_set_memory(SvtMemSize_t* mem, const svt_jpeg_xs_encoder_common_t* enc_common) {
+    const pi_t* pi = &enc_common->pi;
+    const pi_enc_t* pi_enc = &enc_common->pi_enc;
+    size_t size = sizeof(PictureControlSet) + pi->slice_num * sizeof(uint32_t);
+    if (enc_common->slice_packetization_mode) {
+        size += pi->slice_num;
+    }
+    if (enc_common->stats_enable) {
+        size += pi->slice_num * sizeof(svt_jpeg_xs_slice_rate_stats_t);
+    }
+    svt_jxs_mem_size_add(mem, size, SVT_JXS_MEM_GENERAL);
+
+    if (enc_common->cpu_profile == CPU_PROFILE_CPU) {
+        for (uint32_t c = 0; c < pi->comps_num; ++c) {
+            if (pi->components[c].decom_v == 1 || pi->components[c].decom_v == 2) {
+                svt_jxs_mem_size_add(mem,
+                                     sizeof(uint16_t) * pi_enc->coeff_buff_tmp_size_precinct[c] * pi->precincts_line_num,
+                                     SVT_JXS_MEM_COEFFICIENTS);
+            }
+        }
+    }
+}
+
 SvtJxsErrorType_t picture_control_set_creator(void_ptr* object_dbl_ptr, void_ptr object_init_data_ptr) {
     PictureControlSet* obj;
 
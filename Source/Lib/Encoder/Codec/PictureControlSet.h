@@ -26,6 +26,11 @@ typedef struct PictureControlSet {
     int32_t frame_error;
     uint64_t frame_number;
 
+    /*Rate of frame, set by svt_jpeg_xs_encoder_set_rate() before frame is sent*/
+    uint32_t Lcod;
+    RateControlType rate_control_mode;
+    uint32_t *slice_sizes; /*Size of each coded slice, calculated again only when Lcod is changed*/
+
     /*Buffers to keep all data in frame*/
     uint16_t *coeff_buff_ptr_16bit[MAX_COMPONENTS_NUM]; //Requires for Profile: CPU
     uint32_t slice_cnt;
@@ -33,12 +38,21 @@ typedef struct PictureControlSet {
     uint8_t *slice_ready_to_release_arr;
     uint32_t slice_released_idx;
     uint32_t bitstream_release_offset;
+
+    /*Statistics, collected only when stats_enable*/
+    svt_jpeg_xs_frame_stats_t stats;
+    uint64_t stats_time_send_us;
+    uint64_t stats_dwt_time_us[MAX_COMPONENTS_NUM]; /*Set by DWT stage before last slice of component is released*/
+    svt_jpeg_xs_rate_stats_t rate_stats;             /*Slices points to rate_stats_slices*/
+    svt_jpeg_xs_slice_rate_stats_t *rate_stats_slices;
 } PictureControlSet;
 
 /**************************************
  * Extern Function Declarations
  **************************************/
 extern SvtJxsErrorType_t picture_control_set_creator(void_ptr *object_dbl_ptr, void_ptr object_init_data_ptr);
+/*Memory allocated by picture_control_set_creator()*/
+extern void picture_control_set_memory(SvtMemSize_t *mem, const svt_jpeg_xs_encoder_common_t *enc_common);
 
 #ifdef __cplusplus
 }
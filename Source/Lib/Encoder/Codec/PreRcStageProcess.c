@@ -6,6 +6,7 @@
 #include <stdlib.h>
 #include <string.h>
 
+#include "EncBatch.h"
 #include "EncHandle.h"
 #include "PictureControlSet.h"
 #include "PreRcStageProcess.h"
@@ -28,8 +29,82 @@ uint32_t write_pic_level_header_nbytes(uint8_t* buffer_ptr, size_t buffer_size,
     return bitstream_writer_get_used_bytes(&bitstream);
 }
 
-PackInput_t* pre_rc_send_frame_to_pack_slices(PictureControlSet* pcs_ptr, Fifo_t* output_buffer_fifo_ptr, uint64_t frame_num,
-                                              ObjectWrapper_t* pcs_wrapper_ptr) {
+void pre_rc_calculate_slice_sizes(const svt_jpeg_xs_encoder_common_t* enc_common, uint32_t Lcod, uint32_t* slice_sizes) {
+    const pi_t* pi = &enc_common->pi;
+    uint32_t picture_headlen_bytes = enc_common->frame_header_length_bytes;
+    uint32_t heders_and_tags_bytes = picture_headlen_bytes + CODESTREAM_SIZE_BYTES + SLICE_HEADER_SIZE_BYTES * pi->slice_num;
+    assert(Lcod >= heders_and_tags_bytes);
+    uint32_t size_all_precincts_bytes = Lcod - heders_and_tags_bytes;
+
+    uint32_t precincst_last_slice = pi->precincts_per_slice - (pi->slice_num * pi->precincts_per_slice - pi->precincts_line_num);
+    /* Last slice can have less precinct so need to balance size between slices.
+     * First slices get more one byte per slice*/
+    uint32_t min_size_per_precinct_bytes = size_all_precincts_bytes / pi->precincts_line_num;
+    uint32_t min_size_per_slice_bytes = min_size_per_precinct_bytes * pi->precincts_per_slice;
+    uint32_t last_size_per_slice_bytes = min_size_per_precinct_bytes * precincst_last_slice;
+    assert(size_all_precincts_bytes >= last_size_per_slice_bytes + min_size_per_slice_bytes * (pi->slice_num - 1));
+    uint32_t size_left_bytes = size_all_precincts_bytes - last_size_per_slice_bytes -
+        min_size_per_slice_bytes * (pi->slice_num - 1);
+
+    /*Add to slices proportionally to precincts in slice*/
+    if (pi->slice_num > 1) {
+        assert(((uint64_t)size_left_bytes * (pi->slice_num - 1) * pi->precincts_per_slice) < UINT32_MAX);
+        min_size_per_slice_bytes += (size_left_bytes * (pi->slice_num - 1) * pi->precincts_per_slice / pi->precincts_line_num) /
+            (pi->slice_num - 1);
+    }
+    assert(((uint64_t)size_left_bytes * precincst_last_slice) < UINT32_MAX);
+    last_size_per_slice_bytes += size_left_bytes * precincst_last_slice / pi->precincts_line_num;
+    size_left_bytes = size_all_precincts_bytes - last_size_per_slice_bytes - min_size_per_slice_bytes * (pi->slice_num - 1);
+    assert(size_left_bytes <= pi->slice_num);
+
+    uint32_t bytes_left = Lcod - picture_headlen_bytes;
+    for (uint32_t i = 0; i < pi->slice_num; i++) {
+        if (i != pi->slice_num - 1) {
+            uint32_t size_per_slice_bytes = min_size_per_slice_bytes;
+            if (i < size_left_bytes) {
+                size_per_slice_bytes++;
+            }
+            size_per_slice_bytes += SLICE_HEADER_SIZE_BYTES;
+            slice_sizes[i] = size_per_slice_bytes;
+            bytes_left -= size_per_slice_bytes;
+        }
+        else {
+            slice_sizes[i] = bytes_left;
+        }
+    }
+}
+
+void pre_rc_setup_pack_slice(const PictureControlSet* pcs_ptr, PackInput_t* pack_input, uint32_t slice_idx,
+                             uint32_t out_bytes_begin) {
+    pack_input->slice_idx = slice_idx;
+    pack_input->out_bytes_begin = out_bytes_begin;
+
+    if (slice_idx != pcs_ptr->enc_common->pi.slice_num - 1) {
+        pack_input->slice_budget_bytes = pcs_ptr->slice_sizes[slice_idx] - SLICE_HEADER_SIZE_BYTES;
+        pack_input->out_bytes_end = pack_input->out_bytes_begin + pcs_ptr->slice_sizes[slice_idx];
+        pack_input->write_tail = 0;
+    }
+    else {
+        pack_input->slice_budget_bytes = pcs_ptr->slice_sizes[slice_idx] - SLICE_HEADER_SIZE_BYTES - CODESTREAM_SIZE_BYTES;
+        pack_input->out_bytes_end = pack_input->out_bytes_begin + pcs_ptr->slice_sizes[slice_idx] - CODESTREAM_SIZE_BYTES;
+        //Last slice, End of Bitstream
+        pack_input->tail_bytes_begin = pack_input->out_bytes_end;
+        pack_input->write_tail = 1;
+    }
+}
+
+/*Send task to own pack threads of encoder or to threads of batch*/
+static void pre_rc_post_pack_input(svt_jpeg_xs_encoder_common_t* enc_common, ObjectWrapper_t* wrapper_ptr) {
+    if (enc_common->batch) {
+        enc_batch_post(enc_common->batch, wrapper_ptr);
+    }
+    else {
+        svt_jxs_post_full_object(wrapper_ptr);
+    }
+}
+
+PackInput_t* pre_rc_send_frame_to_pack_slices(PictureControlSet* pcs_ptr, Fifo_t* output_buffer_fifo_ptr,
+                                              Fifo_t* slice_slot_fifo_ptr, uint64_t frame_num, ObjectWrapper_t* pcs_wrapper_ptr) {
     UNUSED(frame_num); // Value only used when FLAG_DEADLOCK_DETECT is enabled
     svt_jpeg_xs_encoder_common_t* enc_common = pcs_ptr->enc_common;
     PackInput_t* first = NULL;
@@ -41,7 +116,13 @@ PackInput_t* pre_rc_send_frame_to_pack_slices(PictureControlSet* pcs_ptr, Fifo_t
 
     //Copy image header
     memcpy(pcs_ptr->enc_input.bitstream.buffer, enc_common->frame_header_buffer, enc_common->frame_header_length_bytes);
-    pcs_ptr->enc_input.bitstream.used_size = enc_common->picture_header_dynamic.hdr_Lcod;
+    /*Lcod of frame can be changed by svt_jpeg_xs_encoder_set_rate()*/
+    uint8_t* Lcod_ptr = pcs_ptr->enc_input.bitstream.buffer + FRAME_HEADER_LCOD_OFFSET_BYTES;
+    Lcod_ptr[0] = (uint8_t)(pcs_ptr->Lcod >> 24);
+    Lcod_ptr[1] = (uint8_t)(pcs_ptr->Lcod >> 16);
+    Lcod_ptr[2] = (uint8_t)(pcs_ptr->Lcod >> 8);
+    Lcod_ptr[3] = (uint8_t)pcs_ptr->Lcod;
+    pcs_ptr->enc_input.bitstream.used_size = pcs_ptr->Lcod;
 
     if (enc_common->cpu_profile == CPU_PROFILE_CPU) {
         //All tasks need pointer no next one in frame. Get first task.
@@ -52,7 +133,9 @@ PackInput_t* pre_rc_send_frame_to_pack_slices(PictureControlSet* pcs_ptr, Fifo_t
     }
 
     uint32_t output_bytes_begin = enc_common->frame_header_length_bytes;
-    for (uint32_t i = 0; i < enc_common->pi.slice_num; i++) {
+    /*Always 1 in CPU profile, DWT stage sync with every slice task*/
+    const uint32_t slices_per_task = enc_common->slices_per_pack_task;
+    for (uint32_t i = 0; i < enc_common->pi.slice_num; i += slices_per_task) {
         PackInput_t* pack_input;
         if (enc_common->cpu_profile == CPU_PROFILE_CPU) {
             output_wrapper_ptr = output_wrapper_ptr_next;
@@ -88,29 +171,52 @@ PackInput_t* pre_rc_send_frame_to_pack_slices(PictureControlSet* pcs_ptr, Fifo_t
             pack_input = (PackInput_t*)output_wrapper_ptr->object_ptr;
         }
 
-        pack_input->slice_idx = i;
-        pack_input->out_bytes_begin = output_bytes_begin;
-
-        if (i != enc_common->pi.slice_num - 1) {
-            pack_input->slice_budget_bytes = enc_common->slice_sizes[i] - SLICE_HEADER_SIZE_BYTES;
-            pack_input->out_bytes_end = pack_input->out_bytes_begin + enc_common->slice_sizes[i];
-            pack_input->write_tail = 0;
-        }
-        else {
-            pack_input->slice_budget_bytes = enc_common->slice_sizes[i] - SLICE_HEADER_SIZE_BYTES - CODESTREAM_SIZE_BYTES;
-            pack_input->out_bytes_end = pack_input->out_bytes_begin + enc_common->slice_sizes[i] - CODESTREAM_SIZE_BYTES;
-            //Last slice, End of Bitstream
-            pack_input->tail_bytes_begin = pack_input->out_bytes_end;
-            pack_input->write_tail = 1;
-        }
+        pre_rc_setup_pack_slice(pcs_ptr, pack_input, i, output_bytes_begin);
+        pack_input->slices_num = MIN(slices_per_task, enc_common->pi.slice_num - i);
 
         output_bytes_begin = pack_input->out_bytes_end;
+        for (uint32_t next = i + 1; next < i + pack_input->slices_num; next++) {
+            output_bytes_begin += pcs_ptr->slice_sizes[next];
+        }
         pack_input->pcs_wrapper_ptr = pcs_wrapper_ptr;
+        pack_input->slice_slot_wrapper_ptr = NULL;
+        pack_input->slice_part_idx = 0;
 #ifdef FLAG_DEADLOCK_DETECT
         printf("04[%s:%i] frame: %03li slice: %03d\n", __func__, __LINE__, (size_t)frame_num, pack_input->slice_idx);
 #endif
+        if (slice_slot_fifo_ptr) {
+            /*Precincts of slice are prepared by many parts, all parts have to be sent before first finish*/
+            ObjectWrapper_t* slot_wrapper_ptr = NULL;
+            SvtJxsErrorType_t ret = svt_jxs_get_empty_object(slice_slot_fifo_ptr, &slot_wrapper_ptr);
+            if (ret != SvtJxsErrorNone || slot_wrapper_ptr == NULL) {
+                return NULL;
+            }
+            PackSliceSlot_t* slot = (PackSliceSlot_t*)slot_wrapper_ptr->object_ptr;
+            slot->parts_left = enc_common->slice_parts_num;
+            pack_input->slice_slot_wrapper_ptr = slot_wrapper_ptr;
+
+            for (uint32_t part = 1; part < enc_common->slice_parts_num; part++) {
+                ObjectWrapper_t* part_wrapper_ptr = NULL;
+                ret = svt_jxs_get_empty_object(output_buffer_fifo_ptr, &part_wrapper_ptr);
+                if (ret != SvtJxsErrorNone || part_wrapper_ptr == NULL) {
+                    return NULL;
+                }
+                PackInput_t* part_input = (PackInput_t*)part_wrapper_ptr->object_ptr;
+                part_input->pcs_wrapper_ptr = pcs_wrapper_ptr;
+                part_input->slice_idx = pack_input->slice_idx;
+                part_input->slices_num = 1;
+                part_input->slice_budget_bytes = pack_input->slice_budget_bytes;
+                part_input->out_bytes_begin = pack_input->out_bytes_begin;
+                part_input->out_bytes_end = pack_input->out_bytes_end;
+                part_input->tail_bytes_begin = pack_input->tail_bytes_begin;
+                part_input->write_tail = pack_input->write_tail;
+                part_input->slice_slot_wrapper_ptr = slot_wrapper_ptr;
+                part_input->slice_part_idx = part;
+                pre_rc_post_pack_input(enc_common, part_wrapper_ptr);
+            }
+        }
         //Send direct to PACK
-        svt_jxs_post_full_object(output_wrapper_ptr);
+        pre_rc_post_pack_input(enc_common, output_wrapper_ptr);
     }
     return first;
 }
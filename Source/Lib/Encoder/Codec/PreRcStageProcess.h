@@ -18,10 +18,21 @@
 extern "C" {
 #endif
 
+/*Offset of Lcod in frame header: SOC, CAP, PIH marker and Lpih*/
+#define FRAME_HEADER_LCOD_OFFSET_BYTES (12)
+
 uint32_t write_pic_level_header_nbytes(uint8_t* buffer_ptr, size_t buffer_size, svt_jpeg_xs_encoder_common_t* enc_common);
+/*Distribute Lcod bytes of frame between slices, slice_sizes include slice header and tail of codestream in last slice*/
+void pre_rc_calculate_slice_sizes(const svt_jpeg_xs_encoder_common_t* enc_common, uint32_t Lcod, uint32_t* slice_sizes);
+
+/*Set budget and output range of slice_idx in pack task, out_bytes_begin is end of previous slice*/
+void pre_rc_setup_pack_slice(const PictureControlSet* pcs_ptr, PackInput_t* pack_input, uint32_t slice_idx,
+                             uint32_t out_bytes_begin);
 
-PackInput_t* pre_rc_send_frame_to_pack_slices(PictureControlSet* pcs_ptr, Fifo_t* output_buffer_fifo_ptr, uint64_t frame_num,
-                                              ObjectWrapper_t* pcs_wrapper_ptr);
+/*Send pack task for every enc_common->slices_per_pack_task slices of frame,
+ *or enc_common->slice_parts_num tasks per slice sharing slot from slice_slot_fifo_ptr*/
+PackInput_t* pre_rc_send_frame_to_pack_slices(PictureControlSet* pcs_ptr, Fifo_t* output_buffer_fifo_ptr,
+                                              Fifo_t* slice_slot_fifo_ptr, uint64_t frame_num, ObjectWrapper_t* pcs_wrapper_ptr);
 
 #ifdef __cplusplus
 }
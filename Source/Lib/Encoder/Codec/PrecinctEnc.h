@@ -70,6 +70,8 @@ typedef struct precinct_enc {
     } bands[MAX_COMPONENTS_NUM][MAX_BANDS_PER_COMPONENT_NUM];
     /*For some RC modes with Vertical Prediction when change precinct need recalculate next precinct.*/
     uint8_t need_recalculate_next_precinct;
+    uint32_t rc_iterations; /*Number of budget calculations, for statistics*/
+    uint8_t rc_no_vpred_tables; /*Set when rc_cache_line.no_vpred of all lines is filled by rate_control_init_precinct()*/
 
     /*Precinct pack parameters*/
     uint32_t pack_quantization;
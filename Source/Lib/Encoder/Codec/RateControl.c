@@ -255,6 +255,43 @@ static uint32_t rate_control_lut_significance_elements_less_equal_gtli(rc_cache_
 
 #endif
 
+/*Number of GCLI bits removed by significance flags for GTLI in line of band*/
+static uint32_t rate_control_significance_zeroed_gcli_bits(pi_t *pi, precinct_enc_t *precinct, uint32_t c, uint32_t b,
+                                                           uint32_t line_idx, uint8_t gtli) {
+    struct band_data_enc *band = &precinct->bands[c][b];
+    const uint32_t gcli_width = precinct->p_info->b_info[c][b].gcli_width;
+    const uint32_t significance_width = precinct->p_info->b_info[c][b].significance_width;
+    //Remove from values zeroed sig flags
+    uint8_t *sigFlagMaxGCLI = band->lines_common[line_idx].significance_data_max_ptr;
+    const uint32_t full_group = gcli_width / pi->significance_group_size;
+    /*GCLI value 0 is compressed by VLC to 1 bit,
+     *so we can remove number of bits equal to significance group size from pack_size_gcli*/
+#if LUT_SIGNIFICANE
+    uint32_t significance_flags_zeroed_sum = rate_control_lut_significance_elements_less_equal_gtli(
+        &band->lines_common[line_idx].rc_cache_line, gtli);
+    significance_flags_zeroed_sum *= pi->significance_group_size;
+    if (full_group < significance_width) {
+        if (sigFlagMaxGCLI[full_group] <= gtli) {
+            significance_flags_zeroed_sum += gcli_width - full_group * pi->significance_group_size;
+        }
+    }
+#else  /*LUT_SIGNIFICANE*/
+    uint32_t significance_flags_zeroed_sum = 0;
+    uint32_t sigf_group = 0;
+    for (; sigf_group < full_group; sigf_group++) {
+        if (sigFlagMaxGCLI[sigf_group] <= gtli) {
+            significance_flags_zeroed_sum += pi->significance_group_size;
+        }
+    }
+    if (sigf_group < significance_width) {
+        if (sigFlagMaxGCLI[sigf_group] <= gtli) {
+            significance_flags_zeroed_sum += gcli_width - sigf_group * pi->significance_group_size;
+        }
+    }
+#endif /*SIGNIFICANE_LUT*/
+    return significance_flags_zeroed_sum;
+}
+
 static uint32_t rate_control_get_headers_bytes(svt_jpeg_xs_encoder_common_t *enc_common, precinct_enc_t *precinct) {
     pi_t *pi = &enc_common->pi;
     uint32_t headers_bytes = BITS_TO_BYTE_WITH_ALIGN(PRECINCT_HEADER_SIZE_BYTES * 8 + pi->bands_num_exists * 2);
@@ -537,38 +574,9 @@ static void rate_control_calculate_band_best_method(pi_t *pi, precinct_enc_t *pr
                     uint32_t pack_size_gcli[MAX_BAND_LINES];
 
                     for (uint32_t line_idx = 0; line_idx < height_lines; ++line_idx) {
-                        rc_cache_band_line_t *cache_line = &band->lines_common[line_idx].rc_cache_line;
-                        //Remove from values zeroed sig flags
-                        uint8_t *sigFlagMaxGCLI = band->lines_common[line_idx].significance_data_max_ptr;
-                        const uint32_t full_group = gcli_width / pi->significance_group_size;
-                        /*GCLI value 0 is compressed by VLC to 1 bit,
-                         *so we can remove number of bits equal to significance group size from pack_size_gcli*/
-#if LUT_SIGNIFICANE
-                        uint32_t significance_flags_zeroed_sum = rate_control_lut_significance_elements_less_equal_gtli(
-                            cache_line, band->gtli);
-                        significance_flags_zeroed_sum *= pi->significance_group_size;
-                        if (full_group < significance_width) {
-                            if (sigFlagMaxGCLI[full_group] <= band->gtli) {
-                                significance_flags_zeroed_sum += gcli_width - full_group * pi->significance_group_size;
-                            }
-                        }
-#else  /*LUT_SIGNIFICANE*/
-                        uint32_t significance_flags_zeroed_sum = 0;
-                        uint32_t sigf_group = 0;
-                        for (; sigf_group < full_group; sigf_group++) {
-                            if (sigFlagMaxGCLI[sigf_group] <= band->gtli) {
-                                significance_flags_zeroed_sum += pi->significance_group_size;
-                            }
-                        }
-                        if (sigf_group < significance_width) {
-                            if (sigFlagMaxGCLI[sigf_group] <= band->gtli) {
-                                significance_flags_zeroed_sum += gcli_width - sigf_group * pi->significance_group_size;
-                            }
-                        }
-#endif /*SIGNIFICANE_LUT*/
                         /*Use GCLI from disable signification, and remove signification zero elements*/
                         pack_size_gcli[line_idx] = band_cache->lines[line_idx].pack_size_gcli_bits -
-                            significance_flags_zeroed_sum;
+                            rate_control_significance_zeroed_gcli_bits(pi, precinct, c, b, line_idx, band->gtli);
                         budget += pack_size_gcli[line_idx];
                     }
 
@@ -701,13 +709,14 @@ static void rate_control_reset_cache(pi_t *pi, precinct_enc_t *precinct) {
     }
 }
 
-static uint32_t precinct_get_budget_bytes(svt_jpeg_xs_encoder_common_t *enc_common, precinct_enc_t *precinct,
-                                          VerticalPredictionMode coding_vertical_prediction_mode,
-                                          SignHandlingStrategy coding_signs_handling) {
+uint32_t precinct_get_budget_bytes(svt_jpeg_xs_encoder_common_t *enc_common, precinct_enc_t *precinct,
+                                   VerticalPredictionMode coding_vertical_prediction_mode,
+                                   SignHandlingStrategy coding_signs_handling) {
     pi_t *pi = &enc_common->pi;
     /*For current implementation support only more complex implementation
       that 2 packages with that same band can have different ram mode flag.*/
     assert(enc_common->picture_header_dynamic.hdr_Rl != 0);
+    precinct->rc_iterations++;
     rate_control_calculate_band_best_method(pi, precinct, enc_common, coding_vertical_prediction_mode, coding_signs_handling);
     precinct_info_t *p_info = precinct->p_info;
 
@@ -780,6 +789,89 @@ static uint32_t precinct_get_budget_bytes(svt_jpeg_xs_encoder_common_t *enc_comm
     return precinct_size_bytes;
 }
 
+/*Precalculate bits of every band line for all GTLI values in one pass, without vertical prediction.
+ *Method with significance is chosen per band like in rate_control_calculate_band_best_method().*/
+static void rate_control_lut_fill_no_vpred(svt_jpeg_xs_encoder_common_t *enc_common, precinct_enc_t *precinct,
+                                           SignHandlingStrategy coding_signs_handling) {
+    pi_t *pi = &enc_common->pi;
+    for (uint32_t c = 0; c < pi->comps_num; ++c) {
+        for (uint32_t b = 0; b < pi->components[c].bands_num; ++b) {
+            struct band_data_enc *band = &precinct->bands[c][b];
+            const uint32_t height_lines = precinct->p_info->b_info[c][b].height;
+            const uint32_t significance_width = precinct->p_info->b_info[c][b].significance_width;
+            for (uint8_t gtli = 0; gtli <= TRUNCATION_MAX; ++gtli) {
+                uint32_t budget_no_significance = 0;
+                for (uint32_t line_idx = 0; line_idx < height_lines; ++line_idx) {
+                    rc_cache_band_line_t *cache_line = &band->lines_common[line_idx].rc_cache_line;
+                    struct rc_no_vpred_bits *bits = &cache_line->no_vpred[gtli];
+                    uint32_t sum_data;
+                    uint32_t sum_signs_max;
+                    rate_control_lut_summarize_non_significance_gc_and_data_code_sum(
+                        cache_line, gtli, &sum_data, &bits->gcli_bits, &sum_signs_max, !!coding_signs_handling);
+                    bits->significance_bits = 0;
+                    bits->data_bits = sum_data * pi->coeff_group_size;
+                    bits->signs_handling_bits = sum_signs_max * pi->coeff_group_size;
+                    budget_no_significance += bits->gcli_bits;
+                }
+                if (enc_common->coding_significance) {
+                    uint32_t pack_size_gcli[MAX_BAND_LINES];
+                    uint32_t budget = significance_width * height_lines;
+                    for (uint32_t line_idx = 0; line_idx < height_lines; ++line_idx) {
+                        pack_size_gcli[line_idx] = band->lines_common[line_idx].rc_cache_line.no_vpred[gtli].gcli_bits -
+                            rate_control_significance_zeroed_gcli_bits(pi, precinct, c, b, line_idx, gtli);
+                        budget += pack_size_gcli[line_idx];
+                    }
+                    if (budget_no_significance > budget) {
+                        for (uint32_t line_idx = 0; line_idx < height_lines; ++line_idx) {
+                            struct rc_no_vpred_bits *bits = &band->lines_common[line_idx].rc_cache_line.no_vpred[gtli];
+                            bits->gcli_bits = pack_size_gcli[line_idx];
+                            bits->significance_bits = significance_width;
+                        }
+                    }
+                }
+            }
+        }
+    }
+}
+
+/*The same budget as precinct_get_budget_bytes() with METHOD_PRED_DISABLE and sign handling OFF or FAST,
+ *but only from tables filled by rate_control_lut_fill_no_vpred(). Band cache and packet sizes are not updated.*/
+uint32_t precinct_get_budget_bytes_no_vpred(svt_jpeg_xs_encoder_common_t *enc_common, precinct_enc_t *precinct) {
+    pi_t *pi = &enc_common->pi;
+    precinct_info_t *p_info = precinct->p_info;
+    assert(precinct->rc_no_vpred_tables);
+    precinct->rc_iterations++;
+
+    uint32_t precinct_size_bytes = 0;
+    for (uint32_t packet_idx = 0; packet_idx < pi->packets_num; packet_idx++) {
+        uint32_t packet_size_data_bits = 0;
+        uint32_t packet_size_signs_handling_bits = 0;
+        uint32_t packet_size_gcli_bits = 0;
+        uint32_t packet_size_significance_bits = 0;
+        const uint32_t line_idx = pi->packets[packet_idx].line_idx;
+
+        for (uint32_t band_idx = pi->packets[packet_idx].band_start; band_idx < pi->packets[packet_idx].band_stop; band_idx++) {
+            const uint32_t b = pi->global_band_info[band_idx].band_id;
+            const uint32_t c = pi->global_band_info[band_idx].comp_id;
+            if (line_idx < p_info->b_info[c][b].height) {
+                const struct band_data_enc *band = &precinct->bands[c][b];
+                const struct rc_no_vpred_bits *bits = &band->lines_common[line_idx].rc_cache_line.no_vpred[band->gtli];
+                packet_size_gcli_bits += bits->gcli_bits;
+                packet_size_significance_bits += bits->significance_bits;
+                packet_size_data_bits += bits->data_bits;
+                packet_size_signs_handling_bits += bits->signs_handling_bits;
+            }
+        }
+
+        precinct_size_bytes += BITS_TO_BYTE_WITH_ALIGN(packet_size_data_bits) +
+            BITS_TO_BYTE_WITH_ALIGN(packet_size_signs_handling_bits);
+        uint32_t packet_size_gcli_bytes = BITS_TO_BYTE_WITH_ALIGN(packet_size_significance_bits) +
+            BITS_TO_BYTE_WITH_ALIGN(packet_size_gcli_bits);
+        precinct_size_bytes += MIN(packet_size_gcli_bytes, p_info->packet_size_gcli_raw_bytes[packet_idx]);
+    }
+    return precinct_size_bytes;
+}
+
 #ifndef NDEBUG
 /* Find the minimum quantization to total budget that will be less than or equal to the available buffer.*/
 static SvtJxsErrorType_t rate_control_find_best_quantization(svt_jpeg_xs_encoder_common_t *enc_common, uint32_t budget_bytes,
@@ -920,8 +1012,14 @@ static SvtJxsErrorType_t rate_control_find_best_quantization_binary_search(svt_j
             next_step = BINARY_STEP_OUT_OF_RANGE;
             continue;
         }
-        uint32_t total_budget_bytes = precinct_get_budget_bytes(
-            enc_common, precinct, METHOD_PRED_DISABLE, coding_signs_handling_bin_search);
+        uint32_t total_budget_bytes;
+        if (precinct->rc_no_vpred_tables) {
+            total_budget_bytes = precinct_get_budget_bytes_no_vpred(enc_common, precinct);
+        }
+        else {
+            total_budget_bytes = precinct_get_budget_bytes(
+                enc_common, precinct, METHOD_PRED_DISABLE, coding_signs_handling_bin_search);
+        }
 
         if (total_budget_bytes > budget_bytes) {
             //To small value of quantization
@@ -1037,6 +1135,10 @@ static SvtJxsErrorType_t rate_control_find_best_refinement_binary_search(svt_jpe
     uint32_t refinement;
     int32_t refinement_last_tested = -1;
     uint32_t total_budget_last_bytes = 0;
+    /*Without vertical prediction and full sign handling budget is only lookup to precalculated tables,
+     *then band cache and packet sizes are calculated once for found refinement.*/
+    const uint8_t use_no_vpred_tables = precinct->rc_no_vpred_tables &&
+        (coding_vertical_prediction_mode == METHOD_PRED_DISABLE) && (coding_signs_handling != SIGN_HANDLING_STRATEGY_FULL);
 
     //MAIN LOOP:
     while (BINARY_RESULT_CONTINUE == (result = binary_search_next_step(&search, next_step, &refinement))) {
@@ -1048,9 +1150,15 @@ static SvtJxsErrorType_t rate_control_find_best_refinement_binary_search(svt_jpe
             next_step = BINARY_STEP_OUT_OF_RANGE;
             continue;
         }
-        uint32_t total_budget_bytes = precinct_get_budget_bytes(
-            enc_common, precinct, coding_vertical_prediction_mode, coding_signs_handling);
-        refinement_last_tested = refinement;
+        uint32_t total_budget_bytes;
+        if (use_no_vpred_tables) {
+            total_budget_bytes = precinct_get_budget_bytes_no_vpred(enc_common, precinct);
+        }
+        else {
+            total_budget_bytes = precinct_get_budget_bytes(
+                enc_common, precinct, coding_vertical_prediction_mode, coding_signs_handling);
+            refinement_last_tested = refinement;
+        }
         total_budget_last_bytes = total_budget_bytes;
 
         //Because look for maximum pass not stop on first equal budget
@@ -1085,7 +1193,7 @@ static SvtJxsErrorType_t rate_control_find_best_refinement_binary_search(svt_jpe
 /* Find minimum quantization to total budget will be smaller or equal that available buffer.*/
 static SvtJxsErrorType_t rate_control_find_best_quantization_fast_no_vpred_no_sign_full_binary_search(
     svt_jpeg_xs_encoder_common_t *enc_common, uint32_t budget_slice_bytes, precinct_enc_t *precincts, uint32_t prec_num,
-    uint8_t *out_quantization, SignHandlingStrategy coding_signs_handling) {
+    uint8_t *out_quantization) {
     const uint8_t max_quantization = enc_common->pi_enc.max_quantization;
     SvtJxsErrorType_t ret = SvtJxsErrorEncodeFrameError;
     pi_t *pi = &enc_common->pi; /* Picture Information */
@@ -1101,11 +1209,6 @@ static SvtJxsErrorType_t rate_control_find_best_quantization_fast_no_vpred_no_si
     binary_search_init(&search, 0, max_quantization, find_below_or_equal, initial_step);
     uint32_t quantization_simple;
 
-    SignHandlingStrategy coding_signs_handling_bin_search = coding_signs_handling;
-    if (coding_signs_handling_bin_search == SIGN_HANDLING_STRATEGY_FULL) {
-        coding_signs_handling_bin_search = SIGN_HANDLING_STRATEGY_FAST;
-    }
-
     //MAIN LOOP: Search simple with disable coding_vertical_prediction_mode and coding_signs_handling
     while (BINARY_RESULT_CONTINUE == (result = binary_search_next_step(&search, next_step, &quantization_simple))) {
         //Test quantization value:
@@ -1116,8 +1219,7 @@ static SvtJxsErrorType_t rate_control_find_best_quantization_fast_no_vpred_no_si
             if (empty) {
                 break;
             }
-            total_budget_bytes += precinct_get_budget_bytes(
-                enc_common, &precincts[i], METHOD_PRED_DISABLE, coding_signs_handling_bin_search);
+            total_budget_bytes += precinct_get_budget_bytes_no_vpred(enc_common, &precincts[i]);
         }
         if (empty) {
             //Required when add too big size
@@ -1146,7 +1248,7 @@ static SvtJxsErrorType_t rate_control_find_best_quantization_fast_no_vpred_no_si
  * Take care of recalculate precinct with final refinement for value.*/
 static SvtJxsErrorType_t rate_control_find_best_refinement_fast_no_vpred_no_sign_full_binary_search(
     svt_jpeg_xs_encoder_common_t *enc_common, uint32_t budget_slice_bytes, precinct_enc_t *precincts, uint32_t prec_num,
-    uint8_t quantization, uint8_t *out_refinement, uint32_t *data_budget_bytes, SignHandlingStrategy coding_signs_handling) {
+    uint8_t quantization, uint8_t *out_refinement, uint32_t *data_budget_bytes) {
     const uint8_t max_refinement = enc_common->pi_enc.max_refinement;
     SvtJxsErrorType_t ret = SvtJxsErrorEncodeFrameError;
 
@@ -1173,8 +1275,7 @@ static SvtJxsErrorType_t rate_control_find_best_refinement_fast_no_vpred_no_sign
             if (empty) {
                 break;
             }
-            total_budget_bytes += precinct_get_budget_bytes(
-                enc_common, &precincts[i], METHOD_PRED_DISABLE, coding_signs_handling);
+            total_budget_bytes += precinct_get_budget_bytes_no_vpred(enc_common, &precincts[i]);
         }
         if (empty) {
             //Required when add too big size
@@ -1239,10 +1340,21 @@ static SvtJxsErrorType_t rate_control_find_best_quantization_refinement_binary_s
     return ret;
 }
 
+/*Tables without vertical prediction are read by searches of RC per slice,
+ *and by RC per precinct only when vertical prediction and sign handling FULL are disabled.*/
+static uint8_t rate_control_use_no_vpred_tables(RateControlType rate_control_mode,
+                                                VerticalPredictionMode coding_vertical_prediction_mode,
+                                                SignHandlingStrategy coding_signs_handling) {
+    if (rate_control_mode == RC_CBR_PER_SLICE_COMMON_QUANT || rate_control_mode == RC_CBR_PER_SLICE_COMMON_QUANT_MAX_RATE) {
+        return 1;
+    }
+    return (coding_vertical_prediction_mode == METHOD_PRED_DISABLE) && (coding_signs_handling != SIGN_HANDLING_STRATEGY_FULL);
+}
+
 /*Init precalculate precinct for Rate Control*/
 void rate_control_init_precinct(struct PictureControlSet *pcs_ptr, precinct_enc_t *precinct,
+                                VerticalPredictionMode coding_vertical_prediction_mode,
                                 SignHandlingStrategy coding_signs_handling) {
-    UNUSED(coding_signs_handling);
     svt_jpeg_xs_encoder_common_t *enc_common = pcs_ptr->enc_common;
     /*Precalculate LUT*/
     rate_control_lut_fill(enc_common,
@@ -1253,6 +1365,11 @@ void rate_control_init_precinct(struct PictureControlSet *pcs_ptr, precinct_enc_
                           coding_signs_handling,
 #endif
                           precinct);
+    precinct->rc_no_vpred_tables = rate_control_use_no_vpred_tables(
+        pcs_ptr->rate_control_mode, coding_vertical_prediction_mode, coding_signs_handling);
+    if (precinct->rc_no_vpred_tables) {
+        rate_control_lut_fill_no_vpred(enc_common, precinct, coding_signs_handling);
+    }
 }
 
 /*Find best Quantization and Refinement for Precinct. Need before call rate_control_init_precinct().*/
@@ -1338,6 +1455,7 @@ SvtJxsErrorType_t rate_control_slice_quantization_fast_no_vpred_no_sign_full(str
                                                                              uint32_t budget_slice_bytes,
                                                                              SignHandlingStrategy coding_signs_handling) {
     svt_jpeg_xs_encoder_common_t *enc_common = pcs_ptr->enc_common;
+    /*Sign handling FULL is searched and packed as FAST, tables are filled for it in rate_control_init_precinct()*/
     if (coding_signs_handling == SIGN_HANDLING_STRATEGY_FULL) {
         coding_signs_handling = SIGN_HANDLING_STRATEGY_FAST;
     }
@@ -1371,7 +1489,7 @@ SvtJxsErrorType_t rate_control_slice_quantization_fast_no_vpred_no_sign_full(str
     uint8_t refinement = 0;
     uint32_t data_bytes = 0;
     SvtJxsErrorType_t ret = rate_control_find_best_quantization_fast_no_vpred_no_sign_full_binary_search(
-        enc_common, budget_slice_to_data_bytes, precincts, prec_num, &quantization, coding_signs_handling);
+        enc_common, budget_slice_to_data_bytes, precincts, prec_num, &quantization);
     if (ret) {
 #ifndef NDEBUG
         fprintf(stderr, "[%s[%d]] RC precinct error not found quantization\n", __FUNCTION__, __LINE__);
@@ -1384,8 +1502,7 @@ SvtJxsErrorType_t rate_control_slice_quantization_fast_no_vpred_no_sign_full(str
                                                                                      prec_num,
                                                                                      quantization,
                                                                                      &refinement,
-                                                                                     &data_bytes,
-                                                                                     coding_signs_handling);
+                                                                                     &data_bytes);
     if (ret) {
 #ifndef NDEBUG
         fprintf(stderr, "[%s[%d]] RC precinct error not found refinement\n", __FUNCTION__, __LINE__);
@@ -8,6 +8,7 @@
 #include "RateControlCacheType.h"
 #include "Pi.h"
 #include "PrecinctEnc.h"
+#include "Encoder.h"
 
 #ifdef __cplusplus
 extern "C" {
@@ -16,6 +17,7 @@ extern "C" {
 struct PictureControlSet;
 
 void rate_control_init_precinct(struct PictureControlSet *pcs_ptr, precinct_enc_t *precinct,
+                                VerticalPredictionMode coding_vertical_prediction_mode,
                                 SignHandlingStrategy coding_signs_handling);
 SvtJxsErrorType_t rate_control_precinct(struct PictureControlSet *pcs_ptr, precinct_enc_t *precinct, uint32_t budget_bytes,
                                         VerticalPredictionMode coding_vertical_prediction_mode,
@@ -25,6 +27,11 @@ SvtJxsErrorType_t rate_control_slice_quantization_fast_no_vpred_no_sign_full(str
                                                                              uint32_t budget_slice_bytes,
                                                                              SignHandlingStrategy coding_signs_handling);
 
+uint32_t precinct_get_budget_bytes(svt_jpeg_xs_encoder_common_t *enc_common, precinct_enc_t *precinct,
+                                   VerticalPredictionMode coding_vertical_prediction_mode,
+                                   SignHandlingStrategy coding_signs_handling);
+uint32_t precinct_get_budget_bytes_no_vpred(svt_jpeg_xs_encoder_common_t *enc_common, precinct_enc_t *precinct);
+
 uint32_t rate_control_calc_vpred_cost_nosigf_c(uint32_t gcli_width, uint8_t *gcli_data_top_ptr, uint8_t *gcli_data_ptr,
                                                uint8_t *vpred_bits_pack, uint8_t gtli, uint8_t gtli_max);
 void rate_control_calc_vpred_cost_sigf_nosigf_c(uint32_t significance_width, uint32_t gcli_width, uint8_t hdr_Rm,
@@ -31,6 +31,15 @@ typedef struct rc_cache_band_line {
     /*Get LUT table values without leftover from last group*/
     uint16_t significance_max_lookup_table[TRUNCATION_MAX + 1];
 #endif
+    /*Bits of line for every GTLI without vertical prediction, with band method chosen for GTLI
+     *and data bits for sign handling of encoder. Filled once per precinct only when RC reads it,
+     *budget of any quantization and refinement is then sum of this totals per packet.*/
+    struct rc_no_vpred_bits {
+        uint32_t gcli_bits;
+        uint32_t significance_bits;
+        uint32_t data_bits;
+        uint32_t signs_handling_bits;
+    } no_vpred[TRUNCATION_MAX + 1];
 #if SIGN_NOZERO_COEFF_LUT
     /*LookUpTable: Sum of indexes: svt_log2_32((coeff_16bit[i] & ~BITSTREAM_MASK_SIGN)<<1)
      * Sum of zero on index 0*/
@@ -99,6 +99,14 @@ void setup_encoder_rtcd_internal(CPU_FLAGS flags) {
     //SET_AVX2(get_sigflags_gc, get_sigflags_gc_c, get_sigflags_gc_avx2);
     SET_AVX2_AVX512(image_shift, image_shift_c, image_shift_avx2, image_shift_avx512);
     SET_AVX2_AVX512(dwt_horizontal_line, dwt_horizontal_line_c, dwt_horizontal_line_avx2, dwt_horizontal_line_avx512);
+    SET_AVX2(dwt_horizontal_line_16bit, dwt_horizontal_line_16bit_c, dwt_horizontal_line_16bit_avx2);
+    SET_AVX2(image_shift_from_16bit, image_shift_from_16bit_c, image_shift_from_16bit_avx2);
+    SET_AVX2(linear_input_scaling_line_8bit_to_16bit,
+             linear_input_scaling_line_8bit_to_16bit_c,
+             linear_input_scaling_line_8bit_to_16bit_avx2);
+    SET_AVX2(linear_input_scaling_line_16bit_to_16bit,
+             linear_input_scaling_line_16bit_to_16bit_c,
+             linear_input_scaling_line_16bit_to_16bit_avx2);
 
     SET_AVX2_AVX512(transform_V1_Hx_precinct_recalc_HF_prev,
                     transform_V1_Hx_precinct_recalc_HF_prev_c,
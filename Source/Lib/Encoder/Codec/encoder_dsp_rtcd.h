@@ -53,6 +53,13 @@ RTCD_EXTERN void (*gc_precinct_stage_scalar_loop)(uint32_t line_groups_num, uint
                                                   uint8_t* gcli_data_ptr);
 
 RTCD_EXTERN void (*dwt_horizontal_line)(int32_t* out_lf, int32_t* out_hf, const int32_t* in, uint32_t len);
+RTCD_EXTERN void (*dwt_horizontal_line_16bit)(int16_t* out_lf, int16_t* out_hf, const int16_t* in, uint32_t len);
+RTCD_EXTERN void (*image_shift_from_16bit)(uint16_t* out_coeff_16bit, const int16_t* in_coeff_16bit, uint32_t width,
+                                           int32_t shift, int32_t offset);
+RTCD_EXTERN void (*linear_input_scaling_line_8bit_to_16bit)(const uint8_t* src, int16_t* dst, uint32_t w, uint8_t shift,
+                                                            int16_t offset);
+RTCD_EXTERN void (*linear_input_scaling_line_16bit_to_16bit)(const uint16_t* src, int16_t* dst, uint32_t w, uint8_t shift,
+                                                             int16_t offset, uint8_t bit_depth);
 RTCD_EXTERN void (*transform_V1_Hx_precinct_recalc_HF_prev)(uint32_t width, int32_t* out_tmp_line_HF_next, const int32_t* line_0,
                                                             const int32_t* line_1, const int32_t* line_2);
 RTCD_EXTERN void (*transform_vertical_loop_hf_line_0)(uint32_t width, int32_t* out_hf, const int32_t* line_0,
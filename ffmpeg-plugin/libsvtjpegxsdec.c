@@ -6,6 +6,7 @@
 #include <SvtJpegxsDec.h>
 
 #include "libavutil/mem.h"
+#include "libavutil/buffer.h"
 #include "libavutil/common.h"
 #include "libavutil/cpu.h"
 #include "libavutil/imgutils.h"
@@ -16,22 +17,40 @@
 #include "decode.h"
 #include "profiles.h"
 
+/*Max number of frames decoded in library at the same time*/
+#define SVT_JPEGXS_DEC_FRAMES_MAX 16
+
+/*Frame sent to library, bitstream reference is kept until library return frame.*/
+typedef struct SvtJpegXsDecodeFrame {
+    AVFrame* frame;
+    AVBufferRef* bitstream_ref;
+    uint32_t used;
+} SvtJpegXsDecodeFrame;
+
 typedef struct SvtJpegXsDecodeContext {
     AVClass* class;
     svt_jpeg_xs_image_config_t config;
     svt_jpeg_xs_decoder_api_t decoder;
     uint32_t decoder_initialized;
 
-    /*0- AVPacket* avpkt have full frame*/
-    /*1- AVPacket* avpkt have chunk of frame, need another buffer to merge packets*/
-    uint32_t chunk_decoding;
+    /*Packet received from ffmpeg, can contain data of more than one frame*/
+    AVPacket* packet;
+    int packet_offset;
+    int eof;
+
+    /*Frame split between packets is merged in buffer from pool, frame in single packet is passed to library without copy*/
     uint32_t frame_size;
     uint32_t buffer_filled_len;
-    uint8_t* bitstream_buffer;
+    AVBufferPool* bitstream_pool;
+    AVBufferRef* bitstream_buffer;
+    int64_t bitstream_pts;
+
+    SvtJpegXsDecodeFrame frames[SVT_JPEGXS_DEC_FRAMES_MAX];
+    int frames_in_flight;
+    int frames_deep;
     int proxy_mode;
 } SvtJpegXsDecodeContext;
 
-
 static int set_pix_fmt(AVCodecContext* avctx, svt_jpeg_xs_image_config_t config) {
     if (config.format == COLOUR_FORMAT_PLANAR_YUV420) {
         if (config.bit_depth == 8) {
@@ -82,141 +101,302 @@ static int set_pix_fmt(AVCodecContext* avctx, svt_jpeg_xs_image_config_t config)
     return 0;
 }
 
-static int svt_jpegxs_dec_decode(AVCodecContext* avctx, AVFrame* picture, int* got_frame, AVPacket* avpkt) {
+static int svt_jpegxs_dec_init_decoder(AVCodecContext* avctx, const AVPacket* avpkt) {
     SvtJpegXsDecodeContext* svt_dec = avctx->priv_data;
-
-    SvtJxsErrorType_t err = SvtJxsErrorNone;
+    SvtJxsErrorType_t err;
     int ret;
-    svt_jpeg_xs_frame_t dec_input;
-    svt_jpeg_xs_frame_t dec_output;
-    uint32_t pixel_size;
 
-    if (!svt_dec->decoder_initialized) {
-        err = svt_jpeg_xs_decoder_get_single_frame_size_with_proxy(
-            avpkt->data, avpkt->size, NULL, &svt_dec->frame_size, 1 /*quick search*/, svt_dec->decoder.proxy_mode);
-        if (err) {
-            av_log(NULL, AV_LOG_ERROR, "svt_jpeg_xs_decoder_get_single_frame_size_with_proxy failed, err=%d\n", err);
-            return err;
-        }
-        if (avpkt->size < svt_dec->frame_size) {
-            svt_dec->chunk_decoding = 1;
-            svt_dec->bitstream_buffer = av_malloc(svt_dec->frame_size);
-            if (!svt_dec->bitstream_buffer) {
-                av_log(avctx, AV_LOG_ERROR, "Failed to allocate svt_dec->bitstream_buffer.\n");
-                return AVERROR(ENOMEM);
-            }
-            av_log(NULL, AV_LOG_DEBUG, "svt_jpegxs_dec_decode, bitstream_size=%d, chunk = %d\n", svt_dec->frame_size, avpkt->size);
-        }
-        if (avpkt->size > svt_dec->frame_size) {
-            av_log(avctx, AV_LOG_ERROR, "Single packet have data for more than one frame.\n");
-            return AVERROR_UNKNOWN;
-        }
+    err = svt_jpeg_xs_decoder_get_single_frame_size_with_proxy(
+        avpkt->data, avpkt->size, NULL, &svt_dec->frame_size, 1 /*quick search*/, svt_dec->decoder.proxy_mode);
+    if (err) {
+        av_log(NULL, AV_LOG_ERROR, "svt_jpeg_xs_decoder_get_single_frame_size_with_proxy failed, err=%d\n", err);
+        return err;
+    }
+    if (avpkt->size < svt_dec->frame_size) {
+        av_log(NULL, AV_LOG_DEBUG, "svt_jpegxs_dec_decode, bitstream_size=%d, chunk = %d\n", svt_dec->frame_size, avpkt->size);
+    }
 
-        err = svt_jpeg_xs_decoder_init(
-            SVT_JPEGXS_API_VER_MAJOR, SVT_JPEGXS_API_VER_MINOR, &(svt_dec->decoder), avpkt->data, avpkt->size, &(svt_dec->config));
-        if (err) {
-            av_log(NULL, AV_LOG_ERROR, "svt_jpeg_xs_decoder_init failed, err=%d\n", err);
-            return err;
-        }
+    err = svt_jpeg_xs_decoder_init(
+        SVT_JPEGXS_API_VER_MAJOR, SVT_JPEGXS_API_VER_MINOR, &(svt_dec->decoder), avpkt->data, avpkt->size, &(svt_dec->config));
+    if (err) {
+        av_log(NULL, AV_LOG_ERROR, "svt_jpeg_xs_decoder_init failed, err=%d\n", err);
+        return err;
+    }
 
-        ret = set_pix_fmt(avctx, svt_dec->config);
-        if (ret < 0) {
-            av_log(NULL, AV_LOG_ERROR, "set_pix_fmt failed, err=%d\n", ret);
-            return ret;
-        }
+    ret = set_pix_fmt(avctx, svt_dec->config);
+    if (ret < 0) {
+        av_log(NULL, AV_LOG_ERROR, "set_pix_fmt failed, err=%d\n", ret);
+        return ret;
+    }
 
-        ret = ff_set_dimensions(avctx, svt_dec->config.width, svt_dec->config.height);
-        if (ret < 0) {
-            av_log(NULL, AV_LOG_ERROR, "ff_set_dimensions failed, err=%d\n", ret);
-            return ret;
-        }
+    ret = ff_set_dimensions(avctx, svt_dec->config.width, svt_dec->config.height);
+    if (ret < 0) {
+        av_log(NULL, AV_LOG_ERROR, "ff_set_dimensions failed, err=%d\n", ret);
+        return ret;
+    }
 
-        svt_dec->decoder_initialized = 1;
+    svt_dec->bitstream_pool = av_buffer_pool_init(svt_dec->frame_size, NULL);
+    if (!svt_dec->bitstream_pool) {
+        return AVERROR(ENOMEM);
     }
 
-    if (svt_dec->chunk_decoding) {
-        uint8_t* bitstrream_addr = svt_dec->bitstream_buffer + svt_dec->buffer_filled_len;
-        int bytes_to_copy = avpkt->size;
-        //Do not copy more data than allocation
-        if ((bytes_to_copy + svt_dec->buffer_filled_len) > svt_dec->frame_size) {
-            bytes_to_copy = svt_dec->frame_size - svt_dec->buffer_filled_len;
-        }
+    svt_dec->decoder_initialized = 1;
+    return 0;
+}
 
-        memcpy(bitstrream_addr, avpkt->data, bytes_to_copy);
-        svt_dec->buffer_filled_len += avpkt->size;
-        if (svt_dec->buffer_filled_len >= svt_dec->frame_size) {
-            dec_input.bitstream.buffer = svt_dec->bitstream_buffer;
-            dec_input.bitstream.allocation_size = svt_dec->frame_size;
-            dec_input.bitstream.used_size = svt_dec->frame_size;
-        }
-        else {
-            *got_frame = 0;
-            return avpkt->size;
+/*Send one complete frame to library, take ownership of bitstream_ref.*/
+static int svt_jpegxs_dec_send(AVCodecContext* avctx, AVBufferRef* bitstream_ref, uint8_t* data, int64_t pts) {
+    SvtJpegXsDecodeContext* svt_dec = avctx->priv_data;
+    SvtJpegXsDecodeFrame* dec_frame = NULL;
+    svt_jpeg_xs_frame_t dec_input;
+    SvtJxsErrorType_t err;
+    uint32_t pixel_size;
+    int ret;
+
+    for (int i = 0; i < svt_dec->frames_deep; i++) {
+        if (!svt_dec->frames[i].used) {
+            dec_frame = &svt_dec->frames[i];
+            break;
         }
     }
-    else {// svt_dec->chunk_decoding == 0
-        dec_input.bitstream.buffer = avpkt->data;
-        dec_input.bitstream.allocation_size = avpkt->size;
-        dec_input.bitstream.used_size = avpkt->size;
-    }
-    dec_input.user_prv_ctx_ptr = avpkt;
+    av_assert0(dec_frame);
 
-    ret = ff_get_buffer(avctx, picture, 0);
+    ret = ff_get_buffer(avctx, dec_frame->frame, 0);
     if (ret < 0) {
         av_log(NULL, AV_LOG_ERROR, "ff_get_buffer failed, err=%d\n", ret);
+        av_buffer_unref(&bitstream_ref);
         return ret;
     }
+    dec_frame->frame->pts = pts;
 
+    dec_input.bitstream.buffer = data;
+    dec_input.bitstream.allocation_size = svt_dec->frame_size;
+    dec_input.bitstream.used_size = svt_dec->frame_size;
     pixel_size = svt_dec->config.bit_depth <= 8 ? 1 : 2;
     for (int comp = 0; comp < svt_dec->config.components_num; comp++) {
-        dec_input.image.data_yuv[comp] = picture->data[comp];
-        dec_input.image.stride[comp] = picture->linesize[comp]/pixel_size;
-        dec_input.image.alloc_size[comp] = picture->linesize[comp] * svt_dec->config.components[comp].height;
+        dec_input.image.data_yuv[comp] = dec_frame->frame->data[comp];
+        dec_input.image.stride[comp] = dec_frame->frame->linesize[comp] / pixel_size;
+        dec_input.image.alloc_size[comp] = dec_frame->frame->linesize[comp] * svt_dec->config.components[comp].height;
     }
+    dec_input.user_prv_ctx_ptr = dec_frame;
 
     err = svt_jpeg_xs_decoder_send_frame(&(svt_dec->decoder), &dec_input, 1 /*blocking*/);
     if (err) {
         av_log(NULL, AV_LOG_ERROR, "svt_jpeg_xs_decoder_send_frame failed, err=%d\n", err);
+        av_frame_unref(dec_frame->frame);
+        av_buffer_unref(&bitstream_ref);
         return err;
     }
 
-    err = svt_jpeg_xs_decoder_get_frame(&(svt_dec->decoder), &dec_output, 1 /*blocking*/);
+    dec_frame->bitstream_ref = bitstream_ref;
+    dec_frame->used = 1;
+    svt_dec->frames_in_flight++;
+    return 0;
+}
+
+/*Send frames from current packet while there is place in library, return 1 when whole packet is consumed.*/
+static int svt_jpegxs_dec_send_packet_data(AVCodecContext* avctx) {
+    SvtJpegXsDecodeContext* svt_dec = avctx->priv_data;
+    AVPacket* avpkt = svt_dec->packet;
+    int ret;
+
+    while (svt_dec->packet_offset < avpkt->size) {
+        uint8_t* data = avpkt->data + svt_dec->packet_offset;
+        int bytes_left = avpkt->size - svt_dec->packet_offset;
+        //Timestamp of packet belongs to frame that starts in packet
+        int64_t pts = svt_dec->packet_offset ? AV_NOPTS_VALUE : avpkt->pts;
+
+        if (svt_dec->frames_in_flight >= svt_dec->frames_deep) {
+            return 0;
+        }
+
+        if (!svt_dec->buffer_filled_len && bytes_left >= (int)svt_dec->frame_size) {
+            //Whole frame in packet, decode directly from packet data
+            AVBufferRef* bitstream_ref = av_buffer_ref(avpkt->buf);
+            if (!bitstream_ref) {
+                return AVERROR(ENOMEM);
+            }
+            svt_dec->packet_offset += svt_dec->frame_size;
+            ret = svt_jpegxs_dec_send(avctx, bitstream_ref, data, pts);
+            if (ret < 0) {
+                return ret;
+            }
+            continue;
+        }
+
+        //Frame split between packets, merge chunks
+        if (!svt_dec->bitstream_buffer) {
+            svt_dec->bitstream_buffer = av_buffer_pool_get(svt_dec->bitstream_pool);
+            if (!svt_dec->bitstream_buffer) {
+                return AVERROR(ENOMEM);
+            }
+            svt_dec->bitstream_pts = pts;
+        }
+        int bytes_to_copy = FFMIN(bytes_left, (int)(svt_dec->frame_size - svt_dec->buffer_filled_len));
+        memcpy(svt_dec->bitstream_buffer->data + svt_dec->buffer_filled_len, data, bytes_to_copy);
+        svt_dec->buffer_filled_len += bytes_to_copy;
+        svt_dec->packet_offset += bytes_to_copy;
+        if (svt_dec->buffer_filled_len == svt_dec->frame_size) {
+            AVBufferRef* bitstream_ref = svt_dec->bitstream_buffer;
+            svt_dec->bitstream_buffer = NULL;
+            svt_dec->buffer_filled_len = 0;
+            ret = svt_jpegxs_dec_send(avctx, bitstream_ref, bitstream_ref->data, svt_dec->bitstream_pts);
+            if (ret < 0) {
+                return ret;
+            }
+        }
+    }
+
+    av_packet_unref(avpkt);
+    svt_dec->packet_offset = 0;
+    return 1;
+}
+
+static int svt_jpegxs_dec_get(AVCodecContext* avctx, AVFrame* picture, uint8_t blocking) {
+    SvtJpegXsDecodeContext* svt_dec = avctx->priv_data;
+    SvtJpegXsDecodeFrame* dec_frame;
+    svt_jpeg_xs_frame_t dec_output;
+    SvtJxsErrorType_t err;
+
+    err = svt_jpeg_xs_decoder_get_frame(&(svt_dec->decoder), &dec_output, blocking);
+    if (err == SvtJxsErrorNoErrorEmptyQueue) {
+        return AVERROR(EAGAIN);
+    }
+    dec_frame = dec_output.user_prv_ctx_ptr;
+    if (dec_frame) {
+        //Library does not use bitstream any more
+        av_buffer_unref(&dec_frame->bitstream_ref);
+        dec_frame->used = 0;
+        svt_dec->frames_in_flight--;
+    }
     if (err == SvtJxsErrorDecoderConfigChange) {
         av_log(NULL, AV_LOG_ERROR, "svt_jpeg_xs_decoder_get_frame return SvtJxsErrorDecoderConfigChange\n");
+        if (dec_frame) {
+            av_frame_unref(dec_frame->frame);
+        }
         return AVERROR_INPUT_CHANGED;
     }
     if (err) {
         av_log(NULL, AV_LOG_ERROR, "svt_jpeg_xs_decoder_get_frame failed, err=%d\n", err);
+        if (dec_frame) {
+            av_frame_unref(dec_frame->frame);
+        }
         return err;
     }
-
-    if (dec_output.user_prv_ctx_ptr != avpkt) {
+    if (!dec_frame) {
         av_log(NULL, AV_LOG_ERROR, "Returned different user_prv_ctx_ptr than expected\n");
         return AVERROR_UNKNOWN;
     }
 
-    *got_frame = 1;
+    av_frame_move_ref(picture, dec_frame->frame);
+    return 0;
+}
+
+static int svt_jpegxs_dec_receive_frame(AVCodecContext* avctx, AVFrame* picture) {
+    SvtJpegXsDecodeContext* svt_dec = avctx->priv_data;
+    int ret;
+
+    for (;;) {
+        //Return decoded frame as soon as available
+        if (svt_dec->frames_in_flight) {
+            ret = svt_jpegxs_dec_get(avctx, picture, 0 /*non-blocking*/);
+            if (ret != AVERROR(EAGAIN)) {
+                return ret;
+            }
+        }
+
+        if (svt_dec->packet->size) {
+            ret = svt_jpegxs_dec_send_packet_data(avctx);
+            if (ret < 0) {
+                return ret;
+            }
+            if (ret == 0) {
+                //Library is full, wait for frame
+                return svt_jpegxs_dec_get(avctx, picture, 1 /*blocking*/);
+            }
+            continue;
+        }
+
+        if (!svt_dec->eof) {
+            ret = ff_decode_get_packet(avctx, svt_dec->packet);
+            if (ret == AVERROR_EOF) {
+                svt_dec->eof = 1;
+            }
+            else if (ret == AVERROR(EAGAIN)) {
+                //Let caller send next packets while library decode frames in flight
+                return ret;
+            }
+            else if (ret < 0) {
+                return ret;
+            }
+            else {
+                if (!svt_dec->decoder_initialized) {
+                    ret = svt_jpegxs_dec_init_decoder(avctx, svt_dec->packet);
+                    if (ret) {
+                        av_packet_unref(svt_dec->packet);
+                        return ret;
+                    }
+                }
+                ret = av_packet_make_refcounted(svt_dec->packet);
+                if (ret < 0) {
+                    return ret;
+                }
+                svt_dec->packet_offset = 0;
+                continue;
+            }
+        }
+
+        //Drain frames after end of stream
+        if (!svt_dec->frames_in_flight) {
+            return AVERROR_EOF;
+        }
+        return svt_jpegxs_dec_get(avctx, picture, 1 /*blocking*/);
+    }
+}
+
+static void svt_jpegxs_dec_drain(AVCodecContext* avctx) {
+    SvtJpegXsDecodeContext* svt_dec = avctx->priv_data;
+    svt_jpeg_xs_frame_t dec_output;
 
-    //Copy leftover from AVPacket if it contain data from two frames
-    if (svt_dec->chunk_decoding) {
-        int bytes_to_copy = svt_dec->buffer_filled_len % svt_dec->frame_size;
-        int packet_offset = avpkt->size - bytes_to_copy;
-        uint8_t* packet_addr = avpkt->data + packet_offset;
-        memcpy(svt_dec->bitstream_buffer, packet_addr, bytes_to_copy);
-        svt_dec->buffer_filled_len = bytes_to_copy;
+    //Library write to frames and read bitstreams in flight, wait for them before release
+    while (svt_dec->frames_in_flight) {
+        SvtJxsErrorType_t err = svt_jpeg_xs_decoder_get_frame(&(svt_dec->decoder), &dec_output, 1 /*blocking*/);
+        SvtJpegXsDecodeFrame* dec_frame = dec_output.user_prv_ctx_ptr;
+        if (!dec_frame) {
+            av_log(NULL, AV_LOG_ERROR, "svt_jpeg_xs_decoder_get_frame failed on drain, err=%d\n", err);
+            break;
+        }
+        av_buffer_unref(&dec_frame->bitstream_ref);
+        av_frame_unref(dec_frame->frame);
+        dec_frame->used = 0;
+        svt_dec->frames_in_flight--;
     }
+    av_packet_unref(svt_dec->packet);
+    svt_dec->packet_offset = 0;
+    av_buffer_unref(&svt_dec->bitstream_buffer);
+    svt_dec->buffer_filled_len = 0;
+}
 
-    return avpkt->size;
+static void svt_jpegxs_dec_flush(AVCodecContext* avctx) {
+    SvtJpegXsDecodeContext* svt_dec = avctx->priv_data;
+    svt_jpegxs_dec_drain(avctx);
+    svt_dec->eof = 0;
 }
 
 static av_cold int svt_jpegxs_dec_free(AVCodecContext* avctx) {
     SvtJpegXsDecodeContext* svt_dec = avctx->priv_data;
+    if (svt_dec->decoder_initialized) {
+        svt_jpegxs_dec_drain(avctx);
+    }
     svt_jpeg_xs_decoder_close(&(svt_dec->decoder));
     av_log(NULL, AV_LOG_DEBUG, "svt_jpeg_xs_decoder_close called\n");
 
-    if (svt_dec->chunk_decoding) {
-        av_free(svt_dec->bitstream_buffer);
+    for (int i = 0; i < SVT_JPEGXS_DEC_FRAMES_MAX; i++) {
+        av_frame_free(&svt_dec->frames[i].frame);
     }
+    av_packet_free(&svt_dec->packet);
+    av_buffer_unref(&svt_dec->bitstream_buffer);
+    av_buffer_pool_uninit(&svt_dec->bitstream_pool);
 
     return 0;
 }
@@ -225,9 +405,21 @@ static av_cold int svt_jpegxs_dec_init(AVCodecContext* avctx) {
     SvtJpegXsDecodeContext* svt_dec = avctx->priv_data;
 
     svt_dec->decoder_initialized = 0;
-    svt_dec->chunk_decoding = 0;
     svt_dec->buffer_filled_len = 0;
     svt_dec->bitstream_buffer = NULL;
+    svt_dec->frames_in_flight = 0;
+    svt_dec->eof = 0;
+
+    svt_dec->packet = av_packet_alloc();
+    if (!svt_dec->packet) {
+        return AVERROR(ENOMEM);
+    }
+    for (int i = 0; i < svt_dec->frames_deep; i++) {
+        svt_dec->frames[i].frame = av_frame_alloc();
+        if (!svt_dec->frames[i].frame) {
+            return AVERROR(ENOMEM);
+        }
+    }
 
     if (av_log_get_level() < AV_LOG_DEBUG) {
         svt_dec->decoder.verbose = VERBOSE_ERRORS;
@@ -262,6 +454,14 @@ static av_cold int svt_jpegxs_dec_init(AVCodecContext* avctx) {
 #define VE AV_OPT_FLAG_VIDEO_PARAM | AV_OPT_FLAG_DECODING_PARAM
 static const AVOption svtjpegxs_dec_options[] = {
     {"proxy-mode", "Resolution scaling mode: 0-full, 1-half, 2-quarter", OFFSET(proxy_mode), AV_OPT_TYPE_INT, {.i64 = 0}, 0, 2, VE},
+    {"frames-in-flight",
+     "Max number of frames decoded at the same time",
+     OFFSET(frames_deep),
+     AV_OPT_TYPE_INT,
+     {.i64 = 4},
+     1,
+     SVT_JPEGXS_DEC_FRAMES_MAX,
+     VE},
     {NULL},
 };
 
@@ -280,8 +480,9 @@ const FFCodec ff_libsvtjpegxs_decoder = {
     .priv_data_size = sizeof(SvtJpegXsDecodeContext),
     .init           = svt_jpegxs_dec_init,
     .close          = svt_jpegxs_dec_free,
-    FF_CODEC_DECODE_CB(svt_jpegxs_dec_decode),
-    .p.capabilities = AV_CODEC_CAP_OTHER_THREADS | AV_CODEC_CAP_DR1,
+    .flush          = svt_jpegxs_dec_flush,
+    FF_CODEC_RECEIVE_FRAME_CB(svt_jpegxs_dec_receive_frame),
+    .p.capabilities = AV_CODEC_CAP_OTHER_THREADS | AV_CODEC_CAP_DR1 | AV_CODEC_CAP_DELAY,
     .caps_internal  = FF_CODEC_CAP_NOT_INIT_THREADSAFE |
                       FF_CODEC_CAP_AUTO_THREADS,
     .p.wrapper_name = "libsvtjpegxs",
@@ -6,14 +6,27 @@
 #include <SvtJpegxsEnc.h>
 
 #include "libavutil/common.h"
+#include "libavutil/buffer.h"
+#include "libavutil/frame.h"
 #include "libavutil/cpu.h"
 #include "libavutil/imgutils.h"
+#include "libavutil/avassert.h"
 
 #include "avcodec.h"
 #include "codec_internal.h"
 #include "encode.h"
 #include "profiles.h"
 
+/*Max number of frames encoded in library at the same time*/
+#define SVT_JPEGXS_ENC_FRAMES_MAX 16
+
+/*Frame sent to library, input frame reference is kept until library return bitstream.*/
+typedef struct SvtJpegXsEncodeFrame {
+    AVFrame* frame;
+    AVBufferRef* bitstream_ref;
+    uint32_t used;
+} SvtJpegXsEncodeFrame;
+
 typedef struct SvtJpegXsEncodeContext {
     AVClass* class;
 
@@ -28,68 +41,172 @@ typedef struct SvtJpegXsEncodeContext {
     int coding_vpred;
 
     svt_jpeg_xs_encoder_api_t encoder;
-    int bitstream_frame_size;
+    svt_jpeg_xs_image_config_t image_config;
+    uint32_t bitstream_frame_size;
+    AVBufferPool* bitstream_pool;
+
+    SvtJpegXsEncodeFrame frames[SVT_JPEGXS_ENC_FRAMES_MAX];
+    int frames_in_flight;
+    int frames_deep;
+    int eof;
 } SvtJpegXsEncodeContext;
 
-static int svt_jpegxs_enc_encode(AVCodecContext* avctx, AVPacket* pkt, const AVFrame* frame, int* got_packet) {
+/*Send frame from ffmpeg to library, planes are referenced without copy.*/
+static int svt_jpegxs_enc_send(AVCodecContext* avctx, SvtJpegXsEncodeFrame* enc_frame) {
     SvtJpegXsEncodeContext* svt_enc = avctx->priv_data;
-
-    svt_jpeg_xs_bitstream_buffer_t out_buf;
-    svt_jpeg_xs_image_buffer_t in_buf;
+    const AVFrame* frame = enc_frame->frame;
     svt_jpeg_xs_frame_t enc_input;
-    svt_jpeg_xs_frame_t enc_output;
-
     SvtJxsErrorType_t err = SvtJxsErrorNone;
     uint32_t pixel_size = svt_enc->encoder.input_bit_depth <= 8 ? 1 : 2;
 
-    int ret = ff_alloc_packet(avctx, pkt, svt_enc->bitstream_frame_size);
-    if (ret < 0) {
-        return ret;
+    enc_frame->bitstream_ref = av_buffer_pool_get(svt_enc->bitstream_pool);
+    if (!enc_frame->bitstream_ref) {
+        av_frame_unref(enc_frame->frame);
+        return AVERROR(ENOMEM);
     }
 
-    out_buf.buffer = pkt->data;          // output bitstream ptr
-    out_buf.allocation_size = pkt->size; // output bitstream size
-    out_buf.used_size = 0;
+    enc_input.bitstream.buffer = enc_frame->bitstream_ref->data;
+    enc_input.bitstream.allocation_size = svt_enc->bitstream_frame_size;
+    enc_input.bitstream.used_size = 0;
 
+    memset(&enc_input.image, 0, sizeof(enc_input.image));
     for (int comp = 0; comp < 3; comp++) {
+        if (!frame->data[comp]) {
+            continue;
+        }
         // svt-jpegxs require stride in pixel's not in bytes, this means that for 10 bit-depth, stride is half the linesize
-        in_buf.stride[comp] = frame->linesize[comp] / pixel_size;
-        in_buf.data_yuv[comp] = frame->data[comp];
-        in_buf.alloc_size[comp] = in_buf.stride[comp] * svt_enc->encoder.source_height * pixel_size;
+        enc_input.image.stride[comp] = frame->linesize[comp] / pixel_size;
+        enc_input.image.data_yuv[comp] = frame->data[comp];
+        enc_input.image.alloc_size[comp] = frame->linesize[comp] * svt_enc->image_config.components[comp].height;
     }
-
-    enc_input.bitstream = out_buf;
-    enc_input.image = in_buf;
-    enc_input.user_prv_ctx_ptr = pkt;
+    enc_input.user_prv_ctx_ptr = enc_frame;
 
     err = svt_jpeg_xs_encoder_send_picture(&(svt_enc->encoder), &enc_input, 1 /*blocking*/);
     if (err != SvtJxsErrorNone) {
         av_log(NULL, AV_LOG_ERROR, "svt_jpeg_xs_encoder_send_picture failed\n");
+        av_buffer_unref(&enc_frame->bitstream_ref);
+        av_frame_unref(enc_frame->frame);
         return AVERROR_UNKNOWN;
     }
 
-    err = svt_jpeg_xs_encoder_get_packet(&(svt_enc->encoder), &enc_output, 1 /*blocking*/);
-    if (err != SvtJxsErrorNone) {
-        av_log(NULL, AV_LOG_ERROR, "svt_jpeg_xs_encoder_get_packet failed\n");
-        return AVERROR_UNKNOWN;
-    }
+    enc_frame->used = 1;
+    svt_enc->frames_in_flight++;
+    return 0;
+}
 
-    if (enc_output.user_prv_ctx_ptr != pkt) {
-        av_log(NULL, AV_LOG_ERROR, "Returned different user_prv_ctx_ptr than expected\n");
+static int svt_jpegxs_enc_get(AVCodecContext* avctx, AVPacket* pkt, uint8_t blocking) {
+    SvtJpegXsEncodeContext* svt_enc = avctx->priv_data;
+    SvtJpegXsEncodeFrame* enc_frame;
+    svt_jpeg_xs_frame_t enc_output;
+    SvtJxsErrorType_t err = SvtJxsErrorNone;
+
+    err = svt_jpeg_xs_encoder_get_packet(&(svt_enc->encoder), &enc_output, blocking);
+    if (err == SvtJxsErrorNoErrorEmptyQueue) {
+        return AVERROR(EAGAIN);
+    }
+    enc_frame = enc_output.user_prv_ctx_ptr;
+    if (err != SvtJxsErrorNone || !enc_frame) {
+        av_log(NULL, AV_LOG_ERROR, "svt_jpeg_xs_encoder_get_packet failed\n");
+        if (enc_frame) {
+            av_buffer_unref(&enc_frame->bitstream_ref);
+            av_frame_unref(enc_frame->frame);
+            enc_frame->used = 0;
+            svt_enc->frames_in_flight--;
+        }
         return AVERROR_UNKNOWN;
     }
 
+    //Packet take ownership of bitstream buffer
+    pkt->buf = enc_frame->bitstream_ref;
+    pkt->data = enc_frame->bitstream_ref->data;
     pkt->size = enc_output.bitstream.used_size;
-
-    *got_packet = 1;
+    memset(pkt->data + pkt->size, 0, AV_INPUT_BUFFER_PADDING_SIZE);
+    pkt->pts = enc_frame->frame->pts;
+    pkt->dts = enc_frame->frame->pts;
+    pkt->duration = enc_frame->frame->duration;
+    pkt->flags |= AV_PKT_FLAG_KEY;
+    enc_frame->bitstream_ref = NULL;
+
+    //Library does not use input frame any more
+    av_frame_unref(enc_frame->frame);
+    enc_frame->used = 0;
+    svt_enc->frames_in_flight--;
     return 0;
 }
 
+static int svt_jpegxs_enc_receive_packet(AVCodecContext* avctx, AVPacket* pkt) {
+    SvtJpegXsEncodeContext* svt_enc = avctx->priv_data;
+    int ret;
+
+    for (;;) {
+        //Return encoded packet as soon as available
+        if (svt_enc->frames_in_flight) {
+            ret = svt_jpegxs_enc_get(avctx, pkt, 0 /*non-blocking*/);
+            if (ret != AVERROR(EAGAIN)) {
+                return ret;
+            }
+        }
+
+        if (!svt_enc->eof && svt_enc->frames_in_flight < svt_enc->frames_deep) {
+            SvtJpegXsEncodeFrame* enc_frame = NULL;
+            for (int i = 0; i < svt_enc->frames_deep; i++) {
+                if (!svt_enc->frames[i].used) {
+                    enc_frame = &svt_enc->frames[i];
+                    break;
+                }
+            }
+            av_assert0(enc_frame);
+
+            ret = ff_encode_get_frame(avctx, enc_frame->frame);
+            if (ret == AVERROR_EOF) {
+                svt_enc->eof = 1;
+            }
+            else if (ret < 0) {
+                //AVERROR(EAGAIN): let caller send next frames while library encode frames in flight
+                return ret;
+            }
+            else {
+                ret = svt_jpegxs_enc_send(avctx, enc_frame);
+                if (ret < 0) {
+                    return ret;
+                }
+                continue;
+            }
+        }
+
+        if (!svt_enc->frames_in_flight) {
+            return svt_enc->eof ? AVERROR_EOF : AVERROR(EAGAIN);
+        }
+        //Library is full or end of stream, wait for packet
+        return svt_jpegxs_enc_get(avctx, pkt, 1 /*blocking*/);
+    }
+}
+
 static av_cold int svt_jpegxs_enc_free(AVCodecContext* avctx) {
     SvtJpegXsEncodeContext* svt_enc = avctx->priv_data;
+    svt_jpeg_xs_frame_t enc_output;
+
+    //Library read frames and write bitstreams in flight, wait for them before release
+    while (svt_enc->frames_in_flight) {
+        svt_jpeg_xs_encoder_get_packet(&(svt_enc->encoder), &enc_output, 1 /*blocking*/);
+        SvtJpegXsEncodeFrame* enc_frame = enc_output.user_prv_ctx_ptr;
+        if (!enc_frame) {
+            break;
+        }
+        av_buffer_unref(&enc_frame->bitstream_ref);
+        av_frame_unref(enc_frame->frame);
+        enc_frame->used = 0;
+        svt_enc->frames_in_flight--;
+    }
+
     svt_jpeg_xs_encoder_close(&(svt_enc->encoder));
     av_log(NULL, AV_LOG_DEBUG, "svt_jpeg_xs_encoder_close called\n");
 
+    for (int i = 0; i < SVT_JPEGXS_ENC_FRAMES_MAX; i++) {
+        av_frame_free(&svt_enc->frames[i].frame);
+    }
+    av_buffer_pool_uninit(&svt_enc->bitstream_pool);
+
     return 0;
 }
 
@@ -240,6 +357,16 @@ static av_cold int svt_jpegxs_enc_init(AVCodecContext* avctx) {
         svt_enc->encoder.slice_height = svt_enc->slice_height;
     }
 
+    err = svt_jpeg_xs_encoder_get_image_config(SVT_JPEGXS_API_VER_MAJOR,
+                                               SVT_JPEGXS_API_VER_MINOR,
+                                               &(svt_enc->encoder),
+                                               &(svt_enc->image_config),
+                                               &(svt_enc->bitstream_frame_size));
+    if (err != SvtJxsErrorNone) {
+        av_log(NULL, AV_LOG_ERROR, "svt_jpeg_xs_encoder_get_image_config failed\n");
+        return AVERROR_UNKNOWN;
+    }
+
     err = svt_jpeg_xs_encoder_init(SVT_JPEGXS_API_VER_MAJOR, SVT_JPEGXS_API_VER_MINOR, &(svt_enc->encoder));
     if (err != SvtJxsErrorNone) {
         av_log(NULL, AV_LOG_ERROR, "svt_jpeg_xs_encoder_init failed\n");
@@ -247,8 +374,17 @@ static av_cold int svt_jpegxs_enc_init(AVCodecContext* avctx) {
     }
     av_log(NULL, AV_LOG_DEBUG, "svt_jpeg_xs_encoder_init ok\n");
 
-    svt_enc->bitstream_frame_size =
-        ((avctx->width * avctx->height * svt_enc->encoder.bpp_numerator / svt_enc->encoder.bpp_denominator + 7) / 8);
+    //Packets are returned in pool buffers, ffmpeg require zeroed padding after packet data
+    svt_enc->bitstream_pool = av_buffer_pool_init(svt_enc->bitstream_frame_size + AV_INPUT_BUFFER_PADDING_SIZE, NULL);
+    if (!svt_enc->bitstream_pool) {
+        return AVERROR(ENOMEM);
+    }
+    for (int i = 0; i < svt_enc->frames_deep; i++) {
+        svt_enc->frames[i].frame = av_frame_alloc();
+        if (!svt_enc->frames[i].frame) {
+            return AVERROR(ENOMEM);
+        }
+    }
 
     return 0;
 }
@@ -295,6 +431,14 @@ static const AVOption svtjpegxs_enc_options[] = {
     {"disable", NULL, 0, AV_OPT_TYPE_CONST, {.i64 = 0}, INT_MIN, INT_MAX, VE, .unit = "coding-vpred"},
     {"no_residuals", NULL, 0, AV_OPT_TYPE_CONST, {.i64 = 1}, INT_MIN, INT_MAX, VE, .unit = "coding-vpred"},
     {"no_coeffs", NULL, 0, AV_OPT_TYPE_CONST, {.i64 = 2}, INT_MIN, INT_MAX, VE, .unit = "coding-vpred"},
+    {"frames-in-flight",
+     "Max number of frames encoded at the same time",
+     OFFSET(frames_deep),
+     AV_OPT_TYPE_INT,
+     {.i64 = 4},
+     1,
+     SVT_JPEGXS_ENC_FRAMES_MAX,
+     VE},
     {NULL},
 };
 
@@ -313,8 +457,8 @@ const FFCodec ff_libsvtjpegxs_encoder = {
     .priv_data_size = sizeof(SvtJpegXsEncodeContext),
     .init = svt_jpegxs_enc_init,
     .close = svt_jpegxs_enc_free,
-    FF_CODEC_ENCODE_CB(svt_jpegxs_enc_encode),
-    .p.capabilities = AV_CODEC_CAP_OTHER_THREADS | AV_CODEC_CAP_DR1,
+    FF_CODEC_RECEIVE_PACKET_CB(svt_jpegxs_enc_receive_packet),
+    .p.capabilities = AV_CODEC_CAP_OTHER_THREADS | AV_CODEC_CAP_DELAY,
     .caps_internal = FF_CODEC_CAP_NOT_INIT_THREADSAFE | FF_CODEC_CAP_AUTO_THREADS,
     .p.pix_fmts = (const enum AVPixelFormat[]){AV_PIX_FMT_YUV420P,
                                                AV_PIX_FMT_YUV422P,
@@ -0,0 +1,53 @@
+/*
+* Copyright(c) 2024 Intel Corporation
+* SPDX - License - Identifier: BSD - 2 - Clause - Patent
+*/
+
+#ifndef _SVT_JPEGXS_BENCH_H_
+#define _SVT_JPEGXS_BENCH_H_
+#include <stdint.h>
+#include "SvtJpegxs.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/*Kernel microbenchmark: every RTCD entry measured on every ISA level available on machine.*/
+typedef struct BenchKernelConfig {
+    uint32_t width;     /*Line width in pixels passed to kernels*/
+    uint32_t time_ms;   /*Minimum measure time per kernel and ISA level*/
+    const char* filter; /*Run only kernels with name containing filter, NULL - all*/
+} BenchKernelConfig_t;
+
+/*End-to-end in-memory encode and decode of synthetic frames.*/
+typedef struct BenchPipelineConfig {
+    uint32_t width;
+    uint32_t height;
+    uint8_t bit_depth;
+    ColourFormat_t format;
+    uint32_t bpp_numerator;
+    uint32_t bpp_denominator;
+    uint32_t slice_height;
+    uint8_t cpu_profile;
+    uint32_t threads_num;
+    CPU_FLAGS use_cpu_flags;
+    uint32_t frames_num;  /*Measured frames*/
+    uint32_t warmup_num;  /*Frames processed before measure*/
+    uint32_t frames_deep; /*Max frames in flight in library*/
+    uint8_t skip_decode;
+} BenchPipelineConfig_t;
+
+int32_t bench_kernels_run(const BenchKernelConfig_t* config);
+int32_t bench_pipeline_run(const BenchPipelineConfig_t* config);
+
+/*Deterministic generator for synthetic data, same content on every run.*/
+static inline uint32_t bench_rand(uint32_t* state) {
+    *state = *state * 1103515245u + 12345u;
+    return *state >> 8;
+}
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /*_SVT_JPEGXS_BENCH_H_*/
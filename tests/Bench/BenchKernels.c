@@ -0,0 +1,554 @@
+/*
+* Copyright(c) 2024 Intel Corporation
+* SPDX - License - Identifier: BSD - 2 - Clause - Patent
+*/
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include "Bench.h"
+#include "SvtUtility.h"
+#include "EncDec.h"
+#include "Pi.h"
+#include "encoder_dsp_rtcd.h"
+#include "decoder_dsp_rtcd.h"
+
+/*Extra elements after every buffer, SIMD kernels may read whole vector behind line end.*/
+#define BENCH_BUFFER_PADDING 256
+#define BENCH_LINES_NUM      7
+#define BENCH_BW             20
+#define BENCH_GTLI           2
+
+typedef struct BenchKernelCtx {
+    uint32_t width;
+    int32_t* lines[BENCH_LINES_NUM]; /*Input lines of 32bit coefficients*/
+    int32_t* out_lf;
+    int32_t* out_hf;
+    int32_t* out_idwt[4];
+    int16_t* in_lf16;
+    int16_t* in_hf16;
+    uint16_t* coeff16;
+    uint16_t* coeff16_src; /*Copy of coeff16 to restore data modified in place*/
+    uint8_t* gcli;
+    uint8_t* gcli_top;
+    uint8_t* gcli_pack; /*gcli greater than BENCH_GTLI for pack_data_single_group*/
+    uint8_t* vpred_bits;
+    uint8_t* vpred_sig;
+    uint8_t* sig_max;
+    uint8_t* pixels8;   /*3 * width for packed RGB*/
+    uint16_t* pixels16; /*3 * width for packed RGB*/
+    uint8_t* out8[3];
+    uint16_t* out16[3];
+    uint8_t* bitstream;
+    uint32_t bitstream_size;
+    pi_t* pi;
+    svt_jpeg_xs_image_buffer_t image8;
+    svt_jpeg_xs_image_buffer_t image16;
+    volatile uint32_t sink; /*Keep results of kernels that only return value*/
+} BenchKernelCtx_t;
+
+typedef struct BenchKernel {
+    const char* name;
+    uintptr_t (*get_ptr)(void); /*Current RTCD pointer, to detect ISA levels without own implementation*/
+    void (*run)(BenchKernelCtx_t* ctx);
+} BenchKernel_t;
+
+typedef struct BenchIsaLevel {
+    const char* name;
+    CPU_FLAGS flags;
+} BenchIsaLevel_t;
+
+static const BenchIsaLevel_t isa_levels[] = {
+    {"c", CPU_FLAGS_C},
+    {"sse2", (CPU_FLAGS_SSE2 << 1) - 1},
+    {"sse4_1", (CPU_FLAGS_SSE4_1 << 1) - 1},
+    {"avx2", (CPU_FLAGS_AVX2 << 1) - 1},
+    {"avx512", CPU_FLAGS_ALL},
+};
+#define ISA_LEVELS_NUM (sizeof(isa_levels) / sizeof(isa_levels[0]))
+
+#define BENCH_KERNEL_PTR(fn) \
+    static uintptr_t get_ptr_##fn(void) { return (uintptr_t)fn; }
+
+static void kernel_image_shift(BenchKernelCtx_t* ctx) {
+    image_shift(ctx->coeff16, ctx->lines[0], ctx->width, 4, 8);
+}
+
+static void kernel_image_shift_from_16bit(BenchKernelCtx_t* ctx) {
+    image_shift_from_16bit(ctx->coeff16, ctx->in_lf16, ctx->width, 4, 8);
+}
+
+static void kernel_gc_precinct_stage_scalar(BenchKernelCtx_t* ctx) {
+    gc_precinct_stage_scalar(ctx->gcli, ctx->coeff16_src, GROUP_SIZE, ctx->width);
+}
+
+static void kernel_gc_precinct_stage_scalar_loop(BenchKernelCtx_t* ctx) {
+    gc_precinct_stage_scalar_loop(ctx->width / GROUP_SIZE, ctx->coeff16_src, ctx->gcli);
+}
+
+static void kernel_quantization(BenchKernelCtx_t* ctx) {
+    memcpy(ctx->coeff16, ctx->coeff16_src, ctx->width * sizeof(uint16_t));
+    quantization(ctx->coeff16, ctx->width, ctx->gcli, GROUP_SIZE, BENCH_GTLI, QUANT_TYPE_DEADZONE);
+}
+
+static void kernel_linear_input_scaling_line_8bit(BenchKernelCtx_t* ctx) {
+    linear_input_scaling_line_8bit(ctx->pixels8, ctx->out_lf, ctx->width, BENCH_BW - 8, 1 << (BENCH_BW - 1));
+}
+
+static void kernel_linear_input_scaling_line_16bit(BenchKernelCtx_t* ctx) {
+    linear_input_scaling_line_16bit(ctx->pixels16, ctx->out_lf, ctx->width, BENCH_BW - 10, 1 << (BENCH_BW - 1), 10);
+}
+
+static void kernel_linear_input_scaling_line_8bit_to_16bit(BenchKernelCtx_t* ctx) {
+    linear_input_scaling_line_8bit_to_16bit(ctx->pixels8, (int16_t*)ctx->out_lf, ctx->width, 14 - 8, 1 << (14 - 1));
+}
+
+static void kernel_linear_input_scaling_line_16bit_to_16bit(BenchKernelCtx_t* ctx) {
+    linear_input_scaling_line_16bit_to_16bit(ctx->pixels16, (int16_t*)ctx->out_lf, ctx->width, 14 - 10, 1 << (14 - 1), 10);
+}
+
+static void kernel_pack_data_single_group(BenchKernelCtx_t* ctx) {
+    bitstream_writer_t writer;
+    bitstream_writer_init(&writer, ctx->bitstream, ctx->bitstream_size);
+    const uint32_t groups_num = ctx->width / GROUP_SIZE;
+    for (uint32_t g = 0; g < groups_num; ++g) {
+        pack_data_single_group(&writer, ctx->coeff16_src + g * GROUP_SIZE, ctx->gcli_pack[g], BENCH_GTLI);
+    }
+}
+
+static void kernel_dwt_horizontal_line(BenchKernelCtx_t* ctx) {
+    dwt_horizontal_line(ctx->out_lf, ctx->out_hf, ctx->lines[0], ctx->width);
+}
+
+static void kernel_dwt_horizontal_line_16bit(BenchKernelCtx_t* ctx) {
+    dwt_horizontal_line_16bit((int16_t*)ctx->out_lf, (int16_t*)ctx->out_hf, ctx->in_lf16, ctx->width);
+}
+
+static void kernel_transform_V1_Hx_precinct_recalc_HF_prev(BenchKernelCtx_t* ctx) {
+    transform_V1_Hx_precinct_recalc_HF_prev(ctx->width, ctx->out_hf, ctx->lines[0], ctx->lines[1], ctx->lines[2]);
+}
+
+static void kernel_transform_vertical_loop_hf_line_0(BenchKernelCtx_t* ctx) {
+    transform_vertical_loop_hf_line_0(ctx->width, ctx->out_hf, ctx->lines[0], ctx->lines[1]);
+}
+
+static void kernel_transform_vertical_loop_lf_line_0(BenchKernelCtx_t* ctx) {
+    transform_vertical_loop_lf_line_0(ctx->width, ctx->out_lf, ctx->lines[1], ctx->lines[0]);
+}
+
+static void kernel_transform_vertical_loop_lf_hf_line_0(BenchKernelCtx_t* ctx) {
+    transform_vertical_loop_lf_hf_line_0(ctx->width, ctx->out_lf, ctx->out_hf, ctx->lines[0], ctx->lines[1], ctx->lines[2]);
+}
+
+static void kernel_transform_vertical_loop_lf_hf_line_x_prev(BenchKernelCtx_t* ctx) {
+    transform_vertical_loop_lf_hf_line_x_prev(
+        ctx->width, ctx->out_lf, ctx->out_hf, ctx->lines[0], ctx->lines[1], ctx->lines[2], ctx->lines[3], ctx->lines[4]);
+}
+
+static void kernel_transform_vertical_loop_lf_hf_hf_line_x(BenchKernelCtx_t* ctx) {
+    transform_vertical_loop_lf_hf_hf_line_x(
+        ctx->width, ctx->out_lf, ctx->out_hf, ctx->lines[3], ctx->lines[0], ctx->lines[1], ctx->lines[2]);
+}
+
+static void kernel_transform_vertical_loop_lf_hf_hf_line_last_even(BenchKernelCtx_t* ctx) {
+    transform_vertical_loop_lf_hf_hf_line_last_even(ctx->width, ctx->out_lf, ctx->out_hf, ctx->lines[3], ctx->lines[0], ctx->lines[1]);
+}
+
+static void kernel_gc_precinct_sigflags_max(BenchKernelCtx_t* ctx) {
+    gc_precinct_sigflags_max(ctx->sig_max, ctx->gcli, SIGNIFICANCE_GROUP_SIZE, ctx->width / GROUP_SIZE);
+}
+
+static void kernel_rate_control_calc_vpred_cost_nosigf(BenchKernelCtx_t* ctx) {
+    ctx->sink += rate_control_calc_vpred_cost_nosigf(
+        ctx->width / GROUP_SIZE, ctx->gcli_top, ctx->gcli, ctx->vpred_bits, BENCH_GTLI, BENCH_GTLI + 1);
+}
+
+static void kernel_rate_control_calc_vpred_cost_sigf_nosigf(BenchKernelCtx_t* ctx) {
+    const uint32_t gcli_width = ctx->width / GROUP_SIZE;
+    uint32_t sigf_reduction = 0;
+    uint32_t no_sigf = 0;
+    rate_control_calc_vpred_cost_sigf_nosigf((gcli_width + SIGNIFICANCE_GROUP_SIZE - 1) / SIGNIFICANCE_GROUP_SIZE,
+                                             gcli_width,
+                                             0,
+                                             SIGNIFICANCE_GROUP_SIZE,
+                                             ctx->gcli_top,
+                                             ctx->gcli,
+                                             ctx->vpred_bits,
+                                             ctx->vpred_sig,
+                                             BENCH_GTLI,
+                                             BENCH_GTLI + 1,
+                                             &sigf_reduction,
+                                             &no_sigf);
+    ctx->sink += sigf_reduction + no_sigf;
+}
+
+static void kernel_convert_packed_to_planar_rgb_8bit(BenchKernelCtx_t* ctx) {
+    convert_packed_to_planar_rgb_8bit(ctx->pixels8, ctx->out8[0], ctx->out8[1], ctx->out8[2], ctx->width);
+}
+
+static void kernel_convert_packed_to_planar_rgb_16bit(BenchKernelCtx_t* ctx) {
+    convert_packed_to_planar_rgb_16bit(ctx->pixels16, ctx->out16[0], ctx->out16[1], ctx->out16[2], ctx->width);
+}
+
+static void kernel_dequant(BenchKernelCtx_t* ctx) {
+    memcpy(ctx->coeff16, ctx->coeff16_src, ctx->width * sizeof(uint16_t));
+    dequant(ctx->coeff16, ctx->width, ctx->gcli, GROUP_SIZE, BENCH_GTLI, QUANT_TYPE_DEADZONE);
+}
+
+static void kernel_linear_output_scaling_8bit(BenchKernelCtx_t* ctx) {
+    int32_t* comps[MAX_COMPONENTS_NUM] = {ctx->lines[0]};
+    linear_output_scaling_8bit(ctx->pi, comps, BENCH_BW, 8, &ctx->image8);
+}
+
+static void kernel_linear_output_scaling_16bit(BenchKernelCtx_t* ctx) {
+    int32_t* comps[MAX_COMPONENTS_NUM] = {ctx->lines[0]};
+    linear_output_scaling_16bit(ctx->pi, comps, BENCH_BW, 10, &ctx->image16);
+}
+
+static void kernel_inv_sign(BenchKernelCtx_t* ctx) {
+    memcpy(ctx->coeff16, ctx->coeff16_src, ctx->width * sizeof(uint16_t));
+    inv_sign(ctx->coeff16, ctx->width);
+}
+
+static void kernel_unpack_data(BenchKernelCtx_t* ctx) {
+    bitstream_reader_t reader;
+    bitstream_reader_init(&reader, ctx->bitstream, ctx->bitstream_size);
+    uint8_t leftover_signs_num = 0;
+    int32_t precinct_bits_left = ctx->bitstream_size * 8;
+    unpack_data(
+        &reader, ctx->coeff16, ctx->width, ctx->gcli, GROUP_SIZE, BENCH_GTLI, 0, &leftover_signs_num, &precinct_bits_left);
+}
+
+static void kernel_linear_output_scaling_8bit_line(BenchKernelCtx_t* ctx) {
+    linear_output_scaling_8bit_line(ctx->lines[0], BENCH_BW, 8, ctx->out8[0], ctx->width);
+}
+
+static void kernel_linear_output_scaling_16bit_line(BenchKernelCtx_t* ctx) {
+    linear_output_scaling_16bit_line(ctx->lines[0], BENCH_BW, 10, ctx->out16[0], ctx->width);
+}
+
+static void kernel_idwt_horizontal_line_lf16_hf16(BenchKernelCtx_t* ctx) {
+    idwt_horizontal_line_lf16_hf16(ctx->in_lf16, ctx->in_hf16, ctx->out_lf, ctx->width, 4);
+}
+
+static void kernel_idwt_horizontal_line_lf32_hf16(BenchKernelCtx_t* ctx) {
+    idwt_horizontal_line_lf32_hf16(ctx->lines[0], ctx->in_hf16, ctx->out_lf, ctx->width, 4);
+}
+
+static void kernel_idwt_vertical_line(BenchKernelCtx_t* ctx) {
+    idwt_vertical_line(ctx->lines[0], ctx->lines[1], ctx->lines[2], ctx->out_idwt, ctx->width, 0, 0, 1080);
+}
+
+static void kernel_idwt_vertical_line_recalc(BenchKernelCtx_t* ctx) {
+    idwt_vertical_line_recalc(ctx->lines[0], ctx->lines[1], ctx->lines[2], ctx->out_idwt, ctx->width, 2);
+}
+
+static void kernel_svt_log2_32(BenchKernelCtx_t* ctx) {
+    uint32_t sum = 0;
+    for (uint32_t i = 0; i < ctx->width; ++i) {
+        sum += svt_log2_32((uint32_t)ctx->lines[0][i] | 1);
+    }
+    ctx->sink += sum;
+}
+
+BENCH_KERNEL_PTR(image_shift)
+BENCH_KERNEL_PTR(image_shift_from_16bit)
+BENCH_KERNEL_PTR(gc_precinct_stage_scalar)
+BENCH_KERNEL_PTR(gc_precinct_stage_scalar_loop)
+BENCH_KERNEL_PTR(quantization)
+BENCH_KERNEL_PTR(linear_input_scaling_line_8bit)
+BENCH_KERNEL_PTR(linear_input_scaling_line_16bit)
+BENCH_KERNEL_PTR(linear_input_scaling_line_8bit_to_16bit)
+BENCH_KERNEL_PTR(linear_input_scaling_line_16bit_to_16bit)
+BENCH_KERNEL_PTR(pack_data_single_group)
+BENCH_KERNEL_PTR(dwt_horizontal_line)
+BENCH_KERNEL_PTR(dwt_horizontal_line_16bit)
+BENCH_KERNEL_PTR(transform_V1_Hx_precinct_recalc_HF_prev)
+BENCH_KERNEL_PTR(transform_vertical_loop_hf_line_0)
+BENCH_KERNEL_PTR(transform_vertical_loop_lf_line_0)
+BENCH_KERNEL_PTR(transform_vertical_loop_lf_hf_line_0)
+BENCH_KERNEL_PTR(transform_vertical_loop_lf_hf_line_x_prev)
+BENCH_KERNEL_PTR(transform_vertical_loop_lf_hf_hf_line_x)
+BENCH_KERNEL_PTR(transform_vertical_loop_lf_hf_hf_line_last_even)
+BENCH_KERNEL_PTR(gc_precinct_sigflags_max)
+BENCH_KERNEL_PTR(rate_control_calc_vpred_cost_nosigf)
+BENCH_KERNEL_PTR(rate_control_calc_vpred_cost_sigf_nosigf)
+BENCH_KERNEL_PTR(convert_packed_to_planar_rgb_8bit)
+BENCH_KERNEL_PTR(convert_packed_to_planar_rgb_16bit)
+BENCH_KERNEL_PTR(dequant)
+BENCH_KERNEL_PTR(linear_output_scaling_8bit)
+BENCH_KERNEL_PTR(linear_output_scaling_16bit)
+BENCH_KERNEL_PTR(inv_sign)
+BENCH_KERNEL_PTR(unpack_data)
+BENCH_KERNEL_PTR(linear_output_scaling_8bit_line)
+BENCH_KERNEL_PTR(linear_output_scaling_16bit_line)
+BENCH_KERNEL_PTR(idwt_horizontal_line_lf16_hf16)
+BENCH_KERNEL_PTR(idwt_horizontal_line_lf32_hf16)
+BENCH_KERNEL_PTR(idwt_vertical_line)
+BENCH_KERNEL_PTR(idwt_vertical_line_recalc)
+BENCH_KERNEL_PTR(svt_log2_32)
+
+#define BENCH_KERNEL(fn) {#fn, get_ptr_##fn, kernel_##fn}
+
+static const BenchKernel_t kernels[] = {
+    /*Common*/
+    BENCH_KERNEL(svt_log2_32),
+    /*Encoder*/
+    BENCH_KERNEL(linear_input_scaling_line_8bit),
+    BENCH_KERNEL(linear_input_scaling_line_16bit),
+    BENCH_KERNEL(linear_input_scaling_line_8bit_to_16bit),
+    BENCH_KERNEL(linear_input_scaling_line_16bit_to_16bit),
+    BENCH_KERNEL(convert_packed_to_planar_rgb_8bit),
+    BENCH_KERNEL(convert_packed_to_planar_rgb_16bit),
+    BENCH_KERNEL(dwt_horizontal_line),
+    BENCH_KERNEL(dwt_horizontal_line_16bit),
+    BENCH_KERNEL(transform_V1_Hx_precinct_recalc_HF_prev),
+    BENCH_KERNEL(transform_vertical_loop_hf_line_0),
+    BENCH_KERNEL(transform_vertical_loop_lf_line_0),
+    BENCH_KERNEL(transform_vertical_loop_lf_hf_line_0),
+    BENCH_KERNEL(transform_vertical_loop_lf_hf_line_x_prev),
+    BENCH_KERNEL(transform_vertical_loop_lf_hf_hf_line_x),
+    BENCH_KERNEL(transform_vertical_loop_lf_hf_hf_line_last_even),
+    BENCH_KERNEL(image_shift),
+    BENCH_KERNEL(image_shift_from_16bit),
+    BENCH_KERNEL(gc_precinct_stage_scalar),
+    BENCH_KERNEL(gc_precinct_stage_scalar_loop),
+    BENCH_KERNEL(gc_precinct_sigflags_max),
+    BENCH_KERNEL(rate_control_calc_vpred_cost_nosigf),
+    BENCH_KERNEL(rate_control_calc_vpred_cost_sigf_nosigf),
+    BENCH_KERNEL(quantization),
+    BENCH_KERNEL(pack_data_single_group),
+    /*Decoder*/
+    BENCH_KERNEL(unpack_data),
+    BENCH_KERNEL(inv_sign),
+    BENCH_KERNEL(dequant),
+    BENCH_KERNEL(idwt_horizontal_line_lf16_hf16),
+    BENCH_KERNEL(idwt_horizontal_line_lf32_hf16),
+    BENCH_KERNEL(idwt_vertical_line),
+    BENCH_KERNEL(idwt_vertical_line_recalc),
+    BENCH_KERNEL(linear_output_scaling_8bit_line),
+    BENCH_KERNEL(linear_output_scaling_16bit_line),
+    BENCH_KERNEL(linear_output_scaling_8bit),
+    BENCH_KERNEL(linear_output_scaling_16bit),
+};
+#define KERNELS_NUM (sizeof(kernels) / sizeof(kernels[0]))
+
+static void* bench_calloc(size_t count, size_t size) {
+    return calloc(count + BENCH_BUFFER_PADDING, size);
+}
+
+static void bench_kernel_ctx_free(BenchKernelCtx_t* ctx) {
+    for (uint32_t i = 0; i < BENCH_LINES_NUM; ++i) {
+        free(ctx->lines[i]);
+    }
+    for (uint32_t i = 0; i < 4; ++i) {
+        free(ctx->out_idwt[i]);
+    }
+    for (uint32_t i = 0; i < 3; ++i) {
+        free(ctx->out8[i]);
+        free(ctx->out16[i]);
+    }
+    free(ctx->out_lf);
+    free(ctx->out_hf);
+    free(ctx->in_lf16);
+    free(ctx->in_hf16);
+    free(ctx->coeff16);
+    free(ctx->coeff16_src);
+    free(ctx->gcli);
+    free(ctx->gcli_top);
+    free(ctx->gcli_pack);
+    free(ctx->vpred_bits);
+    free(ctx->vpred_sig);
+    free(ctx->sig_max);
+    free(ctx->pixels8);
+    free(ctx->pixels16);
+    free(ctx->bitstream);
+    free(ctx->pi);
+}
+
+static int32_t bench_kernel_ctx_init(BenchKernelCtx_t* ctx, uint32_t width) {
+    memset(ctx, 0, sizeof(*ctx));
+    ctx->width = width;
+    ctx->bitstream_size = width * 4;
+    int32_t ok = 1;
+    for (uint32_t i = 0; i < BENCH_LINES_NUM; ++i) {
+        ok &= (ctx->lines[i] = bench_calloc(width, sizeof(int32_t))) != NULL;
+    }
+    for (uint32_t i = 0; i < 4; ++i) {
+        ok &= (ctx->out_idwt[i] = bench_calloc(width, sizeof(int32_t))) != NULL;
+    }
+    for (uint32_t i = 0; i < 3; ++i) {
+        ok &= (ctx->out8[i] = bench_calloc(width, sizeof(uint8_t))) != NULL;
+        ok &= (ctx->out16[i] = bench_calloc(width, sizeof(uint16_t))) != NULL;
+    }
+    ok &= (ctx->out_lf = bench_calloc(width, sizeof(int32_t))) != NULL;
+    ok &= (ctx->out_hf = bench_calloc(width, sizeof(int32_t))) != NULL;
+    ok &= (ctx->in_lf16 = bench_calloc(width, sizeof(int16_t))) != NULL;
+    ok &= (ctx->in_hf16 = bench_calloc(width, sizeof(int16_t))) != NULL;
+    ok &= (ctx->coeff16 = bench_calloc(width, sizeof(uint16_t))) != NULL;
+    ok &= (ctx->coeff16_src = bench_calloc(width, sizeof(uint16_t))) != NULL;
+    ok &= (ctx->gcli = bench_calloc(width, sizeof(uint8_t))) != NULL;
+    ok &= (ctx->gcli_top = bench_calloc(width, sizeof(uint8_t))) != NULL;
+    ok &= (ctx->gcli_pack = bench_calloc(width, sizeof(uint8_t))) != NULL;
+    ok &= (ctx->vpred_bits = bench_calloc(width, sizeof(uint8_t))) != NULL;
+    ok &= (ctx->vpred_sig = bench_calloc(width, sizeof(uint8_t))) != NULL;
+    ok &= (ctx->sig_max = bench_calloc(width, sizeof(uint8_t))) != NULL;
+    ok &= (ctx->pixels8 = bench_calloc(3 * width, sizeof(uint8_t))) != NULL;
+    ok &= (ctx->pixels16 = bench_calloc(3 * width, sizeof(uint16_t))) != NULL;
+    ok &= (ctx->bitstream = bench_calloc(ctx->bitstream_size, sizeof(uint8_t))) != NULL;
+    ok &= (ctx->pi = calloc(1, sizeof(pi_t))) != NULL;
+    if (!ok) {
+        bench_kernel_ctx_free(ctx);
+        return -1;
+    }
+
+    uint32_t seed = 0x5EED;
+    for (uint32_t i = 0; i < BENCH_LINES_NUM; ++i) {
+        for (uint32_t x = 0; x < width; ++x) {
+            /*Smooth signal with noise, range of 20 bits coefficients*/
+            ctx->lines[i][x] = (int32_t)((x * 97 + i * 1031) & 0x3FFFF) + (int32_t)(bench_rand(&seed) & 0xFFFF) - (1 << 17);
+        }
+    }
+    for (uint32_t x = 0; x < width; ++x) {
+        ctx->in_lf16[x] = (int16_t)((bench_rand(&seed) & 0xFFF) - 0x800);
+        ctx->in_hf16[x] = (int16_t)((bench_rand(&seed) & 0x3FF) - 0x200);
+        /*Sign and magnitude coefficients*/
+        ctx->coeff16_src[x] = (uint16_t)((bench_rand(&seed) & 0x8000) | (bench_rand(&seed) >> (bench_rand(&seed) % 16 + 2) & 0x7FFF));
+        ctx->gcli[x] = (uint8_t)(bench_rand(&seed) % 15);
+        ctx->gcli_top[x] = (uint8_t)(bench_rand(&seed) % 15);
+        ctx->gcli_pack[x] = (uint8_t)(BENCH_GTLI + 1 + bench_rand(&seed) % (15 - BENCH_GTLI - 1));
+    }
+    for (uint32_t x = 0; x < 3 * width; ++x) {
+        ctx->pixels8[x] = (uint8_t)bench_rand(&seed);
+        ctx->pixels16[x] = (uint16_t)(bench_rand(&seed) & 0x3FF);
+    }
+    for (uint32_t x = 0; x < ctx->bitstream_size; ++x) {
+        ctx->bitstream[x] = (uint8_t)bench_rand(&seed);
+    }
+
+    /*Single component picture with one line for whole picture output scaling*/
+    ctx->pi->comps_num = 1;
+    ctx->pi->width = width;
+    ctx->pi->height = 1;
+    ctx->pi->components[0].width = width;
+    ctx->pi->components[0].height = 1;
+    ctx->image8.data_yuv[0] = ctx->out8[0];
+    ctx->image8.stride[0] = width;
+    ctx->image8.alloc_size[0] = width;
+    ctx->image16.data_yuv[0] = ctx->out16[0];
+    ctx->image16.stride[0] = width;
+    ctx->image16.alloc_size[0] = width * sizeof(uint16_t);
+    return 0;
+}
+
+static void bench_rtcd_setup(CPU_FLAGS flags) {
+    setup_common_rtcd_internal(flags);
+    setup_encoder_rtcd_internal(flags);
+    setup_decoder_rtcd_internal(flags);
+}
+
+/*Return time of single call in nanoseconds, repeat calls until measure time is reached.*/
+static double bench_kernel_measure(const BenchKernel_t* kernel, BenchKernelCtx_t* ctx, uint64_t time_us) {
+    /*Warm up caches and branch predictors*/
+    for (uint32_t i = 0; i < 16; ++i) {
+        kernel->run(ctx);
+    }
+    uint64_t iterations = 16;
+    uint64_t elapsed_us = 0;
+    for (;;) {
+        uint64_t start_us = svt_jxs_get_time_us();
+        for (uint64_t i = 0; i < iterations; ++i) {
+            kernel->run(ctx);
+        }
+        elapsed_us = svt_jxs_get_time_us() - start_us;
+        if (elapsed_us >= time_us) {
+            break;
+        }
+        /*Estimate iterations to reach measure time, with at least doubling when time is too short to estimate*/
+        uint64_t next = elapsed_us ? iterations * time_us / elapsed_us + 1 : iterations * 2;
+        iterations = next > iterations * 2 ? next : iterations * 2;
+    }
+    return (double)elapsed_us * 1000.0 / (double)iterations;
+}
+
+int32_t bench_kernels_run(const BenchKernelConfig_t* config) {
+    BenchKernelCtx_t ctx;
+    if (config->width < 16) {
+        fprintf(stderr, "Kernel width have to be at least 16\n");
+        return -1;
+    }
+    if (bench_kernel_ctx_init(&ctx, config->width)) {
+        fprintf(stderr, "Can not allocate kernel buffers\n");
+        return -1;
+    }
+
+    const CPU_FLAGS cpu_flags = get_cpu_flags();
+    double results[KERNELS_NUM][ISA_LEVELS_NUM];
+    uintptr_t ptrs[KERNELS_NUM][ISA_LEVELS_NUM];
+    uint8_t level_available[ISA_LEVELS_NUM];
+    CPU_FLAGS prev_flags = CPU_FLAGS_INVALID;
+
+    for (uint32_t l = 0; l < ISA_LEVELS_NUM; ++l) {
+        const CPU_FLAGS flags = isa_levels[l].flags & cpu_flags;
+        /*Skip levels not supported by CPU, they resolve to the same flags as lower level*/
+        level_available[l] = (flags != prev_flags);
+        prev_flags = flags;
+        if (!level_available[l]) {
+            continue;
+        }
+        bench_rtcd_setup(flags);
+        for (uint32_t k = 0; k < KERNELS_NUM; ++k) {
+            results[k][l] = -1;
+            ptrs[k][l] = kernels[k].get_ptr();
+            if (config->filter && !strstr(kernels[k].name, config->filter)) {
+                continue;
+            }
+            /*Measure only when level bring own implementation*/
+            uint8_t new_implementation = 1;
+            for (uint32_t p = 0; p < l; ++p) {
+                if (level_available[p] && ptrs[k][p] == ptrs[k][l]) {
+                    new_implementation = 0;
+                }
+            }
+            if (new_implementation) {
+                results[k][l] = bench_kernel_measure(&kernels[k], &ctx, (uint64_t)config->time_ms * 1000);
+            }
+        }
+    }
+    bench_rtcd_setup(cpu_flags);
+
+    printf("Kernels: width %u, CPU: %s, time per pixel [ns], '-' no implementation for level\n",
+           config->width,
+           get_asm_level_name_str(cpu_flags));
+    printf("%-48s", "kernel");
+    for (uint32_t l = 0; l < ISA_LEVELS_NUM; ++l) {
+        if (level_available[l]) {
+            printf(" %9s", isa_levels[l].name);
+        }
+    }
+    printf(" %9s\n", "speedup");
+    for (uint32_t k = 0; k < KERNELS_NUM; ++k) {
+        if (config->filter && !strstr(kernels[k].name, config->filter)) {
+            continue;
+        }
+        double best = results[k][0];
+        printf("%-48s", kernels[k].name);
+        for (uint32_t l = 0; l < ISA_LEVELS_NUM; ++l) {
+            if (!level_available[l]) {
+                continue;
+            }
+            if (results[k][l] < 0) {
+                printf(" %9s", "-");
+                continue;
+            }
+            printf(" %9.4f", results[k][l] / config->width);
+            if (results[k][l] < best) {
+                best = results[k][l];
+            }
+        }
+        printf(" %8.2fx\n", results[k][0] / best);
+    }
+
+    bench_kernel_ctx_free(&ctx);
+    return 0;
+}
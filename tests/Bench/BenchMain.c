@@ -0,0 +1,196 @@
+/*
+* Copyright(c) 2024 Intel Corporation
+* SPDX - License - Identifier: BSD - 2 - Clause - Patent
+*/
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include "Bench.h"
+
+static void print_help(void) {
+    printf("Usage: SvtJpegxsBench [--kernels] [--pipeline] [options]\n"
+           "Without mode option run kernels and pipeline benchmark.\n"
+           "Kernels options:\n"
+           "  --kernel-width <n>      Line width passed to kernels, default 3840\n"
+           "  --kernel-time <ms>      Minimum measure time per kernel and ISA level, default 50\n"
+           "  --kernel-filter <name>  Run only kernels with name containing filter\n"
+           "Pipeline options:\n"
+           "  -w <n>                  Frame width, default 1920\n"
+           "  -h <n>                  Frame height, default 1080\n"
+           "  --colour-format <fmt>   yuv400, yuv420, yuv422, yuv444, default yuv422\n"
+           "  --input-depth <n>       Bit depth 8..14, default 8\n"
+           "  --bpp <n>               Bits per pixel, integer or float, default 3\n"
+           "  --slice-height <n>      Slice height, default 16\n"
+           "  --profile <n>           Encoder CPU profile, 0 - low latency, 1 - low CPU, default 0\n"
+           "  --lp <n>                Threads number, 0 - auto, default 0\n"
+           "  --asm <n>               Limit CPU flags used by pipeline, 0 - c .. 11 - max, default max\n"
+           "  -n <n>                  Measured frames number, default 60\n"
+           "  --warmup <n>            Frames processed before measure, default 8\n"
+           "  --frames-deep <n>       Max frames in flight in library, default 4\n"
+           "  --skip-decode           Measure only encoder\n");
+}
+
+static void set_bpp(const char* value, BenchPipelineConfig_t* cfg) {
+    char* end;
+    cfg->bpp_numerator = strtoul(value, &end, 0);
+    cfg->bpp_denominator = 1;
+    if (*end == '.' || *end == ',') {
+        value = end + 1;
+        uint32_t fraction = strtoul(value, &end, 10);
+        for (const char* c = value; c < end; ++c) {
+            cfg->bpp_denominator *= 10;
+        }
+        cfg->bpp_numerator = cfg->bpp_numerator * cfg->bpp_denominator + fraction;
+    }
+}
+
+static ColourFormat_t get_colour_format(const char* value) {
+    if (!strcmp(value, "yuv400")) {
+        return COLOUR_FORMAT_PLANAR_YUV400;
+    }
+    else if (!strcmp(value, "yuv420")) {
+        return COLOUR_FORMAT_PLANAR_YUV420;
+    }
+    else if (!strcmp(value, "yuv422")) {
+        return COLOUR_FORMAT_PLANAR_YUV422;
+    }
+    else if (!strcmp(value, "yuv444") || !strcmp(value, "rgb")) {
+        return COLOUR_FORMAT_PLANAR_YUV444_OR_RGB;
+    }
+    return COLOUR_FORMAT_INVALID;
+}
+
+static CPU_FLAGS get_asm_flags(const char* value) {
+    uint32_t level = strtoul(value, NULL, 0);
+    const CPU_FLAGS levels[] = {CPU_FLAGS_C,
+                                (CPU_FLAGS_MMX << 1) - 1,
+                                (CPU_FLAGS_SSE << 1) - 1,
+                                (CPU_FLAGS_SSE2 << 1) - 1,
+                                (CPU_FLAGS_SSE3 << 1) - 1,
+                                (CPU_FLAGS_SSSE3 << 1) - 1,
+                                (CPU_FLAGS_SSE4_1 << 1) - 1,
+                                (CPU_FLAGS_SSE4_2 << 1) - 1,
+                                (CPU_FLAGS_AVX << 1) - 1,
+                                (CPU_FLAGS_AVX2 << 1) - 1,
+                                (CPU_FLAGS_AVX512VL << 1) - 1,
+                                CPU_FLAGS_ALL};
+    if (level < sizeof(levels) / sizeof(levels[0])) {
+        return levels[level];
+    }
+    return CPU_FLAGS_INVALID;
+}
+
+int32_t main(int32_t argc, char* argv[]) {
+    uint8_t run_kernels = 0;
+    uint8_t run_pipeline = 0;
+    BenchKernelConfig_t kernel_cfg = {3840, 50, NULL};
+    BenchPipelineConfig_t pipeline_cfg;
+    memset(&pipeline_cfg, 0, sizeof(pipeline_cfg));
+    pipeline_cfg.width = 1920;
+    pipeline_cfg.height = 1080;
+    pipeline_cfg.bit_depth = 8;
+    pipeline_cfg.format = COLOUR_FORMAT_PLANAR_YUV422;
+    pipeline_cfg.bpp_numerator = 3;
+    pipeline_cfg.bpp_denominator = 1;
+    pipeline_cfg.slice_height = 16;
+    pipeline_cfg.use_cpu_flags = CPU_FLAGS_ALL;
+    pipeline_cfg.frames_num = 60;
+    pipeline_cfg.warmup_num = 8;
+    pipeline_cfg.frames_deep = 4;
+
+    for (int32_t i = 1; i < argc; ++i) {
+        const char* arg = argv[i];
+        const char* value = (i + 1 < argc) ? argv[i + 1] : NULL;
+        if (!strcmp(arg, "--help")) {
+            print_help();
+            return 0;
+        }
+        else if (!strcmp(arg, "--kernels")) {
+            run_kernels = 1;
+            continue;
+        }
+        else if (!strcmp(arg, "--pipeline")) {
+            run_pipeline = 1;
+            continue;
+        }
+        else if (!strcmp(arg, "--skip-decode")) {
+            pipeline_cfg.skip_decode = 1;
+            continue;
+        }
+        if (!value) {
+            fprintf(stderr, "Missing value or unknown option: %s\n", arg);
+            print_help();
+            return -1;
+        }
+        i++;
+        if (!strcmp(arg, "--kernel-width")) {
+            kernel_cfg.width = strtoul(value, NULL, 0);
+        }
+        else if (!strcmp(arg, "--kernel-time")) {
+            kernel_cfg.time_ms = strtoul(value, NULL, 0);
+        }
+        else if (!strcmp(arg, "--kernel-filter")) {
+            kernel_cfg.filter = value;
+        }
+        else if (!strcmp(arg, "-w")) {
+            pipeline_cfg.width = strtoul(value, NULL, 0);
+        }
+        else if (!strcmp(arg, "-h")) {
+            pipeline_cfg.height = strtoul(value, NULL, 0);
+        }
+        else if (!strcmp(arg, "--colour-format")) {
+            pipeline_cfg.format = get_colour_format(value);
+        }
+        else if (!strcmp(arg, "--input-depth")) {
+            pipeline_cfg.bit_depth = (uint8_t)strtoul(value, NULL, 0);
+        }
+        else if (!strcmp(arg, "--bpp")) {
+            set_bpp(value, &pipeline_cfg);
+        }
+        else if (!strcmp(arg, "--slice-height")) {
+            pipeline_cfg.slice_height = strtoul(value, NULL, 0);
+        }
+        else if (!strcmp(arg, "--profile")) {
+            pipeline_cfg.cpu_profile = (uint8_t)strtoul(value, NULL, 0);
+        }
+        else if (!strcmp(arg, "--lp")) {
+            pipeline_cfg.threads_num = strtoul(value, NULL, 0);
+        }
+        else if (!strcmp(arg, "--asm")) {
+            pipeline_cfg.use_cpu_flags = get_asm_flags(value);
+        }
+        else if (!strcmp(arg, "-n")) {
+            pipeline_cfg.frames_num = strtoul(value, NULL, 0);
+        }
+        else if (!strcmp(arg, "--warmup")) {
+            pipeline_cfg.warmup_num = strtoul(value, NULL, 0);
+        }
+        else if (!strcmp(arg, "--frames-deep")) {
+            pipeline_cfg.frames_deep = strtoul(value, NULL, 0);
+        }
+        else {
+            fprintf(stderr, "Unknown option: %s\n", arg);
+            print_help();
+            return -1;
+        }
+    }
+
+    if (!run_kernels && !run_pipeline) {
+        run_kernels = 1;
+        run_pipeline = 1;
+    }
+    if (pipeline_cfg.format == COLOUR_FORMAT_INVALID || pipeline_cfg.use_cpu_flags == CPU_FLAGS_INVALID) {
+        fprintf(stderr, "Invalid colour format or asm level\n");
+        return -1;
+    }
+
+    int32_t ret = 0;
+    if (run_kernels) {
+        ret |= bench_kernels_run(&kernel_cfg);
+    }
+    if (run_pipeline) {
+        ret |= bench_pipeline_run(&pipeline_cfg);
+    }
+    return ret;
+}
@@ -0,0 +1,392 @@
+/*
+* Copyright(c) 2024 Intel Corporation
+* SPDX - License - Identifier: BSD - 2 - Clause - Patent
+*/
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#ifdef _WIN32
+#include <windows.h>
+#else
+#include <sys/resource.h>
+#endif
+#include "Bench.h"
+#include "SvtUtility.h"
+#include "EncDec.h"
+#include "SvtJpegxsEnc.h"
+#include "SvtJpegxsDec.h"
+#include "SvtJpegxsImageBufferTools.h"
+
+/*Number of different synthetic frames, encoded frames are reused as decoder input.*/
+#define BENCH_SOURCE_FRAMES_NUM 4
+
+typedef struct BenchResult {
+    uint32_t frames_num;
+    uint64_t wall_us;
+    uint64_t cpu_us;
+    uint64_t bytes;
+    uint64_t* latency_us; /*Per measured frame*/
+} BenchResult_t;
+
+typedef struct BenchSlot {
+    uint64_t time_send_us;
+    uint32_t frame_idx;
+    svt_jpeg_xs_bitstream_buffer_t* bitstream; /*Encoder output*/
+    svt_jpeg_xs_image_buffer_t* image;         /*Decoder output*/
+} BenchSlot_t;
+
+typedef struct BenchPipeline {
+    const BenchPipelineConfig_t* config;
+    svt_jpeg_xs_image_config_t image_config;
+    uint32_t bytes_per_frame;
+    svt_jpeg_xs_image_buffer_t* sources[BENCH_SOURCE_FRAMES_NUM];
+    svt_jpeg_xs_bitstream_buffer_t encoded[BENCH_SOURCE_FRAMES_NUM];
+    BenchSlot_t* slots;
+    uint32_t* free_slots;
+    uint32_t free_slots_num;
+} BenchPipeline_t;
+
+/*User and system time of whole process, include all library threads.*/
+static uint64_t bench_get_cpu_time_us(void) {
+#ifdef _WIN32
+    FILETIME creation_time, exit_time, kernel_time, user_time;
+    if (!GetProcessTimes(GetCurrentProcess(), &creation_time, &exit_time, &kernel_time, &user_time)) {
+        return 0;
+    }
+    uint64_t kernel_100ns = ((uint64_t)kernel_time.dwHighDateTime << 32) | kernel_time.dwLowDateTime;
+    uint64_t user_100ns = ((uint64_t)user_time.dwHighDateTime << 32) | user_time.dwLowDateTime;
+    return (kernel_100ns + user_100ns) / 10;
+#else
+    struct rusage usage;
+    if (getrusage(RUSAGE_SELF, &usage)) {
+        return 0;
+    }
+    return (uint64_t)(usage.ru_utime.tv_sec + usage.ru_stime.tv_sec) * 1000000 + usage.ru_utime.tv_usec +
+        usage.ru_stime.tv_usec;
+#endif
+}
+
+static int compare_u64(const void* a, const void* b) {
+    uint64_t va = *(const uint64_t*)a;
+    uint64_t vb = *(const uint64_t*)b;
+    return (va > vb) - (va < vb);
+}
+
+static uint64_t percentile(const uint64_t* sorted, uint32_t num, uint32_t percent) {
+    uint32_t idx = (uint32_t)(((uint64_t)num * percent + 99) / 100);
+    return sorted[idx ? idx - 1 : 0];
+}
+
+static void bench_result_print(const char* name, const BenchResult_t* result) {
+    if (!result->frames_num) {
+        return;
+    }
+    qsort(result->latency_us, result->frames_num, sizeof(uint64_t), compare_u64);
+    double wall_s = (double)result->wall_us / 1000000.0;
+    printf("%s: frames %u, fps %.2f, %.2f Mbit/frame\n",
+           name,
+           result->frames_num,
+           wall_s > 0 ? result->frames_num / wall_s : 0.0,
+           (double)result->bytes * 8 / 1000000.0 / result->frames_num);
+    printf("    latency [ms]: p50 %.3f p90 %.3f p99 %.3f max %.3f\n",
+           percentile(result->latency_us, result->frames_num, 50) / 1000.0,
+           percentile(result->latency_us, result->frames_num, 90) / 1000.0,
+           percentile(result->latency_us, result->frames_num, 99) / 1000.0,
+           result->latency_us[result->frames_num - 1] / 1000.0);
+    printf("    CPU time: %.3f ms/frame, %.2f cores busy\n",
+           (double)result->cpu_us / 1000.0 / result->frames_num,
+           result->wall_us ? (double)result->cpu_us / result->wall_us : 0.0);
+}
+
+/*Synthetic content: moving gradients with texture and noise, every frame different.*/
+static void bench_fill_source(svt_jpeg_xs_image_buffer_t* image, const svt_jpeg_xs_image_config_t* config, uint32_t frame) {
+    uint32_t seed = 0xC0FFEE + frame;
+    const uint32_t max_value = (1 << config->bit_depth) - 1;
+    for (uint32_t c = 0; c < config->components_num; ++c) {
+        const uint32_t w = config->components[c].width;
+        const uint32_t h = config->components[c].height;
+        for (uint32_t y = 0; y < h; ++y) {
+            for (uint32_t x = 0; x < w; ++x) {
+                uint32_t v = ((x + frame * 8) * 3 + y * 2 + c * 64) % 512;
+                v = (v > 255 ? 511 - v : v) << 4;
+                v += ((x / 16 + y / 16 + frame) & 1) ? 1024 : 0;
+                v += bench_rand(&seed) % 256;
+                v = (v * max_value) / 5375;
+                if (config->bit_depth <= 8) {
+                    ((uint8_t*)image->data_yuv[c])[y * image->stride[c] + x] = (uint8_t)v;
+                }
+                else {
+                    ((uint16_t*)image->data_yuv[c])[y * image->stride[c] + x] = (uint16_t)v;
+                }
+            }
+        }
+    }
+}
+
+static SvtJxsErrorType_t bench_encode(BenchPipeline_t* bench, svt_jpeg_xs_encoder_api_t* enc, uint32_t frames_num,
+                                      BenchResult_t* result) {
+    SvtJxsErrorType_t err = SvtJxsErrorNone;
+    uint32_t sent = 0;
+    uint32_t received = 0;
+    uint64_t start_us = svt_jxs_get_time_us();
+    uint64_t start_cpu_us = bench_get_cpu_time_us();
+    while (received < frames_num) {
+        if (sent < frames_num && bench->free_slots_num) {
+            uint32_t slot_idx = bench->free_slots[--bench->free_slots_num];
+            BenchSlot_t* slot = &bench->slots[slot_idx];
+            svt_jpeg_xs_frame_t frame;
+            frame.image = *bench->sources[sent % BENCH_SOURCE_FRAMES_NUM];
+            frame.bitstream = *slot->bitstream;
+            frame.user_prv_ctx_ptr = (void*)(uintptr_t)slot_idx;
+            slot->frame_idx = sent;
+            slot->time_send_us = svt_jxs_get_time_us();
+            err = svt_jpeg_xs_encoder_send_picture(enc, &frame, 1 /*blocking*/);
+            if (err) {
+                return err;
+            }
+            sent++;
+            continue;
+        }
+        svt_jpeg_xs_frame_t frame;
+        err = svt_jpeg_xs_encoder_get_packet(enc, &frame, 1 /*blocking*/);
+        if (err) {
+            return err;
+        }
+        uint32_t slot_idx = (uint32_t)(uintptr_t)frame.user_prv_ctx_ptr;
+        BenchSlot_t* slot = &bench->slots[slot_idx];
+        if (result) {
+            result->latency_us[received] = svt_jxs_get_time_us() - slot->time_send_us;
+            result->bytes += frame.bitstream.used_size;
+        }
+        if (slot->frame_idx < BENCH_SOURCE_FRAMES_NUM && !bench->encoded[slot->frame_idx].used_size) {
+            svt_jpeg_xs_bitstream_buffer_t* encoded = &bench->encoded[slot->frame_idx];
+            memcpy(encoded->buffer, frame.bitstream.buffer, frame.bitstream.used_size);
+            encoded->used_size = frame.bitstream.used_size;
+        }
+        bench->free_slots[bench->free_slots_num++] = slot_idx;
+        received++;
+    }
+    if (result) {
+        result->wall_us = svt_jxs_get_time_us() - start_us;
+        result->cpu_us = bench_get_cpu_time_us() - start_cpu_us;
+        result->frames_num = frames_num;
+    }
+    return err;
+}
+
+static SvtJxsErrorType_t bench_decode(BenchPipeline_t* bench, svt_jpeg_xs_decoder_api_t* dec, uint32_t frames_num,
+                                      BenchResult_t* result) {
+    SvtJxsErrorType_t err = SvtJxsErrorNone;
+    uint32_t sent = 0;
+    uint32_t received = 0;
+    uint64_t start_us = svt_jxs_get_time_us();
+    uint64_t start_cpu_us = bench_get_cpu_time_us();
+    while (received < frames_num) {
+        if (sent < frames_num && bench->free_slots_num) {
+            uint32_t slot_idx = bench->free_slots[--bench->free_slots_num];
+            BenchSlot_t* slot = &bench->slots[slot_idx];
+            svt_jpeg_xs_frame_t frame;
+            frame.image = *slot->image;
+            frame.bitstream = bench->encoded[sent % BENCH_SOURCE_FRAMES_NUM];
+            frame.user_prv_ctx_ptr = (void*)(uintptr_t)slot_idx;
+            slot->frame_idx = sent;
+            slot->time_send_us = svt_jxs_get_time_us();
+            err = svt_jpeg_xs_decoder_send_frame(dec, &frame, 1 /*blocking*/);
+            if (err) {
+                return err;
+            }
+            sent++;
+            continue;
+        }
+        svt_jpeg_xs_frame_t frame;
+        err = svt_jpeg_xs_decoder_get_frame(dec, &frame, 1 /*blocking*/);
+        if (err) {
+            return err;
+        }
+        uint32_t slot_idx = (uint32_t)(uintptr_t)frame.user_prv_ctx_ptr;
+        if (result) {
+            result->latency_us[received] = svt_jxs_get_time_us() - bench->slots[slot_idx].time_send_us;
+            result->bytes += frame.bitstream.used_size;
+        }
+        bench->free_slots[bench->free_slots_num++] = slot_idx;
+        received++;
+    }
+    if (result) {
+        result->wall_us = svt_jxs_get_time_us() - start_us;
+        result->cpu_us = bench_get_cpu_time_us() - start_cpu_us;
+        result->frames_num = frames_num;
+    }
+    return err;
+}
+
+static void bench_pipeline_free(BenchPipeline_t* bench) {
+    for (uint32_t i = 0; i < BENCH_SOURCE_FRAMES_NUM; ++i) {
+        if (bench->sources[i]) {
+            svt_jpeg_xs_image_buffer_free(bench->sources[i]);
+        }
+        free(bench->encoded[i].buffer);
+    }
+    if (bench->slots) {
+        for (uint32_t i = 0; i < bench->config->frames_deep; ++i) {
+            if (bench->slots[i].bitstream) {
+                svt_jpeg_xs_bitstream_free(bench->slots[i].bitstream);
+            }
+            if (bench->slots[i].image) {
+                svt_jpeg_xs_image_buffer_free(bench->slots[i].image);
+            }
+        }
+    }
+    free(bench->slots);
+    free(bench->free_slots);
+}
+
+static void bench_slots_reset(BenchPipeline_t* bench) {
+    bench->free_slots_num = bench->config->frames_deep;
+    for (uint32_t i = 0; i < bench->free_slots_num; ++i) {
+        bench->free_slots[i] = i;
+    }
+}
+
+static SvtJxsErrorType_t bench_pipeline_encoder(BenchPipeline_t* bench, BenchResult_t* result) {
+    const BenchPipelineConfig_t* config = bench->config;
+    svt_jpeg_xs_encoder_api_t enc;
+    SvtJxsErrorType_t err = svt_jpeg_xs_encoder_load_default_parameters(SVT_JPEGXS_API_VER_MAJOR, SVT_JPEGXS_API_VER_MINOR, &enc);
+    if (err) {
+        return err;
+    }
+    enc.source_width = config->width;
+    enc.source_height = config->height;
+    enc.input_bit_depth = config->bit_depth;
+    enc.colour_format = config->format;
+    enc.bpp_numerator = config->bpp_numerator;
+    enc.bpp_denominator = config->bpp_denominator;
+    enc.slice_height = config->slice_height;
+    enc.cpu_profile = config->cpu_profile;
+    enc.threads_num = config->threads_num;
+    enc.use_cpu_flags = config->use_cpu_flags;
+    enc.verbose = VERBOSE_ERRORS;
+
+    err = svt_jpeg_xs_encoder_get_image_config(
+        SVT_JPEGXS_API_VER_MAJOR, SVT_JPEGXS_API_VER_MINOR, &enc, &bench->image_config, &bench->bytes_per_frame);
+    if (err) {
+        return err;
+    }
+    for (uint32_t i = 0; i < BENCH_SOURCE_FRAMES_NUM; ++i) {
+        bench->sources[i] = svt_jpeg_xs_image_buffer_alloc(&bench->image_config);
+        bench->encoded[i].buffer = malloc(bench->bytes_per_frame);
+        bench->encoded[i].allocation_size = bench->bytes_per_frame;
+        bench->encoded[i].used_size = 0;
+        if (!bench->sources[i] || !bench->encoded[i].buffer) {
+            return SvtJxsErrorInsufficientResources;
+        }
+        bench_fill_source(bench->sources[i], &bench->image_config, i);
+    }
+    for (uint32_t i = 0; i < config->frames_deep; ++i) {
+        bench->slots[i].bitstream = svt_jpeg_xs_bitstream_alloc(bench->bytes_per_frame);
+        if (!bench->slots[i].bitstream) {
+            return SvtJxsErrorInsufficientResources;
+        }
+    }
+
+    err = svt_jpeg_xs_encoder_init(SVT_JPEGXS_API_VER_MAJOR, SVT_JPEGXS_API_VER_MINOR, &enc);
+    if (err) {
+        return err;
+    }
+    bench_slots_reset(bench);
+    /*Warm up frames also produce all source bitstreams for decoder*/
+    uint32_t warmup_num = config->warmup_num > BENCH_SOURCE_FRAMES_NUM ? config->warmup_num : BENCH_SOURCE_FRAMES_NUM;
+    err = bench_encode(bench, &enc, warmup_num, NULL);
+    if (!err) {
+        err = bench_encode(bench, &enc, config->frames_num, result);
+    }
+    svt_jpeg_xs_encoder_close(&enc);
+    return err;
+}
+
+static SvtJxsErrorType_t bench_pipeline_decoder(BenchPipeline_t* bench, BenchResult_t* result) {
+    const BenchPipelineConfig_t* config = bench->config;
+    svt_jpeg_xs_decoder_api_t dec;
+    memset(&dec, 0, sizeof(dec));
+    dec.use_cpu_flags = config->use_cpu_flags;
+    dec.threads_num = config->threads_num;
+    dec.proxy_mode = proxy_mode_full;
+    dec.verbose = VERBOSE_ERRORS;
+
+    svt_jpeg_xs_image_config_t image_config;
+    SvtJxsErrorType_t err = svt_jpeg_xs_decoder_init(SVT_JPEGXS_API_VER_MAJOR,
+                                                     SVT_JPEGXS_API_VER_MINOR,
+                                                     &dec,
+                                                     bench->encoded[0].buffer,
+                                                     bench->encoded[0].used_size,
+                                                     &image_config);
+    if (err) {
+        return err;
+    }
+    for (uint32_t i = 0; i < config->frames_deep; ++i) {
+        bench->slots[i].image = svt_jpeg_xs_image_buffer_alloc(&image_config);
+        if (!bench->slots[i].image) {
+            svt_jpeg_xs_decoder_close(&dec);
+            return SvtJxsErrorInsufficientResources;
+        }
+    }
+    bench_slots_reset(bench);
+    err = bench_decode(bench, &dec, config->warmup_num, NULL);
+    if (!err) {
+        err = bench_decode(bench, &dec, config->frames_num, result);
+    }
+    svt_jpeg_xs_decoder_close(&dec);
+    return err;
+}
+
+int32_t bench_pipeline_run(const BenchPipelineConfig_t* config) {
+    BenchPipeline_t bench;
+    memset(&bench, 0, sizeof(bench));
+    bench.config = config;
+    if (!config->frames_num || !config->frames_deep) {
+        fprintf(stderr, "Number of frames and frames in flight have to be greater than 0\n");
+        return -1;
+    }
+
+    BenchResult_t enc_result;
+    BenchResult_t dec_result;
+    memset(&enc_result, 0, sizeof(enc_result));
+    memset(&dec_result, 0, sizeof(dec_result));
+    enc_result.latency_us = calloc(config->frames_num, sizeof(uint64_t));
+    dec_result.latency_us = calloc(config->frames_num, sizeof(uint64_t));
+    bench.slots = calloc(config->frames_deep, sizeof(BenchSlot_t));
+    bench.free_slots = calloc(config->frames_deep, sizeof(uint32_t));
+    SvtJxsErrorType_t err = SvtJxsErrorInsufficientResources;
+    if (enc_result.latency_us && dec_result.latency_us && bench.slots && bench.free_slots) {
+        err = bench_pipeline_encoder(&bench, &enc_result);
+        if (err) {
+            fprintf(stderr, "Encoder benchmark fail: 0x%x\n", err);
+        }
+        else if (!config->skip_decode) {
+            err = bench_pipeline_decoder(&bench, &dec_result);
+            if (err) {
+                fprintf(stderr, "Decoder benchmark fail: 0x%x\n", err);
+            }
+        }
+    }
+
+    if (!err) {
+        printf("Pipeline: %ux%u %s depth %u bpp %.3f slice_height %u profile %u threads %u frames in flight %u\n",
+               config->width,
+               config->height,
+               svt_jpeg_xs_get_format_name(config->format),
+               config->bit_depth,
+               (double)config->bpp_numerator / config->bpp_denominator,
+               config->slice_height,
+               config->cpu_profile,
+               config->threads_num,
+               config->frames_deep);
+        bench_result_print("Encoder", &enc_result);
+        bench_result_print("Decoder", &dec_result);
+    }
+
+    bench_pipeline_free(&bench);
+    free(enc_result.latency_us);
+    free(dec_result.latency_us);
+    return err ? -1 : 0;
+}
@@ -0,0 +1,162 @@
+/*
+* Copyright(c) 2024 Intel Corporation
+* SPDX - License - Identifier: BSD - 2 - Clause - Patent
+*/
+
+#include <stdlib.h>
+#include <string.h>
+
+#include "gtest/gtest.h"
+#include "SvtJpegxsImageBufferTools.h"
+#include "ApiTestUtils.h"
+
+#define TEST_ALLOCATOR_HEADER_SIZE 64
+
+/*Keep size, base pointer and purpose of allocation before returned pointer*/
+static void* test_aligned_alloc(void* context, size_t size, size_t alignment, SvtJxsMemPurpose_t purpose) {
+    TestAllocatorCtx* ctx = (TestAllocatorCtx*)context;
+    EXPECT_LE(alignment, (size_t)TEST_ALLOCATOR_HEADER_SIZE);
+    uint8_t* base = (uint8_t*)malloc(size + 2 * TEST_ALLOCATOR_HEADER_SIZE);
+    if (!base) {
+        return NULL;
+    }
+    uintptr_t ptr = ((uintptr_t)base + 2 * TEST_ALLOCATOR_HEADER_SIZE - 1) & ~((uintptr_t)TEST_ALLOCATOR_HEADER_SIZE - 1);
+    ((size_t*)ptr)[-1] = size;
+    ((uint8_t**)ptr)[-2] = base;
+    ((size_t*)ptr)[-3] = purpose;
+    ctx->live_allocations++;
+    ctx->bytes_current += size;
+    ctx->purpose_bytes_current[purpose] += size;
+    if (ctx->bytes_current > ctx->bytes_peak) {
+        ctx->bytes_peak = ctx->bytes_current;
+        memcpy(ctx->purpose_bytes_peak, ctx->purpose_bytes_current, sizeof(ctx->purpose_bytes_peak));
+    }
+    ctx->purpose_allocations[purpose]++;
+    return (void*)ptr;
+}
+
+static void* test_alloc(void* context, size_t size, SvtJxsMemPurpose_t purpose) {
+    return test_aligned_alloc(context, size, 16, purpose);
+}
+
+static void test_free(void* context, void* ptr) {
+    TestAllocatorCtx* ctx = (TestAllocatorCtx*)context;
+    ASSERT_GT(ctx->live_allocations, (size_t)0);
+    ctx->live_allocations--;
+    ctx->bytes_current -= ((size_t*)ptr)[-1];
+    ctx->purpose_bytes_current[((size_t*)ptr)[-3]] -= ((size_t*)ptr)[-1];
+    free(((uint8_t**)ptr)[-2]);
+}
+
+void test_allocator_init(svt_jpeg_xs_allocator_t* allocator, TestAllocatorCtx* ctx) {
+    memset(ctx, 0, sizeof(*ctx));
+    allocator->alloc = test_alloc;
+    allocator->aligned_alloc = test_aligned_alloc;
+    allocator->free = test_free;
+    allocator->context = ctx;
+}
+
+void encoder_test_config(svt_jpeg_xs_encoder_api_t* encoder) {
+    svt_jpeg_xs_encoder_load_default_parameters(SVT_JPEGXS_API_VER_MAJOR, SVT_JPEGXS_API_VER_MINOR, encoder);
+    encoder->verbose = VERBOSE_NONE;
+    encoder->source_width = 64;
+    encoder->source_height = 64;
+    encoder->input_bit_depth = 8;
+    encoder->colour_format = COLOUR_FORMAT_PLANAR_YUV422;
+    encoder->bpp_numerator = 3;
+    encoder->threads_num = 4;
+}
+
+void decoder_test_config(svt_jpeg_xs_decoder_api_t* decoder) {
+    memset(decoder, 0, sizeof(*decoder));
+    decoder->verbose = VERBOSE_NONE;
+    decoder->threads_num = 4;
+    decoder->use_cpu_flags = CPU_FLAGS_ALL;
+}
+
+void encode_test_fill_frame(svt_jpeg_xs_frame_t* frame, uint8_t components_num, uint32_t frame_idx, uint32_t stream_idx) {
+    for (int c = 0; c < components_num; c++) {
+        uint8_t* data = (uint8_t*)frame->image.data_yuv[c];
+        for (uint32_t j = 0; j < frame->image.alloc_size[c]; j++) {
+            data[j] = (uint8_t)((j * j) / (frame_idx + 3) + c * 50 + stream_idx * 7);
+        }
+    }
+}
+
+void encode_test_send_frames(svt_jpeg_xs_encoder_api_t* encoder, svt_jpeg_xs_frame_pool_t* pool, uint8_t components_num,
+                             uint32_t stream_idx, uint32_t frames_num, uint8_t blocking_flag) {
+    for (uint32_t i = 0; i < frames_num; i++) {
+        svt_jpeg_xs_frame_t frame;
+        ASSERT_EQ(svt_jpeg_xs_frame_pool_get(pool, &frame, blocking_flag), SvtJxsErrorNone);
+        encode_test_fill_frame(&frame, components_num, i, stream_idx);
+        ASSERT_EQ(svt_jpeg_xs_encoder_send_picture(encoder, &frame, blocking_flag), SvtJxsErrorNone);
+    }
+}
+
+void encode_test_receive_frames(svt_jpeg_xs_encoder_api_t* encoder, svt_jpeg_xs_frame_pool_t* pool, uint32_t frames_num,
+                                std::vector<uint8_t>* codestream) {
+    /*With slice packetization header and every slice are in separate packet, in order of slices*/
+    for (uint32_t i = 0; i < frames_num;) {
+        svt_jpeg_xs_frame_t frame;
+        ASSERT_EQ(svt_jpeg_xs_encoder_get_packet(encoder, &frame, 1), SvtJxsErrorNone);
+        codestream->insert(codestream->end(), frame.bitstream.buffer, frame.bitstream.buffer + frame.bitstream.used_size);
+        if (frame.bitstream.last_packet_in_frame) {
+            i++;
+        }
+        svt_jpeg_xs_frame_pool_release(pool, &frame);
+    }
+}
+
+void encode_test_frames(svt_jpeg_xs_encoder_api_t* encoder, uint32_t frames_num, std::vector<uint8_t>* codestream,
+                        uint32_t stream_idx) {
+    svt_jpeg_xs_image_config_t image_config;
+    uint32_t bytes_per_frame = 0;
+    ASSERT_EQ(svt_jpeg_xs_encoder_get_image_config(
+                  SVT_JPEGXS_API_VER_MAJOR, SVT_JPEGXS_API_VER_MINOR, encoder, &image_config, &bytes_per_frame),
+              SvtJxsErrorNone);
+    ASSERT_EQ(svt_jpeg_xs_encoder_init(SVT_JPEGXS_API_VER_MAJOR, SVT_JPEGXS_API_VER_MINOR, encoder), SvtJxsErrorNone);
+    svt_jpeg_xs_frame_pool_t* pool = svt_jpeg_xs_frame_pool_alloc(&image_config, bytes_per_frame, frames_num);
+    ASSERT_NE(pool, nullptr);
+
+    encode_test_send_frames(encoder, pool, image_config.components_num, stream_idx, frames_num);
+    encode_test_receive_frames(encoder, pool, frames_num, codestream);
+    svt_jpeg_xs_encoder_close(encoder);
+    svt_jpeg_xs_frame_pool_free(pool);
+}
+
+SvtJxsErrorType_t decode_test_frame(svt_jpeg_xs_decoder_api_t* decoder, const uint8_t* codestream, uint32_t codestream_size,
+                                    svt_jpeg_xs_image_buffer_t* image) {
+    svt_jpeg_xs_frame_t frame;
+    memset(&frame, 0, sizeof(frame));
+    frame.image = *image;
+    frame.bitstream.buffer = (uint8_t*)codestream;
+    frame.bitstream.used_size = codestream_size;
+    frame.bitstream.allocation_size = codestream_size;
+    SvtJxsErrorType_t ret = svt_jpeg_xs_decoder_send_frame(decoder, &frame, 1);
+    if (ret) {
+        return ret;
+    }
+    return svt_jpeg_xs_decoder_get_frame(decoder, &frame, 1);
+}
+
+SvtJxsErrorType_t decode_test_single_frame(const uint8_t* codestream, uint32_t codestream_size,
+                                           svt_jpeg_xs_image_buffer_t** out_image, svt_jpeg_xs_image_config_t* image_config) {
+    svt_jpeg_xs_decoder_api_t decoder;
+    decoder_test_config(&decoder);
+    SvtJxsErrorType_t ret = svt_jpeg_xs_decoder_init(
+        SVT_JPEGXS_API_VER_MAJOR, SVT_JPEGXS_API_VER_MINOR, &decoder, codestream, codestream_size, image_config);
+    if (ret) {
+        return ret;
+    }
+    *out_image = svt_jpeg_xs_image_buffer_alloc(image_config);
+    ret = decode_test_frame(&decoder, codestream, codestream_size, *out_image);
+    svt_jpeg_xs_decoder_close(&decoder);
+    return ret;
+}
+
+void decode_test_compare(const svt_jpeg_xs_image_config_t* image_config, const svt_jpeg_xs_image_buffer_t* image,
+                         const svt_jpeg_xs_image_buffer_t* image_ref) {
+    for (int c = 0; c < image_config->components_num; c++) {
+        EXPECT_EQ(memcmp(image->data_yuv[c], image_ref->data_yuv[c], image_config->components[c].byte_size), 0) << "comp " << c;
+    }
+}
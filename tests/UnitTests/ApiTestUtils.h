@@ -0,0 +1,51 @@
+/*
+* Copyright(c) 2024 Intel Corporation
+* SPDX - License - Identifier: BSD - 2 - Clause - Patent
+*/
+
+#ifndef _API_TEST_UTILS_H_
+#define _API_TEST_UTILS_H_
+#include <stdint.h>
+#include <vector>
+#include "SvtJpegxsDec.h"
+#include "SvtJpegxsEnc.h"
+
+/*Caller allocator counting live allocations and bytes per purpose*/
+typedef struct TestAllocatorCtx {
+    size_t live_allocations;
+    size_t bytes_current;
+    size_t bytes_peak;
+    size_t purpose_allocations[SVT_JXS_MEM_BITSTREAM + 1];
+    size_t purpose_bytes_current[SVT_JXS_MEM_BITSTREAM + 1];
+    size_t purpose_bytes_peak[SVT_JXS_MEM_BITSTREAM + 1]; /*Split of bytes_current when bytes_peak was reached*/
+} TestAllocatorCtx;
+
+void test_allocator_init(svt_jpeg_xs_allocator_t* allocator, TestAllocatorCtx* ctx);
+
+/*Encoder of 64x64 8bit YUV422 with 3 bpp on 4 threads*/
+void encoder_test_config(svt_jpeg_xs_encoder_api_t* encoder);
+/*Decoder on 4 threads with all CPU flags*/
+void decoder_test_config(svt_jpeg_xs_decoder_api_t* decoder);
+
+/*Fill 8bit frame with pattern different for every frame and stream*/
+void encode_test_fill_frame(svt_jpeg_xs_frame_t* frame, uint8_t components_num, uint32_t frame_idx, uint32_t stream_idx);
+/*Send frames_num frames filled by encode_test_fill_frame() to encoder*/
+void encode_test_send_frames(svt_jpeg_xs_encoder_api_t* encoder, svt_jpeg_xs_frame_pool_t* pool, uint8_t components_num,
+                             uint32_t stream_idx, uint32_t frames_num, uint8_t blocking_flag = 1);
+/*Get all packets of frames_num frames from encoder and append them to codestream*/
+void encode_test_receive_frames(svt_jpeg_xs_encoder_api_t* encoder, svt_jpeg_xs_frame_pool_t* pool, uint32_t frames_num,
+                                std::vector<uint8_t>* codestream);
+/*Initialize configured encoder, encode frames_num frames into one continuous codestream and close encoder*/
+void encode_test_frames(svt_jpeg_xs_encoder_api_t* encoder, uint32_t frames_num, std::vector<uint8_t>* codestream,
+                        uint32_t stream_idx = 0);
+
+/*Decode single frame by new decoder, image is allocated for decoded configuration*/
+SvtJxsErrorType_t decode_test_single_frame(const uint8_t* codestream, uint32_t codestream_size,
+                                           svt_jpeg_xs_image_buffer_t** out_image, svt_jpeg_xs_image_config_t* image_config);
+/*Send single frame to initialized decoder and receive it*/
+SvtJxsErrorType_t decode_test_frame(svt_jpeg_xs_decoder_api_t* decoder, const uint8_t* codestream, uint32_t codestream_size,
+                                    svt_jpeg_xs_image_buffer_t* image);
+void decode_test_compare(const svt_jpeg_xs_image_config_t* image_config, const svt_jpeg_xs_image_buffer_t* image,
+                         const svt_jpeg_xs_image_buffer_t* image_ref);
+
+#endif /*_API_TEST_UTILS_H_*/
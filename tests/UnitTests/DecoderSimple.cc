@@ -114,7 +114,7 @@ SvtJxsErrorType_t svt_jpeg_xs_decode(svt_jpeg_xs_decoder_instance_t* ctx, svt_jp
     }
     else {
         for (uint32_t slice = 0; slice < pi->slice_num; slice++) {
-            ret = svt_jpeg_xs_decode_final_slice_overlap(ctx, out, slice);
+            ret = svt_jpeg_xs_decode_final_slice_overlap(ctx, dec_thread_context, out, slice);
             if (ret) {
                 return ret;
             }
@@ -0,0 +1,89 @@
+/*
+* Copyright(c) 2024 Intel Corporation
+* SPDX - License - Identifier: BSD - 2 - Clause - Patent
+*/
+
+#include <string.h>
+
+#include "gtest/gtest.h"
+#include "SvtJpegxsImageBufferTools.h"
+#include "ApiTestUtils.h"
+#include "SampleFramesData.h"
+
+/*
+ * Tests for caller allocator and memory footprint
+ */
+
+TEST(Allocator, EncoderAllocationsUseCallbacks) {
+    TestAllocatorCtx ctx;
+    svt_jpeg_xs_allocator_t allocator;
+    test_allocator_init(&allocator, &ctx);
+
+    svt_jpeg_xs_encoder_api_t encoder;
+    encoder_test_config(&encoder);
+    encoder.allocator = &allocator;
+    ASSERT_EQ(svt_jpeg_xs_encoder_init(SVT_JPEGXS_API_VER_MAJOR, SVT_JPEGXS_API_VER_MINOR, &encoder), SvtJxsErrorNone);
+    size_t live_after_init = ctx.live_allocations;
+    EXPECT_GT(live_after_init, (size_t)0);
+    EXPECT_GT(ctx.purpose_allocations[SVT_JXS_MEM_GENERAL], (size_t)0);
+    EXPECT_GT(ctx.purpose_allocations[SVT_JXS_MEM_COEFFICIENTS], (size_t)0);
+    svt_jpeg_xs_encoder_close(&encoder);
+    EXPECT_EQ(ctx.live_allocations, (size_t)0);
+    EXPECT_EQ(ctx.bytes_current, (size_t)0);
+
+    size_t footprint = 0;
+    encoder_test_config(&encoder);
+    ASSERT_EQ(svt_jpeg_xs_encoder_get_memory_footprint(SVT_JPEGXS_API_VER_MAJOR, SVT_JPEGXS_API_VER_MINOR, &encoder, &footprint),
+              SvtJxsErrorNone);
+    EXPECT_EQ(footprint, ctx.bytes_peak);
+}
+
+TEST(Allocator, DecoderAllocationsUseCallbacks) {
+    TestAllocatorCtx ctx;
+    svt_jpeg_xs_allocator_t allocator;
+    test_allocator_init(&allocator, &ctx);
+
+    svt_jpeg_xs_decoder_api_t decoder;
+    decoder_test_config(&decoder);
+    decoder.allocator = &allocator;
+
+    svt_jpeg_xs_image_config_t image_config;
+    ASSERT_EQ(svt_jpeg_xs_decoder_init(SVT_JPEGXS_API_VER_MAJOR,
+                                       SVT_JPEGXS_API_VER_MINOR,
+                                       &decoder,
+                                       Frame_Sample_1_16x16_8bit_422_bitstream,
+                                       Frame_Sample_1_16x16_8bit_422_bitstream_size,
+                                       &image_config),
+              SvtJxsErrorNone);
+    EXPECT_GT(ctx.live_allocations, (size_t)0);
+    EXPECT_GT(ctx.purpose_allocations[SVT_JXS_MEM_COEFFICIENTS], (size_t)0);
+    EXPECT_GT(ctx.purpose_allocations[SVT_JXS_MEM_SCRATCH], (size_t)0);
+    svt_jpeg_xs_decoder_close(&decoder);
+    EXPECT_EQ(ctx.live_allocations, (size_t)0);
+    EXPECT_EQ(ctx.bytes_current, (size_t)0);
+
+    size_t footprint = 0;
+    decoder.allocator = NULL;
+    ASSERT_EQ(svt_jpeg_xs_decoder_get_memory_footprint(SVT_JPEGXS_API_VER_MAJOR,
+                                                       SVT_JPEGXS_API_VER_MINOR,
+                                                       &decoder,
+                                                       Frame_Sample_1_16x16_8bit_422_bitstream,
+                                                       Frame_Sample_1_16x16_8bit_422_bitstream_size,
+                                                       &footprint),
+              SvtJxsErrorNone);
+    EXPECT_EQ(footprint, ctx.bytes_peak);
+}
+
+TEST(Allocator, IncompleteCallbacksReturnsError) {
+    TestAllocatorCtx ctx;
+    svt_jpeg_xs_allocator_t allocator;
+    test_allocator_init(&allocator, &ctx);
+    allocator.free = NULL;
+
+    svt_jpeg_xs_encoder_api_t encoder;
+    encoder_test_config(&encoder);
+    encoder.allocator = &allocator;
+    ASSERT_EQ(svt_jpeg_xs_encoder_init(SVT_JPEGXS_API_VER_MAJOR, SVT_JPEGXS_API_VER_MINOR, &encoder), SvtJxsErrorBadParameter);
+    EXPECT_EQ(encoder.private_ptr, nullptr);
+    EXPECT_EQ(ctx.live_allocations, (size_t)0);
+}
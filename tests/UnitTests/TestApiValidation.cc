@@ -84,6 +84,114 @@ TEST(FramePoolAlloc, NullConfigZeroBitstreamReturnsNull) {
     ASSERT_EQ(pool, nullptr);
 }
 
+static void frame_pool_test_config(svt_jpeg_xs_image_config_t* config) {
+    memset(config, 0, sizeof(*config));
+    config->width = 30;
+    config->height = 16;
+    config->bit_depth = 10;
+    config->format = COLOUR_FORMAT_PLANAR_YUV422;
+    config->components_num = 3;
+    config->components[0].width = 30;
+    config->components[1].width = config->components[2].width = 15;
+    for (int c = 0; c < 3; c++) {
+        config->components[c].height = 16;
+        config->components[c].byte_size = config->components[c].width * 16 * 2;
+    }
+}
+
+static void frame_pool_test_buffers(svt_jpeg_xs_frame_pool_t* pool, const svt_jpeg_xs_image_config_t* config, uint32_t count,
+                                    uintptr_t alignment) {
+    svt_jpeg_xs_frame_t frames[4];
+    ASSERT_LE(count, 4u);
+    for (uint32_t i = 0; i < count; i++) {
+        ASSERT_EQ(svt_jpeg_xs_frame_pool_get(pool, &frames[i], 0), SvtJxsErrorNone);
+        for (int c = 0; c < config->components_num; c++) {
+            ASSERT_NE(frames[i].image.data_yuv[c], nullptr);
+            ASSERT_EQ((uintptr_t)frames[i].image.data_yuv[c] % alignment, 0u);
+            ASSERT_EQ(frames[i].image.alloc_size[c], config->components[c].byte_size);
+            ASSERT_EQ(frames[i].image.stride[c], config->components[c].width);
+            memset(frames[i].image.data_yuv[c], (int)i, frames[i].image.alloc_size[c]);
+        }
+        ASSERT_EQ((uintptr_t)frames[i].bitstream.buffer % alignment, 0u);
+        memset(frames[i].bitstream.buffer, 0xff, frames[i].bitstream.allocation_size);
+    }
+    svt_jpeg_xs_frame_t frame_empty;
+    ASSERT_EQ(svt_jpeg_xs_frame_pool_get(pool, &frame_empty, 0), SvtJxsErrorNoErrorEmptyQueue);
+    /*Buffers of frames can not overlap*/
+    for (uint32_t i = 0; i < count; i++) {
+        for (int c = 0; c < config->components_num; c++) {
+            const uint8_t* data = (const uint8_t*)frames[i].image.data_yuv[c];
+            for (uint32_t b = 0; b < frames[i].image.alloc_size[c]; b++) {
+                ASSERT_EQ(data[b], i);
+            }
+        }
+        frames[i].image.ready_to_release = 1;
+        frames[i].bitstream.ready_to_release = 1;
+        svt_jpeg_xs_frame_pool_release(pool, &frames[i]);
+    }
+}
+
+TEST(FramePoolAlloc, DefaultAlignment) {
+    svt_jpeg_xs_image_config_t config;
+    frame_pool_test_config(&config);
+    svt_jpeg_xs_frame_pool_t* pool = svt_jpeg_xs_frame_pool_alloc(&config, 1000, 3);
+    ASSERT_NE(pool, nullptr);
+    frame_pool_test_buffers(pool, &config, 3, 64);
+    svt_jpeg_xs_frame_pool_free(pool);
+}
+
+TEST(FramePoolAlloc, PageAlignmentHugepages) {
+    svt_jpeg_xs_image_config_t config;
+    frame_pool_test_config(&config);
+    svt_jpeg_xs_frame_pool_config_t pool_config;
+    memset(&pool_config, 0, sizeof(pool_config));
+    pool_config.alignment = 4096;
+    pool_config.hugepages = SVT_JXS_HUGEPAGES_EXPLICIT;
+    svt_jpeg_xs_frame_pool_t* pool = svt_jpeg_xs_frame_pool_alloc_ex(&config, 1000, 4, &pool_config);
+    ASSERT_NE(pool, nullptr);
+    frame_pool_test_buffers(pool, &config, 4, 4096);
+    svt_jpeg_xs_frame_pool_free(pool);
+}
+
+TEST(FramePoolAlloc, InvalidAlignmentReturnsNull) {
+    svt_jpeg_xs_image_config_t config;
+    frame_pool_test_config(&config);
+    svt_jpeg_xs_frame_pool_config_t pool_config;
+    memset(&pool_config, 0, sizeof(pool_config));
+    pool_config.alignment = 96;
+    ASSERT_EQ(svt_jpeg_xs_frame_pool_alloc_ex(&config, 1000, 2, &pool_config), nullptr);
+}
+
+TEST(FramePoolAlloc, CallerOwnedMemory) {
+    svt_jpeg_xs_image_config_t config;
+    frame_pool_test_config(&config);
+    size_t memory_size = 0;
+    ASSERT_EQ(svt_jpeg_xs_frame_pool_get_memory_size(&config, 1000, 2, 256, &memory_size), SvtJxsErrorNone);
+    ASSERT_GE(memory_size, 2 * (size_t)(30 * 16 * 2 + 15 * 16 * 2 * 2 + 1000));
+    uint8_t* memory = (uint8_t*)malloc(memory_size + 1);
+
+    svt_jpeg_xs_frame_pool_config_t pool_config;
+    memset(&pool_config, 0, sizeof(pool_config));
+    pool_config.alignment = 256;
+    pool_config.memory = memory + 1; /*Unaligned region*/
+    pool_config.memory_size = memory_size - 1;
+    ASSERT_EQ(svt_jpeg_xs_frame_pool_alloc_ex(&config, 1000, 2, &pool_config), nullptr);
+
+    pool_config.memory_size = memory_size;
+    svt_jpeg_xs_frame_pool_t* pool = svt_jpeg_xs_frame_pool_alloc_ex(&config, 1000, 2, &pool_config);
+    ASSERT_NE(pool, nullptr);
+    svt_jpeg_xs_frame_t frame;
+    ASSERT_EQ(svt_jpeg_xs_frame_pool_get(pool, &frame, 0), SvtJxsErrorNone);
+    ASSERT_GE((uint8_t*)frame.image.data_yuv[0], memory + 1);
+    ASSERT_LE(frame.bitstream.buffer + frame.bitstream.allocation_size, memory + 1 + memory_size);
+    frame.image.ready_to_release = 1;
+    frame.bitstream.ready_to_release = 1;
+    svt_jpeg_xs_frame_pool_release(pool, &frame);
+    frame_pool_test_buffers(pool, &config, 2, 256);
+    svt_jpeg_xs_frame_pool_free(pool);
+    free(memory);
+}
+
 /*
  * Tests for decoder init validation and cleanup
  */
@@ -0,0 +1,76 @@
+/*
+* Copyright(c) 2024 Intel Corporation
+* SPDX - License - Identifier: BSD - 2 - Clause - Patent
+*/
+
+#include "gtest/gtest.h"
+#include "Threads/SvtArena.h"
+
+TEST(Arena, AlignedZeroedBuffers) {
+    SvtArena_t arena;
+    svt_jxs_arena_ctor(&arena, 4096, SVT_JXS_MEM_SCRATCH);
+    uint8_t* prev_end = NULL;
+    for (size_t size = 1; size < 300; size += 37) {
+        uint8_t* ptr = (uint8_t*)svt_jxs_arena_alloc(&arena, size);
+        ASSERT_NE(ptr, nullptr);
+        ASSERT_EQ((uintptr_t)ptr % ALVALUE, 0u);
+        if (prev_end) {
+            ASSERT_GE(ptr, prev_end);
+        }
+        for (size_t i = 0; i < size; i++) {
+            ASSERT_EQ(ptr[i], 0);
+        }
+        memset(ptr, 0xff, size);
+        prev_end = ptr + size;
+    }
+    ASSERT_EQ(arena.stats.blocks_num, 1u);
+    ASSERT_EQ(arena.stats.allocations_num, 9u);
+    svt_jxs_arena_dctor(&arena);
+    ASSERT_EQ(arena.blocks, nullptr);
+}
+
+TEST(Arena, GrowAndOversizedAllocation) {
+    SvtArena_t arena;
+    svt_jxs_arena_ctor(&arena, 1024, SVT_JXS_MEM_SCRATCH);
+    void* small = svt_jxs_arena_alloc(&arena, 1000);
+    ASSERT_NE(small, nullptr);
+    uint8_t* big = (uint8_t*)svt_jxs_arena_alloc(&arena, 100000);
+    ASSERT_NE(big, nullptr);
+    ASSERT_EQ((uintptr_t)big % ALVALUE, 0u);
+    memset(big, 1, 100000);
+    ASSERT_EQ(arena.stats.blocks_num, 2u);
+    ASSERT_GE(arena.stats.bytes_reserved, arena.stats.bytes_used);
+    ASSERT_GE(arena.stats.bytes_used, 101000u);
+    svt_jxs_arena_dctor(&arena);
+}
+
+TEST(Arena, ResetReusesBlocks) {
+    SvtArena_t arena;
+    svt_jxs_arena_ctor(&arena, 1024, SVT_JXS_MEM_SCRATCH);
+    uint8_t* first = (uint8_t*)svt_jxs_arena_alloc(&arena, 512);
+    ASSERT_NE(first, nullptr);
+    memset(first, 0xff, 512);
+    ASSERT_NE(svt_jxs_arena_alloc(&arena, 4096), nullptr);
+    ASSERT_EQ(arena.stats.blocks_num, 2u);
+    size_t bytes_reserved = arena.stats.bytes_reserved;
+
+    /*Blocks are kept and zeroed when they are big enough*/
+    svt_jxs_arena_reset(&arena, 2048);
+    ASSERT_EQ(arena.stats.blocks_num, 2u);
+    ASSERT_EQ(arena.stats.bytes_reserved, bytes_reserved);
+    ASSERT_EQ(arena.stats.bytes_used, 0u);
+    uint8_t* ptr = (uint8_t*)svt_jxs_arena_alloc(&arena, 3000);
+    ASSERT_NE(ptr, nullptr);
+    for (size_t i = 0; i < 3000; i++) {
+        ASSERT_EQ(ptr[i], 0);
+    }
+    ASSERT_EQ(arena.stats.blocks_num, 2u);
+
+    /*Reallocated as one block when bigger size is required*/
+    svt_jxs_arena_reset(&arena, 100000);
+    ASSERT_NE(svt_jxs_arena_alloc(&arena, 100000 - ALVALUE), nullptr);
+    ASSERT_NE(svt_jxs_arena_alloc(&arena, ALVALUE), nullptr);
+    ASSERT_EQ(arena.stats.blocks_num, 1u);
+    ASSERT_GE(arena.stats.bytes_reserved, 100000u);
+    svt_jxs_arena_dctor(&arena);
+}
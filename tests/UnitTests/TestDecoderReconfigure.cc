@@ -0,0 +1,136 @@
+/*
+* Copyright(c) 2024 Intel Corporation
+* SPDX - License - Identifier: BSD - 2 - Clause - Patent
+*/
+
+#include <string.h>
+#include <vector>
+
+#include "gtest/gtest.h"
+#include "SvtJpegxsImageBufferTools.h"
+#include "ApiTestUtils.h"
+
+/*
+ * Tests for decoder reconfiguration
+ */
+
+class DecoderReconfigure : public ::testing::TestWithParam<int> {};
+
+TEST_P(DecoderReconfigure, DecodeMatchesNewDecoder) {
+    /*Stream changes resolution, format and back, with and without ceiling of stream parameters*/
+    const uint32_t streams_width[] = {64, 96, 64};
+    const uint32_t streams_height[] = {64, 80, 64};
+    const ColourFormat_t streams_format[] = {COLOUR_FORMAT_PLANAR_YUV422, COLOUR_FORMAT_PLANAR_YUV444_OR_RGB,
+                                             COLOUR_FORMAT_PLANAR_YUV422};
+    const int ceiling = GetParam();
+
+    std::vector<uint8_t> codestreams[3];
+    uint32_t codestreams_size[3] = {0};
+    for (int i = 0; i < 3; i++) {
+        svt_jpeg_xs_encoder_api_t encoder;
+        encoder_test_config(&encoder);
+        encoder.source_width = streams_width[i];
+        encoder.source_height = streams_height[i];
+        encoder.colour_format = streams_format[i];
+        encode_test_frames(&encoder, 1, &codestreams[i]);
+        ASSERT_FALSE(codestreams[i].empty());
+        codestreams_size[i] = (uint32_t)codestreams[i].size();
+    }
+
+    TestAllocatorCtx ctx;
+    svt_jpeg_xs_allocator_t allocator;
+    test_allocator_init(&allocator, &ctx);
+
+    svt_jpeg_xs_decoder_api_t decoder;
+    decoder_test_config(&decoder);
+    decoder.allocator = &allocator;
+    decoder.slice_concealment = 1;
+    if (ceiling) {
+        decoder.max_width = 128;
+        decoder.max_height = 128;
+        decoder.max_components_num = 3;
+    }
+    svt_jpeg_xs_image_config_t image_config;
+    ASSERT_EQ(svt_jpeg_xs_decoder_init(SVT_JPEGXS_API_VER_MAJOR,
+                                       SVT_JPEGXS_API_VER_MINOR,
+                                       &decoder,
+                                       codestreams[0].data(),
+                                       codestreams_size[0],
+                                       &image_config),
+              SvtJxsErrorNone);
+
+    for (int i = 0; i < 3; i++) {
+        svt_jpeg_xs_image_config_t image_config_ref;
+        svt_jpeg_xs_image_buffer_t* image_ref = NULL;
+        ASSERT_EQ(decode_test_single_frame(codestreams[i].data(), codestreams_size[i], &image_ref, &image_config_ref),
+                  SvtJxsErrorNone);
+
+        /*Frame with new header is sent with buffer of current configuration*/
+        svt_jpeg_xs_image_buffer_t* image = svt_jpeg_xs_image_buffer_alloc(&image_config);
+        ASSERT_NE(image, nullptr);
+        SvtJxsErrorType_t ret = decode_test_frame(&decoder, codestreams[i].data(), codestreams_size[i], image);
+        if (i > 0) {
+            ASSERT_EQ(ret, SvtJxsErrorDecoderConfigChange);
+            TestAllocatorCtx ctx_before = ctx;
+            ASSERT_EQ(svt_jpeg_xs_decoder_reconfigure(&decoder, codestreams[i].data(), codestreams_size[i], &image_config),
+                      SvtJxsErrorNone);
+            if (ceiling) {
+                /*Buffers allocated for ceiling are reused*/
+                EXPECT_EQ(memcmp(ctx.purpose_allocations, ctx_before.purpose_allocations, sizeof(ctx.purpose_allocations)), 0);
+            }
+            svt_jpeg_xs_image_buffer_free(image);
+            image = svt_jpeg_xs_image_buffer_alloc(&image_config);
+            ASSERT_NE(image, nullptr);
+            ret = decode_test_frame(&decoder, codestreams[i].data(), codestreams_size[i], image);
+        }
+        ASSERT_EQ(ret, SvtJxsErrorNone);
+        ASSERT_EQ(image_config.width, image_config_ref.width);
+        ASSERT_EQ(image_config.height, image_config_ref.height);
+        ASSERT_EQ(image_config.format, image_config_ref.format);
+        decode_test_compare(&image_config, image, image_ref);
+        svt_jpeg_xs_image_buffer_free(image);
+        svt_jpeg_xs_image_buffer_free(image_ref);
+    }
+
+    svt_jpeg_xs_decoder_close(&decoder);
+    EXPECT_EQ(ctx.live_allocations, (size_t)0);
+}
+
+INSTANTIATE_TEST_SUITE_P(DecoderReconfigure, DecoderReconfigure, ::testing::Values(0, 1));
+
+TEST(DecoderReconfigureInit, FramesInDecoderReturnError) {
+    svt_jpeg_xs_encoder_api_t encoder;
+    encoder_test_config(&encoder);
+    std::vector<uint8_t> codestream;
+    encode_test_frames(&encoder, 1, &codestream);
+    ASSERT_FALSE(codestream.empty());
+    const uint32_t codestream_size = (uint32_t)codestream.size();
+
+    svt_jpeg_xs_decoder_api_t decoder;
+    decoder_test_config(&decoder);
+    svt_jpeg_xs_image_config_t image_config;
+    ASSERT_EQ(svt_jpeg_xs_decoder_init(
+                  SVT_JPEGXS_API_VER_MAJOR, SVT_JPEGXS_API_VER_MINOR, &decoder, codestream.data(), codestream_size, &image_config),
+              SvtJxsErrorNone);
+    EXPECT_EQ(svt_jpeg_xs_decoder_reconfigure(&decoder, NULL, codestream_size, &image_config), SvtJxsErrorDecoderInvalidPointer);
+    EXPECT_EQ(svt_jpeg_xs_decoder_reconfigure(NULL, codestream.data(), codestream_size, &image_config),
+              SvtJxsErrorDecoderInvalidPointer);
+
+    svt_jpeg_xs_image_buffer_t* image = svt_jpeg_xs_image_buffer_alloc(&image_config);
+    ASSERT_NE(image, nullptr);
+    svt_jpeg_xs_frame_t frame;
+    memset(&frame, 0, sizeof(frame));
+    frame.image = *image;
+    frame.bitstream.buffer = codestream.data();
+    frame.bitstream.used_size = codestream_size;
+    frame.bitstream.allocation_size = codestream_size;
+    ASSERT_EQ(svt_jpeg_xs_decoder_send_frame(&decoder, &frame, 1), SvtJxsErrorNone);
+    EXPECT_EQ(svt_jpeg_xs_decoder_reconfigure(&decoder, codestream.data(), codestream_size, &image_config),
+              SvtJxsErrorBadParameter);
+    ASSERT_EQ(svt_jpeg_xs_decoder_get_frame(&decoder, &frame, 1), SvtJxsErrorNone);
+    EXPECT_EQ(svt_jpeg_xs_decoder_reconfigure(&decoder, codestream.data(), codestream_size, &image_config), SvtJxsErrorNone);
+    ASSERT_EQ(decode_test_frame(&decoder, codestream.data(), codestream_size, image), SvtJxsErrorNone);
+
+    svt_jpeg_xs_decoder_close(&decoder);
+    svt_jpeg_xs_image_buffer_free(image);
+}
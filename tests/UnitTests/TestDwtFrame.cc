@@ -3,6 +3,7 @@
 * SPDX - License - Identifier: BSD - 2 - Clause - Patent
 */
 
+#include <vector>
 #include "gtest/gtest.h"
 #include "random.h"
 #include "Enc_avx512.h"
@@ -12,6 +13,7 @@
 #include "Pi.h"
 #include "encoder_dsp_rtcd.h"
 #include "Dwt.h"
+#include "Dwt_AVX2.h"
 #include "CodeDeprecated.h"
 #include "WeightTable.h"
 
@@ -395,6 +397,135 @@ INSTANTIATE_TEST_SUITE_P(FRAME_DWT, FRAME_DWT,
                          ::testing::Combine(::testing::Values(8, 10), ::testing::ValuesIn(params_block_sizes),
                                             ::testing::ValuesIn(format_params)));
 
+TEST(FRAME_DWT_16BIT, LINE_C_AVX2) {
+    svt_jxs_test_tool::SVTRandom rnd(32, false);
+    int16_t in_16bit[256];
+    int16_t out_16bit_c[256];
+    int16_t out_16bit_avx2[256];
+    int32_t in_32bit[256];
+    int32_t out_32bit[256];
+
+    for (uint32_t len = 2; len <= 200; ++len) {
+        for (uint32_t i = 0; i < len; ++i) {
+            /*Range of 14bit input, result is the same as 32bit DWT when fit in 16 bits*/
+            in_16bit[i] = (int16_t)((rnd.random() & 0x3FFF) - 0x2000);
+            in_32bit[i] = in_16bit[i];
+        }
+        dwt_horizontal_line_c(out_32bit, out_32bit + (len + 1) / 2, in_32bit, len);
+        dwt_horizontal_line_16bit_c(out_16bit_c, out_16bit_c + (len + 1) / 2, in_16bit, len);
+        for (uint32_t i = 0; i < len; ++i) {
+            ASSERT_EQ(out_32bit[i], out_16bit_c[i]) << "len " << len << " i " << i;
+        }
+        if (CPU_FLAGS_AVX2 & get_cpu_flags()) {
+            /*In-place, output LF on input*/
+            memcpy(out_16bit_avx2, in_16bit, len * sizeof(int16_t));
+            int16_t out_hf[128];
+            dwt_horizontal_line_16bit_avx2(out_16bit_avx2, out_hf, out_16bit_avx2, len);
+            memcpy(out_16bit_avx2 + (len + 1) / 2, out_hf, (len / 2) * sizeof(int16_t));
+            ASSERT_EQ(0, memcmp(out_16bit_c, out_16bit_avx2, len * sizeof(int16_t))) << "len " << len;
+        }
+    }
+}
+
+/*DWT V0 on 16bit lanes have to give the same coefficients as 32bit DWT in every supported configuration*/
+static void test_transform_V0_16bit(uint8_t input_bit_depth, uint32_t decomp_h, uint32_t width) {
+    pi_t pi;
+    pi_enc_t pi_enc;
+    uint32_t sx[MAX_COMPONENTS_NUM];
+    uint32_t sy[MAX_COMPONENTS_NUM];
+    uint32_t num_comp = 0;
+    format_get_sampling_factory(COLOUR_FORMAT_PLANAR_YUV444_OR_RGB, &num_comp, sx, sy, VERBOSE_NONE);
+    if (pi_compute(&pi, 0, num_comp, GROUP_SIZE, SIGNIFICANCE_GROUP_SIZE, width, 16, decomp_h, 0, 0, sx, sy, 0, 16) ||
+        weight_table_calculate(&pi, 0, COLOUR_FORMAT_PACKED_YUV444_OR_RGB) || pi_compute_encoder(&pi, &pi_enc, 1, 1, 0)) {
+        /*Not supported configuration*/
+        return;
+    }
+
+    picture_header_dynamic_t hdr;
+    memset(&hdr, 0, sizeof(hdr));
+    hdr.hdr_Bw = WAVELET_IN_DEPTH_BW_DEFAULT;
+    hdr.hdr_Fq = WAVELET_FRACTION_BITS_FQ_DEFAULT;
+    ASSERT_TRUE(dwt_16bit_supported(input_bit_depth, decomp_h, &hdr));
+
+    svt_jxs_test_tool::SVTRandom rnd(32, false);
+    const uint32_t out_size = pi_enc.coeff_buff_tmp_size_precinct[0];
+    std::vector<uint16_t> input(width);
+    std::vector<uint16_t> out_ref(out_size);
+    std::vector<uint16_t> out_test(out_size);
+    std::vector<int32_t> buffer_tmp(width * 3 / 2 + 1);
+    const uint32_t max_val = (1 << input_bit_depth) - 1;
+    transform_V0_ptr_t transform_V0_Hn = transform_V0_get_function_ptr(decomp_h);
+
+    /*Random, and extreme values with different periods to get maximum gain of all bands*/
+    for (uint32_t pattern = 0; pattern < 4; ++pattern) {
+        for (uint32_t x = 0; x < width; ++x) {
+            uint32_t val = (pattern == 0) ? rnd.random() : (((x >> (pattern - 1)) & 1) ? max_val : 0);
+            if (input_bit_depth <= 8) {
+                ((uint8_t*)input.data())[x] = (uint8_t)val;
+            }
+            else {
+                input[x] = (uint16_t)val;
+            }
+        }
+        transform_V0_Hn(&pi.components[0],
+                        &pi_enc.components[0],
+                        (const int32_t*)input.data(),
+                        input_bit_depth,
+                        &hdr,
+                        out_ref.data(),
+                        hdr.hdr_Fq,
+                        width,
+                        buffer_tmp.data());
+        transform_V0_Hx_16bit(&pi.components[0],
+                              &pi_enc.components[0],
+                              (const int32_t*)input.data(),
+                              input_bit_depth,
+                              &hdr,
+                              out_test.data(),
+                              hdr.hdr_Fq,
+                              width,
+                              buffer_tmp.data());
+        ASSERT_EQ(0, memcmp(out_ref.data(), out_test.data(), out_size * sizeof(uint16_t)))
+            << "bits " << (int)input_bit_depth << " H " << decomp_h << " width " << width << " pattern " << pattern;
+    }
+}
+
+static void test_transform_V0_16bit_all(CPU_FLAGS flags) {
+    setup_encoder_rtcd_internal(flags);
+    const uint8_t bit_depths[] = {8, 8, 10};
+    const uint32_t decomps_h[] = {1, 2, 1};
+    for (uint32_t i = 0; i < sizeof(bit_depths) / sizeof(bit_depths[0]); ++i) {
+        for (uint32_t width = 2; width <= 70; ++width) {
+            test_transform_V0_16bit(bit_depths[i], decomps_h[i], width);
+        }
+        test_transform_V0_16bit(bit_depths[i], decomps_h[i], 1920);
+        test_transform_V0_16bit(bit_depths[i], decomps_h[i], 1921);
+    }
+}
+
+TEST(FRAME_DWT_16BIT, TRANSFORM_V0_C) {
+    test_transform_V0_16bit_all(0);
+}
+
+TEST(FRAME_DWT_16BIT, TRANSFORM_V0_AVX2) {
+    test_transform_V0_16bit_all(CPU_FLAGS_AVX2);
+}
+
+TEST(FRAME_DWT_16BIT, SUPPORTED) {
+    picture_header_dynamic_t hdr;
+    memset(&hdr, 0, sizeof(hdr));
+    hdr.hdr_Bw = WAVELET_IN_DEPTH_BW_DEFAULT;
+    hdr.hdr_Fq = WAVELET_FRACTION_BITS_FQ_DEFAULT;
+    EXPECT_TRUE(dwt_16bit_supported(8, 2, &hdr));
+    EXPECT_TRUE(dwt_16bit_supported(10, 1, &hdr));
+    EXPECT_FALSE(dwt_16bit_supported(8, 3, &hdr));
+    EXPECT_FALSE(dwt_16bit_supported(10, 2, &hdr));
+    EXPECT_FALSE(dwt_16bit_supported(12, 1, &hdr));
+    EXPECT_FALSE(dwt_16bit_supported(0, 1, &hdr));
+    hdr.hdr_Tnlt = 1;
+    EXPECT_FALSE(dwt_16bit_supported(8, 1, &hdr));
+}
+
 static int32_t* convert_input_buffer_alloc(const int32_t* plane_buffer_in, uint8_t param_Bw, uint32_t width, uint32_t height,
                                            uint32_t stride, uint32_t input_bit_depth) {
     int32_t* buffers_input_unpack = (int32_t*)malloc(width * height * sizeof(int32_t));
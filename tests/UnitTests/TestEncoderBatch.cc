@@ -0,0 +1,201 @@
+/*
+* Copyright(c) 2024 Intel Corporation
+* SPDX - License - Identifier: BSD - 2 - Clause - Patent
+*/
+
+#include <string.h>
+#include <vector>
+
+#include "gtest/gtest.h"
+#include "SvtJpegxsImageBufferTools.h"
+#include "ApiTestUtils.h"
+
+/*
+ * Tests for encoder batch sharing slice threads between many streams
+ */
+
+/*Configuration of stream in batch, streams differ in rate, rate control and slices*/
+static void batch_test_config(svt_jpeg_xs_encoder_api_t* encoder, uint32_t stream_idx) {
+    encoder_test_config(encoder);
+    encoder->threads_num = 1;
+    encoder->bpp_numerator = 3 + stream_idx % 3;
+    encoder->rate_control_mode = stream_idx % 4;
+    encoder->slice_height = 16 << (stream_idx % 2);
+    if (stream_idx % 4 == 3) {
+        /*One slice without vertical decomposition, split to parts on threads of batch*/
+        encoder->ndecomp_v = 0;
+        encoder->slice_height = 64;
+    }
+}
+
+/*Streams encoded on shared threads of batch have to give the same codestream as encoded by own encoder*/
+TEST(EncoderBatch, StreamsMatchOwnEncoder) {
+    const uint32_t streams_num = 6;
+    const uint32_t frames_num = 3;
+    std::vector<uint8_t> codestream_ref[streams_num];
+    std::vector<uint8_t> codestream[streams_num];
+    svt_jpeg_xs_image_config_t image_config[streams_num];
+    uint32_t bytes_per_frame[streams_num];
+    svt_jpeg_xs_frame_pool_t* pool[streams_num];
+
+    for (uint32_t s = 0; s < streams_num; s++) {
+        svt_jpeg_xs_encoder_api_t encoder;
+        batch_test_config(&encoder, s);
+        ASSERT_EQ(svt_jpeg_xs_encoder_get_image_config(
+                      SVT_JPEGXS_API_VER_MAJOR, SVT_JPEGXS_API_VER_MINOR, &encoder, &image_config[s], &bytes_per_frame[s]),
+                  SvtJxsErrorNone);
+        pool[s] = svt_jpeg_xs_frame_pool_alloc(&image_config[s], bytes_per_frame[s], frames_num);
+        ASSERT_NE(pool[s], nullptr);
+        encode_test_frames(&encoder, frames_num, &codestream_ref[s], s);
+    }
+
+    svt_jpeg_xs_encoder_batch_t batch;
+    batch.threads_num = 3;
+    ASSERT_EQ(svt_jpeg_xs_encoder_batch_init(SVT_JPEGXS_API_VER_MAJOR, SVT_JPEGXS_API_VER_MINOR, &batch), SvtJxsErrorNone);
+    svt_jpeg_xs_encoder_api_t encoders[streams_num];
+    for (uint32_t s = 0; s < streams_num; s++) {
+        batch_test_config(&encoders[s], s);
+        ASSERT_EQ(
+            svt_jpeg_xs_encoder_batch_init_encoder(SVT_JPEGXS_API_VER_MAJOR, SVT_JPEGXS_API_VER_MINOR, &batch, &encoders[s]),
+            SvtJxsErrorNone);
+    }
+    for (uint32_t i = 0; i < frames_num; i++) {
+        svt_jpeg_xs_frame_t frames[streams_num];
+        for (uint32_t s = 0; s < streams_num; s++) {
+            ASSERT_EQ(svt_jpeg_xs_frame_pool_get(pool[s], &frames[s], 1), SvtJxsErrorNone);
+            encode_test_fill_frame(&frames[s], image_config[s].components_num, i, s);
+        }
+        for (uint32_t s = 0; s < streams_num; s++) {
+            ASSERT_EQ(svt_jpeg_xs_encoder_send_picture(&encoders[s], &frames[s], 1), SvtJxsErrorNone);
+        }
+    }
+    for (uint32_t i = 0; i < frames_num; i++) {
+        for (uint32_t s = 0; s < streams_num; s++) {
+            encode_test_receive_frames(&encoders[s], pool[s], 1, &codestream[s]);
+        }
+    }
+    for (uint32_t s = 0; s < streams_num; s++) {
+        svt_jpeg_xs_encoder_close(&encoders[s]);
+        EXPECT_TRUE(codestream[s] == codestream_ref[s]) << "stream " << s;
+        svt_jpeg_xs_frame_pool_free(pool[s]);
+    }
+    EXPECT_EQ(svt_jpeg_xs_encoder_batch_close(&batch), SvtJxsErrorNone);
+    EXPECT_EQ(batch.private_ptr, nullptr);
+}
+
+static void batch_test_big_config(svt_jpeg_xs_encoder_api_t* encoder) {
+    batch_test_config(encoder, 0);
+    encoder->source_width = 1920;
+    encoder->source_height = 1080;
+    /*One long slice per frame keeps thread of batch busy*/
+    encoder->slice_height = 1080;
+}
+
+/*Closing encoder with slices still queued in batch does not disturb other encoders of batch*/
+TEST(EncoderBatch, CloseEncoderWithQueuedSlices) {
+    const uint32_t frames_num = 3;
+    svt_jpeg_xs_encoder_api_t encoder;
+    batch_test_big_config(&encoder);
+    svt_jpeg_xs_image_config_t image_config;
+    uint32_t bytes_per_frame = 0;
+    ASSERT_EQ(svt_jpeg_xs_encoder_get_image_config(
+                  SVT_JPEGXS_API_VER_MAJOR, SVT_JPEGXS_API_VER_MINOR, &encoder, &image_config, &bytes_per_frame),
+              SvtJxsErrorNone);
+    svt_jpeg_xs_frame_pool_t* pool = svt_jpeg_xs_frame_pool_alloc(&image_config, bytes_per_frame, frames_num);
+    ASSERT_NE(pool, nullptr);
+    std::vector<uint8_t> codestream_ref;
+    encode_test_frames(&encoder, frames_num, &codestream_ref);
+
+    svt_jpeg_xs_encoder_batch_t batch;
+    batch.threads_num = 1;
+    ASSERT_EQ(svt_jpeg_xs_encoder_batch_init(SVT_JPEGXS_API_VER_MAJOR, SVT_JPEGXS_API_VER_MINOR, &batch), SvtJxsErrorNone);
+    batch_test_big_config(&encoder);
+    ASSERT_EQ(svt_jpeg_xs_encoder_batch_init_encoder(SVT_JPEGXS_API_VER_MAJOR, SVT_JPEGXS_API_VER_MINOR, &batch, &encoder),
+              SvtJxsErrorNone);
+    svt_jpeg_xs_encoder_api_t encoder_closed;
+    batch_test_config(&encoder_closed, 1);
+    ASSERT_EQ(
+        svt_jpeg_xs_encoder_batch_init_encoder(SVT_JPEGXS_API_VER_MAJOR, SVT_JPEGXS_API_VER_MINOR, &batch, &encoder_closed),
+        SvtJxsErrorNone);
+    svt_jpeg_xs_image_config_t image_config_closed;
+    ASSERT_EQ(svt_jpeg_xs_encoder_get_image_config(
+                  SVT_JPEGXS_API_VER_MAJOR, SVT_JPEGXS_API_VER_MINOR, &encoder_closed, &image_config_closed, &bytes_per_frame),
+              SvtJxsErrorNone);
+    svt_jpeg_xs_frame_pool_t* pool_closed = svt_jpeg_xs_frame_pool_alloc(&image_config_closed, bytes_per_frame, frames_num);
+    ASSERT_NE(pool_closed, nullptr);
+
+    /*Encoder is closed while its slices may still wait behind big frames on single thread of batch*/
+    encode_test_send_frames(&encoder, pool, image_config.components_num, 0, frames_num);
+    encode_test_send_frames(&encoder_closed, pool_closed, image_config_closed.components_num, 1, frames_num);
+    svt_jpeg_xs_encoder_close(&encoder_closed);
+    svt_jpeg_xs_frame_pool_free(pool_closed);
+
+    std::vector<uint8_t> codestream;
+    encode_test_receive_frames(&encoder, pool, frames_num, &codestream);
+    svt_jpeg_xs_encoder_close(&encoder);
+    svt_jpeg_xs_frame_pool_free(pool);
+    EXPECT_TRUE(codestream == codestream_ref);
+    EXPECT_EQ(svt_jpeg_xs_encoder_batch_close(&batch), SvtJxsErrorNone);
+}
+
+/*Encoder of batch closed without getting packets, slices wait for pack outputs never taken by final stage*/
+TEST(EncoderBatch, CloseEncoderNotDrained) {
+    const uint32_t frames_num = 11;
+    svt_jpeg_xs_encoder_batch_t batch;
+    batch.threads_num = 1;
+    ASSERT_EQ(svt_jpeg_xs_encoder_batch_init(SVT_JPEGXS_API_VER_MAJOR, SVT_JPEGXS_API_VER_MINOR, &batch), SvtJxsErrorNone);
+    svt_jpeg_xs_encoder_api_t encoder;
+    encoder_test_config(&encoder);
+    encoder.source_width = 256;
+    encoder.source_height = 256;
+    encoder.slice_height = 16;
+    encoder.slice_packetization_mode = 1;
+    ASSERT_EQ(svt_jpeg_xs_encoder_batch_init_encoder(SVT_JPEGXS_API_VER_MAJOR, SVT_JPEGXS_API_VER_MINOR, &batch, &encoder),
+              SvtJxsErrorNone);
+    svt_jpeg_xs_image_config_t image_config;
+    uint32_t bytes_per_frame = 0;
+    ASSERT_EQ(svt_jpeg_xs_encoder_get_image_config(
+                  SVT_JPEGXS_API_VER_MAJOR, SVT_JPEGXS_API_VER_MINOR, &encoder, &image_config, &bytes_per_frame),
+              SvtJxsErrorNone);
+    svt_jpeg_xs_frame_pool_t* pool = svt_jpeg_xs_frame_pool_alloc(&image_config, bytes_per_frame, frames_num);
+    ASSERT_NE(pool, nullptr);
+    encode_test_send_frames(&encoder, pool, image_config.components_num, 0, frames_num, 0);
+    svt_jpeg_xs_encoder_close(&encoder);
+    svt_jpeg_xs_frame_pool_free(pool);
+    EXPECT_EQ(svt_jpeg_xs_encoder_batch_close(&batch), SvtJxsErrorNone);
+    EXPECT_EQ(batch.private_ptr, nullptr);
+}
+
+TEST(EncoderBatch, InvalidParametersReturnError) {
+    svt_jpeg_xs_encoder_batch_t batch;
+    batch.threads_num = 0;
+    ASSERT_EQ(svt_jpeg_xs_encoder_batch_init(SVT_JPEGXS_API_VER_MAJOR, SVT_JPEGXS_API_VER_MINOR, nullptr),
+              SvtJxsErrorBadParameter);
+    ASSERT_EQ(svt_jpeg_xs_encoder_batch_init(SVT_JPEGXS_API_VER_MAJOR, SVT_JPEGXS_API_VER_MINOR, &batch), SvtJxsErrorNone);
+
+    svt_jpeg_xs_encoder_api_t encoder;
+    encoder_test_config(&encoder);
+    encoder.cpu_profile = 1;
+    EXPECT_EQ(svt_jpeg_xs_encoder_batch_init_encoder(SVT_JPEGXS_API_VER_MAJOR, SVT_JPEGXS_API_VER_MINOR, &batch, &encoder),
+              SvtJxsErrorBadParameter);
+    EXPECT_EQ(encoder.private_ptr, nullptr);
+
+    /*Batch is not closed while used by encoder, encoder can be closed with frames in progress*/
+    encoder_test_config(&encoder);
+    ASSERT_EQ(svt_jpeg_xs_encoder_batch_init_encoder(SVT_JPEGXS_API_VER_MAJOR, SVT_JPEGXS_API_VER_MINOR, &batch, &encoder),
+              SvtJxsErrorNone);
+    EXPECT_EQ(svt_jpeg_xs_encoder_batch_close(&batch), SvtJxsErrorBadParameter);
+    EXPECT_NE(batch.private_ptr, nullptr);
+    svt_jpeg_xs_image_config_t image_config;
+    uint32_t bytes_per_frame = 0;
+    ASSERT_EQ(svt_jpeg_xs_encoder_get_image_config(
+                  SVT_JPEGXS_API_VER_MAJOR, SVT_JPEGXS_API_VER_MINOR, &encoder, &image_config, &bytes_per_frame),
+              SvtJxsErrorNone);
+    svt_jpeg_xs_frame_pool_t* pool = svt_jpeg_xs_frame_pool_alloc(&image_config, bytes_per_frame, 2);
+    ASSERT_NE(pool, nullptr);
+    encode_test_send_frames(&encoder, pool, image_config.components_num, 0, 2);
+    svt_jpeg_xs_encoder_close(&encoder);
+    svt_jpeg_xs_frame_pool_free(pool);
+    EXPECT_EQ(svt_jpeg_xs_encoder_batch_close(&batch), SvtJxsErrorNone);
+    EXPECT_EQ(batch.private_ptr, nullptr);
+}
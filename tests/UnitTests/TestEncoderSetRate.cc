@@ -0,0 +1,104 @@
+/*
+* Copyright(c) 2024 Intel Corporation
+* SPDX - License - Identifier: BSD - 2 - Clause - Patent
+*/
+
+#include <string.h>
+
+#include "gtest/gtest.h"
+#include "SvtJpegxsImageBufferTools.h"
+#include "ApiTestUtils.h"
+
+/*
+ * Tests for encoder rate change without init
+ */
+
+class EncoderSetRate : public ::testing::TestWithParam<uint32_t> {};
+
+/*Encode the same frame by encoder initialized with bpp and set_rate changed, output have to be the same*/
+TEST_P(EncoderSetRate, FrameMatchesNewEncoder) {
+    const uint32_t rate_control_mode = GetParam();
+    svt_jpeg_xs_encoder_api_t encoder;
+    encoder_test_config(&encoder);
+    encoder.rate_control_mode = rate_control_mode;
+    encoder.bpp_numerator = 4;
+    svt_jpeg_xs_encoder_api_t encoder_ref = encoder;
+    encoder_ref.bpp_numerator = 3;
+
+    svt_jpeg_xs_image_config_t image_config;
+    uint32_t bytes_per_frame = 0;
+    uint32_t bytes_per_frame_ref = 0;
+    ASSERT_EQ(svt_jpeg_xs_encoder_get_image_config(
+                  SVT_JPEGXS_API_VER_MAJOR, SVT_JPEGXS_API_VER_MINOR, &encoder, &image_config, &bytes_per_frame),
+              SvtJxsErrorNone);
+    ASSERT_EQ(svt_jpeg_xs_encoder_get_image_config(
+                  SVT_JPEGXS_API_VER_MAJOR, SVT_JPEGXS_API_VER_MINOR, &encoder_ref, &image_config, &bytes_per_frame_ref),
+              SvtJxsErrorNone);
+    ASSERT_EQ(svt_jpeg_xs_encoder_init(SVT_JPEGXS_API_VER_MAJOR, SVT_JPEGXS_API_VER_MINOR, &encoder), SvtJxsErrorNone);
+    ASSERT_EQ(svt_jpeg_xs_encoder_init(SVT_JPEGXS_API_VER_MAJOR, SVT_JPEGXS_API_VER_MINOR, &encoder_ref), SvtJxsErrorNone);
+    svt_jpeg_xs_frame_pool_t* pool = svt_jpeg_xs_frame_pool_alloc(&image_config, bytes_per_frame, 3);
+    ASSERT_NE(pool, nullptr);
+
+    svt_jpeg_xs_frame_t frames[3];
+    for (int i = 0; i < 3; i++) {
+        ASSERT_EQ(svt_jpeg_xs_frame_pool_get(pool, &frames[i], 1), SvtJxsErrorNone);
+        encode_test_fill_frame(&frames[i], image_config.components_num, 0, 0);
+    }
+
+    /*Rate is changed when first frame is still in encoder*/
+    ASSERT_EQ(svt_jpeg_xs_encoder_send_picture(&encoder, &frames[0], 1), SvtJxsErrorNone);
+    ASSERT_EQ(svt_jpeg_xs_encoder_set_rate(&encoder, 3, 1, rate_control_mode), SvtJxsErrorNone);
+    ASSERT_EQ(svt_jpeg_xs_encoder_send_picture(&encoder, &frames[1], 1), SvtJxsErrorNone);
+    ASSERT_EQ(svt_jpeg_xs_encoder_send_picture(&encoder_ref, &frames[2], 1), SvtJxsErrorNone);
+    for (int i = 0; i < 2; i++) {
+        ASSERT_EQ(svt_jpeg_xs_encoder_get_packet(&encoder, &frames[i], 1), SvtJxsErrorNone);
+    }
+    ASSERT_EQ(svt_jpeg_xs_encoder_get_packet(&encoder_ref, &frames[2], 1), SvtJxsErrorNone);
+
+    EXPECT_EQ(frames[0].bitstream.used_size, bytes_per_frame);
+    EXPECT_EQ(frames[1].bitstream.used_size, bytes_per_frame_ref);
+    ASSERT_EQ(frames[1].bitstream.used_size, frames[2].bitstream.used_size);
+    EXPECT_EQ(memcmp(frames[1].bitstream.buffer, frames[2].bitstream.buffer, frames[2].bitstream.used_size), 0);
+
+    for (int i = 0; i < 3; i++) {
+        svt_jpeg_xs_frame_pool_release(pool, &frames[i]);
+    }
+    svt_jpeg_xs_encoder_close(&encoder);
+    svt_jpeg_xs_encoder_close(&encoder_ref);
+    svt_jpeg_xs_frame_pool_free(pool);
+}
+
+INSTANTIATE_TEST_SUITE_P(EncoderSetRate, EncoderSetRate, ::testing::Values(0u, 1u, 2u, 3u));
+
+TEST(EncoderSetRateInit, InvalidParametersReturnError) {
+    svt_jpeg_xs_encoder_api_t encoder;
+    encoder_test_config(&encoder);
+    EXPECT_EQ(svt_jpeg_xs_encoder_set_rate(NULL, 2, 1, 0), SvtJxsErrorBadParameter);
+    EXPECT_EQ(svt_jpeg_xs_encoder_set_rate(&encoder, 2, 1, 0), SvtJxsErrorBadParameter);
+    ASSERT_EQ(svt_jpeg_xs_encoder_init(SVT_JPEGXS_API_VER_MAJOR, SVT_JPEGXS_API_VER_MINOR, &encoder), SvtJxsErrorNone);
+
+    EXPECT_EQ(svt_jpeg_xs_encoder_set_rate(&encoder, 0, 1, 0), SvtJxsErrorBadParameter);
+    EXPECT_EQ(svt_jpeg_xs_encoder_set_rate(&encoder, 2, 0, 0), SvtJxsErrorBadParameter);
+    EXPECT_EQ(svt_jpeg_xs_encoder_set_rate(&encoder, 1, 1000, 0), SvtJxsErrorBadParameter);
+    EXPECT_EQ(svt_jpeg_xs_encoder_set_rate(&encoder, 2, 1, 4), SvtJxsErrorBadParameter);
+    /*Budget per slice require other pack buffers than budget per precinct*/
+    EXPECT_EQ(svt_jpeg_xs_encoder_set_rate(&encoder, 2, 1, 2), SvtJxsErrorBadParameter);
+    EXPECT_EQ(svt_jpeg_xs_encoder_set_rate(&encoder, 2, 1, 1), SvtJxsErrorNone);
+
+    /*Bitstream buffer smaller than new rate*/
+    svt_jpeg_xs_image_config_t image_config;
+    uint32_t bytes_per_frame = 0;
+    ASSERT_EQ(svt_jpeg_xs_encoder_get_image_config(
+                  SVT_JPEGXS_API_VER_MAJOR, SVT_JPEGXS_API_VER_MINOR, &encoder, &image_config, &bytes_per_frame),
+              SvtJxsErrorNone);
+    svt_jpeg_xs_frame_pool_t* pool = svt_jpeg_xs_frame_pool_alloc(&image_config, bytes_per_frame, 1);
+    ASSERT_NE(pool, nullptr);
+    svt_jpeg_xs_frame_t frame;
+    ASSERT_EQ(svt_jpeg_xs_frame_pool_get(pool, &frame, 1), SvtJxsErrorNone);
+    ASSERT_EQ(svt_jpeg_xs_encoder_set_rate(&encoder, 4, 1, 0), SvtJxsErrorNone);
+    EXPECT_EQ(svt_jpeg_xs_encoder_send_picture(&encoder, &frame, 1), SvtJxsErrorBadParameter);
+
+    svt_jpeg_xs_frame_pool_release(pool, &frame);
+    svt_jpeg_xs_encoder_close(&encoder);
+    svt_jpeg_xs_frame_pool_free(pool);
+}
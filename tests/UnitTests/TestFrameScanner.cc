@@ -0,0 +1,167 @@
+/*
+* Copyright(c) 2024 Intel Corporation
+* SPDX - License - Identifier: BSD - 2 - Clause - Patent
+*/
+
+#include <string.h>
+#include <vector>
+
+#include "gtest/gtest.h"
+#include "SvtJpegxsImageBufferTools.h"
+#include "ApiTestUtils.h"
+#include "SampleFramesData.h"
+
+/*
+ * Tests for incremental frame scanner
+ */
+
+TEST(FrameScanner, NullPointersReturnError) {
+    svt_jpeg_xs_frame_scanner_t scanner;
+    svt_jpeg_xs_frame_index_t index;
+    size_t bytes_used = 0;
+    EXPECT_EQ(svt_jpeg_xs_frame_scanner_init(NULL), SvtJxsErrorDecoderInvalidPointer);
+    ASSERT_EQ(svt_jpeg_xs_frame_scanner_init(&scanner), SvtJxsErrorNone);
+    EXPECT_EQ(svt_jpeg_xs_frame_scanner_feed(&scanner, NULL, 1, &bytes_used, &index), SvtJxsErrorDecoderInvalidPointer);
+    EXPECT_EQ(svt_jpeg_xs_frame_scanner_feed(
+                  &scanner, Frame_Sample_1_16x16_8bit_422_bitstream, Frame_Sample_1_16x16_8bit_422_bitstream_size, NULL, &index),
+              SvtJxsErrorDecoderInvalidPointer);
+    svt_jpeg_xs_frame_scanner_close(&scanner);
+    svt_jpeg_xs_frame_scanner_close(&scanner);
+}
+
+TEST(FrameScanner, SampleFrameMatchesFrameSize) {
+    uint32_t frame_size = 0;
+    ASSERT_EQ(svt_jpeg_xs_decoder_get_single_frame_size(
+                  Frame_Sample_1_16x16_8bit_422_bitstream, Frame_Sample_1_16x16_8bit_422_bitstream_size, NULL, &frame_size, 0),
+              SvtJxsErrorNone);
+
+    svt_jpeg_xs_frame_scanner_t scanner;
+    ASSERT_EQ(svt_jpeg_xs_frame_scanner_init(&scanner), SvtJxsErrorNone);
+    svt_jpeg_xs_frame_index_t index;
+    size_t bytes_used = 0;
+    ASSERT_EQ(svt_jpeg_xs_frame_scanner_feed(
+                  &scanner, Frame_Sample_1_16x16_8bit_422_bitstream, Frame_Sample_1_16x16_8bit_422_bitstream_size, &bytes_used, &index),
+              SvtJxsErrorNone);
+    EXPECT_EQ(bytes_used, (size_t)frame_size);
+    EXPECT_EQ(index.frame_size, frame_size);
+    ASSERT_EQ(index.slices_num, (uint32_t)1);
+    EXPECT_EQ(Frame_Sample_1_16x16_8bit_422_bitstream[index.slice_offsets[0]], 0xff);
+    EXPECT_EQ(Frame_Sample_1_16x16_8bit_422_bitstream[index.slice_offsets[0] + 1], 0x20);
+    svt_jpeg_xs_frame_scanner_close(&scanner);
+}
+
+TEST(FrameScanner, ChunkedInputFindsAllFrames) {
+    const uint32_t frames_num = 3;
+    svt_jpeg_xs_encoder_api_t encoder;
+    encoder_test_config(&encoder);
+    std::vector<uint8_t> codestream;
+    encode_test_frames(&encoder, frames_num, &codestream);
+    ASSERT_FALSE(codestream.empty());
+    const uint32_t codestream_size = (uint32_t)codestream.size();
+
+    svt_jpeg_xs_frame_scanner_t scanner;
+    ASSERT_EQ(svt_jpeg_xs_frame_scanner_init(&scanner), SvtJxsErrorNone);
+    const size_t chunk_sizes[] = {1, 2, 3, 7, 100, codestream_size};
+    for (size_t chunk_size : chunk_sizes) {
+        uint32_t frame_begin = 0;
+        uint32_t frames_found = 0;
+        size_t pos = 0;
+        while (pos < codestream_size) {
+            svt_jpeg_xs_frame_index_t index;
+            size_t bytes_used = 0;
+            size_t size = chunk_size < codestream_size - pos ? chunk_size : codestream_size - pos;
+            SvtJxsErrorType_t ret = svt_jpeg_xs_frame_scanner_feed(&scanner, codestream.data() + pos, size, &bytes_used, &index);
+            pos += bytes_used;
+            if (ret == SvtJxsErrorDecoderBitstreamTooShort) {
+                ASSERT_EQ(bytes_used, size);
+                continue;
+            }
+            ASSERT_EQ(ret, SvtJxsErrorNone);
+
+            uint32_t frame_size = 0;
+            ASSERT_EQ(svt_jpeg_xs_decoder_get_single_frame_size(
+                          codestream.data() + frame_begin, codestream_size - frame_begin, NULL, &frame_size, 0),
+                      SvtJxsErrorNone);
+            ASSERT_EQ(index.frame_size, frame_size);
+            ASSERT_EQ(pos, (size_t)(frame_begin + frame_size));
+            ASSERT_EQ(index.slices_num, (uint32_t)(64 / 16));
+            for (uint32_t slice = 0; slice < index.slices_num; slice++) {
+                const uint8_t* slh = codestream.data() + frame_begin + index.slice_offsets[slice];
+                EXPECT_EQ(slh[0], 0xff);
+                EXPECT_EQ(slh[1], 0x20);
+                EXPECT_EQ((uint32_t)(slh[4] << 8 | slh[5]), slice);
+            }
+            frame_begin += frame_size;
+            frames_found++;
+        }
+        EXPECT_EQ(frames_found, frames_num);
+    }
+    svt_jpeg_xs_frame_scanner_close(&scanner);
+}
+
+TEST(FrameScanner, InvalidCodestreamRequiresReset) {
+    const uint8_t invalid[] = {0xff, 0x10, 0xff, 0x11};
+    svt_jpeg_xs_frame_scanner_t scanner;
+    ASSERT_EQ(svt_jpeg_xs_frame_scanner_init(&scanner), SvtJxsErrorNone);
+    svt_jpeg_xs_frame_index_t index;
+    size_t bytes_used = 0;
+    EXPECT_EQ(svt_jpeg_xs_frame_scanner_feed(&scanner, invalid, sizeof(invalid), &bytes_used, &index),
+              SvtJxsErrorDecoderInvalidBitstream);
+    EXPECT_EQ(svt_jpeg_xs_frame_scanner_feed(
+                  &scanner, Frame_Sample_1_16x16_8bit_422_bitstream, Frame_Sample_1_16x16_8bit_422_bitstream_size, &bytes_used, &index),
+              SvtJxsErrorDecoderInvalidBitstream);
+    svt_jpeg_xs_frame_scanner_reset(&scanner);
+    EXPECT_EQ(svt_jpeg_xs_frame_scanner_feed(
+                  &scanner, Frame_Sample_1_16x16_8bit_422_bitstream, Frame_Sample_1_16x16_8bit_422_bitstream_size, &bytes_used, &index),
+              SvtJxsErrorNone);
+    svt_jpeg_xs_frame_scanner_close(&scanner);
+}
+
+TEST(FrameScanner, DecodeWithIndexMatchesDecode) {
+    svt_jpeg_xs_encoder_api_t encoder;
+    encoder_test_config(&encoder);
+    std::vector<uint8_t> codestream;
+    encode_test_frames(&encoder, 1, &codestream);
+    ASSERT_FALSE(codestream.empty());
+    const uint32_t codestream_size = (uint32_t)codestream.size();
+
+    svt_jpeg_xs_frame_scanner_t scanner;
+    ASSERT_EQ(svt_jpeg_xs_frame_scanner_init(&scanner), SvtJxsErrorNone);
+    svt_jpeg_xs_frame_index_t index;
+    size_t bytes_used = 0;
+    ASSERT_EQ(svt_jpeg_xs_frame_scanner_feed(&scanner, codestream.data(), codestream_size, &bytes_used, &index), SvtJxsErrorNone);
+
+    svt_jpeg_xs_decoder_api_t decoder;
+    decoder_test_config(&decoder);
+    svt_jpeg_xs_image_config_t image_config;
+    ASSERT_EQ(svt_jpeg_xs_decoder_init(
+                  SVT_JPEGXS_API_VER_MAJOR, SVT_JPEGXS_API_VER_MINOR, &decoder, codestream.data(), codestream_size, &image_config),
+              SvtJxsErrorNone);
+
+    svt_jpeg_xs_image_buffer_t* images[2];
+    for (int i = 0; i < 2; i++) {
+        images[i] = svt_jpeg_xs_image_buffer_alloc(&image_config);
+        ASSERT_NE(images[i], nullptr);
+        svt_jpeg_xs_frame_t frame;
+        memset(&frame, 0, sizeof(frame));
+        frame.image = *images[i];
+        frame.bitstream.buffer = codestream.data();
+        frame.bitstream.used_size = codestream_size;
+        frame.bitstream.allocation_size = codestream_size;
+        if (i == 0) {
+            ASSERT_EQ(svt_jpeg_xs_decoder_send_frame(&decoder, &frame, 1), SvtJxsErrorNone);
+        }
+        else {
+            ASSERT_EQ(svt_jpeg_xs_decoder_send_frame_with_index(&decoder, &frame, &index, 1), SvtJxsErrorNone);
+        }
+        ASSERT_EQ(svt_jpeg_xs_decoder_get_frame(&decoder, &frame, 1), SvtJxsErrorNone);
+    }
+    for (int c = 0; c < image_config.components_num; c++) {
+        EXPECT_EQ(memcmp(images[0]->data_yuv[c], images[1]->data_yuv[c], image_config.components[c].byte_size), 0);
+    }
+
+    svt_jpeg_xs_decoder_close(&decoder);
+    svt_jpeg_xs_image_buffer_free(images[0]);
+    svt_jpeg_xs_image_buffer_free(images[1]);
+    svt_jpeg_xs_frame_scanner_close(&scanner);
+}
@@ -0,0 +1,106 @@
+/*
+* Copyright(c) 2024 Intel Corporation
+* SPDX - License - Identifier: BSD - 2 - Clause - Patent
+*/
+
+#include <math.h>
+#include <string.h>
+#include <vector>
+
+#include "gtest/gtest.h"
+#include "SvtJpegxsImageBufferTools.h"
+#include "ApiTestUtils.h"
+
+/*
+ * Tests for 16 bit integer and half-float input
+ */
+
+TEST(HighBitDepthInput, InvalidParametersReturnError) {
+    svt_jpeg_xs_encoder_api_t encoder;
+    encoder_test_config(&encoder);
+    encoder.input_bit_depth = 17;
+    EXPECT_EQ(svt_jpeg_xs_encoder_init(SVT_JPEGXS_API_VER_MAJOR, SVT_JPEGXS_API_VER_MINOR, &encoder), SvtJxsErrorBadParameter);
+    encoder_test_config(&encoder);
+    encoder.input_bit_depth = 10;
+    encoder.input_float16 = 1;
+    EXPECT_EQ(svt_jpeg_xs_encoder_init(SVT_JPEGXS_API_VER_MAJOR, SVT_JPEGXS_API_VER_MINOR, &encoder), SvtJxsErrorBadParameter);
+    EXPECT_EQ(encoder.private_ptr, nullptr);
+    encoder_test_config(&encoder);
+    encoder.input_bit_depth = 16;
+    encoder.input_float16 = 2;
+    EXPECT_EQ(svt_jpeg_xs_encoder_init(SVT_JPEGXS_API_VER_MAJOR, SVT_JPEGXS_API_VER_MINOR, &encoder), SvtJxsErrorBadParameter);
+}
+
+/*Sample of smooth test image, linear 0.0 to 1.0*/
+static double high_depth_test_sample(uint32_t x, uint32_t y, int c) {
+    return (double)((x * 3 + y * 5 + c * 40) % 256) / 255.0;
+}
+
+/*Nearest half-float of value 0.0 to 1.0*/
+static uint16_t high_depth_test_half(double val) {
+    if (val < ldexp(1.0, -14)) {
+        return (uint16_t)lround(ldexp(val, 24));
+    }
+    int exponent = 0;
+    double mantissa = frexp(val, &exponent); /*0.5 <= mantissa < 1*/
+    uint32_t bits = (uint32_t)((exponent + 14) << 10) + (uint32_t)lround(ldexp(mantissa, 11)) - 0x400;
+    return (uint16_t)bits;
+}
+
+TEST(HighBitDepthInput, DecodedMatchesInput) {
+    for (uint8_t input_float16 = 0; input_float16 <= 1; input_float16++) {
+        svt_jpeg_xs_encoder_api_t encoder;
+        encoder_test_config(&encoder);
+        encoder.input_bit_depth = 16;
+        encoder.input_float16 = input_float16;
+        encoder.colour_format = COLOUR_FORMAT_PLANAR_YUV444_OR_RGB;
+        encoder.bpp_numerator = 24;
+
+        svt_jpeg_xs_image_config_t image_config;
+        uint32_t bytes_per_frame = 0;
+        ASSERT_EQ(svt_jpeg_xs_encoder_get_image_config(
+                      SVT_JPEGXS_API_VER_MAJOR, SVT_JPEGXS_API_VER_MINOR, &encoder, &image_config, &bytes_per_frame),
+                  SvtJxsErrorNone);
+        ASSERT_EQ(svt_jpeg_xs_encoder_init(SVT_JPEGXS_API_VER_MAJOR, SVT_JPEGXS_API_VER_MINOR, &encoder), SvtJxsErrorNone);
+        svt_jpeg_xs_frame_pool_t* pool = svt_jpeg_xs_frame_pool_alloc(&image_config, bytes_per_frame, 1);
+        ASSERT_NE(pool, nullptr);
+        svt_jpeg_xs_frame_t frame;
+        ASSERT_EQ(svt_jpeg_xs_frame_pool_get(pool, &frame, 1), SvtJxsErrorNone);
+        for (int c = 0; c < image_config.components_num; c++) {
+            uint16_t* data = (uint16_t*)frame.image.data_yuv[c];
+            for (uint32_t y = 0; y < image_config.components[c].height; y++) {
+                for (uint32_t x = 0; x < image_config.components[c].width; x++) {
+                    double val = high_depth_test_sample(x, y, c);
+                    data[y * frame.image.stride[c] + x] = input_float16 ? high_depth_test_half(val)
+                                                                        : (uint16_t)lround(val * 65535);
+                }
+            }
+        }
+        ASSERT_EQ(svt_jpeg_xs_encoder_send_picture(&encoder, &frame, 1), SvtJxsErrorNone);
+        ASSERT_EQ(svt_jpeg_xs_encoder_get_packet(&encoder, &frame, 1), SvtJxsErrorNone);
+        std::vector<uint8_t> codestream(frame.bitstream.buffer, frame.bitstream.buffer + frame.bitstream.used_size);
+        svt_jpeg_xs_frame_pool_release(pool, &frame);
+        svt_jpeg_xs_encoder_close(&encoder);
+        svt_jpeg_xs_frame_pool_free(pool);
+
+        svt_jpeg_xs_image_config_t out_config;
+        svt_jpeg_xs_image_buffer_t* image = NULL;
+        ASSERT_EQ(decode_test_single_frame(codestream.data(), (uint32_t)codestream.size(), &image, &out_config),
+                  SvtJxsErrorNone);
+        ASSERT_EQ(out_config.bit_depth, 16);
+        /*Decoder return integer samples, half-float input is decoded as linear 16 bit value*/
+        double error_sum = 0;
+        uint32_t samples_num = 0;
+        for (int c = 0; c < out_config.components_num; c++) {
+            const uint16_t* data = (const uint16_t*)image->data_yuv[c];
+            for (uint32_t y = 0; y < out_config.components[c].height; y++) {
+                for (uint32_t x = 0; x < out_config.components[c].width; x++) {
+                    error_sum += fabs(data[y * image->stride[c] + x] - high_depth_test_sample(x, y, c) * 65535);
+                    samples_num++;
+                }
+            }
+        }
+        EXPECT_LT(error_sum / samples_num, 32.0) << "input_float16 " << (int)input_float16;
+        svt_jpeg_xs_image_buffer_free(image);
+    }
+}
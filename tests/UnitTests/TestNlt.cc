@@ -16,6 +16,7 @@
 #include "NltEnc.h"
 #include "Enc_avx512.h"
 #include "Precinct.h"
+#include <math.h>
 
 TEST(Nlt_Linear_Output_8bit, 8AVX2) {
     const int32_t w = 1999;
@@ -293,7 +294,7 @@ void test_linear_input_scaling_line_16bit(void (*test_fn)(const uint16_t* src, i
     memset(dst_ref, 0, w * sizeof(int32_t));
     memset(dst_mod, 0, w * sizeof(int32_t));
 
-    for (uint8_t input_bit_depth = 10; input_bit_depth < 16; ++input_bit_depth) {
+    for (uint8_t input_bit_depth = 10; input_bit_depth <= 16; ++input_bit_depth) {
         const uint8_t shift = param_Bw - input_bit_depth;
         const int32_t offset = 1 << (param_Bw - 1);
 
@@ -336,3 +337,51 @@ TEST(Nlt_Linear_Input_16bit, AVX512) {
         test_linear_input_scaling_line_16bit(linear_input_scaling_line_16bit_avx512);
     }
 }
+
+static double nlt_half_to_double(uint16_t h) {
+    const int32_t exponent = (h >> 10) & 0x1F;
+    const int32_t mantissa = h & 0x3FF;
+    double val = exponent ? ldexp(1024.0 + mantissa, exponent - 25) : ldexp((double)mantissa, -24);
+    if (exponent == 0x1F) {
+        val = mantissa ? 0.0 : 1.0;
+    }
+    if (h & 0x8000) {
+        val = 0.0;
+    }
+    return val > 1.0 ? 1.0 : val;
+}
+
+TEST(Nlt_Quadratic_Input_FP16, RoundTrip) {
+    const uint32_t w = 1 << 16;
+    const uint8_t depth = 16;
+    picture_header_dynamic_t hdr;
+    memset(&hdr, 0, sizeof(hdr));
+    hdr.hdr_Bw = 20;
+    hdr.hdr_Tnlt = 1;
+
+    uint16_t* src = (uint16_t*)malloc(w * sizeof(uint16_t));
+    int32_t* coeff = (int32_t*)malloc(w * sizeof(int32_t));
+    uint16_t* out = (uint16_t*)malloc(w * sizeof(uint16_t));
+    ASSERT_TRUE(src && coeff && out);
+    for (uint32_t j = 0; j < w; j++) {
+        src[j] = (uint16_t)j;
+    }
+
+    /*Every half-float value decoded without quantization have to be within 1 from linear 16 bit value*/
+    nlt_input_scaling_line(src, coeff, w, &hdr, depth);
+    nlt_inverse_transform_line_16bit(coeff, depth, &hdr, out, w);
+    for (uint32_t j = 0; j < w; j++) {
+        const double ref = nlt_half_to_double((uint16_t)j) * ((1 << depth) - 1);
+        ASSERT_NEAR(out[j], ref, 1.0) << "half 0x" << std::hex << j;
+        ASSERT_GE(coeff[j], -(1 << (hdr.hdr_Bw - 1)));
+        ASSERT_LT(coeff[j], 1 << (hdr.hdr_Bw - 1));
+    }
+    /*Monotonic for positive values up to 1.0*/
+    for (uint32_t j = 1; j <= 0x3C00; j++) {
+        ASSERT_GE(coeff[j], coeff[j - 1]);
+    }
+
+    free(src);
+    free(coeff);
+    free(out);
+}
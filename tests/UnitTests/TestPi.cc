@@ -295,6 +295,40 @@ TEST(TestPi, proxy_mode_sampling_support) {
     }
 }
 
+TEST(TestPi, proxy_mode_packets_num) {
+    const ColourFormat_t formats[] = {
+        COLOUR_FORMAT_PLANAR_YUV420, COLOUR_FORMAT_PLANAR_YUV422, COLOUR_FORMAT_PLANAR_YUV444_OR_RGB};
+    uint32_t sx[MAX_COMPONENTS_NUM];
+    uint32_t sy[MAX_COMPONENTS_NUM];
+    uint32_t num_comp = 0;
+
+    for (size_t f = 0; f < sizeof(formats) / sizeof(formats[0]); f++) {
+        for (uint32_t decom_v = 1; decom_v <= 2; decom_v++) {
+            pi_t pi;
+            ASSERT_EQ(format_get_sampling_factory(formats[f], &num_comp, sx, sy, VERBOSE_INFO_FULL), SvtJxsErrorNone);
+            ASSERT_EQ(pi_compute(&pi, 0 /*Init decoder*/, num_comp, 4, 8, 1920, 1080, 5, decom_v, 0, sx, sy, 0 /*Cw*/, 4),
+                      SvtJxsErrorNone);
+            for (int mode = proxy_mode_half; mode < proxy_mode_max; mode++) {
+                const proxy_mode_t proxy_mode = (proxy_mode_t)mode;
+                pi_t pi_tmp = pi;
+                if (pi_update_proxy_mode(&pi_tmp, proxy_mode, VERBOSE_NONE) != SvtJxsErrorNone) {
+                    continue;
+                }
+                /*Only lowest frequency packet left after removing all vertical levels except last one*/
+                const uint32_t packets_expected = (proxy_mode == proxy_mode_half && decom_v == 2) ? 4 : 1;
+                EXPECT_EQ(pi_tmp.packets_num, packets_expected) << "format " << f << " decom_v " << decom_v;
+                /*Packets after proxy packets contain only discarded bands*/
+                for (uint32_t packet_idx = pi_tmp.packets_num; packet_idx < pi.packets_num; packet_idx++) {
+                    for (uint32_t band_idx = pi.packets[packet_idx].band_start; band_idx < pi.packets[packet_idx].band_stop;
+                         band_idx++) {
+                        EXPECT_TRUE(pi_is_band_discarded(&pi_tmp, band_idx));
+                    }
+                }
+            }
+        }
+    }
+}
+
 struct ProxyTopology {
     ColourFormat_t format;
     int ref_w;
@@ -0,0 +1,134 @@
+/*
+* Copyright(c) 2024 Intel Corporation
+* SPDX - License - Identifier: BSD - 2 - Clause - Patent
+*/
+
+#include <string.h>
+#include <vector>
+
+#include "gtest/gtest.h"
+#include "SvtJpegxsImageBufferTools.h"
+#include "ApiTestUtils.h"
+#include "SampleFramesData.h"
+
+/*
+ * Tests for configurable pipeline depth
+ */
+
+TEST(PipelineDepth, InvalidValuesReturnError) {
+    svt_jpeg_xs_encoder_api_t encoder;
+    encoder_test_config(&encoder);
+    encoder.frames_in_pipeline = SVT_JXS_FRAMES_IN_PIPELINE_MAX + 1;
+    EXPECT_EQ(svt_jpeg_xs_encoder_init(SVT_JPEGXS_API_VER_MAJOR, SVT_JPEGXS_API_VER_MINOR, &encoder), SvtJxsErrorBadParameter);
+    EXPECT_EQ(encoder.private_ptr, nullptr);
+    encoder_test_config(&encoder);
+    encoder.frames_in_input_queue = SVT_JXS_FRAMES_IN_INPUT_QUEUE_MAX + 1;
+    EXPECT_EQ(svt_jpeg_xs_encoder_init(SVT_JPEGXS_API_VER_MAJOR, SVT_JPEGXS_API_VER_MINOR, &encoder), SvtJxsErrorBadParameter);
+    EXPECT_EQ(encoder.private_ptr, nullptr);
+
+    svt_jpeg_xs_decoder_api_t decoder;
+    memset(&decoder, 0, sizeof(decoder));
+    decoder.verbose = VERBOSE_NONE;
+    decoder.use_cpu_flags = CPU_FLAGS_ALL;
+    svt_jpeg_xs_image_config_t image_config;
+    for (int i = 0; i < 2; i++) {
+        decoder.frames_in_pipeline = i ? 1 : SVT_JXS_FRAMES_IN_PIPELINE_MAX + 1;
+        decoder.frames_in_input_queue = i ? SVT_JXS_FRAMES_IN_INPUT_QUEUE_MAX + 1 : 1;
+        EXPECT_EQ(svt_jpeg_xs_decoder_init(SVT_JPEGXS_API_VER_MAJOR,
+                                           SVT_JPEGXS_API_VER_MINOR,
+                                           &decoder,
+                                           Frame_Sample_1_16x16_8bit_422_bitstream,
+                                           Frame_Sample_1_16x16_8bit_422_bitstream_size,
+                                           &image_config),
+                  SvtJxsErrorBadParameter);
+        EXPECT_EQ(decoder.private_ptr, nullptr);
+    }
+}
+
+TEST(PipelineDepth, ResourcesFollowConfig) {
+    svt_jpeg_xs_encoder_api_t encoder;
+    encoder_test_config(&encoder);
+    encoder.frames_in_pipeline = 1;
+    encoder.frames_in_input_queue = SVT_JXS_FRAMES_IN_INPUT_QUEUE_MAX;
+    svt_jpeg_xs_resources_t resources;
+    ASSERT_EQ(svt_jpeg_xs_encoder_get_resources(SVT_JPEGXS_API_VER_MAJOR, SVT_JPEGXS_API_VER_MINOR, &encoder, &resources),
+              SvtJxsErrorNone);
+    EXPECT_EQ(resources.frames_in_pipeline, 1u);
+    EXPECT_EQ(resources.frames_in_input_queue, (uint32_t)SVT_JXS_FRAMES_IN_INPUT_QUEUE_MAX);
+
+    /*Picture control sets are allocated per frame in pipeline*/
+    svt_jpeg_xs_resources_t resources_deep;
+    encoder.frames_in_pipeline = 4;
+    ASSERT_EQ(svt_jpeg_xs_encoder_get_resources(SVT_JPEGXS_API_VER_MAJOR, SVT_JPEGXS_API_VER_MINOR, &encoder, &resources_deep),
+              SvtJxsErrorNone);
+    EXPECT_EQ(resources_deep.frames_in_pipeline, 4u);
+    EXPECT_GT(resources_deep.memory_peak, resources.memory_peak);
+
+    svt_jpeg_xs_decoder_api_t decoder;
+    decoder_test_config(&decoder);
+    decoder.frames_in_pipeline = SVT_JXS_FRAMES_IN_PIPELINE_MAX;
+    decoder.frames_in_input_queue = 1;
+    ASSERT_EQ(svt_jpeg_xs_decoder_get_resources(SVT_JPEGXS_API_VER_MAJOR,
+                                                SVT_JPEGXS_API_VER_MINOR,
+                                                &decoder,
+                                                Frame_Sample_1_16x16_8bit_422_bitstream,
+                                                Frame_Sample_1_16x16_8bit_422_bitstream_size,
+                                                &resources),
+              SvtJxsErrorNone);
+    EXPECT_EQ(resources.frames_in_pipeline, (uint32_t)SVT_JXS_FRAMES_IN_PIPELINE_MAX);
+    EXPECT_EQ(resources.frames_in_input_queue, 1u);
+}
+
+/*Send all frames before first receive, encoder and decoder with single frame in pipeline and in input queue*/
+TEST(PipelineDepth, SingleFrameDepthMatchesDefault) {
+    const uint32_t frames_num = 4;
+    svt_jpeg_xs_encoder_api_t encoder;
+    encoder_test_config(&encoder);
+    std::vector<uint8_t> codestream_ref;
+    encode_test_frames(&encoder, frames_num, &codestream_ref);
+    ASSERT_FALSE(codestream_ref.empty());
+
+    encoder_test_config(&encoder);
+    encoder.frames_in_pipeline = 1;
+    encoder.frames_in_input_queue = 1;
+    std::vector<uint8_t> codestream;
+    encode_test_frames(&encoder, frames_num, &codestream);
+    EXPECT_TRUE(codestream == codestream_ref);
+
+    /*Decode with default and with single frame depth*/
+    const uint32_t frame_size = (uint32_t)codestream_ref.size() / frames_num;
+    svt_jpeg_xs_image_config_t image_config;
+    svt_jpeg_xs_decoder_api_t decoders[2];
+    svt_jpeg_xs_image_buffer_t* images[2][frames_num];
+    for (int d = 0; d < 2; d++) {
+        svt_jpeg_xs_decoder_api_t* decoder = &decoders[d];
+        decoder_test_config(decoder);
+        decoder->frames_in_pipeline = d;
+        decoder->frames_in_input_queue = d;
+        ASSERT_EQ(svt_jpeg_xs_decoder_init(
+                      SVT_JPEGXS_API_VER_MAJOR, SVT_JPEGXS_API_VER_MINOR, decoder, codestream_ref.data(), frame_size, &image_config),
+                  SvtJxsErrorNone);
+        for (uint32_t i = 0; i < frames_num; i++) {
+            images[d][i] = svt_jpeg_xs_image_buffer_alloc(&image_config);
+            ASSERT_NE(images[d][i], nullptr);
+            svt_jpeg_xs_frame_t frame;
+            memset(&frame, 0, sizeof(frame));
+            frame.image = *images[d][i];
+            frame.bitstream.buffer = codestream_ref.data() + i * frame_size;
+            frame.bitstream.used_size = frame_size;
+            frame.bitstream.allocation_size = frame_size;
+            ASSERT_EQ(svt_jpeg_xs_decoder_send_frame(decoder, &frame, 1), SvtJxsErrorNone);
+        }
+        for (uint32_t i = 0; i < frames_num; i++) {
+            svt_jpeg_xs_frame_t frame;
+            ASSERT_EQ(svt_jpeg_xs_decoder_get_frame(decoder, &frame, 1), SvtJxsErrorNone);
+            EXPECT_EQ(frame.image.data_yuv[0], images[d][i]->data_yuv[0]);
+        }
+        svt_jpeg_xs_decoder_close(decoder);
+    }
+    for (uint32_t i = 0; i < frames_num; i++) {
+        decode_test_compare(&image_config, images[1][i], images[0][i]);
+        svt_jpeg_xs_image_buffer_free(images[0][i]);
+        svt_jpeg_xs_image_buffer_free(images[1][i]);
+    }
+}
@@ -6,6 +6,10 @@
 #include "gtest/gtest.h"
 #include <RateControl.h>
 #include <BinarySearch.h>
+#include <EncHandle.h>
+#include <PackStageProcess.h>
+#include <PictureControlSet.h>
+#include "random.h"
 
 TEST(RateControl, EqualSimple) {
     BinarySearch_t search;
@@ -333,3 +337,185 @@ TEST(RateControl, NotEqualBiggerFull) {
     Test_next_step_full(0, 1);
     Test_next_step_full(0, -1);
 }
+
+/*Fill GCLI of all band lines with random values and significance groups with maximum GCLI of group*/
+static void budget_test_fill_precinct(pi_t* pi, precinct_enc_t* precinct, svt_jxs_test_tool::SVTRandom* rnd_gcli,
+                                      svt_jxs_test_tool::SVTRandom* rnd_shift, uint8_t coding_significance) {
+    for (uint32_t c = 0; c < pi->comps_num; ++c) {
+        for (uint32_t b = 0; b < pi->components[c].bands_num; ++b) {
+            const uint32_t gcli_width = precinct->p_info->b_info[c][b].gcli_width;
+            const uint32_t significance_width = precinct->p_info->b_info[c][b].significance_width;
+            for (uint32_t line_idx = 0; line_idx < precinct->p_info->b_info[c][b].height; ++line_idx) {
+                uint8_t* gcli = precinct->bands[c][b].lines_common[line_idx].gcli_data_ptr;
+                for (uint32_t i = 0; i < gcli_width; ++i) {
+                    gcli[i] = (uint8_t)(rnd_gcli->random() >> rnd_shift->random());
+                }
+                if (coding_significance) {
+                    uint8_t* significance_max = precinct->bands[c][b].lines_common[line_idx].significance_data_max_ptr;
+                    for (uint32_t s = 0; s < significance_width; ++s) {
+                        uint32_t end = std::min((s + 1) * pi->significance_group_size, gcli_width);
+                        significance_max[s] = 0;
+                        for (uint32_t i = s * pi->significance_group_size; i < end; ++i) {
+                            significance_max[s] = std::max(significance_max[s], gcli[i]);
+                        }
+                    }
+                }
+            }
+        }
+    }
+}
+
+/*Budget looked up in tables without vertical prediction is the same as budget calculated by band methods*/
+static void budget_no_vpred_test(uint32_t ndecomp_v, uint8_t coding_significance, SignHandlingStrategy coding_signs_handling) {
+    svt_jpeg_xs_encoder_api_t encoder;
+    ASSERT_EQ(svt_jpeg_xs_encoder_load_default_parameters(SVT_JPEGXS_API_VER_MAJOR, SVT_JPEGXS_API_VER_MINOR, &encoder),
+              SvtJxsErrorNone);
+    encoder.verbose = VERBOSE_NONE;
+    encoder.source_width = 200;
+    encoder.source_height = 64;
+    encoder.input_bit_depth = 8;
+    encoder.colour_format = COLOUR_FORMAT_PLANAR_YUV422;
+    encoder.bpp_numerator = 3;
+    encoder.threads_num = 1;
+    encoder.ndecomp_v = ndecomp_v;
+    encoder.coding_significance = coding_significance;
+    encoder.coding_signs_handling = coding_signs_handling;
+    encoder.coding_vertical_prediction_mode = METHOD_PRED_DISABLE;
+    ASSERT_EQ(svt_jpeg_xs_encoder_init(SVT_JPEGXS_API_VER_MAJOR, SVT_JPEGXS_API_VER_MINOR, &encoder), SvtJxsErrorNone);
+    svt_jpeg_xs_encoder_common_t* enc_common = &((svt_jpeg_xs_encoder_api_prv_t*)encoder.private_ptr)->enc_common;
+    pi_t* pi = &enc_common->pi;
+
+    PictureControlSet pcs;
+    memset(&pcs, 0, sizeof(pcs));
+    pcs.enc_common = enc_common;
+    pcs.rate_control_mode = RC_CBR_PER_SLICE_COMMON_QUANT;
+    SvtArena_t arena;
+    precinct_enc_t* precinct = NULL;
+    ASSERT_EQ(pack_precincts_alloc(&arena, enc_common, 1, &precinct), SvtJxsErrorNone);
+
+    svt_jxs_test_tool::SVTRandom rnd_gcli(0, TRUNCATION_MAX);
+    svt_jxs_test_tool::SVTRandom rnd_shift(0, 4);
+    svt_jxs_test_tool::SVTRandom rnd_gtli(0, TRUNCATION_MAX);
+    /*RC per slice search and pack sign handling FULL as FAST*/
+    const SignHandlingStrategy signs_handling_budget = coding_signs_handling == SIGN_HANDLING_STRATEGY_FULL
+        ? SIGN_HANDLING_STRATEGY_FAST
+        : coding_signs_handling;
+    for (uint32_t iter = 0; iter < 20; ++iter) {
+        /*Init again to invalidate band cache of previous precinct*/
+        precinct_enc_init(&pcs, pi, 0, PRECINCT_NORMAL, NULL, precinct);
+        budget_test_fill_precinct(pi, precinct, &rnd_gcli, &rnd_shift, coding_significance);
+        rate_control_init_precinct(&pcs, precinct, METHOD_PRED_DISABLE, coding_signs_handling);
+        ASSERT_TRUE(precinct->rc_no_vpred_tables);
+        for (uint32_t probe = 0; probe < 50; ++probe) {
+            for (uint32_t c = 0; c < pi->comps_num; ++c) {
+                for (uint32_t b = 0; b < pi->components[c].bands_num; ++b) {
+                    precinct->bands[c][b].gtli = (uint8_t)rnd_gtli.random();
+                }
+            }
+            uint32_t budget_no_vpred = precinct_get_budget_bytes_no_vpred(enc_common, precinct);
+            uint32_t budget = precinct_get_budget_bytes(enc_common, precinct, METHOD_PRED_DISABLE, signs_handling_budget);
+            ASSERT_EQ(budget_no_vpred, budget) << "iter " << iter << " probe " << probe;
+        }
+    }
+
+    svt_jxs_arena_dctor(&arena);
+    svt_jpeg_xs_encoder_close(&encoder);
+}
+
+TEST(RateControl, BudgetNoVpredTablesMatch) {
+    for (uint32_t ndecomp_v = 0; ndecomp_v <= 2; ++ndecomp_v) {
+        for (uint8_t coding_significance = 0; coding_significance <= 1; ++coding_significance) {
+            budget_no_vpred_test(ndecomp_v, coding_significance, SIGN_HANDLING_STRATEGY_OFF);
+            budget_no_vpred_test(ndecomp_v, coding_significance, SIGN_HANDLING_STRATEGY_FAST);
+            budget_no_vpred_test(ndecomp_v, coding_significance, SIGN_HANDLING_STRATEGY_FULL);
+        }
+    }
+}
+
+typedef struct slice_rc_result {
+    uint8_t quantization;
+    uint8_t refinement;
+    uint32_t total_bytes;
+    uint32_t padding_bytes;
+} slice_rc_result_t;
+
+/*RC per slice with sign handling FULL gives the same quantization, refinement and precinct sizes as with FAST*/
+static void slice_signs_full_test(uint32_t ndecomp_v, RateControlType rate_control_mode) {
+    const uint32_t prec_num = 4;
+    svt_jpeg_xs_encoder_api_t encoder;
+    ASSERT_EQ(svt_jpeg_xs_encoder_load_default_parameters(SVT_JPEGXS_API_VER_MAJOR, SVT_JPEGXS_API_VER_MINOR, &encoder),
+              SvtJxsErrorNone);
+    encoder.verbose = VERBOSE_NONE;
+    encoder.source_width = 200;
+    encoder.source_height = 64;
+    encoder.input_bit_depth = 8;
+    encoder.colour_format = COLOUR_FORMAT_PLANAR_YUV422;
+    encoder.bpp_numerator = 3;
+    encoder.threads_num = 1;
+    encoder.ndecomp_v = ndecomp_v;
+    encoder.rate_control_mode = rate_control_mode;
+    encoder.coding_signs_handling = SIGN_HANDLING_STRATEGY_FULL;
+    encoder.coding_vertical_prediction_mode = METHOD_PRED_DISABLE;
+    ASSERT_EQ(svt_jpeg_xs_encoder_init(SVT_JPEGXS_API_VER_MAJOR, SVT_JPEGXS_API_VER_MINOR, &encoder), SvtJxsErrorNone);
+    svt_jpeg_xs_encoder_common_t* enc_common = &((svt_jpeg_xs_encoder_api_prv_t*)encoder.private_ptr)->enc_common;
+    pi_t* pi = &enc_common->pi;
+
+    PictureControlSet pcs;
+    memset(&pcs, 0, sizeof(pcs));
+    pcs.enc_common = enc_common;
+    pcs.rate_control_mode = rate_control_mode;
+    SvtArena_t arena;
+    precinct_enc_t* precincts = NULL;
+    ASSERT_EQ(pack_precincts_alloc(&arena, enc_common, prec_num, &precincts), SvtJxsErrorNone);
+
+    svt_jxs_test_tool::SVTRandom rnd_gcli(0, TRUNCATION_MAX);
+    svt_jxs_test_tool::SVTRandom rnd_shift(0, 4);
+    for (uint32_t i = 0; i < prec_num; ++i) {
+        precinct_enc_init(&pcs, pi, i, PRECINCT_NORMAL, NULL, &precincts[i]);
+        budget_test_fill_precinct(pi, &precincts[i], &rnd_gcli, &rnd_shift, enc_common->coding_significance);
+    }
+
+    uint32_t found = 0;
+    for (uint32_t budget_bytes = prec_num * 100; budget_bytes <= prec_num * 2000; budget_bytes += prec_num * 100) {
+        slice_rc_result_t results[2][prec_num];
+        SvtJxsErrorType_t ret[2];
+        const SignHandlingStrategy signs[2] = {SIGN_HANDLING_STRATEGY_FAST, SIGN_HANDLING_STRATEGY_FULL};
+        for (uint32_t s = 0; s < 2; ++s) {
+            for (uint32_t i = 0; i < prec_num; ++i) {
+                /*Init again to invalidate band cache, GCLI buffers are kept*/
+                precinct_enc_init(&pcs, pi, i, PRECINCT_NORMAL, NULL, &precincts[i]);
+                rate_control_init_precinct(&pcs, &precincts[i], METHOD_PRED_DISABLE, signs[s]);
+            }
+            ret[s] = rate_control_slice_quantization_fast_no_vpred_no_sign_full(
+                &pcs, precincts, prec_num, budget_bytes, signs[s]);
+            for (uint32_t i = 0; i < prec_num && ret[s] == SvtJxsErrorNone; ++i) {
+                results[s][i].quantization = precincts[i].pack_quantization;
+                results[s][i].refinement = precincts[i].pack_refinement;
+                results[s][i].total_bytes = precincts[i].pack_total_bytes;
+                results[s][i].padding_bytes = precincts[i].pack_padding_bytes;
+            }
+        }
+        ASSERT_EQ(ret[0], ret[1]) << "budget " << budget_bytes;
+        if (ret[0] != SvtJxsErrorNone) {
+            continue;
+        }
+        found++;
+        for (uint32_t i = 0; i < prec_num; ++i) {
+            EXPECT_EQ(results[0][i].quantization, results[1][i].quantization) << "budget " << budget_bytes << " precinct " << i;
+            EXPECT_EQ(results[0][i].refinement, results[1][i].refinement) << "budget " << budget_bytes << " precinct " << i;
+            EXPECT_EQ(results[0][i].total_bytes, results[1][i].total_bytes) << "budget " << budget_bytes << " precinct " << i;
+            EXPECT_EQ(results[0][i].padding_bytes, results[1][i].padding_bytes) << "budget " << budget_bytes << " precinct " << i;
+        }
+    }
+    EXPECT_GT(found, (uint32_t)0);
+
+    svt_jxs_arena_dctor(&arena);
+    svt_jpeg_xs_encoder_close(&encoder);
+}
+
+TEST(RateControl, SliceSignsFullAsFast) {
+    for (uint32_t ndecomp_v = 0; ndecomp_v <= 2; ++ndecomp_v) {
+        slice_signs_full_test(ndecomp_v, RC_CBR_PER_SLICE_COMMON_QUANT);
+        slice_signs_full_test(ndecomp_v, RC_CBR_PER_SLICE_COMMON_QUANT_MAX_RATE);
+    }
+}
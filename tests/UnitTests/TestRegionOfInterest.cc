@@ -0,0 +1,120 @@
+/*
+* Copyright(c) 2024 Intel Corporation
+* SPDX - License - Identifier: BSD - 2 - Clause - Patent
+*/
+
+#include <string.h>
+#include <vector>
+
+#include "gtest/gtest.h"
+#include "SvtJpegxsImageBufferTools.h"
+#include "ApiTestUtils.h"
+
+/*
+ * Tests for region of interest decoding
+ */
+
+/*Decode single frame with region of interest, output buffer is filled with fill_value before decode*/
+static SvtJxsErrorType_t roi_test_decode(const uint8_t* codestream, uint32_t codestream_size, uint16_t slice_begin,
+                                         uint16_t slice_end, uint8_t components_mask, uint8_t fill_value,
+                                         svt_jpeg_xs_image_buffer_t** out_image, svt_jpeg_xs_image_config_t* image_config) {
+    svt_jpeg_xs_decoder_api_t decoder;
+    decoder_test_config(&decoder);
+    decoder.roi_slice_begin = slice_begin;
+    decoder.roi_slice_end = slice_end;
+    decoder.roi_components_mask = components_mask;
+    SvtJxsErrorType_t ret = svt_jpeg_xs_decoder_init(
+        SVT_JPEGXS_API_VER_MAJOR, SVT_JPEGXS_API_VER_MINOR, &decoder, codestream, codestream_size, image_config);
+    if (ret) {
+        return ret;
+    }
+
+    *out_image = svt_jpeg_xs_image_buffer_alloc(image_config);
+    for (int c = 0; c < image_config->components_num; c++) {
+        memset((*out_image)->data_yuv[c], fill_value, image_config->components[c].byte_size);
+    }
+    ret = decode_test_frame(&decoder, codestream, codestream_size, *out_image);
+    svt_jpeg_xs_decoder_close(&decoder);
+    return ret;
+}
+
+TEST(RegionOfInterestInit, InvalidParametersReturnError) {
+    svt_jpeg_xs_encoder_api_t encoder;
+    encoder_test_config(&encoder);
+    std::vector<uint8_t> codestream;
+    encode_test_frames(&encoder, 1, &codestream);
+    ASSERT_FALSE(codestream.empty());
+    const uint32_t codestream_size = (uint32_t)codestream.size();
+
+    svt_jpeg_xs_image_config_t image_config;
+    svt_jpeg_xs_image_buffer_t* image = NULL;
+    EXPECT_EQ(roi_test_decode(codestream.data(), codestream_size, 2, 2, 0, 0, &image, &image_config), SvtJxsErrorBadParameter);
+    EXPECT_EQ(roi_test_decode(codestream.data(), codestream_size, 4, 0, 0, 0, &image, &image_config), SvtJxsErrorBadParameter);
+    EXPECT_EQ(roi_test_decode(codestream.data(), codestream_size, 0, 5, 0, 0, &image, &image_config), SvtJxsErrorBadParameter);
+    EXPECT_EQ(roi_test_decode(codestream.data(), codestream_size, 0, 0, 0x8, 0, &image, &image_config), SvtJxsErrorBadParameter);
+    EXPECT_EQ(image, nullptr);
+}
+
+class RegionOfInterest : public ::testing::TestWithParam<uint32_t> {};
+
+TEST_P(RegionOfInterest, DecodeMatchesFullDecode) {
+    /*Slice range and components mask, 4 slices of 16 lines in picture*/
+    const struct {
+        uint16_t slice_begin;
+        uint16_t slice_end;
+        uint8_t components_mask;
+    } regions[] = {{0, 1, 0x0}, {1, 3, 0x0}, {3, 0, 0x1}, {2, 3, 0x5}, {0, 0, 0x2}};
+    const uint32_t slice_height = 16;
+    const uint8_t fill_value = 0xA5;
+
+    svt_jpeg_xs_encoder_api_t encoder;
+    encoder_test_config(&encoder);
+    encoder.coding_signs_handling = GetParam();
+    std::vector<uint8_t> codestream;
+    encode_test_frames(&encoder, 1, &codestream);
+    ASSERT_FALSE(codestream.empty());
+    const uint32_t codestream_size = (uint32_t)codestream.size();
+
+    svt_jpeg_xs_image_config_t image_config;
+    svt_jpeg_xs_image_buffer_t* image_full = NULL;
+    ASSERT_EQ(roi_test_decode(codestream.data(), codestream_size, 0, 0, 0, 0, &image_full, &image_config), SvtJxsErrorNone);
+
+    for (size_t r = 0; r < sizeof(regions) / sizeof(regions[0]); r++) {
+        svt_jpeg_xs_image_buffer_t* image = NULL;
+        ASSERT_EQ(roi_test_decode(codestream.data(),
+                                  codestream_size,
+                                  regions[r].slice_begin,
+                                  regions[r].slice_end,
+                                  regions[r].components_mask,
+                                  fill_value,
+                                  &image,
+                                  &image_config),
+                  SvtJxsErrorNone);
+        uint32_t slice_end = regions[r].slice_end ? regions[r].slice_end : image_config.height / slice_height;
+        for (int c = 0; c < image_config.components_num; c++) {
+            const uint32_t width = image_config.components[c].width;
+            const uint8_t* data = (const uint8_t*)image->data_yuv[c];
+            const uint8_t* data_full = (const uint8_t*)image_full->data_yuv[c];
+            if (regions[r].components_mask && !(regions[r].components_mask & (1 << c))) {
+                /*Not selected component is not modified*/
+                for (uint32_t i = 0; i < image_config.components[c].byte_size; i++) {
+                    ASSERT_EQ(data[i], fill_value);
+                }
+                continue;
+            }
+            for (uint32_t y = regions[r].slice_begin * slice_height; y < slice_end * slice_height; y++) {
+                EXPECT_EQ(memcmp(data + y * width, data_full + y * width, width), 0) << "region " << r << " comp " << c << " y " << y;
+            }
+            if (regions[r].slice_begin >= 2) {
+                /*First slice is not required by vertical IDWT of region and is not decoded*/
+                EXPECT_EQ(data[0], fill_value);
+            }
+        }
+        svt_jpeg_xs_image_buffer_free(image);
+    }
+
+    svt_jpeg_xs_image_buffer_free(image_full);
+}
+
+/*Coding signs handling disabled and enabled, signs in separate sub-packet require unpack of skipped components*/
+INSTANTIATE_TEST_SUITE_P(RegionOfInterestSigns, RegionOfInterest, ::testing::Values(0, 1));
@@ -0,0 +1,229 @@
+/*
+* Copyright(c) 2024 Intel Corporation
+* SPDX - License - Identifier: BSD - 2 - Clause - Patent
+*/
+
+#include <string.h>
+#include <vector>
+
+#include "gtest/gtest.h"
+#include "SvtJpegxsImageBufferTools.h"
+#include "ApiTestUtils.h"
+#include "SampleFramesData.h"
+
+/*
+ * Tests for resources query before init
+ */
+
+static size_t resources_purpose_sum(const svt_jpeg_xs_resources_t* resources) {
+    size_t sum = 0;
+    for (int i = 0; i < SVT_JXS_MEM_PURPOSES_NUM; i++) {
+        sum += resources->memory_peak_purpose[i];
+    }
+    return sum;
+}
+
+TEST(Resources, EncoderMatchesInit) {
+    TestAllocatorCtx ctx;
+    svt_jpeg_xs_allocator_t allocator;
+    test_allocator_init(&allocator, &ctx);
+
+    svt_jpeg_xs_encoder_api_t encoder;
+    encoder_test_config(&encoder);
+    encoder.cpu_profile = 1; /*Low CPU usage, with DWT stage*/
+    encoder.threads_num = 6;
+    svt_jpeg_xs_resources_t resources;
+    EXPECT_EQ(svt_jpeg_xs_encoder_get_resources(SVT_JPEGXS_API_VER_MAJOR, SVT_JPEGXS_API_VER_MINOR, &encoder, NULL),
+              SvtJxsErrorBadParameter);
+    ASSERT_EQ(svt_jpeg_xs_encoder_get_resources(SVT_JPEGXS_API_VER_MAJOR, SVT_JPEGXS_API_VER_MINOR, &encoder, &resources),
+              SvtJxsErrorNone);
+
+    encoder.allocator = &allocator;
+    ASSERT_EQ(svt_jpeg_xs_encoder_init(SVT_JPEGXS_API_VER_MAJOR, SVT_JPEGXS_API_VER_MINOR, &encoder), SvtJxsErrorNone);
+    svt_jpeg_xs_encoder_close(&encoder);
+
+    EXPECT_EQ(resources.memory_peak, ctx.bytes_peak);
+    EXPECT_EQ(resources_purpose_sum(&resources), resources.memory_peak);
+    EXPECT_EQ(memcmp(resources.memory_peak_purpose, ctx.purpose_bytes_peak, sizeof(resources.memory_peak_purpose)), 0);
+    EXPECT_GT(resources.memory_peak_purpose[SVT_JXS_MEM_COEFFICIENTS], (size_t)0);
+    EXPECT_EQ(resources.threads_num[SVT_JXS_STAGE_INIT], 1u);
+    EXPECT_EQ(resources.threads_num[SVT_JXS_STAGE_DWT], 1u);
+    EXPECT_EQ(resources.threads_num[SVT_JXS_STAGE_SLICE], 3u);
+    EXPECT_EQ(resources.threads_num[SVT_JXS_STAGE_FINAL], 1u);
+    EXPECT_GT(resources.frames_in_pipeline, 0u);
+    EXPECT_GT(resources.frames_in_input_queue, 0u);
+}
+
+TEST(Resources, DecoderMatchesInit) {
+    TestAllocatorCtx ctx;
+    svt_jpeg_xs_allocator_t allocator;
+    test_allocator_init(&allocator, &ctx);
+
+    svt_jpeg_xs_decoder_api_t decoder;
+    decoder_test_config(&decoder);
+    decoder.packetization_mode = 1;
+    svt_jpeg_xs_resources_t resources;
+    ASSERT_EQ(svt_jpeg_xs_decoder_get_resources(SVT_JPEGXS_API_VER_MAJOR,
+                                                SVT_JPEGXS_API_VER_MINOR,
+                                                &decoder,
+                                                Frame_Sample_1_16x16_8bit_422_bitstream,
+                                                Frame_Sample_1_16x16_8bit_422_bitstream_size,
+                                                &resources),
+              SvtJxsErrorNone);
+
+    decoder.allocator = &allocator;
+    svt_jpeg_xs_image_config_t image_config;
+    ASSERT_EQ(svt_jpeg_xs_decoder_init(SVT_JPEGXS_API_VER_MAJOR,
+                                       SVT_JPEGXS_API_VER_MINOR,
+                                       &decoder,
+                                       Frame_Sample_1_16x16_8bit_422_bitstream,
+                                       Frame_Sample_1_16x16_8bit_422_bitstream_size,
+                                       &image_config),
+              SvtJxsErrorNone);
+    svt_jpeg_xs_decoder_close(&decoder);
+
+    EXPECT_EQ(resources.memory_peak, ctx.bytes_peak);
+    EXPECT_EQ(resources_purpose_sum(&resources), resources.memory_peak);
+    EXPECT_EQ(memcmp(resources.memory_peak_purpose, ctx.purpose_bytes_peak, sizeof(resources.memory_peak_purpose)), 0);
+    EXPECT_GT(resources.memory_peak_purpose[SVT_JXS_MEM_COEFFICIENTS], (size_t)0);
+    EXPECT_GT(resources.memory_peak_purpose[SVT_JXS_MEM_SCRATCH], (size_t)0);
+    EXPECT_EQ(resources.threads_num[SVT_JXS_STAGE_INIT], 0u);
+    EXPECT_EQ(resources.threads_num[SVT_JXS_STAGE_DWT], 0u);
+    EXPECT_EQ(resources.threads_num[SVT_JXS_STAGE_SLICE], 2u);
+    EXPECT_EQ(resources.threads_num[SVT_JXS_STAGE_FINAL], 1u);
+    EXPECT_GT(resources.frames_in_pipeline, 0u);
+    EXPECT_EQ(resources.frames_in_input_queue, 0u);
+}
+
+/*Encoder configurations of every pipeline path: CPU profiles, packed input, statistics, slice parts and rate control*/
+static void resources_test_encoder_config(uint32_t idx, svt_jpeg_xs_encoder_api_t* encoder) {
+    encoder_test_config(encoder);
+    switch (idx) {
+    case 1:
+        encoder->cpu_profile = 1;
+        encoder->threads_num = 14;
+        encoder->ndecomp_v = 1;
+        break;
+    case 2:
+        encoder->colour_format = COLOUR_FORMAT_PACKED_YUV444_OR_RGB;
+        encoder->ndecomp_v = 2;
+        break;
+    case 3:
+        encoder->stats_enable = 1;
+        encoder->slice_packetization_mode = 1;
+        encoder->frames_in_pipeline = 3;
+        encoder->frames_in_input_queue = 5;
+        break;
+    case 4:
+        encoder->ndecomp_v = 0;
+        encoder->slice_height = 16;
+        encoder->threads_num = 12;
+        break;
+    case 5:
+        encoder->rate_control_mode = 1;
+        encoder->coding_vertical_prediction_mode = 1;
+        encoder->input_bit_depth = 10;
+        break;
+    default:
+        break;
+    }
+}
+
+class EncoderResources : public ::testing::TestWithParam<uint32_t> {};
+
+TEST_P(EncoderResources, MatchesInit) {
+    TestAllocatorCtx ctx;
+    svt_jpeg_xs_allocator_t allocator;
+    test_allocator_init(&allocator, &ctx);
+
+    svt_jpeg_xs_encoder_api_t encoder;
+    resources_test_encoder_config(GetParam(), &encoder);
+    svt_jpeg_xs_resources_t resources;
+    ASSERT_EQ(svt_jpeg_xs_encoder_get_resources(SVT_JPEGXS_API_VER_MAJOR, SVT_JPEGXS_API_VER_MINOR, &encoder, &resources),
+              SvtJxsErrorNone);
+    /*Nothing is allocated to get resources*/
+    EXPECT_EQ(ctx.bytes_peak, (size_t)0);
+
+    encoder.allocator = &allocator;
+    ASSERT_EQ(svt_jpeg_xs_encoder_init(SVT_JPEGXS_API_VER_MAJOR, SVT_JPEGXS_API_VER_MINOR, &encoder), SvtJxsErrorNone);
+    svt_jpeg_xs_encoder_close(&encoder);
+
+    EXPECT_EQ(resources.memory_peak, ctx.bytes_peak);
+    EXPECT_EQ(memcmp(resources.memory_peak_purpose, ctx.purpose_bytes_peak, sizeof(resources.memory_peak_purpose)), 0);
+}
+
+INSTANTIATE_TEST_SUITE_P(EncoderResources, EncoderResources, ::testing::Values(0u, 1u, 2u, 3u, 4u, 5u));
+
+/*Decoder configurations of every pipeline path: threads, packetization, concealment, statistics and ceiling of stream*/
+static void resources_test_decoder_config(uint32_t idx, svt_jpeg_xs_decoder_api_t* decoder) {
+    decoder_test_config(decoder);
+    switch (idx) {
+    case 1:
+        decoder->threads_num = 1;
+        decoder->frames_in_pipeline = 5;
+        decoder->frames_in_input_queue = 7;
+        break;
+    case 2:
+        decoder->threads_num = 10;
+        decoder->slice_concealment = 1;
+        decoder->stats_enable = 1;
+        break;
+    case 3:
+        decoder->packetization_mode = 1;
+        break;
+    case 4:
+        decoder->max_width = 128;
+        decoder->max_height = 128;
+        decoder->max_components_num = 3;
+        decoder->slice_concealment = 1;
+        break;
+    case 5:
+        decoder->max_width = 32;
+        decoder->max_height = 256;
+        decoder->proxy_mode = proxy_mode_half;
+        decoder->roi_slice_begin = 1;
+        break;
+    default:
+        break;
+    }
+}
+
+class DecoderResources : public ::testing::TestWithParam<uint32_t> {};
+
+TEST_P(DecoderResources, MatchesInit) {
+    svt_jpeg_xs_encoder_api_t encoder;
+    encoder_test_config(&encoder);
+    encoder.source_width = 96;
+    encoder.source_height = 80;
+    std::vector<uint8_t> codestream;
+    encode_test_frames(&encoder, 1, &codestream);
+    ASSERT_FALSE(codestream.empty());
+    const uint32_t codestream_size = (uint32_t)codestream.size();
+
+    TestAllocatorCtx ctx;
+    svt_jpeg_xs_allocator_t allocator;
+    test_allocator_init(&allocator, &ctx);
+
+    svt_jpeg_xs_decoder_api_t decoder;
+    resources_test_decoder_config(GetParam(), &decoder);
+    svt_jpeg_xs_resources_t resources;
+    ASSERT_EQ(svt_jpeg_xs_decoder_get_resources(
+                  SVT_JPEGXS_API_VER_MAJOR, SVT_JPEGXS_API_VER_MINOR, &decoder, codestream.data(), codestream_size, &resources),
+              SvtJxsErrorNone);
+    /*Nothing is allocated to get resources*/
+    EXPECT_EQ(ctx.bytes_peak, (size_t)0);
+
+    decoder.allocator = &allocator;
+    svt_jpeg_xs_image_config_t image_config;
+    ASSERT_EQ(svt_jpeg_xs_decoder_init(
+                  SVT_JPEGXS_API_VER_MAJOR, SVT_JPEGXS_API_VER_MINOR, &decoder, codestream.data(), codestream_size, &image_config),
+              SvtJxsErrorNone);
+    svt_jpeg_xs_decoder_close(&decoder);
+
+    EXPECT_EQ(resources.memory_peak, ctx.bytes_peak);
+    EXPECT_EQ(memcmp(resources.memory_peak_purpose, ctx.purpose_bytes_peak, sizeof(resources.memory_peak_purpose)), 0);
+    EXPECT_EQ(resources.threads_num[SVT_JXS_STAGE_INIT], decoder.packetization_mode ? 0u : 1u);
+    EXPECT_EQ(resources.threads_num[SVT_JXS_STAGE_SLICE], decoder.threads_num <= 2 ? 1u : decoder.threads_num - 2);
+}
+
+INSTANTIATE_TEST_SUITE_P(DecoderResources, DecoderResources, ::testing::Values(0u, 1u, 2u, 3u, 4u, 5u));
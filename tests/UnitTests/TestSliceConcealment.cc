@@ -0,0 +1,134 @@
+/*
+* Copyright(c) 2024 Intel Corporation
+* SPDX - License - Identifier: BSD - 2 - Clause - Patent
+*/
+
+#include <string.h>
+#include <vector>
+
+#include "gtest/gtest.h"
+#include "SvtJpegxsImageBufferTools.h"
+#include "ApiTestUtils.h"
+
+/*
+ * Tests for slice concealment
+ */
+
+/*Decode single frame with slice concealment and return bitmap of concealed slices*/
+static SvtJxsErrorType_t conceal_test_decode(const uint8_t* codestream, uint32_t codestream_size, uint8_t slice_concealment,
+                                             svt_jpeg_xs_image_buffer_t** out_image, svt_jpeg_xs_image_config_t* image_config,
+                                             uint8_t* out_bitmap, uint32_t* out_concealed_num) {
+    svt_jpeg_xs_decoder_api_t decoder;
+    decoder_test_config(&decoder);
+    decoder.slice_concealment = slice_concealment;
+    SvtJxsErrorType_t ret = svt_jpeg_xs_decoder_init(
+        SVT_JPEGXS_API_VER_MAJOR, SVT_JPEGXS_API_VER_MINOR, &decoder, codestream, codestream_size, image_config);
+    if (ret) {
+        return ret;
+    }
+
+    *out_image = svt_jpeg_xs_image_buffer_alloc(image_config);
+    ret = decode_test_frame(&decoder, codestream, codestream_size, *out_image);
+    if (ret == SvtJxsErrorNone && slice_concealment) {
+        ret = svt_jpeg_xs_decoder_get_concealed_slices(&decoder, out_bitmap, 1, out_concealed_num);
+    }
+    svt_jpeg_xs_decoder_close(&decoder);
+    return ret;
+}
+
+TEST(SliceConcealment, InvalidParametersReturnError) {
+    svt_jpeg_xs_encoder_api_t encoder;
+    encoder_test_config(&encoder);
+    std::vector<uint8_t> codestream;
+    encode_test_frames(&encoder, 1, &codestream);
+    ASSERT_FALSE(codestream.empty());
+    const uint32_t codestream_size = (uint32_t)codestream.size();
+
+    svt_jpeg_xs_image_config_t image_config;
+    svt_jpeg_xs_image_buffer_t* image = NULL;
+    uint8_t bitmap = 0;
+    uint32_t concealed_num = 0;
+    EXPECT_EQ(conceal_test_decode(codestream.data(), codestream_size, 2, &image, &image_config, &bitmap, &concealed_num),
+              SvtJxsErrorBadParameter);
+    EXPECT_EQ(image, nullptr);
+
+    svt_jpeg_xs_decoder_api_t decoder;
+    memset(&decoder, 0, sizeof(decoder));
+    decoder.verbose = VERBOSE_NONE;
+    decoder.use_cpu_flags = CPU_FLAGS_ALL;
+    ASSERT_EQ(svt_jpeg_xs_decoder_init(
+                  SVT_JPEGXS_API_VER_MAJOR, SVT_JPEGXS_API_VER_MINOR, &decoder, codestream.data(), codestream_size, &image_config),
+              SvtJxsErrorNone);
+    EXPECT_EQ(svt_jpeg_xs_decoder_get_concealed_slices(&decoder, &bitmap, 1, &concealed_num), SvtJxsErrorBadParameter);
+    EXPECT_EQ(svt_jpeg_xs_decoder_get_concealed_slices(&decoder, &bitmap, 1, NULL), SvtJxsErrorDecoderInvalidPointer);
+    svt_jpeg_xs_decoder_close(&decoder);
+}
+
+TEST(SliceConcealment, CorruptedSliceIsConcealed) {
+    /*4 slices of 16 lines in picture, rows far from concealed slice are not changed by vertical IDWT*/
+    const uint32_t slice_height = 16;
+    const uint32_t distance = 8;
+
+    svt_jpeg_xs_encoder_api_t encoder;
+    encoder_test_config(&encoder);
+    std::vector<uint8_t> codestream;
+    encode_test_frames(&encoder, 1, &codestream);
+    ASSERT_FALSE(codestream.empty());
+    const uint32_t codestream_size = (uint32_t)codestream.size();
+
+    svt_jpeg_xs_frame_scanner_t scanner;
+    ASSERT_EQ(svt_jpeg_xs_frame_scanner_init(&scanner), SvtJxsErrorNone);
+    svt_jpeg_xs_frame_index_t index;
+    size_t bytes_used = 0;
+    ASSERT_EQ(svt_jpeg_xs_frame_scanner_feed(&scanner, codestream.data(), codestream_size, &bytes_used, &index), SvtJxsErrorNone);
+    ASSERT_EQ(index.slices_num, 4u);
+
+    svt_jpeg_xs_image_config_t image_config;
+    svt_jpeg_xs_image_buffer_t* image_full = NULL;
+    uint8_t bitmap = 0xFF;
+    uint32_t concealed_num = 0xFF;
+    ASSERT_EQ(conceal_test_decode(codestream.data(), codestream_size, 1, &image_full, &image_config, &bitmap, &concealed_num),
+              SvtJxsErrorNone);
+    EXPECT_EQ(bitmap, 0);
+    EXPECT_EQ(concealed_num, 0u);
+
+    for (uint32_t slice_broken = 1; slice_broken < index.slices_num; slice_broken += 2) {
+        uint8_t* broken = (uint8_t*)malloc(codestream_size);
+        ASSERT_NE(broken, nullptr);
+        memcpy(broken, codestream.data(), codestream_size);
+        /*Invalid slice header marker*/
+        broken[index.slice_offsets[slice_broken]] = 0;
+
+        svt_jpeg_xs_image_buffer_t* image = NULL;
+        EXPECT_NE(conceal_test_decode(broken, codestream_size, 0, &image, &image_config, &bitmap, &concealed_num),
+                  SvtJxsErrorNone);
+        svt_jpeg_xs_image_buffer_free(image);
+
+        ASSERT_EQ(conceal_test_decode(broken, codestream_size, 1, &image, &image_config, &bitmap, &concealed_num),
+                  SvtJxsErrorNone);
+        EXPECT_EQ(bitmap, 1 << slice_broken);
+        EXPECT_EQ(concealed_num, 1u);
+        for (int c = 0; c < image_config.components_num; c++) {
+            const uint32_t width = image_config.components[c].width;
+            const uint8_t* data = (const uint8_t*)image->data_yuv[c];
+            const uint8_t* data_full = (const uint8_t*)image_full->data_yuv[c];
+            uint32_t broken_begin = slice_broken * slice_height;
+            uint32_t broken_end = broken_begin + slice_height;
+            for (uint32_t y = 0; y < image_config.components[c].height; y++) {
+                if (y >= broken_begin && y < broken_end) {
+                    for (uint32_t x = 0; x < width; x++) {
+                        ASSERT_EQ(data[y * width + x], 128) << "comp " << c << " y " << y;
+                    }
+                }
+                else if (y + distance < broken_begin || y >= broken_end + distance) {
+                    EXPECT_EQ(memcmp(data + y * width, data_full + y * width, width), 0) << "comp " << c << " y " << y;
+                }
+            }
+        }
+        svt_jpeg_xs_image_buffer_free(image);
+        free(broken);
+    }
+
+    svt_jpeg_xs_image_buffer_free(image_full);
+    svt_jpeg_xs_frame_scanner_close(&scanner);
+}
@@ -0,0 +1,64 @@
+/*
+* Copyright(c) 2024 Intel Corporation
+* SPDX - License - Identifier: BSD - 2 - Clause - Patent
+*/
+
+#include <string.h>
+#include <vector>
+
+#include "gtest/gtest.h"
+#include "SvtJpegxsImageBufferTools.h"
+#include "ApiTestUtils.h"
+
+/*
+ * Tests for overlap of slices calculated on universal threads
+ */
+
+class SliceOverlap : public ::testing::TestWithParam<uint32_t> {};
+
+/*Slices of 1 and 2 precincts, overlap of slice depends on previous slices and is calculated by any thread*/
+TEST_P(SliceOverlap, ThreadsMatchSingleThread) {
+    const uint32_t slice_height = GetParam();
+    const uint32_t threads_num[] = {8, 3};
+    svt_jpeg_xs_encoder_api_t encoder;
+    encoder_test_config(&encoder);
+    encoder.source_width = 128;
+    encoder.slice_height = slice_height;
+    std::vector<uint8_t> codestream;
+    encode_test_frames(&encoder, 1, &codestream);
+    ASSERT_FALSE(codestream.empty());
+    const uint32_t codestream_size = (uint32_t)codestream.size();
+
+    svt_jpeg_xs_decoder_api_t decoder;
+    svt_jpeg_xs_image_config_t image_config;
+    decoder_test_config(&decoder);
+    decoder.threads_num = 1;
+    ASSERT_EQ(svt_jpeg_xs_decoder_init(
+                  SVT_JPEGXS_API_VER_MAJOR, SVT_JPEGXS_API_VER_MINOR, &decoder, codestream.data(), codestream_size, &image_config),
+              SvtJxsErrorNone);
+    svt_jpeg_xs_image_buffer_t* image_ref = svt_jpeg_xs_image_buffer_alloc(&image_config);
+    ASSERT_NE(image_ref, nullptr);
+    ASSERT_EQ(decode_test_frame(&decoder, codestream.data(), codestream_size, image_ref), SvtJxsErrorNone);
+    svt_jpeg_xs_decoder_close(&decoder);
+
+    for (size_t t = 0; t < sizeof(threads_num) / sizeof(threads_num[0]); t++) {
+        decoder_test_config(&decoder);
+        decoder.threads_num = threads_num[t];
+        ASSERT_EQ(svt_jpeg_xs_decoder_init(
+                      SVT_JPEGXS_API_VER_MAJOR, SVT_JPEGXS_API_VER_MINOR, &decoder, codestream.data(), codestream_size, &image_config),
+                  SvtJxsErrorNone);
+        svt_jpeg_xs_image_buffer_t* image = svt_jpeg_xs_image_buffer_alloc(&image_config);
+        ASSERT_NE(image, nullptr);
+        /*Order of finished slices differs between frames, so overlaps are calculated by different threads*/
+        for (int i = 0; i < 4; i++) {
+            memset(image->data_yuv[0], 0, image_config.components[0].byte_size);
+            ASSERT_EQ(decode_test_frame(&decoder, codestream.data(), codestream_size, image), SvtJxsErrorNone);
+            decode_test_compare(&image_config, image, image_ref);
+        }
+        svt_jpeg_xs_decoder_close(&decoder);
+        svt_jpeg_xs_image_buffer_free(image);
+    }
+    svt_jpeg_xs_image_buffer_free(image_ref);
+}
+
+INSTANTIATE_TEST_SUITE_P(SliceOverlapHeights, SliceOverlap, ::testing::Values(4, 8));
@@ -0,0 +1,49 @@
+/*
+* Copyright(c) 2024 Intel Corporation
+* SPDX - License - Identifier: BSD - 2 - Clause - Patent
+*/
+
+#include <string.h>
+#include <vector>
+
+#include "gtest/gtest.h"
+#include "SvtJpegxsImageBufferTools.h"
+#include "ApiTestUtils.h"
+
+/*
+ * Tests for slices without vertical decomposition split to parts on pack threads
+ */
+
+class SliceParts : public ::testing::TestWithParam<uint32_t> {};
+
+static void slice_parts_test_encode(uint32_t threads_num, uint32_t rate_control_mode, uint32_t frames_num,
+                                    std::vector<uint8_t>& codestream) {
+    svt_jpeg_xs_encoder_api_t encoder;
+    encoder_test_config(&encoder);
+    encoder.source_width = 128;
+    encoder.ndecomp_v = 0;
+    encoder.slice_height = 64; /*One slice in frame*/
+    encoder.threads_num = threads_num;
+    encoder.rate_control_mode = rate_control_mode;
+    encoder.coding_vertical_prediction_mode = 1;
+    encoder.stats_enable = 1;
+    encode_test_frames(&encoder, frames_num, &codestream);
+}
+
+/*Precincts of slice prepared by many threads have to give the same codestream as one thread*/
+TEST_P(SliceParts, ThreadsMatchSingleThread) {
+    const uint32_t rate_control_mode = GetParam();
+    const uint32_t frames_num = 4;
+    std::vector<uint8_t> codestream_ref;
+    slice_parts_test_encode(1, rate_control_mode, frames_num, codestream_ref);
+    ASSERT_FALSE(codestream_ref.empty());
+
+    const uint32_t threads_num[] = {8, 5};
+    for (size_t t = 0; t < sizeof(threads_num) / sizeof(threads_num[0]); t++) {
+        std::vector<uint8_t> codestream;
+        slice_parts_test_encode(threads_num[t], rate_control_mode, frames_num, codestream);
+        EXPECT_TRUE(codestream == codestream_ref) << "threads " << threads_num[t];
+    }
+}
+
+INSTANTIATE_TEST_SUITE_P(SlicePartsRateControl, SliceParts, ::testing::Values(0, 1, 2, 3));
@@ -0,0 +1,57 @@
+/*
+* Copyright(c) 2024 Intel Corporation
+* SPDX - License - Identifier: BSD - 2 - Clause - Patent
+*/
+
+#include <string.h>
+#include <vector>
+
+#include "gtest/gtest.h"
+#include "SvtJpegxsImageBufferTools.h"
+#include "ApiTestUtils.h"
+
+/*
+ * Tests for chunked order of slices on pack threads
+ */
+
+class SliceScheduling : public ::testing::TestWithParam<uint32_t> {};
+
+static void slice_scheduling_test_encode(uint32_t threads_num, uint8_t slice_scheduling, uint32_t rate_control_mode,
+                                         uint32_t frames_num, std::vector<uint8_t>& codestream) {
+    svt_jpeg_xs_encoder_api_t encoder;
+    encoder_test_config(&encoder);
+    encoder.source_width = 128;
+    encoder.source_height = 80;
+    encoder.slice_height = 8; /*10 slices in frame*/
+    encoder.threads_num = threads_num;
+    encoder.rate_control_mode = rate_control_mode;
+    encoder.slice_scheduling = slice_scheduling;
+    encoder.slice_packetization_mode = 1; /*Header and every slice in separate packet, in order of slices*/
+    encode_test_frames(&encoder, frames_num, &codestream);
+}
+
+/*Ranges of slices calculated on one thread have to give the same codestream as slices taken by any thread*/
+TEST_P(SliceScheduling, ChunkedMatchesInterleaved) {
+    const uint32_t rate_control_mode = GetParam();
+    const uint32_t frames_num = 4;
+    std::vector<uint8_t> codestream_ref;
+    slice_scheduling_test_encode(4, 0, rate_control_mode, frames_num, codestream_ref);
+    ASSERT_FALSE(codestream_ref.empty());
+
+    /*Pack threads: 1 - whole frame in one task, 3 - ranges of 4, 4 and 2 slices, 5 - ranges of 2 slices*/
+    const uint32_t threads_num[] = {3, 5, 7};
+    for (size_t t = 0; t < sizeof(threads_num) / sizeof(threads_num[0]); t++) {
+        std::vector<uint8_t> codestream;
+        slice_scheduling_test_encode(threads_num[t], 1, rate_control_mode, frames_num, codestream);
+        EXPECT_TRUE(codestream == codestream_ref) << "threads " << threads_num[t];
+    }
+}
+
+INSTANTIATE_TEST_SUITE_P(SliceSchedulingRateControl, SliceScheduling, ::testing::Values(0, 1, 2, 3));
+
+TEST(SliceSchedulingInit, InvalidModeReturnsError) {
+    svt_jpeg_xs_encoder_api_t encoder;
+    encoder_test_config(&encoder);
+    encoder.slice_scheduling = 2;
+    EXPECT_EQ(svt_jpeg_xs_encoder_init(SVT_JPEGXS_API_VER_MAJOR, SVT_JPEGXS_API_VER_MINOR, &encoder), SvtJxsErrorBadParameter);
+}
@@ -0,0 +1,310 @@
+/*
+* Copyright(c) 2024 Intel Corporation
+* SPDX - License - Identifier: BSD - 2 - Clause - Patent
+*/
+
+#include <string.h>
+#include <vector>
+
+#include "gtest/gtest.h"
+#include "SvtJpegxsImageBufferTools.h"
+#include "ApiTestUtils.h"
+#include "SampleFramesData.h"
+
+/*
+ * Tests for per frame statistics
+ */
+
+typedef struct TestStatsCtx {
+    uint32_t calls;
+    svt_jpeg_xs_frame_stats_t last;
+} TestStatsCtx;
+
+static void test_encoder_stats_callback(svt_jpeg_xs_encoder_api_t* encoder, const svt_jpeg_xs_frame_stats_t* stats,
+                                        void* context) {
+    (void)encoder;
+    TestStatsCtx* ctx = (TestStatsCtx*)context;
+    EXPECT_EQ(stats->frame_num, (uint64_t)ctx->calls);
+    ctx->last = *stats;
+    ctx->calls++;
+}
+
+static void test_decoder_stats_callback(svt_jpeg_xs_decoder_api_t* decoder, const svt_jpeg_xs_frame_stats_t* stats,
+                                        void* context) {
+    (void)decoder;
+    TestStatsCtx* ctx = (TestStatsCtx*)context;
+    EXPECT_EQ(stats->frame_num, (uint64_t)ctx->calls);
+    ctx->last = *stats;
+    ctx->calls++;
+}
+
+TEST(Stats, InvalidStatsModeReturnsError) {
+    svt_jpeg_xs_encoder_api_t encoder;
+    encoder_test_config(&encoder);
+    encoder.stats_enable = 2;
+    ASSERT_EQ(svt_jpeg_xs_encoder_init(SVT_JPEGXS_API_VER_MAJOR, SVT_JPEGXS_API_VER_MINOR, &encoder), SvtJxsErrorBadParameter);
+    EXPECT_EQ(encoder.private_ptr, nullptr);
+
+    svt_jpeg_xs_decoder_api_t decoder;
+    memset(&decoder, 0, sizeof(decoder));
+    decoder.verbose = VERBOSE_NONE;
+    decoder.stats_enable = 2;
+    svt_jpeg_xs_image_config_t image_config;
+    ASSERT_EQ(svt_jpeg_xs_decoder_init(SVT_JPEGXS_API_VER_MAJOR,
+                                       SVT_JPEGXS_API_VER_MINOR,
+                                       &decoder,
+                                       Frame_Sample_1_16x16_8bit_422_bitstream,
+                                       Frame_Sample_1_16x16_8bit_422_bitstream_size,
+                                       &image_config),
+              SvtJxsErrorBadParameter);
+    EXPECT_EQ(decoder.private_ptr, nullptr);
+}
+
+TEST(Stats, DisabledStatsReturnsError) {
+    svt_jpeg_xs_encoder_api_t encoder;
+    encoder_test_config(&encoder);
+    ASSERT_EQ(svt_jpeg_xs_encoder_init(SVT_JPEGXS_API_VER_MAJOR, SVT_JPEGXS_API_VER_MINOR, &encoder), SvtJxsErrorNone);
+    svt_jpeg_xs_frame_stats_t stats;
+    EXPECT_EQ(svt_jpeg_xs_encoder_get_frame_stats(&encoder, &stats), SvtJxsErrorBadParameter);
+    svt_jpeg_xs_encoder_close(&encoder);
+
+    EXPECT_EQ(svt_jpeg_xs_decoder_get_frame_stats(NULL, &stats), SvtJxsErrorDecoderInvalidPointer);
+}
+
+TEST(Stats, EncoderFrameStats) {
+    const uint32_t frames_num = 4;
+    TestStatsCtx ctx;
+    memset(&ctx, 0, sizeof(ctx));
+
+    svt_jpeg_xs_encoder_api_t encoder;
+    encoder_test_config(&encoder);
+    encoder.slice_height = 16;
+    encoder.stats_enable = 1;
+    encoder.callback_frame_stats = test_encoder_stats_callback;
+    encoder.callback_frame_stats_context = &ctx;
+
+    svt_jpeg_xs_image_config_t image_config;
+    uint32_t bytes_per_frame = 0;
+    ASSERT_EQ(svt_jpeg_xs_encoder_get_image_config(
+                  SVT_JPEGXS_API_VER_MAJOR, SVT_JPEGXS_API_VER_MINOR, &encoder, &image_config, &bytes_per_frame),
+              SvtJxsErrorNone);
+    ASSERT_EQ(svt_jpeg_xs_encoder_init(SVT_JPEGXS_API_VER_MAJOR, SVT_JPEGXS_API_VER_MINOR, &encoder), SvtJxsErrorNone);
+
+    svt_jpeg_xs_frame_stats_t stats;
+    EXPECT_EQ(svt_jpeg_xs_encoder_get_frame_stats(&encoder, &stats), SvtJxsErrorNoErrorEmptyQueue);
+
+    svt_jpeg_xs_frame_pool_t* pool = svt_jpeg_xs_frame_pool_alloc(&image_config, bytes_per_frame, 1);
+    ASSERT_NE(pool, nullptr);
+    for (uint32_t i = 0; i < frames_num; i++) {
+        svt_jpeg_xs_frame_t frame;
+        ASSERT_EQ(svt_jpeg_xs_frame_pool_get(pool, &frame, 1), SvtJxsErrorNone);
+        for (int c = 0; c < image_config.components_num; c++) {
+            memset(frame.image.data_yuv[c], (int)(i * 40), frame.image.alloc_size[c]);
+        }
+        ASSERT_EQ(svt_jpeg_xs_encoder_send_picture(&encoder, &frame, 1), SvtJxsErrorNone);
+        ASSERT_EQ(svt_jpeg_xs_encoder_get_packet(&encoder, &frame, 1), SvtJxsErrorNone);
+        svt_jpeg_xs_frame_pool_release(pool, &frame);
+    }
+    /*Statistics are published after packet is ready, previous frame is always finished*/
+    ASSERT_EQ(svt_jpeg_xs_encoder_get_frame_stats(&encoder, &stats), SvtJxsErrorNone);
+    EXPECT_GE(stats.frame_num, (uint64_t)(frames_num - 2));
+
+    svt_jpeg_xs_encoder_close(&encoder);
+    svt_jpeg_xs_frame_pool_free(pool);
+
+    EXPECT_EQ(ctx.calls, frames_num);
+    EXPECT_EQ(ctx.last.frame_num, (uint64_t)(frames_num - 1));
+    EXPECT_EQ(ctx.last.slices_num, (uint32_t)(64 / 16));
+    EXPECT_GE(ctx.last.rc_iterations, ctx.last.slices_num);
+    EXPECT_GE(ctx.last.rc_iterations, ctx.last.rc_iterations_max);
+    EXPECT_LE(ctx.last.slice_time_min_us, ctx.last.slice_time_max_us);
+    EXPECT_GE(ctx.last.stage_time_us[SVT_JXS_STAGE_SLICE], ctx.last.slice_time_max_us);
+    EXPECT_GE(ctx.last.latency_us, ctx.last.slice_time_max_us);
+}
+
+typedef struct TestRateStatsCtx {
+    uint32_t calls;
+    svt_jpeg_xs_rate_stats_t last;
+    std::vector<svt_jpeg_xs_slice_rate_stats_t> last_slices;
+} TestRateStatsCtx;
+
+static void test_encoder_rate_stats_callback(svt_jpeg_xs_encoder_api_t* encoder, const svt_jpeg_xs_rate_stats_t* stats,
+                                             void* context) {
+    (void)encoder;
+    TestRateStatsCtx* ctx = (TestRateStatsCtx*)context;
+    EXPECT_EQ(stats->frame_num, (uint64_t)ctx->calls);
+    ctx->last = *stats;
+    ctx->last_slices.assign(stats->slices, stats->slices + stats->slices_num);
+    ctx->calls++;
+}
+
+/*Encode one frame, return rate statistics from callback*/
+static void rate_stats_test_encode(uint32_t rate_control_mode, uint32_t bpp_numerator, TestRateStatsCtx* ctx,
+                                   uint32_t* out_frame_size) {
+    svt_jpeg_xs_encoder_api_t encoder;
+    encoder_test_config(&encoder);
+    encoder.bpp_numerator = bpp_numerator;
+    encoder.rate_control_mode = rate_control_mode;
+    encoder.stats_enable = 1;
+    encoder.callback_rate_stats = test_encoder_rate_stats_callback;
+    encoder.callback_rate_stats_context = ctx;
+    std::vector<uint8_t> codestream;
+    encode_test_frames(&encoder, 1, &codestream);
+    *out_frame_size = (uint32_t)codestream.size();
+}
+
+class RateStats : public ::testing::TestWithParam<uint32_t> {};
+
+TEST_P(RateStats, SlicesMatchFrame) {
+    const uint32_t rate_control_mode = GetParam();
+    const uint32_t precincts_num = 64 / 4;
+    TestRateStatsCtx ctx_low;
+    TestRateStatsCtx ctx_high;
+    ctx_low.calls = 0;
+    ctx_high.calls = 0;
+    uint32_t frame_size_low = 0;
+    uint32_t frame_size_high = 0;
+    rate_stats_test_encode(rate_control_mode, 3, &ctx_low, &frame_size_low);
+    rate_stats_test_encode(rate_control_mode, 8, &ctx_high, &frame_size_high);
+    ASSERT_EQ(ctx_low.calls, 1u);
+    ASSERT_EQ(ctx_high.calls, 1u);
+
+    const TestRateStatsCtx* ctxs[2] = {&ctx_low, &ctx_high};
+    const uint32_t frame_sizes[2] = {frame_size_low, frame_size_high};
+    for (int i = 0; i < 2; i++) {
+        const svt_jpeg_xs_rate_stats_t& stats = ctxs[i]->last;
+        EXPECT_EQ(stats.frame_num, 0u);
+        EXPECT_EQ(stats.bytes, frame_sizes[i]);
+        ASSERT_EQ(stats.slices_num, 64u / 16);
+        ASSERT_EQ(ctxs[i]->last_slices.size(), (size_t)stats.slices_num);
+        uint32_t slices_bytes = 0;
+        uint32_t slices_padding_bytes = 0;
+        uint64_t slices_distortion = 0;
+        for (const svt_jpeg_xs_slice_rate_stats_t& slice : ctxs[i]->last_slices) {
+            EXPECT_LT(slice.padding_bytes, slice.bytes);
+            slices_bytes += slice.bytes;
+            slices_padding_bytes += slice.padding_bytes;
+            slices_distortion += slice.distortion;
+        }
+        /*Frame is picture header and all slices*/
+        EXPECT_LT(slices_bytes, stats.bytes);
+        EXPECT_EQ(slices_padding_bytes, stats.padding_bytes);
+        EXPECT_EQ(slices_distortion, stats.distortion);
+
+        /*Lowest band of luma exists in every precinct*/
+        uint32_t precincts_in_band = 0;
+        for (uint32_t gtli = 0; gtli < SVT_JXS_GTLI_VALUES_NUM; gtli++) {
+            precincts_in_band += stats.gtli_histogram[0][0][gtli];
+        }
+        EXPECT_EQ(precincts_in_band, precincts_num);
+    }
+    /*Frame can not be coded lossless, more bits give less truncation*/
+    EXPECT_GT(ctx_low.last.distortion, ctx_high.last.distortion);
+    EXPECT_GT(ctx_high.last.distortion, 0u);
+}
+
+INSTANTIATE_TEST_SUITE_P(RateStatsRateControl, RateStats, ::testing::Values(0, 1, 2, 3));
+
+TEST(Stats, EncoderGetRateStats) {
+    svt_jpeg_xs_encoder_api_t encoder;
+    encoder_test_config(&encoder);
+    encoder.slice_height = 16;
+    encoder.stats_enable = 1;
+
+    svt_jpeg_xs_image_config_t image_config;
+    uint32_t bytes_per_frame = 0;
+    ASSERT_EQ(svt_jpeg_xs_encoder_get_image_config(
+                  SVT_JPEGXS_API_VER_MAJOR, SVT_JPEGXS_API_VER_MINOR, &encoder, &image_config, &bytes_per_frame),
+              SvtJxsErrorNone);
+    ASSERT_EQ(svt_jpeg_xs_encoder_init(SVT_JPEGXS_API_VER_MAJOR, SVT_JPEGXS_API_VER_MINOR, &encoder), SvtJxsErrorNone);
+
+    svt_jpeg_xs_slice_rate_stats_t slices[2];
+    svt_jpeg_xs_rate_stats_t stats;
+    memset(&stats, 0, sizeof(stats));
+    stats.slices_alloc = 2;
+    EXPECT_EQ(svt_jpeg_xs_encoder_get_rate_stats(&encoder, &stats), SvtJxsErrorBadParameter);
+    stats.slices = slices;
+    EXPECT_EQ(svt_jpeg_xs_encoder_get_rate_stats(&encoder, &stats), SvtJxsErrorNoErrorEmptyQueue);
+
+    svt_jpeg_xs_frame_pool_t* pool = svt_jpeg_xs_frame_pool_alloc(&image_config, bytes_per_frame, 1);
+    ASSERT_NE(pool, nullptr);
+    for (uint32_t i = 0; i < 2; i++) {
+        svt_jpeg_xs_frame_t frame;
+        ASSERT_EQ(svt_jpeg_xs_frame_pool_get(pool, &frame, 1), SvtJxsErrorNone);
+        for (int c = 0; c < image_config.components_num; c++) {
+            memset(frame.image.data_yuv[c], 100, frame.image.alloc_size[c]);
+        }
+        ASSERT_EQ(svt_jpeg_xs_encoder_send_picture(&encoder, &frame, 1), SvtJxsErrorNone);
+        ASSERT_EQ(svt_jpeg_xs_encoder_get_packet(&encoder, &frame, 1), SvtJxsErrorNone);
+        svt_jpeg_xs_frame_pool_release(pool, &frame);
+    }
+
+    /*Statistics are published after packet is ready, previous frame is always finished*/
+    memset(slices, 0, sizeof(slices));
+    ASSERT_EQ(svt_jpeg_xs_encoder_get_rate_stats(&encoder, &stats), SvtJxsErrorNone);
+    EXPECT_EQ(stats.slices, slices);
+    EXPECT_EQ(stats.slices_alloc, 2u);
+    EXPECT_EQ(stats.slices_num, 64u / 16);
+    EXPECT_GT(slices[0].bytes, 0u);
+    EXPECT_GT(slices[1].bytes, 0u);
+
+    stats.slices = NULL;
+    stats.slices_alloc = 0;
+    ASSERT_EQ(svt_jpeg_xs_encoder_get_rate_stats(&encoder, &stats), SvtJxsErrorNone);
+    EXPECT_EQ(stats.slices, nullptr);
+
+    svt_jpeg_xs_encoder_close(&encoder);
+    svt_jpeg_xs_frame_pool_free(pool);
+
+    EXPECT_EQ(svt_jpeg_xs_encoder_get_rate_stats(NULL, &stats), SvtJxsErrorBadParameter);
+}
+
+TEST(Stats, DecoderFrameStats) {
+    const uint32_t frames_num = 4;
+    TestStatsCtx ctx;
+    memset(&ctx, 0, sizeof(ctx));
+
+    svt_jpeg_xs_decoder_api_t decoder;
+    decoder_test_config(&decoder);
+    decoder.stats_enable = 1;
+    decoder.callback_frame_stats = test_decoder_stats_callback;
+    decoder.callback_frame_stats_context = &ctx;
+
+    svt_jpeg_xs_image_config_t image_config;
+    ASSERT_EQ(svt_jpeg_xs_decoder_init(SVT_JPEGXS_API_VER_MAJOR,
+                                       SVT_JPEGXS_API_VER_MINOR,
+                                       &decoder,
+                                       Frame_Sample_1_16x16_8bit_422_bitstream,
+                                       Frame_Sample_1_16x16_8bit_422_bitstream_size,
+                                       &image_config),
+              SvtJxsErrorNone);
+
+    svt_jpeg_xs_frame_stats_t stats;
+    EXPECT_EQ(svt_jpeg_xs_decoder_get_frame_stats(&decoder, &stats), SvtJxsErrorNoErrorEmptyQueue);
+
+    svt_jpeg_xs_image_buffer_t* image = svt_jpeg_xs_image_buffer_alloc(&image_config);
+    ASSERT_NE(image, nullptr);
+    for (uint32_t i = 0; i < frames_num; i++) {
+        svt_jpeg_xs_frame_t frame;
+        memset(&frame, 0, sizeof(frame));
+        frame.image = *image;
+        frame.bitstream.buffer = (uint8_t*)Frame_Sample_1_16x16_8bit_422_bitstream;
+        frame.bitstream.used_size = Frame_Sample_1_16x16_8bit_422_bitstream_size;
+        frame.bitstream.allocation_size = Frame_Sample_1_16x16_8bit_422_bitstream_size;
+        ASSERT_EQ(svt_jpeg_xs_decoder_send_frame(&decoder, &frame, 1), SvtJxsErrorNone);
+        ASSERT_EQ(svt_jpeg_xs_decoder_get_frame(&decoder, &frame, 1), SvtJxsErrorNone);
+    }
+    /*Statistics are published after frame is ready, previous frame is always finished*/
+    ASSERT_EQ(svt_jpeg_xs_decoder_get_frame_stats(&decoder, &stats), SvtJxsErrorNone);
+    EXPECT_GE(stats.frame_num, (uint64_t)(frames_num - 2));
+
+    svt_jpeg_xs_decoder_close(&decoder);
+    svt_jpeg_xs_image_buffer_free(image);
+
+    EXPECT_EQ(ctx.calls, frames_num);
+    EXPECT_EQ(ctx.last.frame_num, (uint64_t)(frames_num - 1));
+    EXPECT_GE(ctx.last.slices_num, (uint32_t)1);
+    EXPECT_EQ(ctx.last.rc_iterations, (uint32_t)0);
+    EXPECT_LE(ctx.last.slice_time_min_us, ctx.last.slice_time_max_us);
+    EXPECT_GE(ctx.last.latency_us, ctx.last.slice_time_max_us);
+}